@@ -65,6 +65,11 @@ if (ENABLE_GE OR ENABLE_D)
     set(ENABLE_TDTQUE ON)
 endif()
 
+if (ENABLE_CPU)
+    set(ENABLE_CPUQUE ON)
+    add_compile_definitions(ENABLE_CPUQUE)
+endif()
+
 if (ENABLE_GPU)
     set(ENABLE_GPUQUE ON)
     add_compile_definitions(ENABLE_GPU_COLLECTIVE)
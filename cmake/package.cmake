@@ -73,6 +73,15 @@ if (ENABLE_MINDDATA)
         COMPONENT mindspore
     )
 
+    # the standalone cache server loads _c_dataengine from its own directory
+    if (CMAKE_SYSTEM_NAME MATCHES "Linux")
+        install(
+            TARGETS cache_server
+            DESTINATION ${INSTALL_BASE_DIR}
+            COMPONENT mindspore
+        )
+    endif ()
+
     file(GLOB_RECURSE OPENCV_LIB_LIST
             ${opencv_LIBPATH}/libopencv_core*
             ${opencv_LIBPATH}/libopencv_imgcodecs*
@@ -120,6 +129,11 @@ if (ENABLE_CPU)
         DESTINATION ${INSTALL_LIB_DIR}
         COMPONENT mindspore
     )
+    install(
+        TARGETS cpu_queue
+        DESTINATION ${INSTALL_LIB_DIR}
+        COMPONENT mindspore
+    )
 endif ()
 
 if (ENABLE_MPI)
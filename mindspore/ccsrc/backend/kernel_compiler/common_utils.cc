@@ -20,10 +20,10 @@
 #include <iostream>
 #include <utility>
 #include <fstream>
-#include <thread>
 #include "nlohmann/json.hpp"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "common/utils.h"
+#include "common/thread_pool.h"
 #include "ir/manager.h"
 #include "ir/meta_tensor.h"
 #include "ir/func_graph.h"
@@ -585,30 +585,13 @@ void RunMultiThreadReduceSparseGradient(const SparseGradient &origin_sparse_grad
                                         size_t outer_dim, std::vector<std::pair<int, size_t>> *sorted_indices,
                                         std::vector<size_t> *slice_positions) {
   MS_LOG(DEBUG) << "Start";
-  size_t thread_num = 24;
-  if (slice_positions->size() < thread_num) {
-    thread_num = slice_positions->size();
-  }
-  size_t stride = (slice_positions->size() + thread_num - 1) / thread_num;
-  thread_num = (slice_positions->size() + stride - 1) / stride;
-  std::vector<std::thread> threads;
   size_t max_length = sorted_indices->size() * outer_dim;
-  for (size_t i = 0; i < thread_num; ++i) {
-    size_t slice_start = i * stride;
-    size_t slice_end = 0;
-    if (i == thread_num - 1) {
-      slice_end = slice_positions->size();
-    } else {
-      slice_end = slice_start + stride;
-    }
+  common::ThreadPool::GetInstance().ParallelFor(slice_positions->size(), 1, [&](size_t slice_start, size_t slice_end) {
     WorkerParamsForReduceSparseGradient params{
       slice_start, slice_end, max_length, outer_dim, sorted_indices, slice_positions, origin_sparse_grad.value_,
       unique_grad};
-    threads.emplace_back(std::thread(WorkerForReduceSparseGradient, params));
-  }
-  for (size_t i = 0; i < thread_num; ++i) {
-    threads[i].join();
-  }
+    WorkerForReduceSparseGradient(params);
+  });
   MS_LOG(DEBUG) << "End";
 }
 
@@ -699,15 +682,14 @@ void TwoLevelReduceSparseGradient(const SparseGradient &origin_sparse_grad, Spar
   MS_EXCEPTION_IF_NULL(tmp_grad);
   MS_EXCEPTION_IF_NULL(tmp_grad->value_);
   MS_EXCEPTION_IF_NULL(tmp_grad->indices_);
-  size_t thread_num = 24;
+  size_t thread_num = common::ThreadPool::GetInstance().thread_num();
   if (origin_sparse_grad.indices_size_ < thread_num) {
     thread_num = origin_sparse_grad.indices_size_;
   }
   size_t thread_indices_size = origin_sparse_grad.indices_size_ / thread_num;
   size_t left_indices_size = origin_sparse_grad.indices_size_ % thread_num;
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
   std::vector<std::shared_ptr<SparseGradient>> unique_slice_grads;
+  std::vector<SparseGradient> slice_grads;
   for (size_t i = 0; i < thread_num; ++i) {
     size_t indices_size = thread_indices_size;
     if (i == thread_num - 1) {
@@ -715,18 +697,16 @@ void TwoLevelReduceSparseGradient(const SparseGradient &origin_sparse_grad, Spar
     }
     size_t value_offset = i * thread_indices_size * outer_dim;
     size_t indices_offset = i * thread_indices_size;
-    auto slice_grad = SparseGradient(
-      {origin_sparse_grad.value_ + value_offset, origin_sparse_grad.indices_ + indices_offset, indices_size});
+    slice_grads.emplace_back(SparseGradient(
+      {origin_sparse_grad.value_ + value_offset, origin_sparse_grad.indices_ + indices_offset, indices_size}));
     unique_slice_grads.emplace_back(std::make_shared<SparseGradient>());
     unique_slice_grads[i]->value_ = unique_grad->value_ + value_offset;
     unique_slice_grads[i]->indices_ = unique_grad->indices_ + indices_offset;
     unique_slice_grads[i]->indices_size_ = indices_size;
-    threads.emplace_back(
-      std::thread(ReduceSparseGradient, slice_grad, unique_slice_grads[i].get(), first_dim, outer_dim, false));
-  }
-  for (size_t i = 0; i < thread_num; ++i) {
-    threads[i].join();
   }
+  common::ThreadPool::GetInstance().Run(thread_num, [&](size_t i) {
+    ReduceSparseGradient(slice_grads[i], unique_slice_grads[i].get(), first_dim, outer_dim, false);
+  });
   ReduceMultiSparseGradient(unique_slice_grads, tmp_grad, unique_grad, first_dim, outer_dim);
   MS_LOG(DEBUG) << "End";
 }
@@ -977,19 +957,8 @@ bool IsWeightBoundary(const AnfNodePtr &node) {
 
 void MultiThreadCompute(const MultiThreadComputeFunc &func, MultiThreadComputeParams *params,
                         size_t total_compute_size) {
-  const size_t kThreadNum = 24;
-  std::vector<std::thread> threads;
-  threads.reserve(kThreadNum);
-  size_t start = 0;
-  size_t once_compute_size = (total_compute_size + kThreadNum - 1) / kThreadNum;
-  while (start < total_compute_size) {
-    size_t end = (start + once_compute_size) > total_compute_size ? total_compute_size : (start + once_compute_size);
-    threads.emplace_back(std::thread(func, params, start, end));
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-  }
+  auto task = [&func, params](size_t start, size_t end) { func(params, start, end); };
+  common::ThreadPool::GetInstance().ParallelFor(total_compute_size, 1, task);
 }
 
 std::vector<int> GetReduceAttrAxis(const CNodePtr &cnode) {
@@ -30,22 +30,23 @@ bool AddNCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                            const std::vector<kernel::AddressPtr> & /*workspace*/,
                            const std::vector<kernel::AddressPtr> &outputs) {
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
-
-  size_t offset = 0;
-  for (size_t i = 0; i < output_shape_[0]; ++i) {
-    for (size_t j = 0; j < output_shape_[1]; ++j) {
-      for (size_t k = 0; k < output_shape_[2]; ++k) {
-        for (size_t m = 0; m < output_shape_[3]; ++m) {
-          float sum = 0;
-          for (size_t index = 0; index < input_num_; ++index) {
-            auto input_addr = reinterpret_cast<float *>(inputs[index]->addr);
-            sum += input_addr[offset];
-          }
-          output_addr[offset++] = sum;
+  std::vector<const float *> input_addrs;
+  for (size_t index = 0; index < input_num_; ++index) {
+    input_addrs.push_back(reinterpret_cast<float *>(inputs[index]->addr));
+  }
+  size_t elem_num = output_shape_[0] * output_shape_[1] * output_shape_[2] * output_shape_[3];
+  const size_t kParallelGrain = 10000;
+  CPUKernelUtils::ParallelFor(
+    [&input_addrs, output_addr](size_t start, size_t end) {
+      for (size_t offset = start; offset < end; ++offset) {
+        float sum = 0;
+        for (auto input_addr : input_addrs) {
+          sum += input_addr[offset];
         }
+        output_addr[offset] = sum;
       }
-    }
-  }
+    },
+    elem_num, kParallelGrain);
 
   return true;
 }
@@ -15,6 +15,7 @@
  */
 
 #include "backend/kernel_compiler/cpu/bias_add_cpu_kernel.h"
+#include <algorithm>
 
 namespace mindspore {
 namespace kernel {
@@ -50,31 +51,36 @@ bool BiasAddCPUKernel::Launch(const std::vector<AddressPtr> &inputs, const std::
   auto bias_addr = reinterpret_cast<float *>(inputs[1]->addr);
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
 
+  const size_t kParallelGrain = 10000;
   if (data_shape_ == 4) {
-    size_t h_size = input_shape_[3];
-    size_t c_size = input_shape_[2] * h_size;
-    size_t n_size = input_shape_[1] * c_size;
+    // each plane of one batch and one channel adds the same bias
+    size_t c_num = input_shape_[1];
     size_t hw_size = input_shape_[2] * input_shape_[3];
-    size_t n_offset = 0;
-    for (size_t n = 0; n < input_shape_[0]; ++n) {
-      size_t c_offset = 0;
-      for (size_t c = 0; c < input_shape_[1]; ++c) {
-        for (size_t hw = 0; hw < hw_size; ++hw) {
-          size_t offset = n_offset + c_offset + hw;
-          output_addr[offset] = src_addr[offset] + bias_addr[c];
+    size_t plane_grain = hw_size == 0 ? 1 : std::max(kParallelGrain / hw_size, static_cast<size_t>(1));
+    CPUKernelUtils::ParallelFor(
+      [src_addr, bias_addr, output_addr, c_num, hw_size](size_t start, size_t end) {
+        for (size_t plane = start; plane < end; ++plane) {
+          float bias = bias_addr[plane % c_num];
+          size_t offset = plane * hw_size;
+          for (size_t hw = 0; hw < hw_size; ++hw) {
+            output_addr[offset + hw] = src_addr[offset + hw] + bias;
+          }
         }
-        c_offset += c_size;
-      }
-      n_offset += n_size;
-    }
+      },
+      input_shape_[0] * c_num, plane_grain);
   } else {
-    size_t n_offset = 0;
-    for (size_t n = 0; n < input_shape_[0]; ++n) {
-      for (size_t c = 0; c < input_shape_[1]; ++c) {
-        output_addr[n_offset + c] = src_addr[n_offset + c] + bias_addr[c];
-      }
-      n_offset += input_shape_[1];
-    }
+    size_t c_num = input_shape_[1];
+    size_t row_grain = c_num == 0 ? 1 : std::max(kParallelGrain / c_num, static_cast<size_t>(1));
+    CPUKernelUtils::ParallelFor(
+      [src_addr, bias_addr, output_addr, c_num](size_t start, size_t end) {
+        for (size_t n = start; n < end; ++n) {
+          size_t n_offset = n * c_num;
+          for (size_t c = 0; c < c_num; ++c) {
+            output_addr[n_offset + c] = src_addr[n_offset + c] + bias_addr[c];
+          }
+        }
+      },
+      input_shape_[0], row_grain);
   }
   return true;
 }
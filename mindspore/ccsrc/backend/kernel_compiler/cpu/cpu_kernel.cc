@@ -14,14 +14,23 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "ir/dtype.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+// types without a fixed width, if any, keep the float32 slot they always had
+size_t GetDeviceTypeSize(TypeId type_id) {
+  size_t type_size = GetTypeByte(TypeIdToType(type_id));
+  return type_size == 0 ? sizeof(float) : type_size;
+}
+}  // namespace
+
 void CPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
-  size_t type_size = sizeof(float);
   for (size_t input_index = 0; input_index < input_num; ++input_index) {
+    size_t type_size = GetDeviceTypeSize(AnfAlgo::GetInputDeviceDataType(kernel_node, input_index));
     std::vector<size_t> shape = AnfAlgo::GetInputDeviceShape(kernel_node, input_index);
     size_t tensor_size =
       shape.empty() ? type_size : std::accumulate(shape.begin(), shape.end(), type_size, std::multiplies<size_t>());
@@ -29,6 +38,7 @@ void CPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
   }
   size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
   for (size_t output_index = 0; output_index < output_num; ++output_index) {
+    size_t type_size = GetDeviceTypeSize(AnfAlgo::GetOutputDeviceDataType(kernel_node, output_index));
     std::vector<size_t> shape = AnfAlgo::GetOutputDeviceShape(kernel_node, output_index);
     size_t tensor_size =
       shape.empty() ? type_size : std::accumulate(shape.begin(), shape.end(), type_size, std::multiplies<size_t>());
@@ -76,5 +86,9 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
   }
   std::reverse(element_num->begin(), element_num->end());
 }
+
+void CPUKernelUtils::ParallelFor(const CTask &task, size_t count, size_t grain) {
+  common::ThreadPool::GetInstance().ParallelFor(count, grain, task);
+}
 }  // namespace kernel
 }  // namespace mindspore
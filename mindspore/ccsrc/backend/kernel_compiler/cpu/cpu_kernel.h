@@ -24,6 +24,7 @@
 #include "backend/kernel_compiler/kernel.h"
 #include "ir/anf.h"
 #include "backend/session/anf_runtime_algorithm.h"
+#include "common/thread_pool.h"
 
 using mindspore::kernel::Address;
 using mindspore::kernel::AddressPtr;
@@ -74,12 +75,15 @@ class CPUKernel : public kernel::KernelMod {
   std::vector<size_t> workspace_size_list_;
 };
 
+using CTask = common::RangeTask;
 class CPUKernelUtils {
  public:
   static void ExpandDimsTo4(std::vector<size_t> *shape);
   static size_t CalcOffset(const std::vector<size_t> &shape, size_t dim0, size_t dim1, size_t dim2, size_t dim3);
   static size_t GetElementNumOnAxis(const std::vector<size_t> &shape, int axis);
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
+  // run task over [0, count) on the shared intra op thread pool, each piece holds at least grain elements
+  static void ParallelFor(const CTask &task, size_t count, size_t grain = 1);
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -13,15 +13,61 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <thread>
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "runtime/device/cpu/mpi/mpi_adapter.h"
 #include "ir/primitive.h"
+#include "ir/tensor.h"
+#include "common/utils.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+// Sorting the ids by row pays off when reading the table is far slower than writing the output, e.g. a table on a
+// remote numa node. Otherwise gathering in index order with prefetch is faster, so it is the default.
+constexpr auto kSortIndicesEnv = "MS_CPU_EMBEDDING_SORT_INDICES";
+// smaller batches are always gathered in index order
+constexpr size_t kSortIndicesThreshold = 4096;
+constexpr size_t kRadixBits = 11;
+constexpr size_t kRadixBucketNum = 1 << kRadixBits;
+constexpr size_t kPositionBits = 32;
+constexpr uint64_t kPositionMask = (static_cast<uint64_t>(1) << kPositionBits) - 1;
+// rows fetched ahead of the one being copied
+constexpr size_t kPrefetchDistance = 8;
+// only the head of a long row is prefetched, the hardware prefetcher picks up the rest
+constexpr size_t kMaxPrefetchBytes = 1024;
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kParallelGrain = 256;
+
+inline void PrefetchRow(const void *row, size_t lens) {
+#if defined(__GNUC__)
+  auto addr = static_cast<const char *>(row);
+  lens = std::min(lens, kMaxPrefetchBytes);
+  for (size_t i = 0; i < lens; i += kCacheLineSize) {
+    __builtin_prefetch(addr + i, 0, 1);
+  }
+#endif
+}
+
+inline void CopyRow(void *dst, const void *src, size_t lens) {
+  auto ret = memcpy_s(dst, lens, src, lens);
+  if (ret != EOK) {
+    MS_LOG(EXCEPTION) << "LookUpTable task memcpy failed.";
+  }
+}
+
+inline void ZeroRow(void *dst, size_t lens) {
+  auto ret = memset_s(dst, lens, 0, lens);
+  if (ret != EOK) {
+    MS_LOG(EXCEPTION) << "LookUpTable task memset failed.";
+  }
+}
+}  // namespace
+
 void EmbeddingLookUpCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   CheckParam(kernel_node);
   input_shape_ = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
@@ -39,6 +85,11 @@ void EmbeddingLookUpCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (AnfAlgo::HasNodeAttr(kAttrReduceScatterFlag, kernel_node)) {
     reduce_scatter_flag_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrReduceScatterFlag);
   }
+  dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
+  if (reduce_scatter_flag_ && dtype_ != kNumberTypeFloat32) {
+    MS_LOG(EXCEPTION) << "EmbeddingLookUpCPUKernel only supports float32 with reduce_scatter_flag, but got "
+                      << TypeIdLabel(dtype_);
+  }
 #ifdef ENABLE_MPI
   if (reduce_scatter_flag_) {
     size_t gatherv2_out_lens = 1;
@@ -77,31 +128,31 @@ void EmbeddingLookUpCPUKernel::InitKernel(const CNodePtr &kernel_node) {
 bool EmbeddingLookUpCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                                       const std::vector<kernel::AddressPtr> & /*workspace*/,
                                       const std::vector<kernel::AddressPtr> &outputs) {
-  auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
-  float *gather_out_addr = reduce_scatter_flag_ ? reinterpret_cast<float *>(gather_v2_out_) : output_addr;
-  size_t dim0 = input_shape_[0];
-  size_t dim1 = input_shape_[1];
-  size_t dim2 = input_shape_[2];
-  if (axis_ == 3) {
-    for (size_t i = 0; i < dim0; ++i) {
-      for (size_t j = 0; j < dim1; ++j) {
-        for (size_t k = 0; k < dim2; ++k) {
-          LookUpTable(inputs, i, j, k, &gather_out_addr);
-        }
-      }
-    }
-  } else if (axis_ == 2) {
-    for (size_t i = 0; i < dim0; ++i) {
-      for (size_t j = 0; j < dim1; ++j) {
-        LookUpTable(inputs, i, j, 0, &gather_out_addr);
-      }
-    }
-  } else if (axis_ == 1) {
-    for (size_t i = 0; i < dim0; ++i) {
-      LookUpTable(inputs, i, 0, 0, &gather_out_addr);
-    }
-  } else if (axis_ == 0) {
-    LookUpTable(inputs, 0, 0, 0, &gather_out_addr);
+  if (dtype_ == kNumberTypeFloat16) {
+    LaunchKernel<float16>(inputs, outputs);
+  } else {
+    LaunchKernel<float>(inputs, outputs);
+  }
+  return true;
+}
+
+template <typename T>
+void EmbeddingLookUpCPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr> &inputs,
+                                            const std::vector<kernel::AddressPtr> &outputs) {
+  auto output_addr = reinterpret_cast<T *>(outputs[0]->addr);
+  T *gather_out_addr = reduce_scatter_flag_ ? reinterpret_cast<T *>(gather_v2_out_) : output_addr;
+  auto input_addr = reinterpret_cast<T *>(inputs[0]->addr);
+  auto indices_addr = reinterpret_cast<int *>(inputs[1]->addr);
+  // every position of the dims before axis_ holds a [first_dim_size_, row_size_] table, usually there is just one
+  size_t outer_num = 1;
+  for (int i = 0; i < axis_; ++i) {
+    outer_num *= input_shape_[IntToSize(i)];
+  }
+  first_dim_size_ = input_shape_[IntToSize(axis_)];
+  row_size_ = CPUKernelUtils::GetElementNumOnAxis(input_shape_, axis_);
+  for (size_t i = 0; i < outer_num; ++i) {
+    GatherRows(input_addr + i * first_dim_size_ * row_size_, indices_addr,
+               gather_out_addr + i * indices_lens_ * row_size_);
   }
 #ifdef ENABLE_MPI
   if (reduce_scatter_flag_) {
@@ -112,88 +163,108 @@ bool EmbeddingLookUpCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inp
     MS_EXCEPTION_IF_NULL(mpi_instance);
     for (int i = 0; i < split_num_; i++) {
       mpi_instance->ReduceScatter(reinterpret_cast<float *>(gather_v2_out_) + i * one_split_lens,
-                                  output_addr + i * reduce_scatter_out_lens, group, one_split_lens / 8, "sum");
+                                  reinterpret_cast<float *>(output_addr) + i * reduce_scatter_out_lens, group,
+                                  one_split_lens / 8, "sum");
     }
   }
 #endif
-  return true;
 }
 
-void LookUpTable_task(const float *input_addr, float *output_addr, const int *indices_addr, size_t indices_lens,
-                      size_t num, size_t dim0, size_t dim1, size_t dim2, int offset, size_t axis,
-                      std::vector<size_t> input_shape, size_t input_lens) {
-  size_t lens = num * sizeof(float);
-  for (size_t i = 0; i < indices_lens; ++i) {
-    int indices = indices_addr[i] - offset;
-    if (indices >= 0) {
-      size_t index = IntToSize(indices);
-      if (index < input_shape[axis]) {
-        size_t pos = 0;
-        if (axis == 3) {
-          pos = CPUKernelUtils::CalcOffset(input_shape, dim0, dim1, dim2, index);
-        } else if (axis == 2) {
-          pos = CPUKernelUtils::CalcOffset(input_shape, dim0, dim1, index, 0);
-        } else if (axis == 1) {
-          pos = CPUKernelUtils::CalcOffset(input_shape, dim0, index, 0, 0);
-        } else if (axis == 0) {
-          pos = CPUKernelUtils::CalcOffset(input_shape, index, 0, 0, 0);
-        }
-        if (pos + num <= input_lens) {
-          auto ret = memcpy_s(output_addr, lens, input_addr + pos, lens);
-          if (ret != EOK) {
-            MS_LOG(EXCEPTION) << "LookUpTable task memcpy failed.";
-          }
-        } else {
-          auto ret = memset_s(output_addr, lens, 0, lens);
-          if (ret != EOK) {
-            MS_LOG(EXCEPTION) << "LookUpTable task memset failed.";
-          }
-        }
-      } else {
-        auto ret = memset_s(output_addr, lens, 0, lens);
-        if (ret != EOK) {
-          MS_LOG(EXCEPTION) << "LookUpTable task memset failed.";
-        }
+bool EmbeddingLookUpCPUKernel::GetRow(int index, size_t *row) const {
+  int local_index = index - offset_;
+  if (local_index < 0 || IntToSize(local_index) >= first_dim_size_) {
+    return false;
+  }
+  *row = IntToSize(local_index);
+  return (*row + 1) * row_size_ <= input_lens_;
+}
+
+template <typename T>
+void EmbeddingLookUpCPUKernel::GatherRows(const T *table, const int *indices, T *output) const {
+  MS_EXCEPTION_IF_NULL(table);
+  MS_EXCEPTION_IF_NULL(indices);
+  MS_EXCEPTION_IF_NULL(output);
+  static const bool sort_indices = common::GetEnv(kSortIndicesEnv) == "1";
+  if (sort_indices && indices_lens_ >= kSortIndicesThreshold && indices_lens_ <= kPositionMask &&
+      first_dim_size_ <= kPositionMask) {
+    GatherRowsByRow(table, indices, output);
+  } else {
+    GatherRowsInOrder(table, indices, output);
+  }
+}
+
+template <typename T>
+void EmbeddingLookUpCPUKernel::GatherRowsInOrder(const T *table, const int *indices, T *output) const {
+  size_t lens = row_size_ * sizeof(T);
+  auto task = [this, table, indices, output, lens](size_t start, size_t end) {
+    size_t row = 0;
+    for (size_t i = start; i < end; ++i) {
+      if (i + kPrefetchDistance < end && GetRow(indices[i + kPrefetchDistance], &row)) {
+        PrefetchRow(table + row * row_size_, lens);
       }
-    } else {
-      auto ret = memset_s(output_addr, lens, 0, lens);
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "LookUpTable task memset failed.";
+      if (GetRow(indices[i], &row)) {
+        CopyRow(output + i * row_size_, table + row * row_size_, lens);
+      } else {
+        ZeroRow(output + i * row_size_, lens);
       }
     }
-    output_addr += num;
-  }
+  };
+  CPUKernelUtils::ParallelFor(task, indices_lens_, kParallelGrain);
 }
 
-void EmbeddingLookUpCPUKernel::LookUpTable(const std::vector<kernel::AddressPtr> &inputs, size_t dim0, size_t dim1,
-                                           size_t dim2, float **output_addr) {
-  auto input_addr = reinterpret_cast<float *>(inputs[0]->addr);
-  auto indices_addr = reinterpret_cast<int *>(inputs[1]->addr);
-  size_t num = CPUKernelUtils::GetElementNumOnAxis(input_shape_, axis_);
-  float *task_out_addr = *output_addr;
-  const size_t thread_num = 8;
-  std::thread threads[8];
-  size_t task_proc_lens = (indices_lens_ + thread_num - 1) / thread_num;
-  size_t i;
-  size_t task_offset = 0;
-  MS_LOG(DEBUG) << "indices_lens_: " << indices_lens_ << " one task proc lens:" << task_proc_lens;
-  for (i = 0; i < thread_num; i++) {
-    if (task_offset >= indices_lens_) {
-      break;
+template <typename T>
+void EmbeddingLookUpCPUKernel::GatherRowsByRow(const T *table, const int *indices, T *output) const {
+  size_t lens = row_size_ * sizeof(T);
+  // key = row << 32 | position, the ids out of this table get their outputs zeroed and are left out
+  std::vector<uint64_t> keys;
+  keys.reserve(indices_lens_);
+  size_t row = 0;
+  for (size_t i = 0; i < indices_lens_; ++i) {
+    if (GetRow(indices[i], &row)) {
+      keys.push_back((static_cast<uint64_t>(row) << kPositionBits) | i);
+    } else {
+      ZeroRow(output + i * row_size_, lens);
+    }
+  }
+  // lsd radix sort on the row bits, it is stable, so the positions of one row stay in ascending order
+  std::vector<uint64_t> sorted_keys(keys.size());
+  std::vector<size_t> bucket_offsets(kRadixBucketNum);
+  for (size_t shift = kPositionBits; (first_dim_size_ - 1) >> (shift - kPositionBits) > 0; shift += kRadixBits) {
+    std::fill(bucket_offsets.begin(), bucket_offsets.end(), 0);
+    for (auto key : keys) {
+      bucket_offsets[(key >> shift) & (kRadixBucketNum - 1)]++;
     }
-    MS_LOG(DEBUG) << "task_offset: " << task_offset << " task_proc_lenss:" << task_proc_lens;
-    threads[i] =
-      std::thread(LookUpTable_task, input_addr, task_out_addr + task_offset * num, indices_addr + task_offset,
-                  task_proc_lens, num, dim0, dim1, dim2, offset_, axis_, input_shape_, input_lens_);
-    task_offset += task_proc_lens;
-    if (task_offset + task_proc_lens > indices_lens_) {
-      task_proc_lens = indices_lens_ - task_offset;
+    size_t offset = 0;
+    for (auto &bucket_offset : bucket_offsets) {
+      std::swap(offset, bucket_offset);
+      offset += bucket_offset;
     }
+    for (auto key : keys) {
+      sorted_keys[bucket_offsets[(key >> shift) & (kRadixBucketNum - 1)]++] = key;
+    }
+    keys.swap(sorted_keys);
   }
-  for (size_t j = 0; j < i; j++) {
-    threads[j].join();
+
+  // every distinct row is fetched once and copied to all the outputs that ask for it
+  std::vector<size_t> unique_offsets;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (i == 0 || (keys[i] >> kPositionBits) != (keys[i - 1] >> kPositionBits)) {
+      unique_offsets.push_back(i);
+    }
   }
-  *output_addr += num * indices_lens_;
+  unique_offsets.push_back(keys.size());
+  auto task = [this, table, output, lens, &keys, &unique_offsets](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      if (i + kPrefetchDistance < end) {
+        PrefetchRow(table + (keys[unique_offsets[i + kPrefetchDistance]] >> kPositionBits) * row_size_, lens);
+      }
+      const T *src = table + (keys[unique_offsets[i]] >> kPositionBits) * row_size_;
+      for (size_t j = unique_offsets[i]; j < unique_offsets[i + 1]; ++j) {
+        CopyRow(output + (keys[j] & kPositionMask) * row_size_, src, lens);
+      }
+    }
+  };
+  CPUKernelUtils::ParallelFor(task, unique_offsets.size() - 1, kParallelGrain);
 }
 
 void EmbeddingLookUpCPUKernel::CheckParam(const CNodePtr &kernel_node) {
@@ -31,6 +31,8 @@ class EmbeddingLookUpCPUKernel : public CPUKernel {
     input_lens_ = 0;
     indices_lens_ = 0;
     gatherv2_out_lens_ = 0;
+    first_dim_size_ = 0;
+    row_size_ = 0;
     reduce_scatter_flag_ = false;
     gather_v2_out_ = nullptr;
   }
@@ -47,8 +49,18 @@ class EmbeddingLookUpCPUKernel : public CPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
-  void LookUpTable(const std::vector<kernel::AddressPtr> &inputs, size_t dim0, size_t dim1, size_t dim2,
-                   float **output_addr);
+  // Copy the rows picked by indices into output, rows out of this table are filled with zero. GatherRowsInOrder
+  // prefetches the rows a few ids ahead. GatherRowsByRow radix sorts the ids by row first, so every distinct row is
+  // read from the table once and the reads go in address order.
+  template <typename T>
+  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
+  template <typename T>
+  void GatherRows(const T *table, const int *indices, T *output) const;
+  template <typename T>
+  void GatherRowsInOrder(const T *table, const int *indices, T *output) const;
+  template <typename T>
+  void GatherRowsByRow(const T *table, const int *indices, T *output) const;
+  bool GetRow(int index, size_t *row) const;
   void CheckParam(const CNodePtr &kernel_node);
   std::vector<size_t> input_shape_;
   std::vector<size_t> indices_shape_;
@@ -59,7 +71,11 @@ class EmbeddingLookUpCPUKernel : public CPUKernel {
   size_t input_lens_;
   size_t indices_lens_;
   size_t gatherv2_out_lens_;
+  // rows in the table and floats in one row, taken from input_shape_ at launch
+  size_t first_dim_size_;
+  size_t row_size_;
   bool reduce_scatter_flag_;
+  TypeId dtype_{kNumberTypeFloat32};
 
   void *gather_v2_out_;
 };
@@ -68,6 +84,10 @@ MS_REG_CPU_KERNEL(
   EmbeddingLookup,
   KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeFloat32),
   EmbeddingLookUpCPUKernel);
+MS_REG_CPU_KERNEL(
+  EmbeddingLookup,
+  KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeFloat16),
+  EmbeddingLookUpCPUKernel);
 }  // namespace kernel
 }  // namespace mindspore
 
@@ -0,0 +1,422 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/fused_elemwise_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include "backend/kernel_compiler/cpu/simd_utils.h"
+#include "runtime/device/convert_tensor_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// floats of one register in a tile, the registers of a whole program stay in L1
+constexpr size_t kTileSize = 1024;
+constexpr size_t kParallelGrain = 16384;
+
+const std::map<std::string, std::pair<ElemwiseOpType, size_t>> kElemwiseOps = {
+  {"TensorAdd", {kElemwiseAdd, 2}},  {"BiasAdd", {kElemwiseAdd, 2}},         {"AddN", {kElemwiseAdd, 0}},
+  {"Sub", {kElemwiseSub, 2}},        {"Mul", {kElemwiseMul, 2}},             {"RealDiv", {kElemwiseDiv, 2}},
+  {"Maximum", {kElemwiseMaximum, 2}}, {"Minimum", {kElemwiseMinimum, 2}},    {"Neg", {kElemwiseNeg, 1}},
+  {"Square", {kElemwiseSquare, 1}},  {"Sqrt", {kElemwiseSqrt, 1}},           {"Exp", {kElemwiseExp, 1}},
+  {"ReLU", {kElemwiseRelu, 1}},      {"ReluGrad", {kElemwiseReluGrad, 2}}};
+
+struct AddOp {
+  static constexpr bool kVectorized = true;
+  static constexpr SimdOpType kSimdOp = kSimdAdd;
+  static float Apply(float a, float b) { return a + b; }
+};
+
+struct SubOp {
+  static constexpr bool kVectorized = true;
+  static constexpr SimdOpType kSimdOp = kSimdSub;
+  static float Apply(float a, float b) { return a - b; }
+};
+
+struct MulOp {
+  static constexpr bool kVectorized = true;
+  static constexpr SimdOpType kSimdOp = kSimdMul;
+  static float Apply(float a, float b) { return a * b; }
+};
+
+struct DivOp {
+  static constexpr bool kVectorized = true;
+  static constexpr SimdOpType kSimdOp = kSimdDiv;
+  static float Apply(float a, float b) { return a / b; }
+};
+
+struct MaximumOp {
+  static constexpr bool kVectorized = true;
+  static constexpr SimdOpType kSimdOp = kSimdMax;
+  static float Apply(float a, float b) { return a > b ? a : b; }
+};
+
+struct MinimumOp {
+  static constexpr bool kVectorized = true;
+  static constexpr SimdOpType kSimdOp = kSimdMin;
+  static float Apply(float a, float b) { return a < b ? a : b; }
+};
+
+// inputs are (dy, x)
+struct ReluGradOp {
+  static constexpr bool kVectorized = true;
+  static constexpr SimdOpType kSimdOp = kSimdReluGrad;
+  static float Apply(float dy, float x) { return x > 0 ? dy : 0; }
+};
+
+struct NegOp {
+  static constexpr bool kVectorized = true;
+  static constexpr SimdOpType kSimdOp = kSimdNeg;
+  static float Apply(float a) { return -a; }
+};
+
+struct SquareOp {
+  static constexpr bool kVectorized = true;
+  static constexpr SimdOpType kSimdOp = kSimdSquare;
+  static float Apply(float a) { return a * a; }
+};
+
+struct SqrtOp {
+  static constexpr bool kVectorized = true;
+  static constexpr SimdOpType kSimdOp = kSimdSqrt;
+  static float Apply(float a) { return std::sqrt(a); }
+};
+
+struct ReluOp {
+  static constexpr bool kVectorized = true;
+  static constexpr SimdOpType kSimdOp = kSimdRelu;
+  static float Apply(float a) { return a > 0 ? a : 0; }
+};
+
+// there is no vector exp in the wrappers, the scalar loop is left to the compiler
+struct ExpOp {
+  static constexpr bool kVectorized = false;
+  static float Apply(float a) { return std::exp(a); }
+};
+
+template <typename Op, bool kScalarA, bool kScalarB>
+void BinaryLoop(const float *a, const float *b, float *dst, size_t len) {
+  size_t i = 0;
+  if constexpr (Op::kVectorized) {
+    i = SimdBinary(Op::kSimdOp, a, kScalarA, b, kScalarB, dst, len);
+  }
+  for (; i < len; ++i) {
+    dst[i] = Op::Apply(kScalarA ? a[0] : a[i], kScalarB ? b[0] : b[i]);
+  }
+}
+
+template <typename Op>
+void UnaryLoop(const float *a, float *dst, size_t len) {
+  size_t i = 0;
+  if constexpr (Op::kVectorized) {
+    i = SimdUnary(Op::kSimdOp, a, dst, len);
+  }
+  for (; i < len; ++i) {
+    dst[i] = Op::Apply(a[i]);
+  }
+}
+
+// a register broadcast along the tile is read as a[0], the loops are specialized so that it is loaded once
+template <typename Op>
+void Binary(const float *a, bool scalar_a, const float *b, bool scalar_b, float *dst, size_t len) {
+  if (scalar_a && !scalar_b) {
+    BinaryLoop<Op, true, false>(a, b, dst, len);
+  } else if (!scalar_a && scalar_b) {
+    BinaryLoop<Op, false, true>(a, b, dst, len);
+  } else {
+    BinaryLoop<Op, false, false>(a, b, dst, len);
+  }
+}
+
+void RunBinary(ElemwiseOpType op_type, const float *a, bool scalar_a, const float *b, bool scalar_b, float *dst,
+               size_t len) {
+  switch (op_type) {
+    case kElemwiseAdd:
+      Binary<AddOp>(a, scalar_a, b, scalar_b, dst, len);
+      break;
+    case kElemwiseSub:
+      Binary<SubOp>(a, scalar_a, b, scalar_b, dst, len);
+      break;
+    case kElemwiseMul:
+      Binary<MulOp>(a, scalar_a, b, scalar_b, dst, len);
+      break;
+    case kElemwiseDiv:
+      Binary<DivOp>(a, scalar_a, b, scalar_b, dst, len);
+      break;
+    case kElemwiseMaximum:
+      Binary<MaximumOp>(a, scalar_a, b, scalar_b, dst, len);
+      break;
+    case kElemwiseMinimum:
+      Binary<MinimumOp>(a, scalar_a, b, scalar_b, dst, len);
+      break;
+    case kElemwiseReluGrad:
+      Binary<ReluGradOp>(a, scalar_a, b, scalar_b, dst, len);
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "Elemwise op " << op_type << " is not binary";
+  }
+}
+
+void RunUnary(ElemwiseOpType op_type, const float *a, float *dst, size_t len) {
+  switch (op_type) {
+    case kElemwiseNeg:
+      UnaryLoop<NegOp>(a, dst, len);
+      break;
+    case kElemwiseSquare:
+      UnaryLoop<SquareOp>(a, dst, len);
+      break;
+    case kElemwiseSqrt:
+      UnaryLoop<SqrtOp>(a, dst, len);
+      break;
+    case kElemwiseExp:
+      UnaryLoop<ExpOp>(a, dst, len);
+      break;
+    case kElemwiseRelu:
+      UnaryLoop<ReluOp>(a, dst, len);
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "Elemwise op " << op_type << " is not unary";
+  }
+}
+}  // namespace
+
+bool FusedElemwiseCPUKernel::GetElemwiseOp(const std::string &op_name, ElemwiseOpType *op_type, size_t *input_num) {
+  auto iter = kElemwiseOps.find(op_name);
+  if (iter == kElemwiseOps.end()) {
+    return false;
+  }
+  if (op_type != nullptr) {
+    *op_type = iter->second.first;
+  }
+  if (input_num != nullptr) {
+    *input_num = iter->second.second;
+  }
+  return true;
+}
+
+void FusedElemwiseCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  input_num_ = AnfAlgo::GetInputTensorNum(kernel_node);
+  auto ops = AnfAlgo::GetNodeAttr<std::vector<std::string>>(kernel_node, kAttrFusedOps);
+  auto operands = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, kAttrFusedOperands);
+  auto operand_nums = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, kAttrFusedOperandNums);
+  auto dim_offsets = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, kAttrInputDimOffsets);
+  InitProgram(ops, operands, operand_nums);
+  std::vector<std::vector<size_t>> input_shapes;
+  for (size_t i = 0; i < input_num_; ++i) {
+    input_shapes.emplace_back(AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i));
+  }
+  output_shape_ = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  InitStrides(input_shapes, dim_offsets);
+  dtype_ = AnfAlgo::GetOutputDeviceDataType(kernel_node, 0);
+}
+
+void FusedElemwiseCPUKernel::InitProgram(const std::vector<std::string> &ops, const std::vector<int> &operands,
+                                         const std::vector<int> &operand_nums) {
+  if (ops.empty() || ops.size() != operand_nums.size()) {
+    MS_LOG(EXCEPTION) << "Fused elemwise op num " << ops.size() << " mismatches operand num " << operand_nums.size();
+  }
+  program_.clear();
+  size_t pos = 0;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    Instruction instruction;
+    size_t input_num = 0;
+    if (!GetElemwiseOp(ops[i], &instruction.op_type, &input_num)) {
+      MS_LOG(EXCEPTION) << "Op " << ops[i] << " can not be fused into cpu elemwise kernel";
+    }
+    auto operand_num = IntToSize(operand_nums[i]);
+    if ((input_num != 0 && operand_num != input_num) || (input_num == 0 && operand_num < 2)) {
+      MS_LOG(EXCEPTION) << "Op " << ops[i] << " gets wrong operand num " << operand_num;
+    }
+    if (pos + operand_num > operands.size()) {
+      MS_LOG(EXCEPTION) << "Fused elemwise operands are out of range";
+    }
+    for (size_t j = 0; j < operand_num; ++j) {
+      auto operand = IntToSize(operands[pos + j]);
+      // an instruction only reads the inputs and the results of the instructions before it
+      if (operand >= input_num_ + i) {
+        MS_LOG(EXCEPTION) << "Op " << ops[i] << " reads register " << operand << " before it is written";
+      }
+      instruction.operands.push_back(operand);
+    }
+    pos += operand_num;
+    program_.emplace_back(std::move(instruction));
+  }
+}
+
+void FusedElemwiseCPUKernel::InitStrides(const std::vector<std::vector<size_t>> &input_shapes,
+                                         const std::vector<int> &dim_offsets) {
+  if (input_shapes.size() != input_num_ || (!dim_offsets.empty() && dim_offsets.size() != input_num_)) {
+    MS_LOG(EXCEPTION) << "Fused elemwise input num " << input_num_ << " mismatches its shapes or dim offsets";
+  }
+  size_t rank = output_shape_.size();
+  // strides of every input over the output dims, inputs are aligned to the output at their dim offset
+  std::vector<std::vector<size_t>> strides(input_num_, std::vector<size_t>(rank, 0));
+  for (size_t i = 0; i < input_num_; ++i) {
+    const auto &shape = input_shapes[i];
+    size_t offset = dim_offsets.empty() ? rank - std::min(rank, shape.size()) : IntToSize(dim_offsets[i]);
+    if (offset + shape.size() > rank) {
+      MS_LOG(EXCEPTION) << "Input " << i << " of rank " << shape.size() << " does not fit output rank " << rank
+                        << " at dim " << offset;
+    }
+    size_t stride = 1;
+    for (size_t j = shape.size(); j > 0; --j) {
+      size_t dim = offset + j - 1;
+      if (shape[j - 1] != 1 && shape[j - 1] != output_shape_[dim]) {
+        MS_LOG(EXCEPTION) << "Input " << i << " can not broadcast on dim " << dim << ", " << shape[j - 1] << " vs "
+                          << output_shape_[dim];
+      }
+      strides[i][dim] = shape[j - 1] == 1 ? 0 : stride;
+      stride *= shape[j - 1];
+    }
+  }
+  // drop the dims of size 1 and merge neighbour dims that every input walks in the same way
+  std::vector<size_t> merged_shape;
+  input_strides_.assign(input_num_, {});
+  for (size_t dim = 0; dim < rank; ++dim) {
+    if (output_shape_[dim] == 1) {
+      continue;
+    }
+    bool can_merge = !merged_shape.empty();
+    for (size_t i = 0; i < input_num_ && can_merge; ++i) {
+      can_merge = input_strides_[i].back() == strides[i][dim] * output_shape_[dim];
+    }
+    if (can_merge) {
+      merged_shape.back() *= output_shape_[dim];
+      for (size_t i = 0; i < input_num_; ++i) {
+        input_strides_[i].back() = strides[i][dim];
+      }
+      continue;
+    }
+    merged_shape.push_back(output_shape_[dim]);
+    for (size_t i = 0; i < input_num_; ++i) {
+      input_strides_[i].push_back(strides[i][dim]);
+    }
+  }
+  if (merged_shape.empty()) {
+    merged_shape.push_back(1);
+    for (auto &input_stride : input_strides_) {
+      input_stride.push_back(0);
+    }
+  }
+  output_shape_ = merged_shape;
+  output_size_ = 1;
+  for (auto dim : output_shape_) {
+    output_size_ *= dim;
+  }
+}
+
+void FusedElemwiseCPUKernel::RunTile(std::vector<Register> *registers, float *buffer, float *output,
+                                     size_t len) const {
+  for (size_t i = 0; i < program_.size(); ++i) {
+    const auto &instruction = program_[i];
+    bool last = i + 1 == program_.size();
+    float *dst = last ? output : buffer + i * kTileSize;
+    bool scalar = std::all_of(instruction.operands.begin(), instruction.operands.end(),
+                              [registers](size_t operand) { return (*registers)[operand].scalar; });
+    // an instruction on broadcast values only is worked out once
+    size_t dst_len = scalar ? 1 : len;
+    const auto &first = (*registers)[instruction.operands[0]];
+    if (instruction.operands.size() == 1) {
+      RunUnary(instruction.op_type, first.data, dst, dst_len);
+    } else {
+      const auto &second = (*registers)[instruction.operands[1]];
+      RunBinary(instruction.op_type, first.data, first.scalar, second.data, second.scalar, dst, dst_len);
+      for (size_t j = 2; j < instruction.operands.size(); ++j) {
+        const auto &next = (*registers)[instruction.operands[j]];
+        RunBinary(instruction.op_type, dst, scalar, next.data, next.scalar, dst, dst_len);
+      }
+    }
+    (*registers)[input_num_ + i] = {dst, scalar};
+    if (last && scalar) {
+      std::fill(output + 1, output + len, output[0]);
+    }
+  }
+}
+
+bool FusedElemwiseCPUKernel::Launch(const std::vector<AddressPtr> &inputs,
+                                    const std::vector<AddressPtr> & /*workspace*/,
+                                    const std::vector<AddressPtr> &outputs) {
+  if (inputs.size() != input_num_ || outputs.size() != 1) {
+    MS_LOG(EXCEPTION) << "Fused elemwise kernel needs " << input_num_ << " inputs and 1 output, but gets "
+                      << inputs.size() << " inputs and " << outputs.size() << " outputs";
+  }
+  // an empty output has nothing to compute, and its inner dim may be 0
+  if (output_size_ == 0) {
+    return true;
+  }
+  // float16 tiles are widened into float buffers on the way in and narrowed on the way out
+  bool half = dtype_ == kNumberTypeFloat16;
+  size_t type_size = half ? sizeof(float16) : sizeof(float);
+  std::vector<const uint8_t *> input_addrs;
+  for (const auto &input : inputs) {
+    input_addrs.push_back(static_cast<const uint8_t *>(input->addr));
+  }
+  auto output_addr = static_cast<uint8_t *>(outputs[0]->addr);
+  size_t rank = output_shape_.size();
+  size_t inner_size = output_shape_.back();
+  size_t tile_num = (inner_size + kTileSize - 1) / kTileSize;
+  size_t task_num = output_size_ / inner_size * tile_num;
+  size_t grain = std::max<size_t>(1, kParallelGrain / std::min(inner_size, kTileSize));
+  auto task = [&](size_t start, size_t end) {
+    std::vector<float> buffer(program_.size() * kTileSize);
+    std::vector<float> half_buffer(half ? (input_num_ + 1) * kTileSize : 0);
+    std::vector<Register> registers(input_num_ + program_.size());
+    std::vector<size_t> offsets(input_num_, 0);
+    size_t current_row = output_size_;
+    for (size_t pos = start; pos < end; ++pos) {
+      size_t row = pos / tile_num;
+      size_t begin = (pos % tile_num) * kTileSize;
+      size_t len = std::min(kTileSize, inner_size - begin);
+      if (row != current_row) {
+        current_row = row;
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (size_t dim = rank - 1, index = row; dim > 0; --dim) {
+          size_t coord = index % output_shape_[dim - 1];
+          index /= output_shape_[dim - 1];
+          for (size_t i = 0; i < input_num_; ++i) {
+            offsets[i] += coord * input_strides_[i][dim - 1];
+          }
+        }
+      }
+      for (size_t i = 0; i < input_num_; ++i) {
+        bool scalar = input_strides_[i].back() == 0;
+        auto input = input_addrs[i] + (offsets[i] + (scalar ? 0 : begin)) * type_size;
+        if (half) {
+          float *tile = half_buffer.data() + i * kTileSize;
+          device::HalfToFloat(tile, input, scalar ? 1 : len);
+          registers[i] = {tile, scalar};
+        } else {
+          registers[i] = {reinterpret_cast<const float *>(input), scalar};
+        }
+      }
+      auto output = output_addr + (row * inner_size + begin) * type_size;
+      if (half) {
+        float *tile = half_buffer.data() + input_num_ * kTileSize;
+        RunTile(&registers, buffer.data(), tile, len);
+        device::FloatToHalf(output, tile, len);
+      } else {
+        RunTile(&registers, buffer.data(), reinterpret_cast<float *>(output), len);
+      }
+    }
+  };
+  CPUKernelUtils::ParallelFor(task, task_num, grain);
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+#include <vector>
+#include <memory>
+#include <string>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+enum ElemwiseOpType {
+  kElemwiseAdd = 0,
+  kElemwiseSub,
+  kElemwiseMul,
+  kElemwiseDiv,
+  kElemwiseMaximum,
+  kElemwiseMinimum,
+  kElemwiseNeg,
+  kElemwiseSquare,
+  kElemwiseSqrt,
+  kElemwiseExp,
+  kElemwiseRelu,
+  kElemwiseReluGrad,
+};
+
+// Runs a group of elementwise ops merged by the cpu elementwise fusion pass in one pass over memory.
+// The group is a small register program: registers [0, input_num) hold the inputs, instruction i writes register
+// input_num + i and the last instruction gives the output. The program runs on tiles of the innermost output dim,
+// so the intermediate values stay in L1. Inputs broadcast along the tile are kept as scalars. Float16 tensors are
+// computed in float32 tile by tile.
+class FusedElemwiseCPUKernel : public CPUKernel {
+ public:
+  FusedElemwiseCPUKernel() = default;
+  ~FusedElemwiseCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+  // the ops the fused kernel can run, with the number of inputs they take, 0 means any number above one
+  static bool GetElemwiseOp(const std::string &op_name, ElemwiseOpType *op_type, size_t *input_num);
+
+ private:
+  struct Instruction {
+    ElemwiseOpType op_type;
+    std::vector<size_t> operands;
+  };
+  // a register points either at a tile of values or at a single value broadcast along the tile
+  struct Register {
+    const float *data{nullptr};
+    bool scalar{false};
+  };
+  void InitProgram(const std::vector<std::string> &ops, const std::vector<int> &operands,
+                   const std::vector<int> &operand_nums);
+  void InitStrides(const std::vector<std::vector<size_t>> &input_shapes, const std::vector<int> &dim_offsets);
+  void RunTile(std::vector<Register> *registers, float *buffer, float *output, size_t len) const;
+
+  size_t input_num_{0};
+  std::vector<Instruction> program_;
+  // output dims after merging, and the strides of every input over them, 0 for broadcast dims
+  std::vector<size_t> output_shape_;
+  std::vector<std::vector<size_t>> input_strides_;
+  size_t output_size_{1};
+  TypeId dtype_{kNumberTypeFloat32};
+};
+
+MS_REG_CPU_KERNEL(
+  CPUFusedElemwise,
+  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+  FusedElemwiseCPUKernel);
+MS_REG_CPU_KERNEL(
+  CPUFusedElemwise,
+  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+  FusedElemwiseCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
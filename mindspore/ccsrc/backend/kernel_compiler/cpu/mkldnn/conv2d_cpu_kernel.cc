@@ -23,15 +23,25 @@ namespace mindspore {
 namespace kernel {
 void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
-  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
-  std::vector<size_t> weight_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
-  std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  std::vector<size_t> src_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  std::vector<size_t> weight_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
+  std::vector<size_t> dst_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
   if (src_shape.size() != 4 || weight_shape.size() != 4) {
     MS_LOG(EXCEPTION) << "conv2d only support nchw input!";
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
-  dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
+  auto compute_type = dnnl::memory::data_type::f32;
+  if (dtype_ == kNumberTypeFloat16) {
+    compute_type = GetHalfComputeType(true);
+    size_t type_size = GetDataTypeSize(compute_type);
+    workspace_size_list_.emplace_back(GetElementNum(src_shape) * type_size);
+    workspace_size_list_.emplace_back(GetElementNum(weight_shape) * type_size);
+    workspace_size_list_.emplace_back(GetElementNum(dst_shape) * sizeof(float));
+  }
+  // the activations may come in the blocked layout of the neighbour kernels, the primitive picks its own layouts
+  dnnl::memory::desc src_desc = GetFormatMemDesc(src_shape, AnfAlgo::GetInputFormat(kernel_node, 0), compute_type);
+  dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape, compute_type);
+  dnnl::memory::desc dst_desc = GetFormatMemDesc(dst_shape, AnfAlgo::GetOutputFormat(kernel_node, 0));
 
   int kernel_size = SizeToInt(weight_shape[3]);
   auto stride_ori = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, STRIDE);
@@ -63,28 +73,48 @@ void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
-  dnnl::convolution_forward::desc desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+  dnnl::convolution_forward::desc desc = dnnl::convolution_forward::desc(
+    dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, GetAnyMemDesc(src_shape, compute_type),
+    GetAnyMemDesc(weight_shape, compute_type), GetAnyMemDesc(dst_shape), strides, dilates, padding_l, padding_r);
 
-  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
+  auto prim_desc =
+    dnnl::convolution_forward::primitive_desc(desc, GetPrimitiveAttr(), MKLKernelEngine::Get().engine());
+  std::vector<int64_t> params{stride, dilation};
+  params.insert(params.end(), int_padding_l.begin(), int_padding_l.end());
+  params.insert(params.end(), int_padding_r.begin(), int_padding_r.end());
+  auto key =
+    GetPrimitiveKey("conv2d", {prim_desc.src_desc(), prim_desc.weights_desc(), prim_desc.dst_desc()}, params);
+  CreatePrimitive<dnnl::convolution_forward>(key, prim_desc);
 
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
-  AddArgument(DNNL_ARG_DST, dst_desc);
+  AddReorderArgument(DNNL_ARG_SRC, src_desc, prim_desc.src_desc(), false);
+  AddReorderArgument(DNNL_ARG_WEIGHTS, weights_desc, prim_desc.weights_desc(), false);
+  AddReorderArgument(DNNL_ARG_DST, dst_desc, prim_desc.dst_desc(), true);
 }
 
 bool Conv2dCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
-                             const std::vector<kernel::AddressPtr> & /*workspace*/,
+                             const std::vector<kernel::AddressPtr> &workspace,
                              const std::vector<kernel::AddressPtr> &outputs) {
   if (inputs.size() < 2 || outputs.empty()) {
     MS_LOG(EXCEPTION) << "error input output size!";
   }
+  if (dtype_ == kNumberTypeFloat16) {
+    if (workspace.size() < 3) {
+      MS_LOG(EXCEPTION) << "conv2d float16 needs 3 workspaces, but got " << workspace.size();
+    }
+    auto compute_type = GetHalfComputeType(true);
+    WidenHalf(inputs[0], workspace[0], compute_type);
+    WidenHalf(inputs[1], workspace[1], compute_type);
+    SetArgumentHandle(DNNL_ARG_SRC, workspace[0]->addr);
+    SetArgumentHandle(DNNL_ARG_WEIGHTS, workspace[1]->addr);
+    SetArgumentHandle(DNNL_ARG_DST, workspace[2]->addr);
+    ExecutePrimitive(workspace);
+    NarrowToHalf(workspace[2], outputs[0]);
+    return true;
+  }
   SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
   SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
   SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
-  ExecutePrimitive();
+  ExecutePrimitive(workspace);
   return true;
 }
 }  // namespace kernel
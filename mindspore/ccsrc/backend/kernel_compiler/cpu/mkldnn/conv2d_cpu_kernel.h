@@ -31,12 +31,19 @@ class Conv2dCPUKernel : public MKLCPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  TypeId dtype_{kNumberTypeFloat32};
 };
 
 MS_REG_CPU_KERNEL(
   Conv2D,
   KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
   Conv2dCPUKernel);
+MS_REG_CPU_KERNEL(
+  Conv2D,
+  KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+  Conv2dCPUKernel);
 }  // namespace kernel
 }  // namespace mindspore
 
@@ -23,15 +23,15 @@ namespace mindspore {
 namespace kernel {
 void Conv2dGradInputCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
-  std::vector<size_t> src_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
-  std::vector<size_t> weight_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
-  std::vector<size_t> dst_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> src_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  std::vector<size_t> weight_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
+  std::vector<size_t> dst_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
   if (src_shape.size() != 4 || weight_shape.size() != 4) {
     MS_LOG(EXCEPTION) << "conv2d grad filter only support nchw input!";
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  dnnl::memory::desc src_desc = GetFormatMemDesc(src_shape, AnfAlgo::GetOutputFormat(kernel_node, 0));
   dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  dnnl::memory::desc dst_desc = GetFormatMemDesc(dst_shape, AnfAlgo::GetInputFormat(kernel_node, 0));
 
   int kernel_size = SizeToInt(weight_shape[3]);
   auto stride_ori = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, STRIDE);
@@ -58,26 +58,37 @@ void Conv2dGradInputCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
+  auto src_any_desc = GetAnyMemDesc(src_shape);
+  auto weights_any_desc = GetAnyMemDesc(weight_shape);
+  auto dst_any_desc = GetAnyMemDesc(dst_shape);
   dnnl::convolution_forward::desc forward_desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_any_desc,
+                                    weights_any_desc, dst_any_desc, strides, dilates, padding_l, padding_r);
 
   auto forward_prim_desc = dnnl::convolution_forward::primitive_desc(forward_desc, MKLKernelEngine::Get().engine());
 
-  dnnl::convolution_backward_data::desc backward_desc = dnnl::convolution_backward_data::desc(
-    dnnl::algorithm::convolution_auto, src_desc, weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+  dnnl::convolution_backward_data::desc backward_desc =
+    dnnl::convolution_backward_data::desc(dnnl::algorithm::convolution_auto, src_any_desc, weights_any_desc,
+                                          dst_any_desc, strides, dilates, padding_l, padding_r);
 
-  auto backward_prim_desc =
-    dnnl::convolution_backward_data::primitive_desc(backward_desc, MKLKernelEngine::Get().engine(), forward_prim_desc);
-  primitive_ = std::make_shared<dnnl::convolution_backward_data>(backward_prim_desc);
+  auto backward_prim_desc = dnnl::convolution_backward_data::primitive_desc(
+    backward_desc, GetPrimitiveAttr(), MKLKernelEngine::Get().engine(), forward_prim_desc);
+  std::vector<int64_t> params{stride, dilation};
+  params.insert(params.end(), int_padding_l.begin(), int_padding_l.end());
+  params.insert(params.end(), int_padding_r.begin(), int_padding_r.end());
+  auto key = GetPrimitiveKey(
+    "conv2d_grad_input",
+    {backward_prim_desc.diff_src_desc(), backward_prim_desc.weights_desc(), backward_prim_desc.diff_dst_desc()},
+    params);
+  CreatePrimitive<dnnl::convolution_backward_data>(key, backward_prim_desc);
 
-  AddArgument(DNNL_ARG_DIFF_SRC, src_desc);
-  AddArgument(DNNL_ARG_DIFF_DST, dst_desc);
-  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  AddReorderArgument(DNNL_ARG_DIFF_SRC, src_desc, backward_prim_desc.diff_src_desc(), true);
+  AddReorderArgument(DNNL_ARG_DIFF_DST, dst_desc, backward_prim_desc.diff_dst_desc(), false);
+  AddReorderArgument(DNNL_ARG_WEIGHTS, weights_desc, backward_prim_desc.weights_desc(), false);
 }
 
 bool Conv2dGradInputCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
-                                      const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                      const std::vector<kernel::AddressPtr> &workspace,
                                       const std::vector<kernel::AddressPtr> &outputs) {
   if (inputs.size() < 2 || outputs.empty()) {
     MS_LOG(EXCEPTION) << "error input output size!";
@@ -85,7 +96,7 @@ bool Conv2dGradInputCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inp
   SetArgumentHandle(DNNL_ARG_DIFF_DST, inputs[0]->addr);
   SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
   SetArgumentHandle(DNNL_ARG_DIFF_SRC, outputs[0]->addr);
-  ExecutePrimitive();
+  ExecutePrimitive(workspace);
   return true;
 }
 }  // namespace kernel
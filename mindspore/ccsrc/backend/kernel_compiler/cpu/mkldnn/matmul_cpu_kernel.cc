@@ -45,14 +45,73 @@ void MatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     trans_b_ = TRANSPOSE_YES;
   }
   dim_n_ = static_cast<dnnl_dim_t>(dst_shape[1]);
+  dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
+  if (dtype_ == kNumberTypeFloat16) {
+    InitHalfKernel();
+  }
+}
+
+void MatMulCPUKernel::InitHalfKernel() {
+  // the inner product takes a row major src and reads the weights as [n, k], a transposed b is just another layout
+  use_bf16_ = trans_a_ == TRANSPOSE_NO && GetHalfComputeType(true) == dnnl::memory::data_type::bf16;
+  auto bf16 = dnnl::memory::data_type::bf16;
+  dnnl::memory::desc src_desc({dim_m_, dim_k_}, bf16, dnnl::memory::format_tag::ab);
+  auto weights_tag = trans_b_ == TRANSPOSE_YES ? dnnl::memory::format_tag::ab : dnnl::memory::format_tag::ba;
+  dnnl::memory::desc weights_desc({dim_n_, dim_k_}, bf16, weights_tag);
+  dnnl::memory::desc dst_desc({dim_m_, dim_n_}, dnnl::memory::data_type::f32, dnnl::memory::format_tag::ab);
+  dnnl::inner_product_forward::primitive_desc prim_desc;
+  if (use_bf16_) {
+    try {
+      dnnl::inner_product_forward::desc desc(dnnl::prop_kind::forward_inference, src_desc, weights_desc, dst_desc);
+      prim_desc =
+        dnnl::inner_product_forward::primitive_desc(desc, GetPrimitiveAttr(), MKLKernelEngine::Get().engine());
+    } catch (const dnnl::error &e) {
+      MS_LOG(INFO) << "matmul has no bf16 implementation for the shape, use f32 instead: " << e.what();
+      use_bf16_ = false;
+    }
+  }
+  size_t type_size = use_bf16_ ? sizeof(uint16_t) : sizeof(float);
+  workspace_size_list_.emplace_back(LongToSize(dim_m_ * dim_k_) * type_size);
+  workspace_size_list_.emplace_back(LongToSize(dim_k_ * dim_n_) * type_size);
+  workspace_size_list_.emplace_back(LongToSize(dim_m_ * dim_n_) * sizeof(float));
+  if (use_bf16_) {
+    CreatePrimitive<dnnl::inner_product_forward>(GetPrimitiveKey("matmul", {src_desc, weights_desc, dst_desc}),
+                                                 prim_desc);
+    AddArgument(DNNL_ARG_SRC, src_desc);
+    AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+    AddArgument(DNNL_ARG_DST, dst_desc);
+  }
 }
 
 bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
-                             const std::vector<kernel::AddressPtr> & /*workspace*/,
+                             const std::vector<kernel::AddressPtr> &workspace,
                              const std::vector<kernel::AddressPtr> &outputs) {
   if (inputs.size() < 2 || outputs.empty()) {
     MS_LOG(EXCEPTION) << "matmul error input output size!";
   }
+  if (dtype_ == kNumberTypeFloat16) {
+    if (workspace.size() < 3) {
+      MS_LOG(EXCEPTION) << "matmul float16 needs 3 workspaces, but got " << workspace.size();
+    }
+    auto compute_type = use_bf16_ ? dnnl::memory::data_type::bf16 : dnnl::memory::data_type::f32;
+    WidenHalf(inputs[0], workspace[0], compute_type);
+    WidenHalf(inputs[1], workspace[1], compute_type);
+    if (use_bf16_) {
+      SetArgumentHandle(DNNL_ARG_SRC, workspace[0]->addr);
+      SetArgumentHandle(DNNL_ARG_WEIGHTS, workspace[1]->addr);
+      SetArgumentHandle(DNNL_ARG_DST, workspace[2]->addr);
+      ExecutePrimitive(workspace);
+    } else {
+      Gemm(workspace[0]->addr, workspace[1]->addr, workspace[2]->addr);
+    }
+    NarrowToHalf(workspace[2], outputs[0]);
+    return true;
+  }
+  Gemm(inputs[0]->addr, inputs[1]->addr, outputs[0]->addr);
+  return true;
+}
+
+void MatMulCPUKernel::Gemm(const void *input_a, const void *input_b, void *output) const {
   dnnl_dim_t lda = dim_m_;
   if (trans_a_ == TRANSPOSE_NO) {
     lda = dim_k_;
@@ -61,11 +120,8 @@ bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   if (trans_b_ == TRANSPOSE_NO) {
     ldb = dim_n_;
   }
-  auto input_a = reinterpret_cast<float *>(inputs[0]->addr);
-  auto input_b = reinterpret_cast<float *>(inputs[1]->addr);
-  auto output = reinterpret_cast<float *>(outputs[0]->addr);
-  (void)dnnl_sgemm(trans_a_, trans_b_, dim_m_, dim_n_, dim_k_, 1.f, input_a, lda, input_b, ldb, 0.f, output, dim_n_);
-  return true;
+  (void)dnnl_sgemm(trans_a_, trans_b_, dim_m_, dim_n_, dim_k_, 1.f, static_cast<const float *>(input_a), lda,
+                   static_cast<const float *>(input_b), ldb, 0.f, static_cast<float *>(output), dim_n_);
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -33,17 +33,26 @@ class MatMulCPUKernel : public MKLCPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
+  void InitHalfKernel();
+  void Gemm(const void *input_a, const void *input_b, void *output) const;
   char trans_a_{TRANSPOSE_NO};
   char trans_b_{TRANSPOSE_NO};
   dnnl_dim_t dim_m_{0};
   dnnl_dim_t dim_n_{0};
   dnnl_dim_t dim_k_{0};
+  TypeId dtype_{kNumberTypeFloat32};
+  // float16 matmul runs as a bf16 inner product when the cpu supports it, and as a f32 gemm otherwise
+  bool use_bf16_{false};
 };
 
 MS_REG_CPU_KERNEL(
   MatMul,
   KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
   MatMulCPUKernel);
+MS_REG_CPU_KERNEL(
+  MatMul,
+  KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+  MatMulCPUKernel);
 }  // namespace kernel
 }  // namespace mindspore
 
@@ -17,8 +17,12 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <functional>
+#include <numeric>
 #include "common/utils.h"
+#include "utils/utils.h"
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include "runtime/device/convert_tensor_utils.h"
 
 namespace mindspore {
 namespace kernel {
@@ -78,19 +82,127 @@ dnnl::memory::format_tag MKLCPUKernel::GetDefaultFormatTag(const dnnl::memory::d
   return mem_tag;
 }
 
-dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &shape) {
+dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &shape,
+                                                   dnnl::memory::data_type data_type) {
   dnnl::memory::dims dims;
   dims.insert(dims.end(), shape.begin(), shape.end());
   dnnl::memory::format_tag mem_tag = GetDefaultFormatTag(dims);
-  dnnl::memory::desc mem_desc(dims, dnnl::memory::data_type::f32, mem_tag);
+  dnnl::memory::desc mem_desc(dims, data_type, mem_tag);
   return mem_desc;
 }
 
+dnnl::memory::data_type MKLCPUKernel::GetHalfComputeType(bool compute_bound) const {
+  if (compute_bound && MKLKernelEngine::Get().bf16_supported()) {
+    return dnnl::memory::data_type::bf16;
+  }
+  return dnnl::memory::data_type::f32;
+}
+
+size_t MKLCPUKernel::GetDataTypeSize(dnnl::memory::data_type data_type) {
+  if (data_type == dnnl::memory::data_type::bf16) {
+    return sizeof(uint16_t);
+  }
+  if (data_type != dnnl::memory::data_type::f32) {
+    MS_LOG(EXCEPTION) << "unsupported compute type " << static_cast<int>(data_type);
+  }
+  return sizeof(float);
+}
+
+size_t MKLCPUKernel::GetElementNum(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+void MKLCPUKernel::WidenHalf(const AddressPtr &src, const AddressPtr &dst, dnnl::memory::data_type data_type) {
+  MS_EXCEPTION_IF_NULL(src);
+  MS_EXCEPTION_IF_NULL(dst);
+  size_t elem_num = src->size / sizeof(float16);
+  if (dst->size < elem_num * GetDataTypeSize(data_type)) {
+    MS_LOG(EXCEPTION) << "workspace size " << dst->size << " is too small for " << elem_num << " elements";
+  }
+  if (data_type == dnnl::memory::data_type::bf16) {
+    device::HalfToBFloat16(dst->addr, src->addr, elem_num);
+  } else {
+    device::HalfToFloat(dst->addr, src->addr, elem_num);
+  }
+}
+
+void MKLCPUKernel::NarrowToHalf(const AddressPtr &src, const AddressPtr &dst) {
+  MS_EXCEPTION_IF_NULL(src);
+  MS_EXCEPTION_IF_NULL(dst);
+  size_t elem_num = dst->size / sizeof(float16);
+  if (src->size < elem_num * sizeof(float)) {
+    MS_LOG(EXCEPTION) << "workspace size " << src->size << " is too small for " << elem_num << " elements";
+  }
+  device::FloatToHalf(dst->addr, src->addr, elem_num);
+}
+
+dnnl::memory::desc MKLCPUKernel::GetFormatMemDesc(const std::vector<size_t> &shape, const std::string &format,
+                                                  dnnl::memory::data_type data_type) {
+  if (format != kOpFormat_NC1HWC0) {
+    return GetDefaultMemDesc(shape, data_type);
+  }
+  if (shape.size() != 4) {
+    MS_LOG(EXCEPTION) << "format " << format << " needs 4 dims, but got " << shape.size();
+  }
+  dnnl::memory::dims dims(shape.begin(), shape.end());
+  return dnnl::memory::desc(dims, data_type, dnnl::memory::format_tag::nChw16c);
+}
+
+dnnl::memory::desc MKLCPUKernel::GetAnyMemDesc(const std::vector<size_t> &shape, dnnl::memory::data_type data_type) {
+  dnnl::memory::dims dims(shape.begin(), shape.end());
+  return dnnl::memory::desc(dims, data_type, dnnl::memory::format_tag::any);
+}
+
+dnnl::primitive_attr MKLCPUKernel::GetPrimitiveAttr() const {
+  dnnl::primitive_attr attr;
+  attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+  return attr;
+}
+
+std::string MKLCPUKernel::GetPrimitiveKey(const std::string &name, const std::vector<dnnl::memory::desc> &mem_descs,
+                                          const std::vector<int64_t> &params) {
+  std::string key = name;
+  for (const auto &mem_desc : mem_descs) {
+    key += MKLKernelEngine::GetMemDescKey(mem_desc);
+  }
+  for (auto param : params) {
+    key += "_" + std::to_string(param);
+  }
+  return key;
+}
+
+void MKLCPUKernel::AddScratchpad(const dnnl::memory::desc &scratchpad_desc) {
+  if (scratchpad_desc.get_size() == 0) {
+    return;
+  }
+  AddArgument(DNNL_ARG_SCRATCHPAD, scratchpad_desc);
+  has_scratchpad_ = true;
+  scratchpad_index_ = workspace_size_list_.size();
+  workspace_size_list_.emplace_back(scratchpad_desc.get_size());
+}
+
 void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc) {
   arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(mem_desc, alloc);
 }
 
+void MKLCPUKernel::AddReorderArgument(int arg_key, const dnnl::memory::desc &user_desc,
+                                      const dnnl::memory::desc &mem_desc, bool is_output) {
+  AddArgument(arg_key, mem_desc);
+  if (user_desc == mem_desc) {
+    return;
+  }
+  reorder_arguments_.push_back(
+    {arg_key, MKLKernelEngine::Get().CreateMemory(user_desc), workspace_size_list_.size(), is_output});
+  workspace_size_list_.emplace_back(mem_desc.get_size());
+}
+
 void MKLCPUKernel::SetArgumentHandle(int arg_key, void *ptr) {
+  for (auto &reorder : reorder_arguments_) {
+    if (reorder.arg_key == arg_key) {
+      reorder.user_memory.set_data_handle(ptr);
+      return;
+    }
+  }
   auto arg_iter = arguments_.find(arg_key);
   if (arg_iter != arguments_.end()) {
     arg_iter->second.set_data_handle(ptr);
@@ -99,6 +211,31 @@ void MKLCPUKernel::SetArgumentHandle(int arg_key, void *ptr) {
 
 void MKLCPUKernel::ExecutePrimitive() { MKLKernelEngine::Get().Execute(primitive_, arguments_); }
 
+void MKLCPUKernel::ExecutePrimitive(const std::vector<AddressPtr> &workspace) {
+  if (has_scratchpad_) {
+    if (scratchpad_index_ >= workspace.size()) {
+      MS_LOG(EXCEPTION) << "scratchpad workspace " << scratchpad_index_ << " is out of " << workspace.size();
+    }
+    arguments_[DNNL_ARG_SCRATCHPAD].set_data_handle(workspace[scratchpad_index_]->addr);
+  }
+  for (auto &reorder : reorder_arguments_) {
+    if (reorder.workspace_index >= workspace.size()) {
+      MS_LOG(EXCEPTION) << "reorder workspace " << reorder.workspace_index << " is out of " << workspace.size();
+    }
+    auto &mem = arguments_[reorder.arg_key];
+    mem.set_data_handle(workspace[reorder.workspace_index]->addr);
+    if (!reorder.is_output) {
+      Reorder(&reorder.user_memory, &mem);
+    }
+  }
+  ExecutePrimitive();
+  for (auto &reorder : reorder_arguments_) {
+    if (reorder.is_output) {
+      Reorder(&arguments_[reorder.arg_key], &reorder.user_memory);
+    }
+  }
+}
+
 void MKLCPUKernel::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
   MKLKernelEngine::Get().Reorder(src_mem, dst_mem);
 }
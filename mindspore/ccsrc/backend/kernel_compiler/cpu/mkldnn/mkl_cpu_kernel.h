@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_KERNEL_CPU_MKL_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_KERNEL_CPU_MKL_CPU_KERNEL_H_
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <memory>
@@ -23,6 +24,7 @@
 #include "dnnl.hpp"
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 
 namespace mindspore {
 namespace kernel {
@@ -37,14 +39,56 @@ class MKLCPUKernel : public CPUKernel {
   void AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc = false);
   void SetArgumentHandle(int arg_key, void *ptr);
   dnnl::memory::format_tag GetDefaultFormatTag(const dnnl::memory::dims &dims) const;
-  dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape);
+  dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape,
+                                       dnnl::memory::data_type data_type = dnnl::memory::data_type::f32);
+  // float16 tensors run through f32 primitives, or bf16 ones for compute bound kernels when the cpu supports them.
+  // The inputs are widened into workspaces and the f32 result is narrowed into the output, so the accumulation
+  // stays in f32.
+  dnnl::memory::data_type GetHalfComputeType(bool compute_bound) const;
+  static size_t GetDataTypeSize(dnnl::memory::data_type data_type);
+  static size_t GetElementNum(const std::vector<size_t> &shape);
+  static void WidenHalf(const AddressPtr &src, const AddressPtr &dst, dnnl::memory::data_type data_type);
+  static void NarrowToHalf(const AddressPtr &src, const AddressPtr &dst);
+  // the desc of an activation in the format kernel selection gave it, NC1HWC0 is the nChw16c layout of mkl-dnn
+  dnnl::memory::desc GetFormatMemDesc(const std::vector<size_t> &shape, const std::string &format,
+                                      dnnl::memory::data_type data_type = dnnl::memory::data_type::f32);
+  // lets the primitive pick the layout it runs fastest on
+  dnnl::memory::desc GetAnyMemDesc(const std::vector<size_t> &shape,
+                                   dnnl::memory::data_type data_type = dnnl::memory::data_type::f32);
+  // primitives taken from the cache of the engine run with a scratchpad owned by the kernel
+  dnnl::primitive_attr GetPrimitiveAttr() const;
+  static std::string GetPrimitiveKey(const std::string &name, const std::vector<dnnl::memory::desc> &mem_descs,
+                                     const std::vector<int64_t> &params = {});
+  template <typename Primitive, typename PrimitiveDesc>
+  void CreatePrimitive(const std::string &key, const PrimitiveDesc &prim_desc) {
+    primitive_ =
+      MKLKernelEngine::Get().GetPrimitive(key, [&prim_desc]() { return std::make_shared<Primitive>(prim_desc); });
+    AddScratchpad(prim_desc.scratchpad_desc());
+  }
+  // An argument whose layout in memory differs from the one the primitive wants is reordered through a workspace,
+  // before the primitive runs for inputs and after it for outputs. Equal layouts are bound directly.
+  void AddReorderArgument(int arg_key, const dnnl::memory::desc &user_desc, const dnnl::memory::desc &mem_desc,
+                          bool is_output);
   void ExecutePrimitive();
+  void ExecutePrimitive(const std::vector<AddressPtr> &workspace);
   std::unordered_map<int, dnnl::memory> arguments_;
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
   inline dnnl::memory::desc formatted_md(const dnnl::memory::dims &dimensions, dnnl::memory::format_tag layout) {
     return dnnl::memory::desc{{dimensions}, dnnl::memory::data_type::f32, layout};
   }
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
+
+ private:
+  struct ReorderArgument {
+    int arg_key;
+    dnnl::memory user_memory;
+    size_t workspace_index;
+    bool is_output;
+  };
+  void AddScratchpad(const dnnl::memory::desc &scratchpad_desc);
+  std::vector<ReorderArgument> reorder_arguments_;
+  bool has_scratchpad_{false};
+  size_t scratchpad_index_{0};
 };
 }  // namespace kernel
 }  // namespace mindspore
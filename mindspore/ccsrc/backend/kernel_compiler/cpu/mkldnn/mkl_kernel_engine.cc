@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include <sstream>
 #include "utils/log_adapter.h"
 #include "dnnl.hpp"
 
@@ -22,8 +23,69 @@ namespace kernel {
 void MKLKernelEngine::Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                               const std::unordered_map<int, dnnl::memory> &arguments) {
   MS_EXCEPTION_IF_NULL(primitive);
-  primitive->execute(stream_, arguments);
-  (void)stream_.wait();
+  auto &stream = this->stream();
+  primitive->execute(stream, arguments);
+  (void)stream.wait();
+}
+
+dnnl::stream &MKLKernelEngine::stream() {
+  static thread_local dnnl::stream stream(engine_);
+  return stream;
+}
+
+bool MKLKernelEngine::CheckBF16Support() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+         __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq");
+#else
+  return false;
+#endif
+}
+
+bool MKLKernelEngine::CheckBlockedLayoutSupport() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx512f");
+#else
+  return false;
+#endif
+}
+
+std::shared_ptr<dnnl::primitive> MKLKernelEngine::GetPrimitive(
+  const std::string &key, const std::function<std::shared_ptr<dnnl::primitive>()> &creator) {
+  std::lock_guard<std::mutex> lock(primitive_mutex_);
+  auto iter = primitives_.find(key);
+  if (iter != primitives_.end()) {
+    MS_LOG(DEBUG) << "Reuse cached mkl-dnn primitive " << key;
+    return iter->second;
+  }
+  auto primitive = creator();
+  MS_EXCEPTION_IF_NULL(primitive);
+  primitives_[key] = primitive;
+  return primitive;
+}
+
+std::string MKLKernelEngine::GetMemDescKey(const dnnl::memory::desc &mem_desc) {
+  const auto &data = mem_desc.data;
+  std::ostringstream key;
+  key << "(" << static_cast<int>(data.data_type) << ":";
+  for (int i = 0; i < data.ndims; ++i) {
+    key << data.dims[i] << ",";
+  }
+  key << static_cast<int>(data.format_kind);
+  if (data.format_kind == dnnl_blocked) {
+    const auto &blocking = data.format_desc.blocking;
+    key << ":";
+    for (int i = 0; i < data.ndims; ++i) {
+      key << blocking.strides[i] << ",";
+    }
+    for (int i = 0; i < blocking.inner_nblks; ++i) {
+      key << blocking.inner_idxs[i] << "x" << blocking.inner_blks[i] << ",";
+    }
+  }
+  key << ")";
+  return key.str();
 }
 
 dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc) {
@@ -34,7 +96,14 @@ dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, b
   }
 }
 void MKLKernelEngine::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
-  dnnl::reorder(*src_mem, *dst_mem).execute(stream_, *src_mem, *dst_mem);
+  MS_EXCEPTION_IF_NULL(src_mem);
+  MS_EXCEPTION_IF_NULL(dst_mem);
+  auto key = "reorder" + GetMemDescKey(src_mem->get_desc()) + GetMemDescKey(dst_mem->get_desc());
+  auto primitive =
+    GetPrimitive(key, [src_mem, dst_mem]() { return std::make_shared<dnnl::reorder>(*src_mem, *dst_mem); });
+  auto &stream = this->stream();
+  primitive->execute(stream, {{DNNL_ARG_FROM, *src_mem}, {DNNL_ARG_TO, *dst_mem}});
+  (void)stream.wait();
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -17,7 +17,9 @@
 #define MINDSPORE_MKL_KERNEL_ENGINE_H_
 #include <cstdlib>
 #include <algorithm>
+#include <functional>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -36,6 +38,10 @@ class MKLKernelEngine {
   DISABLE_COPY_AND_ASSIGN(MKLKernelEngine)
 
   const dnnl::engine &engine() const { return engine_; }
+  // bf16 primitives of mkl-dnn need avx512 core, they are emulated and slow on older cpus
+  bool bf16_supported() const { return bf16_supported_; }
+  // the blocked nChw16c layout is what the avx512 primitives of mkl-dnn read and write natively
+  bool blocked_layout_supported() const { return blocked_layout_supported_; }
 
   dnnl::memory CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc = false);
 
@@ -43,11 +49,28 @@ class MKLKernelEngine {
                const std::unordered_map<int, dnnl::memory> &arguments);
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
 
+  // Creating a primitive generates its jit code, which takes far longer than running it on small shapes. Primitives
+  // are cached by a key of their kind, memory descs and attributes, and shared by every kernel of every graph that
+  // asks for the same one. They must use a user scratchpad, so that kernels sharing one can run at the same time.
+  std::shared_ptr<dnnl::primitive> GetPrimitive(const std::string &key,
+                                                const std::function<std::shared_ptr<dnnl::primitive>()> &creator);
+  static std::string GetMemDescKey(const dnnl::memory::desc &mem_desc);
+
  private:
-  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
+  MKLKernelEngine()
+      : engine_(dnnl::engine::kind::cpu, 0),
+        bf16_supported_(CheckBF16Support()),
+        blocked_layout_supported_(CheckBlockedLayoutSupport()) {}
   ~MKLKernelEngine() = default;
+  // a dnnl stream must not be shared by threads, kernels may be launched from several threads at the same time
+  dnnl::stream &stream();
+  static bool CheckBF16Support();
+  static bool CheckBlockedLayoutSupport();
   dnnl::engine engine_;
-  dnnl::stream stream_;
+  bool bf16_supported_{false};
+  bool blocked_layout_supported_{false};
+  std::mutex primitive_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<dnnl::primitive>> primitives_;
 };
 }  // namespace kernel
 }  // namespace mindspore
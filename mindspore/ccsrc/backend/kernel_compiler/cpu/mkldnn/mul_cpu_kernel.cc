@@ -34,27 +34,47 @@ void MulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
       src1_shape.emplace_back(1);
     }
   }
+  // mul is bound by memory, float16 runs the f32 primitive on widened copies
+  dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
+  if (dtype_ == kNumberTypeFloat16) {
+    workspace_size_list_.emplace_back(GetElementNum(src0_shape) * sizeof(float));
+    workspace_size_list_.emplace_back(GetElementNum(src1_shape) * sizeof(float));
+    workspace_size_list_.emplace_back(GetElementNum(dst_shape) * sizeof(float));
+  }
   dnnl::memory::desc src0_mem_desc = GetDefaultMemDesc(src0_shape);
   dnnl::memory::desc src1_mem_desc = GetDefaultMemDesc(src1_shape);
   dnnl::memory::desc dst_mem_desc = GetDefaultMemDesc(dst_shape);
   dnnl::binary::desc desc = dnnl::binary::desc(dnnl::algorithm::binary_mul, src0_mem_desc, src1_mem_desc, dst_mem_desc);
-  auto prim_desc = dnnl::binary::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::binary>(prim_desc);
+  auto prim_desc = dnnl::binary::primitive_desc(desc, GetPrimitiveAttr(), MKLKernelEngine::Get().engine());
+  CreatePrimitive<dnnl::binary>(GetPrimitiveKey("mul", {src0_mem_desc, src1_mem_desc, dst_mem_desc}), prim_desc);
   AddArgument(DNNL_ARG_SRC_0, src0_mem_desc);
   AddArgument(DNNL_ARG_SRC_1, src1_mem_desc);
   AddArgument(DNNL_ARG_DST, dst_mem_desc);
 }
 
 bool MulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
-                          const std::vector<kernel::AddressPtr> & /*workspace*/,
+                          const std::vector<kernel::AddressPtr> &workspace,
                           const std::vector<kernel::AddressPtr> &outputs) {
   if (inputs.size() < 2 || outputs.empty()) {
     MS_LOG(EXCEPTION) << "mul error input output size!";
   }
+  if (dtype_ == kNumberTypeFloat16) {
+    if (workspace.size() < 3) {
+      MS_LOG(EXCEPTION) << "mul float16 needs 3 workspaces, but got " << workspace.size();
+    }
+    WidenHalf(inputs[0], workspace[0], dnnl::memory::data_type::f32);
+    WidenHalf(inputs[1], workspace[1], dnnl::memory::data_type::f32);
+    SetArgumentHandle(DNNL_ARG_SRC_0, workspace[0]->addr);
+    SetArgumentHandle(DNNL_ARG_SRC_1, workspace[1]->addr);
+    SetArgumentHandle(DNNL_ARG_DST, workspace[2]->addr);
+    ExecutePrimitive(workspace);
+    NarrowToHalf(workspace[2], outputs[0]);
+    return true;
+  }
   SetArgumentHandle(DNNL_ARG_SRC_0, inputs[0]->addr);
   SetArgumentHandle(DNNL_ARG_SRC_1, inputs[1]->addr);
   SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
-  ExecutePrimitive();
+  ExecutePrimitive(workspace);
   return true;
 }
 }  // namespace kernel
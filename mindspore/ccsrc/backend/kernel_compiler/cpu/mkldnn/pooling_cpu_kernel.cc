@@ -24,10 +24,10 @@ namespace mindspore {
 namespace kernel {
 void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
-  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
-  std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  std::vector<size_t> src_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  std::vector<size_t> dst_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  dnnl::memory::desc src_desc = GetFormatMemDesc(src_shape, AnfAlgo::GetInputFormat(kernel_node, 0));
+  dnnl::memory::desc dst_desc = GetFormatMemDesc(dst_shape, AnfAlgo::GetOutputFormat(kernel_node, 0));
   std::vector<int> kernel_sizes = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, KSIZE);
   std::vector<int> strides = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, STRIDES);
   if (kernel_sizes.size() != 4 || strides.size() != 4) {
@@ -44,25 +44,30 @@ void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
-  dnnl::pooling_forward::desc desc =
-    dnnl::pooling_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::pooling_max, src_desc, dst_desc,
-                                strides_dims, kernels_dims, padding_l, padding_r);
-  auto prim_desc = dnnl::pooling_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::pooling_forward>(prim_desc);
+  // MaxPoolGrad recomputes the argmax itself, so the forward pass needs no workspace; the pooling takes the layout
+  // of its input and picks the one of its output
+  dnnl::pooling_forward::desc desc = dnnl::pooling_forward::desc(
+    dnnl::prop_kind::forward_inference, dnnl::algorithm::pooling_max, src_desc, GetAnyMemDesc(dst_shape),
+    strides_dims, kernels_dims, padding_l, padding_r);
+  auto prim_desc = dnnl::pooling_forward::primitive_desc(desc, GetPrimitiveAttr(), MKLKernelEngine::Get().engine());
+  std::vector<int64_t> params{strides[2], strides[3], kernel_sizes[2], kernel_sizes[3]};
+  params.insert(params.end(), int_padding_l.begin(), int_padding_l.end());
+  params.insert(params.end(), int_padding_r.begin(), int_padding_r.end());
+  auto key = GetPrimitiveKey("max_pool", {prim_desc.src_desc(), prim_desc.dst_desc()}, params);
+  CreatePrimitive<dnnl::pooling_forward>(key, prim_desc);
   AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DST, dst_desc);
-  AddArgument(DNNL_ARG_WORKSPACE, prim_desc.workspace_desc());
+  AddReorderArgument(DNNL_ARG_DST, dst_desc, prim_desc.dst_desc(), true);
 }
 
 bool PoolingCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
-                              const std::vector<kernel::AddressPtr> & /*workspace*/,
+                              const std::vector<kernel::AddressPtr> &workspace,
                               const std::vector<kernel::AddressPtr> &outputs) {
   if (inputs.empty() || outputs.empty()) {
     MS_LOG(EXCEPTION) << "error input output size!";
   }
   SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
   SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
-  ExecutePrimitive();
+  ExecutePrimitive(workspace);
   return true;
 }
 }  // namespace kernel
@@ -22,30 +22,48 @@ namespace mindspore {
 namespace kernel {
 void ReluCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
-  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> src_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
   if (src_shape.size() != 4 && src_shape.size() != 2) {
     MS_LOG(EXCEPTION) << "relu kernel dims invalid " << src_shape.size();
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  // relu runs on the layout of its input and writes the output in the same one
+  dnnl::memory::desc src_desc = GetFormatMemDesc(src_shape, AnfAlgo::GetInputFormat(kernel_node, 0));
+  dnnl::memory::desc dst_desc = GetFormatMemDesc(src_shape, AnfAlgo::GetOutputFormat(kernel_node, 0));
+  // relu is bound by memory, float16 runs the f32 primitive in place on a widened copy
+  dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
+  if (dtype_ == kNumberTypeFloat16) {
+    workspace_size_list_.emplace_back(GetElementNum(src_shape) * sizeof(float));
+  }
 
   dnnl::eltwise_forward::desc desc =
     dnnl::eltwise_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::eltwise_relu, src_desc, 0.0);
-  auto prim_desc = dnnl::eltwise_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::eltwise_forward>(prim_desc);
+  auto prim_desc = dnnl::eltwise_forward::primitive_desc(desc, GetPrimitiveAttr(), MKLKernelEngine::Get().engine());
+  CreatePrimitive<dnnl::eltwise_forward>(GetPrimitiveKey("relu", {src_desc}), prim_desc);
 
   AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DST, src_desc);
+  AddReorderArgument(DNNL_ARG_DST, dst_desc, src_desc, true);
 }
 
 bool ReluCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
-                           const std::vector<kernel::AddressPtr> & /*workspace*/,
+                           const std::vector<kernel::AddressPtr> &workspace,
                            const std::vector<kernel::AddressPtr> &outputs) {
   if (inputs.empty() || outputs.empty()) {
     MS_LOG(EXCEPTION) << "error input output size!";
   }
+  if (dtype_ == kNumberTypeFloat16) {
+    if (workspace.empty()) {
+      MS_LOG(EXCEPTION) << "relu float16 needs a workspace!";
+    }
+    WidenHalf(inputs[0], workspace[0], dnnl::memory::data_type::f32);
+    SetArgumentHandle(DNNL_ARG_SRC, workspace[0]->addr);
+    SetArgumentHandle(DNNL_ARG_DST, workspace[0]->addr);
+    ExecutePrimitive(workspace);
+    NarrowToHalf(workspace[0], outputs[0]);
+    return true;
+  }
   SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
   SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
-  ExecutePrimitive();
+  ExecutePrimitive(workspace);
   return true;
 }
 }  // namespace kernel
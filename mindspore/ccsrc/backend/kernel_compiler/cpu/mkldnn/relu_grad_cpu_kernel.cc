@@ -22,11 +22,22 @@ namespace mindspore {
 namespace kernel {
 void ReluGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
-  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> src_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
   if (src_shape.size() != 4 && src_shape.size() != 2) {
     MS_LOG(EXCEPTION) << "relu grad kernel dims invalid " << src_shape.size();
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  // the gradient runs on the layout of the forward input, the incoming and outgoing gradients are reordered to it
+  dnnl::memory::desc src_desc = GetFormatMemDesc(src_shape, AnfAlgo::GetInputFormat(kernel_node, 1));
+  dnnl::memory::desc diff_dst_desc = GetFormatMemDesc(src_shape, AnfAlgo::GetInputFormat(kernel_node, 0));
+  dnnl::memory::desc diff_src_desc = GetFormatMemDesc(src_shape, AnfAlgo::GetOutputFormat(kernel_node, 0));
+  // a blocked layout pads the channels, so the byte sizes of the gradients differ when only one of them is blocked
+  std::vector<size_t> dy_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  std::vector<size_t> dx_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  if (GetElementNum(dy_shape) != GetElementNum(src_shape) || GetElementNum(dx_shape) != GetElementNum(src_shape)) {
+    MS_LOG(EXCEPTION) << "relu grad error input output element number!";
+  }
+  diff_dst_size_ = diff_dst_desc.get_size();
+  diff_src_size_ = diff_src_desc.get_size();
 
   dnnl::eltwise_forward::desc forward_desc =
     dnnl::eltwise_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::eltwise_relu, src_desc, 0.0);
@@ -34,35 +45,29 @@ void ReluGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
 
   dnnl::eltwise_backward::desc backward_desc =
     dnnl::eltwise_backward::desc(dnnl::algorithm::eltwise_relu, src_desc, src_desc, 0.0, 0.0);
-  auto backward_prim_desc =
-    dnnl::eltwise_backward::primitive_desc(backward_desc, MKLKernelEngine::Get().engine(), forward_prim_desc);
-  primitive_ = std::make_shared<dnnl::eltwise_backward>(backward_prim_desc);
+  auto backward_prim_desc = dnnl::eltwise_backward::primitive_desc(backward_desc, GetPrimitiveAttr(),
+                                                                   MKLKernelEngine::Get().engine(), forward_prim_desc);
+  CreatePrimitive<dnnl::eltwise_backward>(GetPrimitiveKey("relu_grad", {src_desc}), backward_prim_desc);
 
   AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DIFF_SRC, src_desc);
-  AddArgument(DNNL_ARG_DIFF_DST, src_desc);
+  AddReorderArgument(DNNL_ARG_DIFF_SRC, diff_src_desc, src_desc, true);
+  AddReorderArgument(DNNL_ARG_DIFF_DST, diff_dst_desc, src_desc, false);
 }
 
 bool ReluGradCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
-                               const std::vector<kernel::AddressPtr> & /*workspace*/,
+                               const std::vector<kernel::AddressPtr> &workspace,
                                const std::vector<kernel::AddressPtr> &outputs) {
   if (inputs.size() < 2 || outputs.empty()) {
     MS_LOG(EXCEPTION) << "relu grad error input output size!";
   }
-  if (inputs[0]->size != outputs[0]->size) {
+  if (inputs[0]->size < diff_dst_size_ || outputs[0]->size < diff_src_size_) {
     MS_LOG(EXCEPTION) << "relu grad error input output data size!";
   }
 
   SetArgumentHandle(DNNL_ARG_SRC, inputs[1]->addr);
-  SetArgumentHandle(DNNL_ARG_DIFF_SRC, inputs[0]->addr);
+  SetArgumentHandle(DNNL_ARG_DIFF_SRC, outputs[0]->addr);
   SetArgumentHandle(DNNL_ARG_DIFF_DST, inputs[0]->addr);
-  ExecutePrimitive();
-  size_t mem_bits = outputs[0]->size;
-  auto ret = memcpy_s(outputs[0]->addr, mem_bits, inputs[0]->addr, mem_bits);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "memcpy_s error, errorno " << ret;
-    return false;
-  }
+  ExecutePrimitive(workspace);
   return true;
 }
 }  // namespace kernel
@@ -31,6 +31,10 @@ class ReluGradCPUKernel : public MKLCPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  size_t diff_dst_size_{0};
+  size_t diff_src_size_{0};
 };
 
 MS_REG_CPU_KERNEL(
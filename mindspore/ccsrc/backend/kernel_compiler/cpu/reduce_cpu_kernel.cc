@@ -13,10 +13,16 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <map>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
 #include <string>
+#include <utility>
 #include <vector>
 #include "backend/kernel_compiler/cpu/reduce_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/simd_utils.h"
+#include "ir/tensor.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
@@ -24,7 +30,100 @@ namespace kernel {
 const size_t kReduceTypeMax = 0;
 const size_t kReduceTypeMean = 1;
 const size_t kReduceTypeSum = 2;
-const size_t kMaxDim = 100;
+const size_t kReduceTypeMin = 3;
+const size_t kReduceTypeProd = 4;
+const size_t kMaxMergedDim = 16;
+// floats converted or accumulated at a time, small enough to stay in L1
+const size_t kTileSize = 1024;
+// input elements handled by one parallel task at least
+const size_t kParallelGrain = 16384;
+
+namespace {
+struct SumOp {
+  static constexpr SimdOpType kSimdOp = kSimdAdd;
+  static float Init() { return 0.0f; }
+  static float Apply(float a, float b) { return a + b; }
+};
+
+struct ProdOp {
+  static constexpr SimdOpType kSimdOp = kSimdMul;
+  static float Init() { return 1.0f; }
+  static float Apply(float a, float b) { return a * b; }
+};
+
+struct MaxOp {
+  static constexpr SimdOpType kSimdOp = kSimdMax;
+  static float Init() { return -std::numeric_limits<float>::infinity(); }
+  static float Apply(float a, float b) { return a > b ? a : b; }
+};
+
+struct MinOp {
+  static constexpr SimdOpType kSimdOp = kSimdMin;
+  static float Init() { return std::numeric_limits<float>::infinity(); }
+  static float Apply(float a, float b) { return a < b ? a : b; }
+};
+
+template <typename Op>
+float ReduceContiguous(const float *data, size_t size) {
+  float result = Op::Init();
+  size_t i = SimdReduce(Op::kSimdOp, data, size, &result);
+  for (; i < size; ++i) {
+    result = Op::Apply(result, data[i]);
+  }
+  return result;
+}
+
+template <typename Op>
+void ReduceElementwise(float *acc, const float *data, size_t size) {
+  size_t i = SimdReduceElementwise(Op::kSimdOp, acc, data, size);
+  for (; i < size; ++i) {
+    acc[i] = Op::Apply(acc[i], data[i]);
+  }
+}
+
+// fp32 data is used in place, fp16 data is widened into the buffer first
+inline const float *LoadTile(const float *data, size_t /*size*/, float * /*buffer*/) { return data; }
+
+inline const float *LoadTile(const float16 *data, size_t size, float *buffer) {
+  for (size_t i = 0; i < size; ++i) {
+    buffer[i] = static_cast<float>(data[i]);
+  }
+  return buffer;
+}
+
+// Walks the positions of some strided dims in row-major order and tracks the offset of the current one.
+class StridedIndex {
+ public:
+  StridedIndex(const std::vector<size_t> &shape, const std::vector<size_t> &strides, size_t position)
+      : shape_(shape), strides_(strides) {
+    for (size_t i = shape_.size(); i > 0; --i) {
+      index_[i - 1] = position % shape_[i - 1];
+      position /= shape_[i - 1];
+      offset_ += index_[i - 1] * strides_[i - 1];
+    }
+  }
+  ~StridedIndex() = default;
+
+  size_t offset() const { return offset_; }
+  void Next() {
+    for (size_t i = shape_.size(); i > 0; --i) {
+      offset_ += strides_[i - 1];
+      if (++index_[i - 1] < shape_[i - 1]) {
+        return;
+      }
+      offset_ -= index_[i - 1] * strides_[i - 1];
+      index_[i - 1] = 0;
+    }
+  }
+
+ private:
+  const std::vector<size_t> &shape_;
+  const std::vector<size_t> &strides_;
+  size_t index_[kMaxMergedDim];
+  size_t offset_{0};
+};
+}  // namespace
+
 void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
@@ -34,9 +133,14 @@ void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     reduce_type_ = kReduceTypeMean;
   } else if (kernel_name == "ReduceSum") {
     reduce_type_ = kReduceTypeSum;
+  } else if (kernel_name == "ReduceMin") {
+    reduce_type_ = kReduceTypeMin;
+  } else if (kernel_name == "ReduceProd") {
+    reduce_type_ = kReduceTypeProd;
   } else {
     MS_LOG(EXCEPTION) << "Array reduce kernel type " << kernel_name << " is not supported.";
   }
+  dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
   shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
   auto axis_addr = AnfAlgo::GetCNodePrimitive(kernel_node)->GetAttr(AXIS);
   if (axis_addr->isa<ValueTuple>()) {
@@ -62,99 +166,189 @@ void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   } else {
     MS_LOG(EXCEPTION) << "Attribute axis type is invalid.";
   }
+  InitReducePlan();
+}
+
+void ReduceCPUKernel::InitReducePlan() {
+  std::vector<bool> reduced(shape_.size(), false);
+  for (auto axis : axis_) {
+    if (axis >= shape_.size()) {
+      MS_LOG(EXCEPTION) << "axis value is oversize.";
+    }
+    reduced[axis] = true;
+  }
+  // drop the dims of size 1 and merge the neighbouring dims of the same kind
+  std::vector<std::pair<size_t, bool>> dims;
+  left_dims_ = 1;
+  stride_ = 1;
   for (size_t i = 0; i < shape_.size(); ++i) {
     if (shape_[i] <= 0) {
       MS_LOG(EXCEPTION) << "shape value is invalid.";
     }
-    left_dims_ *= shape_[i];
+    if (reduced[i]) {
+      stride_ *= shape_[i];
+    } else {
+      left_dims_ *= shape_[i];
+    }
+    if (shape_[i] == 1) {
+      continue;
+    }
+    if (!dims.empty() && dims.back().second == reduced[i]) {
+      dims.back().first *= shape_[i];
+    } else {
+      dims.emplace_back(shape_[i], reduced[i]);
+    }
   }
-  for (size_t i = 0; i < axis_.size(); ++i) {
-    stride_ *= shape_[axis_[i]];
+  if (dims.empty()) {
+    dims.emplace_back(1, false);
   }
-  if (stride_ <= 0) {
-    MS_LOG(EXCEPTION) << "stride_ must greater than zero.";
+  if (dims.size() > kMaxMergedDim) {
+    MS_LOG(EXCEPTION) << "Too many interleaved reduce axes, the merged dim number is " << dims.size();
   }
-  left_dims_ = left_dims_ / stride_;
+
+  kept_shape_.clear();
+  kept_strides_.clear();
+  reduced_shape_.clear();
+  reduced_strides_.clear();
+  inner_reduced_ = dims.back().second;
+  inner_size_ = dims.back().first;
+  size_t dim_stride = inner_size_;
+  for (size_t i = dims.size() - 1; i > 0; --i) {
+    auto &shape = dims[i - 1].second ? reduced_shape_ : kept_shape_;
+    auto &strides = dims[i - 1].second ? reduced_strides_ : kept_strides_;
+    (void)shape.insert(shape.begin(), dims[i - 1].first);
+    (void)strides.insert(strides.begin(), dim_stride);
+    dim_stride *= dims[i - 1].first;
+  }
+  outer_kept_num_ = std::accumulate(kept_shape_.begin(), kept_shape_.end(), size_t(1), std::multiplies<size_t>());
+  outer_reduced_num_ =
+    std::accumulate(reduced_shape_.begin(), reduced_shape_.end(), size_t(1), std::multiplies<size_t>());
 }
+
 bool ReduceCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                              const std::vector<kernel::AddressPtr> & /*workspaces*/,
                              const std::vector<kernel::AddressPtr> &outputs) {
   if (inputs.empty() || outputs.empty()) {
     MS_LOG(EXCEPTION) << "input or output empty!";
   }
-  size_t out_float_size = left_dims_ * sizeof(float);
-  size_t in_float_size = stride_ * out_float_size;
-  if (inputs[0]->size != in_float_size || outputs[0]->size != out_float_size) {
-    MS_LOG(EXCEPTION) << "invalid input or output data size!";
+  if (dtype_ == kNumberTypeFloat16) {
+    return LaunchKernel<float16>(inputs, outputs);
   }
-  auto input = reinterpret_cast<float *>(inputs[0]->addr);
-  auto output = reinterpret_cast<float *>(outputs[0]->addr);
-  int size = inputs[0]->size / sizeof(float);
-  std::vector<float> new_input(IntToSize(size), 0.0);
-  std::vector<size_t> transpose_axis;
-  for (size_t i = 0; i < shape_.size(); ++i) {
-    bool insert = true;
-    for (size_t j = 0; j < axis_.size(); ++j) {
-      if (axis_[j] == i) {
-        insert = false;
-        break;
-      }
-    }
-    if (insert) {
-      transpose_axis.push_back(i);
-    }
+  return LaunchKernel<float>(inputs, outputs);
+}
+
+template <typename T>
+bool ReduceCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) {
+  size_t out_size = left_dims_ * sizeof(T);
+  size_t in_size = stride_ * out_size;
+  if (inputs[0]->size != in_size || outputs[0]->size != out_size) {
+    MS_LOG(EXCEPTION) << "invalid input or output data size!";
   }
-  (void)transpose_axis.insert(transpose_axis.end(), axis_.begin(), axis_.end());
-  Transpose(size, input, shape_, transpose_axis, SizeToInt(shape_.size()), &new_input[0]);
+  auto input = reinterpret_cast<T *>(inputs[0]->addr);
+  auto output = reinterpret_cast<T *>(outputs[0]->addr);
   if (reduce_type_ == kReduceTypeMax) {
-    for (size_t i = 0; i < left_dims_; ++i) {
-      float value = new_input[i * stride_];
-      for (size_t k = 0; k < stride_; ++k) {
-        if (value < new_input[i * stride_ + k]) {
-          value = new_input[i * stride_ + k];
-        }
-      }
-      output[i] = value;
-    }
+    Reduce<T, MaxOp>(input, output, 1.0f);
+  } else if (reduce_type_ == kReduceTypeMin) {
+    Reduce<T, MinOp>(input, output, 1.0f);
+  } else if (reduce_type_ == kReduceTypeProd) {
+    Reduce<T, ProdOp>(input, output, 1.0f);
+  } else if (reduce_type_ == kReduceTypeMean) {
+    Reduce<T, SumOp>(input, output, 1.0f / stride_);
   } else {
-    for (size_t i = 0; i < left_dims_; ++i) {
-      float value = 0.0;
-      for (size_t k = 0; k < stride_; ++k) {
-        value += new_input[i * stride_ + k];
-      }
-      if (reduce_type_ == kReduceTypeMean) {
-        output[i] = value / stride_;
-      } else {
-        output[i] = value;
-      }
-    }
+    Reduce<T, SumOp>(input, output, 1.0f);
   }
   return true;
 }
-void ReduceCPUKernel::Transpose(const int size, const float *input, const std::vector<size_t> &input_shape,
-                                const std::vector<size_t> &input_axis, const int shape_size, float *output) {
-  int pos_array[kMaxDim];
-  int size_offset[kMaxDim];
-  size_offset[0] = size / SizeToInt(input_shape[0]);
-  for (int i = 1; i < shape_size; i++) {
-    size_offset[i] = size_offset[i - 1] / SizeToInt(input_shape[i]);
-  }
-  for (int position = 0; position < size; position += 1) {
-    int temp_position = position;
-    pos_array[0] = temp_position / size_offset[0];
-    for (int i = 1; i < shape_size; i++) {
-      temp_position -= pos_array[i - 1] * size_offset[i - 1];
-      pos_array[i] = temp_position / size_offset[i];
+
+template <typename T, typename Op>
+void ReduceCPUKernel::Reduce(const T *input, T *output, float scale) const {
+  if (inner_reduced_) {
+    ReduceInner<T, Op>(input, output, scale);
+  } else {
+    ReduceOuter<T, Op>(input, output, scale);
+  }
+}
+
+template <typename T, typename Op>
+float ReduceCPUKernel::ReduceRange(const T *input, size_t start, size_t end) const {
+  float buffer[kTileSize];
+  float result = Op::Init();
+  size_t col = start % inner_size_;
+  StridedIndex rows(reduced_shape_, reduced_strides_, start / inner_size_);
+  for (size_t pos = start; pos < end; rows.Next()) {
+    size_t len = std::min(inner_size_ - col, end - pos);
+    const T *data = input + rows.offset() + col;
+    for (size_t i = 0; i < len; i += kTileSize) {
+      size_t tile = std::min(kTileSize, len - i);
+      result = Op::Apply(result, ReduceContiguous<Op>(LoadTile(data + i, tile, buffer), tile));
     }
-    int new_position = pos_array[SizeToInt(input_axis[shape_size - 1])];
-    int new_position_size = 1;
-    for (int j = shape_size - 2; j >= 0; j--) {
-      new_position_size *= SizeToInt(input_shape[SizeToInt(input_axis[j + 1])]);
-      new_position += pos_array[SizeToInt(input_axis[j])] * new_position_size;
+    pos += len;
+    col = 0;
+  }
+  return result;
+}
+
+template <typename T, typename Op>
+void ReduceCPUKernel::ReduceInner(const T *input, T *output, float scale) const {
+  size_t reduce_size = outer_reduced_num_ * inner_size_;
+  auto &pool = common::ThreadPool::GetInstance();
+  if (outer_kept_num_ >= pool.thread_num() || reduce_size < 2 * kParallelGrain) {
+    auto task = [this, input, output, scale, reduce_size](size_t start, size_t end) {
+      StridedIndex outs(kept_shape_, kept_strides_, start);
+      for (size_t i = start; i < end; ++i, outs.Next()) {
+        output[i] = static_cast<T>(ReduceRange<T, Op>(input + outs.offset(), 0, reduce_size) * scale);
+      }
+    };
+    CPUKernelUtils::ParallelFor(task, outer_kept_num_, std::max(kParallelGrain / reduce_size, size_t(1)));
+    return;
+  }
+  // too few outputs to keep all threads busy, so every output is split into partial reductions
+  size_t task_num = std::min(pool.thread_num(), (reduce_size + kParallelGrain - 1) / kParallelGrain);
+  size_t once_compute_size = (reduce_size + task_num - 1) / task_num;
+  std::vector<float> partials(task_num);
+  StridedIndex outs(kept_shape_, kept_strides_, 0);
+  for (size_t i = 0; i < outer_kept_num_; ++i, outs.Next()) {
+    const T *data = input + outs.offset();
+    pool.Run(task_num, [this, data, once_compute_size, reduce_size, &partials](size_t task_id) {
+      size_t start = task_id * once_compute_size;
+      partials[task_id] = ReduceRange<T, Op>(data, start, std::min(reduce_size, start + once_compute_size));
+    });
+    // the partials are combined in a fixed order, so the result does not depend on the scheduling
+    float result = Op::Init();
+    for (auto partial : partials) {
+      result = Op::Apply(result, partial);
     }
-    output[new_position] = input[position];
+    output[i] = static_cast<T>(result * scale);
   }
-  return;
+}
+
+template <typename T, typename Op>
+void ReduceCPUKernel::ReduceOuter(const T *input, T *output, float scale) const {
+  auto task = [this, input, output, scale](size_t start, size_t end) {
+    float acc[kTileSize];
+    float buffer[kTileSize];
+    size_t col = start % inner_size_;
+    StridedIndex outs(kept_shape_, kept_strides_, start / inner_size_);
+    for (size_t pos = start; pos < end; outs.Next()) {
+      size_t len = std::min(inner_size_ - col, end - pos);
+      const T *data = input + outs.offset() + col;
+      for (size_t i = 0; i < len; i += kTileSize) {
+        size_t tile = std::min(kTileSize, len - i);
+        std::fill(acc, acc + tile, Op::Init());
+        StridedIndex rows(reduced_shape_, reduced_strides_, 0);
+        for (size_t row = 0; row < outer_reduced_num_; ++row, rows.Next()) {
+          ReduceElementwise<Op>(acc, LoadTile(data + rows.offset() + i, tile, buffer), tile);
+        }
+        for (size_t j = 0; j < tile; ++j) {
+          output[pos + i + j] = static_cast<T>(acc[j] * scale);
+        }
+      }
+      pos += len;
+      col = 0;
+    }
+  };
+  CPUKernelUtils::ParallelFor(task, outer_kept_num_ * inner_size_,
+                              std::max(kParallelGrain / outer_reduced_num_, size_t(1)));
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -23,6 +23,10 @@
 
 namespace mindspore {
 namespace kernel {
+// Reduces the input in place, without moving the reduce axes to the innermost position first.
+// After InitReducePlan the dims of size 1 are dropped and neighbouring dims of the same kind are merged, so the
+// input is seen as alternating kept and reduced dims. The innermost merged dim is contiguous and is handled by
+// vectorized loops, the outer ones are walked by strides.
 class ReduceCPUKernel : public CPUKernel {
  public:
   ReduceCPUKernel() = default;
@@ -32,20 +36,56 @@ class ReduceCPUKernel : public CPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
-  void Transpose(const int size, const float *input, const std::vector<size_t> &input_shape,
-                 const std::vector<size_t> &input_axis, const int shape_size, float *output);
-  size_t reduce_type_;
+  void InitReducePlan();
+  template <typename T>
+  bool LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
+  template <typename T, typename Op>
+  void Reduce(const T *input, T *output, float scale) const;
+  // the innermost merged dim is reduced, every output is a reduction of contiguous runs
+  template <typename T, typename Op>
+  void ReduceInner(const T *input, T *output, float scale) const;
+  // the innermost merged dim is kept, every output row accumulates whole input rows
+  template <typename T, typename Op>
+  void ReduceOuter(const T *input, T *output, float scale) const;
+  template <typename T, typename Op>
+  float ReduceRange(const T *input, size_t start, size_t end) const;
+
+  size_t reduce_type_{0};
+  TypeId dtype_{kNumberTypeFloat32};
   std::vector<size_t> axis_;
   std::vector<size_t> shape_;
   size_t left_dims_ = 1;
   size_t stride_ = 1;
+  // the merged dims except the innermost one, with their strides in elements
+  std::vector<size_t> kept_shape_;
+  std::vector<size_t> kept_strides_;
+  std::vector<size_t> reduced_shape_;
+  std::vector<size_t> reduced_strides_;
+  bool inner_reduced_{true};
+  size_t inner_size_ = 1;
+  size_t outer_kept_num_ = 1;
+  size_t outer_reduced_num_ = 1;
 };
 MS_REG_CPU_KERNEL(ReduceMean, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
                   ReduceCPUKernel);
 MS_REG_CPU_KERNEL(ReduceMax, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
                   ReduceCPUKernel);
+MS_REG_CPU_KERNEL(ReduceMin, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  ReduceCPUKernel);
 MS_REG_CPU_KERNEL(ReduceSum, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
                   ReduceCPUKernel);
+MS_REG_CPU_KERNEL(ReduceProd, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  ReduceCPUKernel);
+MS_REG_CPU_KERNEL(ReduceMean, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+                  ReduceCPUKernel);
+MS_REG_CPU_KERNEL(ReduceMax, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+                  ReduceCPUKernel);
+MS_REG_CPU_KERNEL(ReduceMin, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+                  ReduceCPUKernel);
+MS_REG_CPU_KERNEL(ReduceSum, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+                  ReduceCPUKernel);
+MS_REG_CPU_KERNEL(ReduceProd, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+                  ReduceCPUKernel);
 }  // namespace kernel
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_KERNEL_CPU_REDUCE_CPU_KERNEL_H_
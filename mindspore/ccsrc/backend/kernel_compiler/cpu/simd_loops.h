@@ -0,0 +1,204 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// NOLINT(build/header_guard)
+// The loops of simd_utils.h. This file has no include guard: simd_utils.cc includes it once for each instruction set,
+// in a namespace that defines FloatVec, kVecLen and the Vec* wrappers, under the target options of that instruction
+// set. It must not include anything, or the code it pulls in could be compiled for a wider target than the CPU has.
+
+struct AddOp {
+  static float Apply(float a, float b) { return a + b; }
+  static FloatVec Apply(FloatVec a, FloatVec b) { return VecAdd(a, b); }
+};
+
+struct SubOp {
+  static FloatVec Apply(FloatVec a, FloatVec b) { return VecSub(a, b); }
+};
+
+struct MulOp {
+  static float Apply(float a, float b) { return a * b; }
+  static FloatVec Apply(FloatVec a, FloatVec b) { return VecMul(a, b); }
+};
+
+struct DivOp {
+  static FloatVec Apply(FloatVec a, FloatVec b) { return VecDiv(a, b); }
+};
+
+struct MaxOp {
+  static float Apply(float a, float b) { return a > b ? a : b; }
+  static FloatVec Apply(FloatVec a, FloatVec b) { return VecMax(a, b); }
+};
+
+struct MinOp {
+  static float Apply(float a, float b) { return a < b ? a : b; }
+  static FloatVec Apply(FloatVec a, FloatVec b) { return VecMin(a, b); }
+};
+
+struct ReluGradOp {
+  static FloatVec Apply(FloatVec dy, FloatVec x) { return VecSelectPositive(x, dy); }
+};
+
+struct NegOp {
+  static FloatVec Apply(FloatVec a) { return VecSub(VecSet(0), a); }
+};
+
+struct SquareOp {
+  static FloatVec Apply(FloatVec a) { return VecMul(a, a); }
+};
+
+struct SqrtOp {
+  static FloatVec Apply(FloatVec a) { return VecSqrt(a); }
+};
+
+struct ReluOp {
+  static FloatVec Apply(FloatVec a) { return VecMax(a, VecSet(0)); }
+};
+
+template <typename Op>
+size_t ReduceLoop(const float *data, size_t size, float *result) {
+  if (size < 2 * kVecLen) {
+    return 0;
+  }
+  // two accumulators hide the latency of the vector unit
+  FloatVec acc0 = VecLoad(data);
+  FloatVec acc1 = VecLoad(data + kVecLen);
+  size_t i = 2 * kVecLen;
+  for (; i + 2 * kVecLen <= size; i += 2 * kVecLen) {
+    acc0 = Op::Apply(acc0, VecLoad(data + i));
+    acc1 = Op::Apply(acc1, VecLoad(data + i + kVecLen));
+  }
+  float lanes[kVecLen];
+  VecStore(lanes, Op::Apply(acc0, acc1));
+  float value = *result;
+  for (size_t j = 0; j < kVecLen; ++j) {
+    value = Op::Apply(value, lanes[j]);
+  }
+  *result = value;
+  return i;
+}
+
+template <typename Op>
+size_t ReduceElementwiseLoop(float *acc, const float *data, size_t size) {
+  size_t i = 0;
+  for (; i + kVecLen <= size; i += kVecLen) {
+    VecStore(acc + i, Op::Apply(VecLoad(acc + i), VecLoad(data + i)));
+  }
+  return i;
+}
+
+template <typename Op, bool kScalarA, bool kScalarB>
+size_t BinaryLoop(const float *a, const float *b, float *dst, size_t len) {
+  size_t i = 0;
+  FloatVec va = VecSet(a[0]);
+  FloatVec vb = VecSet(b[0]);
+  for (; i + kVecLen <= len; i += kVecLen) {
+    if (!kScalarA) {
+      va = VecLoad(a + i);
+    }
+    if (!kScalarB) {
+      vb = VecLoad(b + i);
+    }
+    VecStore(dst + i, Op::Apply(va, vb));
+  }
+  return i;
+}
+
+// a broadcast operand is loaded once, the loops are specialized for it
+template <typename Op>
+size_t BinaryBroadcast(const float *a, bool scalar_a, const float *b, bool scalar_b, float *dst, size_t len) {
+  if (scalar_a && !scalar_b) {
+    return BinaryLoop<Op, true, false>(a, b, dst, len);
+  }
+  if (!scalar_a && scalar_b) {
+    return BinaryLoop<Op, false, true>(a, b, dst, len);
+  }
+  return BinaryLoop<Op, false, false>(a, b, dst, len);
+}
+
+template <typename Op>
+size_t UnaryLoop(const float *a, float *dst, size_t len) {
+  size_t i = 0;
+  for (; i + kVecLen <= len; i += kVecLen) {
+    VecStore(dst + i, Op::Apply(VecLoad(a + i)));
+  }
+  return i;
+}
+
+size_t Reduce(SimdOpType op_type, const float *data, size_t size, float *result) {
+  switch (op_type) {
+    case kSimdAdd:
+      return ReduceLoop<AddOp>(data, size, result);
+    case kSimdMul:
+      return ReduceLoop<MulOp>(data, size, result);
+    case kSimdMax:
+      return ReduceLoop<MaxOp>(data, size, result);
+    case kSimdMin:
+      return ReduceLoop<MinOp>(data, size, result);
+    default:
+      return 0;
+  }
+}
+
+size_t ReduceElementwise(SimdOpType op_type, float *acc, const float *data, size_t size) {
+  switch (op_type) {
+    case kSimdAdd:
+      return ReduceElementwiseLoop<AddOp>(acc, data, size);
+    case kSimdMul:
+      return ReduceElementwiseLoop<MulOp>(acc, data, size);
+    case kSimdMax:
+      return ReduceElementwiseLoop<MaxOp>(acc, data, size);
+    case kSimdMin:
+      return ReduceElementwiseLoop<MinOp>(acc, data, size);
+    default:
+      return 0;
+  }
+}
+
+size_t Binary(SimdOpType op_type, const float *a, bool scalar_a, const float *b, bool scalar_b, float *dst,
+              size_t len) {
+  switch (op_type) {
+    case kSimdAdd:
+      return BinaryBroadcast<AddOp>(a, scalar_a, b, scalar_b, dst, len);
+    case kSimdSub:
+      return BinaryBroadcast<SubOp>(a, scalar_a, b, scalar_b, dst, len);
+    case kSimdMul:
+      return BinaryBroadcast<MulOp>(a, scalar_a, b, scalar_b, dst, len);
+    case kSimdDiv:
+      return BinaryBroadcast<DivOp>(a, scalar_a, b, scalar_b, dst, len);
+    case kSimdMax:
+      return BinaryBroadcast<MaxOp>(a, scalar_a, b, scalar_b, dst, len);
+    case kSimdMin:
+      return BinaryBroadcast<MinOp>(a, scalar_a, b, scalar_b, dst, len);
+    case kSimdReluGrad:
+      return BinaryBroadcast<ReluGradOp>(a, scalar_a, b, scalar_b, dst, len);
+    default:
+      return 0;
+  }
+}
+
+size_t Unary(SimdOpType op_type, const float *a, float *dst, size_t len) {
+  switch (op_type) {
+    case kSimdNeg:
+      return UnaryLoop<NegOp>(a, dst, len);
+    case kSimdSquare:
+      return UnaryLoop<SquareOp>(a, dst, len);
+    case kSimdSqrt:
+      return UnaryLoop<SqrtOp>(a, dst, len);
+    case kSimdRelu:
+      return UnaryLoop<ReluOp>(a, dst, len);
+    default:
+      return 0;
+  }
+}
@@ -0,0 +1,175 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/simd_utils.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CPU_KERNEL_SIMD_X86
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define CPU_KERNEL_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace mindspore {
+namespace kernel {
+namespace {
+struct SimdLoops {
+  const char *name;
+  size_t (*reduce)(SimdOpType, const float *, size_t, float *);
+  size_t (*reduce_elementwise)(SimdOpType, float *, const float *, size_t);
+  size_t (*binary)(SimdOpType, const float *, bool, const float *, bool, float *, size_t);
+  size_t (*unary)(SimdOpType, const float *, float *, size_t);
+};
+
+#if defined(CPU_KERNEL_SIMD_X86)
+// SSE is part of x86-64, the wider instruction sets are only compiled here and entered when the CPU has them
+namespace simd_sse {
+using FloatVec = __m128;
+constexpr size_t kVecLen = 4;
+inline FloatVec VecLoad(const float *data) { return _mm_loadu_ps(data); }
+inline void VecStore(float *data, FloatVec value) { _mm_storeu_ps(data, value); }
+inline FloatVec VecSet(float value) { return _mm_set1_ps(value); }
+inline FloatVec VecAdd(FloatVec a, FloatVec b) { return _mm_add_ps(a, b); }
+inline FloatVec VecSub(FloatVec a, FloatVec b) { return _mm_sub_ps(a, b); }
+inline FloatVec VecMul(FloatVec a, FloatVec b) { return _mm_mul_ps(a, b); }
+inline FloatVec VecDiv(FloatVec a, FloatVec b) { return _mm_div_ps(a, b); }
+inline FloatVec VecMax(FloatVec a, FloatVec b) { return _mm_max_ps(a, b); }
+inline FloatVec VecMin(FloatVec a, FloatVec b) { return _mm_min_ps(a, b); }
+inline FloatVec VecSqrt(FloatVec a) { return _mm_sqrt_ps(a); }
+// a > 0 ? b : 0
+inline FloatVec VecSelectPositive(FloatVec a, FloatVec b) { return _mm_and_ps(_mm_cmpgt_ps(a, _mm_setzero_ps()), b); }
+#include "backend/kernel_compiler/cpu/simd_loops.h"
+const SimdLoops kLoops = {"sse", Reduce, ReduceElementwise, Binary, Unary};
+}  // namespace simd_sse
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+namespace simd_avx2 {
+using FloatVec = __m256;
+constexpr size_t kVecLen = 8;
+inline FloatVec VecLoad(const float *data) { return _mm256_loadu_ps(data); }
+inline void VecStore(float *data, FloatVec value) { _mm256_storeu_ps(data, value); }
+inline FloatVec VecSet(float value) { return _mm256_set1_ps(value); }
+inline FloatVec VecAdd(FloatVec a, FloatVec b) { return _mm256_add_ps(a, b); }
+inline FloatVec VecSub(FloatVec a, FloatVec b) { return _mm256_sub_ps(a, b); }
+inline FloatVec VecMul(FloatVec a, FloatVec b) { return _mm256_mul_ps(a, b); }
+inline FloatVec VecDiv(FloatVec a, FloatVec b) { return _mm256_div_ps(a, b); }
+inline FloatVec VecMax(FloatVec a, FloatVec b) { return _mm256_max_ps(a, b); }
+inline FloatVec VecMin(FloatVec a, FloatVec b) { return _mm256_min_ps(a, b); }
+inline FloatVec VecSqrt(FloatVec a) { return _mm256_sqrt_ps(a); }
+inline FloatVec VecSelectPositive(FloatVec a, FloatVec b) {
+  return _mm256_and_ps(_mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_GT_OQ), b);
+}
+#include "backend/kernel_compiler/cpu/simd_loops.h"
+const SimdLoops kLoops = {"avx2", Reduce, ReduceElementwise, Binary, Unary};
+}  // namespace simd_avx2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+// the unmasked max, min and sqrt of GCC 12 start from _mm512_undefined_ps, which it then reports as uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+namespace simd_avx512 {
+using FloatVec = __m512;
+constexpr size_t kVecLen = 16;
+inline FloatVec VecLoad(const float *data) { return _mm512_loadu_ps(data); }
+inline void VecStore(float *data, FloatVec value) { _mm512_storeu_ps(data, value); }
+inline FloatVec VecSet(float value) { return _mm512_set1_ps(value); }
+inline FloatVec VecAdd(FloatVec a, FloatVec b) { return _mm512_add_ps(a, b); }
+inline FloatVec VecSub(FloatVec a, FloatVec b) { return _mm512_sub_ps(a, b); }
+inline FloatVec VecMul(FloatVec a, FloatVec b) { return _mm512_mul_ps(a, b); }
+inline FloatVec VecDiv(FloatVec a, FloatVec b) { return _mm512_div_ps(a, b); }
+inline FloatVec VecMax(FloatVec a, FloatVec b) { return _mm512_max_ps(a, b); }
+inline FloatVec VecMin(FloatVec a, FloatVec b) { return _mm512_min_ps(a, b); }
+inline FloatVec VecSqrt(FloatVec a) { return _mm512_sqrt_ps(a); }
+inline FloatVec VecSelectPositive(FloatVec a, FloatVec b) {
+  return _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(a, _mm512_setzero_ps(), _CMP_GT_OQ), b);
+}
+#include "backend/kernel_compiler/cpu/simd_loops.h"
+const SimdLoops kLoops = {"avx512", Reduce, ReduceElementwise, Binary, Unary};
+}  // namespace simd_avx512
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+
+const SimdLoops &SelectSimdLoops() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return simd_avx512::kLoops;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return simd_avx2::kLoops;
+  }
+  return simd_sse::kLoops;
+}
+#elif defined(CPU_KERNEL_SIMD_NEON)
+namespace simd_neon {
+using FloatVec = float32x4_t;
+constexpr size_t kVecLen = 4;
+inline FloatVec VecLoad(const float *data) { return vld1q_f32(data); }
+inline void VecStore(float *data, FloatVec value) { vst1q_f32(data, value); }
+inline FloatVec VecSet(float value) { return vdupq_n_f32(value); }
+inline FloatVec VecAdd(FloatVec a, FloatVec b) { return vaddq_f32(a, b); }
+inline FloatVec VecSub(FloatVec a, FloatVec b) { return vsubq_f32(a, b); }
+inline FloatVec VecMul(FloatVec a, FloatVec b) { return vmulq_f32(a, b); }
+inline FloatVec VecDiv(FloatVec a, FloatVec b) { return vdivq_f32(a, b); }
+inline FloatVec VecMax(FloatVec a, FloatVec b) { return vmaxq_f32(a, b); }
+inline FloatVec VecMin(FloatVec a, FloatVec b) { return vminq_f32(a, b); }
+inline FloatVec VecSqrt(FloatVec a) { return vsqrtq_f32(a); }
+inline FloatVec VecSelectPositive(FloatVec a, FloatVec b) {
+  return vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(a, vdupq_n_f32(0.0f)), vreinterpretq_u32_f32(b)));
+}
+#include "backend/kernel_compiler/cpu/simd_loops.h"
+const SimdLoops kLoops = {"neon", Reduce, ReduceElementwise, Binary, Unary};
+}  // namespace simd_neon
+
+const SimdLoops &SelectSimdLoops() { return simd_neon::kLoops; }
+#else
+size_t NoReduce(SimdOpType, const float *, size_t, float *) { return 0; }
+size_t NoReduceElementwise(SimdOpType, float *, const float *, size_t) { return 0; }
+size_t NoBinary(SimdOpType, const float *, bool, const float *, bool, float *, size_t) { return 0; }
+size_t NoUnary(SimdOpType, const float *, float *, size_t) { return 0; }
+const SimdLoops kScalarLoops = {"scalar", NoReduce, NoReduceElementwise, NoBinary, NoUnary};
+
+const SimdLoops &SelectSimdLoops() { return kScalarLoops; }
+#endif
+
+const SimdLoops &GetSimdLoops() {
+  static const SimdLoops &loops = SelectSimdLoops();
+  return loops;
+}
+}  // namespace
+
+size_t SimdReduce(SimdOpType op_type, const float *data, size_t size, float *result) {
+  return GetSimdLoops().reduce(op_type, data, size, result);
+}
+
+size_t SimdReduceElementwise(SimdOpType op_type, float *acc, const float *data, size_t size) {
+  return GetSimdLoops().reduce_elementwise(op_type, acc, data, size);
+}
+
+size_t SimdBinary(SimdOpType op_type, const float *a, bool scalar_a, const float *b, bool scalar_b, float *dst,
+                  size_t len) {
+  return GetSimdLoops().binary(op_type, a, scalar_a, b, scalar_b, dst, len);
+}
+
+size_t SimdUnary(SimdOpType op_type, const float *a, float *dst, size_t len) {
+  return GetSimdLoops().unary(op_type, a, dst, len);
+}
+
+const char *SimdIsaName() { return GetSimdLoops().name; }
+}  // namespace kernel
+}  // namespace mindspore
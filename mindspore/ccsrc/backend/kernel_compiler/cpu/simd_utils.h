@@ -0,0 +1,56 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_SIMD_UTILS_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_SIMD_UTILS_H_
+
+#include <cstddef>
+
+// Float loops with a vector implementation. The build only assumes the baseline instruction set of the target, so
+// on x86-64 the loops are compiled for SSE, AVX2 and AVX-512 each, and the widest one the CPU supports is picked at
+// run time. On arm64 they use NEON. Each loop handles a prefix of the elements and returns its length, the caller
+// finishes the rest with its scalar loop.
+namespace mindspore {
+namespace kernel {
+enum SimdOpType {
+  kSimdAdd = 0,
+  kSimdSub,
+  kSimdMul,
+  kSimdDiv,
+  kSimdMax,
+  kSimdMin,
+  // inputs are (dy, x), dy where x > 0 and 0 elsewhere
+  kSimdReluGrad,
+  kSimdNeg,
+  kSimdSquare,
+  kSimdSqrt,
+  kSimdRelu
+};
+
+// *result = op(...op(op(*result, data[0]), data[1])...), in an unspecified order. Only add, mul, max and min.
+size_t SimdReduce(SimdOpType op_type, const float *data, size_t size, float *result);
+// acc[i] = op(acc[i], data[i]). Only add, mul, max and min.
+size_t SimdReduceElementwise(SimdOpType op_type, float *acc, const float *data, size_t size);
+// dst[i] = op(a[i], b[i]), a[0] is read for every element if scalar_a is set, and b[0] if scalar_b is
+size_t SimdBinary(SimdOpType op_type, const float *a, bool scalar_a, const float *b, bool scalar_b, float *dst,
+                  size_t len);
+// dst[i] = op(a[i])
+size_t SimdUnary(SimdOpType op_type, const float *a, float *dst, size_t len);
+// name of the instruction set the loops run with
+const char *SimdIsaName();
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_SIMD_UTILS_H_
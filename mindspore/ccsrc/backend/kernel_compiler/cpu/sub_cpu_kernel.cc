@@ -13,7 +13,6 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <thread>
 #include "backend/kernel_compiler/cpu/sub_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
@@ -30,12 +29,6 @@ void SubCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
 }
 
-void sub_task(const int *in_addr, int *out_addr, size_t lens, int offset) {
-  for (size_t i = 0; i < lens; i++) {
-    out_addr[i] = in_addr[i] - offset;
-  }
-}
-
 bool SubCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                           const std::vector<kernel::AddressPtr> & /*workspace*/,
                           const std::vector<kernel::AddressPtr> &outputs) {
@@ -50,29 +43,15 @@ bool SubCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   offset_ = *reinterpret_cast<int *>(inputs[1]->addr);
   MS_LOG(INFO) << "offset: " << offset_;
   auto lens = inputs[0]->size / sizeof(int);
-  if (lens < 10000) {
-    for (size_t i = 0; i < lens; i++) {
-      output_addr[i] = input_addr[i] - offset_;
-    }
-  } else {
-    const size_t thread_num = 4;
-    std::thread threads[4];
-    size_t process_lens = (lens + thread_num - 1) / thread_num;
-    size_t process_offset = 0;
-    for (size_t i = 0; i < thread_num; i++) {
-      threads[i] =
-        std::thread(sub_task, input_addr + process_offset, output_addr + process_offset, process_lens, offset_);
-      if (process_offset + process_lens > lens) {
-        process_lens = lens - process_offset;
-        process_offset = lens;
-      } else {
-        process_offset += process_lens;
+  const size_t kParallelGrain = 10000;
+  int offset = offset_;
+  CPUKernelUtils::ParallelFor(
+    [input_addr, output_addr, offset](size_t start, size_t end) {
+      for (size_t i = start; i < end; i++) {
+        output_addr[i] = input_addr[i] - offset;
       }
-    }
-    for (size_t i = 0; i < thread_num; i++) {
-      threads[i].join();
-    }
-  }
+    },
+    lens, kParallelGrain);
 #if defined(_WIN32) || defined(_WIN64)
   auto end_time = std::chrono::steady_clock::now();
   std::chrono::duration<double, std::ratio<1, 1000000>> cost = end_time - start_time;
@@ -0,0 +1,255 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/cpu_elemwise_fusion.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+#include "frontend/operator/ops.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/kernel_graph.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/fused_elemwise_cpu_kernel.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+// bounds the size of the attrs and of the per tile buffers of the fused kernel
+constexpr size_t kMaxGroupSize = 32;
+constexpr size_t kBiasOperandIndex = 1;
+
+// the operands of an elementwise op, AddN gets its operands packed in a MakeTuple
+std::vector<AnfNodePtr> GetOperands(const CNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  std::vector<AnfNodePtr> operands(node->inputs().begin() + 1, node->inputs().end());
+  if (operands.size() == 1 && IsPrimitiveCNode(operands[0], prim::kPrimMakeTuple)) {
+    auto make_tuple = operands[0]->cast<CNodePtr>();
+    operands.assign(make_tuple->inputs().begin() + 1, make_tuple->inputs().end());
+  }
+  return operands;
+}
+
+std::vector<size_t> GetOperandInferShape(const AnfNodePtr &operand) {
+  auto kernel_with_index = AnfAlgo::VisitKernel(operand, 0);
+  return AnfAlgo::GetOutputInferShape(kernel_with_index.first, kernel_with_index.second);
+}
+
+TypeId GetOperandInferDataType(const AnfNodePtr &operand) {
+  auto kernel_with_index = AnfAlgo::VisitKernel(operand, 0);
+  return AnfAlgo::GetOutputInferDataType(kernel_with_index.first, kernel_with_index.second);
+}
+
+// the output dim an operand of an elementwise op is aligned to, BiasAdd adds its bias on the channel dim
+size_t GetOperandDimOffset(const CNodePtr &node, size_t operand_index, const AnfNodePtr &operand,
+                           size_t output_rank) {
+  if (AnfAlgo::GetCNodeName(node) == kBiasAddOpName && operand_index == kBiasOperandIndex) {
+    return 1;
+  }
+  return output_rank - std::min(output_rank, GetOperandInferShape(operand).size());
+}
+
+// the fused kernel runs in float32, float16 tensors are widened tile by tile
+bool IsFusableType(TypeId type_id) { return type_id == kNumberTypeFloat32 || type_id == kNumberTypeFloat16; }
+
+bool IsFusableNode(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>() || !AnfAlgo::IsRealKernel(node)) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  size_t input_num = 0;
+  if (!kernel::FusedElemwiseCPUKernel::GetElemwiseOp(AnfAlgo::GetCNodeName(cnode), nullptr, &input_num)) {
+    return false;
+  }
+  auto operands = GetOperands(cnode);
+  if ((input_num != 0 && operands.size() != input_num) || (input_num == 0 && operands.size() < 2)) {
+    return false;
+  }
+  if (AnfAlgo::GetOutputTensorNum(cnode) != 1 || !IsFusableType(AnfAlgo::GetOutputInferDataType(cnode, 0))) {
+    return false;
+  }
+  auto output_type = AnfAlgo::GetOutputInferDataType(cnode, 0);
+  auto output_shape = AnfAlgo::GetOutputInferShape(cnode, 0);
+  for (size_t i = 0; i < operands.size(); ++i) {
+    if (IsPrimitiveCNode(operands[i], prim::kPrimMakeTuple) || GetOperandInferDataType(operands[i]) != output_type) {
+      return false;
+    }
+    auto input_shape = GetOperandInferShape(operands[i]);
+    size_t offset = GetOperandDimOffset(cnode, i, operands[i], output_shape.size());
+    if (offset + input_shape.size() > output_shape.size()) {
+      return false;
+    }
+    for (size_t j = 0; j < input_shape.size(); ++j) {
+      if (input_shape[j] != 1 && input_shape[j] != output_shape[offset + j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool HasCPUKernel(const CNodePtr &node) {
+  return !kernel::CPUKernelFactory::GetInstance().GetSupportedKernelAttrList(AnfAlgo::GetCNodeName(node)).empty();
+}
+}  // namespace
+
+std::vector<CNodePtr> CPUElemwiseFusion::CollectGroup(const FuncGraphPtr &func_graph, const CNodePtr &root,
+                                                      const std::unordered_set<AnfNodePtr> &fused) const {
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  auto &node_users = manager->node_users();
+  auto output_shape = AnfAlgo::GetOutputInferShape(root, 0);
+  auto output_type = AnfAlgo::GetOutputInferDataType(root, 0);
+  std::vector<CNodePtr> group{root};
+  std::unordered_set<AnfNodePtr> members{root};
+  // a MakeTuple packing the operands of a member is used by the group only
+  auto is_group_user = [&members, &node_users](const std::pair<AnfNodePtr, int> &user) {
+    if (members.count(user.first) != 0) {
+      return true;
+    }
+    auto tuple_users = node_users.find(user.first);
+    return IsPrimitiveCNode(user.first, prim::kPrimMakeTuple) && tuple_users != node_users.end() &&
+           tuple_users->second.size() == 1 && members.count(tuple_users->second.begin()->first) != 0;
+  };
+  for (size_t pos = 0; pos < group.size(); ++pos) {
+    auto operands = GetOperands(group[pos]);
+    for (size_t i = 0; i < operands.size() && group.size() < kMaxGroupSize; ++i) {
+      auto input = operands[i];
+      if (members.count(input) != 0 || fused.count(input) != 0 || !IsFusableNode(input) ||
+          AnfAlgo::GetOutputInferShape(input, 0) != output_shape ||
+          AnfAlgo::GetOutputInferDataType(input, 0) != output_type) {
+        continue;
+      }
+      // a producer whose result is needed outside of the group has to be written to memory anyway
+      auto users = node_users.find(input);
+      if (users == node_users.end() || !std::all_of(users->second.begin(), users->second.end(), is_group_user)) {
+        continue;
+      }
+      group.push_back(input->cast<CNodePtr>());
+      (void)members.insert(input);
+    }
+  }
+  return group;
+}
+
+AnfNodePtr CPUElemwiseFusion::CreateFusedNode(const FuncGraphPtr &func_graph,
+                                              const std::vector<CNodePtr> &group) const {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto root = group.back();
+  auto output_shape = AnfAlgo::GetOutputInferShape(root, 0);
+  // the inputs of the fused node are the operands from outside of the group, taken once for each dim offset
+  std::vector<AnfNodePtr> leaves;
+  std::vector<int> dim_offsets;
+  std::map<std::pair<AnfNodePtr, size_t>, size_t> leaf_index;
+  std::unordered_map<AnfNodePtr, size_t> member_index;
+  for (size_t i = 0; i < group.size(); ++i) {
+    member_index[group[i]] = i;
+  }
+  for (const auto &node : group) {
+    auto node_operands = GetOperands(node);
+    for (size_t i = 0; i < node_operands.size(); ++i) {
+      auto input = node_operands[i];
+      if (member_index.count(input) != 0) {
+        continue;
+      }
+      auto key = std::make_pair(input, GetOperandDimOffset(node, i, input, output_shape.size()));
+      if (leaf_index.count(key) == 0) {
+        leaf_index[key] = leaves.size();
+        leaves.push_back(input);
+        dim_offsets.push_back(SizeToInt(key.second));
+      }
+    }
+  }
+  std::vector<std::string> ops;
+  std::vector<int> operands;
+  std::vector<int> operand_nums;
+  for (const auto &node : group) {
+    ops.push_back(AnfAlgo::GetCNodeName(node));
+    auto node_operands = GetOperands(node);
+    operand_nums.push_back(SizeToInt(node_operands.size()));
+    for (size_t i = 0; i < node_operands.size(); ++i) {
+      auto input = node_operands[i];
+      auto iter = member_index.find(input);
+      if (iter != member_index.end()) {
+        operands.push_back(SizeToInt(leaves.size() + iter->second));
+      } else {
+        auto key = std::make_pair(input, GetOperandDimOffset(node, i, input, output_shape.size()));
+        operands.push_back(SizeToInt(leaf_index[key]));
+      }
+    }
+  }
+
+  auto prim = std::make_shared<Primitive>(kCPUFusedElemwiseOpName);
+  std::vector<AnfNodePtr> inputs{NewValueNode(prim)};
+  inputs.insert(inputs.end(), leaves.begin(), leaves.end());
+  auto fused_node = func_graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  fused_node->set_scope(root->scope());
+  AnfAlgo::SetOutputInferTypeAndShape({AnfAlgo::GetOutputInferDataType(root, 0)}, {output_shape}, fused_node.get());
+  AnfAlgo::SetNodeAttr(kAttrFusedOps, MakeValue(ops), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedOperands, MakeValue(operands), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedOperandNums, MakeValue(operand_nums), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrInputDimOffsets, MakeValue(dim_offsets), fused_node);
+  return fused_node;
+}
+
+bool CPUElemwiseFusion::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  auto kernel_graph = func_graph->cast<KernelGraphPtr>();
+  std::vector<AnfNodePtr> node_list = TopoSort(func_graph->get_return());
+  std::unordered_map<AnfNodePtr, size_t> topo_index;
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    topo_index[node_list[i]] = i;
+  }
+  std::unordered_set<AnfNodePtr> fused;
+  bool changed = false;
+  // walk from the outputs, so that every group grows from its last op towards its inputs
+  for (auto iter = node_list.rbegin(); iter != node_list.rend(); ++iter) {
+    auto node = *iter;
+    if (fused.count(node) != 0 || !IsFusableNode(node)) {
+      continue;
+    }
+    auto root = node->cast<CNodePtr>();
+    auto group = CollectGroup(func_graph, root, fused);
+    std::sort(group.begin(), group.end(),
+              [&topo_index](const CNodePtr &a, const CNodePtr &b) { return topo_index[a] < topo_index[b]; });
+    fused.insert(group.begin(), group.end());
+    if (group.size() == 1 && HasCPUKernel(root)) {
+      continue;
+    }
+    auto fused_node = CreateFusedNode(func_graph, group);
+    MS_LOG(INFO) << "Fuse " << group.size() << " elemwise ops into " << fused_node->DebugString();
+    if (!manager->Replace(root, fused_node)) {
+      MS_LOG(EXCEPTION) << "Manager replace node " << root->DebugString() << " failed";
+    }
+    if (kernel_graph != nullptr && kernel_graph->BackendNodeExistInFrontBackendMap(root)) {
+      kernel_graph->FrontBackendlMapUpdate(root, fused_node);
+    }
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,42 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_CPU_ELEMWISE_FUSION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_CPU_ELEMWISE_FUSION_H_
+#include <unordered_set>
+#include <vector>
+#include "backend/optimizer/common/pass.h"
+#include "ir/func_graph.h"
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace opt {
+// Merges connected fp32 elementwise ops of the same output shape into one CPUFusedElemwise node, so that the
+// intermediate tensors are never written to memory. A node joins the group of its consumer only when all of its users
+// are in that group. Single elementwise ops without a cpu kernel of their own are wrapped as well.
+class CPUElemwiseFusion : public Pass {
+ public:
+  CPUElemwiseFusion() : Pass("cpu_elemwise_fusion") {}
+  ~CPUElemwiseFusion() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+
+ private:
+  std::vector<CNodePtr> CollectGroup(const FuncGraphPtr &func_graph, const CNodePtr &root,
+                                     const std::unordered_set<AnfNodePtr> &fused) const;
+  AnfNodePtr CreateFusedNode(const FuncGraphPtr &func_graph, const std::vector<CNodePtr> &group) const;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_CPU_ELEMWISE_FUSION_H_
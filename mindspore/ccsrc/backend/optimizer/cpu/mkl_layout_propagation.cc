@@ -0,0 +1,143 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/mkl_layout_propagation.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/kernel_compiler/kernel_build_info.h"
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kActivationRank = 4;
+
+struct LayoutAwareOp {
+  // the inputs holding activations, the other inputs are weights or attributes read in the default layout
+  std::vector<size_t> activation_inputs;
+  bool activation_output;
+};
+
+// the mkl-dnn kernels that take their activations in any layout and reorder internally when they need to
+const std::map<std::string, LayoutAwareOp> kLayoutAwareOps = {
+  {"Conv2D", {{0}, true}},
+  {"Conv2DBackpropInput", {{0}, true}},
+  {"Conv2DBackpropFilter", {{0, 1}, false}},
+  {"MaxPool", {{0}, true}},
+  {"ReLU", {{0}, true}},
+  {"ReluGrad", {{0, 1}, true}},
+};
+
+const LayoutAwareOp *GetLayoutAwareOp(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>() || !AnfAlgo::IsRealKernel(node) || AnfAlgo::GetSelectKernelBuildInfo(node) == nullptr) {
+    return nullptr;
+  }
+  auto iter = kLayoutAwareOps.find(AnfAlgo::GetCNodeName(node));
+  if (iter == kLayoutAwareOps.end()) {
+    return nullptr;
+  }
+  for (auto index : iter->second.activation_inputs) {
+    if (index >= AnfAlgo::GetInputTensorNum(node) ||
+        AnfAlgo::GetInputDeviceDataType(node, index) != kNumberTypeFloat32 ||
+        AnfAlgo::GetPrevNodeOutputInferShape(node, index).size() != kActivationRank) {
+      return nullptr;
+    }
+  }
+  if (iter->second.activation_output && (AnfAlgo::GetOutputDeviceDataType(node, 0) != kNumberTypeFloat32 ||
+                                         AnfAlgo::GetOutputInferShape(node, 0).size() != kActivationRank)) {
+    return nullptr;
+  }
+  return &iter->second;
+}
+
+bool IsActivationInput(const AnfNodePtr &user, int input_index) {
+  auto op = GetLayoutAwareOp(user);
+  if (op == nullptr || input_index < 1) {
+    return false;
+  }
+  auto index = IntToSize(input_index - 1);
+  return std::find(op->activation_inputs.begin(), op->activation_inputs.end(), index) != op->activation_inputs.end();
+}
+
+void SetFormat(const AnfNodePtr &node, const std::vector<size_t> &input_indexes, bool output) {
+  auto build_info = std::make_shared<kernel::KernelBuildInfo>(*AnfAlgo::GetSelectKernelBuildInfo(node));
+  auto inputs_format = build_info->GetAllInputFormats();
+  auto outputs_format = build_info->GetAllOutputFormats();
+  for (auto index : input_indexes) {
+    inputs_format[index] = kOpFormat_NC1HWC0;
+  }
+  if (output) {
+    outputs_format[0] = kOpFormat_NC1HWC0;
+  }
+  kernel::KernelBuildInfo::KernelBuildInfoBuilder builder(build_info);
+  builder.SetInputsFormat(inputs_format);
+  builder.SetOutputsFormat(outputs_format);
+  AnfAlgo::SetSelectKernelBuildInfo(build_info, node.get());
+}
+}  // namespace
+
+bool MKLLayoutPropagation::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  if (!kernel::MKLKernelEngine::Get().blocked_layout_supported()) {
+    MS_LOG(INFO) << "The cpu has no avx512, keep the default layout between mkl-dnn kernels";
+    return false;
+  }
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  auto &node_users = manager->node_users();
+  std::vector<AnfNodePtr> node_list = TopoSort(func_graph->get_return());
+  // the inputs of every node that read a blocked activation, collected first so that the checks above see the formats
+  // kernel selection gave
+  std::map<AnfNodePtr, std::vector<size_t>> blocked_inputs;
+  std::vector<AnfNodePtr> blocked_outputs;
+  for (const auto &node : node_list) {
+    auto op = GetLayoutAwareOp(node);
+    if (op == nullptr || !op->activation_output) {
+      continue;
+    }
+    auto users = node_users.find(node);
+    if (users == node_users.end() || users->second.empty() ||
+        !std::all_of(users->second.begin(), users->second.end(), [](const std::pair<AnfNodePtr, int> &user) {
+          return IsActivationInput(user.first, user.second);
+        })) {
+      continue;
+    }
+    blocked_outputs.push_back(node);
+    for (const auto &user : users->second) {
+      blocked_inputs[user.first].push_back(IntToSize(user.second - 1));
+    }
+  }
+  for (const auto &node : blocked_outputs) {
+    SetFormat(node, blocked_inputs[node], true);
+    (void)blocked_inputs.erase(node);
+  }
+  for (const auto &iter : blocked_inputs) {
+    SetFormat(iter.first, iter.second, false);
+  }
+  MS_LOG(INFO) << "Keep " << blocked_outputs.size() << " activations in the blocked layout";
+  return !blocked_outputs.empty();
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,36 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_MKL_LAYOUT_PROPAGATION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_MKL_LAYOUT_PROPAGATION_H_
+#include "backend/optimizer/common/pass.h"
+#include "ir/func_graph.h"
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace opt {
+// Keeps the activations passed between adjacent mkl-dnn kernels in the blocked nChw16c layout, which is the NC1HWC0
+// format with a block of 16 channels. An output is given that format only when every user is a layout aware kernel
+// reading it as an activation, so graph outputs and other kernels always see the default layout and the reorders
+// happen inside the kernels at the edges of a region. Runs after kernel selection, on fp32 4d tensors only.
+class MKLLayoutPropagation : public Pass {
+ public:
+  MKLLayoutPropagation() : Pass("mkl_layout_propagation") {}
+  ~MKLLayoutPropagation() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_MKL_LAYOUT_PROPAGATION_H_
@@ -39,7 +39,9 @@ class CPUSession : public SessionBasic {
   ParameterPtr CreateNewParameterFromParameter(const AnfNodePtr &anf, bool valid_input, KernelGraph *graph) override;
 
  private:
+  void Optimize(const std::shared_ptr<KernelGraph> &kernel_graph);
   void SetKernelInfo(const KernelGraph *kernel_graph);
+  void OptimizeLayout(const std::shared_ptr<KernelGraph> &kernel_graph);
   void BuildKernel(const KernelGraph *kernel_graph);
   device::cpu::CPUKernelRuntime runtime_;
 };
@@ -0,0 +1,255 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/thread_pool.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace common {
+namespace {
+constexpr auto kIntraOpThreadNumEnv = "MS_CPU_INTRA_OP_THREAD_NUM";
+constexpr auto kIntraOpBindNumaEnv = "MS_CPU_INTRA_OP_BIND_NUMA";
+constexpr size_t kMaxNumaNodeNum = 64;
+
+size_t GetAvailableCpuNum() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    int cpu_num = CPU_COUNT(&cpu_set);
+    if (cpu_num > 0) {
+      return static_cast<size_t>(cpu_num);
+    }
+  }
+#endif
+  size_t cpu_num = std::thread::hardware_concurrency();
+  return cpu_num > 0 ? cpu_num : 1;
+}
+
+size_t GetThreadNum() {
+  auto thread_num_str = GetEnv(kIntraOpThreadNumEnv);
+  if (thread_num_str.empty()) {
+    return GetAvailableCpuNum();
+  }
+  int thread_num = 0;
+  try {
+    thread_num = std::stoi(thread_num_str);
+  } catch (const std::exception &) {
+    MS_LOG(WARNING) << "Invalid " << kIntraOpThreadNumEnv << ": " << thread_num_str;
+  }
+  return thread_num > 0 ? static_cast<size_t>(thread_num) : GetAvailableCpuNum();
+}
+
+// parse a sysfs cpu list such as "0-15,32-47"
+std::vector<int> ParseCpuList(const std::string &cpu_list) {
+  std::vector<int> cpus;
+  std::stringstream ss(cpu_list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    auto pos = range.find('-');
+    try {
+      int first = std::stoi(range.substr(0, pos));
+      int last = pos == std::string::npos ? first : std::stoi(range.substr(pos + 1));
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception &) {
+      MS_LOG(WARNING) << "Invalid cpu list: " << cpu_list;
+      return {};
+    }
+  }
+  return cpus;
+}
+
+std::vector<std::vector<int>> GetNumaCpus() {
+  std::vector<std::vector<int>> numa_cpus;
+  for (size_t node = 0; node < kMaxNumaNodeNum; ++node) {
+    std::ifstream cpu_list_file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!cpu_list_file.is_open()) {
+      break;
+    }
+    std::string cpu_list;
+    std::getline(cpu_list_file, cpu_list);
+    auto cpus = ParseCpuList(cpu_list);
+    if (!cpus.empty()) {
+      numa_cpus.push_back(cpus);
+    }
+  }
+  return numa_cpus;
+}
+}  // namespace
+
+ThreadPool &ThreadPool::GetInstance() {
+  static ThreadPool instance;
+  return instance;
+}
+
+ThreadPool::ThreadPool() {
+  thread_num_ = GetThreadNum();
+  bind_numa_ = GetEnv(kIntraOpBindNumaEnv) == "1";
+  if (bind_numa_) {
+    numa_cpus_ = GetNumaCpus();
+  }
+  MS_LOG(INFO) << "Intra op thread pool size " << thread_num_ << ", numa node num " << numa_cpus_.size();
+  // the calling thread always takes part, so one worker less is needed
+  for (size_t i = 1; i < thread_num_; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  job_cond_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void ThreadPool::BindWorker(size_t worker_id) const {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (!bind_numa_ || numa_cpus_.empty()) {
+    return;
+  }
+  const auto &cpus = numa_cpus_[worker_id * numa_cpus_.size() / thread_num_];
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) {
+    MS_LOG(WARNING) << "Bind intra op worker " << worker_id << " to numa node failed";
+  }
+#endif
+}
+
+bool ThreadPool::RunJobTasks(const JobPtr &job) {
+  bool finish_last = false;
+  while (true) {
+    size_t task_id = job->next_task.fetch_add(1);
+    if (task_id >= job->task_num) {
+      break;
+    }
+    // after a failure the left tasks are only counted, so that Run can return
+    if (!job->failed) {
+      try {
+        job->task(task_id);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (job->error == nullptr) {
+          job->error = std::current_exception();
+        }
+        job->failed = true;
+      }
+    }
+    if (job->finished_task.fetch_add(1) + 1 == job->task_num) {
+      finish_last = true;
+    }
+  }
+  return finish_last;
+}
+
+void ThreadPool::WorkerLoop(size_t worker_id) {
+  BindWorker(worker_id);
+  while (true) {
+    JobPtr job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_cond_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+      if (stop_) {
+        return;
+      }
+      job = jobs_.front();
+      if (job->next_task >= job->task_num) {
+        jobs_.pop_front();
+        continue;
+      }
+    }
+    if (RunJobTasks(job)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      finish_cond_.notify_all();
+    }
+  }
+}
+
+void ThreadPool::Run(size_t task_num, const Task &task) {
+  if (task_num == 0) {
+    return;
+  }
+  if (task_num == 1 || workers_.empty()) {
+    for (size_t i = 0; i < task_num; ++i) {
+      task(i);
+    }
+    return;
+  }
+  auto job = std::make_shared<Job>();
+  job->task = task;
+  job->task_num = task_num;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(job);
+  }
+  job_cond_.notify_all();
+  (void)RunJobTasks(job);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  finish_cond_.wait(lock, [&job] { return job->finished_task == job->task_num; });
+  auto iter = std::find(jobs_.begin(), jobs_.end(), job);
+  if (iter != jobs_.end()) {
+    (void)jobs_.erase(iter);
+  }
+  if (job->error != nullptr) {
+    auto error = job->error;
+    lock.unlock();
+    std::rethrow_exception(error);
+  }
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grain, const RangeTask &task) {
+  if (count == 0) {
+    return;
+  }
+  grain = std::max(grain, static_cast<size_t>(1));
+  size_t task_num = std::min(thread_num_, (count + grain - 1) / grain);
+  if (task_num <= 1) {
+    task(0, count);
+    return;
+  }
+  size_t once_compute_size = (count + task_num - 1) / task_num;
+  task_num = (count + once_compute_size - 1) / once_compute_size;
+  Run(task_num, [&task, count, once_compute_size](size_t task_id) {
+    size_t start = task_id * once_compute_size;
+    size_t end = std::min(count, start + once_compute_size);
+    task(start, end);
+  });
+}
+}  // namespace common
+}  // namespace mindspore
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
+#define MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/utils.h"
+
+namespace mindspore {
+namespace common {
+using Task = std::function<void(size_t task_id)>;
+using RangeTask = std::function<void(size_t start, size_t end)>;
+
+// Process-wide pool for intra-op parallelism of host kernels.
+// MS_CPU_INTRA_OP_THREAD_NUM sets the thread number, it defaults to the cores this process may run on.
+// MS_CPU_INTRA_OP_BIND_NUMA=1 binds every worker to the cores of one numa node, nodes are filled one by one.
+class ThreadPool {
+ public:
+  static ThreadPool &GetInstance();
+  DISABLE_COPY_AND_ASSIGN(ThreadPool)
+  ~ThreadPool();
+
+  size_t thread_num() const { return thread_num_; }
+  // Run task(0) ... task(task_num - 1) and return when all of them are done. The calling thread takes tasks too, so
+  // it is safe to call from inside a task. The first exception thrown by a task is rethrown here.
+  void Run(size_t task_num, const Task &task);
+  // Split [0, count) into at most thread_num() ranges of at least grain elements and run them in parallel.
+  void ParallelFor(size_t count, size_t grain, const RangeTask &task);
+
+ private:
+  struct Job {
+    Task task;
+    size_t task_num{0};
+    std::atomic<size_t> next_task{0};
+    std::atomic<size_t> finished_task{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error{nullptr};
+  };
+  using JobPtr = std::shared_ptr<Job>;
+
+  ThreadPool();
+  void WorkerLoop(size_t worker_id);
+  // run tasks of the job until none is left, return true if this call finished the last one
+  bool RunJobTasks(const JobPtr &job);
+  void BindWorker(size_t worker_id) const;
+
+  size_t thread_num_{1};
+  bool bind_numa_{false};
+  std::vector<std::vector<int>> numa_cpus_;
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable job_cond_;
+  std::condition_variable finish_cond_;
+  std::deque<JobPtr> jobs_;
+  bool stop_{false};
+};
+}  // namespace common
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
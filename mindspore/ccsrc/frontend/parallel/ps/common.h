@@ -31,6 +31,10 @@ constexpr char kEnvPServerNum[] = "MS_SERVER_NUM";
 constexpr char kEnvWorkerNum[] = "MS_WORKER_NUM";
 constexpr char kEnvSchedulerHost[] = "MS_SCHED_HOST";
 constexpr char kEnvSchedulerPort[] = "MS_SCHED_PORT";
+constexpr char kEnvPSStaleness[] = "MS_PS_STALENESS";
+constexpr char kEnvPSUpdateThreadNum[] = "MS_PS_UPDATE_THREAD_NUM";
+constexpr char kEnvEmbeddingCacheSize[] = "MS_PS_EMBEDDING_CACHE_SIZE";
+constexpr char kEnvEmbeddingCacheStaleness[] = "MS_PS_EMBEDDING_CACHE_STALENESS";
 
 constexpr char kEnvRole[] = "MS_ROLE";
 constexpr char kEnvRoleOfPServer[] = "MS_PSERVER";
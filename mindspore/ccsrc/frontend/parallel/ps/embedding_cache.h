@@ -0,0 +1,125 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_MINDSPORE_CCSRC_PARALLEL_PS_EMBEDDING_CACHE_H_
+#define MINDSPORE_MINDSPORE_CCSRC_PARALLEL_PS_EMBEDDING_CACHE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+// An LRU cache of the embedding rows a worker looked up, so that the hot rows of skewed id distributions are not
+// fetched from the servers on every step. Every push of a table is a new version of its weights; a row fetched at
+// version v serves lookups until version v + staleness and is dropped after that. A capacity of 0 disables the cache.
+template <typename T>
+class EmbeddingCache {
+ public:
+  EmbeddingCache(size_t capacity, size_t staleness) : capacity_(capacity), staleness_(staleness) {}
+  ~EmbeddingCache() = default;
+
+  bool enabled() const { return capacity_ > 0; }
+  size_t size() const { return entries_.size(); }
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+
+  // copies the row of id to dst and returns true when it is cached and fresh enough
+  bool Lookup(uint64_t table_key, uint64_t id, T *dst, size_t row_len) {
+    if (!enabled()) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = index_.find(RowKey(table_key, id));
+    if (iter == index_.end()) {
+      miss_count_++;
+      return false;
+    }
+    auto entry = iter->second;
+    if (entry->version + staleness_ < versions_[table_key] || entry->row.size() != row_len) {
+      entries_.erase(entry);
+      index_.erase(iter);
+      miss_count_++;
+      return false;
+    }
+    std::copy(entry->row.begin(), entry->row.end(), dst);
+    entries_.splice(entries_.begin(), entries_, entry);
+    hit_count_++;
+    return true;
+  }
+
+  void Insert(uint64_t table_key, uint64_t id, const T *row, size_t row_len) {
+    if (!enabled()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto row_key = RowKey(table_key, id);
+    auto iter = index_.find(row_key);
+    if (iter != index_.end()) {
+      entries_.erase(iter->second);
+      index_.erase(iter);
+    }
+    entries_.push_front({row_key, versions_[table_key], std::vector<T>(row, row + row_len)});
+    index_[row_key] = entries_.begin();
+    while (entries_.size() > capacity_) {
+      index_.erase(entries_.back().row_key);
+      entries_.pop_back();
+    }
+  }
+
+  // the weights of the table were pushed to the servers, the cached rows age by one version
+  void Update(uint64_t table_key) {
+    if (!enabled()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    versions_[table_key]++;
+  }
+
+ private:
+  using RowKey = std::pair<uint64_t, uint64_t>;
+  struct RowKeyHash {
+    size_t operator()(const RowKey &key) const {
+      return std::hash<uint64_t>()(key.first * 0x9e3779b97f4a7c15ULL ^ key.second);
+    }
+  };
+  struct Entry {
+    RowKey row_key;
+    size_t version;
+    std::vector<T> row;
+  };
+  using EntryIter = typename std::list<Entry>::iterator;
+
+  size_t capacity_;
+  size_t staleness_;
+  // the most recently used row first
+  std::list<Entry> entries_;
+  std::unordered_map<RowKey, EntryIter, RowKeyHash> index_;
+  std::unordered_map<uint64_t, size_t> versions_;
+  size_t hit_count_{0};
+  size_t miss_count_{0};
+  std::mutex mutex_;
+};
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
+#endif  // MINDSPORE_MINDSPORE_CCSRC_PARALLEL_PS_EMBEDDING_CACHE_H_
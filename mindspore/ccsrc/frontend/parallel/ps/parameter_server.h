@@ -18,12 +18,17 @@
 #define MINDSPORE_MINDSPORE_CCSRC_PARALLEL_PS_PARAMETER_SERVER_H_
 
 #include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <deque>
 #include <unordered_map>
 #include <string>
 #include <iostream>
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
 #include <thread>
 #include <cmath>
@@ -66,17 +71,41 @@ class ParameterServer {
       : pserver_num_(0),
         worker_num_(0),
         rank_id_(0),
-        grad_accum_count_(0),
+        staleness_(0),
         ps_(new ::ps::KVServer<T>(0)),
         handler_(nullptr),
         func_graph_(nullptr),
         kernel_graph_(nullptr),
-        sess_(nullptr),
-        thread_(nullptr) {}
+        sess_(nullptr) {}
   ~ParameterServer() = default;
   ParameterServer(const ParameterServer &) = delete;
   ParameterServer &operator=(const ParameterServer &) = delete;
 
+  // Everything the traffic of one key touches. It is guarded by the stripe the key falls in, so that pushes, pulls and
+  // updates of different keys run at the same time. Each key has its own optimizer kernel, since kernels keep the
+  // shapes of their inputs.
+  struct KeyState {
+    WeightPtr weight;
+    GradPtr grad;
+    // a copy of the weight made after every update, the pulls of the async mode read it without taking the stripe.
+    // Embedding tables have none, they are only read through their lookup op.
+    WeightPtr snapshot;
+    std::string optim_name;
+    InputsShapePtr optim_inputs_shape;
+    std::shared_ptr<PServerKernel> optimizer;
+    std::shared_ptr<OptimizerInfo> optim_info;
+    std::shared_ptr<PServerKernel> lookup_op;
+    // pushes accumulated since the last update, and whether an update of the key is waiting for an update thread
+    size_t pending_pushes{0};
+    bool update_queued{false};
+  };
+  using KeyStatePtr = std::shared_ptr<KeyState>;
+
+  struct Stripe {
+    std::mutex mutex;
+    std::condition_variable update_done;
+  };
+
   struct ServerHandler {
     explicit ServerHandler(ParameterServer *ps) : ps_(ps) {}
     void operator()(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVServer<T> *server);
@@ -99,45 +128,51 @@ class ParameterServer {
   void InitEmbeddingTable(const Key &key,
                           const std::shared_ptr<std::vector<std::shared_ptr<std::vector<size_t>>>> &shapes);
   void UpdateWeights();
+  void UpdateWeight(const Key &key);
   void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
   WeightPtr weight(const Key &key);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res);
   int SumOfShapes(const std::vector<int> &shapes) const;
   size_t PreComputeCapacity(const Keys &keys, const Lengths &lens);
-  bool ReadyForUpdateWeights();
-  bool ReadyForAccumGrads();
-  void ResetGradAccumCount();
+  KeyStatePtr key_state(const Key &key);
+  // the caller holds keys_mutex_ exclusively
+  KeyStatePtr GetOrCreateKeyState(const Key &key);
+  Stripe &stripe(const Key &key) { return stripes_[key % kStripeNum]; }
+  bool ReadyForUpdateWeight(const KeyState &state) const;
+  bool ReadyForAccumGrad(const KeyState &state) const;
+  void ScheduleUpdate(const Key &key);
+  void PublishSnapshot(KeyState *state) const;
 
   size_t pserver_num_;
   size_t worker_num_;
   size_t rank_id_;
-  size_t grad_accum_count_;
+  // 0 runs synchronous updates: a key is updated once every worker pushed it and the next pushes of the key wait for
+  // that update. Above 0 every push is applied on its own, pulls never wait for an update in flight and a push only
+  // waits when that many pushes of its key are still not applied.
+  size_t staleness_;
   std::unique_ptr<::ps::KVServer<T>> ps_;
   std::unique_ptr<ServerHandler> handler_;
   FuncGraphPtr func_graph_;
   std::shared_ptr<session::KernelGraph> kernel_graph_;
   std::shared_ptr<session::SessionBasic> sess_;
 
-  std::unordered_map<std::string, std::shared_ptr<PServerKernel>> optimizers_;
-  std::unordered_map<Key, InputsShapePtr> optim_inputs_shape_;
-  std::unordered_map<Key, std::shared_ptr<OptimizerInfo>> optim_infos_;
   std::unordered_map<std::string, std::shared_ptr<OptimizerInfoBuilder>> optim_info_builders_;
-  std::unordered_map<Key, std::string> weight_key_to_optims_;
-  std::unordered_map<Key, WeightPtr> weights_;
-  std::unordered_map<Key, WeightPtr> grads_;
-  std::unordered_map<Key, size_t> grads_accum_counter_;
-  // std::unordered_map<Key, EmbeddingTablePtr> embeddings_;
-  std::unordered_map<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
+  // the keys only change while the workers init them, the traffic of a key holds keys_mutex_ just to find its state
+  std::shared_mutex keys_mutex_;
+  std::unordered_map<Key, KeyStatePtr> key_states_;
   std::unordered_map<Key, size_t> embedding_row_lens_;
 
   T learning_rate_;
   T momentum_;
 
-  std::mutex mutex_;
-  std::condition_variable apply_grads_cv_;
-  std::condition_variable accum_grads_cv_;
+  static constexpr size_t kStripeNum = 64;
+  std::array<Stripe, kStripeNum> stripes_;
 
-  std::unique_ptr<std::thread> thread_;
+  // the keys ready for an update, each queued once, taken by a pool of update threads
+  std::mutex update_mutex_;
+  std::condition_variable update_cv_;
+  std::deque<Key> update_queue_;
+  std::vector<std::thread> update_threads_;
 
   friend struct ServerHandler;
 };
@@ -251,7 +286,7 @@ void ParameterServer<T>::ServerHandler::HandleEmbeddingLookup(const ::ps::KVMeta
   const Key &key = req_data.keys[0];
   ps_->DoEmbeddingLookup(key, req_data.vals, res);
   for (size_t i = 0; i < req_data.vals.size(); i++) {
-    res->keys->push_back(req_data.vals[i]);
+    res->keys.push_back(static_cast<Key>(req_data.vals[i]));
   }
 }
 
@@ -265,6 +300,17 @@ bool ParameterServer<T>::Init(const FuncGraphPtr &func_graph) {
   if (worker_num != nullptr) {
     worker_num_ = *worker_num - '0';
   }
+  // the optimizer infos of the sparse optimizers hold the pushes of at most worker_num_ workers
+  const char *staleness = getenv(kEnvPSStaleness);
+  if (staleness != nullptr) {
+    staleness_ = std::min(static_cast<size_t>(std::strtoul(staleness, nullptr, 10)), worker_num_);
+  }
+  size_t update_thread_num = std::max(std::thread::hardware_concurrency(), 1U);
+  const char *thread_num = getenv(kEnvPSUpdateThreadNum);
+  if (thread_num != nullptr && std::strtoul(thread_num, nullptr, 10) > 0) {
+    update_thread_num = std::strtoul(thread_num, nullptr, 10);
+  }
+  MS_LOG(INFO) << "Parameter server runs " << update_thread_num << " update threads, staleness " << staleness_;
   func_graph_ = func_graph;
   rank_id_ = ::ps::MyRank();
   handler_.reset(new ServerHandler(this));
@@ -272,7 +318,9 @@ bool ParameterServer<T>::Init(const FuncGraphPtr &func_graph) {
   InitOptimInfoBuilders();
 
   ps_->set_request_handle(*handler_);
-  thread_.reset(new std::thread(&ParameterServer::UpdateWeights, this));
+  for (size_t i = 0; i < update_thread_num; i++) {
+    update_threads_.emplace_back(&ParameterServer::UpdateWeights, this);
+  }
   return true;
 }
 
@@ -286,12 +334,33 @@ void ParameterServer<T>::InitOptimInfoBuilders() {
   optim_info_builders_[kSparseFtrl] = sparse_ftrl_info_builder;
 }
 
+template <typename T>
+typename ParameterServer<T>::KeyStatePtr ParameterServer<T>::key_state(const Key &key) {
+  std::shared_lock<std::shared_mutex> lock(keys_mutex_);
+  auto iter = key_states_.find(key);
+  if (iter == key_states_.end()) {
+    return nullptr;
+  }
+  return iter->second;
+}
+
+template <typename T>
+typename ParameterServer<T>::KeyStatePtr ParameterServer<T>::GetOrCreateKeyState(const Key &key) {
+  auto &state = key_states_[key];
+  if (state == nullptr) {
+    state = std::make_shared<KeyState>();
+  }
+  return state;
+}
+
 template <typename T>
 void ParameterServer<T>::InitWeightKeyToOptims(const Key &key, const int &optim_id) {
-  if (weight_key_to_optims_.count(key) > 0 || Util::optimizer_name(key) == "") {
+  std::unique_lock<std::shared_mutex> lock(keys_mutex_);
+  auto state = GetOrCreateKeyState(key);
+  if (!state->optim_name.empty() || Util::optimizer_name(key) == "") {
     return;
   }
-  weight_key_to_optims_[key] = Util::optimizer_name(optim_id);
+  state->optim_name = Util::optimizer_name(optim_id);
 }
 
 template <typename T>
@@ -300,8 +369,10 @@ void ParameterServer<T>::InitOptimInputsShape(const Keys &keys, const Values &va
   int val_idx = 0;
   const Key &key = keys[0];
 
-  if (optim_inputs_shape_.count(key) == 0) {
-    optim_inputs_shape_[key] = inputs_shape;
+  std::unique_lock<std::shared_mutex> lock(keys_mutex_);
+  auto state = GetOrCreateKeyState(key);
+  if (state->optim_inputs_shape == nullptr) {
+    state->optim_inputs_shape = inputs_shape;
   }
   for (size_t i = 0; i < keys.size(); i++) {
     auto shape = std::make_shared<std::vector<size_t>>();
@@ -312,41 +383,40 @@ void ParameterServer<T>::InitOptimInputsShape(const Keys &keys, const Values &va
       shape->push_back(values[val_idx++]);
     }
   }
-  if (weight_key_to_optims_.count(key) > 0) {
-    const std::string &optim_name = weight_key_to_optims_[key];
-    if (optimizers_.count(optim_name) == 0 && optim_inputs_shape_.count(key) > 0) {
-      if (optim_name == kSparseAdam) {
-        std::shared_ptr<PServerKernel> optimizer =
-          std::make_shared<kernel::ps::SparseApplyAdamPSKernel>(rank_id_, pserver_num_);
-        optimizer->InitKernel(optim_inputs_shape_[key]);
-        optimizers_[optim_name] = optimizer;
-      } else if (optim_name == kApplyMomentum) {
-        std::shared_ptr<PServerKernel> optimizer =
-          std::make_shared<kernel::ps::ApplyMomentumPSKernel>(rank_id_, pserver_num_);
-        optimizer->InitKernel(optim_inputs_shape_[key]);
-        optimizers_[optim_name] = optimizer;
-      } else if (optim_name == kSparseFtrl) {
-        std::shared_ptr<PServerKernel> optimizer =
-          std::make_shared<kernel::ps::SparseApplyFtrlPSKernel>(rank_id_, pserver_num_);
-        optimizer->InitKernel(optim_inputs_shape_[key]);
-        optimizers_[optim_name] = optimizer;
-      }
+  const std::string &optim_name = state->optim_name;
+  if (!optim_name.empty() && state->optimizer == nullptr) {
+    std::shared_ptr<PServerKernel> optimizer = nullptr;
+    if (optim_name == kSparseAdam) {
+      optimizer = std::make_shared<kernel::ps::SparseApplyAdamPSKernel>(rank_id_, pserver_num_);
+    } else if (optim_name == kApplyMomentum) {
+      optimizer = std::make_shared<kernel::ps::ApplyMomentumPSKernel>(rank_id_, pserver_num_);
+    } else if (optim_name == kSparseFtrl) {
+      optimizer = std::make_shared<kernel::ps::SparseApplyFtrlPSKernel>(rank_id_, pserver_num_);
+    }
+    if (optimizer != nullptr) {
+      optimizer->InitKernel(state->optim_inputs_shape);
+      state->optimizer = optimizer;
     }
   }
 }
 
 template <typename T>
 void ParameterServer<T>::InitWeight(const Key &key, const WeightPtr &weight) {
-  if (weights_.count(key) == 0) {
-    weights_[key] = weight;
+  std::unique_lock<std::shared_mutex> lock(keys_mutex_);
+  auto state = GetOrCreateKeyState(key);
+  if (state->weight == nullptr) {
+    state->weight = weight;
+    PublishSnapshot(state.get());
   }
 }
 
 template <typename T>
 void ParameterServer<T>::InitGrad(const Key &key, const GradPtr &grad) {
-  if (grads_.count(key) == 0) {
-    grads_[key] = grad;
-    grads_accum_counter_[key] = 0;
+  std::unique_lock<std::shared_mutex> lock(keys_mutex_);
+  auto state = GetOrCreateKeyState(key);
+  if (state->grad == nullptr) {
+    state->grad = grad;
+    state->pending_pushes = 0;
   }
 }
 
@@ -356,7 +426,6 @@ void ParameterServer<T>::InitEmbeddingTable(
   // Init embedding lookup kernel
   std::shared_ptr<PServerKernel> lookup = std::make_shared<kernel::ps::EmbeddingLookUpPSKernel>(rank_id_, pserver_num_);
   lookup->InitKernel(shapes);
-  embedding_lookup_ops_[key] = lookup;
 
   // Init embedding weight
   const std::vector<size_t> &input_shapes = lookup->input_sizes();
@@ -365,66 +434,76 @@ void ParameterServer<T>::InitEmbeddingTable(
     total_dims *= shape;
   }
   WeightPtr embedding = std::make_shared<Weight>(total_dims, 0.01);
-  weights_[key] = embedding;
 
-  grads_accum_counter_[key] = 0;
+  std::unique_lock<std::shared_mutex> lock(keys_mutex_);
+  auto state = GetOrCreateKeyState(key);
+  state->lookup_op = lookup;
+  state->weight = embedding;
+  state->pending_pushes = 0;
+  PublishSnapshot(state.get());
 }
 
 template <typename T>
 void ParameterServer<T>::UpdateWeights() {
   while (true) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights(); });
-
-    for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
-      Key key = iter->first;
-      WeightPtr weight_ptr = iter->second;
-
-      std::shared_ptr<PServerKernel> optimizer = nullptr;
-      if (weight_key_to_optims_.count(key) > 0) {
-        const std::string &optim_name = weight_key_to_optims_[key];
-        optimizer = optimizers_[optim_name];
-      }
-      MS_EXCEPTION_IF_NULL(optimizer);
-
-      std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-      if (optim_info == nullptr) {
-        continue;
-      }
-      const WeightPtr &weight = weights_[key];
-      optim_info->UpdateWeight(weight);
+    Key key;
+    {
+      std::unique_lock<std::mutex> lock(update_mutex_);
+      update_cv_.wait(lock, [this] { return !update_queue_.empty(); });
+      key = update_queue_.front();
+      update_queue_.pop_front();
+    }
+    UpdateWeight(key);
+  }
+}
+
+template <typename T>
+void ParameterServer<T>::UpdateWeight(const Key &key) {
+  KeyStatePtr state = key_state(key);
+  MS_EXCEPTION_IF_NULL(state);
+  Stripe &key_stripe = stripe(key);
+  {
+    std::unique_lock<std::mutex> lock(key_stripe.mutex);
+    state->update_queued = false;
+    const std::shared_ptr<OptimizerInfo> &optim_info = state->optim_info;
+    if (optim_info != nullptr && state->pending_pushes > 0) {
+      MS_EXCEPTION_IF_NULL(state->optimizer);
+      optim_info->UpdateWeight(state->weight);
       const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
       const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
       const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
 
-      optimizer->Execute(inputs, workspaces, outputs);
+      state->optimizer->Execute(inputs, workspaces, outputs);
       optim_info->Reset();
     }
-    ResetGradAccumCount();
-    accum_grads_cv_.notify_all();
+    state->pending_pushes = 0;
+    PublishSnapshot(state.get());
   }
+  key_stripe.update_done.notify_all();
 }
 
 template <typename T>
 void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  accum_grads_cv_.wait(lock, [this] { return this->ReadyForAccumGrads(); });
-
   const Key &key = keys[0];
-  std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
+  KeyStatePtr state = key_state(key);
+  if (state == nullptr || state->weight == nullptr) {
+    MS_LOG(EXCEPTION) << "Invalid weight key " << key;
+  }
+  Stripe &key_stripe = stripe(key);
+  std::unique_lock<std::mutex> lock(key_stripe.mutex);
+  key_stripe.update_done.wait(lock, [this, &state] { return this->ReadyForAccumGrad(*state); });
 
   // Create or update the optimizer info
+  std::shared_ptr<OptimizerInfo> optim_info = state->optim_info;
   if (optim_info == nullptr) {
-    const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
-    std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[weight_key_to_optims_[key]];
-    if (pserver_kernel == nullptr) {
-      MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+    auto builder = optim_info_builders_.find(state->optim_name);
+    if (state->optimizer == nullptr || builder == optim_info_builders_.end()) {
+      MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << state->optim_name;
     }
-    MS_EXCEPTION_IF_NULL(pserver_kernel);
-    OptimizerInfo *optim =
-      builder->Build(pserver_kernel, weights_[key], keys, values, lengths, optim_inputs_shape_[key], worker_num_);
+    OptimizerInfo *optim = builder->second->Build(state->optimizer, state->weight, keys, values, lengths,
+                                                  state->optim_inputs_shape, worker_num_);
     optim_info.reset(optim);
-    optim_infos_[key] = optim_info;
+    state->optim_info = optim_info;
   } else {
     optim_info->Update(values, lengths);
   }
@@ -432,24 +511,26 @@ void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const
 
   optim_info->Accumulate(values, lengths);
 
-  grads_accum_counter_[key] += 1;
-  if (grads_accum_counter_[key] == worker_num_) {
-    grad_accum_count_++;
-  }
-  if (ReadyForUpdateWeights()) {
-    apply_grads_cv_.notify_one();
+  state->pending_pushes += 1;
+  if (ReadyForUpdateWeight(*state) && !state->update_queued) {
+    state->update_queued = true;
+    ScheduleUpdate(key);
   }
 }
 
 template <typename T>
 WeightPtr ParameterServer<T>::weight(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-
-  if (weights_.count(key) == 0) {
+  KeyStatePtr state = key_state(key);
+  if (state == nullptr || state->weight == nullptr) {
     MS_LOG(ERROR) << "Invalid weight key " << key;
     return nullptr;
   }
-  WeightPtr weight_ptr = weights_[key];
+  if (staleness_ > 0 && state->lookup_op == nullptr) {
+    // the snapshot is never written after it is published, so it is sent as it is
+    return std::atomic_load(&state->snapshot);
+  }
+  std::unique_lock<std::mutex> lock(stripe(key).mutex);
+  WeightPtr weight_ptr = state->weight;
   WeightPtr copy_weight_ptr = std::make_shared<::ps::SArray<T>>(weight_ptr->size(), 0);
   copy_weight_ptr->CopyFrom(weight_ptr->data(), weight_ptr->size());
   return copy_weight_ptr;
@@ -457,17 +538,19 @@ WeightPtr ParameterServer<T>::weight(const Key &key) {
 
 template <typename T>
 void ParameterServer<T>::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.count(key) == 0) {
+  KeyStatePtr state = key_state(key);
+  if (state == nullptr || state->weight == nullptr) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
   }
-  if (embedding_lookup_ops_.count(key) == 0) {
+  if (state->lookup_op == nullptr) {
     MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
     return;
   }
-  WeightPtr table_ptr = weights_[key];
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
+  // the lookup op is reshaped for every request, so it runs under the stripe even in async mode
+  std::unique_lock<std::mutex> lock(stripe(key).mutex);
+  WeightPtr table_ptr = state->weight;
+  std::shared_ptr<PServerKernel> table_lookup_op = state->lookup_op;
 
   // Update shapes of lookup operator
   std::shared_ptr<std::vector<std::shared_ptr<std::vector<size_t>>>> shapes =
@@ -499,7 +582,7 @@ void ParameterServer<T>::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids,
 
   table_lookup_op->Execute(inputs, workspaces, outputs);
   res->vals = *addr;
-  res->lens.push_back(res.vals.size());
+  res->lens.push_back(res->vals.size());
 }
 
 template <typename T>
@@ -526,21 +609,38 @@ size_t ParameterServer<T>::PreComputeCapacity(const Keys &keys, const Lengths &l
 }
 
 template <typename T>
-inline bool ParameterServer<T>::ReadyForUpdateWeights() {
-  return grads_accum_counter_.size() > 0 && grad_accum_count_ == grads_accum_counter_.size();
+inline bool ParameterServer<T>::ReadyForUpdateWeight(const KeyState &state) const {
+  return staleness_ > 0 ? state.pending_pushes > 0 : state.pending_pushes == worker_num_;
 }
 
 template <typename T>
-inline bool ParameterServer<T>::ReadyForAccumGrads() {
-  return grad_accum_count_ < weights_.size();
+inline bool ParameterServer<T>::ReadyForAccumGrad(const KeyState &state) const {
+  return state.pending_pushes < (staleness_ > 0 ? staleness_ : worker_num_);
 }
 
 template <typename T>
-inline void ParameterServer<T>::ResetGradAccumCount() {
-  grad_accum_count_ = 0;
-  for (auto iter = grads_accum_counter_.begin(); iter != grads_accum_counter_.end(); iter++) {
-    grads_accum_counter_[iter->first] = 0;
+void ParameterServer<T>::ScheduleUpdate(const Key &key) {
+  {
+    std::unique_lock<std::mutex> lock(update_mutex_);
+    update_queue_.push_back(key);
   }
+  update_cv_.notify_one();
+}
+
+template <typename T>
+void ParameterServer<T>::PublishSnapshot(KeyState *state) const {
+  MS_EXCEPTION_IF_NULL(state);
+  if (staleness_ == 0 || state->weight == nullptr) {
+    return;
+  }
+  if (state->lookup_op != nullptr) {
+    // copying a whole embedding table after every update costs more than the lookups save
+    std::atomic_store(&state->snapshot, WeightPtr());
+    return;
+  }
+  WeightPtr snapshot = std::make_shared<::ps::SArray<T>>(state->weight->size(), 0);
+  snapshot->CopyFrom(state->weight->data(), state->weight->size());
+  std::atomic_store(&state->snapshot, snapshot);
 }
 
 template <typename T>
@@ -551,7 +651,9 @@ void ParameterServer<T>::Run(const FuncGraphPtr &func_graph) {
     return;
   }
   Init(func_graph);
-  thread_->join();
+  for (auto &thread : update_threads_) {
+    thread.join();
+  }
 }
 }  // namespace ps
 }  // namespace parallel
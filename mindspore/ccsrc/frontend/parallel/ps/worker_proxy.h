@@ -17,12 +17,16 @@
 #ifndef MINDSPORE_MINDSPORE_CCSRC_PARALLEL_PS_WORKER_PROXY_H_
 #define MINDSPORE_MINDSPORE_CCSRC_PARALLEL_PS_WORKER_PROXY_H_
 
+#include <cstdlib>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <utility>
 #include <memory>
 #include <vector>
 #include "ps/ps.h"
+#include "frontend/parallel/ps/common.h"
+#include "frontend/parallel/ps/embedding_cache.h"
 #include "frontend/parallel/ps/util.h"
 
 namespace mindspore {
@@ -37,7 +41,9 @@ class WorkerProxy : public ::ps::KVWorker<T> {
   using Slicer =
     std::function<void(const ::ps::KVPairs<T> &send, const std::vector<::ps::Range> &ranges, SlicedKVs *sliced)>;
   using ::ps::SimpleApp::obj_;
-  explicit WorkerProxy(int app_id, int customer_id, int lookup_customer_id) : Worker(app_id, customer_id) {
+  explicit WorkerProxy(int app_id, int customer_id, int lookup_customer_id)
+      : Worker(app_id, customer_id),
+        embedding_cache_(GetEnvNum(kEnvEmbeddingCacheSize), GetEnvNum(kEnvEmbeddingCacheStaleness)) {
     using _1 = std::placeholders::_1;
     using _2 = std::placeholders::_2;
     using _3 = std::placeholders::_3;
@@ -74,9 +80,18 @@ class WorkerProxy : public ::ps::KVWorker<T> {
   void ProcessLookupResult(const ::ps::Message &msg);
   void Send(::ps::Customer *customer, int timestamp, bool push, bool pull, int cmd, const ::ps::KVPairs<T> &kvs,
             const Slicer &slicer);
+  size_t embedding_row_len(const ::ps::Key &key);
+  static size_t GetEnvNum(const char *name) {
+    const char *value = getenv(name);
+    return value == nullptr ? 0 : std::strtoul(value, nullptr, 10);
+  }
 
   std::unique_ptr<::ps::Customer> lookup_customer_;
+  // the row ranges of every table the servers own, in server rank order
   std::unordered_map<::ps::Key, std::shared_ptr<std::vector<::ps::Range>>> embedding_table_ranges_;
+  // the row length of every table, known from the first lookup answered by the servers
+  std::unordered_map<::ps::Key, size_t> embedding_row_lens_;
+  EmbeddingCache<T> embedding_cache_;
   std::unordered_map<int, std::vector<::ps::KVPairs<T>>> lookup_results_;
   std::mutex mutex_;
   Slicer lookup_slicer_;
@@ -111,13 +126,35 @@ template <typename T>
 void WorkerProxy<T>::EmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<T> &lookup_ids,
                                      const ::ps::SArray<int> &lens, ::ps::SArray<T> *outs, int cmd, const Callback &cb,
                                      int priority) {
+  // the rows found in the cache are written to outs right away, each missing id is asked for once
+  const ::ps::Key &key = keys[0];
+  size_t row_len = embedding_row_len(key);
+  if (row_len > 0) {
+    outs->resize(lookup_ids.size() * row_len, 0);
+  }
+  ::ps::SArray<T> missing_ids;
+  std::unordered_set<uint64_t> requested_ids;
+  for (size_t i = 0; i < lookup_ids.size(); i++) {
+    auto id = static_cast<uint64_t>(lookup_ids[i]);
+    if (row_len > 0 && embedding_cache_.Lookup(key, id, outs->data() + i * row_len, row_len)) {
+      continue;
+    }
+    if (requested_ids.insert(id).second) {
+      missing_ids.push_back(lookup_ids[i]);
+    }
+  }
+  if (missing_ids.empty()) {
+    if (cb) cb();
+    return;
+  }
+
   int ts = AddLookupCB(keys, lookup_ids, outs, cmd, cb);
   ::ps::KVPairs<T> kvs;
   kvs.keys = keys;
-  kvs.vals = lookup_ids;
-  kvs.lens = lens;
+  kvs.vals = missing_ids;
+  kvs.lens.push_back(missing_ids.size());
   kvs.priority = priority;
-  Send(lookup_customer_.get(), ts, true, true, cmd, kvs, broadcast_slicer_);
+  Send(lookup_customer_.get(), ts, true, true, cmd, kvs, lookup_slicer_);
   lookup_customer_->WaitRequest(ts);
 }
 
@@ -145,6 +182,12 @@ void WorkerProxy<T>::PushData(const ::ps::SArray<::ps::Key> &keys, const ::ps::S
   kvs.priority = priority;
   Send(obj_, ts, true, false, cmd, kvs, push_slicer_);
   obj_->WaitRequest(ts);
+  // the pushed gradients make a new version of the tables on the servers
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (embedding_table_ranges_.count(keys[i]) > 0) {
+      embedding_cache_.Update(keys[i]);
+    }
+  }
 }
 
 template <typename T>
@@ -154,68 +197,70 @@ int WorkerProxy<T>::AddLookupCB(const ::ps::SArray<::ps::Key> &keys, const ::ps:
   int ts = lookup_customer_->NewRequest(::ps::kServerGroup);
   const auto &callback = [this, ts, keys, lookup_ids, lookup_result, cb]() mutable {
     mutex_.lock();
-    auto &kvs = lookup_results_[ts];
+    auto kvs = std::move(lookup_results_[ts]);
+    lookup_results_.erase(ts);
     mutex_.unlock();
 
-    size_t total_len = 0;
-    const auto &s = kvs[0];
-    for (size_t i = 0; i < s.lens.size(); i++) {
-      total_len += s.lens[i];
-    }
-    lookup_result->resize(total_len, 0);
-    T *result_addr = lookup_result->data();
-
+    // every server answers the ids of its range with their rows, in the order it got them
+    const ::ps::Key &key = keys[0];
+    std::unordered_map<uint64_t, const T *> rows;
+    size_t row_len = 0;
     for (const auto &s : kvs) {
-      size_t offset = 0;
-      for (size_t i = 0; i < s.vals.size(); i++) {
-        result_addr[offset++] += s.vals[i];
+      if (s.keys.empty()) {
+        continue;
+      }
+      row_len = s.vals.size() / s.keys.size();
+      for (size_t i = 0; i < s.keys.size(); i++) {
+        rows[s.keys[i]] = s.vals.data() + i * row_len;
       }
     }
-
+    if (row_len == 0) {
+      MS_LOG(EXCEPTION) << "No embedding row is returned for table " << key;
+    }
     mutex_.lock();
-    lookup_results_.erase(ts);
+    embedding_row_lens_[key] = row_len;
     mutex_.unlock();
+
+    lookup_result->resize(lookup_ids.size() * row_len, 0);
+    T *result_addr = lookup_result->data();
+    for (size_t i = 0; i < lookup_ids.size(); i++) {
+      auto iter = rows.find(static_cast<uint64_t>(lookup_ids[i]));
+      if (iter != rows.end()) {
+        std::copy(iter->second, iter->second + row_len, result_addr + i * row_len);
+      }
+    }
+    for (const auto &row : rows) {
+      embedding_cache_.Insert(key, row.first, row.second, row_len);
+    }
     if (cb) cb();
   };
+  mutex_.lock();
   lookup_callbacks_[ts] = callback;
+  mutex_.unlock();
   return ts;
 }
 
 template <typename T>
 void WorkerProxy<T>::LookupIdSlicer(const ::ps::KVPairs<T> &send, const std::vector<::ps::Range> &,
                                     std::vector<std::pair<bool, ::ps::KVPairs<T>>> *sliced) {
-  int *data = send.lens.data();
-  size_t size = send.lens.size();
-  std::vector<int> lookup_ids(data, data + size);
-  std::sort(lookup_ids.begin(), lookup_ids.end());
-
+  // each id goes only to the server owning the range it falls in, the ranges are sorted and cover the table
   const Key &key = send.keys[0];
   const std::vector<::ps::Range> &ranges = *(embedding_table_ranges_[key]);
   sliced->resize(ranges.size());
-
-  size_t index = 0;
+  for (size_t i = 0; i < send.vals.size(); i++) {
+    auto lookup_id = static_cast<uint64_t>(send.vals[i]);
+    auto range = std::upper_bound(ranges.begin(), ranges.end(), lookup_id,
+                                  [](uint64_t id, const ::ps::Range &range) { return id < range.begin(); });
+    if (range == ranges.begin() || lookup_id > (range - 1)->end()) {
+      MS_LOG(EXCEPTION) << "Lookup id " << lookup_id << " is out of the ranges of table " << key;
+    }
+    sliced->at(range - ranges.begin() - 1).second.vals.push_back(send.vals[i]);
+  }
   for (size_t i = 0; i < ranges.size(); i++) {
-    const ::ps::Range &range = ranges[i];
-    const auto &begin = range.begin();
-    const auto &end = range.end();
     auto &kvs = sliced->at(i).second;
-
-    auto lookup_id = static_cast<uint64_t>(lookup_ids[index]);
-    while (lookup_id >= begin && lookup_id <= end) {
-      kvs.vals.push_back(lookup_id);
-      if (++index >= lookup_ids.size()) {
-        break;
-      }
-      lookup_id = static_cast<uint64_t>(lookup_ids[index]);
-    }
     kvs.keys.push_back(key);
     kvs.lens.push_back(kvs.vals.size());
-
-    if (kvs.vals.size() == 0) {
-      sliced->at(i).first = false;
-    } else {
-      sliced->at(i).first = true;
-    }
+    sliced->at(i).first = kvs.vals.size() > 0;
   }
 }
 
@@ -269,17 +314,31 @@ void WorkerProxy<T>::ProcessLookupResult(const ::ps::Message &msg) {
     mutex_.unlock();
   }
   if (lookup_customer_->NumResponse(ts) == ::ps::Postoffice::Get()->num_servers() - 1) {
-    const auto &cb = lookup_callbacks_[ts];
-    cb();
+    mutex_.lock();
+    auto cb = std::move(lookup_callbacks_[ts]);
     lookup_callbacks_.erase(ts);
+    mutex_.unlock();
+    cb();
   }
 }
 
+template <typename T>
+size_t WorkerProxy<T>::embedding_row_len(const ::ps::Key &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = embedding_row_lens_.find(key);
+  return iter == embedding_row_lens_.end() ? 0 : iter->second;
+}
+
 template <typename T>
 void WorkerProxy<T>::Send(::ps::Customer *customer, int timestamp, bool push, bool pull, int cmd,
                           const ::ps::KVPairs<T> &kvs, const Slicer &slicer) {
   SlicedKVs sliced;
   slicer(kvs, ::ps::Postoffice::Get()->GetServerKeyRanges(), &sliced);
+  // the servers skipped by the slicer will not answer, count them as answered so that the request completes
+  int skipped = std::count_if(sliced.begin(), sliced.end(), [](const auto &s) { return !s.first; });
+  if (skipped > 0) {
+    customer->AddResponse(timestamp, skipped);
+  }
 
   for (size_t i = 0; i < sliced.size(); i++) {
     const auto &s = sliced[i];
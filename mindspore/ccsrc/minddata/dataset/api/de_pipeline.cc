@@ -347,6 +347,10 @@ Status DEPipeline::ParseShuffleOp(const py::dict &args, std::shared_ptr<DatasetO
     if (!value.is_none()) {
       if (key == "reshuffle_each_epoch") {
         (void)builder->SetReshuffleEachEpoch(ToBool(args["reshuffle_each_epoch"]));
+      } else if (key == "memory_limit") {
+        (void)builder->SetMemoryLimit(ToInt(value));
+      } else if (key == "spill_dir") {
+        (void)builder->SetSpillDir(ToString(value));
       }
     }
   }
@@ -869,6 +873,8 @@ Status DEPipeline::ParseTFReaderOp(const py::dict &args, std::shared_ptr<Dataset
         (void)builder->SetDeviceId(ToInt(value));
       } else if (key == "shard_equal_rows") {
         (void)builder->SetShardEqualRows(ToBool(value));
+      } else if (key == "check_crc") {
+        (void)builder->SetCheckCrc(ToBool(value));
       } else if (key == "cache") {
         cache_client = value.cast<std::shared_ptr<CacheClient>>();
       } else if (key == "sampler") {
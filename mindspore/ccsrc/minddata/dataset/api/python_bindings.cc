@@ -282,12 +282,18 @@ void bindTensor(py::module *m) {
     .def("set_op_connector_size", &ConfigManager::set_op_connector_size)
     .def("set_seed", &ConfigManager::set_seed)
     .def("set_monitor_sampling_interval", &ConfigManager::set_monitor_sampling_interval)
+    .def("set_enable_autotune", &ConfigManager::set_enable_autotune)
+    .def("set_autotune_cpu_budget", &ConfigManager::set_autotune_cpu_budget)
+    .def("set_mindrecord_io_mode", &ConfigManager::set_mindrecord_io_mode)
     .def("get_rows_per_buffer", &ConfigManager::rows_per_buffer)
     .def("get_num_parallel_workers", &ConfigManager::num_parallel_workers)
     .def("get_worker_connector_size", &ConfigManager::worker_connector_size)
     .def("get_op_connector_size", &ConfigManager::op_connector_size)
     .def("get_seed", &ConfigManager::seed)
     .def("get_monitor_sampling_interval", &ConfigManager::monitor_sampling_interval)
+    .def("get_enable_autotune", &ConfigManager::enable_autotune)
+    .def("get_autotune_cpu_budget", &ConfigManager::autotune_cpu_budget)
+    .def("get_mindrecord_io_mode", &ConfigManager::mindrecord_io_mode)
     .def("load", [](ConfigManager &c, std::string s) { THROW_IF_ERROR(c.LoadFile(s)); });
 
   (void)py::class_<Tensor, std::shared_ptr<Tensor>>(*m, "Tensor", py::buffer_protocol())
@@ -716,7 +722,7 @@ void bindSamplerOps(py::module *m) {
     .def(py::init<int64_t, int64_t, bool>());
 
   (void)py::class_<RandomSampler, Sampler, std::shared_ptr<RandomSampler>>(*m, "RandomSampler")
-    .def(py::init<int64_t, bool, bool>());
+    .def(py::init<int64_t, bool, bool, int64_t>());
 
   (void)py::class_<SequentialSampler, Sampler, std::shared_ptr<SequentialSampler>>(*m, "SequentialSampler")
     .def(py::init<int64_t, int64_t>());
@@ -860,11 +866,15 @@ void bindGraphData(py::module *m) {
            THROW_IF_ERROR(g.GraphInfo(&out));
            return out;
          })
-    .def("random_walk", [](gnn::Graph &g, std::vector<gnn::NodeIdType> node_list, std::vector<gnn::NodeType> meta_path,
-                           float step_home_param, float step_away_param, gnn::NodeIdType default_node) {
-      std::shared_ptr<Tensor> out;
-      THROW_IF_ERROR(g.RandomWalk(node_list, meta_path, step_home_param, step_away_param, default_node, &out));
-      return out;
+    .def("random_walk",
+         [](gnn::Graph &g, std::vector<gnn::NodeIdType> node_list, std::vector<gnn::NodeType> meta_path,
+            float step_home_param, float step_away_param, gnn::NodeIdType default_node) {
+           std::shared_ptr<Tensor> out;
+           THROW_IF_ERROR(g.RandomWalk(node_list, meta_path, step_home_param, step_away_param, default_node, &out));
+           return out;
+         })
+    .def("save_snapshot", [](gnn::Graph &g, const std::string &snapshot_file) {
+      THROW_IF_ERROR(g.SaveSnapshot(snapshot_file));
     });
 }
 
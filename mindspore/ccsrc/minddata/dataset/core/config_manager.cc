@@ -42,6 +42,9 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_op_connector_size(j.value("opConnectorSize", op_connector_size_));
   set_seed(j.value("seed", seed_));
   set_monitor_sampling_interval(j.value("monitorSamplingInterval", monitor_sampling_interval_));
+  set_enable_autotune(j.value("enableAutotune", enable_autotune_));
+  set_autotune_cpu_budget(j.value("autotuneCpuBudget", autotune_cpu_budget_));
+  set_mindrecord_io_mode(j.value("mindrecordIOMode", mindrecord_io_mode_));
   return Status::OK();
 }
 
@@ -88,5 +91,11 @@ uint32_t ConfigManager::seed() const { return seed_; }
 void ConfigManager::set_seed(uint32_t seed) { seed_ = seed; }
 
 void ConfigManager::set_monitor_sampling_interval(uint32_t interval) { monitor_sampling_interval_ = interval; }
+
+void ConfigManager::set_enable_autotune(bool enable) { enable_autotune_ = enable; }
+
+void ConfigManager::set_autotune_cpu_budget(uint32_t cpu_budget) { autotune_cpu_budget_ = cpu_budget; }
+
+void ConfigManager::set_mindrecord_io_mode(const std::string &io_mode) { mindrecord_io_mode_ = io_mode; }
 }  // namespace dataset
 }  // namespace mindspore
@@ -119,6 +119,30 @@ class ConfigManager {
   // @return The iterval of monitor sampling
   int32_t monitor_sampling_interval() const { return monitor_sampling_interval_; }
 
+  // setter function
+  // @param enable - Whether the tree tunes its workers and connectors during the first epoch
+  void set_enable_autotune(bool enable);
+
+  // getter function
+  // @return Whether the tree tunes its workers and connectors during the first epoch
+  bool enable_autotune() const { return enable_autotune_; }
+
+  // setter function
+  // @param cpu_budget - The number of worker threads the tuning may use in the tree, 0 for all the cores
+  void set_autotune_cpu_budget(uint32_t cpu_budget);
+
+  // getter function
+  // @return The number of worker threads the tuning may use in the tree, 0 for all the cores
+  uint32_t autotune_cpu_budget() const { return autotune_cpu_budget_; }
+
+  // setter function
+  // @param io_mode - How MindRecord reads its shard files: "stream", "pread", "mmap" or "io_uring"
+  void set_mindrecord_io_mode(const std::string &io_mode);
+
+  // getter function
+  // @return How MindRecord reads its shard files
+  std::string mindrecord_io_mode() const { return mindrecord_io_mode_; }
+
  private:
   int32_t rows_per_buffer_{kCfgRowsPerBuffer};
   int32_t num_parallel_workers_{kCfgParallelWorkers};
@@ -126,6 +150,9 @@ class ConfigManager {
   int32_t op_connector_size_{kCfgOpConnectorSize};
   uint32_t seed_{kCfgDefaultSeed};
   uint32_t monitor_sampling_interval_{kCfgMonitorSamplingInterval};
+  bool enable_autotune_{kCfgEnableAutotune};
+  uint32_t autotune_cpu_budget_{kCfgAutotuneCpuBudget};
+  std::string mindrecord_io_mode_{kCfgMindrecordIOMode};
 
   // Private helper function that taks a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
@@ -54,6 +54,9 @@ constexpr uint32_t kCfgWorkerConnectorSize = 16;
 constexpr uint32_t kCfgOpConnectorSize = 16;
 constexpr uint32_t kCfgDefaultSeed = std::mt19937::default_seed;
 constexpr uint32_t kCfgMonitorSamplingInterval = 10;
+constexpr bool kCfgEnableAutotune = false;
+constexpr uint32_t kCfgAutotuneCpuBudget = 0;  // 0 for all the cores of the machine
+constexpr char kCfgMindrecordIOMode[] = "stream";
 
 // Invalid OpenCV type should not be from 0 to 7 (opencv4/opencv2/core/hal/interface.h)
 constexpr uint8_t kCVInvalidType = 255;
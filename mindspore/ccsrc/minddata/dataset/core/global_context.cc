@@ -23,7 +23,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/util/allocator.h"
 #include "minddata/dataset/util/circular_pool.h"
-#include "minddata/dataset/util/system_pool.h"
+#include "minddata/dataset/util/size_class_pool.h"
 
 namespace mindspore {
 namespace dataset {
@@ -51,7 +51,8 @@ GlobalContext *GlobalContext::Instance() {
 
 Status GlobalContext::Init() {
   config_manager_ = std::make_shared<ConfigManager>();
-  mem_pool_ = std::make_shared<SystemPool>();
+  // The tensors of every row are about the same sizes, so freed buffers are kept for the next rows.
+  mem_pool_ = std::make_shared<SizeClassPool>();
   // For testing we can use Dummy pool instead
 
   // Create some tensor allocators for the different types and hook them into the pool.
@@ -102,7 +102,8 @@ Tensor::Tensor(Tensor &&other) noexcept
     : shape_(other.shape()),
       type_(other.type()),
       data_(other.GetMutableBuffer()),
-      data_allocator_(std::move(other.data_allocator_)) {
+      data_allocator_(std::move(other.data_allocator_)),
+      data_owner_(std::move(other.data_owner_)) {
   other.Invalidate();
 }
 
@@ -113,6 +114,7 @@ Tensor &Tensor::operator=(Tensor &&other) noexcept {
     data_ = other.GetMutableBuffer();
     data_end_ = other.data_end_;
     data_allocator_ = std::move(other.data_allocator_);
+    data_owner_ = std::move(other.data_owner_);
     other.Invalidate();
   }
   return *this;
@@ -227,6 +229,57 @@ Status Tensor::CreateTensor(std::shared_ptr<Tensor> *ptr, TensorImpl tensor_impl
   return Status::OK();  // returns base-class shared_ptr
 }
 
+Status Tensor::CreateRowView(std::shared_ptr<Tensor> *ptr, const std::shared_ptr<Tensor> &owner, dsize_t row) {
+  RETURN_UNEXPECTED_IF_NULL(owner);
+  CHECK_FAIL_RETURN_UNEXPECTED(owner->Rank() > 0 && row >= 0 && row < owner->shape()[0], "Invalid row of Tensor.");
+  uchar *start = nullptr;
+  TensorShape remaining = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(owner->StartAddrOfIndex({row}, &start, &remaining));
+  RETURN_IF_NOT_OK(CreateTensor(ptr, TensorImpl::kFlexible, remaining, owner->type()));
+  (*ptr)->data_ = start;
+  (*ptr)->data_end_ = start + (*ptr)->SizeInBytes();
+  (*ptr)->data_owner_ = owner;
+  return Status::OK();
+}
+
+namespace {
+// The placements of the thread, in the order they were made
+thread_local std::vector<Tensor::Placement *> placements;
+}  // namespace
+
+Tensor::Placement::Placement(std::shared_ptr<Tensor> owner, dsize_t row) : owner_(std::move(owner)) {
+  if (owner_ == nullptr || !owner_->type().IsNumeric() || owner_->Rank() == 0 || row < 0 ||
+      row >= owner_->shape()[0]) {
+    return;
+  }
+  unsigned char *start = owner_->GetMutableBuffer();
+  length_ = owner_->SizeInBytes() / owner_->shape()[0];
+  if (start == nullptr || length_ == 0) {
+    return;
+  }
+  data_ = start + row * length_;
+  placements.push_back(this);
+}
+
+Tensor::Placement::~Placement() {
+  auto itr = std::find(placements.begin(), placements.end(), this);
+  if (itr != placements.end()) {
+    (void)placements.erase(itr);
+  }
+}
+
+bool Tensor::Placement::Take(dsize_t length, unsigned char **data, std::shared_ptr<Tensor> *owner) {
+  for (Placement *placement : placements) {
+    if (!placement->taken_ && placement->length_ == length) {
+      placement->taken_ = true;
+      *data = placement->data_;
+      *owner = placement->owner_;
+      return true;
+    }
+  }
+  return false;
+}
+
 #ifdef ENABLE_PYTHON
 Status Tensor::CreateTensorFromNumpyString(std::shared_ptr<Tensor> *ptr, py::array arr) {
   std::vector<dsize_t> shape;
@@ -395,7 +448,11 @@ Status Tensor::CopyStridedArray(unsigned char *dst, unsigned char *src, std::vec
 // Description: Destructor
 Tensor::~Tensor() {
   if (data_ != nullptr) {
-    if (data_allocator_ != nullptr) {
+    if (data_owner_ != nullptr) {
+      // The memory belongs to another tensor
+      data_ = nullptr;
+      data_end_ = nullptr;
+    } else if (data_allocator_ != nullptr) {
       data_allocator_->deallocate(data_);
       data_ = nullptr;
       data_end_ = nullptr;
@@ -502,7 +559,9 @@ void Tensor::Print(std::ostream &out) const {
 }
 Status Tensor::AllocateBuffer(const dsize_t &length) {
   if (data_ == nullptr) {
-    if (data_allocator_ != nullptr) {
+    if (Placement::Take(length, &data_, &data_owner_)) {
+      data_end_ = data_ + length;
+    } else if (data_allocator_ != nullptr) {
       data_ = data_allocator_->allocate(length);
       RETURN_UNEXPECTED_IF_NULL(data_);
       data_end_ = data_ + length;
@@ -562,6 +621,7 @@ void Tensor::Invalidate() {
   data_ = nullptr;
   data_end_ = nullptr;
   data_allocator_ = nullptr;
+  data_owner_ = nullptr;
 }
 
 template <typename T>
@@ -80,6 +80,43 @@ class Tensor {
 
   Status AllocateBuffer(const dsize_t &length);
 
+  // A row of a tensor lent to the next buffer of the same length that this thread allocates, so that an op which
+  // writes its output into a new tensor writes it straight into the row. The loan ends with the Placement, which
+  // must not outlive the thread's current call into the op.
+  class Placement {
+   public:
+    // @param owner - the tensor holding the row, numeric and with a known shape
+    // @param row - index of the row in the first dimension of owner
+    Placement(std::shared_ptr<Tensor> owner, dsize_t row);
+
+    ~Placement();
+
+    Placement(const Placement &) = delete;
+
+    Placement &operator=(const Placement &) = delete;
+
+    // @return true if a tensor got its buffer from the row
+    bool taken() const { return taken_; }
+
+    // @return the start of the row
+    const unsigned char *data() const { return data_; }
+
+   private:
+    friend class Tensor;
+
+    // Hands the row of the first free placement of the thread with the given length to a new buffer.
+    // @param length - size of the buffer in bytes
+    // @param data [out] - start of the row
+    // @param owner [out] - the tensor holding the row
+    // @return true if a placement was found
+    static bool Take(dsize_t length, unsigned char **data, std::shared_ptr<Tensor> *owner);
+
+    std::shared_ptr<Tensor> owner_;
+    unsigned char *data_ = nullptr;
+    dsize_t length_ = 0;
+    bool taken_ = false;
+  };
+
   // type of offest values to store strings information
   using offset_t = uint32_t;
   // const of the size of the offset variable
@@ -121,6 +158,14 @@ class Tensor {
   static Status CreateTensor(std::shared_ptr<Tensor> *, TensorImpl tensor_impl, const TensorShape &shape, DataType type,
                              const unsigned char *data = nullptr);
 
+  // Create a tensor which shares the memory of a row of another tensor rather than owning its own. The other tensor
+  // is kept alive for as long as the view is.
+  // @param ptr [out] - the view
+  // @param owner - the tensor holding the row, numeric and with a known shape
+  // @param row - index of the row in the first dimension of owner
+  // @return Status Code
+  static Status CreateRowView(std::shared_ptr<Tensor> *ptr, const std::shared_ptr<Tensor> &owner, dsize_t row);
+
   // Create a copy of the input tensor
   // @param out [out] output tensor to be generated
   // @param in [in] orginal tensor to be copied
@@ -658,6 +703,8 @@ class Tensor {
   CharAllocPtr data_allocator_;
   // pointer to the end of the physical data
   unsigned char *data_end_ = nullptr;
+  // the tensor whose memory data_ points into, if data_ is not owned by this tensor
+  std::shared_ptr<Tensor> data_owner_;
 };
 template <>
 inline Tensor::TensorIterator<std::string_view> Tensor::end<std::string_view>() {
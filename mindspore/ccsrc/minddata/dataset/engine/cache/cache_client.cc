@@ -16,6 +16,7 @@
 
 #include <iomanip>
 #include "minddata/dataset/engine/cache/cache_client.h"
+#include "common/utils.h"
 #include "minddata/dataset/engine/cache/cache_request.h"
 #include "minddata/dataset/util/bit.h"
 
@@ -24,7 +25,19 @@ namespace dataset {
 
 // Constructor
 CacheClient::CacheClient(uint32_t session_id, uint64_t cache_mem_sz, bool spill)
-    : server_connection_id_(0), session_id_(session_id), cache_crc_(0), cache_mem_sz_(cache_mem_sz), spill_(spill) {}
+    : server_connection_id_(0), session_id_(session_id), cache_crc_(0), cache_mem_sz_(cache_mem_sz), spill_(spill) {
+  std::string socket_path = common::GetEnv(kCacheServerSocketEnv);
+  if (!socket_path.empty()) {
+    ipc_ = std::make_shared<CacheIpcClient>(socket_path);
+  }
+}
+
+Status CacheClient::PushRequest(BaseRequest *rq) const {
+  if (ipc_ != nullptr) {
+    return ipc_->Submit(rq);
+  }
+  return CacheServer::GetInstance().PushRequest(rq);
+}
 
 // print method for display cache details
 void CacheClient::Print(std::ostream &out) const {
@@ -36,7 +49,7 @@ void CacheClient::Print(std::ostream &out) const {
 Status CacheClient::WriteRow(const TensorRow &row, row_id_type *row_id_from_server) const {
   CacheRowRequest rq(server_connection_id_, cookie());
   RETURN_IF_NOT_OK(rq.SerializeCacheRowRequest(row));
-  RETURN_IF_NOT_OK(CacheServer::GetInstance().PushRequest(&rq));
+  RETURN_IF_NOT_OK(PushRequest(&rq));
   RETURN_IF_NOT_OK(rq.Wait());
   if (row_id_from_server != nullptr) {
     *row_id_from_server = rq.GetRowIdAfterCache();
@@ -54,18 +67,26 @@ Status CacheClient::WriteBuffer(std::unique_ptr<DataBuffer> &&in) const {
     // and then do a final wait.
     MemGuard<CacheRowRequest> rq_arr;
     RETURN_IF_NOT_OK(rq_arr.allocate(num_rows, server_connection_id_, cookie()));
-    CacheServer &cs = CacheServer::GetInstance();
+    std::vector<CacheRowRequest *> ipc_rq;
     for (auto i = 0; i < num_rows; ++i) {
       TensorRow row;
       auto rq = rq_arr[i];
       RETURN_IF_NOT_OK(db_ptr->PopRow(&row));
       RETURN_IF_NOT_OK(rq->SerializeCacheRowRequest(row));
-      RETURN_IF_NOT_OK(cs.PushRequest(rq));
+      if (ipc_ != nullptr) {
+        ipc_rq.push_back(rq);
+      } else {
+        RETURN_IF_NOT_OK(CacheServer::GetInstance().PushRequest(rq));
+      }
       // We can't let row go out of scope. Otherwise it will free all the tensor memory.
       // So park it in the vector. When this function go out of scope, its memory
       // will be freed.
       all_rows.push_back(std::move(row));
     }
+    // A standalone server gets all the rows streamed through one connection.
+    if (ipc_ != nullptr) {
+      RETURN_IF_NOT_OK(ipc_->SubmitRows(ipc_rq));
+    }
     // Now we wait for the requests to be done.
     for (auto i = 0; i < num_rows; ++i) {
       auto rq = rq_arr[i];
@@ -78,7 +99,11 @@ Status CacheClient::WriteBuffer(std::unique_ptr<DataBuffer> &&in) const {
 Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable *out) const {
   RETURN_UNEXPECTED_IF_NULL(out);
   BatchFetchRequest rq(server_connection_id_, row_id);
-  RETURN_IF_NOT_OK(CacheServer::GetInstance().PushRequest(&rq));
+  if (ipc_ != nullptr) {
+    // The rows are restored straight from the shared memory the server wrote them to.
+    return ipc_->FetchRows(&rq, out);
+  }
+  RETURN_IF_NOT_OK(PushRequest(&rq));
   RETURN_IF_NOT_OK(rq.Wait());
   RETURN_IF_NOT_OK(rq.RestoreRows(out));
   return Status::OK();
@@ -132,7 +157,7 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
       createFlag |= BaseRequest::CreateCacheFlag::kGenerateRowId;
     }
     CreationCacheRequest rq(connection_identification, cache_mem_sz_, createFlag);
-    RETURN_IF_NOT_OK(CacheServer::GetInstance().PushRequest(&rq));
+    RETURN_IF_NOT_OK(PushRequest(&rq));
     Status rc = rq.Wait();
     if (rc.IsOk() || rc.get_code() == StatusCode::kDuplicateKey) {
       server_connection_id_ = rq.GetServerConnectionId();
@@ -153,14 +178,14 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
 Status CacheClient::PurgeCache() {
   UniqueLock lck(&mux_);
   PurgeCacheRequest rq(server_connection_id_);
-  RETURN_IF_NOT_OK(CacheServer::GetInstance().PushRequest(&rq));
+  RETURN_IF_NOT_OK(PushRequest(&rq));
   return rq.Wait();
 }
 
 Status CacheClient::DestroyCache() {
   UniqueLock lck(&mux_);
   DestroyCacheRequest rq(server_connection_id_);
-  RETURN_IF_NOT_OK(CacheServer::GetInstance().PushRequest(&rq));
+  RETURN_IF_NOT_OK(PushRequest(&rq));
   return rq.Wait();
 }
 
@@ -168,7 +193,7 @@ Status CacheClient::GetStat(ServiceStat *stat) {
   SharedLock lck(&mux_);
   RETURN_UNEXPECTED_IF_NULL(stat);
   GetStatRequest rq(server_connection_id_);
-  RETURN_IF_NOT_OK(CacheServer::GetInstance().PushRequest(&rq));
+  RETURN_IF_NOT_OK(PushRequest(&rq));
   RETURN_IF_NOT_OK(rq.Wait());
   stat->num_disk_cached = rq.GetNumDiskCached();
   stat->num_mem_cached = rq.GetNumMemCached();
@@ -182,7 +207,7 @@ Status CacheClient::CacheSchema(const std::unordered_map<std::string, int32_t> &
   SharedLock lck(&mux_);
   CacheSchemaRequest rq(server_connection_id_);
   RETURN_IF_NOT_OK(rq.SerializeCacheSchemaRequest(map));
-  RETURN_IF_NOT_OK(CacheServer::GetInstance().PushRequest(&rq));
+  RETURN_IF_NOT_OK(PushRequest(&rq));
   RETURN_IF_NOT_OK(rq.Wait());
   return Status::OK();
 }
@@ -191,7 +216,7 @@ Status CacheClient::FetchSchema(std::unordered_map<std::string, int32_t> *map) {
   SharedLock lck(&mux_);
   RETURN_UNEXPECTED_IF_NULL(map);
   FetchSchemaRequest rq(server_connection_id_);
-  RETURN_IF_NOT_OK(CacheServer::GetInstance().PushRequest(&rq));
+  RETURN_IF_NOT_OK(PushRequest(&rq));
   RETURN_IF_NOT_OK(rq.Wait());
   *map = rq.GetColumnMap();
   return Status::OK();
@@ -200,7 +225,7 @@ Status CacheClient::FetchSchema(std::unordered_map<std::string, int32_t> *map) {
 Status CacheClient::BuildPhaseDone() const {
   SharedLock lck(&mux_);
   BuildPhaseDoneRequest rq(server_connection_id_, cookie());
-  RETURN_IF_NOT_OK(CacheServer::GetInstance().PushRequest(&rq));
+  RETURN_IF_NOT_OK(PushRequest(&rq));
   RETURN_IF_NOT_OK(rq.Wait());
   return Status::OK();
 }
@@ -25,6 +25,7 @@
 
 #include "./de_tensor_generated.h"
 #include "minddata/dataset/engine/data_buffer.h"
+#include "minddata/dataset/engine/cache/cache_ipc.h"
 #include "minddata/dataset/engine/cache/cache_server.h"
 #include "minddata/dataset/util/lock.h"
 
@@ -35,7 +36,8 @@ namespace dataset {
 /// rows, etc.
 class CacheClient {
  public:
-  /// \brief Constructor
+  /// \brief Constructor. If MS_CACHE_SERVER_SOCKET is set, the client uses the standalone cache server listening on
+  /// that unix socket, otherwise the cache server of this process.
   /// \param session_id A user assigned session id for the current pipeline
   /// \param cache_mem_sz Size of the memory set aside for the row caching. 0 for unlimited
   /// \param spill Spill to disk if out of memory
@@ -134,6 +136,13 @@ class CacheClient {
   connection_id_type server_connection_id_;
   // Some magic cookie returned from the cache server.
   std::string cookie_;
+  // Transport to a cache server of another process. Null if the cache server of this process is used.
+  std::shared_ptr<CacheIpcClient> ipc_;
+
+  /// \brief Send a request to the cache server this client is using
+  /// \param rq The request. It is done once its Wait returns.
+  /// \return Status object
+  Status PushRequest(BaseRequest *rq) const;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,613 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "minddata/dataset/engine/cache/cache_ipc.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "minddata/dataset/engine/cache/cache_request.h"
+#include "minddata/dataset/util/services.h"
+#include "minddata/dataset/util/slice.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Bound on the rows sent but not yet answered on one connection. The replies queue up in the socket while the client
+// is sending, and the socket buffer must be able to hold them all.
+constexpr size_t kMaxRowsInFlight = 64;
+// Bound on the extra bytes of a control message, which only carry cookies, row ids and schemas.
+constexpr int64_t kMaxExtraLen = 1L << 30;
+
+std::string ErrnoString() { return std::string(strerror(errno)); }
+
+Status ReplyStatus(const CacheIpcMsg &reply, const std::string &extra) {
+  auto code = static_cast<StatusCode>(reply.rc_);
+  if (code == StatusCode::kOK) {
+    return Status::OK();
+  }
+  return Status(code, extra);
+}
+
+Status CopyToMemGuard(const std::string &src, MemGuard<uint8_t> *dest) {
+  RETURN_IF_NOT_OK(dest->allocate(src.size()));
+  if (!src.empty()) {
+    WritableSlice dest_slice(dest->GetMutablePointer(), src.size());
+    RETURN_IF_NOT_OK(WritableSlice::Copy(&dest_slice, ReadableSlice(src.data(), src.size())));
+  }
+  return Status::OK();
+}
+}  // namespace
+
+#if !defined(_WIN32) && !defined(_WIN64)
+Status SharedMemory::Create(int64_t sz) {
+  // The name only lives until the file descriptor is obtained
+  std::string name = "/mindspore_cache_" + std::to_string(getpid()) + "_" + Services::GetUniqueID();
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    RETURN_STATUS_UNEXPECTED("Unable to create shared memory: " + ErrnoString());
+  }
+  (void)shm_unlink(name.c_str());
+  if (ftruncate(fd, sz) != 0) {
+    std::string errMsg = "Unable to size shared memory to " + std::to_string(sz) + " bytes: " + ErrnoString();
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
+  return Attach(fd, sz);
+}
+
+Status SharedMemory::Attach(int fd, int64_t sz) {
+  Detach();
+  // The size comes from the other process. Mapping beyond the end of the file would bring a SIGBUS at first access.
+  struct stat st {};
+  if (fstat(fd, &st) != 0) {
+    std::string errMsg = "Unable to stat shared memory: " + ErrnoString();
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
+  if (sz <= 0 || sz > static_cast<int64_t>(st.st_size)) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED("Invalid shared memory size " + std::to_string(sz) + ". The shared memory has " +
+                             std::to_string(st.st_size) + " bytes");
+  }
+  void *p = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (p == MAP_FAILED) {
+    std::string errMsg = "Unable to map shared memory: " + ErrnoString();
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
+  fd_ = fd;
+  ptr_ = static_cast<uint8_t *>(p);
+  sz_ = sz;
+  return Status::OK();
+}
+
+void SharedMemory::Detach() noexcept {
+  if (ptr_ != nullptr) {
+    (void)munmap(ptr_, sz_);
+    ptr_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    (void)close(fd_);
+    fd_ = -1;
+  }
+  sz_ = 0;
+}
+
+Status CacheIpcSend(int sock, const CacheIpcMsg &msg, const void *extra, int pass_fd) {
+  struct iovec iov[2];
+  iov[0].iov_base = const_cast<CacheIpcMsg *>(&msg);
+  iov[0].iov_len = sizeof(msg);
+  iov[1].iov_base = const_cast<void *>(extra);
+  iov[1].iov_len = msg.extra_len_;
+  struct msghdr hdr {};
+  hdr.msg_iov = iov;
+  hdr.msg_iovlen = (msg.extra_len_ > 0) ? 2 : 1;
+  char control[CMSG_SPACE(sizeof(int))] = {0};
+  if (pass_fd >= 0) {
+    hdr.msg_control = control;
+    hdr.msg_controllen = sizeof(control);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    *reinterpret_cast<int *>(CMSG_DATA(cmsg)) = pass_fd;
+  }
+  while (hdr.msg_iovlen > 0) {
+    auto n = sendmsg(sock, &hdr, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      RETURN_STATUS_UNEXPECTED("Unable to send to the cache server socket: " + ErrnoString());
+    }
+    // The file descriptor goes along with the first bytes sent.
+    hdr.msg_control = nullptr;
+    hdr.msg_controllen = 0;
+    while (hdr.msg_iovlen > 0 && static_cast<size_t>(n) >= hdr.msg_iov->iov_len) {
+      n -= hdr.msg_iov->iov_len;
+      ++hdr.msg_iov;
+      --hdr.msg_iovlen;
+    }
+    if (hdr.msg_iovlen > 0) {
+      hdr.msg_iov->iov_base = static_cast<char *>(hdr.msg_iov->iov_base) + n;
+      hdr.msg_iov->iov_len -= n;
+    }
+  }
+  return Status::OK();
+}
+
+Status CacheIpcReceive(int sock, CacheIpcMsg *msg, std::string *extra, int *fd) {
+  RETURN_UNEXPECTED_IF_NULL(msg);
+  RETURN_UNEXPECTED_IF_NULL(extra);
+  if (fd != nullptr) {
+    *fd = -1;
+  }
+  char control[CMSG_SPACE(sizeof(int))] = {0};
+  size_t received = 0;
+  while (received < sizeof(CacheIpcMsg)) {
+    struct iovec iov;
+    iov.iov_base = reinterpret_cast<char *>(msg) + received;
+    iov.iov_len = sizeof(CacheIpcMsg) - received;
+    struct msghdr hdr {};
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control;
+    hdr.msg_controllen = sizeof(control);
+    auto n = recvmsg(sock, &hdr, 0);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      RETURN_STATUS_UNEXPECTED("Unable to receive from the cache server socket: " + ErrnoString());
+    }
+    if (n == 0) {
+      RETURN_STATUS_UNEXPECTED("Connection closed by peer");
+    }
+    for (auto cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+        int passed_fd = *reinterpret_cast<int *>(CMSG_DATA(cmsg));
+        if (fd != nullptr) {
+          *fd = passed_fd;
+        } else {
+          (void)close(passed_fd);
+        }
+      }
+    }
+    received += n;
+  }
+  if (msg->extra_len_ < 0 || msg->extra_len_ > kMaxExtraLen) {
+    RETURN_STATUS_UNEXPECTED("Bad control message length " + std::to_string(msg->extra_len_));
+  }
+  extra->resize(msg->extra_len_);
+  received = 0;
+  while (received < extra->size()) {
+    auto n = recv(sock, &(*extra)[received], extra->size() - received, 0);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      RETURN_STATUS_UNEXPECTED("Unable to receive from the cache server socket: " + ErrnoString());
+    }
+    if (n == 0) {
+      RETURN_STATUS_UNEXPECTED("Connection closed by peer");
+    }
+    received += n;
+  }
+  return Status::OK();
+}
+
+namespace {
+Status MakeSocketAddress(const std::string &path, struct sockaddr_un *addr) {
+  if (path.size() >= sizeof(addr->sun_path)) {
+    RETURN_STATUS_UNEXPECTED("Socket path too long: " + path);
+  }
+  *addr = {};
+  addr->sun_family = AF_UNIX;
+  (void)path.copy(addr->sun_path, path.size());
+  return Status::OK();
+}
+}  // namespace
+
+Status CacheIpcListen(const std::string &path, int *sock) {
+  RETURN_UNEXPECTED_IF_NULL(sock);
+  struct sockaddr_un addr;
+  RETURN_IF_NOT_OK(MakeSocketAddress(path, &addr));
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    RETURN_STATUS_UNEXPECTED("Unable to create socket: " + ErrnoString());
+  }
+  // Remove the socket a previous server left behind
+  (void)unlink(path.c_str());
+  if (bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0) {
+    std::string errMsg = "Unable to listen on " + path + ": " + ErrnoString();
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
+  *sock = fd;
+  return Status::OK();
+}
+
+Status CacheIpcConnect(const std::string &path, int *sock) {
+  RETURN_UNEXPECTED_IF_NULL(sock);
+  struct sockaddr_un addr;
+  RETURN_IF_NOT_OK(MakeSocketAddress(path, &addr));
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    RETURN_STATUS_UNEXPECTED("Unable to create socket: " + ErrnoString());
+  }
+  if (connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+    std::string errMsg = "Unable to connect to cache server at " + path + ": " + ErrnoString();
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
+  *sock = fd;
+  return Status::OK();
+}
+
+CacheIpcClient::Connection::~Connection() {
+  if (sock_ >= 0) {
+    (void)close(sock_);
+  }
+}
+#else
+Status SharedMemory::Create(int64_t sz) { RETURN_STATUS_UNEXPECTED("Shared memory is not supported"); }
+Status SharedMemory::Attach(int fd, int64_t sz) { RETURN_STATUS_UNEXPECTED("Shared memory is not supported"); }
+void SharedMemory::Detach() noexcept {}
+Status CacheIpcSend(int sock, const CacheIpcMsg &msg, const void *extra, int pass_fd) {
+  RETURN_STATUS_UNEXPECTED("Unix socket is not supported");
+}
+Status CacheIpcReceive(int sock, CacheIpcMsg *msg, std::string *extra, int *fd) {
+  RETURN_STATUS_UNEXPECTED("Unix socket is not supported");
+}
+Status CacheIpcListen(const std::string &path, int *sock) { RETURN_STATUS_UNEXPECTED("Unix socket is not supported"); }
+Status CacheIpcConnect(const std::string &path, int *sock) { RETURN_STATUS_UNEXPECTED("Unix socket is not supported"); }
+CacheIpcClient::Connection::~Connection() {}
+#endif
+
+Status SharedMemoryRing::Create(int64_t sz) {
+  RETURN_IF_NOT_OK(mem_.Create(sz));
+  head_ = 0;
+  tail_ = 0;
+  used_ = 0;
+  allocations_.clear();
+  return Status::OK();
+}
+
+Status ParseIpcRow(const uint8_t *row, int64_t len, std::vector<uint8_t> *header, std::vector<const void *> *buffers) {
+  RETURN_UNEXPECTED_IF_NULL(row);
+  CHECK_FAIL_RETURN_UNEXPECTED(len > 0, "Row is empty");
+  // The ring offsets are not aligned, the copy is.
+  const bool check_alignment = false;
+  flatbuffers::Verifier in_place(row, static_cast<size_t>(len), 64, 1000000, check_alignment);
+  CHECK_FAIL_RETURN_UNEXPECTED(VerifyTensorRowHeaderMsgBuffer(in_place), "Invalid row header");
+  const int64_t hdr_sz = GetTensorRowHeaderMsg(row)->size_of_this();
+  CHECK_FAIL_RETURN_UNEXPECTED(hdr_sz > 0 && hdr_sz <= len, "Row header is larger than its payload");
+  header->assign(row, row + hdr_sz);
+  flatbuffers::Verifier copy(header->data(), header->size());
+  CHECK_FAIL_RETURN_UNEXPECTED(VerifyTensorRowHeaderMsgBuffer(copy), "Row header changed while it was read");
+  auto *hdr = GetTensorRowHeaderMsg(header->data());
+  CHECK_FAIL_RETURN_UNEXPECTED(hdr->size_of_this() == hdr_sz, "Row header changed while it was read");
+  CHECK_FAIL_RETURN_UNEXPECTED(hdr->data_sz()->size() == hdr->column()->size(),
+                               "Row header has " + std::to_string(hdr->column()->size()) + " columns but " +
+                                 std::to_string(hdr->data_sz()->size()) + " sizes");
+  buffers->clear();
+  buffers->push_back(header->data());
+  int64_t pos = hdr_sz;
+  for (auto k = 0; k < hdr->data_sz()->size(); ++k) {
+    const int64_t sz = hdr->data_sz()->Get(k);
+    // Checked before it is added, so that pos never goes past len
+    if (sz < 0 || sz > len - pos) {
+      RETURN_STATUS_UNEXPECTED("Row is larger than its payload");
+    }
+    buffers->push_back(row + pos);
+    pos += sz;
+  }
+  return Status::OK();
+}
+
+Status SharedMemoryRing::Allocate(int64_t len, int64_t *offset) {
+  RETURN_UNEXPECTED_IF_NULL(offset);
+  const int64_t sz = mem_.size();
+  if (used_ == 0) {
+    head_ = 0;
+    tail_ = 0;
+  }
+  int64_t skip = 0;
+  if (head_ > tail_ || used_ == 0) {
+    // The free space is from the head to the end of the ring, and from the start of the ring to the tail.
+    if (len > sz - head_) {
+      if (len > tail_) {
+        return Status(StatusCode::kNoSpace);
+      }
+      // An allocation is never split. Skip the end of the ring and start over from the beginning.
+      skip = sz - head_;
+      head_ = 0;
+    }
+  } else if (len > tail_ - head_) {
+    return Status(StatusCode::kNoSpace);
+  }
+  *offset = head_;
+  head_ += len;
+  used_ += skip + len;
+  allocations_.emplace_back(head_, skip + len);
+  return Status::OK();
+}
+
+void SharedMemoryRing::FreeOldest() {
+  if (allocations_.empty()) {
+    return;
+  }
+  auto &oldest = allocations_.front();
+  tail_ = oldest.first;
+  used_ -= oldest.second;
+  allocations_.pop_front();
+}
+
+CacheIpcClient::CacheIpcClient(std::string socket_path, int32_t num_connections, int64_t ring_sz)
+    : socket_path_(std::move(socket_path)),
+      num_connections_(std::max(num_connections, 1)),
+      ring_sz_(ring_sz),
+      num_created_(0) {}
+
+CacheIpcClient::~CacheIpcClient() = default;
+
+Status CacheIpcClient::Acquire(std::unique_ptr<Connection> *out) {
+  std::unique_lock<std::mutex> lck(mux_);
+  cv_.wait(lck, [this]() { return !idle_.empty() || num_created_ < num_connections_; });
+  if (!idle_.empty()) {
+    *out = std::move(idle_.back());
+    idle_.pop_back();
+    return Status::OK();
+  }
+  ++num_created_;
+  lck.unlock();
+  auto conn = std::make_unique<Connection>();
+  Status rc = CacheIpcConnect(socket_path_, &conn->sock_);
+  if (rc.IsOk()) {
+    rc = GrowRing(conn.get(), ring_sz_);
+  }
+  if (rc.IsError()) {
+    Release(nullptr);
+    return rc;
+  }
+  *out = std::move(conn);
+  return Status::OK();
+}
+
+void CacheIpcClient::Release(std::unique_ptr<Connection> conn) {
+  std::unique_lock<std::mutex> lck(mux_);
+  // A connection which failed in the middle of a request is dropped, a new one is made when needed.
+  if (conn == nullptr) {
+    --num_created_;
+  } else {
+    idle_.push_back(std::move(conn));
+  }
+  cv_.notify_one();
+}
+
+Status CacheIpcClient::GrowRing(Connection *conn, int64_t sz) {
+  if (conn->ring_ != nullptr) {
+    sz = std::max(sz, conn->ring_->size() * 2);
+  }
+  auto ring = std::make_unique<SharedMemoryRing>();
+  RETURN_IF_NOT_OK(ring->Create(sz));
+  CacheIpcMsg msg{};
+  msg.type_ = kAttachRing;
+  msg.len_ = sz;
+  RETURN_IF_NOT_OK(CacheIpcSend(conn->sock_, msg, nullptr, ring->fd()));
+  CacheIpcMsg reply{};
+  std::string extra;
+  RETURN_IF_NOT_OK(CacheIpcReceive(conn->sock_, &reply, &extra));
+  RETURN_IF_NOT_OK(ReplyStatus(reply, extra));
+  conn->ring_ = std::move(ring);
+  return Status::OK();
+}
+
+Status CacheIpcClient::Submit(BaseRequest *rq) {
+  RETURN_UNEXPECTED_IF_NULL(rq);
+  if (rq->type_ == BaseRequest::RequestType::kCacheRow) {
+    return SubmitRows({static_cast<CacheRowRequest *>(rq)});
+  }
+  std::unique_ptr<Connection> conn;
+  RETURN_IF_NOT_OK(Acquire(&conn));
+  Status rc = DoRequest(conn.get(), rq);
+  Release(rc.IsOk() ? std::move(conn) : nullptr);
+  RETURN_IF_NOT_OK(rc);
+  rq->wp_.Set();
+  return Status::OK();
+}
+
+Status CacheIpcClient::DoRequest(Connection *conn, BaseRequest *rq) {
+  CacheIpcMsg msg{};
+  msg.type_ = static_cast<int32_t>(rq->type_);
+  msg.connection_id_ = rq->connection_id_;
+  const void *extra = nullptr;
+  switch (rq->type_) {
+    case BaseRequest::RequestType::kCreateCache: {
+      auto *create_rq = static_cast<CreationCacheRequest *>(rq);
+      msg.value_ = static_cast<int64_t>(create_rq->cache_mem_sz);
+      msg.len_ = static_cast<int64_t>(create_rq->flag_);
+      break;
+    }
+    case BaseRequest::RequestType::kCacheSchema: {
+      auto *schema_rq = static_cast<CacheSchemaRequest *>(rq);
+      extra = schema_rq->buf_;
+      msg.extra_len_ = schema_rq->len_of_buf_;
+      break;
+    }
+    case BaseRequest::RequestType::kBuildPhaseDone: {
+      auto *done_rq = static_cast<BuildPhaseDoneRequest *>(rq);
+      extra = done_rq->cookie_.data();
+      msg.extra_len_ = done_rq->cookie_.size();
+      break;
+    }
+    case BaseRequest::RequestType::kPurgeCache:
+    case BaseRequest::RequestType::kDestroyCache:
+    case BaseRequest::RequestType::kGetStat:
+    case BaseRequest::RequestType::kFetchSchema:
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("Request type " + std::to_string(msg.type_) + " is not sent this way");
+  }
+  RETURN_IF_NOT_OK(CacheIpcSend(conn->sock_, msg, extra));
+  CacheIpcMsg reply{};
+  std::string reply_extra;
+  RETURN_IF_NOT_OK(CacheIpcReceive(conn->sock_, &reply, &reply_extra));
+  rq->rc_ = ReplyStatus(reply, reply_extra);
+  if (rq->rc_.IsError()) {
+    return Status::OK();
+  }
+  switch (rq->type_) {
+    case BaseRequest::RequestType::kCreateCache:
+      static_cast<CreationCacheRequest *>(rq)->cookie_ = reply_extra;
+      break;
+    case BaseRequest::RequestType::kGetStat:
+      rq->rc_ = CopyToMemGuard(reply_extra, &static_cast<GetStatRequest *>(rq)->mem_);
+      break;
+    case BaseRequest::RequestType::kFetchSchema:
+      rq->rc_ = CopyToMemGuard(reply_extra, &static_cast<FetchSchemaRequest *>(rq)->mem_);
+      break;
+    default:
+      break;
+  }
+  return Status::OK();
+}
+
+Status CacheIpcClient::SendRow(Connection *conn, CacheRowRequest *rq) {
+  if (rq->buffers_.empty()) {
+    RETURN_STATUS_UNEXPECTED("Row is not serialized");
+  }
+  auto *hdr = GetTensorRowHeaderMsg(rq->buffers_.front());
+  const int64_t hdr_sz = hdr->size_of_this();
+  int64_t row_sz = hdr_sz;
+  for (auto k = 0; k < hdr->data_sz()->size(); ++k) {
+    row_sz += hdr->data_sz()->Get(k);
+  }
+  int64_t offset = 0;
+  Status rc = conn->ring_->Allocate(row_sz, &offset);
+  if (rc.IsNoSpace() && conn->ring_->empty()) {
+    // The row alone is larger than the ring.
+    RETURN_IF_NOT_OK(GrowRing(conn, row_sz));
+    rc = conn->ring_->Allocate(row_sz, &offset);
+  }
+  RETURN_IF_NOT_OK(rc);
+  // The header and the tensors are laid out one after another, the same way the cache pool keeps a row.
+  WritableSlice row_data(conn->ring_->GetPointer(offset), row_sz);
+  int64_t pos = 0;
+  for (auto i = 0; i < rq->buffers_.size(); ++i) {
+    int64_t sz = (i == 0) ? hdr_sz : hdr->data_sz()->Get(i - 1);
+    if (sz > 0) {
+      WritableSlice dest(row_data, pos, sz);
+      RETURN_IF_NOT_OK(WritableSlice::Copy(&dest, ReadableSlice(rq->buffers_[i], sz)));
+    }
+    pos += sz;
+  }
+  CacheIpcMsg msg{};
+  msg.type_ = static_cast<int32_t>(BaseRequest::RequestType::kCacheRow);
+  msg.connection_id_ = rq->connection_id_;
+  msg.offset_ = offset;
+  msg.len_ = row_sz;
+  msg.extra_len_ = rq->cookie_.size();
+  return CacheIpcSend(conn->sock_, msg, rq->cookie_.data());
+}
+
+Status CacheIpcClient::ReceiveRowReply(Connection *conn, CacheRowRequest *rq) {
+  CacheIpcMsg reply{};
+  std::string extra;
+  RETURN_IF_NOT_OK(CacheIpcReceive(conn->sock_, &reply, &extra));
+  conn->ring_->FreeOldest();
+  rq->rc_ = ReplyStatus(reply, extra);
+  rq->row_id_from_server_ = reply.value_;
+  rq->wp_.Set();
+  return Status::OK();
+}
+
+Status CacheIpcClient::SubmitRows(const std::vector<CacheRowRequest *> &rq) {
+  std::unique_ptr<Connection> conn;
+  RETURN_IF_NOT_OK(Acquire(&conn));
+  Status rc;
+  size_t num_sent = 0;
+  size_t num_done = 0;
+  while (rc.IsOk() && num_done < rq.size()) {
+    if (num_sent < rq.size() && num_sent - num_done < kMaxRowsInFlight) {
+      rc = SendRow(conn.get(), rq[num_sent]);
+      if (rc.IsOk()) {
+        ++num_sent;
+        continue;
+      }
+      if (!rc.IsNoSpace()) {
+        break;
+      }
+      // The ring is full. The oldest row must be cached before its space can be reused.
+      rc = Status::OK();
+    }
+    rc = ReceiveRowReply(conn.get(), rq[num_done++]);
+  }
+  Release(rc.IsOk() ? std::move(conn) : nullptr);
+  return rc;
+}
+
+Status CacheIpcClient::FetchRows(BatchFetchRequest *rq, TensorTable *out) {
+  RETURN_UNEXPECTED_IF_NULL(rq);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  std::unique_ptr<Connection> conn;
+  RETURN_IF_NOT_OK(Acquire(&conn));
+  auto fetch = [this, rq, out](Connection *conn) -> Status {
+    const auto &row_id = rq->row_id_;
+    while (true) {
+      // The connection is idle, so the whole ring is there for the reply.
+      int64_t offset = 0;
+      RETURN_IF_NOT_OK(conn->ring_->Allocate(conn->ring_->size(), &offset));
+      CacheIpcMsg msg{};
+      msg.type_ = static_cast<int32_t>(BaseRequest::RequestType::kBatchFetchRows);
+      msg.connection_id_ = rq->connection_id_;
+      msg.offset_ = offset;
+      msg.len_ = conn->ring_->size();
+      msg.extra_len_ = row_id.size() * sizeof(row_id_type);
+      RETURN_IF_NOT_OK(CacheIpcSend(conn->sock_, msg, row_id.data()));
+      CacheIpcMsg reply{};
+      std::string extra;
+      RETURN_IF_NOT_OK(CacheIpcReceive(conn->sock_, &reply, &extra));
+      if (static_cast<StatusCode>(reply.rc_) == StatusCode::kNoSpace) {
+        // The reply tells how much room the rows need.
+        conn->ring_->FreeOldest();
+        RETURN_IF_NOT_OK(GrowRing(conn, reply.len_));
+        continue;
+      }
+      rq->rc_ = ReplyStatus(reply, extra);
+      if (rq->rc_.IsOk()) {
+        rq->rc_ = rq->RestoreRows(ReadableSlice(conn->ring_->GetPointer(offset), reply.len_), out);
+      }
+      conn->ring_->FreeOldest();
+      return Status::OK();
+    }
+  };
+  Status rc = fetch(conn.get());
+  Release(rc.IsOk() ? std::move(conn) : nullptr);
+  RETURN_IF_NOT_OK(rc);
+  return rq->rc_;
+}
+}  // namespace dataset
+}  // namespace mindspore
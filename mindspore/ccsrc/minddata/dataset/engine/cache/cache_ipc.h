@@ -0,0 +1,187 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef DATASET_ENGINE_CACHE_IPC_H_
+#define DATASET_ENGINE_CACHE_IPC_H_
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/constants.h"
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class BaseRequest;
+class BatchFetchRequest;
+class CacheRowRequest;
+
+/// \brief Environment variable naming the unix socket of a standalone cache server. When it is set, CacheClient
+/// talks to that server instead of the in-process one.
+constexpr char kCacheServerSocketEnv[] = "MS_CACHE_SERVER_SOCKET";
+
+/// \brief Fixed part of every control message exchanged on the unix socket. Row payloads never go through the
+/// socket. They are placed in a shared memory ring owned by the client and only their location is sent.
+struct CacheIpcMsg {
+  // One of BaseRequest::RequestType, or kAttachRing
+  int32_t type_;
+  // StatusCode of a reply
+  int32_t rc_;
+  connection_id_type connection_id_;
+  // Location of the payload in the shared memory ring
+  int64_t offset_;
+  int64_t len_;
+  // Type specific value. Row id, memory size, flags or the size a reply needs.
+  int64_t value_;
+  // Number of bytes following this message on the socket
+  int64_t extra_len_;
+};
+
+/// \brief Control message which hands the file descriptor of a (new) shared memory ring to the server
+constexpr int32_t kAttachRing = 1024;
+
+/// \brief A shared memory segment. The client creates it and passes the file descriptor to the server through
+/// the unix socket, so the segment has no name in the file system and dies with its last user.
+class SharedMemory {
+ public:
+  SharedMemory() : fd_(-1), ptr_(nullptr), sz_(0) {}
+  ~SharedMemory() { Detach(); }
+  SharedMemory(const SharedMemory &) = delete;
+  SharedMemory &operator=(const SharedMemory &) = delete;
+
+  /// \brief Create a new segment of the given size and map it
+  Status Create(int64_t sz);
+  /// \brief Map a segment created by another process. The object takes over the file descriptor.
+  Status Attach(int fd, int64_t sz);
+  void Detach() noexcept;
+
+  int fd() const { return fd_; }
+  int64_t size() const { return sz_; }
+  uint8_t *GetPointer() const { return ptr_; }
+
+ private:
+  int fd_;
+  uint8_t *ptr_;
+  int64_t sz_;
+};
+
+/// \brief Allocator of the shared memory of one connection. Requests on a connection are served in order, so the
+/// space is handed out and released like a ring buffer: allocations are taken at the head and freed at the tail.
+class SharedMemoryRing {
+ public:
+  SharedMemoryRing() : head_(0), tail_(0), used_(0) {}
+  ~SharedMemoryRing() = default;
+
+  Status Create(int64_t sz);
+  /// \brief Reserve len contiguous bytes.
+  /// \return kNoSpace if the ring has no such room until older allocations are freed
+  Status Allocate(int64_t len, int64_t *offset);
+  /// \brief Release the oldest allocation
+  void FreeOldest();
+  bool empty() const { return allocations_.empty(); }
+
+  int fd() const { return mem_.fd(); }
+  int64_t size() const { return mem_.size(); }
+  uint8_t *GetPointer(int64_t offset) const { return mem_.GetPointer() + offset; }
+
+ private:
+  SharedMemory mem_;
+  int64_t head_;
+  int64_t tail_;
+  int64_t used_;
+  // End offset and charged length of the allocations still in use. The charge includes the bytes skipped at the end
+  // of the ring to keep an allocation contiguous.
+  std::deque<std::pair<int64_t, int64_t>> allocations_;
+};
+
+/// \brief Send a control message, followed by extra_len bytes of extra, and optionally a file descriptor.
+Status CacheIpcSend(int sock, const CacheIpcMsg &msg, const void *extra, int pass_fd = -1);
+
+/// \brief Receive a control message and its extra bytes. A file descriptor passed along is returned in fd.
+Status CacheIpcReceive(int sock, CacheIpcMsg *msg, std::string *extra, int *fd = nullptr);
+
+/// \brief Create a listening unix socket at the given path
+Status CacheIpcListen(const std::string &path, int *sock);
+
+/// \brief Connect to a listening unix socket
+Status CacheIpcConnect(const std::string &path, int *sock);
+
+/// \brief Check a row a client laid out in the shared memory, a TensorRowHeaderMsg followed by the tensors, before the
+/// server reads any of it. The client can still write to the shared memory, so the header is verified and copied
+/// once, and the server only reads the sizes from the copy.
+/// \param row Start of the row in the shared memory
+/// \param len Size of the payload holding the row
+/// \param[out] header Copy of the header
+/// \param[out] buffers The header copy, then the start of each tensor in the shared memory
+/// \return Status object
+Status ParseIpcRow(const uint8_t *row, int64_t len, std::vector<uint8_t> *header, std::vector<const void *> *buffers);
+
+/// \brief Client side of the cross process transport. It executes a request on a standalone cache server and fills
+/// in the same fields the in-process server does, so CacheClient waits on the request in the same way.
+class CacheIpcClient {
+ public:
+  /// \brief Constructor
+  /// \param socket_path The unix socket the cache server listens to
+  /// \param num_connections Maximum number of connections, each with a shared memory ring of its own
+  /// \param ring_sz Initial size of a ring. A ring grows when a row or a batch of rows does not fit.
+  explicit CacheIpcClient(std::string socket_path, int32_t num_connections = 4, int64_t ring_sz = 64 * 1048576L);
+  ~CacheIpcClient();
+
+  /// \brief Execute one request. The request is done when this returns.
+  Status Submit(BaseRequest *rq);
+
+  /// \brief Cache a batch of rows. The rows are streamed through the ring and the replies collected as the ring
+  /// fills up, so the server caches a row while the client copies the next ones.
+  Status SubmitRows(const std::vector<CacheRowRequest *> &rq);
+
+  /// \brief Fetch rows. The server writes them into the ring and they are restored from there.
+  Status FetchRows(BatchFetchRequest *rq, TensorTable *out);
+
+ private:
+  struct Connection {
+    int sock_ = -1;
+    std::unique_ptr<SharedMemoryRing> ring_;
+    ~Connection();
+  };
+
+  std::string socket_path_;
+  int32_t num_connections_;
+  int64_t ring_sz_;
+  std::mutex mux_;
+  std::condition_variable cv_;
+  std::vector<std::unique_ptr<Connection>> idle_;
+  int32_t num_created_;
+
+  Status Acquire(std::unique_ptr<Connection> *out);
+  void Release(std::unique_ptr<Connection> conn);
+  /// \brief Replace the ring of a connection by one of at least sz bytes
+  Status GrowRing(Connection *conn, int64_t sz);
+  /// \brief Execute a request which has no payload in the ring
+  Status DoRequest(Connection *conn, BaseRequest *rq);
+  /// \brief Copy a row into the ring and send it
+  /// \return kNoSpace if the ring is full and the replies of the rows already sent must be collected first
+  Status SendRow(Connection *conn, CacheRowRequest *rq);
+  /// \brief Collect the reply of the oldest row sent and release its space in the ring
+  Status ReceiveRowReply(Connection *conn, CacheRowRequest *rq);
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_ENGINE_CACHE_IPC_H_
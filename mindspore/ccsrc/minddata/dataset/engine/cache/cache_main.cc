@@ -0,0 +1,56 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include <signal.h>
+#include <iostream>
+#include <string>
+#include "common/utils.h"
+#include "minddata/dataset/core/client.h"
+#include "minddata/dataset/engine/cache/cache_ipc.h"
+#include "minddata/dataset/engine/cache/cache_server.h"
+
+namespace ms = mindspore;
+namespace ds = mindspore::dataset;
+
+/// Standalone cache server, shared by the training jobs of a host.
+/// Usage: cache_server [socket path]
+/// The socket path defaults to MS_CACHE_SERVER_SOCKET. Clients set the same variable to use this server.
+/// The server runs until it receives SIGINT or SIGTERM.
+int main(int argc, char **argv) {
+  std::string socket_path = (argc > 1) ? argv[1] : ms::common::GetEnv(ds::kCacheServerSocketEnv);
+  if (socket_path.empty()) {
+    std::cerr << "Usage: " << argv[0] << " <socket path>" << std::endl;
+    return 1;
+  }
+  // Block the signals before any thread is spawned, so that they are all left to the sigwait below.
+  sigset_t sig_set;
+  (void)sigemptyset(&sig_set);
+  (void)sigaddset(&sig_set, SIGINT);
+  (void)sigaddset(&sig_set, SIGTERM);
+  (void)pthread_sigmask(SIG_BLOCK, &sig_set, nullptr);
+  ds::Status rc = ds::GlobalInit();
+  if (rc.IsOk()) {
+    rc = ds::CacheServer::GetInstance().Listen(socket_path);
+  }
+  if (rc.IsError()) {
+    std::cerr << rc << std::endl;
+    return 1;
+  }
+  int sig = 0;
+  (void)sigwait(&sig_set, &sig);
+  std::cout << "Cache server stopped by signal " << sig << std::endl;
+  // The cache server is stopped and the socket removed when the services are torn down at exit.
+  return 0;
+}
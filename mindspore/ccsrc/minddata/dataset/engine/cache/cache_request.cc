@@ -155,12 +155,15 @@ Status BatchFetchRequest::RestoreOneTensor(const TensorMetaMsg *col_ts, const Re
 }
 
 Status BatchFetchRequest::RestoreRows(TensorTable *out) {
+  return RestoreRows(ReadableSlice(mem_.GetPointer(), mem_.GetSizeInBytes()), out);
+}
+
+Status BatchFetchRequest::RestoreRows(const ReadableSlice &all, TensorTable *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   auto num_elements = row_id_.size();
-  auto *offset_array = reinterpret_cast<const int64_t *>(mem_.GetPointer());
+  auto *offset_array = reinterpret_cast<const int64_t *>(all.GetPointer());
   TensorTable tbl;
   tbl.reserve(num_elements);
-  ReadableSlice all(mem_.GetPointer(), mem_.GetSizeInBytes());
   for (auto i = 0; i < num_elements; ++i) {
     auto len = offset_array[i + 1] - offset_array[i];
     TensorRow row;
@@ -50,6 +50,7 @@ class BaseRequest {
   // For kCreateCache
   enum class CreateCacheFlag : uint32_t { kNone = 0, kSpillToDisk = 1, kGenerateRowId = 1u << 1L };
   friend class CacheServer;
+  friend class CacheIpcClient;
   /// \brief Base class of a cache server request
   /// \param connection_id A combination of session id and crc that uniquely identifies a connection.
   /// \param type Type of the request
@@ -77,6 +78,7 @@ class BaseRequest {
 class CacheRowRequest : public BaseRequest {
  public:
   friend class CacheServer;
+  friend class CacheIpcClient;
   explicit CacheRowRequest(connection_id_type connection_id, const std::string &cookie)
       : BaseRequest(connection_id, RequestType::kCacheRow), row_id_from_server_(-1), cookie_(cookie) {}
   ~CacheRowRequest() = default;
@@ -108,20 +110,36 @@ class CacheRowRequest : public BaseRequest {
 class BatchFetchRequest : public BaseRequest {
  public:
   friend class CacheServer;
+  friend class CacheIpcClient;
   friend class CacheService;
   BatchFetchRequest(connection_id_type connection_id, const std::vector<row_id_type> &row_id)
-      : BaseRequest(connection_id, RequestType::kBatchFetchRows), row_id_(row_id) {}
+      : BaseRequest(connection_id, RequestType::kBatchFetchRows),
+        row_id_(row_id),
+        dest_(nullptr),
+        dest_sz_(0),
+        fetch_sz_(0) {}
   Status RestoreRows(TensorTable *out);
+  /// \brief Restore the rows from a reply which the server placed elsewhere, e.g. in shared memory
+  /// \param data The reply of the server
+  /// \param out A TensorTable of TensorRows
+  /// \return Status object
+  Status RestoreRows(const ReadableSlice &data, TensorTable *out);
 
  private:
   std::vector<row_id_type> row_id_;
   MemGuard<uint8_t> mem_;
+  // If set, the server writes the rows into this buffer instead of mem_. The size of the rows is returned in
+  // fetch_sz_, which tells the client how large the buffer must be if it is too small.
+  uint8_t *dest_;
+  int64_t dest_sz_;
+  int64_t fetch_sz_;
   Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out);
 };
 /// \brief Request to create a cache for the current connection
 class CreationCacheRequest : public BaseRequest {
  public:
   friend class CacheServer;
+  friend class CacheIpcClient;
   /// \brief Constructor
   /// \param connection_id
   /// \param cache_mem_sz Maximum memory assigned for this connection. 0 means unlimited
@@ -141,12 +159,14 @@ class CreationCacheRequest : public BaseRequest {
 class PurgeCacheRequest : public BaseRequest {
  public:
   friend class CacheServer;
+  friend class CacheIpcClient;
   explicit PurgeCacheRequest(connection_id_type connection_id) : BaseRequest(connection_id, RequestType::kPurgeCache) {}
 };
 /// \brief Request to destroy a cache
 class DestroyCacheRequest : public BaseRequest {
  public:
   friend class CacheServer;
+  friend class CacheIpcClient;
   explicit DestroyCacheRequest(connection_id_type connection_id)
       : BaseRequest(connection_id, RequestType::kDestroyCache) {}
 };
@@ -154,6 +174,7 @@ class DestroyCacheRequest : public BaseRequest {
 class GetStatRequest : public BaseRequest {
  public:
   friend class CacheServer;
+  friend class CacheIpcClient;
   friend class CacheService;
   explicit GetStatRequest(connection_id_type connection_id) : BaseRequest(connection_id, RequestType::kGetStat) {}
   row_id_type GetMinRowId() const {
@@ -184,6 +205,7 @@ class GetStatRequest : public BaseRequest {
 class CacheSchemaRequest : public BaseRequest {
  public:
   friend class CacheServer;
+  friend class CacheIpcClient;
   explicit CacheSchemaRequest(connection_id_type connection_id)
       : BaseRequest(connection_id, RequestType::kCacheSchema), buf_(nullptr), len_of_buf_(0) {}
   ~CacheSchemaRequest() = default;
@@ -200,6 +222,7 @@ class CacheSchemaRequest : public BaseRequest {
 class FetchSchemaRequest : public BaseRequest {
  public:
   friend class CacheServer;
+  friend class CacheIpcClient;
   explicit FetchSchemaRequest(connection_id_type connection_id)
       : BaseRequest(connection_id, RequestType::kFetchSchema) {}
   ~FetchSchemaRequest() = default;
@@ -214,6 +237,7 @@ class FetchSchemaRequest : public BaseRequest {
 class BuildPhaseDoneRequest : public BaseRequest {
  public:
   friend class CacheServer;
+  friend class CacheIpcClient;
   BuildPhaseDoneRequest(connection_id_type connection_id, const std::string &cookie)
       : BaseRequest(connection_id, RequestType::kBuildPhaseDone), cookie_(cookie) {}
 
@@ -14,6 +14,13 @@
  * limitations under the License.
 */
 #include "minddata/dataset/engine/cache/cache_server.h"
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include <cerrno>
+#include <cstring>
 #include "minddata/dataset/engine/cache/cache_service.h"
 #include "minddata/dataset/engine/cache/cache_request.h"
 #include "minddata/dataset/util/bit.h"
@@ -42,6 +49,13 @@ Status CacheServer::DoServiceStop() {
   Status rc2;
   // First stop all the threads.
   RETURN_IF_NOT_OK(vg_.ServiceStop());
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (listen_sock_ >= 0) {
+    (void)close(listen_sock_);
+    (void)unlink(socket_path_.c_str());
+    listen_sock_ = -1;
+  }
+#endif
   // Clean up all the caches if any.
   UniqueLock lck(&rwLock_);
   auto it = all_caches_.begin();
@@ -113,140 +127,354 @@ Status CacheServer::ServerRequest() {
   while (true) {
     BaseRequest *base_rq = nullptr;
     RETURN_IF_NOT_OK(cache_q_->PopFront(&base_rq));
-    auto cs = GetService(base_rq->connection_id_);
-    // Except for creating a new session, we expect cs is not null.
-    switch (base_rq->type_) {
-      case BaseRequest::RequestType::kCacheRow: {
-        if (cs == nullptr) {
-          std::string errMsg = "Cache id " + std::to_string(base_rq->connection_id_) + " not found";
-          base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
+    RETURN_IF_NOT_OK(HandleRequest(base_rq));
+    // Notify it is done, and move on to the next request.
+    base_rq->wp_.Set();
+  }
+  return Status::OK();
+}
+
+Status CacheServer::HandleRequest(BaseRequest *base_rq) {
+  auto cs = GetService(base_rq->connection_id_);
+  // Except for creating a new session, we expect cs is not null.
+  switch (base_rq->type_) {
+    case BaseRequest::RequestType::kCacheRow: {
+      if (cs == nullptr) {
+        std::string errMsg = "Cache id " + std::to_string(base_rq->connection_id_) + " not found";
+        base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
+      } else {
+        auto *rq = reinterpret_cast<CacheRowRequest *>(base_rq);
+        // Only if the cookie matches, we can accept insert into this cache that has a build phase
+        if (!cs->HasBuildPhase() || rq->cookie_ == cs->cookie()) {
+          rq->rc_ = cs->CacheRow(rq->buffers_, &rq->row_id_from_server_);
         } else {
-          auto *rq = reinterpret_cast<CacheRowRequest *>(base_rq);
-          // Only if the cookie matches, we can accept insert into this cache that has a build phase
-          if (!cs->HasBuildPhase() || rq->cookie_ == cs->cookie()) {
-            rq->rc_ = cs->CacheRow(rq->buffers_, &rq->row_id_from_server_);
-          } else {
-            return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "Cookie mismatch");
-          }
+          return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "Cookie mismatch");
         }
-        break;
       }
-      case BaseRequest::RequestType::kBatchFetchRows: {
-        if (cs == nullptr) {
-          std::string errMsg = "Cache id " + std::to_string(base_rq->connection_id_) + " not found";
-          base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
+      break;
+    }
+    case BaseRequest::RequestType::kBatchFetchRows: {
+      if (cs == nullptr) {
+        std::string errMsg = "Cache id " + std::to_string(base_rq->connection_id_) + " not found";
+        base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
+      } else {
+        auto *rq = reinterpret_cast<BatchFetchRequest *>(base_rq);
+        if (rq->dest_ != nullptr) {
+          rq->rc_ = cs->BatchFetch(rq->row_id_, rq->dest_, rq->dest_sz_, &rq->fetch_sz_);
         } else {
-          auto *rq = reinterpret_cast<BatchFetchRequest *>(base_rq);
           rq->rc_ = cs->BatchFetch(rq->row_id_, &rq->mem_);
         }
-        break;
       }
-      case BaseRequest::RequestType::kCreateCache: {
-        // If the cache is already created we still need to run the creation so that we do sanity checks on the
-        // client id and return the cache id back to the user.
-        auto *rq = reinterpret_cast<CreationCacheRequest *>(base_rq);
-        rq->rc_ = CreateService(rq->connection_id_, rq->cache_mem_sz, rq->flag_, &rq->cookie_);
-        break;
-      }
-      case BaseRequest::RequestType::kPurgeCache: {
-        if (cs != nullptr) {
-          base_rq->rc_ = cs->Purge();
-        } else {
-          // it is already purged. Ignore it.
-          base_rq->rc_ = Status::OK();
-        }
-        break;
+      break;
+    }
+    case BaseRequest::RequestType::kCreateCache: {
+      // If the cache is already created we still need to run the creation so that we do sanity checks on the
+      // client id and return the cache id back to the user.
+      auto *rq = reinterpret_cast<CreationCacheRequest *>(base_rq);
+      rq->rc_ = CreateService(rq->connection_id_, rq->cache_mem_sz, rq->flag_, &rq->cookie_);
+      break;
+    }
+    case BaseRequest::RequestType::kPurgeCache: {
+      if (cs != nullptr) {
+        base_rq->rc_ = cs->Purge();
+      } else {
+        // it is already purged. Ignore it.
+        base_rq->rc_ = Status::OK();
       }
-      case BaseRequest::RequestType::kDestroyCache: {
-        if (cs != nullptr) {
-          // We need a strong lock to protect the map.
-          connection_id_type id = base_rq->connection_id_;
-          UniqueLock lck(&rwLock_);
-          // std::map will invoke the constructor of CacheService. So we don't need to do anything here.
-          auto n = all_caches_.erase(id);
-          if (n == 0) {
-            // It has been destroyed by another duplicate request.
-            MS_LOG(INFO) << "Duplicate request for " + std::to_string(id) + " to create cache service";
-          }
-          base_rq->rc_ = Status::OK();
-        } else {
-          // it is already destroyed. Ignore it.
-          base_rq->rc_ = Status::OK();
+      break;
+    }
+    case BaseRequest::RequestType::kDestroyCache: {
+      if (cs != nullptr) {
+        // We need a strong lock to protect the map.
+        connection_id_type id = base_rq->connection_id_;
+        UniqueLock lck(&rwLock_);
+        // std::map will invoke the constructor of CacheService. So we don't need to do anything here.
+        auto n = all_caches_.erase(id);
+        if (n == 0) {
+          // It has been destroyed by another duplicate request.
+          MS_LOG(INFO) << "Duplicate request for " + std::to_string(id) + " to create cache service";
         }
-        break;
+        base_rq->rc_ = Status::OK();
+      } else {
+        // it is already destroyed. Ignore it.
+        base_rq->rc_ = Status::OK();
       }
-      case BaseRequest::RequestType::kGetStat: {
-        if (cs == nullptr) {
-          std::string errMsg = "Session " + std::to_string(base_rq->connection_id_) + " not found";
-          base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
-        } else {
-          auto *rq = reinterpret_cast<GetStatRequest *>(base_rq);
-          CacheService::ServiceStat svc_stat;
-          rq->rc_ = cs->GetStat(&svc_stat);
+      break;
+    }
+    case BaseRequest::RequestType::kGetStat: {
+      if (cs == nullptr) {
+        std::string errMsg = "Session " + std::to_string(base_rq->connection_id_) + " not found";
+        base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
+      } else {
+        auto *rq = reinterpret_cast<GetStatRequest *>(base_rq);
+        CacheService::ServiceStat svc_stat;
+        rq->rc_ = cs->GetStat(&svc_stat);
+        if (rq->rc_.IsOk()) {
+          flatbuffers::FlatBufferBuilder fbb;
+          ServiceStatMsgBuilder bld(fbb);
+          bld.add_num_disk_cached(svc_stat.stat_.num_disk_cached);
+          bld.add_num_mem_cached(svc_stat.stat_.num_mem_cached);
+          bld.add_max_row_id(svc_stat.max_);
+          bld.add_min_row_id(svc_stat.min_);
+          bld.add_state(svc_stat.state_);
+          auto offset = bld.Finish();
+          fbb.Finish(offset);
+          rq->rc_ = rq->mem_.allocate(fbb.GetSize());
           if (rq->rc_.IsOk()) {
-            flatbuffers::FlatBufferBuilder fbb;
-            ServiceStatMsgBuilder bld(fbb);
-            bld.add_num_disk_cached(svc_stat.stat_.num_disk_cached);
-            bld.add_num_mem_cached(svc_stat.stat_.num_mem_cached);
-            bld.add_max_row_id(svc_stat.max_);
-            bld.add_min_row_id(svc_stat.min_);
-            bld.add_state(svc_stat.state_);
-            auto offset = bld.Finish();
-            fbb.Finish(offset);
-            rq->rc_ = rq->mem_.allocate(fbb.GetSize());
-            if (rq->rc_.IsOk()) {
-              WritableSlice dest(rq->mem_.GetMutablePointer(), fbb.GetSize());
-              ReadableSlice src(fbb.GetBufferPointer(), fbb.GetSize());
-              RETURN_IF_NOT_OK(WritableSlice::Copy(&dest, src));
-            }
+            WritableSlice dest(rq->mem_.GetMutablePointer(), fbb.GetSize());
+            ReadableSlice src(fbb.GetBufferPointer(), fbb.GetSize());
+            RETURN_IF_NOT_OK(WritableSlice::Copy(&dest, src));
           }
         }
-        break;
       }
-      case BaseRequest::RequestType::kCacheSchema: {
-        if (cs == nullptr) {
-          std::string errMsg = "Session " + std::to_string(base_rq->connection_id_) + " not found";
-          base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
-        } else {
-          auto *rq = reinterpret_cast<CacheSchemaRequest *>(base_rq);
-          rq->rc_ = cs->CacheSchema(rq->buf_, rq->len_of_buf_);
-        }
-        break;
+      break;
+    }
+    case BaseRequest::RequestType::kCacheSchema: {
+      if (cs == nullptr) {
+        std::string errMsg = "Session " + std::to_string(base_rq->connection_id_) + " not found";
+        base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
+      } else {
+        auto *rq = reinterpret_cast<CacheSchemaRequest *>(base_rq);
+        rq->rc_ = cs->CacheSchema(rq->buf_, rq->len_of_buf_);
       }
-      case BaseRequest::RequestType::kFetchSchema: {
-        if (cs == nullptr) {
-          std::string errMsg = "Session " + std::to_string(base_rq->connection_id_) + " not found";
-          base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
-        } else {
-          auto *rq = reinterpret_cast<FetchSchemaRequest *>(base_rq);
-          rq->rc_ = cs->FetchSchema(&rq->mem_);
-        }
-        break;
+      break;
+    }
+    case BaseRequest::RequestType::kFetchSchema: {
+      if (cs == nullptr) {
+        std::string errMsg = "Session " + std::to_string(base_rq->connection_id_) + " not found";
+        base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
+      } else {
+        auto *rq = reinterpret_cast<FetchSchemaRequest *>(base_rq);
+        rq->rc_ = cs->FetchSchema(&rq->mem_);
       }
-      case BaseRequest::RequestType::kBuildPhaseDone: {
-        if (cs == nullptr) {
-          std::string errMsg = "Session " + std::to_string(base_rq->connection_id_) + " not found";
-          base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
+      break;
+    }
+    case BaseRequest::RequestType::kBuildPhaseDone: {
+      if (cs == nullptr) {
+        std::string errMsg = "Session " + std::to_string(base_rq->connection_id_) + " not found";
+        base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, errMsg);
+      } else {
+        auto *rq = reinterpret_cast<BuildPhaseDoneRequest *>(base_rq);
+        // We can only allow to switch phase is the cookie match.
+        if (rq->cookie_ == cs->cookie()) {
+          rq->rc_ = cs->BuildPhaseDone();
         } else {
-          auto *rq = reinterpret_cast<BuildPhaseDoneRequest *>(base_rq);
-          // We can only allow to switch phase is the cookie match.
-          if (rq->cookie_ == cs->cookie()) {
-            rq->rc_ = cs->BuildPhaseDone();
-          } else {
-            return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "Cookie mismatch");
-          }
+          return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "Cookie mismatch");
         }
-        break;
       }
-      default:
-        base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "Unknown request type");
+      break;
+    }
+    default:
+      base_rq->rc_ = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "Unknown request type");
+  }
+  return Status::OK();
+}
+
+Status CacheServer::Listen(const std::string &socket_path) {
+  if (listen_sock_ >= 0) {
+    RETURN_STATUS_UNEXPECTED("Cache server is already listening on " + socket_path_);
+  }
+  RETURN_IF_NOT_OK(CacheIpcListen(socket_path, &listen_sock_));
+  socket_path_ = socket_path;
+  MS_LOG(INFO) << "CacheServer listening on " << socket_path_;
+  auto f = std::bind(&CacheServer::AcceptConnections, this);
+  RETURN_IF_NOT_OK(vg_.CreateAsyncTask("Cache server listener", f));
+  return Status::OK();
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+namespace {
+// Threads blocked on a socket check for interrupt at this interval.
+constexpr int kPollIntervalMs = 100;
+
+/// \brief Wait until the socket has something to read. Return with ready set to false if the thread is interrupted.
+Status WaitForInput(int sock, bool *ready) {
+  *ready = false;
+  while (!this_thread::is_interrupted()) {
+    struct pollfd pfd {};
+    pfd.fd = sock;
+    pfd.events = POLLIN;
+    auto n = poll(&pfd, 1, kPollIntervalMs);
+    if (n > 0) {
+      *ready = true;
+      break;
+    }
+    if (n < 0 && errno != EINTR) {
+      RETURN_STATUS_UNEXPECTED("Poll failed: " + std::string(strerror(errno)));
+    }
+  }
+  return Status::OK();
+}
+}  // namespace
+
+Status CacheServer::AcceptConnections() {
+  TaskManager::FindMe()->Post();
+  while (true) {
+    bool ready = false;
+    RETURN_IF_NOT_OK(WaitForInput(listen_sock_, &ready));
+    if (!ready) {
+      break;
+    }
+    int sock = accept(listen_sock_, nullptr, nullptr);
+    if (sock < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      RETURN_STATUS_UNEXPECTED("Accept failed: " + std::string(strerror(errno)));
+    }
+    auto f = std::bind(&CacheServer::ServeConnection, this, sock);
+    Status rc = vg_.CreateAsyncTask("Cache server connection", f);
+    if (rc.IsError()) {
+      (void)close(sock);
+      return rc;
     }
-    // Notify it is done, and move on to the next request.
-    base_rq->wp_.Set();
   }
   return Status::OK();
 }
+
+Status CacheServer::ServeConnection(int sock) {
+  TaskManager::FindMe()->Post();
+  SharedMemory ring;
+  Status rc;
+  while (true) {
+    bool ready = false;
+    rc = WaitForInput(sock, &ready);
+    if (rc.IsError() || !ready) {
+      break;
+    }
+    CacheIpcMsg msg{};
+    std::string extra;
+    int fd = -1;
+    rc = CacheIpcReceive(sock, &msg, &extra, &fd);
+    if (rc.IsError()) {
+      break;
+    }
+    CacheIpcMsg reply{};
+    std::string reply_extra;
+    Status req_rc = ServeIpcRequest(msg, extra, fd, &ring, &reply, &reply_extra);
+    reply.type_ = msg.type_;
+    reply.connection_id_ = msg.connection_id_;
+    reply.rc_ = static_cast<int32_t>(req_rc.get_code());
+    if (req_rc.IsError()) {
+      reply_extra = req_rc.ToString();
+    }
+    reply.extra_len_ = reply_extra.size();
+    rc = CacheIpcSend(sock, reply, reply_extra.data());
+    if (rc.IsError()) {
+      break;
+    }
+  }
+  // A client going away is not an error of the server.
+  MS_LOG(INFO) << "Cache client connection closed. " << rc;
+  (void)close(sock);
+  return Status::OK();
+}
+#else
+Status CacheServer::AcceptConnections() { RETURN_STATUS_UNEXPECTED("Unix socket is not supported"); }
+Status CacheServer::ServeConnection(int sock) { RETURN_STATUS_UNEXPECTED("Unix socket is not supported"); }
+#endif
+
+Status CacheServer::ServeIpcRequest(const CacheIpcMsg &msg, const std::string &extra, int fd, SharedMemory *ring,
+                                    CacheIpcMsg *reply, std::string *reply_extra) {
+  if (msg.type_ == kAttachRing) {
+    if (fd < 0) {
+      RETURN_STATUS_UNEXPECTED("No shared memory passed along");
+    }
+    return ring->Attach(fd, msg.len_);
+  }
+  if (fd >= 0) {
+    (void)close(fd);
+  }
+  // Except for the row ids of a fetch, the payloads are in the ring, and must be within it.
+  auto check_payload = [&msg, ring]() -> Status {
+    if (ring->GetPointer() == nullptr || msg.offset_ < 0 || msg.len_ <= 0 || msg.offset_ > ring->size() ||
+        msg.len_ > ring->size() - msg.offset_) {
+      RETURN_STATUS_UNEXPECTED("Payload out of the shared memory");
+    }
+    return Status::OK();
+  };
+  // The status of a request is either returned or kept in the request.
+  auto run = [this](BaseRequest *rq) -> Status {
+    Status rc = HandleRequest(rq);
+    return rc.IsError() ? rc : rq->rc_;
+  };
+  Status rc;
+  switch (static_cast<BaseRequest::RequestType>(msg.type_)) {
+    case BaseRequest::RequestType::kCacheRow: {
+      RETURN_IF_NOT_OK(check_payload());
+      CacheRowRequest rq(msg.connection_id_, extra);
+      // The client has laid out the header followed by the tensors. Point to each of them in the ring, so that
+      // they are copied only once, into the cache pool.
+      std::vector<uint8_t> header;
+      RETURN_IF_NOT_OK(ParseIpcRow(ring->GetPointer() + msg.offset_, msg.len_, &header, &rq.buffers_));
+      rc = run(&rq);
+      reply->value_ = rq.row_id_from_server_;
+      break;
+    }
+    case BaseRequest::RequestType::kBatchFetchRows: {
+      RETURN_IF_NOT_OK(check_payload());
+      const auto *ids = reinterpret_cast<const row_id_type *>(extra.data());
+      BatchFetchRequest rq(msg.connection_id_, std::vector<row_id_type>(ids, ids + extra.size() / sizeof(row_id_type)));
+      // The rows are written to the ring and restored by the client from there.
+      rq.dest_ = ring->GetPointer() + msg.offset_;
+      rq.dest_sz_ = msg.len_;
+      rc = run(&rq);
+      reply->offset_ = msg.offset_;
+      reply->len_ = rq.fetch_sz_;
+      break;
+    }
+    case BaseRequest::RequestType::kCreateCache: {
+      CreationCacheRequest rq(msg.connection_id_, static_cast<uint64_t>(msg.value_),
+                              static_cast<BaseRequest::CreateCacheFlag>(msg.len_));
+      rc = run(&rq);
+      *reply_extra = rq.cookie_;
+      break;
+    }
+    case BaseRequest::RequestType::kPurgeCache: {
+      PurgeCacheRequest rq(msg.connection_id_);
+      rc = run(&rq);
+      break;
+    }
+    case BaseRequest::RequestType::kDestroyCache: {
+      DestroyCacheRequest rq(msg.connection_id_);
+      rc = run(&rq);
+      break;
+    }
+    case BaseRequest::RequestType::kGetStat: {
+      GetStatRequest rq(msg.connection_id_);
+      rc = run(&rq);
+      if (rc.IsOk()) {
+        reply_extra->assign(reinterpret_cast<const char *>(rq.mem_.GetPointer()), rq.mem_.GetSizeInBytes());
+      }
+      break;
+    }
+    case BaseRequest::RequestType::kCacheSchema: {
+      CacheSchemaRequest rq(msg.connection_id_);
+      rq.buf_ = extra.data();
+      rq.len_of_buf_ = extra.size();
+      rc = run(&rq);
+      break;
+    }
+    case BaseRequest::RequestType::kFetchSchema: {
+      FetchSchemaRequest rq(msg.connection_id_);
+      rc = run(&rq);
+      if (rc.IsOk()) {
+        reply_extra->assign(reinterpret_cast<const char *>(rq.mem_.GetPointer()), rq.mem_.GetSizeInBytes());
+      }
+      break;
+    }
+    case BaseRequest::RequestType::kBuildPhaseDone: {
+      BuildPhaseDoneRequest rq(msg.connection_id_, extra);
+      rc = run(&rq);
+      break;
+    }
+    default:
+      RETURN_STATUS_UNEXPECTED("Unknown request type " + std::to_string(msg.type_));
+  }
+  return rc;
+}
+
 CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers)
-    : top_(spill_path), num_workers_(num_workers) {}
+    : top_(spill_path), num_workers_(num_workers), listen_sock_(-1) {}
 }  // namespace dataset
 }  // namespace mindspore
@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 #include <map>
+#include "minddata/dataset/engine/cache/cache_ipc.h"
 #include "minddata/dataset/engine/cache/cache_service.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/util/arena.h"
@@ -62,6 +63,12 @@ class CacheServer : public Service {
     return Status::OK();
   }
 
+  /// \brief Accept cache clients of other processes on a unix socket. Each client connection is served by a thread
+  /// of its own, and the rows are exchanged through a shared memory ring the client hands over.
+  /// \param socket_path Path of the unix socket
+  /// \return Status object
+  Status Listen(const std::string &socket_path);
+
  private:
   mutable RWLock rwLock_;
   std::string top_;
@@ -69,6 +76,8 @@ class CacheServer : public Service {
   std::shared_ptr<Queue<BaseRequest *>> cache_q_;
   TaskGroup vg_;
   int32_t num_workers_;
+  std::string socket_path_;
+  int listen_sock_;
 
   /// \brief Constructor
   /// \param spill_path Top directory for spilling buffers to.
@@ -92,6 +101,26 @@ class CacheServer : public Service {
 
   /// \brief Entry point for all server threads.
   Status ServerRequest();
+
+  /// \brief Carry out one request, from the queue or from a client connection.
+  Status HandleRequest(BaseRequest *base_rq);
+
+  /// \brief Entry point of the thread accepting client connections on the unix socket.
+  Status AcceptConnections();
+
+  /// \brief Entry point of the thread serving one client connection.
+  Status ServeConnection(int sock);
+
+  /// \brief Carry out one control message of a client connection.
+  /// \param[in] msg The control message
+  /// \param[in] extra The bytes following the control message
+  /// \param[in] fd The file descriptor passed along with the message, if any
+  /// \param[in/out] ring The shared memory ring of the connection
+  /// \param[out] reply The reply control message
+  /// \param[out] reply_extra The bytes following the reply
+  /// \return Status of the request
+  Status ServeIpcRequest(const CacheIpcMsg &msg, const std::string &extra, int fd, SharedMemory *ring,
+                         CacheIpcMsg *reply, std::string *reply_extra);
 };
 }  // namespace dataset
 }  // namespace mindspore
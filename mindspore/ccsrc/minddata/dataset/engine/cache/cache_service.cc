@@ -157,6 +157,32 @@ Status CacheService::GetStat(CacheService::ServiceStat *out) {
 }
 Status CacheService::BatchFetch(const std::vector<row_id_type> &v, MemGuard<uint8_t> *out) const {
   RETURN_UNEXPECTED_IF_NULL(out);
+  MemGuard<uint8_t> mem;
+  auto alloc = [&mem](int64_t mem_sz, uint8_t **p) -> Status {
+    RETURN_IF_NOT_OK(mem.allocate(mem_sz));
+    *p = mem.GetMutablePointer();
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(FetchRows(v, alloc));
+  *out = std::move(mem);
+  return Status::OK();
+}
+Status CacheService::BatchFetch(const std::vector<row_id_type> &v, uint8_t *dest, int64_t dest_sz,
+                                int64_t *mem_sz) const {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  RETURN_UNEXPECTED_IF_NULL(mem_sz);
+  auto alloc = [dest, dest_sz, mem_sz](int64_t sz, uint8_t **p) -> Status {
+    *mem_sz = sz;
+    if (sz > dest_sz) {
+      return Status(StatusCode::kNoSpace, __LINE__, __FILE__, "Buffer too small for the rows");
+    }
+    *p = dest;
+    return Status::OK();
+  };
+  return FetchRows(v, alloc);
+}
+Status CacheService::FetchRows(const std::vector<row_id_type> &v,
+                               const std::function<Status(int64_t, uint8_t **)> &alloc) const {
   SharedLock rw(&rw_lock_);
   if (st_ == State::kBuildPhase) {
     // For this kind of cache service, we can't fetch yet until we are done with caching all the rows.
@@ -188,11 +214,11 @@ Status CacheService::BatchFetch(const std::vector<row_id_type> &v, MemGuard<uint
       sz_v.push_back(0);
     }
   }
-  MemGuard<uint8_t> mem;
-  RETURN_IF_NOT_OK(mem.allocate(mem_sz));
-  auto *offset_array = reinterpret_cast<int64_t *>(mem.GetMutablePointer());
+  uint8_t *mem = nullptr;
+  RETURN_IF_NOT_OK(alloc(mem_sz, &mem));
+  auto *offset_array = reinterpret_cast<int64_t *>(mem);
   offset_array[0] = data_offset;
-  WritableSlice all(mem.GetMutablePointer(), mem.GetSizeInBytes());
+  WritableSlice all(mem, mem_sz);
   for (auto i = 0; i < num_elements; ++i) {
     auto sz = sz_v.at(i);
     offset_array[i + 1] = offset_array[i] + sz;
@@ -208,7 +234,6 @@ Status CacheService::BatchFetch(const std::vector<row_id_type> &v, MemGuard<uint
       }
     }
   }
-  *out = std::move(mem);
   return Status::OK();
 }
 Status CacheService::CacheSchema(const void *buf, int64_t len) {
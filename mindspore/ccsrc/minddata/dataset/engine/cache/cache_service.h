@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -75,6 +76,13 @@ class CacheService : public Service {
   /// \param[out] out A contiguous memory buffer that holds the requested rows.
   /// \return Status object
   Status BatchFetch(const std::vector<row_id_type> &v, MemGuard<uint8_t> *out) const;
+  /// \brief Same as above but the rows are written into a buffer provided by the caller, e.g. shared memory.
+  /// \param[in] v A vector of row id.
+  /// \param[in] dest The buffer to write the rows to
+  /// \param[in] dest_sz Size of the buffer
+  /// \param[out] mem_sz Size of the rows. If it is larger than dest_sz, nothing is written and kNoSpace is returned.
+  /// \return Status object
+  Status BatchFetch(const std::vector<row_id_type> &v, uint8_t *dest, int64_t dest_sz, int64_t *mem_sz) const;
 
   /// \brief Getter function
   /// \return Spilling path
@@ -137,6 +145,9 @@ class CacheService : public Service {
   /// \brief Private function to generate a row id
   /// \return Row id assigned.
   row_id_type GetNextRowId() { return next_id_.fetch_add(1); }
+
+  /// \brief Common part of the BatchFetch. The output buffer is obtained from alloc once its size is known.
+  Status FetchRows(const std::vector<row_id_type> &v, const std::function<Status(int64_t, uint8_t **)> &alloc) const;
 };
 }  // namespace dataset
 }  // namespace mindspore
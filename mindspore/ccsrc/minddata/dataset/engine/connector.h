@@ -16,6 +16,7 @@
 #ifndef DATASET_ENGINE_CONNECTOR_H_
 #define DATASET_ENGINE_CONNECTOR_H_
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
@@ -72,7 +73,7 @@ class Connector {
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each queue.
   Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : num_producers_(n_producers), num_consumers_(n_consumers) {
+      : num_producers_(n_producers), num_consumers_(n_consumers), num_active_producers_(n_producers), num_popped_(0) {
     MS_LOG(DEBUG) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
     my_name_ = Services::GetUniqueID();
     // We require the consumers to have ids sequentially from 0 to the num_consumers_-1,
@@ -101,7 +102,7 @@ class Connector {
       std::unique_lock<std::mutex> lk(m_);
       RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
       RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
-      pop_from_ = (pop_from_ + 1) % num_producers_;
+      AdvancePopFrom();
       out_buffers_count_++;
       expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
     }
@@ -143,6 +144,12 @@ class Connector {
     expect_consumer_ = 0;
     pop_from_ = 0;
     out_buffers_count_ = 0;
+    num_popped_ = 0;
+    {
+      std::unique_lock<std::mutex> lk(schedule_mux_);
+      producer_schedule_.clear();
+    }
+    num_active_producers_ = num_producers_;
     MS_LOG(DEBUG) << "Connector counters reset.";
   }
 
@@ -174,6 +181,26 @@ class Connector {
     return capacity;
   }
 
+  // Change the capacity of every internal queue while the connector is in use.
+  // @param queue_capacity The new number of elements of each queue.
+  // @return Status The error code return
+  Status SetQueueCapacity(int32_t queue_capacity) {
+    for (int32_t i = 0; i < queues_.size(); ++i) {
+      RETURN_IF_NOT_OK(queues_[i]->Resize(queue_capacity));
+    }
+    return Status::OK();
+  }
+
+  // Change the number of producers the elements are popped from, for producers which can hand their work to a
+  // subset of their threads. The producers must switch at the start of a round robin, and tell the connector the
+  // position of the first element of that round before they push it.
+  // @param index The position, counted from 0, of the first element pushed by the new set of producers.
+  // @param num_active_producers The number of producers from that element on, at most the number of queues.
+  void ScheduleActiveProducers(int64_t index, int32_t num_active_producers) {
+    std::unique_lock<std::mutex> lk(schedule_mux_);
+    producer_schedule_.emplace_back(index, num_active_producers);
+  }
+
   // Register the internal resources with Task group for interruption service.
   // @param vg
   // @return
@@ -200,6 +227,26 @@ class Connector {
   int32_t num_producers_;
   int32_t num_consumers_;
 
+  // The producers currently pushing elements, and the changes scheduled by ScheduleActiveProducers. The schedule
+  // has its own lock, since m_ is held by a consumer while it waits for the next element.
+  int32_t num_active_producers_;
+  int64_t num_popped_;
+  std::mutex schedule_mux_;
+  std::deque<std::pair<int64_t, int32_t>> producer_schedule_;
+
+  // Move to the queue of the next element. Called with m_ held, after an element has been popped.
+  void AdvancePopFrom() {
+    {
+      std::unique_lock<std::mutex> lk(schedule_mux_);
+      while (!producer_schedule_.empty() && producer_schedule_.front().first <= num_popped_) {
+        num_active_producers_ = producer_schedule_.front().second;
+        producer_schedule_.pop_front();
+      }
+    }
+    num_popped_++;
+    pop_from_ = (pop_from_ + 1) % num_active_producers_;
+  }
+
   // Used in the Pop(), when a thread call pop() but it is not the expect_consumer_.
   std::mutex m_;
   CondVar cv_;
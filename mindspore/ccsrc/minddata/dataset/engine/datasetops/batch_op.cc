@@ -24,6 +24,7 @@
 #endif
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/engine/db_connector.h"
+#include "minddata/dataset/engine/datasetops/map_op.h"
 #include "minddata/dataset/engine/opt/pass.h"
 #include "minddata/dataset/kernels/data/data_utils.h"
 
@@ -70,9 +71,7 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
       pyfunc_column_names_(cols_to_map),
       batch_size_func_(batch_size_func),
       batch_map_func_(batch_map_func),
-      pad_info_(pad_map) {
-  worker_queues_.Init(num_workers, op_queue_size);
-}
+      pad_info_(pad_map) {}
 #else
 BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size, int32_t num_workers,
                  const std::vector<std::string> &cols_to_map, PadInfo pad_map)
@@ -81,9 +80,7 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
       drop_(drop),
       pad_(pad),
       pyfunc_column_names_(cols_to_map),
-      pad_info_(pad_map) {
-  worker_queues_.Init(num_workers, op_queue_size);
-}
+      pad_info_(pad_map) {}
 #endif
 
 Status BatchOp::operator()() {
@@ -103,7 +100,9 @@ Status BatchOp::operator()() {
       table->emplace_back(new_row);
       // if # of rows is enough to make 1 batch (1 batch is buffer), send it to worker_queue
       if (table->size() == static_cast<size_t>(cur_batch_size)) {
-        RETURN_IF_NOT_OK(worker_queues_[cnt++ % num_workers_]->EmplaceBack(
+        int32_t worker_id = NextWorker();
+        cnt++;
+        RETURN_IF_NOT_OK(worker_queues_[worker_id]->EmplaceBack(
           std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt - epoch_num))));
         table = std::make_unique<TensorQTable>();
         RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, cnt - epoch_num)));
@@ -112,24 +111,26 @@ Status BatchOp::operator()() {
     }
     // Reminder logic, execute only when there is a remainder (table is non empty) and don't drop
     if (drop_ == false && table->empty() == false) {
-      RETURN_IF_NOT_OK(worker_queues_[cnt++ % num_workers_]->EmplaceBack(
+      int32_t worker_id = NextWorker();
+      cnt++;
+      RETURN_IF_NOT_OK(worker_queues_[worker_id]->EmplaceBack(
         std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt - epoch_num))));
+    } else if (batch_slots_ != nullptr && table->empty() == false) {
+      batch_slots_->Drop(epoch_num, batch_num);
     }
     table = std::make_unique<TensorQTable>();  // this drops when drop == true
     // end of the current epoch, batch_num should start from 0 again
     batch_num = 0;
     epoch_num++;
-    RETURN_IF_NOT_OK(
-      worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOE))));
+    cnt++;
+    RETURN_IF_NOT_OK(worker_queues_[NextWorker()]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOE))));
     RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, cnt - epoch_num)));
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   }  // end of eof_handled() == false
-  RETURN_IF_NOT_OK(
-    worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOF))));
-  // EOF received, send quit signal (an empty buffer) to all workers
+  RETURN_IF_NOT_OK(worker_queues_[NextWorker()]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOF))));
+  // EOF received, send quit signal (an empty buffer) to all workers, including the ones not getting work
   for (int32_t ind = 0; ind < num_workers_; ind++) {
-    RETURN_IF_NOT_OK(
-      worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kQuit))));
+    RETURN_IF_NOT_OK(worker_queues_[ind]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kQuit))));
   }
   return Status::OK();
 }
@@ -151,7 +152,7 @@ void BatchOp::Print(std::ostream &out, bool show_all) const {
 }
 
 Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
-                          dsize_t batch_size) {
+                          dsize_t batch_size, const TensorRow &batched_columns) {
   if ((*src)->size() != batch_size) {
     RETURN_STATUS_UNEXPECTED("[Internal Batch ERROR] Source table size does not match the batch_size");
   }
@@ -175,7 +176,9 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
     TensorShape new_shape = first_shape.PrependDim(static_cast<int64_t>(batch_size));
 
     std::shared_ptr<Tensor> new_tensor;
-    if (first_type.IsNumeric()) {  // numeric tensor
+    if (i < batched_columns.size() && batched_columns[i] != nullptr) {  // rows written into the batch upstream
+      new_tensor = batched_columns[i];
+    } else if (first_type.IsNumeric()) {  // numeric tensor
       RETURN_IF_NOT_OK(Tensor::CreateTensor(&new_tensor, TensorImpl::kFlexible, new_shape, first_type));
       dsize_t j = 0;
       for (auto row : **src) {
@@ -232,18 +235,41 @@ Status BatchOp::MakeBatchedBuffer(std::pair<std::unique_ptr<TensorQTable>, CBatc
   if (pad_) RETURN_IF_NOT_OK(PadColumns(&table_pair.first, pad_info_, column_name_id_map_));  // do padding if needed
   (*db) = std::make_unique<DataBuffer>(table_pair.second.batch_num_, DataBuffer::kDeBFlagNone);
   std::unique_ptr<TensorQTable> dest_table = std::make_unique<TensorQTable>();
-  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size()));
+  TensorRow batched_columns;
+  if (batch_slots_ != nullptr) {
+    batch_slots_->Take(table_pair.second.epoch_num_, table_pair.second.batch_num_, *table_pair.first, &batched_columns);
+  }
+  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size(), batched_columns));
   (*db)->set_tensor_table(std::move(dest_table));
   return Status::OK();
 }
 
 Status BatchOp::LaunchThreadsAndInitOp() {
   RETURN_UNEXPECTED_IF_NULL(tree_);
+  // The queues are created here rather than in the constructor, once the number of workers is final
+  worker_queues_.Init(num_workers_, oc_queue_size_);
   RETURN_IF_NOT_OK(worker_queues_.Register(tree_->AllTasks()));
   RETURN_IF_NOT_OK(tree_->LaunchWorkers(num_workers_, std::bind(&BatchOp::WorkerEntry, this, std::placeholders::_1)));
   return Status::OK();
 }
 
+Status BatchOp::PrepareNodePostAction() {
+  RETURN_IF_NOT_OK(ParallelOp::PrepareNodePostAction());
+  // The rows of a batch are known ahead only with a fixed batch size and nothing done to them before batching
+  bool fixed_batches = start_batch_size_ > 1 && !pad_ && pyfunc_column_names_.empty();
+#ifdef ENABLE_PYTHON
+  fixed_batches = fixed_batches && batch_size_func_ == nullptr;
+#endif
+  std::shared_ptr<MapOp> map_op = child_.empty() ? nullptr : std::dynamic_pointer_cast<MapOp>(child_[0]);
+  if (fixed_batches && map_op != nullptr) {
+    auto batch_slots = std::make_shared<BatchSlots>(start_batch_size_);
+    if (map_op->SetBatchSlots(batch_slots)) {
+      batch_slots_ = std::move(batch_slots);
+    }
+  }
+  return Status::OK();
+}
+
 Status BatchOp::EofReceived(int32_t) { return Status::OK(); }
 
 Status BatchOp::EoeReceived(int32_t) {
@@ -29,6 +29,7 @@
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
+#include "minddata/dataset/engine/datasetops/batch_slots.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/util/status.h"
 
@@ -173,6 +174,10 @@ class BatchOp : public ParallelOp {
   // @return Status - The error code return
   Status EoeReceived(int32_t) override;
 
+  // The master thread hands out the batches, so the number of active workers can change while the op runs.
+  // @return true
+  bool AllowsWorkerResize() const override { return true; }
+
   // A print method typically used for debugging
   // @param out - The output stream to write output to
   // @param show_all - A bool to control if you want to show all info or just a summary
@@ -192,6 +197,11 @@ class BatchOp : public ParallelOp {
   // @return Status - The error code return
   Status operator()() override;
 
+  // Base-class override for post-prepare actions. Batches of a fixed size over a MapOp are handed to the MapOp to
+  // write its rows into, see BatchSlots.
+  // @return Status - The error code return
+  Status PrepareNodePostAction() override;
+
   // Base-class override for NodePass visitor acceptor.
   // @param p - Pointer to the NodePass to be accepted.
   // @param modified - Whether this node visit modified the pipeline.
@@ -206,10 +216,10 @@ class BatchOp : public ParallelOp {
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
   // @param int32_t size - batch_size
-  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param const TensorRow &batched_columns - columns already batched, used as they are, nullptr for the others
   // @return Status - The error code return
   static Status BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
-                          dsize_t batch_size);
+                          dsize_t batch_size, const TensorRow &batched_columns = {});
 
   // @param table
   // @param const PadInfo &pad_info pad info
@@ -276,6 +286,7 @@ class BatchOp : public ParallelOp {
   PadInfo pad_info_;                               // column names to perform padding on
   std::unique_ptr<ChildIterator> child_iterator_;  // child iterator for fetching TensorRows 1 by 1
   QueueList<std::pair<std::unique_ptr<TensorQTable>, CBatchInfo>> worker_queues_;  // internal queue for syncing worker
+  std::shared_ptr<BatchSlots> batch_slots_;        // batch tensors the child MapOp writes the rows into, if any
 #ifdef ENABLE_PYTHON
   py::function batch_size_func_;  // Function pointer of batch size function
   py::function batch_map_func_;   // Function pointer of per batch map function
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/batch_slots.h"
+
+namespace mindspore {
+namespace dataset {
+Status BatchSlots::GetSlot(int64_t epoch_num, int64_t row_num, int32_t column, const TensorShape &shape,
+                           const DataType &type, std::shared_ptr<Tensor> *batch, dsize_t *slot) {
+  *batch = nullptr;
+  *slot = row_num % batch_size_;
+  if (!enabled_ || !shape.known() || !type.IsNumeric()) {
+    return Status::OK();
+  }
+  std::unique_lock<std::mutex> lock(mux_);
+  std::shared_ptr<Tensor> &tensor = batches_[std::make_pair(epoch_num, row_num / batch_size_)][column];
+  if (tensor == nullptr) {
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&tensor, TensorImpl::kFlexible, shape.PrependDim(batch_size_), type));
+    RETURN_IF_NOT_OK(tensor->AllocateBuffer(tensor->SizeInBytes()));
+  } else if (tensor->type() != type || tensor->shape() != shape.PrependDim(batch_size_)) {
+    // The rows differ in shape, BatchOp will report it if they are in the same batch
+    enabled_ = false;
+    return Status::OK();
+  }
+  *batch = tensor;
+  return Status::OK();
+}
+
+void BatchSlots::Take(int64_t epoch_num, int64_t batch_num, const TensorQTable &rows, TensorRow *batched_columns) {
+  std::map<int32_t, std::shared_ptr<Tensor>> columns;
+  {
+    std::unique_lock<std::mutex> lock(mux_);
+    auto itr = batches_.find(std::make_pair(epoch_num, batch_num));
+    if (itr == batches_.end()) {
+      return;
+    }
+    columns = std::move(itr->second);
+    (void)batches_.erase(itr);
+  }
+  if (rows.size() != static_cast<size_t>(batch_size_)) {
+    return;
+  }
+  for (const auto &pair : columns) {
+    auto column = static_cast<size_t>(pair.first);
+    if (column < rows.front().size() && Filled(pair.second, rows, column)) {
+      batched_columns->resize(rows.front().size());
+      (*batched_columns)[column] = pair.second;
+      num_taken_++;
+    }
+  }
+}
+
+void BatchSlots::Drop(int64_t epoch_num, int64_t batch_num) {
+  std::unique_lock<std::mutex> lock(mux_);
+  (void)batches_.erase(std::make_pair(epoch_num, batch_num));
+}
+
+bool BatchSlots::Filled(const std::shared_ptr<Tensor> &batch, const TensorQTable &rows, size_t column) {
+  dsize_t row_bytes = batch->SizeInBytes() / batch->shape()[0];
+  const unsigned char *start = batch->GetBuffer();
+  for (size_t r = 0; r < rows.size(); r++) {
+    const std::shared_ptr<Tensor> &tensor = rows[r].at(column);
+    if (tensor == nullptr || tensor->GetBuffer() != start + r * row_bytes || tensor->type() != batch->type() ||
+        tensor->shape().PrependDim(batch->shape()[0]) != batch->shape()) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_DATASETOPS_BATCH_SLOTS_H_
+#define DATASET_ENGINE_DATASETOPS_BATCH_SLOTS_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// The batch tensors of a BatchOp with a fixed batch size, allocated as soon as the first row of a batch is known, so
+// that the MapOp below it can write each row into its slot of the batch tensor rather than into a tensor of its own.
+// Rows are numbered from 0 in each epoch, in the order the BatchOp receives them, and the row n goes to the slot
+// n % batch_size of the batch n / batch_size. Once a row does not fit in the slot of its batch, the slots are
+// disabled and the BatchOp copies the rows as usual.
+class BatchSlots {
+ public:
+  // @param int32_t batch_size - number of rows of each batch, greater than 1
+  explicit BatchSlots(int32_t batch_size) : batch_size_(batch_size), enabled_(true) {}
+
+  ~BatchSlots() = default;
+
+  // Finds the slot of a row in the batch tensor of a column, creating the batch tensor for the first row of the batch.
+  // @param int64_t epoch_num - epoch of the row
+  // @param int64_t row_num - index of the row in the epoch
+  // @param int32_t column - index of the column in the rows
+  // @param const TensorShape &shape - shape of the tensor of the row
+  // @param const DataType &type - type of the tensor of the row, numeric
+  // @param std::shared_ptr<Tensor> *batch [out] - the batch tensor, or nullptr if the row has no slot
+  // @param dsize_t *slot [out] - index of the row in the batch tensor
+  // @return Status - The error code return
+  Status GetSlot(int64_t epoch_num, int64_t row_num, int32_t column, const TensorShape &shape, const DataType &type,
+                 std::shared_ptr<Tensor> *batch, dsize_t *slot);
+
+  // Removes the batch tensors of a batch, and gives back the ones every row of the batch has been written into.
+  // @param int64_t epoch_num - epoch of the batch
+  // @param int64_t batch_num - index of the batch in the epoch
+  // @param const TensorQTable &rows - rows of the batch
+  // @param TensorRow *batched_columns [out] - the batch tensor of each column, nullptr for the columns without one
+  void Take(int64_t epoch_num, int64_t batch_num, const TensorQTable &rows, TensorRow *batched_columns);
+
+  // Removes the batch tensors of a batch which will not be made, like a dropped remainder.
+  // @param int64_t epoch_num - epoch of the batch
+  // @param int64_t batch_num - index of the batch in the epoch
+  void Drop(int64_t epoch_num, int64_t batch_num);
+
+  // Stops handing out slots. The batches already started can still be taken.
+  void Disable() { enabled_ = false; }
+
+  bool enabled() const { return enabled_; }
+
+  // @return the number of batch tensors Take gave back, each one a column of a batch its rows were written into
+  int64_t num_taken() const { return num_taken_; }
+
+ private:
+  // @return true if every row holds a view of its slot of the batch tensor in the column
+  static bool Filled(const std::shared_ptr<Tensor> &batch, const TensorQTable &rows, size_t column);
+
+  const int32_t batch_size_;
+  std::atomic<bool> enabled_;
+  std::atomic<int64_t> num_taken_{0};
+  std::mutex mux_;
+  // batch tensor of each column, by epoch and batch
+  std::map<std::pair<int64_t, int64_t>, std::map<int32_t, std::shared_ptr<Tensor>>> batches_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_DATASETOPS_BATCH_SLOTS_H_
@@ -313,6 +313,16 @@ Status DatasetOp::PrepareNodePostAction() {
 // Getter function.  Base class does not have any special flags setting.
 uint32_t DatasetOp::PrepareFlags() const { return ExecutionTree::kDePrepNone; }
 
+// Change the capacity of each queue of the output connector while the tree runs
+Status DatasetOp::SetConnectorQueueCapacity(int32_t queue_capacity) {
+  if (inlined() || out_connector_ == nullptr) {
+    RETURN_STATUS_UNEXPECTED(Name() + " has no output connector to resize.");
+  }
+  RETURN_IF_NOT_OK(out_connector_->SetQueueCapacity(queue_capacity));
+  oc_queue_size_ = queue_capacity;
+  return Status::OK();
+}
+
 // Derived classes may implement the reset function if the operator is stateful and needs
 // specific reset handling that is not contained in this common code version of the reset.
 Status DatasetOp::Reset() {
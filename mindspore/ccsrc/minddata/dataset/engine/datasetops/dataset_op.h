@@ -243,6 +243,20 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return out_connector_ == nullptr ? int64_t(-1) : static_cast<int64_t>(out_connector_->out_buffers_count());
   }
 
+  /// \brief Counting number of epochs sent out by a connector
+  int64_t ConnectorOutEoeCount() const {
+    return out_connector_ == nullptr ? int64_t(-1) : out_connector_->out_eoe_count();
+  }
+
+  /// \brief Getter function
+  /// \return capacity of each queue of the output connector
+  int32_t ConnectorQueueCapacity() const { return oc_queue_size_; }
+
+  /// \brief Change the capacity of each queue of the output connector while the tree runs
+  /// \param[in] queue_capacity The new capacity, not less than the number of buffers in any queue
+  /// \return Status The error code return
+  Status SetConnectorQueueCapacity(int32_t queue_capacity);
+
   /// \brief Getter function
   /// \return connector size of current op
   int32_t ConnectorCapacity() const {
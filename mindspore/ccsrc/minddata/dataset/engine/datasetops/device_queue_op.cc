@@ -273,27 +273,76 @@ Status DeviceQueueOp::MallocForGPUData(std::vector<device::DataItemGpu> *items,
 Status DeviceQueueOp::SendDataToCPU() {
   MS_LOG(INFO) << "Device queue, sending data to CPU.";
   int64_t total_batch = 0;
+  bool is_break_loop = false;
+#ifdef ENABLE_CPUQUE
+  if (CpuBufferMgr::GetInstance().Open(channel_name_) != CpuQueueStatus::CPU_QUEUE_SUCCESS) {
+    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "open cpu queue failed");
+  }
+#endif
 
   std::unique_ptr<ChildIterator> child_iterator = std::make_unique<ChildIterator>(this, 0, 0);
-  while (!(child_iterator->eof_handled())) {
+  while (!(child_iterator->eof_handled()) && !is_break_loop) {
     TensorRow curr_row;
     RETURN_IF_NOT_OK(child_iterator->FetchNextTensorRow(&curr_row));
 
     if (!curr_row.empty()) {
+#ifdef ENABLE_CPUQUE
+      RETURN_IF_NOT_OK(RetryPushCPUData(curr_row, &is_break_loop));
+#else
       MS_LOG(DEBUG) << "Feature size is " << curr_row[0]->SizeInBytes() << ".";
-      MS_LOG(DEBUG) << "Label size is " << curr_row[1]->SizeInBytes() << ".";
+#endif
       total_batch++;
       if (num_batch_ > 0 && total_batch == num_batch_) {
-        break;
+        is_break_loop = true;
       }
     }
   }
 
+#ifdef ENABLE_CPUQUE
+  CpuBufferMgr::GetInstance().Close(channel_name_);
+#endif
   MS_LOG(INFO) << "Device queue total batch is " << total_batch << ", number of batches is " << num_batch_ << ".";
 
   return Status::OK();
 }
 
+#ifdef ENABLE_CPUQUE
+Status DeviceQueueOp::RetryPushCPUData(const TensorRow &curr_row, bool *is_break_loop) {
+  std::vector<device::DataItemCpu> items;
+  for (const auto &column : curr_row) {
+    CHECK_FAIL_RETURN_UNEXPECTED(column->type().IsNumeric(), "Cannot send tensor of string type to device.");
+    device::DataItemCpu data_item;
+    // The session only reads its inputs, so the batch is handed over as it is
+    data_item.data_ptr_ = const_cast<unsigned char *>(column->GetBuffer());
+    data_item.data_len_ = static_cast<size_t>(column->SizeInBytes());
+    for (auto dim : column->shape().AsVector()) {
+      data_item.shape_.push_back(static_cast<int>(dim));
+    }
+    data_item.holder_ = column;
+    items.push_back(std::move(data_item));
+  }
+
+  // items are only moved from once they are queued, so a timed out push can be retried with them
+  while (!TaskManager::FindMe()->Interrupted()) {
+    CpuQueueStatus ret = CpuBufferMgr::GetInstance().Push(channel_name_, std::move(items), WAIT_TIME * 1000);
+    if (ret == CpuQueueStatus::CPU_QUEUE_SUCCESS) {
+      return Status::OK();
+    } else if (ret == CpuQueueStatus::CPU_QUEUE_TIMEOUT) {
+      MS_LOG(DEBUG) << "Cpu queue is full, retry pushing data...";
+      continue;
+    } else if (ret == CpuQueueStatus::CPU_QUEUE_CLOSED) {
+      // the consumer has stopped, there is nobody left to send to
+      MS_LOG(INFO) << "Cpu queue " << channel_name_ << " is closed by the consumer.";
+      break;
+    } else {
+      return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "cpu queue " + channel_name_ + " not exist.");
+    }
+  }
+  *is_break_loop = true;
+  return Status::OK();
+}
+#endif
+
 void DeviceQueueOp::Print(std::ostream &out, bool show_all) const {
   // Always show the id and name as first line regardless if this summary or detailed print
   out << "(" << std::setw(2) << operator_id_ << ") <DeviceQueueOp>:";
@@ -27,6 +27,12 @@
 #include "minddata/dataset/engine/tdt/tdt_plugin.h"
 #endif
 
+#ifdef ENABLE_CPUQUE
+#include "runtime/device/cpu/cpu_buffer_mgr.h"
+using mindspore::device::CpuBufferMgr;
+using mindspore::device::CpuQueueStatus;
+#endif
+
 #ifdef ENABLE_GPUQUE
 #include "runtime/device/gpu/gpu_buffer_mgr.h"
 using mindspore::device::BlockQueueStatus_T;
@@ -160,6 +166,10 @@ class DeviceQueueOp : public PipelineOp {
 #endif
 
   Status SendDataToCPU();
+#ifdef ENABLE_CPUQUE
+  // Push one batch to the cpu channel, sharing the tensor buffers of the row instead of copying them
+  Status RetryPushCPUData(const TensorRow &curr_row, bool *is_break_loop);
+#endif
   std::string channel_name_;
   DeviceType device_type_;
   const int32_t device_id_;
@@ -17,7 +17,9 @@
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 #include "minddata/dataset/core/config_manager.h"
 
@@ -28,6 +30,7 @@
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/kernels/data/data_utils.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "utils/log_adapter.h"
 #include "minddata/dataset/util/task_manager.h"
@@ -125,16 +128,22 @@ Status MapOp::operator()() {
   RETURN_IF_NOT_OK(rc);
 
   if (perf_mode_) {
-    int64_t que_id = 0;
     std::unique_ptr<DataBuffer> buff;
     bool is_eof = false;
+    BufferPosition position = {0, 0};
     // Draining output connector of the previous op and distribute it to local queues.
     // Stop when all worker threads are finished (received EOF).
     while (!is_eof) {
       RETURN_IF_NOT_OK(child_[0]->GetNextBuffer(&buff, 0));
       is_eof = buff->eof();
-      RETURN_IF_NOT_OK(local_queues_[que_id]->Add(std::move(buff)));
-      que_id = (que_id + 1) % num_workers_;
+      BufferPosition next = position;
+      if (buff->eoe()) {
+        next = {position.epoch_num + 1, 0};
+      } else if (!is_eof) {
+        next.first_row += buff->NumRows();
+      }
+      RETURN_IF_NOT_OK(local_queues_[NextWorker()]->Add(std::make_pair(std::move(buff), position)));
+      position = next;
     }
   }
 
@@ -149,11 +158,12 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
   // Handshake with TaskManager that thread creation is successful.
   TaskManager::FindMe()->Post();
   std::unique_ptr<DataBuffer> in_buffer;
+  BufferPosition position = {0, 0};
 
   // Getting a databuffer to work on.
   // Perform the first fetch here outside of the loop.  This allows us to execute one-time only
   // initializations that happen after the first fetch.
-  RETURN_IF_NOT_OK(FetchNextBuffer(&in_buffer, worker_id));
+  RETURN_IF_NOT_OK(FetchNextBuffer(&in_buffer, worker_id, &position));
 
   // Sanity check the databuffer.
   // Special case: if there's more threads than buffers, some threads simply get the final control
@@ -175,7 +185,7 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
     if (in_buffer->eoe()) {
       // Calling base class EoeReceived to forward eoe buffer.
       RETURN_IF_NOT_OK(EoeReceived(worker_id));
-      RETURN_IF_NOT_OK(FetchNextBuffer(&in_buffer, worker_id));
+      RETURN_IF_NOT_OK(FetchNextBuffer(&in_buffer, worker_id, &position));
       continue;
     } else if (in_buffer->eof()) {
       // Calling base class EofReceived to forward eof buffer.
@@ -185,7 +195,7 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
 
     std::unique_ptr<TensorQTable> new_tensor_table(std::make_unique<TensorQTable>());
     // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
-    RETURN_IF_NOT_OK(WorkerCompute(in_buffer.get(), new_tensor_table.get()));
+    RETURN_IF_NOT_OK(WorkerCompute(in_buffer.get(), position, new_tensor_table.get()));
 
     // Replace the TensorTable in DataBuffer with the new one.
     in_buffer->set_tensor_table(std::move(new_tensor_table));
@@ -194,44 +204,68 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
     RETURN_IF_NOT_OK(out_connector_->Add(static_cast<int>(worker_id), std::move(in_buffer)));
 
     // Fetch the next buffer and loop back to the top.
-    RETURN_IF_NOT_OK(FetchNextBuffer(&in_buffer, worker_id));
+    RETURN_IF_NOT_OK(FetchNextBuffer(&in_buffer, worker_id, &position));
   }
 
   return Status::OK();
 }
 
-Status MapOp::WorkerCompute(DataBuffer *in_buffer, TensorQTable *new_tensor_table) {
+Status MapOp::WorkerCompute(DataBuffer *in_buffer, const BufferPosition &position, TensorQTable *new_tensor_table) {
   // Getting number of rows and cols in this buffer.
   int32_t num_rows = in_buffer->NumRows();
   int32_t num_cols = in_buffer->NumCols();
 
+  // original_table  : The rows of the DataBuffer, holding all the columns.
+  // job_input_table : The rows holding only the cols in input_columns, to be processed by the TensorOps.
+  std::vector<TensorRow> original_table, job_input_table;
   for (int32_t r = 0; r < num_rows; r++) {
-    // to_process   : A vector of Tensors only holding cols in input_columns.
-    // result_row;  : A vector of Tensors to hold the result after Compute().
-    // cur_row      : A vector of Tensors holding all the columns from DataBuffer.
-    TensorRow to_process, result_row, cur_row;
+    TensorRow to_process, cur_row;
     RETURN_IF_NOT_OK(in_buffer->PopRow(&cur_row));
 
     // Populate the Tensor from the current row to be processed by TensorOp
     for (const auto &idx : to_process_indices_) {
       to_process.push_back(std::move(cur_row[idx]));
     }
+    original_table.push_back(std::move(cur_row));
+    job_input_table.push_back(std::move(to_process));
+  }
 
-    // Looping over multiple TensorOps supplied in to MapOp.
-    // The assumption is that the result of one TensorOp matches the required input to the next TensorOp.
-    for (size_t i = 0; i < tfuncs_.size(); i++) {
-      // TensorOp can operate on single col or multiple cols. MapOp always call compute for multiple cols.
-      // TensorOp base class will call the single column Compute() depending on the ops.
-      // Note: The columns of the result_row is not preallocated, the compute function of each tensor op are
-      // required to resize/push back the result_row
-      RETURN_IF_NOT_OK(tfuncs_[i]->Compute(to_process, &result_row));
-
-      // Assign result_row to to_process for the next TensorOp processing, except for the last TensorOp in the list.
-      if (i + 1 < tfuncs_.size()) {
-        to_process = std::move(result_row);
+  std::vector<TensorRow> result_table;
+  if (CanComputeBatch(job_input_table)) {
+    RETURN_IF_NOT_OK(ComputeBatch(job_input_table, &result_table));
+  } else {
+    result_table.resize(num_rows);
+    for (int32_t r = 0; r < num_rows; r++) {
+      // to_process   : A vector of Tensors only holding cols in input_columns.
+      // result_row;  : A vector of Tensors to hold the result after Compute().
+      TensorRow to_process = std::move(job_input_table[r]);
+      TensorRow &result_row = result_table[r];
+
+      // Looping over multiple TensorOps supplied in to MapOp.
+      // The assumption is that the result of one TensorOp matches the required input to the next TensorOp.
+      for (size_t i = 0; i < tfuncs_.size(); i++) {
+        // TensorOp can operate on single col or multiple cols. MapOp always call compute for multiple cols.
+        // TensorOp base class will call the single column Compute() depending on the ops.
+        // Note: The columns of the result_row is not preallocated, the compute function of each tensor op are
+        // required to resize/push back the result_row
+        if (i + 1 == tfuncs_.size() && batch_slots_ != nullptr && batch_slots_->enabled()) {
+          RETURN_IF_NOT_OK(ComputeIntoSlots(tfuncs_[i], to_process, position.epoch_num, position.first_row + r,
+                                            &result_row));
+        } else {
+          RETURN_IF_NOT_OK(tfuncs_[i]->Compute(to_process, &result_row));
+        }
+
+        // Assign result_row to to_process for the next TensorOp processing, except for the last TensorOp in the list.
+        if (i + 1 < tfuncs_.size()) {
+          to_process = std::move(result_row);
+        }
       }
     }
+  }
 
+  for (int32_t r = 0; r < num_rows; r++) {
+    TensorRow &cur_row = original_table[r];
+    TensorRow &result_row = result_table[r];
     if (out_columns_.size() != result_row.size()) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "Result of a tensorOp doesn't match output column names");
@@ -258,6 +292,152 @@ Status MapOp::WorkerCompute(DataBuffer *in_buffer, TensorQTable *new_tensor_tabl
   return Status::OK();
 }
 
+bool MapOp::CanComputeBatch(const std::vector<TensorRow> &job_input_table) const {
+  // A single row gains nothing from the stacking copies
+  if (job_input_table.size() < 2 || tfuncs_.empty()) {
+    return false;
+  }
+  for (const auto &tfunc : tfuncs_) {
+    if (!tfunc->SupportsBatch()) {
+      return false;
+    }
+  }
+  const TensorRow &first_row = job_input_table[0];
+  for (const auto &tensor : first_row) {
+    if (tensor == nullptr || !tensor->type().IsNumeric() || !tensor->shape().known() || !tensor->HasData()) {
+      return false;
+    }
+  }
+  for (const auto &row : job_input_table) {
+    if (row.size() != first_row.size()) {
+      return false;
+    }
+    for (size_t c = 0; c < row.size(); c++) {
+      if (row[c] == nullptr || row[c]->shape() != first_row[c]->shape() || row[c]->type() != first_row[c]->type() ||
+          !row[c]->HasData()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+Status MapOp::ComputeBatch(const std::vector<TensorRow> &job_input_table, std::vector<TensorRow> *result_table) {
+  size_t num_rows = job_input_table.size();
+  // Stack each column of the rows into a single tensor
+  TensorRow to_process, result;
+  for (size_t c = 0; c < job_input_table[0].size(); c++) {
+    std::vector<std::shared_ptr<Tensor>> column;
+    for (const auto &row : job_input_table) {
+      column.push_back(row[c]);
+    }
+    std::shared_ptr<Tensor> stacked;
+    RETURN_IF_NOT_OK(StackTensors(column, &stacked));
+    to_process.push_back(std::move(stacked));
+  }
+
+  for (size_t i = 0; i < tfuncs_.size(); i++) {
+    RETURN_IF_NOT_OK(tfuncs_[i]->ComputeBatch(to_process, &result));
+    if (i + 1 < tfuncs_.size()) {
+      to_process = std::move(result);
+    }
+  }
+
+  // Split the stacked results back into rows
+  result_table->clear();
+  result_table->resize(num_rows);
+  for (const auto &stacked : result) {
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      stacked != nullptr && stacked->Rank() > 0 && stacked->shape()[0] == static_cast<dsize_t>(num_rows),
+      "Result of a tensorOp on a batch doesn't match the number of rows");
+    std::vector<std::shared_ptr<Tensor>> tensors;
+    RETURN_IF_NOT_OK(UnstackTensor(stacked, &tensors));
+    for (size_t r = 0; r < num_rows; r++) {
+      (*result_table)[r].push_back(std::move(tensors[r]));
+    }
+  }
+  return Status::OK();
+}
+
+bool MapOp::SetBatchSlots(std::shared_ptr<BatchSlots> batch_slots) {
+  if (!perf_mode_ || tfuncs_.empty() || column_name_id_map_.empty()) {
+    return false;
+  }
+  out_column_indices_.clear();
+  for (const auto &col_name : out_columns_) {
+    auto itr = column_name_id_map_.find(col_name);
+    if (itr == column_name_id_map_.end()) {
+      return false;
+    }
+    out_column_indices_.push_back(itr->second);
+  }
+  batch_slots_ = std::move(batch_slots);
+  return true;
+}
+
+Status MapOp::ComputeIntoSlots(const std::shared_ptr<TensorOp> &tfunc, const TensorRow &input, int64_t epoch_num,
+                               int64_t row_num, TensorRow *output) {
+  std::vector<TensorShape> in_shapes, out_shapes;
+  std::vector<DataType> in_types, out_types;
+  for (const auto &tensor : input) {
+    in_shapes.push_back(tensor->shape());
+    in_types.push_back(tensor->type());
+  }
+  // Without the shapes of the output ahead there is nothing to place
+  if (tfunc->OutputShape(in_shapes, out_shapes).IsError() || tfunc->OutputType(in_types, out_types).IsError() ||
+      out_shapes.size() != out_column_indices_.size() || out_types.size() != out_shapes.size()) {
+    return tfunc->Compute(input, output);
+  }
+  std::vector<std::shared_ptr<Tensor>> batches(out_shapes.size());
+  std::vector<dsize_t> slots(out_shapes.size(), 0);
+  for (size_t c = 0; c < out_shapes.size(); c++) {
+    RETURN_IF_NOT_OK(batch_slots_->GetSlot(epoch_num, row_num, out_column_indices_[c], out_shapes[c], out_types[c],
+                                           &batches[c], &slots[c]));
+  }
+  {
+    // The tensors allocated by the op while the placements live get their memory from the slots, by size. Columns
+    // of the same size could swap slots, so those are copied rather than placed.
+    std::vector<dsize_t> sizes(batches.size(), 0);
+    std::map<dsize_t, size_t> num_columns_of_size;
+    for (size_t c = 0; c < batches.size(); c++) {
+      if (batches[c] != nullptr) {
+        sizes[c] = out_shapes[c].NumOfElements() * out_types[c].SizeInBytes();
+        num_columns_of_size[sizes[c]]++;
+      }
+    }
+    std::vector<std::unique_ptr<Tensor::Placement>> placements;
+    for (size_t c = 0; c < batches.size(); c++) {
+      if (batches[c] != nullptr && num_columns_of_size[sizes[c]] == 1) {
+        placements.push_back(std::make_unique<Tensor::Placement>(batches[c], slots[c]));
+      }
+    }
+    RETURN_IF_NOT_OK(tfunc->Compute(input, output));
+  }
+  if (output->size() != batches.size()) {
+    batch_slots_->Disable();
+    return Status::OK();
+  }
+  for (size_t c = 0; c < batches.size(); c++) {
+    if (batches[c] == nullptr) {
+      continue;
+    }
+    std::shared_ptr<Tensor> &tensor = (*output)[c];
+    if (tensor == nullptr || tensor->shape() != out_shapes[c] || tensor->type() != out_types[c]) {
+      // The op did not output what it told, so the batch will be assembled by copying
+      batch_slots_->Disable();
+      continue;
+    }
+    std::shared_ptr<Tensor> view;
+    RETURN_IF_NOT_OK(Tensor::CreateRowView(&view, batches[c], slots[c]));
+    if (tensor->GetBuffer() != view->GetBuffer()) {
+      // Allocated before the op ran, or in memory of another library
+      RETURN_IF_NOT_OK(batches[c]->InsertTensor({slots[c]}, tensor));
+    }
+    tensor = std::move(view);
+  }
+  return Status::OK();
+}
+
 Status MapOp::ComputeColMap() {
   // If the map has not been set up yet in the base class, then set it up
   if (column_name_id_map_.empty()) {
@@ -21,6 +21,7 @@
 #include <unordered_map>
 #include <utility>
 #include <vector>
+#include "minddata/dataset/engine/datasetops/batch_slots.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/util/queue.h"
@@ -171,6 +172,10 @@ class MapOp : public ParallelOp {
   // @return the number of threads consuming data from previous op's output Connector.
   int32_t num_consumers() const override;
 
+  // The workers can be resized in Performance Mode, where the master thread hands out the buffers.
+  // @return true if the number of active workers can change while the op runs
+  bool AllowsWorkerResize() const override { return perf_mode_; }
+
   // Base-class override for NodePass visitor acceptor.
   // @param p - Pointer to the NodePass to be accepted.
   // @param modified - Whether this node visit modified the pipeline.
@@ -188,11 +193,27 @@ class MapOp : public ParallelOp {
 
   const auto &TFuncs() const { return tfuncs_; }
 
+  // Have the last TensorOp write the output columns straight into the batch tensors of the BatchOp above, when it
+  // can tell the shapes of its output ahead. Only in Performance Mode, where the master thread numbers the rows.
+  // Called once the column name map is set, before the op runs.
+  // @param batch_slots The batch tensors of the BatchOp
+  // @return true if the slots are used
+  bool SetBatchSlots(std::shared_ptr<BatchSlots> batch_slots);
+
+  // @return the batch tensors the output is written into, nullptr if there are none
+  const std::shared_ptr<BatchSlots> &batch_slots() const { return batch_slots_; }
+
  private:
+  // Where the rows of a buffer are in the epoch.
+  struct BufferPosition {
+    int64_t epoch_num;
+    int64_t first_row;
+  };
+
   // Local queues where worker threads can pop from.
   // Popping directly from the Connector can block if the previous designated threads haven't pop.
   // Setting the size of these queues to 0 is essentially the same as pulling directly from Connector.
-  QueueList<std::unique_ptr<DataBuffer>> local_queues_;
+  QueueList<std::pair<std::unique_ptr<DataBuffer>, BufferPosition>> local_queues_;
 
   // Static variables to be ready by worker threads, no modification and readonly
   std::vector<std::shared_ptr<TensorOp>> tfuncs_;
@@ -216,6 +237,12 @@ class MapOp : public ParallelOp {
   // cause additional blocking because pop calls to Connector from the threads are synchronized to enforce the order.
   bool perf_mode_;
 
+  // The batch tensors of the BatchOp above, if the output is written into them.
+  std::shared_ptr<BatchSlots> batch_slots_;
+
+  // Indices of the output columns in the final rows.
+  std::vector<int32_t> out_column_indices_;
+
   // Private function for worker/thread to loop continuously. It comprises the main
   // logic of MapOp: getting the data from previous Op, validating user specified column names,
   // applying a list of TensorOps to each of the data, process the results and then
@@ -228,10 +255,14 @@ class MapOp : public ParallelOp {
   // When PerformanceMode is enabled, workers pop from the local queue.
   // Otherwise, workers pop from the first child output Connector.
   // @param p_buffer - the buffer to return
+  // @param position - where the rows of the buffer are, known in Performance Mode only
   // @return Status return code
-  Status FetchNextBuffer(std::unique_ptr<DataBuffer> *p_buffer, int32_t worker_id) {
+  Status FetchNextBuffer(std::unique_ptr<DataBuffer> *p_buffer, int32_t worker_id, BufferPosition *position) {
     if (perf_mode_) {
-      RETURN_IF_NOT_OK(local_queues_[worker_id]->PopFront(p_buffer));
+      std::pair<std::unique_ptr<DataBuffer>, BufferPosition> job;
+      RETURN_IF_NOT_OK(local_queues_[worker_id]->PopFront(&job));
+      *p_buffer = std::move(job.first);
+      *position = job.second;
     } else {
       RETURN_IF_NOT_OK(child_[0]->GetNextBuffer(p_buffer, worker_id));
     }
@@ -241,8 +272,31 @@ class MapOp : public ParallelOp {
   // Private function for worker thread to perform TensorOp's compute function and get the result.
   // @param in_buffer A raw pointer to the DataBuffer. A raw pointer is fine because this function doesn't manage memory
   //     and is not shared with other threads.
+  // @param position Where the rows of the buffer are.
   // @param[out] new_tensor_table A new Tensor Table to be populated in this function.
-  Status WorkerCompute(DataBuffer *in_buffer, TensorQTable *new_tensor_table);
+  Status WorkerCompute(DataBuffer *in_buffer, const BufferPosition &position, TensorQTable *new_tensor_table);
+
+  // Private function to run the last TensorOp on a row with its output placed in the batch slots of the row. The
+  // output columns which did not land in their slots are copied there, and replaced by views of the slots.
+  // @param tfunc The last TensorOp.
+  // @param input The input columns.
+  // @param epoch_num, row_num Where the row is.
+  // @param[out] output The output columns.
+  // @return Status The error code return
+  Status ComputeIntoSlots(const std::shared_ptr<TensorOp> &tfunc, const TensorRow &input, int64_t epoch_num,
+                          int64_t row_num, TensorRow *output);
+
+  // Private function to tell if the columns of a buffer can go through the TensorOps stacked, which needs every
+  // TensorOp to support it and every row to hold numeric tensors of the same shapes and types.
+  // @param job_input_table The columns to process of each row.
+  // @return true if ComputeBatch() can be used on the buffer
+  bool CanComputeBatch(const std::vector<TensorRow> &job_input_table) const;
+
+  // Private function to apply the TensorOps to all the rows of a buffer at once through TensorOp::ComputeBatch().
+  // @param job_input_table The columns to process of each row.
+  // @param[out] result_table The output columns of each row.
+  // @return Status The error code return
+  Status ComputeBatch(const std::vector<TensorRow> &job_input_table, std::vector<TensorRow> *result_table);
 
   // Private function that create the final column name to index mapping and
   // get indices of the columns this mapop does not use.
@@ -31,7 +31,11 @@ ParallelOp::ParallelOp(int32_t num_workers, int32_t op_connector_size, std::shar
       num_workers_(num_workers),
       num_producers_(num_workers),
       worker_connector_size_(1),
-      worker_connector_(nullptr) {}
+      worker_connector_(nullptr),
+      target_active_workers_(num_workers),
+      active_workers_(num_workers),
+      next_worker_(0),
+      num_handed_out_(0) {}
 
 // Creates the internal worker connector for the parallel op if the derived class wants to use it
 Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size) {
@@ -48,6 +52,48 @@ Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size) {
   return Status::OK();
 }
 
+// Launch a pool of workers larger than the number of workers getting work
+Status ParallelOp::ReserveWorkers(int32_t pool_size) {
+  if (!AllowsWorkerResize()) {
+    RETURN_STATUS_UNEXPECTED(Name() + " cannot change its number of workers.");
+  }
+  if (out_connector_ != nullptr || pool_size < num_workers_) {
+    RETURN_STATUS_UNEXPECTED("Cannot reserve " + std::to_string(pool_size) + " workers for " + Name() + ".");
+  }
+  // The output connector starts popping from all the workers, the first call to NextWorker narrows it down
+  target_active_workers_ = num_workers_;
+  active_workers_ = pool_size;
+  num_workers_ = pool_size;
+  num_producers_ = pool_size;
+  return Status::OK();
+}
+
+// Change the number of workers getting work
+Status ParallelOp::SetNumActiveWorkers(int32_t num_active_workers) {
+  if (!AllowsWorkerResize() || num_active_workers < 1 || num_active_workers > num_workers_) {
+    RETURN_STATUS_UNEXPECTED("Cannot set " + std::to_string(num_active_workers) + " active workers for " + Name() +
+                             ".");
+  }
+  target_active_workers_ = num_active_workers;
+  return Status::OK();
+}
+
+// Round robin over the active workers
+int32_t ParallelOp::NextWorker() {
+  if (next_worker_ == 0) {
+    int32_t target = target_active_workers_;
+    if (target != active_workers_) {
+      // The elements from here on come from the first target queues of the output connector
+      out_connector_->ScheduleActiveProducers(num_handed_out_, target);
+      active_workers_ = target;
+    }
+  }
+  int32_t worker_id = next_worker_;
+  next_worker_ = (next_worker_ + 1) % active_workers_;
+  num_handed_out_++;
+  return worker_id;
+}
+
 // A print method typically used for debugging
 void ParallelOp::Print(std::ostream &out, bool show_all) const {
   // Summary 1-liner print
@@ -59,6 +105,9 @@ void ParallelOp::Print(std::ostream &out, bool show_all) const {
     // Detailed print
     DatasetOp::Print(out, show_all);
     out << "\nNum workers: " << num_workers_;
+    if (target_active_workers_ != num_workers_) {
+      out << "\nNum active workers: " << target_active_workers_;
+    }
   }
 }
 
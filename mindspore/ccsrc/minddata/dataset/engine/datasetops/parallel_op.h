@@ -16,6 +16,7 @@
 #ifndef DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 #define DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include "minddata/dataset/core/constants.h"
@@ -109,16 +110,47 @@ class ParallelOp : public DatasetOp {
   // @return Status
   Status RegisterWorkerConnectors() override;
 
+  // Whether the number of workers doing the work can change while the op runs, see SetNumActiveWorkers.
+  // @return true if the op hands its work out to its workers with NextWorker
+  virtual bool AllowsWorkerResize() const { return false; }
+
+  // Launch a pool of pool_size workers instead of num_workers, of which only num_workers get work at first.
+  // Must be called before the connectors of the op are created, when AllowsWorkerResize is true.
+  // @param pool_size - The number of workers to launch, not less than num_workers
+  // @return Status - The error code return
+  Status ReserveWorkers(int32_t pool_size);
+
+  // Change the number of workers getting work, from the start of the next round robin.
+  // @param num_active_workers - Between 1 and the number of launched workers
+  // @return Status - The error code return
+  Status SetNumActiveWorkers(int32_t num_active_workers);
+
+  // Getter
+  // @return the number of workers getting work, as last set
+  int32_t num_active_workers() const { return target_active_workers_; }
+
  protected:
   // Interface for derived classes to implement. All derived classes must provide the entry
   // function with the main execution loop for worker threads.
   // @return Status - The error code return
   virtual Status WorkerEntry(int32_t workerId) = 0;
 
+  // Round robin over the active workers, for ops handing out their work from a single master thread, when each
+  // piece of work makes one element of the output connector. A change of SetNumActiveWorkers is applied here, at
+  // the start of a round, and scheduled on the output connector so the elements are still popped in order.
+  // @return the id of the worker to give the next piece of work to
+  int32_t NextWorker();
+
   int32_t num_workers_;    // The number of worker threads
   int32_t num_producers_;  // The number of threads pushing to the out_connector_
   int32_t worker_connector_size_;
   std::unique_ptr<DbConnector> worker_connector_;  // The internal connector for worker threads
+
+ private:
+  std::atomic<int32_t> target_active_workers_;  // The number of workers set by SetNumActiveWorkers
+  int32_t active_workers_;                      // The number of workers in the current round of NextWorker
+  int32_t next_worker_;
+  int64_t num_handed_out_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -23,7 +23,9 @@
 #include <iostream>
 #include <limits>
 #include <random>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
@@ -31,7 +33,10 @@
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/util/path.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/services.h"
+#include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/status.h"
 
 #include "utils/log_adapter.h"
@@ -43,7 +48,7 @@ constexpr int32_t ShuffleOp::kShuffleStateActive;
 constexpr int32_t ShuffleOp::kShuffleStateDrain;
 
 // Builder constructor. Creates the builder object.
-ShuffleOp::Builder::Builder() : build_shuffle_size_(0), build_reshuffle_each_epoch_(true) {
+ShuffleOp::Builder::Builder() : build_shuffle_size_(0), build_reshuffle_each_epoch_(true), build_memory_limit_(0) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   build_op_connector_size_ = cfg->op_connector_size();
   build_rows_per_buffer_ = cfg->rows_per_buffer();
@@ -54,6 +59,9 @@ Status ShuffleOp::Builder::SanityCheck() const {
   if (build_shuffle_size_ < 2) {
     RETURN_STATUS_UNEXPECTED("Shuffle buffer size must be greater than 1.");
   }
+  if (build_memory_limit_ < 0) {
+    RETURN_STATUS_UNEXPECTED("Shuffle memory limit must not be negative.");
+  }
   return Status::OK();
 }
 
@@ -61,13 +69,14 @@ Status ShuffleOp::Builder::SanityCheck() const {
 Status ShuffleOp::Builder::Build(std::shared_ptr<ShuffleOp> *ptr) {
   RETURN_IF_NOT_OK(SanityCheck());
   *ptr = std::make_shared<ShuffleOp>(build_shuffle_size_, build_shuffle_seed_, build_op_connector_size_,
-                                     build_reshuffle_each_epoch_, build_rows_per_buffer_);
+                                     build_reshuffle_each_epoch_, build_rows_per_buffer_, build_memory_limit_,
+                                     build_spill_dir_);
   return Status::OK();
 }
 
 // Constructor of the ShuffleOp
 ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
-                     int32_t rows_per_buffer)
+                     int32_t rows_per_buffer, int32_t memory_limit, const std::string &spill_dir)
     : PipelineOp(op_connector_size),
       shuffle_size_(shuffle_size),
       shuffle_seed_(shuffle_seed),
@@ -77,7 +86,14 @@ ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_con
       rows_per_buffer_(rows_per_buffer),
       shuffle_buffer_(std::make_unique<TensorTable>()),
       shuffle_last_row_idx_(0),
-      shuffle_buffer_state_(kShuffleStateInit) {}
+      shuffle_buffer_state_(kShuffleStateInit),
+      memory_limit_(memory_limit),
+      spill_dir_(spill_dir),
+      arena_(nullptr),
+      spill_storage_(nullptr),
+      spill_folder_(Services::GetUniqueID()) {}
+
+ShuffleOp::~ShuffleOp() { (void)CloseSpillStorage(); }
 
 // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
 // itself rather than waiting for the reset driven from operators above it in the pipeline.
@@ -92,6 +108,9 @@ Status ShuffleOp::SelfReset() {
   }
 
   shuffle_buffer_ = std::make_unique<TensorTable>();
+  // The spill storage cannot release single rows, so its files are dropped once the epoch is drained.
+  handle_buffer_.clear();
+  RETURN_IF_NOT_OK(CloseSpillStorage());
   buffer_counter_ = 0;
   shuffle_last_row_idx_ = 0;
   shuffle_buffer_state_ = kShuffleStateInit;
@@ -112,7 +131,11 @@ void ShuffleOp::Print(std::ostream &out, bool show_all) const {
     PipelineOp::Print(out, show_all);
     // Then show any custom derived-internal stuff
     out << "\nShuffle size: " << shuffle_size_ << "\nRows per buffer: " << rows_per_buffer_
-        << "\nShuffle buffer state: " << shuffle_buffer_state_ << "\nShuffle seed: " << shuffle_seed_ << "\n\n";
+        << "\nShuffle buffer state: " << shuffle_buffer_state_ << "\nShuffle seed: " << shuffle_seed_;
+    if (memory_limit_ > 0) {
+      out << "\nMemory limit (MB): " << memory_limit_ << "\nSpill directory: " << spill_dir_;
+    }
+    out << "\n\n";
   }
 }
 
@@ -124,19 +147,219 @@ Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
   // If we are already at the full size, then we overwrite the last slot with our row (and the last
   // slot better be empty because it should already have been swapped out during the random row
   // selection that was done previously!)
+  // With a memory limit the same is done with the handle of the row instead of the row.
   if (shuffle_last_row_idx_ < (shuffle_size_ - 1)) {
-    shuffle_buffer_->push_back(std::move(new_shuffle_row));
-    shuffle_last_row_idx_ = (shuffle_buffer_->size()) - 1;
+    if (memory_limit_ > 0) {
+      RowHandle handle;
+      RETURN_IF_NOT_OK(StoreRow(new_shuffle_row, &handle));
+      handle_buffer_.push_back(handle);
+    } else {
+      shuffle_buffer_->push_back(std::move(new_shuffle_row));
+    }
+    shuffle_last_row_idx_ = ShuffleBufferSize() - 1;
   } else {
-    if (!(*shuffle_buffer_)[shuffle_last_row_idx_].empty()) {
+    bool occupied = memory_limit_ > 0 ? handle_buffer_[shuffle_last_row_idx_].size != 0
+                                      : !(*shuffle_buffer_)[shuffle_last_row_idx_].empty();
+    if (occupied) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "Last row of shuffle buffer should not be occupied!");
     }
-    (*shuffle_buffer_)[shuffle_last_row_idx_] = std::move(new_shuffle_row);
+    if (memory_limit_ > 0) {
+      RETURN_IF_NOT_OK(StoreRow(new_shuffle_row, &handle_buffer_[shuffle_last_row_idx_]));
+    } else {
+      (*shuffle_buffer_)[shuffle_last_row_idx_] = std::move(new_shuffle_row);
+    }
+  }
+  return Status::OK();
+}
+
+size_t ShuffleOp::ShuffleBufferSize() const {
+  return memory_limit_ > 0 ? handle_buffer_.size() : shuffle_buffer_->size();
+}
+
+Status ShuffleOp::TakeRow(int64_t slot, TensorRow *row) {
+  if (memory_limit_ > 0) {
+    return LoadRow(&handle_buffer_[slot], row);
+  }
+  *row = std::move((*shuffle_buffer_)[slot]);
+  return Status::OK();
+}
+
+void ShuffleOp::MoveRow(int64_t dest, int64_t src) {
+  if (memory_limit_ > 0) {
+    handle_buffer_[dest] = handle_buffer_[src];
+    handle_buffer_[src] = RowHandle();
+  } else {
+    (*shuffle_buffer_)[dest] = std::move((*shuffle_buffer_)[src]);
+  }
+}
+
+namespace {
+// Rebuild a column of a stored row. A string tensor holds the offsets of its strings followed by the null terminated
+// strings. It is rebuilt from the strings, which checks the offsets and gives the tensor the end of its data.
+Status RestoreTensor(const TensorShape &shape, const DataType &type, const unsigned char *data, int64_t num_bytes,
+                     std::shared_ptr<Tensor> *out) {
+  if (type != DataType::DE_STRING) {
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(out, TensorImpl::kFlexible, shape, type, num_bytes > 0 ? data : nullptr));
+    CHECK_FAIL_RETURN_UNEXPECTED(num_bytes == 0 || (*out)->SizeInBytes() == num_bytes,
+                                 "Shuffle buffer row is corrupted.");
+    return Status::OK();
+  }
+  dsize_t num_strings = shape.NumOfElements();
+  int64_t offsets_bytes = (num_strings + 1) * static_cast<int64_t>(sizeof(Tensor::offset_t));
+  CHECK_FAIL_RETURN_UNEXPECTED(num_bytes >= offsets_bytes, "Shuffle buffer row is corrupted.");
+  std::vector<Tensor::offset_t> offsets(num_strings + 1);
+  // The data of a column is not aligned when it follows another column.
+  int ret_code = memcpy_s(offsets.data(), offsets_bytes, data, offsets_bytes);
+  CHECK_FAIL_RETURN_UNEXPECTED(ret_code == 0, "Failed to copy string offsets.");
+  CHECK_FAIL_RETURN_UNEXPECTED(offsets[num_strings] == num_bytes, "Shuffle buffer row is corrupted.");
+  std::vector<std::string> strings;
+  strings.reserve(num_strings);
+  for (dsize_t i = 0; i < num_strings; i++) {
+    CHECK_FAIL_RETURN_UNEXPECTED(offsets[i] >= offsets_bytes && offsets[i] < offsets[i + 1],
+                                 "Shuffle buffer row is corrupted.");
+    // -1 to skip the \0 at the end of each string
+    strings.emplace_back(reinterpret_cast<const char *>(data) + offsets[i], offsets[i + 1] - offsets[i] - 1);
+  }
+  return Tensor::CreateTensor(out, strings, shape);
+}
+}  // namespace
+
+// A stored row starts with a header of int64 values: the row id, the number of columns, then the type, rank,
+// dims and size in bytes of each column. The data of the columns follows the header in the same order.
+Status ShuffleOp::StoreRow(const TensorRow &row, RowHandle *handle) {
+  std::vector<int64_t> header = {row.getId(), static_cast<int64_t>(row.size())};
+  std::vector<ReadableSlice> slices(1);
+  slices.reserve(row.size() + 1);
+  for (const auto &ts : row) {
+    dsize_t num_bytes = ts->GetBuffer() == nullptr ? 0 : ts->SizeInBytes();
+    header.push_back(static_cast<int64_t>(ts->type().value()));
+    header.push_back(ts->Rank());
+    for (auto dim : ts->shape().AsVector()) {
+      header.push_back(dim);
+    }
+    header.push_back(num_bytes);
+    if (num_bytes > 0) {
+      slices.emplace_back(ts->GetBuffer(), num_bytes);
+    }
+  }
+  slices[0] = ReadableSlice(header.data(), header.size() * sizeof(int64_t));
+  size_t sz = 0;
+  for (auto &v : slices) {
+    sz += v.GetSize();
+  }
+  handle->size = sz;
+
+  Status rc = arena_->Allocate(sz, &handle->ptr);
+  if (rc.IsOk()) {
+    WritableSlice dest(handle->ptr, sz);
+    size_t pos = 0;
+    for (auto &v : slices) {
+      WritableSlice out(dest, pos);
+      rc = WritableSlice::Copy(&out, v);
+      if (rc.IsError()) {
+        arena_->Deallocate(handle->ptr);
+        *handle = RowHandle();
+        return rc;
+      }
+      pos += v.GetSize();
+    }
+    return Status::OK();
+  }
+  if (!rc.IsOutofMemory()) {
+    return rc;
+  }
+  // The arena is full, the row goes to disk.
+  handle->ptr = nullptr;
+  if (spill_dir_.empty()) {
+    RETURN_STATUS_UNEXPECTED("Shuffle buffer exceeds its memory limit and no spill directory is given.");
+  }
+  if (spill_storage_ == nullptr) {
+    RETURN_IF_NOT_OK(OpenSpillStorage());
+  }
+  return spill_storage_->Write(&handle->key, slices);
+}
+
+Status ShuffleOp::LoadRow(RowHandle *handle, TensorRow *row) {
+  CHECK_FAIL_RETURN_UNEXPECTED(handle->size != 0, "Shuffle buffer slot is empty.");
+  const int64_t *header = nullptr;
+  if (handle->ptr != nullptr) {
+    header = static_cast<const int64_t *>(handle->ptr);
+  } else {
+    // A spilled row is read back into a buffer that is reused for every spilled row.
+    CHECK_FAIL_RETURN_UNEXPECTED(spill_storage_ != nullptr, "Shuffle spill storage is not open.");
+    spill_read_buffer_.resize((handle->size + sizeof(int64_t) - 1) / sizeof(int64_t));
+    WritableSlice dest(spill_read_buffer_.data(), handle->size);
+    size_t bytes_read = 0;
+    RETURN_IF_NOT_OK(spill_storage_->Read(handle->key, &dest, &bytes_read));
+    CHECK_FAIL_RETURN_UNEXPECTED(bytes_read == handle->size, "Shuffle spill storage returned a partial row.");
+    header = spill_read_buffer_.data();
   }
+
+  // First pass over the header to find where the data starts.
+  int64_t num_cols = header[1];
+  size_t pos = 2;
+  for (int64_t i = 0; i < num_cols; i++) {
+    pos += header[pos + 1] + 3;
+  }
+  const unsigned char *data = reinterpret_cast<const unsigned char *>(header + pos);
+  const unsigned char *data_end = reinterpret_cast<const unsigned char *>(header) + handle->size;
+
+  TensorRow out;
+  out.setId(header[0]);
+  out.reserve(num_cols);
+  pos = 2;
+  for (int64_t i = 0; i < num_cols; i++) {
+    DataType type(static_cast<DataType::Type>(header[pos]));
+    int64_t rank = header[pos + 1];
+    TensorShape shape(std::vector<dsize_t>(header + pos + 2, header + pos + 2 + rank));
+    int64_t num_bytes = header[pos + 2 + rank];
+    pos += rank + 3;
+    CHECK_FAIL_RETURN_UNEXPECTED(data + num_bytes <= data_end, "Shuffle buffer row is corrupted.");
+    std::shared_ptr<Tensor> ts;
+    RETURN_IF_NOT_OK(RestoreTensor(shape, type, data, num_bytes, &ts));
+    data += num_bytes;
+    out.push_back(std::move(ts));
+  }
+
+  if (handle->ptr != nullptr) {
+    arena_->Deallocate(handle->ptr);
+  }
+  *handle = RowHandle();
+  *row = std::move(out);
+  return Status::OK();
+}
+
+Status ShuffleOp::OpenSpillStorage() {
+  Path spill = Path(spill_dir_) / spill_folder_;
+  RETURN_IF_NOT_OK(spill.CreateDirectories());
+  spill_storage_ = std::make_shared<StorageManager>(spill);
+  RETURN_IF_NOT_OK(spill_storage_->ServiceStart());
+  MS_LOG(INFO) << "Shuffle operator spills rows to " << spill.toString();
   return Status::OK();
 }
 
+Status ShuffleOp::CloseSpillStorage() {
+  if (spill_storage_ == nullptr) {
+    return Status::OK();
+  }
+  Status rc = spill_storage_->ServiceStop();
+  spill_storage_.reset();
+  Path spill = Path(spill_dir_) / spill_folder_;
+  auto it = Path::DirIterator::OpenDirectory(&spill);
+  while (it != nullptr && it->hasNext()) {
+    Status rc2 = it->next().Remove();
+    if (rc2.IsError() && rc.IsOk()) {
+      rc = rc2;
+    }
+  }
+  Status rc2 = spill.Remove();
+  if (rc2.IsError() && rc.IsOk()) {
+    rc = rc2;
+  }
+  return rc;
+}
+
 // Class functor operator () override.
 // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
 // provide the master loop that drives the logic for performing the work
@@ -152,6 +375,11 @@ Status ShuffleOp::operator()() {
   int32_t child_idx = 0;
   child_iterator_ = std::make_unique<ChildIterator>(this, worker_id, child_idx);
 
+  // With a memory limit the rows are held in an arena of that size instead of as tensors.
+  if (memory_limit_ > 0) {
+    RETURN_IF_NOT_OK(Arena::CreateArena(&arena_, memory_limit_));
+  }
+
   // Main operator loop
   while (true) {
     // Do an initial populate of the shuffle buffer
@@ -177,7 +405,9 @@ Status ShuffleOp::operator()() {
       // tensor table. We remove the data from the shuffle buffer, leaving that slot
       // in the table as an empty vector
       int64_t random_slot = rng_() % (shuffle_last_row_idx_ + 1);
-      new_buffer_table->push_back(std::move((*shuffle_buffer_)[random_slot]));
+      TensorRow random_row;
+      RETURN_IF_NOT_OK(TakeRow(random_slot, &random_row));
+      new_buffer_table->push_back(std::move(random_row));
 
       // Step 3)
       // If the output tensor table is at the requested size, then create a buffer for it
@@ -196,7 +426,7 @@ Status ShuffleOp::operator()() {
       // just vacated.  This makes the shuffle buffer contiguous, with an empty slot at the
       // tail of the shuffle buffer.
       if (random_slot != shuffle_last_row_idx_) {
-        (*shuffle_buffer_)[random_slot] = std::move((*shuffle_buffer_)[shuffle_last_row_idx_]);
+        MoveRow(random_slot, shuffle_last_row_idx_);
       }
 
       // Step 5)
@@ -268,7 +498,7 @@ Status ShuffleOp::InitShuffleBuffer() {
 
   // Now fill the rest of the shuffle buffer until we are unable to get the next row or we reached
   // the desired shuffle buffer size.
-  while (!new_row.empty() && shuffle_buffer_->size() < static_cast<size_t>(shuffle_size_ - 1)) {
+  while (!new_row.empty() && ShuffleBufferSize() < static_cast<size_t>(shuffle_size_ - 1)) {
     // Add the previously fetched row
     RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
 
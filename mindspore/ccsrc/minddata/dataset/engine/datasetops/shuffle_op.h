@@ -28,7 +28,9 @@
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/datasetops/pipeline_op.h"
+#include "minddata/dataset/util/arena.h"
 #include "minddata/dataset/util/status.h"
+#include "minddata/dataset/util/storage_manager.h"
 
 namespace mindspore {
 namespace dataset {
@@ -100,6 +102,23 @@ class ShuffleOp : public PipelineOp {
       return *this;
     }
 
+    // Setter method.
+    // @param memory_limit - MB of memory for the rows waiting in the shuffle buffer. 0 keeps the rows as they
+    //     are, any other value stores them serialized in an arena of that size.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetMemoryLimit(int32_t memory_limit) {
+      build_memory_limit_ = memory_limit;
+      return *this;
+    }
+
+    // Setter method.
+    // @param spill_dir - Directory for the rows that do not fit in the memory limit.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetSpillDir(const std::string &spill_dir) {
+      build_spill_dir_ = spill_dir;
+      return *this;
+    }
+
     // The builder "build" method creates the final object.
     // @return shared_ptr to the new ShuffleOp object
     Status Build(std::shared_ptr<ShuffleOp> *);
@@ -112,6 +131,8 @@ class ShuffleOp : public PipelineOp {
     int32_t build_rows_per_buffer_;
     bool build_reshuffle_each_epoch_;
     int32_t build_op_connector_size_;
+    int32_t build_memory_limit_;
+    std::string build_spill_dir_;
 
     Status SanityCheck() const;
   };
@@ -122,11 +143,13 @@ class ShuffleOp : public PipelineOp {
   // @param shuffle_seed - The seed to use for random number generation
   // @param op_connector_size - The output connector queue size
   // @param rows_per_buffer - The requested number of rows per buffer
+  // @param memory_limit - MB of memory for the rows held by the shuffle buffer, 0 for no limit
+  // @param spill_dir - The directory for the rows beyond the memory limit, empty to fail instead
   ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
-            int32_t rows_per_buffer);
+            int32_t rows_per_buffer, int32_t memory_limit = 0, const std::string &spill_dir = "");
 
   // Destructor
-  ~ShuffleOp() = default;
+  ~ShuffleOp() override;
 
   // A print method typically used for debugging
   // @param out - The output stream to write output to
@@ -180,6 +203,49 @@ class ShuffleOp : public PipelineOp {
   // @return Status - The error code return
   Status SelfReset();
 
+  // A row of the shuffle buffer when the buffer has a memory limit. The row is serialized into the arena,
+  // or written to the spill storage when the arena is full.
+  struct RowHandle {
+    void *ptr = nullptr;                // the serialized row in the arena, null if it was spilled
+    StorageManager::key_type key = 0;   // the key of a spilled row
+    size_t size = 0;                    // the size of the serialized row, 0 for an empty slot
+  };
+
+  // Private function to tell how many slots the shuffle buffer has.
+  // @return - The number of slots
+  size_t ShuffleBufferSize() const;
+
+  // Private function to take the row out of a slot of the shuffle buffer, leaving the slot empty.
+  // @param slot - The slot to take the row from
+  // @param row - The row
+  // @return Status - The error code return
+  Status TakeRow(int64_t slot, TensorRow *row);
+
+  // Private function to move the row of one slot of the shuffle buffer into another.
+  // @param dest - The slot to fill, which must be empty
+  // @param src - The slot to empty
+  void MoveRow(int64_t dest, int64_t src);
+
+  // Private function to serialize a row into the arena, or into the spill storage if the arena is full.
+  // @param row - The row to store
+  // @param handle - Where the row was stored
+  // @return Status - The error code return
+  Status StoreRow(const TensorRow &row, RowHandle *handle);
+
+  // Private function to rebuild a stored row and release its memory.
+  // @param handle - Where the row was stored
+  // @param row - The row
+  // @return Status - The error code return
+  Status LoadRow(RowHandle *handle, TensorRow *row);
+
+  // Private function to start the spill storage in a folder of its own under spill_dir_.
+  // @return Status - The error code return
+  Status OpenSpillStorage();
+
+  // Private function to stop the spill storage and remove its files.
+  // @return Status - The error code return
+  Status CloseSpillStorage();
+
   int32_t shuffle_size_;  // User config for the size of the shuffle buffer (number of rows)
   uint32_t shuffle_seed_;
   bool reshuffle_each_epoch_;
@@ -195,6 +261,15 @@ class ShuffleOp : public PipelineOp {
   std::unique_ptr<TensorTable> shuffle_buffer_;
   int32_t shuffle_last_row_idx_;  // Internal tracking of the last slot of our shuffle buffer
   int32_t shuffle_buffer_state_;  // State tracking for the shuffle buffer phases of work
+  // With a memory limit, the shuffle buffer holds handles to the rows instead of the rows themselves.
+  // The rows are kept in arena_, which does not grow past the limit, and the rest go to spill_storage_.
+  int32_t memory_limit_;
+  std::string spill_dir_;
+  std::shared_ptr<Arena> arena_;
+  std::vector<RowHandle> handle_buffer_;
+  std::shared_ptr<StorageManager> spill_storage_;
+  std::string spill_folder_;               // A folder of spill_dir_ unique to this op
+  std::vector<int64_t> spill_read_buffer_;  // Holds a spilled row while it is rebuilt
 
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
 };
@@ -18,17 +18,19 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include "minddata/dataset/util/random.h"
 
 namespace mindspore {
 namespace dataset {
-RandomSampler::RandomSampler(int64_t num_samples, bool replacement, bool reshuffle_each_epoch,
+RandomSampler::RandomSampler(int64_t num_samples, bool replacement, bool reshuffle_each_epoch, int64_t block_size,
                              int64_t samples_per_buffer)
     : Sampler(num_samples, samples_per_buffer),
       seed_(GetSeed()),
       replacement_(replacement),
       next_id_(0),
       reshuffle_each_epoch_(reshuffle_each_epoch),
+      block_size_(block_size),
       dist(nullptr) {}
 
 Status RandomSampler::GetNextSample(std::unique_ptr<DataBuffer> *out_buffer) {
@@ -75,6 +77,8 @@ Status RandomSampler::InitSampler() {
     num_samples_ = num_rows_;
   }
   CHECK_FAIL_RETURN_UNEXPECTED(num_samples_ > 0 && num_rows_ > 0, "both num_samples & num_rows need to be positive");
+  CHECK_FAIL_RETURN_UNEXPECTED(block_size_ > 0, "block_size needs to be positive");
+  CHECK_FAIL_RETURN_UNEXPECTED(block_size_ == 1 || !replacement_, "block_size needs to be 1 with replacement");
   samples_per_buffer_ = samples_per_buffer_ > num_samples_ ? num_samples_ : samples_per_buffer_;
   rnd_.seed(seed_);
 
@@ -83,7 +87,7 @@ Status RandomSampler::InitSampler() {
     for (int64_t i = 0; i < num_rows_; i++) {
       shuffled_ids_.push_back(i);
     }
-    std::shuffle(shuffled_ids_.begin(), shuffled_ids_.end(), rnd_);
+    ShuffleIds();
   } else {
     dist = std::make_unique<std::uniform_int_distribution<int64_t>>(0, num_rows_ - 1);
   }
@@ -102,7 +106,7 @@ Status RandomSampler::ResetSampler() {
   rnd_.seed(seed_);
 
   if (replacement_ == false && reshuffle_each_epoch_) {
-    std::shuffle(shuffled_ids_.begin(), shuffled_ids_.end(), rnd_);
+    ShuffleIds();
   }
 
   if (HasChildSampler()) {
@@ -112,12 +116,34 @@ Status RandomSampler::ResetSampler() {
   return Status::OK();
 }
 
+void RandomSampler::ShuffleIds() {
+  if (block_size_ <= 1) {
+    std::shuffle(shuffled_ids_.begin(), shuffled_ids_.end(), rnd_);
+    return;
+  }
+  // Only the order of the blocks is random, so a source with random access reads block_size_ rows in a row.
+  // A shuffle op on top of the source then mixes the rows of the blocks in its buffer.
+  std::vector<int64_t> blocks((num_rows_ + block_size_ - 1) / block_size_);
+  std::iota(blocks.begin(), blocks.end(), 0);
+  std::shuffle(blocks.begin(), blocks.end(), rnd_);
+  shuffled_ids_.clear();
+  for (auto block : blocks) {
+    int64_t end = std::min((block + 1) * block_size_, num_rows_);
+    for (int64_t i = block * block_size_; i < end; i++) {
+      shuffled_ids_.push_back(i);
+    }
+  }
+}
+
 void RandomSampler::Print(std::ostream &out, bool show_all) const {
   out << "\nSampler: RandomSampler";
   if (show_all) {
     // Call the super class for displaying any common detailed info
     Sampler::Print(out, show_all);
     // Then add our own info if any
+    if (block_size_ > 1) {
+      out << "\nBlock size: " << block_size_;
+    }
   }
 }
 }  // namespace dataset
@@ -30,8 +30,10 @@ class RandomSampler : public Sampler {
   // @param int64_t num_samples - number samples to draw
   // @param bool replacement - put he id back / or not after a sample
   // @param reshuffle_each_epoch - T/F to reshuffle after epoch
+  // @param int64_t block_size - shuffle blocks of this many consecutive ids instead of single ids, the ids of a
+  //     block stay in order. Only used for NO REPLACEMENT
   // @param int64_t samples_per_buffer - Num of Sampler Ids to fetch via 1 GetNextBuffer call
-  explicit RandomSampler(int64_t num_samples, bool replacement, bool reshuffle_each_epoch,
+  explicit RandomSampler(int64_t num_samples, bool replacement, bool reshuffle_each_epoch, int64_t block_size = 1,
                          int64_t samples_per_buffer = std::numeric_limits<int64_t>::max());
 
   // Destructor.
@@ -53,6 +55,9 @@ class RandomSampler : public Sampler {
   virtual void Print(std::ostream &out, bool show_all) const;
 
  private:
+  // Shuffles shuffled_ids_, by blocks when block_size_ is larger than 1
+  void ShuffleIds();
+
   uint32_t seed_;
   bool replacement_;
   std::vector<int64_t> shuffled_ids_;  // only used for NO REPLACEMENT
@@ -60,6 +65,7 @@ class RandomSampler : public Sampler {
   std::mt19937 rnd_;
   std::unique_ptr<std::uniform_int_distribution<int64_t>> dist;
   bool reshuffle_each_epoch_;
+  int64_t block_size_;
 };
 }  // namespace dataset
 }  // namespace mindspore
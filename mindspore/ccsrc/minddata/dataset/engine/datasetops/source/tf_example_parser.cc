@@ -0,0 +1,343 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
+
+#include <cstring>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Wire types of the protobuf encoding, groups are not used by Example
+constexpr uint32_t kWireVarint = 0;
+constexpr uint32_t kWireFixed64 = 1;
+constexpr uint32_t kWireLengthDelimited = 2;
+constexpr uint32_t kWireFixed32 = 5;
+constexpr int kMaxVarintBytes = 10;
+
+// Field numbers of example.proto and feature.proto
+constexpr uint32_t kExampleFeatures = 1;  // Example.features
+constexpr uint32_t kFeaturesFeature = 1;  // Features.feature, a map
+constexpr uint32_t kMapEntryKey = 1;
+constexpr uint32_t kMapEntryValue = 2;
+constexpr uint32_t kListValue = 1;  // value of BytesList, FloatList and Int64List
+
+inline bool ReadVarint(const uint8_t **p, const uint8_t *end, uint64_t *value) {
+  uint64_t result = 0;
+  for (int i = 0; i < kMaxVarintBytes && *p < end; ++i) {
+    uint8_t byte = *(*p)++;
+    result |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+inline bool ReadTag(const uint8_t **p, const uint8_t *end, uint32_t *field, uint32_t *wire_type) {
+  uint64_t tag = 0;
+  if (!ReadVarint(p, end, &tag)) {
+    return false;
+  }
+  *field = static_cast<uint32_t>(tag >> 3);
+  *wire_type = static_cast<uint32_t>(tag & 0x7);
+  return *field != 0;
+}
+
+inline bool ReadLengthDelimited(const uint8_t **p, const uint8_t *end, const uint8_t **payload, size_t *size) {
+  uint64_t length = 0;
+  if (!ReadVarint(p, end, &length) || length > static_cast<uint64_t>(end - *p)) {
+    return false;
+  }
+  *payload = *p;
+  *size = static_cast<size_t>(length);
+  *p += length;
+  return true;
+}
+
+inline bool SkipField(const uint8_t **p, const uint8_t *end, uint32_t wire_type) {
+  switch (wire_type) {
+    case kWireVarint: {
+      uint64_t value = 0;
+      return ReadVarint(p, end, &value);
+    }
+    case kWireFixed64:
+      if (end - *p < static_cast<int64_t>(sizeof(uint64_t))) return false;
+      *p += sizeof(uint64_t);
+      return true;
+    case kWireLengthDelimited: {
+      const uint8_t *payload = nullptr;
+      size_t size = 0;
+      return ReadLengthDelimited(p, end, &payload, &size);
+    }
+    case kWireFixed32:
+      if (end - *p < static_cast<int64_t>(sizeof(uint32_t))) return false;
+      *p += sizeof(uint32_t);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Calls func(wire_type, payload, size) for every value field of a list message. A packed or length delimited
+// value passes its payload, a scalar value passes its encoded bytes.
+template <typename Func>
+bool ForEachValue(const TFFeatureView &feature, Func func) {
+  const uint8_t *p = feature.data;
+  const uint8_t *end = p + feature.size;
+  while (p < end) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    if (!ReadTag(&p, end, &field, &wire_type)) {
+      return false;
+    }
+    const uint8_t *payload = p;
+    size_t size = 0;
+    if (wire_type == kWireLengthDelimited) {
+      if (!ReadLengthDelimited(&p, end, &payload, &size)) {
+        return false;
+      }
+    } else {
+      if (!SkipField(&p, end, wire_type)) {
+        return false;
+      }
+      size = static_cast<size_t>(p - payload);
+    }
+    if (field == kListValue && !func(wire_type, payload, size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Number of varints in a packed field, every varint ends with the only byte of it which has no high bit
+inline bool CountPackedVarints(const uint8_t *data, size_t size, int64_t *count) {
+  if (size > 0 && (data[size - 1] & 0x80) != 0) {
+    return false;
+  }
+  int64_t n = 0;
+  for (size_t i = 0; i < size; ++i) {
+    n += (data[i] & 0x80) == 0;
+  }
+  *count += n;
+  return true;
+}
+}  // namespace
+
+TFExampleParser::TFExampleParser(std::vector<std::string> keys) : keys_(std::move(keys)) {}
+
+bool TFExampleParser::Parse(const uint8_t *data, size_t size, std::vector<TFFeatureView> *features) const {
+  features->assign(keys_.size(), TFFeatureView());
+  const uint8_t *p = data;
+  const uint8_t *end = data + size;
+  while (p < end) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    if (!ReadTag(&p, end, &field, &wire_type)) {
+      return false;
+    }
+    if (field != kExampleFeatures || wire_type != kWireLengthDelimited) {
+      if (!SkipField(&p, end, wire_type)) {
+        return false;
+      }
+      continue;
+    }
+    // protobuf merges a repeated message field, so the entries of every occurrence make up the map
+    const uint8_t *payload = nullptr;
+    size_t payload_size = 0;
+    if (!ReadLengthDelimited(&p, end, &payload, &payload_size) || !ParseFeatures(payload, payload_size, features)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TFExampleParser::ParseFeatures(const uint8_t *data, size_t size, std::vector<TFFeatureView> *features) const {
+  const uint8_t *p = data;
+  const uint8_t *end = data + size;
+  while (p < end) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    if (!ReadTag(&p, end, &field, &wire_type)) {
+      return false;
+    }
+    if (field != kFeaturesFeature || wire_type != kWireLengthDelimited) {
+      if (!SkipField(&p, end, wire_type)) {
+        return false;
+      }
+      continue;
+    }
+    const uint8_t *entry = nullptr;
+    size_t entry_size = 0;
+    if (!ReadLengthDelimited(&p, end, &entry, &entry_size) || !ParseFeatureEntry(entry, entry_size, features)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TFExampleParser::ParseFeatureEntry(const uint8_t *data, size_t size, std::vector<TFFeatureView> *features) const {
+  std::string_view key;
+  TFFeatureView value;
+  const uint8_t *p = data;
+  const uint8_t *end = data + size;
+  while (p < end) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    if (!ReadTag(&p, end, &field, &wire_type)) {
+      return false;
+    }
+    if ((field != kMapEntryKey && field != kMapEntryValue) || wire_type != kWireLengthDelimited) {
+      if (!SkipField(&p, end, wire_type)) {
+        return false;
+      }
+      continue;
+    }
+    const uint8_t *payload = nullptr;
+    size_t payload_size = 0;
+    if (!ReadLengthDelimited(&p, end, &payload, &payload_size)) {
+      return false;
+    }
+    if (field == kMapEntryKey) {
+      key = std::string_view(reinterpret_cast<const char *>(payload), payload_size);
+    } else {
+      value.data = payload;
+      value.size = payload_size;
+    }
+  }
+
+  // a handful of columns, a linear search beats hashing the key
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    if (keys_[i] == key) {
+      // a later entry of the same key replaces the earlier one, as in a protobuf map
+      (*features)[i] = TFFeatureView();
+      (*features)[i].found = true;
+      return value.data == nullptr || ParseFeature(value.data, value.size, &(*features)[i]);
+    }
+  }
+  return true;
+}
+
+bool TFExampleParser::ParseFeature(const uint8_t *data, size_t size, TFFeatureView *feature) {
+  const uint8_t *p = data;
+  const uint8_t *end = data + size;
+  while (p < end) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    if (!ReadTag(&p, end, &field, &wire_type)) {
+      return false;
+    }
+    if (field < TFFeatureView::kBytesList || field > TFFeatureView::kInt64List || wire_type != kWireLengthDelimited) {
+      if (!SkipField(&p, end, wire_type)) {
+        return false;
+      }
+      continue;
+    }
+    // the same list twice would have to be merged, leave that to protobuf
+    if (feature->kind == static_cast<TFFeatureView::Kind>(field)) {
+      return false;
+    }
+    // another member of the oneof replaces the current one
+    feature->kind = static_cast<TFFeatureView::Kind>(field);
+    if (!ReadLengthDelimited(&p, end, &feature->data, &feature->size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TFExampleParser::CountValues(const TFFeatureView &feature, int64_t *num_elements) {
+  *num_elements = 0;
+  switch (feature.kind) {
+    case TFFeatureView::kBytesList:
+      return ForEachValue(feature, [num_elements](uint32_t wire_type, const uint8_t *, size_t) {
+        (*num_elements)++;
+        return wire_type == kWireLengthDelimited;
+      });
+    case TFFeatureView::kFloatList:
+      return ForEachValue(feature, [num_elements](uint32_t wire_type, const uint8_t *, size_t size) {
+        if (wire_type == kWireFixed32) {
+          (*num_elements)++;
+          return true;
+        }
+        *num_elements += static_cast<int64_t>(size / sizeof(float));
+        return wire_type == kWireLengthDelimited && size % sizeof(float) == 0;
+      });
+    case TFFeatureView::kInt64List:
+      return ForEachValue(feature, [num_elements](uint32_t wire_type, const uint8_t *payload, size_t size) {
+        if (wire_type == kWireVarint) {
+          (*num_elements)++;
+          return true;
+        }
+        return wire_type == kWireLengthDelimited && CountPackedVarints(payload, size, num_elements);
+      });
+    default:
+      return true;
+  }
+}
+
+bool TFExampleParser::ReadFloats(const TFFeatureView &feature, float *out) {
+  // floats are little endian on the wire as they are in memory, so a packed list is copied as it is
+  return ForEachValue(feature, [&out](uint32_t wire_type, const uint8_t *payload, size_t size) {
+    if ((wire_type != kWireLengthDelimited && wire_type != kWireFixed32) || size % sizeof(float) != 0) {
+      return false;
+    }
+    if (size > 0) {
+      (void)std::memcpy(out, payload, size);
+      out += size / sizeof(float);
+    }
+    return true;
+  });
+}
+
+template <typename T>
+bool TFExampleParser::ReadInts(const TFFeatureView &feature, T *out) {
+  return ForEachValue(feature, [&out](uint32_t wire_type, const uint8_t *payload, size_t size) {
+    if (wire_type != kWireLengthDelimited && wire_type != kWireVarint) {
+      return false;
+    }
+    const uint8_t *p = payload;
+    const uint8_t *end = payload + size;
+    while (p < end) {
+      uint64_t value = 0;
+      if (!ReadVarint(&p, end, &value)) {
+        return false;
+      }
+      *out++ = static_cast<T>(static_cast<int64_t>(value));
+    }
+    return true;
+  });
+}
+
+template bool TFExampleParser::ReadInts<uint64_t>(const TFFeatureView &feature, uint64_t *out);
+template bool TFExampleParser::ReadInts<int64_t>(const TFFeatureView &feature, int64_t *out);
+template bool TFExampleParser::ReadInts<uint32_t>(const TFFeatureView &feature, uint32_t *out);
+template bool TFExampleParser::ReadInts<int32_t>(const TFFeatureView &feature, int32_t *out);
+template bool TFExampleParser::ReadInts<uint16_t>(const TFFeatureView &feature, uint16_t *out);
+template bool TFExampleParser::ReadInts<int16_t>(const TFFeatureView &feature, int16_t *out);
+template bool TFExampleParser::ReadInts<uint8_t>(const TFFeatureView &feature, uint8_t *out);
+template bool TFExampleParser::ReadInts<int8_t>(const TFFeatureView &feature, int8_t *out);
+
+bool TFExampleParser::ReadBytes(const TFFeatureView &feature, std::vector<std::string_view> *values) {
+  values->clear();
+  return ForEachValue(feature, [values](uint32_t wire_type, const uint8_t *payload, size_t size) {
+    values->emplace_back(reinterpret_cast<const char *>(payload), size);
+    return wire_type == kWireLengthDelimited;
+  });
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
+#define DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+// A feature of a serialized dataengine::Example. The payload points into the buffer of the record,
+// so a view is only valid as long as that buffer is.
+struct TFFeatureView {
+  // Same values as dataengine::Feature::KindCase
+  enum Kind : int32_t { kNotSet = 0, kBytesList = 1, kFloatList = 2, kInt64List = 3 };
+
+  bool found = false;             // the Example has a feature of this name
+  Kind kind = kNotSet;            // which list the feature holds
+  const uint8_t *data = nullptr;  // the encoded BytesList, FloatList or Int64List
+  size_t size = 0;
+};
+
+// Reads serialized Examples at the level of the protobuf wire format instead of building the messages.
+// Only the features named at construction are located, every other field is skipped without being decoded,
+// and the values are copied from the record straight into their destination.
+class TFExampleParser {
+ public:
+  // Constructor
+  // @param keys - names of the features to locate, in the order of the views returned by Parse
+  explicit TFExampleParser(std::vector<std::string> keys);
+
+  ~TFExampleParser() = default;
+
+  // Locates the features of the keys in a record.
+  // @param data - the serialized Example.
+  // @param size - number of bytes of the record.
+  // @param features - one view per key, found is false when the record lacks the key.
+  // @return bool - false if the record is malformed or uses an encoding this parser does not handle,
+  //     parse it with protobuf in that case.
+  bool Parse(const uint8_t *data, size_t size, std::vector<TFFeatureView> *features) const;
+
+  // Counts the values of a feature.
+  // @param feature - a found feature.
+  // @param num_elements - the number of values.
+  // @return bool - false if the list is malformed.
+  static bool CountValues(const TFFeatureView &feature, int64_t *num_elements);
+
+  // Copies the values of a FloatList.
+  // @param feature - a feature of kind kFloatList.
+  // @param out - room for the number of values given by CountValues.
+  // @return bool - false if the list is malformed.
+  static bool ReadFloats(const TFFeatureView &feature, float *out);
+
+  // Copies the values of an Int64List, casting each to T.
+  // @param feature - a feature of kind kInt64List.
+  // @param out - room for the number of values given by CountValues.
+  // @return bool - false if the list is malformed.
+  template <typename T>
+  static bool ReadInts(const TFFeatureView &feature, T *out);
+
+  // Gets the values of a BytesList, without copying them.
+  // @param feature - a feature of kind kBytesList.
+  // @param values - the values, pointing into the record.
+  // @return bool - false if the list is malformed.
+  static bool ReadBytes(const TFFeatureView &feature, std::vector<std::string_view> *values);
+
+ private:
+  // Locates the features of the keys in a Features message
+  bool ParseFeatures(const uint8_t *data, size_t size, std::vector<TFFeatureView> *features) const;
+
+  // Decodes one key and value pair of the feature map, the value is kept if the key is wanted
+  bool ParseFeatureEntry(const uint8_t *data, size_t size, std::vector<TFFeatureView> *features) const;
+
+  // Finds which list a Feature message holds
+  static bool ParseFeature(const uint8_t *data, size_t size, TFFeatureView *feature);
+
+  std::vector<std::string> keys_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
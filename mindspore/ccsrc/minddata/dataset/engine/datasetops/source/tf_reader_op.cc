@@ -22,9 +22,11 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "google/protobuf/arena.h"
 #include "proto/example.pb.h"
 #include "./securec.h"
 #include "common/utils.h"
@@ -52,7 +54,8 @@ TFReaderOp::Builder::Builder()
       builder_num_devices_(1),
       builder_total_rows_(0),
       builder_equal_rows_per_shard_(false),
-      builder_sampler_(nullptr) {
+      builder_sampler_(nullptr),
+      builder_check_crc_(false) {
   std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
   builder_num_workers_ = config_manager->num_parallel_workers();
   builder_worker_connector_size_ = config_manager->worker_connector_size();
@@ -125,7 +128,7 @@ Status TFReaderOp::Builder::Build(std::shared_ptr<TFReaderOp> *out_tf_reader_op)
     builder_num_workers_, builder_worker_connector_size_, builder_rows_per_buffer_, builder_total_rows_,
     builder_dataset_files_list_, std::move(builder_data_schema_), builder_op_connector_size_, builder_columns_to_load_,
     builder_shuffle_files_, builder_num_devices_, builder_device_id_, builder_equal_rows_per_shard_,
-    std::move(builder_sampler_));
+    std::move(builder_sampler_), builder_check_crc_);
 
   RETURN_IF_NOT_OK(new_tf_reader_op->Init());
   *out_tf_reader_op = std::move(new_tf_reader_op);
@@ -136,7 +139,8 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
                        int64_t total_num_rows, std::vector<std::string> dataset_files_list,
                        std::unique_ptr<DataSchema> data_schema, int32_t op_connector_size,
                        std::vector<std::string> columns_to_load, bool shuffle_files, int32_t num_device,
-                       int32_t device_id, bool equal_rows_per_shard, std::shared_ptr<Sampler> sampler)
+                       int32_t device_id, bool equal_rows_per_shard, std::shared_ptr<Sampler> sampler,
+                       bool check_crc)
     : ParallelOp(num_workers, op_connector_size, std::move(sampler)),
       device_id_(device_id),
       num_devices_(num_device),
@@ -152,7 +156,8 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
       load_jagged_connector_(true),
       num_rows_(0),
       num_rows_per_shard_(0),
-      equal_rows_per_shard_(equal_rows_per_shard) {
+      equal_rows_per_shard_(equal_rows_per_shard),
+      check_crc_(check_crc) {
   worker_connector_size_ = worker_connector_size;
 }
 
@@ -194,6 +199,13 @@ Status TFReaderOp::Init() {
   if (total_rows_ == 0) {
     total_rows_ = data_schema_->num_rows();
   }
+
+  // The parser looks for the features of the columns, in the order of the columns
+  std::vector<std::string> column_names;
+  for (int32_t col = 0; col < data_schema_->NumColumns(); ++col) {
+    column_names.push_back(data_schema_->column(col).name());
+  }
+  example_parser_ = std::make_unique<TFExampleParser>(std::move(column_names));
   if (total_rows_ < 0) {
     RETURN_STATUS_UNEXPECTED("The num_sample or numRows for TFRecordDataset should be greater than 0");
   }
@@ -567,7 +579,7 @@ Status TFReaderOp::PushIoBlockQueue(int32_t index, std::unique_ptr<FilenameBlock
 Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_offset, const int64_t end_offset,
                             const int32_t &worker_id) {
   std::ifstream reader;
-  reader.open(filename);
+  reader.open(filename, std::ios::binary);
   if (!reader) {
     RETURN_STATUS_UNEXPECTED("failed to open file: " + filename);
   }
@@ -577,6 +589,10 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
   std::unique_ptr<DataBuffer> current_buffer = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
   std::unique_ptr<TensorQTable> new_tensor_table = std::make_unique<TensorQTable>();
 
+  // Reused by every record of the file, so a record costs no allocation once the largest one has been read
+  std::string serialized_example;
+  std::vector<TFFeatureView> features;
+
   while (reader.peek() != EOF) {
     if (!load_jagged_connector_) {
       break;
@@ -586,25 +602,37 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
     int64_t record_length = 0;
     (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
 
-    // ignore crc header
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
+    // crc header
+    uint32_t masked_crc = 0;
+    (void)reader.read(reinterpret_cast<char *>(&masked_crc), static_cast<std::streamsize>(sizeof(uint32_t)));
+    if (!reader || record_length < 0) {
+      RETURN_STATUS_UNEXPECTED("failed to read the record length from file: " + filename);
+    }
+    if (check_crc_) {
+      RETURN_IF_NOT_OK(
+        CheckRecordCrc(filename, reinterpret_cast<const char *>(&record_length), sizeof(int64_t), masked_crc));
+    }
 
-    // read serialized Example
-    std::string serialized_example;
-    serialized_example.resize(record_length);
-    (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
     if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_file;
-      if (!tf_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "parse tfrecord failed";
-        RETURN_STATUS_UNEXPECTED(errMsg);
+      // read serialized Example
+      serialized_example.resize(record_length);
+      (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
+
+      // crc footer
+      (void)reader.read(reinterpret_cast<char *>(&masked_crc), static_cast<std::streamsize>(sizeof(uint32_t)));
+      if (!reader) {
+        RETURN_STATUS_UNEXPECTED("failed to read a record from file: " + filename);
+      }
+      if (check_crc_) {
+        RETURN_IF_NOT_OK(CheckRecordCrc(filename, serialized_example.data(), serialized_example.size(), masked_crc));
       }
-      RETURN_IF_NOT_OK(LoadExample(&tf_file, &new_tensor_table, rows_read));
+
+      RETURN_IF_NOT_OK(LoadRecord(serialized_example, &features, &new_tensor_table, rows_read));
       rows_read++;
+    } else {
+      // rows of other shards are skipped without reading them
+      (void)reader.seekg(record_length + static_cast<int64_t>(sizeof(uint32_t)), std::ios::cur);
     }
-
-    // ignore crc footer
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
     rows_total++;
 
     if (rows_read == rows_per_buffer_) {
@@ -625,6 +653,30 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
   return Status::OK();
 }
 
+Status TFReaderOp::CheckRecordCrc(const std::string &filename, const char *data, size_t size, uint32_t masked_crc) {
+  if (system::Crc32c::GetMaskCrc32cValue(data, size) != masked_crc) {
+    RETURN_STATUS_UNEXPECTED("crc check failed, the tfrecord file is corrupted: " + filename);
+  }
+  return Status::OK();
+}
+
+Status TFReaderOp::LoadRecord(const std::string &serialized_example, std::vector<TFFeatureView> *features,
+                              std::unique_ptr<TensorQTable> *tensor_table, int64_t row) {
+  if (example_parser_->Parse(reinterpret_cast<const uint8_t *>(serialized_example.data()), serialized_example.size(),
+                             features)) {
+    return LoadExample(*features, tensor_table, row);
+  }
+
+  // The messages of a full parse are allocated in an arena and released together with it
+  google::protobuf::Arena arena;
+  auto *tf_file = google::protobuf::Arena::CreateMessage<dataengine::Example>(&arena);
+  if (!tf_file->ParseFromString(serialized_example)) {
+    std::string errMsg = "parse tfrecord failed";
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
+  return LoadExample(tf_file, tensor_table, row);
+}
+
 // Parses a single row and puts the data into a tensor table.
 Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, std::unique_ptr<TensorQTable> *tensor_table,
                                int64_t row) {
@@ -643,6 +695,23 @@ Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, std::unique_p
   return Status::OK();
 }
 
+Status TFReaderOp::LoadExample(const std::vector<TFFeatureView> &features, std::unique_ptr<TensorQTable> *tensor_table,
+                               int64_t row) {
+  int32_t num_columns = data_schema_->NumColumns();
+  TensorRow newRow(num_columns, nullptr);
+  (*tensor_table)->push_back(std::move(newRow));
+
+  for (int32_t col = 0; col < num_columns; ++col) {
+    const ColDescriptor &current_col = data_schema_->column(col);
+    if (!features[col].found) {
+      RETURN_STATUS_UNEXPECTED("column not found in tfrecord: " + current_col.name());
+    }
+    RETURN_IF_NOT_OK(LoadFeature(features[col], current_col, &(**tensor_table)[row][col]));
+  }
+
+  return Status::OK();
+}
+
 // Parses a single cell and puts the data into a tensor table.
 Status TFReaderOp::LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table,
                                const dataengine::Feature &column_values_list, const ColDescriptor &current_col,
@@ -700,6 +769,132 @@ Status TFReaderOp::LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table
   return Status::OK();
 }
 
+namespace {
+// Decodes the varints of an Int64List straight into a new tensor of type T
+template <typename T>
+Status LoadIntFeature(const TFFeatureView &feature, const ColDescriptor &current_col, int64_t num_elements,
+                      std::shared_ptr<Tensor> *tensor) {
+  TensorShape current_shape = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &current_shape));
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(tensor, current_col.tensorImpl(), current_shape, current_col.type()));
+  CHECK_FAIL_RETURN_UNEXPECTED((*tensor)->Size() == num_elements,
+                               "Number of values does not match the shape of column: " + current_col.name());
+  // begin() allocates the buffer, the values are decoded into it in place
+  if (num_elements > 0 && !TFExampleParser::ReadInts<T>(feature, &*(*tensor)->begin<T>())) {
+    RETURN_STATUS_UNEXPECTED("parse tfrecord failed");
+  }
+  return Status::OK();
+}
+}  // namespace
+
+Status TFReaderOp::LoadFeature(const TFFeatureView &feature, const ColDescriptor &current_col,
+                               std::shared_ptr<Tensor> *tensor) {
+  int64_t num_elements = 0;
+  if (!TFExampleParser::CountValues(feature, &num_elements)) {
+    RETURN_STATUS_UNEXPECTED("parse tfrecord failed");
+  }
+  const DataType type = current_col.type();
+
+  switch (feature.kind) {
+    case TFFeatureView::kBytesList: {
+      // kBytesList can map to DE_UINT8, DE_INT8 and DE_STRING only
+      if (type != DataType::DE_UINT8 && type != DataType::DE_INT8 && type != DataType::DE_STRING) {
+        RETURN_STATUS_UNEXPECTED("Invalid datatype for Tensor at column: " + current_col.name());
+      }
+      std::vector<std::string_view> values;
+      if (!TFExampleParser::ReadBytes(feature, &values)) {
+        RETURN_STATUS_UNEXPECTED("parse tfrecord failed");
+      }
+      if (type == DataType::DE_STRING) {
+        TensorShape shape = TensorShape::CreateScalar();
+        RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &shape));
+        RETURN_IF_NOT_OK(Tensor::CreateTensor(tensor, std::vector<std::string>(values.begin(), values.end()), shape));
+        break;
+      }
+
+      int64_t max_size = 0;
+      for (const auto &value : values) max_size = std::max(max_size, static_cast<int64_t>(value.size()));
+      int64_t pad_size = 0;
+      RETURN_IF_NOT_OK(GetBytesPadSize(current_col, max_size, &pad_size));
+      TensorShape current_shape = TensorShape::CreateScalar();
+      RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements * pad_size, &current_shape));
+      RETURN_IF_NOT_OK(Tensor::CreateTensor(tensor, TensorImpl::kFlexible, current_shape, type));
+
+      // each element is copied from the record and padded with spaces, as for a BytesList message
+      if (num_elements * pad_size == 0) {
+        break;
+      }
+      unsigned char *current_tensor_addr = reinterpret_cast<unsigned char *>(&*(*tensor)->begin<uint8_t>());
+      int64_t tensor_bytes_remaining = num_elements * pad_size;
+      for (const auto &value : values) {
+        int64_t chars_to_pad = pad_size - static_cast<int64_t>(value.size());
+        CHECK_FAIL_RETURN_UNEXPECTED(chars_to_pad >= 0, "Bytes longer than the shape of column: " + current_col.name());
+        if (!value.empty()) {
+          int return_code = memcpy_s(current_tensor_addr, tensor_bytes_remaining, value.data(), value.size());
+          CHECK_FAIL_RETURN_UNEXPECTED(return_code == 0, "memcpy_s failed when reading bytesList element into Tensor");
+        }
+        current_tensor_addr += value.size();
+        tensor_bytes_remaining -= value.size();
+        if (chars_to_pad > 0) {
+          int return_code = memset_s(current_tensor_addr, tensor_bytes_remaining, static_cast<int>(' '), chars_to_pad);
+          CHECK_FAIL_RETURN_UNEXPECTED(return_code == 0, "memcpy_s failed when padding Tensor");
+        }
+        current_tensor_addr += chars_to_pad;
+        tensor_bytes_remaining -= chars_to_pad;
+      }
+      break;
+    }
+    case TFFeatureView::kFloatList: {
+      // KFloatList can only map to DE_FLOAT32
+      if (type != DataType::DE_FLOAT32) {
+        RETURN_STATUS_UNEXPECTED("Invalid datatype for Tensor at column: " + current_col.name());
+      }
+      TensorShape current_shape = TensorShape::CreateUnknownRankShape();
+      RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &current_shape));
+      RETURN_IF_NOT_OK(Tensor::CreateTensor(tensor, current_col.tensorImpl(), current_shape, type));
+      CHECK_FAIL_RETURN_UNEXPECTED((*tensor)->Size() == num_elements,
+                                   "Number of values does not match the shape of column: " + current_col.name());
+      // the floats are copied from the record straight into the tensor
+      if (num_elements > 0 && !TFExampleParser::ReadFloats(feature, &*(*tensor)->begin<float>())) {
+        RETURN_STATUS_UNEXPECTED("parse tfrecord failed");
+      }
+      break;
+    }
+    case TFFeatureView::kInt64List: {
+      if (type == DataType::DE_UINT64) {
+        RETURN_IF_NOT_OK(LoadIntFeature<uint64_t>(feature, current_col, num_elements, tensor));
+      } else if (type == DataType::DE_INT64) {
+        RETURN_IF_NOT_OK(LoadIntFeature<int64_t>(feature, current_col, num_elements, tensor));
+      } else if (type == DataType::DE_UINT32) {
+        RETURN_IF_NOT_OK(LoadIntFeature<uint32_t>(feature, current_col, num_elements, tensor));
+      } else if (type == DataType::DE_INT32) {
+        RETURN_IF_NOT_OK(LoadIntFeature<int32_t>(feature, current_col, num_elements, tensor));
+      } else if (type == DataType::DE_UINT16) {
+        RETURN_IF_NOT_OK(LoadIntFeature<uint16_t>(feature, current_col, num_elements, tensor));
+      } else if (type == DataType::DE_INT16) {
+        RETURN_IF_NOT_OK(LoadIntFeature<int16_t>(feature, current_col, num_elements, tensor));
+      } else if (type == DataType::DE_UINT8) {
+        RETURN_IF_NOT_OK(LoadIntFeature<uint8_t>(feature, current_col, num_elements, tensor));
+      } else if (type == DataType::DE_INT8) {
+        RETURN_IF_NOT_OK(LoadIntFeature<int8_t>(feature, current_col, num_elements, tensor));
+      } else {
+        RETURN_STATUS_UNEXPECTED("Invalid datatype for Tensor at column: " + current_col.name());
+      }
+      break;
+    }
+    case TFFeatureView::kNotSet: {
+      std::string err_msg = "tf_file column list type enum is KIND_NOT_SET";
+      RETURN_STATUS_UNEXPECTED(err_msg);
+    }
+    default: {
+      std::string err_msg = "tf_file column list type enum does not match any known DE type";
+      RETURN_STATUS_UNEXPECTED(err_msg);
+    }
+  }
+
+  return Status::OK();
+}
+
 // Overrides base class reset method. Cleans up any state info from it's previous execution and
 // reinitializes itself so that it can be executed again, as if it was just created.
 Status TFReaderOp::Reset() {
@@ -742,7 +937,19 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
   uint64_t max_size = 0;
   for (uint32_t i = 0; i < bytes_list.value_size(); ++i) max_size = std::max(max_size, bytes_list.value(i).size());
 
-  int64_t pad_size = max_size;
+  int64_t pad_size = 0;
+  RETURN_IF_NOT_OK(GetBytesPadSize(current_col, max_size, &pad_size));
+
+  // know how many elements there are and the total bytes, create tensor here:
+  TensorShape current_shape = TensorShape::CreateScalar();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape((*num_elements) * pad_size, &current_shape));
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(tensor, bytes_list, current_shape, current_col.type(), pad_size));
+
+  return Status::OK();
+}
+
+Status TFReaderOp::GetBytesPadSize(const ColDescriptor &current_col, int64_t max_size, int64_t *pad_size) {
+  *pad_size = max_size;
 
   // if user provides a shape in the form of [-1, d1, 2d, ... , dn], we need to pad to d1 * d2 * ... * dn
   if (current_col.hasShape()) {
@@ -756,15 +963,10 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
         }
         new_pad_size *= cur_shape[i];
       }
-      pad_size = new_pad_size;
+      *pad_size = new_pad_size;
     }
   }
 
-  // know how many elements there are and the total bytes, create tensor here:
-  TensorShape current_shape = TensorShape::CreateScalar();
-  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape((*num_elements) * pad_size, &current_shape));
-  RETURN_IF_NOT_OK(Tensor::CreateTensor(tensor, bytes_list, current_shape, current_col.type(), pad_size));
-
   return Status::OK();
 }
 
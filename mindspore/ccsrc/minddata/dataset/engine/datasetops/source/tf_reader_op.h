@@ -31,6 +31,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
 
 namespace dataengine {
 class Example;
@@ -161,6 +162,15 @@ class TFReaderOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method. By default only the crc of the first record of each file is checked, when the files are
+    // validated.
+    // @param check_crc - whether or not to check the crc of the length and data of every record read.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetCheckCrc(bool check_crc) {
+      builder_check_crc_ = check_crc;
+      return *this;
+    }
+
    private:
     std::unique_ptr<DataSchema> builder_data_schema_;
     std::shared_ptr<Sampler> builder_sampler_;
@@ -175,6 +185,7 @@ class TFReaderOp : public ParallelOp {
     std::vector<std::string> builder_columns_to_load_;
     bool builder_shuffle_files_;
     bool builder_equal_rows_per_shard_;
+    bool builder_check_crc_;
   };
 
   // Constructor of TFReaderOp (2)
@@ -190,10 +201,12 @@ class TFReaderOp : public ParallelOp {
   // @param shuffle_files - whether or not to shuffle the files before reading data.
   // @param equal_rows_per_shard - whether or not to get equal rows for each process.
   // @param sampler - allow a sampler.  Only valid if a cache exists in ascendent tree nodes
+  // @param check_crc - whether or not to check the crc of every record read.
   TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64_t rows_per_buffer, int64_t total_num_rows,
              std::vector<std::string> dataset_files_list, std::unique_ptr<DataSchema> data_schema,
              int32_t op_connector_size, std::vector<std::string> columns_to_load, bool shuffle_files,
-             int32_t num_devices, int32_t device_id, bool equal_rows_per_shard, std::shared_ptr<Sampler> sampler);
+             int32_t num_devices, int32_t device_id, bool equal_rows_per_shard, std::shared_ptr<Sampler> sampler,
+             bool check_crc = false);
 
   // Default destructor
   ~TFReaderOp() = default;
@@ -301,6 +314,24 @@ class TFReaderOp : public ParallelOp {
   Status LoadFile(const std::string &filename, const int64_t start_offset, const int64_t end_offset,
                   const int32_t &worker_id);
 
+  // Checks the masked crc32c which follows the length or the data of a record.
+  // @param filename - the tf_file file the record is read from, for the error message.
+  // @param data - the bytes covered by the crc.
+  // @param size - the number of bytes covered by the crc.
+  // @param masked_crc - the crc read from the file.
+  // @return Status - the error code returned.
+  static Status CheckRecordCrc(const std::string &filename, const char *data, size_t size, uint32_t masked_crc);
+
+  // Parses a serialized row with the wire level parser, or into an Example when that parser cannot handle it,
+  // and puts the data into a tensor table.
+  // @param serialized_example - the row to be parsed.
+  // @param features - scratch space for the features located in the row.
+  // @param tensor_table - the tensor table to put the parsed data in.
+  // @param row - the id of the row filled in the tensor table.
+  // @return Status - the error code returned.
+  Status LoadRecord(const std::string &serialized_example, std::vector<TFFeatureView> *features,
+                    std::unique_ptr<TensorQTable> *tensor_table, int64_t row);
+
   // Parses a single row and puts the data into a tensor table.
   // @param tf_file - the row to be parsed.
   // @param tensor_table - the tensor table to put the parsed data in.
@@ -308,6 +339,14 @@ class TFReaderOp : public ParallelOp {
   // @return Status - the error code returned.
   Status LoadExample(const dataengine::Example *tf_file, std::unique_ptr<TensorQTable> *tensor_table, int64_t row);
 
+  // Puts the features of a row located by the wire level parser into a tensor table.
+  // @param features - the features of the row, in the order of the columns of the schema.
+  // @param tensor_table - the tensor table to put the parsed data in.
+  // @param row - the id of the row filled in the tensor table.
+  // @return Status - the error code returned.
+  Status LoadExample(const std::vector<TFFeatureView> &features, std::unique_ptr<TensorQTable> *tensor_table,
+                     int64_t row);
+
   // Parses a single cell and puts the data into a tensor table.
   // @param tensor_table - the tensor table to put the parsed data in.
   // @param column_values_list - the cell to parse.
@@ -316,6 +355,21 @@ class TFReaderOp : public ParallelOp {
   Status LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table, const dataengine::Feature &column_values_list,
                      const ColDescriptor &current_col, int64_t row, int32_t col);
 
+  // Builds the tensor of a single cell straight from the record buffer.
+  // @param feature - the cell to read, located by the wire level parser.
+  // @param current_col - the column descriptor containing the expected shape and type of the data.
+  // @param tensor - the tensor we read the values into.
+  // @return Status - the error code returned.
+  static Status LoadFeature(const TFFeatureView &feature, const ColDescriptor &current_col,
+                            std::shared_ptr<Tensor> *tensor);
+
+  // Finds how many bytes each element of a bytes list is padded to.
+  // @param current_col - the column descriptor containing the expected shape and type of the data.
+  // @param max_size - the size of the largest element.
+  // @param pad_size - the number of bytes of each element in the tensor.
+  // @return Status - the error code returned.
+  static Status GetBytesPadSize(const ColDescriptor &current_col, int64_t max_size, int64_t *pad_size);
+
   // Reads values from a bytes list
   // @param current_col - the column descriptor containing the expected shape and type of the data.
   // @param column_values_list - the cell that contains the bytes list to read from.
@@ -414,6 +468,8 @@ class TFReaderOp : public ParallelOp {
   int64_t num_rows_;
   int64_t num_rows_per_shard_;
   bool equal_rows_per_shard_;
+  bool check_crc_;
+  std::unique_ptr<TFExampleParser> example_parser_;
 };
 }  // namespace dataset
 }  // namespace mindspore
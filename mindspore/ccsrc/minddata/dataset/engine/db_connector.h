@@ -16,6 +16,7 @@
 #ifndef DATASET_ENGINE_DB_CONNECTOR_H_
 #define DATASET_ENGINE_DB_CONNECTOR_H_
 
+#include <atomic>
 #include <memory>
 #include <utility>
 #include "minddata/dataset/engine/connector.h"
@@ -35,7 +36,9 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each internal queue.
   DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity), end_of_file_(false) {}
+      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity),
+        end_of_file_(false),
+        out_eoe_count_(0) {}
 
   // Destructor of DbConnector
   ~DbConnector() = default;
@@ -75,8 +78,10 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
         // Setting the internal flag once the first EOF is encountered.
         if ((*result)->eof()) {
           end_of_file_ = true;
+        } else if ((*result)->eoe()) {
+          out_eoe_count_++;
         }
-        pop_from_ = (pop_from_ + 1) % num_producers_;
+        AdvancePopFrom();
       }
       // Do not increment expect_consumer_ when result is eoe and retry_if_eoe is set.
       if (!((*result)->eoe() && retry_if_eoe)) {
@@ -88,9 +93,15 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
     return Status::OK();
   }
 
+  // Getter
+  // @return The number of EOE buffers popped, which is the number of epochs the consumers have finished.
+  int64_t out_eoe_count() const { return out_eoe_count_.load(); }
+
  private:
   // A flag to indicate the end of stream has been encountered.
   bool end_of_file_;
+
+  std::atomic<int64_t> out_eoe_count_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -16,6 +16,8 @@
 #include "minddata/dataset/engine/execution_tree.h"
 #include <iostream>
 #include <string>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/util/task_manager.h"
@@ -26,6 +28,7 @@
 #include "mindspore/ccsrc/minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/perf/profiling.h"
 #include "minddata/dataset/engine/perf/monitor.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
 
 namespace mindspore {
 namespace dataset {
@@ -152,6 +155,11 @@ Status ExecutionTree::Launch() {
     }
   }
 
+  // Launch the tuning once the ops are running
+  if (auto_tune_ != nullptr) {
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("AutoTune Thread launched", std::ref(*auto_tune_)));
+  }
+
   tree_state_ = kDeTStateExecuting;
 
   return Status::OK();
@@ -212,6 +220,12 @@ Status ExecutionTree::Prepare() {
   // Post optimization compulsory transformation
   RETURN_IF_NOT_OK(this->PrepareTreePostAction());
 
+  // The workers the tuning may give work to are launched with the ops, so they are set before the connectors
+  if (GlobalContext::config_manager()->enable_autotune()) {
+    auto_tune_ = std::make_unique<AutoTune>(this);
+    RETURN_IF_NOT_OK(auto_tune_->ReserveWorkers());
+  }
+
   // Existing transformation implementation, will be removed later
   RETURN_IF_NOT_OK(this->PrepareDeprecated());
   return Status::OK();
@@ -31,6 +31,7 @@ namespace dataset {
 class TaskGroup;
 class DatasetOp;
 class Monitor;
+class AutoTune;
 
 class ExecutionTree {
  public:
@@ -247,6 +248,7 @@ class ExecutionTree {
   TreeState tree_state_;                                 // Tracking the current tree state
   std::unique_ptr<Monitor> perf_monitor_;                // Performance Monitor
   std::unique_ptr<ProfilingManager> profiling_manager_;  // Profiling manager
+  std::unique_ptr<AutoTune> auto_tune_;                  // Tuning of the workers and connectors, if enabled
   bool optimize_;                                        // Flag to enable optional optimizations
 };
 
@@ -0,0 +1,527 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/csr_graph.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "./securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+namespace {
+constexpr char kSnapshotMagic[8] = {'M', 'S', 'G', 'N', 'N', 'C', 'S', 'R'};
+constexpr int64_t kSnapshotVersion = 1;
+constexpr int64_t kByteOrderMark = 0x0102030405060708;
+constexpr size_t kSnapshotAlign = 64;  // Arrays start on a cache line of the mapping
+
+// Sorts nodes or edges by type and id into a table and copies their features into its rows. Each element is
+// released once copied, after visit() has seen it.
+template <typename T>
+Status BuildTable(std::vector<std::shared_ptr<T>> *elements,
+                  const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_features,
+                  const std::function<Status(CsrGraph::Index, const std::shared_ptr<T> &)> &visit,
+                  CsrGraph::Table *table) {
+  auto &elems = *elements;
+  std::sort(elems.begin(), elems.end(), [](const std::shared_ptr<T> &a, const std::shared_ptr<T> &b) {
+    return a->type() != b->type() ? a->type() < b->type() : a->id() < b->id();
+  });
+  CHECK_FAIL_RETURN_UNEXPECTED(elems.size() <= static_cast<size_t>(std::numeric_limits<CsrGraph::Index>::max()),
+                               "Too many nodes or edges: " + std::to_string(elems.size()));
+  auto n = static_cast<CsrGraph::Index>(elems.size());
+  std::vector<int8_t> types;
+  std::vector<CsrGraph::Index> type_offsets;
+  std::vector<int32_t> ids(n);
+  for (CsrGraph::Index i = 0; i < n; i++) {
+    ids[i] = elems[i]->id();
+    if (i == 0 || elems[i]->type() != elems[i - 1]->type()) {
+      types.push_back(elems[i]->type());
+      type_offsets.push_back(i);
+    }
+  }
+  type_offsets.push_back(n);
+  // A lookup tries the types one by one, so an id may only be used once across all the types
+  std::vector<int32_t> sorted_ids(ids);
+  std::sort(sorted_ids.begin(), sorted_ids.end());
+  auto dup = std::adjacent_find(sorted_ids.begin(), sorted_ids.end());
+  if (dup != sorted_ids.end()) {
+    RETURN_STATUS_UNEXPECTED("Duplicate id:" + std::to_string(*dup));
+  }
+  size_t num_types = types.size();
+  table->types.Assign(std::move(types));
+  table->type_offsets.Assign(std::move(type_offsets));
+  table->ids.Assign(std::move(ids));
+
+  // The matrices of each feature, one per type
+  std::map<FeatureType, std::vector<std::vector<uint8_t>>> matrices;
+  for (const auto &f : default_features) {
+    const std::shared_ptr<Tensor> &value = f.second->Value();
+    CsrGraph::FeatureColumn column{value->type(), value->SizeInBytes(), value->shape().AsVector(), {}};
+    table->features.emplace(f.first, std::move(column));
+    matrices[f.first].resize(num_types);
+  }
+  int32_t slot = 0;
+  for (CsrGraph::Index i = 0; i < n; i++) {
+    while (i >= table->type_offsets[slot + 1]) {
+      slot++;
+    }
+    for (auto &f : table->features) {
+      std::shared_ptr<Feature> feature;
+      if (!elems[i]->GetFeatures(f.first, &feature).IsOk()) {
+        continue;
+      }
+      const CsrGraph::FeatureColumn &column = f.second;
+      const std::shared_ptr<Tensor> &value = feature->Value();
+      if (value->type() != column.type || value->SizeInBytes() != column.row_bytes) {
+        RETURN_STATUS_UNEXPECTED("Feature " + std::to_string(f.first) + " of id " + std::to_string(elems[i]->id()) +
+                                 " has a different type or size from the other ones");
+      }
+      std::vector<uint8_t> &rows = matrices[f.first][slot];
+      CsrGraph::Index row = i - table->type_offsets[slot];
+      if (rows.empty()) {
+        rows.resize((table->type_offsets[slot + 1] - table->type_offsets[slot]) * column.row_bytes, 0);
+      }
+      if (column.row_bytes > 0) {
+        int ret =
+          memcpy_s(rows.data() + row * column.row_bytes, column.row_bytes, value->GetBuffer(), column.row_bytes);
+        CHECK_FAIL_RETURN_UNEXPECTED(ret == 0, "Failed to copy feature " + std::to_string(f.first));
+      }
+    }
+    RETURN_IF_NOT_OK(visit(i, elems[i]));
+    elems[i].reset();
+  }
+  elems.clear();
+  elems.shrink_to_fit();
+  for (auto &f : table->features) {
+    std::vector<std::vector<uint8_t>> &matrix = matrices[f.first];
+    f.second.data.resize(num_types);
+    for (size_t t = 0; t < num_types; t++) {
+      f.second.data[t].Assign(std::move(matrix[t]));
+    }
+  }
+  return Status::OK();
+}
+
+// Writes the snapshot. Each array is its length followed by its elements, which start at a multiple of
+// kSnapshotAlign from the beginning of the file. Numbers are in the byte order of the host.
+class SnapshotWriter {
+ public:
+  explicit SnapshotWriter(std::ofstream *out) : out_(out), pos_(0) {}
+
+  void Put(int64_t v) { Write(&v, sizeof(v)); }
+
+  template <typename T>
+  void PutArray(const T *data, size_t n) {
+    Put(static_cast<int64_t>(n));
+    Pad(kSnapshotAlign);
+    Write(data, n * sizeof(T));
+    Pad(sizeof(int64_t));
+  }
+
+  void Write(const void *p, size_t n) {
+    if (n > 0) {
+      (void)out_->write(static_cast<const char *>(p), static_cast<std::streamsize>(n));
+      pos_ += n;
+    }
+  }
+
+ private:
+  void Pad(size_t align) {
+    static const char zeros[kSnapshotAlign] = {};
+    Write(zeros, (align - pos_ % align) % align);
+  }
+
+  std::ofstream *out_;
+  size_t pos_;
+};
+
+// Reads a mapped snapshot. The arrays are not copied, they point into the mapping.
+class SnapshotReader {
+ public:
+  SnapshotReader(const uint8_t *base, size_t size) : base_(base), size_(size), pos_(0) {}
+
+  Status Get(int64_t *v) {
+    CHECK_FAIL_RETURN_UNEXPECTED(pos_ + sizeof(int64_t) <= size_, "Invalid graph snapshot, the file is truncated");
+    int ret = memcpy_s(v, sizeof(int64_t), base_ + pos_, sizeof(int64_t));
+    CHECK_FAIL_RETURN_UNEXPECTED(ret == 0, "Failed to read graph snapshot");
+    pos_ += sizeof(int64_t);
+    return Status::OK();
+  }
+
+  template <typename T>
+  Status GetArray(CsrGraph::Array<T> *array) {
+    int64_t n = 0;
+    RETURN_IF_NOT_OK(Get(&n));
+    pos_ = Align(pos_, kSnapshotAlign);
+    CHECK_FAIL_RETURN_UNEXPECTED(n >= 0 && pos_ <= size_ && static_cast<uint64_t>(n) <= (size_ - pos_) / sizeof(T),
+                                 "Invalid graph snapshot, the file is truncated");
+    array->Map(reinterpret_cast<const T *>(base_ + pos_), static_cast<size_t>(n));
+    pos_ = Align(pos_ + n * sizeof(T), sizeof(int64_t));
+    return Status::OK();
+  }
+
+ private:
+  static size_t Align(size_t pos, size_t align) { return (pos + align - 1) / align * align; }
+
+  const uint8_t *base_;
+  size_t size_;
+  size_t pos_;
+};
+
+void SaveTable(const CsrGraph::Table &table, SnapshotWriter *writer) {
+  writer->PutArray(table.types.data(), table.types.size());
+  writer->PutArray(table.type_offsets.data(), table.type_offsets.size());
+  writer->PutArray(table.ids.data(), table.ids.size());
+  writer->Put(static_cast<int64_t>(table.features.size()));
+  for (const auto &f : table.features) {
+    writer->Put(f.first);
+    writer->Put(f.second.type.value());
+    writer->Put(f.second.row_bytes);
+    writer->PutArray(f.second.shape.data(), f.second.shape.size());
+    for (const auto &rows : f.second.data) {
+      writer->PutArray(rows.data(), rows.size());
+    }
+  }
+}
+
+Status MapTable(SnapshotReader *reader, CsrGraph::Table *table) {
+  RETURN_IF_NOT_OK(reader->GetArray(&table->types));
+  RETURN_IF_NOT_OK(reader->GetArray(&table->type_offsets));
+  RETURN_IF_NOT_OK(reader->GetArray(&table->ids));
+  const auto &offsets = table->type_offsets;
+  CHECK_FAIL_RETURN_UNEXPECTED(offsets.size() == table->types.size() + 1 && offsets[0] == 0 &&
+                                 offsets.back() == static_cast<CsrGraph::Index>(table->ids.size()),
+                               "Invalid graph snapshot, the type offsets do not match the ids");
+  for (size_t t = 0; t < table->types.size(); t++) {
+    CHECK_FAIL_RETURN_UNEXPECTED(offsets[t] <= offsets[t + 1] && (t == 0 || table->types[t - 1] < table->types[t]),
+                                 "Invalid graph snapshot, the types are not sorted");
+  }
+  int64_t num_features = 0;
+  RETURN_IF_NOT_OK(reader->Get(&num_features));
+  for (int64_t i = 0; i < num_features; i++) {
+    int64_t feature_type = 0, data_type = 0, row_bytes = 0;
+    RETURN_IF_NOT_OK(reader->Get(&feature_type));
+    RETURN_IF_NOT_OK(reader->Get(&data_type));
+    RETURN_IF_NOT_OK(reader->Get(&row_bytes));
+    CHECK_FAIL_RETURN_UNEXPECTED(data_type >= 0 && data_type < DataType::NUM_OF_TYPES && row_bytes >= 0,
+                                 "Invalid graph snapshot, bad feature " + std::to_string(feature_type));
+    CsrGraph::Array<dsize_t> shape;
+    RETURN_IF_NOT_OK(reader->GetArray(&shape));
+    CsrGraph::FeatureColumn column{DataType(static_cast<DataType::Type>(data_type)), row_bytes,
+                                   std::vector<dsize_t>(shape.begin(), shape.end()), {}};
+    column.data.resize(table->types.size());
+    for (size_t t = 0; t < table->types.size(); t++) {
+      RETURN_IF_NOT_OK(reader->GetArray(&column.data[t]));
+      size_t rows = offsets[t + 1] - offsets[t];
+      CHECK_FAIL_RETURN_UNEXPECTED(column.data[t].empty() || column.data[t].size() == rows * row_bytes,
+                                   "Invalid graph snapshot, bad rows of feature " + std::to_string(feature_type));
+    }
+    table->features.emplace(static_cast<FeatureType>(feature_type), std::move(column));
+  }
+  return Status::OK();
+}
+}  // namespace
+
+int32_t CsrGraph::Table::TypeSlot(int8_t type) const {
+  auto itr = std::lower_bound(types.begin(), types.end(), type);
+  if (itr == types.end() || *itr != type) {
+    return -1;
+  }
+  return static_cast<int32_t>(itr - types.begin());
+}
+
+int32_t CsrGraph::Table::SlotOf(Index pos) const {
+  return static_cast<int32_t>(std::upper_bound(type_offsets.begin(), type_offsets.end(), pos) - type_offsets.begin()) -
+         1;
+}
+
+bool CsrGraph::Table::Find(int32_t id, Index *pos) const {
+  for (size_t s = 0; s < types.size(); s++) {
+    auto begin = ids.begin() + type_offsets[s], end = ids.begin() + type_offsets[s + 1];
+    auto itr = std::lower_bound(begin, end, id);
+    if (itr != end && *itr == id) {
+      *pos = static_cast<Index>(itr - ids.begin());
+      return true;
+    }
+  }
+  return false;
+}
+
+const uint8_t *CsrGraph::Table::FeatureRow(Index pos, FeatureType feature) const {
+  auto itr = features.find(feature);
+  if (itr == features.end()) {
+    return nullptr;
+  }
+  int32_t slot = SlotOf(pos);
+  const Array<uint8_t> &rows = itr->second.data[slot];
+  if (rows.empty()) {
+    return nullptr;
+  }
+  return rows.data() + (pos - type_offsets[slot]) * itr->second.row_bytes;
+}
+
+Status CsrGraph::Build(std::vector<std::shared_ptr<Node>> *nodes, std::vector<std::shared_ptr<Edge>> *edges,
+                       const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_node_features,
+                       const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_edge_features) {
+  RETURN_UNEXPECTED_IF_NULL(nodes);
+  RETURN_UNEXPECTED_IF_NULL(edges);
+  CHECK_FAIL_RETURN_UNEXPECTED(nodes_.ids.empty() && edges_.ids.empty(), "The graph is already built");
+  RETURN_IF_NOT_OK(BuildTable<Node>(
+    nodes, default_node_features, [](Index, const std::shared_ptr<Node> &) { return Status::OK(); }, &nodes_));
+
+  // Keep the node ids of each edge, they become positions once the edges are sorted
+  std::vector<Index> edge_src(edges->size());
+  std::vector<Index> edge_dst(edges->size());
+  RETURN_IF_NOT_OK(BuildTable<Edge>(
+    edges, default_edge_features,
+    [&edge_src, &edge_dst](Index e, const std::shared_ptr<Edge> &edge) {
+      std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>> p;
+      RETURN_IF_NOT_OK(edge->GetNode(&p));
+      edge_src[e] = p.first->id();
+      edge_dst[e] = p.second->id();
+      return Status::OK();
+    },
+    &edges_));
+
+  // Count the neighbors of each (node, neighbor type), then place them
+  auto num_types = static_cast<int64_t>(nodes_.types.size());
+  std::vector<int64_t> neighbor_offsets(NumNodes() * num_types + 1, 0);
+  for (Index e = 0; e < NumEdges(); e++) {
+    Index src = 0, dst = 0;
+    if (!nodes_.Find(edge_src[e], &src)) {
+      RETURN_STATUS_UNEXPECTED("invalid src_id:" + std::to_string(edge_src[e]));
+    }
+    if (!nodes_.Find(edge_dst[e], &dst)) {
+      RETURN_STATUS_UNEXPECTED("invalid dst_id:" + std::to_string(edge_dst[e]));
+    }
+    edge_src[e] = src;
+    edge_dst[e] = dst;
+    neighbor_offsets[src * num_types + nodes_.SlotOf(dst) + 1]++;
+  }
+  for (size_t i = 1; i < neighbor_offsets.size(); i++) {
+    neighbor_offsets[i] += neighbor_offsets[i - 1];
+  }
+  std::vector<Index> neighbors(NumEdges());
+  std::vector<int64_t> cursor(neighbor_offsets.begin(), neighbor_offsets.end() - 1);
+  for (Index e = 0; e < NumEdges(); e++) {
+    neighbors[cursor[edge_src[e] * num_types + nodes_.SlotOf(edge_dst[e])]++] = edge_dst[e];
+  }
+  for (size_t i = 0; i + 1 < neighbor_offsets.size(); i++) {
+    std::sort(neighbors.begin() + neighbor_offsets[i], neighbors.begin() + neighbor_offsets[i + 1]);
+  }
+  neighbor_offsets_.Assign(std::move(neighbor_offsets));
+  neighbors_.Assign(std::move(neighbors));
+  edge_src_.Assign(std::move(edge_src));
+  edge_dst_.Assign(std::move(edge_dst));
+  MS_LOG(INFO) << "Built graph of " << NumNodes() << " nodes and " << NumEdges() << " edges.";
+  return Status::OK();
+}
+
+Status CsrGraph::Save(const std::string &path) const {
+  // Write aside and rename, so that a process never maps a snapshot being written
+  std::string tmp_path = path + ".tmp";
+  std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED(out.is_open(), "Failed to open graph snapshot:" + tmp_path);
+  SnapshotWriter writer(&out);
+  writer.Write(kSnapshotMagic, sizeof(kSnapshotMagic));
+  writer.Put(kSnapshotVersion);
+  writer.Put(kByteOrderMark);
+  SaveTable(nodes_, &writer);
+  SaveTable(edges_, &writer);
+  writer.PutArray(neighbor_offsets_.data(), neighbor_offsets_.size());
+  writer.PutArray(neighbors_.data(), neighbors_.size());
+  writer.PutArray(edge_src_.data(), edge_src_.size());
+  writer.PutArray(edge_dst_.data(), edge_dst_.size());
+  out.close();
+  if (out.fail()) {
+    (void)std::remove(tmp_path.c_str());
+    RETURN_STATUS_UNEXPECTED("Failed to write graph snapshot:" + tmp_path);
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    (void)std::remove(tmp_path.c_str());
+    RETURN_STATUS_UNEXPECTED("Failed to rename graph snapshot to " + path + ", errno " + std::to_string(errno));
+  }
+  MS_LOG(INFO) << "Saved graph of " << NumNodes() << " nodes and " << NumEdges() << " edges to " << path << ".";
+  return Status::OK();
+}
+
+namespace {
+// Maps a file read only, or reads it into memory where there is no mmap.
+// @param std::string path - the file
+// @param std::shared_ptr<const uint8_t> *mapping - Returned content of the file, unmapped when released
+// @param size_t *size - Returned size of the file
+// @return Status - The error code return
+Status MapFile(const std::string &path, std::shared_ptr<const uint8_t> *mapping, size_t *size) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(path.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Failed to open graph snapshot:" + path + ", errno " + std::to_string(errno));
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED("Failed to stat graph snapshot:" + path + ", errno " + std::to_string(errno));
+  }
+  auto length = static_cast<size_t>(file_stat.st_size);
+  if (length == 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED("Invalid graph snapshot, the file is empty:" + path);
+  }
+  // A shared read only mapping: all the processes which map the file use the same pages of the page cache
+  void *addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping keeps the file open
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED(addr != MAP_FAILED,
+                               "Failed to mmap graph snapshot:" + path + ", errno " + std::to_string(errno));
+  *mapping = std::shared_ptr<const uint8_t>(
+    static_cast<const uint8_t *>(addr), [length](const uint8_t *p) { (void)munmap(const_cast<uint8_t *>(p), length); });
+#else
+  // Each process reads its own copy of the snapshot
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  CHECK_FAIL_RETURN_UNEXPECTED(in.is_open(), "Failed to open graph snapshot:" + path);
+  auto length = static_cast<size_t>(in.tellg());
+  CHECK_FAIL_RETURN_UNEXPECTED(length > 0, "Invalid graph snapshot, the file is empty:" + path);
+  auto buffer = std::shared_ptr<uint8_t>(new uint8_t[length], std::default_delete<uint8_t[]>());
+  (void)in.seekg(0);
+  CHECK_FAIL_RETURN_UNEXPECTED(in.read(reinterpret_cast<char *>(buffer.get()), static_cast<std::streamsize>(length)),
+                               "Failed to read graph snapshot:" + path);
+  *mapping = std::move(buffer);
+#endif
+  *size = length;
+  return Status::OK();
+}
+}  // namespace
+
+Status CsrGraph::Map(const std::string &path) {
+  CHECK_FAIL_RETURN_UNEXPECTED(nodes_.ids.empty() && edges_.ids.empty(), "The graph is already built");
+  std::shared_ptr<const uint8_t> mapping;
+  size_t size = 0;
+  RETURN_IF_NOT_OK(MapFile(path, &mapping, &size));
+
+  SnapshotReader reader(mapping.get(), size);
+  CHECK_FAIL_RETURN_UNEXPECTED(size >= sizeof(kSnapshotMagic) &&
+                                 memcmp(mapping.get(), kSnapshotMagic, sizeof(kSnapshotMagic)) == 0,
+                               "Not a graph snapshot:" + path);
+  int64_t magic = 0, version = 0, byte_order = 0;
+  RETURN_IF_NOT_OK(reader.Get(&magic));
+  RETURN_IF_NOT_OK(reader.Get(&version));
+  RETURN_IF_NOT_OK(reader.Get(&byte_order));
+  CHECK_FAIL_RETURN_UNEXPECTED(version == kSnapshotVersion,
+                               "Unsupported graph snapshot version:" + std::to_string(version));
+  CHECK_FAIL_RETURN_UNEXPECTED(byte_order == kByteOrderMark, "The graph snapshot was written on another byte order");
+  Table nodes;
+  Table edges;
+  Array<int64_t> neighbor_offsets;
+  Array<Index> neighbors;
+  Array<Index> edge_src;
+  Array<Index> edge_dst;
+  RETURN_IF_NOT_OK(MapTable(&reader, &nodes));
+  RETURN_IF_NOT_OK(MapTable(&reader, &edges));
+  RETURN_IF_NOT_OK(reader.GetArray(&neighbor_offsets));
+  RETURN_IF_NOT_OK(reader.GetArray(&neighbors));
+  RETURN_IF_NOT_OK(reader.GetArray(&edge_src));
+  RETURN_IF_NOT_OK(reader.GetArray(&edge_dst));
+  // The structure is checked, the contents of the arrays are trusted like those of the mindrecord files
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    neighbor_offsets.size() == nodes.ids.size() * nodes.types.size() + 1 && neighbor_offsets[0] == 0 &&
+      neighbor_offsets.back() == static_cast<int64_t>(neighbors.size()) && neighbors.size() == edges.ids.size() &&
+      edge_src.size() == edges.ids.size() && edge_dst.size() == edges.ids.size(),
+    "Invalid graph snapshot, the neighbors do not match the nodes and edges");
+
+  mapping_ = std::move(mapping);
+  nodes_ = std::move(nodes);
+  edges_ = std::move(edges);
+  neighbor_offsets_ = std::move(neighbor_offsets);
+  neighbors_ = std::move(neighbors);
+  edge_src_ = std::move(edge_src);
+  edge_dst_ = std::move(edge_dst);
+  MS_LOG(INFO) << "Mapped graph of " << NumNodes() << " nodes and " << NumEdges() << " edges from " << path << ".";
+  return Status::OK();
+}
+
+bool CsrGraph::IsSnapshot(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  char magic[sizeof(kSnapshotMagic)] = {};
+  if (!in.read(magic, sizeof(magic))) {
+    return false;
+  }
+  return memcmp(magic, kSnapshotMagic, sizeof(magic)) == 0;
+}
+
+Status CsrGraph::GetNodeRange(NodeType type, Index *begin, Index *end) const {
+  int32_t slot = nodes_.TypeSlot(type);
+  if (slot < 0) {
+    std::string err_msg = "Invalid node type:" + std::to_string(type);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  *begin = nodes_.type_offsets[slot];
+  *end = nodes_.type_offsets[slot + 1];
+  return Status::OK();
+}
+
+Status CsrGraph::GetEdgeRange(EdgeType type, Index *begin, Index *end) const {
+  int32_t slot = edges_.TypeSlot(type);
+  if (slot < 0) {
+    std::string err_msg = "Invalid edge type:" + std::to_string(type);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  *begin = edges_.type_offsets[slot];
+  *end = edges_.type_offsets[slot + 1];
+  return Status::OK();
+}
+
+Status CsrGraph::FindNode(NodeIdType id, Index *node) const {
+  if (!nodes_.Find(id, node)) {
+    std::string err_msg = "Invalid node id:" + std::to_string(id);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return Status::OK();
+}
+
+Status CsrGraph::FindEdge(EdgeIdType id, Index *edge) const {
+  if (!edges_.Find(id, edge)) {
+    std::string err_msg = "Invalid edge id:" + std::to_string(id);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return Status::OK();
+}
+
+void CsrGraph::GetNeighbors(Index node, NodeType neighbor_type, const Index **begin, const Index **end) const {
+  int32_t slot = nodes_.TypeSlot(neighbor_type);
+  if (slot < 0) {
+    *begin = *end = nullptr;
+    return;
+  }
+  int64_t i = node * static_cast<int64_t>(nodes_.types.size()) + slot;
+  *begin = neighbors_.data() + neighbor_offsets_[i];
+  *end = neighbors_.data() + neighbor_offsets_[i + 1];
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
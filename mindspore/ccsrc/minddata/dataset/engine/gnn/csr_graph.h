@@ -0,0 +1,228 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_GNN_CSR_GRAPH_H_
+#define DATASET_ENGINE_GNN_CSR_GRAPH_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/engine/gnn/edge.h"
+#include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+// A graph stored in flat arrays, where nodes and edges are referred to by their position.
+//
+// Nodes are sorted by type and then by id, so the nodes of a type take a contiguous range of positions and a node
+// is found by a binary search of its id within the range of each type. The out-neighbors of a node are kept in
+// compressed sparse row form and grouped by the type of the neighbor. With T node types, the neighbors of type t of
+// the node at position i are neighbors_[neighbor_offsets_[i * T + t], neighbor_offsets_[i * T + t + 1]), sorted by
+// position. Edges are sorted the same way, by type and then by id.
+//
+// A feature is stored as one matrix per node (or edge) type, with one row for each node of the type in position
+// order. Rows of the nodes which do not have the feature are zeros, the same as the default feature.
+//
+// The arrays are either built from the GraphLoader or mapped from a snapshot file written by Save(). A mapped graph
+// is served from the page cache, so the processes of a host which map the same snapshot share one copy of it.
+class CsrGraph {
+ public:
+  using Index = int32_t;
+
+  // A read only array, which owns its elements or points into a mapped snapshot.
+  template <typename T>
+  class Array {
+   public:
+    Array() : data_(nullptr), size_(0) {}
+
+    Array(const Array &) = delete;
+
+    Array &operator=(const Array &) = delete;
+
+    // The elements of a vector stay where they are when it is moved, so data_ remains valid
+    Array(Array &&) = default;
+
+    Array &operator=(Array &&) = default;
+
+    ~Array() = default;
+
+    void Assign(std::vector<T> &&v) {
+      owned_ = std::move(v);
+      data_ = owned_.data();
+      size_ = owned_.size();
+    }
+
+    void Map(const T *data, size_t size) {
+      std::vector<T>().swap(owned_);
+      data_ = data;
+      size_ = size;
+    }
+
+    const T *data() const { return data_; }
+
+    size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    const T *begin() const { return data_; }
+
+    const T *end() const { return data_ + size_; }
+
+    const T &operator[](size_t i) const { return data_[i]; }
+
+    const T &back() const { return data_[size_ - 1]; }
+
+   private:
+    std::vector<T> owned_;
+    const T *data_;
+    size_t size_;
+  };
+
+  // The rows of one feature. data[s] holds the matrix of the type at slot s, it is empty if no node of the type
+  // has the feature.
+  struct FeatureColumn {
+    DataType type;
+    dsize_t row_bytes;
+    std::vector<dsize_t> shape;  // The shape of one row
+    std::vector<Array<uint8_t>> data;
+  };
+
+  // Nodes or edges sorted by type and then by id, with their features.
+  struct Table {
+    Array<int8_t> types;          // The distinct types, sorted. The position of a type is its slot
+    Array<Index> type_offsets;    // types.size() + 1 entries, the range of positions of each type
+    Array<int32_t> ids;           // The id at each position
+    std::map<FeatureType, FeatureColumn> features;
+
+    // @return the slot of a type, or -1 if there is no such type
+    int32_t TypeSlot(int8_t type) const;
+
+    // @return the slot of the type of the element at a position
+    int32_t SlotOf(Index pos) const;
+
+    // Binary search of an id within the range of each type.
+    // @return true if the id is found
+    bool Find(int32_t id, Index *pos) const;
+
+    // @return the row of a feature of the element at a position, or nullptr if it does not have the feature
+    const uint8_t *FeatureRow(Index pos, FeatureType feature) const;
+  };
+
+  CsrGraph() = default;
+
+  CsrGraph(const CsrGraph &) = delete;
+
+  CsrGraph &operator=(const CsrGraph &) = delete;
+
+  ~CsrGraph() = default;
+
+  // Builds the arrays from the nodes and edges made by the GraphLoader. They are released along the way.
+  // @param std::vector<std::shared_ptr<Node>> *nodes - the nodes, emptied on return
+  // @param std::vector<std::shared_ptr<Edge>> *edges - the edges, emptied on return
+  // @param std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_node_features - one zero feature for
+  //     every type of node feature, which gives the type and size of its rows
+  // @param std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_edge_features - same for the edges
+  // @return Status - The error code return
+  Status Build(std::vector<std::shared_ptr<Node>> *nodes, std::vector<std::shared_ptr<Edge>> *edges,
+               const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_node_features,
+               const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_edge_features);
+
+  // Writes the arrays into a snapshot file, which Map() can serve the graph from.
+  // @param std::string path - the snapshot file, overwritten if it exists
+  // @return Status - The error code return
+  Status Save(const std::string &path) const;
+
+  // Maps a snapshot file written by Save(). Nothing is read until it is used.
+  // @param std::string path - the snapshot file
+  // @return Status - The error code return
+  Status Map(const std::string &path);
+
+  // @param std::string path - a file
+  // @return true if the file starts like a snapshot
+  static bool IsSnapshot(const std::string &path);
+
+  Index NumNodes() const { return static_cast<Index>(nodes_.ids.size()); }
+
+  Index NumEdges() const { return static_cast<Index>(edges_.ids.size()); }
+
+  const Table &nodes() const { return nodes_; }
+
+  const Table &edges() const { return edges_; }
+
+  // Get the positions of the nodes of a type.
+  // @param NodeType type - type of node
+  // @param Index *begin, Index *end - Returned range of positions
+  // @return Status - The error code return
+  Status GetNodeRange(NodeType type, Index *begin, Index *end) const;
+
+  // Get the positions of the edges of a type.
+  // @param EdgeType type - type of edge
+  // @param Index *begin, Index *end - Returned range of positions
+  // @return Status - The error code return
+  Status GetEdgeRange(EdgeType type, Index *begin, Index *end) const;
+
+  // Find the position of a node.
+  // @param NodeIdType id - node id
+  // @param Index *node - Returned position
+  // @return Status - The error code return
+  Status FindNode(NodeIdType id, Index *node) const;
+
+  // Find the position of an edge.
+  // @param EdgeIdType id - edge id
+  // @param Index *edge - Returned position
+  // @return Status - The error code return
+  Status FindEdge(EdgeIdType id, Index *edge) const;
+
+  NodeIdType NodeId(Index node) const { return nodes_.ids[node]; }
+
+  EdgeIdType EdgeId(Index edge) const { return edges_.ids[edge]; }
+
+  // @return the position of the source node of an edge
+  Index EdgeSrc(Index edge) const { return edge_src_[edge]; }
+
+  // @return the position of the destination node of an edge
+  Index EdgeDst(Index edge) const { return edge_dst_[edge]; }
+
+  // Get the neighbors of a type of a node, sorted by position.
+  // @param Index node - position of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param const Index **begin, const Index **end - Returned range of neighbor positions, empty if there is none
+  void GetNeighbors(Index node, NodeType neighbor_type, const Index **begin, const Index **end) const;
+
+  // @param const Index *neighbor - a neighbor returned by GetNeighbors()
+  // @return the entry of the neighbor in the neighbor lists, which tells apart the edges from the nodes to it
+  int64_t EntryOf(const Index *neighbor) const { return neighbor - neighbors_.data(); }
+
+ private:
+  std::shared_ptr<const uint8_t> mapping_;  // The mapped snapshot, if any
+  Table nodes_;
+  Table edges_;
+  Array<int64_t> neighbor_offsets_;
+  Array<Index> neighbors_;
+  Array<Index> edge_src_;
+  Array<Index> edge_dst_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_ENGINE_GNN_CSR_GRAPH_H_
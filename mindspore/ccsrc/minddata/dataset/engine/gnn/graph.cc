@@ -16,6 +16,7 @@
 #include "minddata/dataset/engine/gnn/graph.h"
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <iterator>
 #include <numeric>
@@ -23,6 +24,8 @@
 
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/task_manager.h"
+#include "./securec.h"
 
 namespace mindspore {
 namespace dataset {
@@ -35,13 +38,10 @@ Graph::Graph(std::string dataset_file, int32_t num_workers)
 }
 
 Status Graph::GetAllNodes(NodeType node_type, std::shared_ptr<Tensor> *out) {
-  auto itr = node_type_map_.find(node_type);
-  if (itr == node_type_map_.end()) {
-    std::string err_msg = "Invalid node type:" + std::to_string(node_type);
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  } else {
-    RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({itr->second}, DataType(DataType::DE_INT32), out));
-  }
+  CsrGraph::Index begin = 0, end = 0;
+  RETURN_IF_NOT_OK(csr_.GetNodeRange(node_type, &begin, &end));
+  std::vector<NodeIdType> nodes(csr_.nodes().ids.begin() + begin, csr_.nodes().ids.begin() + end);
+  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({nodes}, DataType(DataType::DE_INT32), out));
   return Status::OK();
 }
 
@@ -91,13 +91,10 @@ Status Graph::ComplementVector(std::vector<std::vector<T>> *data, size_t max_siz
 }
 
 Status Graph::GetAllEdges(EdgeType edge_type, std::shared_ptr<Tensor> *out) {
-  auto itr = edge_type_map_.find(edge_type);
-  if (itr == edge_type_map_.end()) {
-    std::string err_msg = "Invalid edge type:" + std::to_string(edge_type);
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  } else {
-    RETURN_IF_NOT_OK(CreateTensorByVector<EdgeIdType>({itr->second}, DataType(DataType::DE_INT32), out));
-  }
+  CsrGraph::Index begin = 0, end = 0;
+  RETURN_IF_NOT_OK(csr_.GetEdgeRange(edge_type, &begin, &end));
+  std::vector<EdgeIdType> edges(csr_.edges().ids.begin() + begin, csr_.edges().ids.begin() + end);
+  RETURN_IF_NOT_OK(CreateTensorByVector<EdgeIdType>({edges}, DataType(DataType::DE_INT32), out));
   return Status::OK();
 }
 
@@ -109,15 +106,9 @@ Status Graph::GetNodesFromEdges(const std::vector<EdgeIdType> &edge_list, std::s
   std::vector<std::vector<NodeIdType>> node_list;
   node_list.reserve(edge_list.size());
   for (const auto &edge_id : edge_list) {
-    auto itr = edge_id_map_.find(edge_id);
-    if (itr == edge_id_map_.end()) {
-      std::string err_msg = "Invalid edge id:" + std::to_string(edge_id);
-      RETURN_STATUS_UNEXPECTED(err_msg);
-    } else {
-      std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>> nodes;
-      RETURN_IF_NOT_OK(itr->second->GetNode(&nodes));
-      node_list.push_back({nodes.first->id(), nodes.second->id()});
-    }
+    CsrGraph::Index edge = 0;
+    RETURN_IF_NOT_OK(csr_.FindEdge(edge_id, &edge));
+    node_list.push_back({csr_.NodeId(csr_.EdgeSrc(edge)), csr_.NodeId(csr_.EdgeDst(edge))});
   }
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(node_list, DataType(DataType::DE_INT32), out));
   return Status::OK();
@@ -132,9 +123,16 @@ Status Graph::GetAllNeighbors(const std::vector<NodeIdType> &node_list, NodeType
   size_t max_neighbor_num = 0;
   neighbors.resize(node_list.size());
   for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
+    CsrGraph::Index node = 0;
+    RETURN_IF_NOT_OK(csr_.FindNode(node_list[i], &node));
+    const CsrGraph::Index *begin = nullptr, *end = nullptr;
+    csr_.GetNeighbors(node, neighbor_type, &begin, &end);
+    // The node itself comes first
+    neighbors[i].reserve(end - begin + 1);
+    neighbors[i].push_back(node_list[i]);
+    for (auto itr = begin; itr != end; ++itr) {
+      neighbors[i].push_back(csr_.NodeId(*itr));
+    }
     max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
   }
 
@@ -145,9 +143,7 @@ Status Graph::GetAllNeighbors(const std::vector<NodeIdType> &node_list, NodeType
 }
 
 Status Graph::CheckSamplesNum(NodeIdType samples_num) {
-  NodeIdType all_nodes_number =
-    std::accumulate(node_type_map_.begin(), node_type_map_.end(), 0,
-                    [](NodeIdType t1, const auto &t2) -> NodeIdType { return t1 + t2.second.size(); });
+  NodeIdType all_nodes_number = csr_.NumNodes();
   if ((samples_num < 1) || (samples_num > all_nodes_number)) {
     std::string err_msg = "Wrong samples number, should be between 1 and " + std::to_string(all_nodes_number) +
                           ", got " + std::to_string(samples_num);
@@ -157,13 +153,73 @@ Status Graph::CheckSamplesNum(NodeIdType samples_num) {
 }
 
 Status Graph::CheckNeighborType(NodeType neighbor_type) {
-  if (node_type_map_.find(neighbor_type) == node_type_map_.end()) {
+  if (csr_.nodes().TypeSlot(neighbor_type) < 0) {
     std::string err_msg = "Invalid neighbor type:" + std::to_string(neighbor_type);
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
   return Status::OK();
 }
 
+Status Graph::ParallelFor(size_t n, int32_t num_workers,
+                          const std::function<Status(size_t, size_t, std::mt19937 *)> &func) {
+  const uint32_t seed = rnd_();
+  const size_t num_chunks = (n + kGnnChunkSize - 1) / kGnnChunkSize;
+  std::atomic<size_t> next_chunk(0);
+  auto worker = [&]() -> Status {
+    for (size_t chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+      std::seed_seq seq{seed, static_cast<uint32_t>(chunk)};
+      std::mt19937 rnd(seq);
+      Status rc = func(chunk * kGnnChunkSize, std::min(n, (chunk + 1) * kGnnChunkSize), &rnd);
+      if (rc.IsError()) {
+        // stop the other workers too
+        next_chunk = num_chunks;
+        return rc;
+      }
+    }
+    return Status::OK();
+  };
+  size_t num_threads = std::min(static_cast<size_t>(std::max(num_workers, 1)), num_chunks);
+  if (num_threads <= 1) {
+    return worker();
+  }
+  TaskGroup vg;
+  Status rc;
+  for (size_t i = 0; i < num_threads && rc.IsOk(); i++) {
+    rc = vg.CreateAsyncTask("GraphSampler", [&worker]() -> Status {
+      // Handshake
+      TaskManager::FindMe()->Post();
+      return worker();
+    });
+  }
+  // the workers use the locals of this function, wait for them before leaving
+  vg.join_all(Task::WaitFlag::kBlocking);
+  RETURN_IF_NOT_OK(rc);
+  RETURN_IF_NOT_OK(vg.GetTaskErrorIfAny());
+  return Status::OK();
+}
+
+void Graph::SampleNeighbors(CsrGraph::Index node, NodeType neighbor_type, int32_t samples_num, std::mt19937 *rnd,
+                            std::vector<CsrGraph::Index> *out) {
+  const CsrGraph::Index *begin = nullptr, *end = nullptr;
+  csr_.GetNeighbors(node, neighbor_type, &begin, &end);
+  if (begin == end) {
+    MS_LOG(DEBUG) << "There are no neighbors. node_id:" << csr_.NodeId(node) << " neighbor_type:" << neighbor_type;
+    // If there are no neighbors, they are filled with kDefaultNodeId
+    out->insert(out->end(), samples_num, kDefaultNodeId);
+    return;
+  }
+  std::vector<int32_t> shuffled_id(end - begin);
+  std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
+  while (samples_num > 0) {
+    std::shuffle(shuffled_id.begin(), shuffled_id.end(), *rnd);
+    int32_t num = std::min(samples_num, static_cast<int32_t>(shuffled_id.size()));
+    for (int32_t i = 0; i < num; ++i) {
+      out->emplace_back(begin[shuffled_id[i]]);
+    }
+    samples_num -= num;
+  }
+}
+
 Status Graph::GetSampledNeighbors(const std::vector<NodeIdType> &node_list,
                                   const std::vector<NodeIdType> &neighbor_nums,
                                   const std::vector<NodeType> &neighbor_types, std::shared_ptr<Tensor> *out) {
@@ -177,41 +233,41 @@ Status Graph::GetSampledNeighbors(const std::vector<NodeIdType> &node_list,
     RETURN_IF_NOT_OK(CheckNeighborType(type));
   }
   std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> input_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &input_node));
-    neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
-    std::vector<NodeIdType> input_list = {node_list[node_idx]};
-    for (size_t i = 0; i < neighbor_nums.size(); ++i) {
-      std::vector<NodeIdType> neighbors;
-      neighbors.reserve(input_list.size() * neighbor_nums[i]);
-      for (const auto &node_id : input_list) {
-        if (node_id == kDefaultNodeId) {
-          for (int32_t j = 0; j < neighbor_nums[i]; ++j) {
-            neighbors.emplace_back(kDefaultNodeId);
+  auto sample = [&](size_t begin, size_t end, std::mt19937 *rnd) -> Status {
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      CsrGraph::Index input_node = 0;
+      RETURN_IF_NOT_OK(csr_.FindNode(node_list[node_idx], &input_node));
+      neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
+      std::vector<CsrGraph::Index> input_list = {input_node};
+      for (size_t i = 0; i < neighbor_nums.size(); ++i) {
+        std::vector<CsrGraph::Index> neighbors;
+        neighbors.reserve(input_list.size() * neighbor_nums[i]);
+        for (const auto &node : input_list) {
+          if (node == kDefaultNodeId) {
+            neighbors.insert(neighbors.end(), neighbor_nums[i], kDefaultNodeId);
+          } else {
+            SampleNeighbors(node, neighbor_types[i], neighbor_nums[i], rnd, &neighbors);
           }
-        } else {
-          std::shared_ptr<Node> node;
-          RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &node));
-          std::vector<NodeIdType> out;
-          RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], &out));
-          neighbors.insert(neighbors.end(), out.begin(), out.end());
         }
+        for (const auto &node : neighbors) {
+          neighbors_vec[node_idx].emplace_back(node == kDefaultNodeId ? kDefaultNodeId : csr_.NodeId(node));
+        }
+        input_list = std::move(neighbors);
       }
-      neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
-      input_list = std::move(neighbors);
     }
-  }
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), num_workers_, sample));
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors_vec, DataType(DataType::DE_INT32), out));
   return Status::OK();
 }
 
 Status Graph::NegativeSample(const std::vector<NodeIdType> &data, const std::unordered_set<NodeIdType> &exclude_data,
-                             int32_t samples_num, std::vector<NodeIdType> *out_samples) {
+                             int32_t samples_num, std::mt19937 *rnd, std::vector<NodeIdType> *out_samples) {
   CHECK_FAIL_RETURN_UNEXPECTED(!data.empty(), "Input data is empty.");
   std::vector<NodeIdType> shuffled_id(data.size());
   std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
-  std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
+  std::shuffle(shuffled_id.begin(), shuffled_id.end(), *rnd);
   for (const auto &index : shuffled_id) {
     if (exclude_data.find(data[index]) != exclude_data.end()) {
       continue;
@@ -230,33 +286,42 @@ Status Graph::GetNegSampledNeighbors(const std::vector<NodeIdType> &node_list, N
   RETURN_IF_NOT_OK(CheckSamplesNum(samples_num));
   RETURN_IF_NOT_OK(CheckNeighborType(neg_neighbor_type));
 
+  CsrGraph::Index type_begin = 0, type_end = 0;
+  RETURN_IF_NOT_OK(csr_.GetNodeRange(neg_neighbor_type, &type_begin, &type_end));
+  const std::vector<NodeIdType> all_nodes(csr_.nodes().ids.begin() + type_begin,
+                                          csr_.nodes().ids.begin() + type_end);
   std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
   neg_neighbors_vec.resize(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
-    std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
-    std::unordered_set<NodeIdType> exclude_nodes;
-    std::transform(neighbors.begin(), neighbors.end(),
-                   std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
-                   [](const NodeIdType node) { return node; });
-    const std::vector<NodeIdType> &all_nodes = node_type_map_[neg_neighbor_type];
-    neg_neighbors_vec[node_idx].emplace_back(node->id());
-    if (all_nodes.size() > exclude_nodes.size()) {
-      while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
-        RETURN_IF_NOT_OK(NegativeSample(all_nodes, exclude_nodes, samples_num - neg_neighbors_vec[node_idx].size(),
-                                        &neg_neighbors_vec[node_idx]));
+  auto sample = [&](size_t begin, size_t end, std::mt19937 *rnd) -> Status {
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      CsrGraph::Index node = 0;
+      RETURN_IF_NOT_OK(csr_.FindNode(node_list[node_idx], &node));
+      const CsrGraph::Index *nbr_begin = nullptr, *nbr_end = nullptr;
+      csr_.GetNeighbors(node, neg_neighbor_type, &nbr_begin, &nbr_end);
+      // The node itself is excluded too if it has the type
+      std::unordered_set<NodeIdType> exclude_nodes = {node_list[node_idx]};
+      for (auto itr = nbr_begin; itr != nbr_end; ++itr) {
+        exclude_nodes.insert(csr_.NodeId(*itr));
       }
-    } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
-                    << " neg_neighbor_type:" << neg_neighbor_type;
-      // If there are no negative neighbors, they are filled with kDefaultNodeId
-      for (int32_t i = 0; i < samples_num; ++i) {
-        neg_neighbors_vec[node_idx].emplace_back(kDefaultNodeId);
+      neg_neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
+      if (all_nodes.size() > exclude_nodes.size()) {
+        while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
+          RETURN_IF_NOT_OK(NegativeSample(all_nodes, exclude_nodes,
+                                          samples_num - neg_neighbors_vec[node_idx].size(), rnd,
+                                          &neg_neighbors_vec[node_idx]));
+        }
+      } else {
+        MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node_list[node_idx]
+                      << " neg_neighbor_type:" << neg_neighbor_type;
+        // If there are no negative neighbors, they are filled with kDefaultNodeId
+        for (int32_t i = 0; i < samples_num; ++i) {
+          neg_neighbors_vec[node_idx].emplace_back(kDefaultNodeId);
+        }
       }
     }
-  }
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), num_workers_, sample));
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neg_neighbors_vec, DataType(DataType::DE_INT32), out));
   return Status::OK();
 }
@@ -264,7 +329,8 @@ Status Graph::GetNegSampledNeighbors(const std::vector<NodeIdType> &node_list, N
 Status Graph::RandomWalk(const std::vector<NodeIdType> &node_list, const std::vector<NodeType> &meta_path,
                          float step_home_param, float step_away_param, NodeIdType default_node,
                          std::shared_ptr<Tensor> *out) {
-  RETURN_IF_NOT_OK(random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node));
+  RETURN_IF_NOT_OK(
+    random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node, 1, num_workers_));
   std::vector<std::vector<NodeIdType>> walks;
   RETURN_IF_NOT_OK(random_walk_.SimulateWalk(&walks));
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({walks}, DataType(DataType::DE_INT32), out));
@@ -293,48 +359,61 @@ Status Graph::GetEdgeDefaultFeature(FeatureType feature_type, std::shared_ptr<Fe
   return Status::OK();
 }
 
+Status Graph::GatherFeature(const CsrGraph::Table &table, const std::vector<CsrGraph::Index> &positions,
+                            const std::shared_ptr<Tensor> &ids, FeatureType feature_type,
+                            const std::shared_ptr<Feature> &default_feature, std::shared_ptr<Tensor> *out) {
+  const std::shared_ptr<Tensor> &default_value = default_feature->Value();
+  TensorShape shape(default_value->shape());
+  shape = shape.PrependDim(static_cast<dsize_t>(positions.size()));
+  std::shared_ptr<Tensor> fea_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(&fea_tensor, TensorImpl::kFlexible, shape, default_value->type(), nullptr));
+
+  dsize_t row_bytes = default_value->SizeInBytes();
+  if (row_bytes > 0) {
+    uchar *dst = nullptr;
+    TensorShape remaining({-1});
+    RETURN_IF_NOT_OK(fea_tensor->StartAddrOfIndex({0}, &dst, &remaining));
+    for (const auto &pos : positions) {
+      // If no feature can be obtained, fill in the default value
+      const uint8_t *row = pos == kDefaultNodeId ? nullptr : table.FeatureRow(pos, feature_type);
+      const unsigned char *src = row != nullptr ? row : default_value->GetBuffer();
+      int ret = memcpy_s(dst, row_bytes, src, row_bytes);
+      CHECK_FAIL_RETURN_UNEXPECTED(ret == 0, "Failed to copy feature:" + std::to_string(feature_type));
+      dst += row_bytes;
+    }
+  }
+
+  TensorShape reshape(ids->shape());
+  for (auto s : default_value->shape().AsVector()) {
+    reshape = reshape.AppendDim(s);
+  }
+  RETURN_IF_NOT_OK(fea_tensor->Reshape(reshape));
+  fea_tensor->Squeeze();
+  *out = std::move(fea_tensor);
+  return Status::OK();
+}
+
 Status Graph::GetNodeFeature(const std::shared_ptr<Tensor> &nodes, const std::vector<FeatureType> &feature_types,
                              TensorRow *out) {
   if (!nodes || nodes->Size() == 0) {
     RETURN_STATUS_UNEXPECTED("Input nodes is empty");
   }
   CHECK_FAIL_RETURN_UNEXPECTED(!feature_types.empty(), "Input feature_types is empty");
+  std::vector<CsrGraph::Index> positions;
+  positions.reserve(nodes->Size());
+  for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
+    CsrGraph::Index node = kDefaultNodeId;
+    if (*node_itr != kDefaultNodeId) {
+      RETURN_IF_NOT_OK(csr_.FindNode(*node_itr, &node));
+    }
+    positions.push_back(node);
+  }
   TensorRow tensors;
   for (const auto &f_type : feature_types) {
     std::shared_ptr<Feature> default_feature;
-    // If no feature can be obtained, fill in the default value
     RETURN_IF_NOT_OK(GetNodeDefaultFeature(f_type, &default_feature));
-
-    TensorShape shape(default_feature->Value()->shape());
-    auto shape_vec = nodes->shape().AsVector();
-    dsize_t size = std::accumulate(shape_vec.begin(), shape_vec.end(), 1, std::multiplies<dsize_t>());
-    shape = shape.PrependDim(size);
     std::shared_ptr<Tensor> fea_tensor;
-    RETURN_IF_NOT_OK(
-      Tensor::CreateTensor(&fea_tensor, TensorImpl::kFlexible, shape, default_feature->Value()->type(), nullptr));
-
-    dsize_t index = 0;
-    for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
-      std::shared_ptr<Feature> feature;
-      if (*node_itr == kDefaultNodeId) {
-        feature = default_feature;
-      } else {
-        std::shared_ptr<Node> node;
-        RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
-        if (!node->GetFeatures(f_type, &feature).IsOk()) {
-          feature = default_feature;
-        }
-      }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
-      index++;
-    }
-
-    TensorShape reshape(nodes->shape());
-    for (auto s : default_feature->Value()->shape().AsVector()) {
-      reshape = reshape.AppendDim(s);
-    }
-    RETURN_IF_NOT_OK(fea_tensor->Reshape(reshape));
-    fea_tensor->Squeeze();
+    RETURN_IF_NOT_OK(GatherFeature(csr_.nodes(), positions, nodes, f_type, default_feature, &fea_tensor));
     tensors.push_back(fea_tensor);
   }
   *out = std::move(tensors);
@@ -347,38 +426,19 @@ Status Graph::GetEdgeFeature(const std::shared_ptr<Tensor> &edges, const std::ve
     RETURN_STATUS_UNEXPECTED("Input edges is empty");
   }
   CHECK_FAIL_RETURN_UNEXPECTED(!feature_types.empty(), "Input feature_types is empty");
+  std::vector<CsrGraph::Index> positions;
+  positions.reserve(edges->Size());
+  for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
+    CsrGraph::Index edge = 0;
+    RETURN_IF_NOT_OK(csr_.FindEdge(*edge_itr, &edge));
+    positions.push_back(edge);
+  }
   TensorRow tensors;
   for (const auto &f_type : feature_types) {
     std::shared_ptr<Feature> default_feature;
-    // If no feature can be obtained, fill in the default value
     RETURN_IF_NOT_OK(GetEdgeDefaultFeature(f_type, &default_feature));
-
-    TensorShape shape(default_feature->Value()->shape());
-    auto shape_vec = edges->shape().AsVector();
-    dsize_t size = std::accumulate(shape_vec.begin(), shape_vec.end(), 1, std::multiplies<dsize_t>());
-    shape = shape.PrependDim(size);
     std::shared_ptr<Tensor> fea_tensor;
-    RETURN_IF_NOT_OK(
-      Tensor::CreateTensor(&fea_tensor, TensorImpl::kFlexible, shape, default_feature->Value()->type(), nullptr));
-
-    dsize_t index = 0;
-    for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
-      std::shared_ptr<Edge> edge;
-      RETURN_IF_NOT_OK(GetEdgeByEdgeId(*edge_itr, &edge));
-      std::shared_ptr<Feature> feature;
-      if (!edge->GetFeatures(f_type, &feature).IsOk()) {
-        feature = default_feature;
-      }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
-      index++;
-    }
-
-    TensorShape reshape(edges->shape());
-    for (auto s : default_feature->Value()->shape().AsVector()) {
-      reshape = reshape.AppendDim(s);
-    }
-    RETURN_IF_NOT_OK(fea_tensor->Reshape(reshape));
-    fea_tensor->Squeeze();
+    RETURN_IF_NOT_OK(GatherFeature(csr_.edges(), positions, edges, f_type, default_feature, &fea_tensor));
     tensors.push_back(fea_tensor);
   }
   *out = std::move(tensors);
@@ -391,41 +451,27 @@ Status Graph::Init() {
 }
 
 Status Graph::GetMetaInfo(MetaInfo *meta_info) {
-  meta_info->node_type.resize(node_type_map_.size());
-  std::transform(node_type_map_.begin(), node_type_map_.end(), meta_info->node_type.begin(),
-                 [](auto itr) { return itr.first; });
-  std::sort(meta_info->node_type.begin(), meta_info->node_type.end());
-
-  meta_info->edge_type.resize(edge_type_map_.size());
-  std::transform(edge_type_map_.begin(), edge_type_map_.end(), meta_info->edge_type.begin(),
-                 [](auto itr) { return itr.first; });
-  std::sort(meta_info->edge_type.begin(), meta_info->edge_type.end());
-
-  for (const auto &node : node_type_map_) {
-    meta_info->node_num[node.first] = node.second.size();
+  const CsrGraph::Table &nodes = csr_.nodes();
+  meta_info->node_type.assign(nodes.types.begin(), nodes.types.end());
+  for (size_t i = 0; i < nodes.types.size(); i++) {
+    meta_info->node_num[nodes.types[i]] = nodes.type_offsets[i + 1] - nodes.type_offsets[i];
   }
 
-  for (const auto &edge : edge_type_map_) {
-    meta_info->edge_num[edge.first] = edge.second.size();
+  const CsrGraph::Table &edges = csr_.edges();
+  meta_info->edge_type.assign(edges.types.begin(), edges.types.end());
+  for (size_t i = 0; i < edges.types.size(); i++) {
+    meta_info->edge_num[edges.types[i]] = edges.type_offsets[i + 1] - edges.type_offsets[i];
   }
 
-  for (const auto &node_feature : node_feature_map_) {
-    for (auto type : node_feature.second) {
-      meta_info->node_feature_type.emplace_back(type);
-    }
+  for (const auto &node_feature : default_node_feature_map_) {
+    meta_info->node_feature_type.emplace_back(node_feature.first);
   }
   std::sort(meta_info->node_feature_type.begin(), meta_info->node_feature_type.end());
-  auto unique_node = std::unique(meta_info->node_feature_type.begin(), meta_info->node_feature_type.end());
-  meta_info->node_feature_type.erase(unique_node, meta_info->node_feature_type.end());
 
-  for (const auto &edge_feature : edge_feature_map_) {
-    for (const auto &type : edge_feature.second) {
-      meta_info->edge_feature_type.emplace_back(type);
-    }
+  for (const auto &edge_feature : default_edge_feature_map_) {
+    meta_info->edge_feature_type.emplace_back(edge_feature.first);
   }
   std::sort(meta_info->edge_feature_type.begin(), meta_info->edge_feature_type.end());
-  auto unique_edge = std::unique(meta_info->edge_feature_type.begin(), meta_info->edge_feature_type.end());
-  meta_info->edge_feature_type.erase(unique_edge, meta_info->edge_feature_type.end());
   return Status::OK();
 }
 
@@ -443,41 +489,48 @@ Status Graph::GraphInfo(py::dict *out) {
 }
 #endif
 
-Status Graph::LoadNodeAndEdge() {
-  GraphLoader gl(dataset_file_, num_workers_);
-  // ask graph_loader to load everything into memory
-  RETURN_IF_NOT_OK(gl.InitAndLoad());
-  // get all maps
-  RETURN_IF_NOT_OK(gl.GetNodesAndEdges(&node_id_map_, &edge_id_map_, &node_type_map_, &edge_type_map_,
-                                       &node_feature_map_, &edge_feature_map_, &default_node_feature_map_,
-                                       &default_edge_feature_map_));
+Status Graph::SaveSnapshot(const std::string &snapshot_file) {
+  CHECK_FAIL_RETURN_UNEXPECTED(snapshot_file != dataset_file_, "The snapshot can't overwrite the dataset file");
+  RETURN_IF_NOT_OK(csr_.Save(snapshot_file));
   return Status::OK();
 }
 
-Status Graph::GetNodeByNodeId(NodeIdType id, std::shared_ptr<Node> *node) {
-  auto itr = node_id_map_.find(id);
-  if (itr == node_id_map_.end()) {
-    std::string err_msg = "Invalid node id:" + std::to_string(id);
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  } else {
-    *node = itr->second;
+Status Graph::MakeDefaultFeatures(const CsrGraph::Table &table,
+                                  std::unordered_map<FeatureType, std::shared_ptr<Feature>> *default_feature_map) {
+  for (const auto &f : table.features) {
+    std::shared_ptr<Tensor> zero_tensor;
+    RETURN_IF_NOT_OK(
+      Tensor::CreateTensor(&zero_tensor, TensorImpl::kFlexible, TensorShape(f.second.shape), f.second.type));
+    RETURN_IF_NOT_OK(zero_tensor->Zero());
+    (*default_feature_map)[f.first] = std::make_shared<Feature>(f.first, zero_tensor);
   }
   return Status::OK();
 }
 
-Status Graph::GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge) {
-  auto itr = edge_id_map_.find(id);
-  if (itr == edge_id_map_.end()) {
-    std::string err_msg = "Invalid edge id:" + std::to_string(id);
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  } else {
-    *edge = itr->second;
+Status Graph::LoadNodeAndEdge() {
+  if (CsrGraph::IsSnapshot(dataset_file_)) {
+    RETURN_IF_NOT_OK(csr_.Map(dataset_file_));
+    RETURN_IF_NOT_OK(MakeDefaultFeatures(csr_.nodes(), &default_node_feature_map_));
+    RETURN_IF_NOT_OK(MakeDefaultFeatures(csr_.edges(), &default_edge_feature_map_));
+    return Status::OK();
   }
+  GraphLoader gl(dataset_file_, num_workers_);
+  // ask graph_loader to load everything into memory
+  RETURN_IF_NOT_OK(gl.InitAndLoad());
+  // move the nodes and edges into the arrays of the graph
+  RETURN_IF_NOT_OK(gl.GetCsrGraph(&csr_, &default_node_feature_map_, &default_edge_feature_map_));
   return Status::OK();
 }
 
 Graph::RandomWalkBase::RandomWalkBase(Graph *graph)
-    : graph_(graph), step_home_param_(1.0), step_away_param_(1.0), default_node_(-1), num_walks_(1), num_workers_(1) {}
+    : graph_(graph),
+      step_home_param_(1.0),
+      step_away_param_(1.0),
+      default_node_(-1),
+      num_walks_(1),
+      num_workers_(1),
+      table_home_param_(0.0),
+      table_away_param_(0.0) {}
 
 Status Graph::RandomWalkBase::Build(const std::vector<NodeIdType> &node_list, const std::vector<NodeType> &meta_path,
                                     float step_home_param, float step_away_param, const NodeIdType default_node,
@@ -516,39 +569,143 @@ Status Graph::RandomWalkBase::Build(const std::vector<NodeIdType> &node_list, co
   default_node_ = default_node;
   num_walks_ = num_walks;
   num_workers_ = num_workers;
+  RETURN_IF_NOT_OK(BuildAliasTables());
+  return Status::OK();
+}
+
+Status Graph::RandomWalkBase::BuildAliasTables() {
+  if (step_home_param_ != table_home_param_ || step_away_param_ != table_away_param_) {
+    alias_tables_.clear();
+    table_home_param_ = step_home_param_;
+    table_away_param_ = step_away_param_;
+  }
+  if (Uniform()) {
+    return Status::OK();
+  }
+  for (size_t i = 1; i < meta_path_.size(); i++) {
+    auto key = std::make_pair(meta_path_[i - 1], meta_path_[i]);
+    if (alias_tables_.find(key) == alias_tables_.end()) {
+      AliasTable table;
+      RETURN_IF_NOT_OK(BuildAliasTable(key.first, key.second, &table));
+      alias_tables_.emplace(key, std::move(table));
+    }
+  }
+  return Status::OK();
+}
+
+Status Graph::RandomWalkBase::BuildAliasTable(NodeType t1, NodeType t2, AliasTable *table) {
+  const CsrGraph &csr = graph_->csr_;
+  // Size the table of every edge src -> dst with dst of type t1, it is over the neighbors of type t2 of dst
+  table->offsets.assign(static_cast<size_t>(csr.NumEdges()) + 1, 0);
+  for (CsrGraph::Index src = 0; src < csr.NumNodes(); src++) {
+    const CsrGraph::Index *begin = nullptr, *end = nullptr;
+    csr.GetNeighbors(src, t1, &begin, &end);
+    for (const CsrGraph::Index *dst = begin; dst != end; ++dst) {
+      const CsrGraph::Index *dst_begin = nullptr, *dst_end = nullptr;
+      csr.GetNeighbors(*dst, t2, &dst_begin, &dst_end);
+      table->offsets[csr.EntryOf(dst) + 1] = dst_end - dst_begin;
+    }
+  }
+  for (size_t k = 1; k < table->offsets.size(); k++) {
+    table->offsets[k] += table->offsets[k - 1];
+  }
+  table->prob.resize(table->offsets.back());
+  table->alias.resize(table->offsets.back());
+
+  auto build = [this, &csr, t1, t2, table](size_t first, size_t last, std::mt19937 *) -> Status {
+    std::vector<int32_t> smaller;
+    std::vector<int32_t> larger;
+    for (auto src = static_cast<CsrGraph::Index>(first); src < static_cast<CsrGraph::Index>(last); src++) {
+      const CsrGraph::Index *src_begin = nullptr, *src_end = nullptr;
+      csr.GetNeighbors(src, t1, &src_begin, &src_end);
+      for (const CsrGraph::Index *dst = src_begin; dst != src_end; ++dst) {
+        const CsrGraph::Index *dst_begin = nullptr, *dst_end = nullptr;
+        csr.GetNeighbors(*dst, t2, &dst_begin, &dst_end);
+        auto k = static_cast<int32_t>(dst_end - dst_begin);
+        float *prob = table->prob.data() + table->offsets[csr.EntryOf(dst)];
+        int32_t *alias = table->alias.data() + table->offsets[csr.EntryOf(dst)];
+        float sum = 0.0;
+        for (int32_t i = 0; i < k; i++) {
+          const CsrGraph::Index dst_nbr = dst_begin[i];
+          if (dst_nbr == src) {
+            prob[i] = 1.0 / step_home_param_;  // replace 1.0 with G[dst][dst_nbr]['weight']
+          } else if (std::binary_search(src_begin, src_end, dst_nbr)) {
+            // stay close, this node connect both src and dst
+            prob[i] = 1.0;  // replace 1.0 with G[dst][dst_nbr]['weight']
+          } else {
+            // step far away
+            prob[i] = 1.0 / step_away_param_;  // replace 1.0 with G[dst][dst_nbr]['weight']
+          }
+          sum += prob[i];
+        }
+        // Vose's alias method: split the scaled probabilities into k columns of height 1, each holding at most
+        // two outcomes
+        smaller.clear();
+        larger.clear();
+        for (int32_t i = 0; i < k; i++) {
+          prob[i] = prob[i] * k / sum;
+          alias[i] = i;
+          prob[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
+        }
+        while (!smaller.empty() && !larger.empty()) {
+          int32_t small = smaller.back();
+          smaller.pop_back();
+          int32_t large = larger.back();
+          larger.pop_back();
+          alias[small] = large;
+          prob[large] = prob[large] + prob[small] - 1.0;
+          prob[large] < 1.0 ? smaller.push_back(large) : larger.push_back(large);
+        }
+        // What is left is 1 up to rounding errors
+        for (int32_t i : smaller) {
+          prob[i] = 1.0;
+        }
+        for (int32_t i : larger) {
+          prob[i] = 1.0;
+        }
+      }
+    }
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(graph_->ParallelFor(csr.NumNodes(), num_workers_, build));
   return Status::OK();
 }
 
-Status Graph::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path) {
+Status Graph::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::mt19937 *rnd,
+                                           std::vector<NodeIdType> *walk_path) {
   // Simulate a random walk starting from start node.
+  const CsrGraph &csr = graph_->csr_;
   auto walk = std::vector<NodeIdType>(1, start_node);  // walk is an vector
+  walk.reserve(meta_path_.size() + 1);
+  CsrGraph::Index cur_node = 0;
+  RETURN_IF_NOT_OK(csr.FindNode(start_node, &cur_node));
+  int64_t prev_entry = -1;  // the edge taken by the previous step
+  std::uniform_real_distribution<float> distribution(0.0, 1.0);
   // walk simulate
   while (walk.size() - 1 < meta_path_.size()) {
-    // current nodE
-    auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
-
+    size_t step = walk.size() - 1;
     // current neighbors
-    std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
-    std::sort(cur_neighbors.begin(), cur_neighbors.end());
+    const CsrGraph::Index *begin = nullptr, *end = nullptr;
+    csr.GetNeighbors(cur_node, meta_path_[step], &begin, &end);
 
     // break if no neighbors
-    if (cur_neighbors.empty()) {
+    if (begin == end) {
       break;
     }
 
-    // walk by the fist node, then by the previous 2 nodes
-    std::shared_ptr<StochasticIndex> stochastic_index;
-    if (walk.size() == 1) {
-      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], &stochastic_index));
-    } else {
-      NodeIdType prev_node_id = walk[walk.size() - 2];
-      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, &stochastic_index));
+    // walk by the fist node, which is uniform, then by the previous 2 nodes
+    std::uniform_int_distribution<int64_t> pick(0, end - begin - 1);
+    int64_t next = pick(*rnd);
+    if (step > 0 && !Uniform()) {
+      const AliasTable &table = alias_tables_.at(std::make_pair(meta_path_[step - 1], meta_path_[step]));
+      int64_t offset = table.offsets[prev_entry];
+      if (distribution(*rnd) >= table.prob[offset + next]) {
+        next = table.alias[offset + next];
+      }
     }
-    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index)];
-    walk.push_back(next_node_id);
+    prev_entry = csr.EntryOf(begin + next);
+    cur_node = begin[next];
+    walk.push_back(csr.NodeId(cur_node));
   }
 
   while (walk.size() - 1 < meta_path_.size()) {
@@ -560,122 +717,18 @@ Status Graph::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::ve
 }
 
 Status Graph::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
-  for (int32_t i = 0; i < num_walks_; i++) {
-    for (const auto &node : node_list_) {
-      std::vector<NodeIdType> walk;
-      RETURN_IF_NOT_OK(Node2vecWalk(node, &walk));
-      walks->push_back(walk);
-    }
-  }
-  return Status::OK();
-}
-
-Status Graph::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                                                 std::shared_ptr<StochasticIndex> *node_probability) {
-  // Generate alias nodes
-  std::shared_ptr<Node> node;
-  graph_->GetNodeByNodeId(node_id, &node);
-  std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
-  std::sort(neighbors.begin(), neighbors.end());
-  auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
-  *node_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
-  return Status::OK();
-}
-
-Status Graph::RandomWalkBase::GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                                                 std::shared_ptr<StochasticIndex> *edge_probability) {
-  // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  graph_->GetNodeByNodeId(src, &src_node);
-  std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
-
-  std::shared_ptr<Node> dst_node;
-  graph_->GetNodeByNodeId(dst, &dst_node);
-  std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
-
-  std::sort(dst_neighbors.begin(), dst_neighbors.end());
-  std::vector<float> non_normalized_probability;
-  for (const auto &dst_nbr : dst_neighbors) {
-    if (dst_nbr == src) {
-      non_normalized_probability.push_back(1.0 / step_home_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
-      continue;
-    }
-    auto it = std::find(src_neighbors.begin(), src_neighbors.end(), dst_nbr);
-    if (it != src_neighbors.end()) {
-      // stay close, this node connect both src and dst
-      non_normalized_probability.push_back(1.0);  // replace 1.0 with G[dst][dst_nbr]['weight']
-    } else {
-      // step far away
-      non_normalized_probability.push_back(1.0 / step_away_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
+  // The walks of every round over the nodes, the rounds one after the other
+  const size_t num_nodes = node_list_.size();
+  walks->resize(num_walks_ * num_nodes);
+  auto simulate = [this, walks, num_nodes](size_t begin, size_t end, std::mt19937 *rnd) -> Status {
+    for (size_t i = begin; i < end; i++) {
+      RETURN_IF_NOT_OK(Node2vecWalk(node_list_[i % num_nodes], rnd, &(*walks)[i]));
     }
-  }
-
-  *edge_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(graph_->ParallelFor(walks->size(), num_workers_, simulate));
   return Status::OK();
 }
-
-StochasticIndex Graph::RandomWalkBase::GenerateProbability(const std::vector<float> &probability) {
-  uint32_t K = probability.size();
-  std::vector<int32_t> switch_to_large_index(K, 0);
-  std::vector<float> weight(K, .0);
-  std::vector<int32_t> smaller;
-  std::vector<int32_t> larger;
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(-kGnnEpsilon, kGnnEpsilon);
-  float accumulate_threshold = 0.0;
-  for (uint32_t i = 0; i < K; i++) {
-    float threshold_one = distribution(random_device);
-    accumulate_threshold += threshold_one;
-    weight[i] = i < K - 1 ? probability[i] * K + threshold_one : probability[i] * K - accumulate_threshold;
-    weight[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
-  }
-
-  while ((!smaller.empty()) && (!larger.empty())) {
-    uint32_t small = smaller.back();
-    smaller.pop_back();
-    uint32_t large = larger.back();
-    larger.pop_back();
-    switch_to_large_index[small] = large;
-    weight[large] = weight[large] + weight[small] - 1.0;
-    weight[large] < 1.0 ? smaller.push_back(large) : larger.push_back(large);
-  }
-  return StochasticIndex(switch_to_large_index, weight);
-}
-
-uint32_t Graph::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
-  const uint32_t size_of_index = switch_to_large_index.size();
-
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(0.0, 1.0);
-
-  // Generate random integer between [0, K)
-  uint32_t random_idx = std::floor(distribution(random_device) * size_of_index);
-
-  if (distribution(random_device) < weight[random_idx]) {
-    return random_idx;
-  }
-  return switch_to_large_index[random_idx];
-}
-
-template <typename T>
-std::vector<float> Graph::RandomWalkBase::Normalize(const std::vector<T> &non_normalized_probability) {
-  float sum_probability =
-    1.0 * std::accumulate(non_normalized_probability.begin(), non_normalized_probability.end(), 0);
-  if (sum_probability < kGnnEpsilon) {
-    sum_probability = 1.0;
-  }
-  std::vector<float> normalized_probability;
-  std::transform(non_normalized_probability.begin(), non_normalized_probability.end(),
-                 std::back_inserter(normalized_probability), [&](T value) -> float { return value / sum_probability; });
-  return normalized_probability;
-}
 }  // namespace gnn
 }  // namespace dataset
 }  // namespace mindspore
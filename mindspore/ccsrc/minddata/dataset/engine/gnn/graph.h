@@ -17,7 +17,9 @@
 #define DATASET_ENGINE_GNN_GRAPH_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
+#include <random>
 #include <string>
 #include <map>
 #include <unordered_map>
@@ -27,6 +29,7 @@
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/engine/gnn/csr_graph.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 #include "minddata/dataset/engine/gnn/feature.h"
 #include "minddata/dataset/engine/gnn/node.h"
@@ -39,7 +42,7 @@ namespace gnn {
 
 const float kGnnEpsilon = 0.0001;
 const uint32_t kMaxNumWalks = 80;
-using StochasticIndex = std::pair<std::vector<int32_t>, std::vector<float>>;
+const size_t kGnnChunkSize = 64;  // The number of items of a batch sampled from one random stream
 
 struct MetaInfo {
   std::vector<NodeType> node_type;
@@ -147,6 +150,12 @@ class Graph {
 
   Status Init();
 
+  // Write the graph into a snapshot file. A Graph made with the snapshot as its dataset_file maps it instead of
+  // loading the mindrecord files.
+  // @param std::string snapshot_file - the snapshot file
+  // @return Status - The error code return
+  Status SaveSnapshot(const std::string &snapshot_file);
+
  private:
   class RandomWalkBase {
    public:
@@ -161,20 +170,31 @@ class Graph {
     Status SimulateWalk(std::vector<std::vector<NodeIdType>> *walks);
 
    private:
-    Status Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path);
-
-    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                              std::shared_ptr<StochasticIndex> *node_probability);
-
-    Status GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                              std::shared_ptr<StochasticIndex> *edge_probability);
-
-    static StochasticIndex GenerateProbability(const std::vector<float> &probability);
-
-    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index);
-
-    template <typename T>
-    std::vector<float> Normalize(const std::vector<T> &non_normalized_probability);
+    // The alias tables of the steps to a node of type t2 coming from a node of type t1. The step from the edge at
+    // entry k of the neighbor lists, whose destination has type t1, picks one of the neighbors of type t2 of that
+    // destination with the table prob[offsets[k], offsets[k + 1]) and alias[offsets[k], offsets[k + 1]).
+    struct AliasTable {
+      std::vector<int64_t> offsets;
+      std::vector<float> prob;
+      std::vector<int32_t> alias;
+    };
+
+    Status Node2vecWalk(const NodeIdType &start_node, std::mt19937 *rnd, std::vector<NodeIdType> *walk_path);
+
+    // @return true if every neighbor is as likely as the others whatever the previous node, the walk then needs no
+    // alias table
+    bool Uniform() const { return step_home_param_ == 1.0 && step_away_param_ == 1.0; }
+
+    // Build the alias tables of the consecutive types of the meta path which are not built yet
+    // @return Status - The error code return
+    Status BuildAliasTables();
+
+    // Build the alias table of the steps from type t1 to type t2
+    // @param NodeType t1 - type of the current node
+    // @param NodeType t2 - type of the next node
+    // @param AliasTable *table - Returned table
+    // @return Status - The error code return
+    Status BuildAliasTable(NodeType t1, NodeType t2, AliasTable *table);
 
     Graph *graph_;
     std::vector<NodeIdType> node_list_;
@@ -185,12 +205,24 @@ class Graph {
 
     int32_t num_walks_;    // Number of walks per source. Default is 1
     int32_t num_workers_;  // The number of worker threads. Default is 1
+
+    // The tables only depend on the graph and the parameters, they are kept until the parameters change
+    std::map<std::pair<NodeType, NodeType>, AliasTable> alias_tables_;
+    float table_home_param_;
+    float table_away_param_;
   };
 
-  // Load graph data from mindrecord file
+  // Load graph data from mindrecord file, or map it from a snapshot file
   // @return Status - The error code return
   Status LoadNodeAndEdge();
 
+  // Make the default features of the nodes or edges of a mapped snapshot
+  // @param CsrGraph::Table &table - the nodes or edges
+  // @param std::unordered_map<FeatureType, std::shared_ptr<Feature>> *default_feature_map - Returned zero features
+  // @return Status - The error code return
+  Status MakeDefaultFeatures(const CsrGraph::Table &table,
+                             std::unordered_map<FeatureType, std::shared_ptr<Feature>> *default_feature_map);
+
   // Create Tensor By Vector
   // @param std::vector<std::vector<T>> &data -
   // @param DataType type -
@@ -219,26 +251,45 @@ class Graph {
   // @return Status - The error code return
   Status GetEdgeDefaultFeature(FeatureType feature_type, std::shared_ptr<Feature> *out_feature);
 
-  // Find node object using node id
-  // @param NodeIdType id -
-  // @param std::shared_ptr<Node> *node - Returned node object
-  // @return Status - The error code return
-  Status GetNodeByNodeId(NodeIdType id, std::shared_ptr<Node> *node);
-
-  // Find edge object using edge id
-  // @param EdgeIdType id -
-  // @param std::shared_ptr<Node> *edge - Returned edge object
+  // Sample neighbors of a node. Once all the neighbors are taken, the sampling starts over.
+  // @param CsrGraph::Index node - position of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param int32_t samples_num - Number of neighbors to be acquired
+  // @param std::mt19937 *rnd - random engine of the calling worker
+  // @param std::vector<CsrGraph::Index> *out - Sampled neighbor positions appended, or -1 if there is no neighbor
+  void SampleNeighbors(CsrGraph::Index node, NodeType neighbor_type, int32_t samples_num, std::mt19937 *rnd,
+                       std::vector<CsrGraph::Index> *out);
+
+  // Copy the feature rows of nodes or edges into a tensor shaped like the ids with the feature shape appended.
+  // @param CsrGraph::Table &table - the nodes or the edges of the graph
+  // @param std::vector<CsrGraph::Index> &positions - the positions of the ids, -1 takes the default feature
+  // @param std::shared_ptr<Tensor> &ids - the ids, which give the shape
+  // @param FeatureType feature_type -
+  // @param std::shared_ptr<Feature> &default_feature -
+  // @param std::shared_ptr<Tensor> *out - Returned features
   // @return Status - The error code return
-  Status GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge);
+  Status GatherFeature(const CsrGraph::Table &table, const std::vector<CsrGraph::Index> &positions,
+                       const std::shared_ptr<Tensor> &ids, FeatureType feature_type,
+                       const std::shared_ptr<Feature> &default_feature, std::shared_ptr<Tensor> *out);
 
   // Negative sampling
   // @param std::vector<NodeIdType> &input_data - The data set to be sampled
   // @param std::unordered_set<NodeIdType> &exclude_data - Data to be excluded
   // @param int32_t samples_num -
+  // @param std::mt19937 *rnd - random engine of the calling worker
   // @param std::vector<NodeIdType> *out_samples - Sampling results returned
   // @return Status - The error code return
   Status NegativeSample(const std::vector<NodeIdType> &input_data, const std::unordered_set<NodeIdType> &exclude_data,
-                        int32_t samples_num, std::vector<NodeIdType> *out_samples);
+                        int32_t samples_num, std::mt19937 *rnd, std::vector<NodeIdType> *out_samples);
+
+  // Run func over the items [0, n) of a batch in chunks of kGnnChunkSize, shared by num_workers threads. Each chunk
+  // draws from its own random engine, seeded with its index and a seed drawn from rnd_ once per call, so the results
+  // are the same whatever the number of threads.
+  // @param size_t n - number of items
+  // @param int32_t num_workers - number of threads
+  // @param std::function func - called with the range of items of a chunk and its random engine
+  // @return Status - The error code return
+  Status ParallelFor(size_t n, int32_t num_workers, const std::function<Status(size_t, size_t, std::mt19937 *)> &func);
 
   Status CheckSamplesNum(NodeIdType samples_num);
 
@@ -249,14 +300,7 @@ class Graph {
   std::mt19937 rnd_;
   RandomWalkBase random_walk_;
 
-  std::unordered_map<NodeType, std::vector<NodeIdType>> node_type_map_;
-  std::unordered_map<NodeIdType, std::shared_ptr<Node>> node_id_map_;
-
-  std::unordered_map<EdgeType, std::vector<EdgeIdType>> edge_type_map_;
-  std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> edge_id_map_;
-
-  std::unordered_map<NodeType, std::unordered_set<FeatureType>> node_feature_map_;
-  std::unordered_map<EdgeType, std::unordered_set<FeatureType>> edge_feature_map_;
+  CsrGraph csr_;
 
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> default_node_feature_map_;
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> default_edge_feature_map_;
@@ -75,6 +75,25 @@ Status GraphLoader::GetNodesAndEdges(NodeIdMap *n_id_map, EdgeIdMap *e_id_map, N
   return Status::OK();
 }
 
+Status GraphLoader::GetCsrGraph(CsrGraph *graph, DefaultNodeFeatureMap *default_node_feature_map,
+                                DefaultEdgeFeatureMap *default_edge_feature_map) {
+  std::vector<std::shared_ptr<Node>> nodes;
+  for (std::deque<std::shared_ptr<Node>> &dq : n_deques_) {
+    nodes.insert(nodes.end(), dq.begin(), dq.end());
+    std::deque<std::shared_ptr<Node>>().swap(dq);
+  }
+  std::vector<std::shared_ptr<Edge>> edges;
+  for (std::deque<std::shared_ptr<Edge>> &dq : e_deques_) {
+    edges.insert(edges.end(), dq.begin(), dq.end());
+    std::deque<std::shared_ptr<Edge>>().swap(dq);
+  }
+  NodeFeatureMap n_feature_map;
+  EdgeFeatureMap e_feature_map;
+  MergeFeatureMaps(&n_feature_map, &e_feature_map, default_node_feature_map, default_edge_feature_map);
+  RETURN_IF_NOT_OK(graph->Build(&nodes, &edges, *default_node_feature_map, *default_edge_feature_map));
+  return Status::OK();
+}
+
 Status GraphLoader::InitAndLoad() {
   CHECK_FAIL_RETURN_UNEXPECTED(num_workers_ > 0, "num_reader can't be < 1\n");
   CHECK_FAIL_RETURN_UNEXPECTED(row_id_ == 0, "InitAndLoad Can only be called once!\n");
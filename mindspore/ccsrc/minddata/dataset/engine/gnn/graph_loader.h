@@ -26,6 +26,7 @@
 
 #include "minddata/dataset/core/data_type.h"
 #include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/gnn/csr_graph.h"
 #include "minddata/dataset/engine/gnn/feature.h"
 #include "minddata/dataset/engine/gnn/graph.h"
 #include "minddata/dataset/engine/gnn/node.h"
@@ -66,6 +67,15 @@ class GraphLoader {
   Status GetNodesAndEdges(NodeIdMap *, EdgeIdMap *, NodeTypeMap *, EdgeTypeMap *, NodeFeatureMap *, EdgeFeatureMap *,
                           DefaultNodeFeatureMap *, DefaultEdgeFeatureMap *);
 
+  // this function moves all the nodes and edges loaded into the flat arrays of a CsrGraph, without connecting the
+  // node objects to each other. The default features give the type and size of each feature.
+  // @param CsrGraph *graph - the graph to build
+  // @param DefaultNodeFeatureMap *default_node_feature_map - returned default node features
+  // @param DefaultEdgeFeatureMap *default_edge_feature_map - returned default edge features
+  // @return Status - the status code
+  Status GetCsrGraph(CsrGraph *graph, DefaultNodeFeatureMap *default_node_feature_map,
+                     DefaultEdgeFeatureMap *default_edge_feature_map);
+
  private:
   //
   // worker thread that reads mindrecord file
@@ -14,44 +14,137 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
 #include "minddata/dataset/engine/datasetops/map_op.h"
+#include "minddata/dataset/kernels/image/fused_crop_flip_op.h"
+#include "minddata/dataset/kernels/image/fused_normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+using Repeat = TensorOpFusionPass::OpMatcher::Repeat;
 
-Status TensorOpFusionPass::RunOnNode(std::shared_ptr<MapOp> node, bool *modified) {
-  // Most primitive pattern: DecodeOp immediately followed by RandomCropAndResizeOp
-  // Abstract into a more general member function that can find any pattern, expressed
-  // by regular expressions, for instance.
-  // Add a list of optimisation policies. For now, just this lambda
-  auto FindPattern = [](auto &tfuncs) {
-    auto it =
-      std::find_if(tfuncs.begin(), tfuncs.end(), [](const auto &tf) -> bool { return tf->Name() == kDecodeOp; });
-    auto next = it + 1;
-    if (it != tfuncs.end() && next != tfuncs.end() && (*next)->Name() == kRandomCropAndResizeOp) {
-      return it;
+// DecodeOp immediately followed by RandomCropAndResizeOp: only the cropped part of the image is decoded
+Status FuseDecodeRandomCropResize(const TensorOpFusionPass::OpList &ops, std::shared_ptr<TensorOp> *fused) {
+  auto op = static_cast<RandomCropAndResizeOp *>(ops[1].get());
+  *fused = std::make_shared<RandomCropDecodeResizeOp>(*op);
+  return Status::OK();
+}
+
+// [Decode] [Resize] [Rescale] Normalize [HwcToChw]: a single pass computes the normalized float image
+Status FuseNormalize(const TensorOpFusionPass::OpList &ops, std::shared_ptr<TensorOp> *fused) {
+  if (ops.size() < 2) {
+    return Status::OK();
+  }
+  std::shared_ptr<DecodeOp> decode;
+  std::shared_ptr<ResizeOp> resize;
+  const RescaleOp *rescale = nullptr;
+  const NormalizeOp *normalize = nullptr;
+  bool hwc_to_chw = false;
+  for (auto &op : ops) {
+    std::string name = op->Name();
+    if (name == kDecodeOp) {
+      decode = std::static_pointer_cast<DecodeOp>(op);
+    } else if (name == kResizeOp) {
+      resize = std::static_pointer_cast<ResizeOp>(op);
+    } else if (name == kRescaleOp) {
+      rescale = static_cast<const RescaleOp *>(op.get());
+    } else if (name == kNormalizeOp) {
+      normalize = static_cast<const NormalizeOp *>(op.get());
     } else {
-      return tfuncs.end();
+      hwc_to_chw = true;
     }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(normalize != nullptr, "The normalize pattern matched no NormalizeOp");
+  *fused = std::make_shared<FusedNormalizeOp>(decode, resize, rescale, *normalize, hwc_to_chw);
+  return Status::OK();
+}
+
+// A chain of crops and flips: the output is copied once from the final window of the input
+Status FuseCropFlip(const TensorOpFusionPass::OpList &ops, std::shared_ptr<TensorOp> *fused) {
+  if (ops.size() < 2 ||
+      !std::all_of(ops.begin(), ops.end(), [](const auto &op) { return FusedCropFlipOp::IsFusible(*op); })) {
+    return Status::OK();
+  }
+  *fused = std::make_shared<FusedCropFlipOp>(ops);
+  return Status::OK();
+}
+}  // namespace
+
+std::vector<TensorOpFusionPass::FusionPattern> *TensorOpFusionPass::Registry() {
+  // Longer patterns first where they overlap. The patterns are matched greedily, without backtracking.
+  static std::vector<FusionPattern> patterns = {
+    {"DecodeRandomCropResize",
+     {{{kDecodeOp}, Repeat::kOne}, {{kRandomCropAndResizeOp}, Repeat::kOne}},
+     FuseDecodeRandomCropResize},
+    {"Normalize",
+     {{{kDecodeOp}, Repeat::kOptional},
+      {{kResizeOp}, Repeat::kOptional},
+      {{kRescaleOp}, Repeat::kOptional},
+      {{kNormalizeOp}, Repeat::kOne},
+      {{kHwcToChwOp}, Repeat::kOptional}},
+     FuseNormalize},
+    {"CropFlip",
+     {{{kCenterCropOp, kRandomCropOp, kRandomHorizontalFlipOp, kRandomVerticalFlipOp}, Repeat::kOneOrMore}},
+     FuseCropFlip},
   };
+  return &patterns;
+}
 
-  auto &tfuncs = node->TFuncs();
-  auto it = FindPattern(tfuncs);
-  if (it != tfuncs.end()) {
-    auto next = it + 1;
-    auto op = static_cast<RandomCropAndResizeOp *>(next->get());
-    *it = std::static_pointer_cast<TensorOp>(std::make_shared<RandomCropDecodeResizeOp>(*op));
-    tfuncs.erase(next);
+void TensorOpFusionPass::RegisterPattern(FusionPattern pattern) { Registry()->push_back(std::move(pattern)); }
+
+const std::vector<TensorOpFusionPass::FusionPattern> &TensorOpFusionPass::GetPatterns() { return *Registry(); }
+
+size_t TensorOpFusionPass::Match(const FusionPattern &pattern, const OpList &tfuncs, size_t start) {
+  size_t pos = start;
+  for (const auto &matcher : pattern.ops_) {
+    auto matches = [&tfuncs, &matcher](size_t i) {
+      return i < tfuncs.size() &&
+             std::find(matcher.names_.begin(), matcher.names_.end(), tfuncs[i]->Name()) != matcher.names_.end();
+    };
+    if (!matches(pos)) {
+      if (matcher.repeat_ == OpMatcher::Repeat::kOptional) {
+        continue;
+      }
+      return 0;
+    }
+    pos++;
+    while (matcher.repeat_ == OpMatcher::Repeat::kOneOrMore && matches(pos)) {
+      pos++;
+    }
   }
-  if (modified != nullptr) {
-    *modified = true;
-  } else {
+  return pos - start;
+}
+
+Status TensorOpFusionPass::RunOnNode(std::shared_ptr<MapOp> node, bool *modified) {
+  if (modified == nullptr) {
     RETURN_STATUS_UNEXPECTED("modified is nullptr");
   }
+  auto &tfuncs = node->TFuncs();
+  for (size_t i = 0; i < tfuncs.size(); i++) {
+    for (const auto &pattern : GetPatterns()) {
+      size_t len = Match(pattern, tfuncs, i);
+      if (len == 0) {
+        continue;
+      }
+      std::shared_ptr<TensorOp> fused;
+      RETURN_IF_NOT_OK(pattern.fuse_(OpList(tfuncs.begin() + i, tfuncs.begin() + i + len), &fused));
+      if (fused == nullptr) {
+        continue;
+      }
+      MS_LOG(INFO) << "Tensor op fusion: " << len << " ops of " << node->Name() << " fused by pattern "
+                   << pattern.name_ << " into " << fused->Name() << ".";
+      (void)tfuncs.erase(tfuncs.begin() + i + 1, tfuncs.begin() + i + len);
+      tfuncs[i] = std::move(fused);
+      *modified = true;
+      break;
+    }
+  }
   return Status::OK();
 }
 }  // namespace dataset
@@ -16,21 +16,61 @@
 #ifndef DATASET_TENSOR_OP_FUSION_PASS_H_
 #define DATASET_TENSOR_OP_FUSION_PASS_H_
 
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/kernels/tensor_op.h"
 
 namespace mindspore {
 namespace dataset {
 
 /// \class TensorOpFusionPass tensor_op_fusion_pass.h
-/// \brief And optional optimization pass identifying and fusing
-///     tensor ops within MapOp
+/// \brief An optional optimization pass identifying and fusing tensor ops within MapOp. The sequences of ops it
+///     looks for are the patterns of a registry, tried in order at every position of the op list of a MapOp.
 class TensorOpFusionPass : public NodePass {
+ public:
+  using OpList = std::vector<std::shared_ptr<TensorOp>>;
+
+  /// \brief Builds the fused op replacing the ops matched by a pattern. Setting *fused to nullptr declines the
+  ///     match, e.g. when one of the ops has a parameter the fused op does not support.
+  using FuseFunc = std::function<Status(const OpList &ops, std::shared_ptr<TensorOp> *fused)>;
+
+  /// \brief One element of a pattern, matching a tensor op whose name is one of names_
+  struct OpMatcher {
+    enum class Repeat { kOne, kOptional, kOneOrMore };
+    std::vector<std::string> names_;
+    Repeat repeat_;
+  };
+
+  /// \brief A sequence of tensor ops and how to fuse it
+  struct FusionPattern {
+    std::string name_;
+    std::vector<OpMatcher> ops_;
+    FuseFunc fuse_;
+  };
+
+  /// \brief Add a pattern to the registry, after the built-in ones. Patterns are registered before any pipeline
+  ///     is launched, the registry is not protected against concurrent updates.
+  /// \param[in] pattern The pattern
+  static void RegisterPattern(FusionPattern pattern);
+
+  /// \brief The registered patterns, in the order they are tried
+  static const std::vector<FusionPattern> &GetPatterns();
+
   /// \brief Identifies and fuses tensor ops within MapOp
   /// \param[in] node The node being visited
-  /// \param[inout] *modified indicates whether the node has been visited
+  /// \param[inout] *modified indicates whether the node has been modified
   /// \return Status The error code return
   Status RunOnNode(std::shared_ptr<MapOp> node, bool *modified) override;
+
+ private:
+  static std::vector<FusionPattern> *Registry();
+
+  /// \brief Match a pattern against the ops starting at position start
+  /// \return The number of ops matched, 0 if the pattern does not match
+  static size_t Match(const FusionPattern &pattern, const OpList &tfuncs, size_t start);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,230 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/auto_tune.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int32_t kWindowSize = 10;     // The number of samples the tuning decides on
+constexpr double kBusyFill = 0.5;       // A connector fuller than this on average has work waiting
+constexpr double kIdleFill = 0.1;       // A connector emptier than this on average is starved
+constexpr double kFullFill = 0.9;       // A connector fuller than this blocks its producers
+constexpr double kMinSpeedup = 0.9;     // A change of workers is undone below this share of the throughput
+constexpr int32_t kMaxQueueGrowth = 8;  // The connector queues grow up to this many times their size
+
+// The op which owns the connector an op reads from or writes to, skipping the inlined ops
+DatasetOp *ConnectorOwner(DatasetOp *op) {
+  while (op->inlined() && !op->Children().empty()) {
+    op = op->Children()[0].get();
+  }
+  return op;
+}
+
+// The number of workers doing the work of an op
+int32_t ActiveWorkers(DatasetOp *op) {
+  auto parallel_op = dynamic_cast<ParallelOp *>(op);
+  if (parallel_op != nullptr && parallel_op->AllowsWorkerResize()) {
+    return parallel_op->num_active_workers();
+  }
+  return op->num_workers();
+}
+
+// The share of the output connector of an op in use, counting only the queues of the producers getting work
+double QueueFill(DatasetOp *op) {
+  op = ConnectorOwner(op);
+  if (op->inlined()) {
+    return 0.0;
+  }
+  auto parallel_op = dynamic_cast<ParallelOp *>(op);
+  int32_t producers = (parallel_op != nullptr && parallel_op->AllowsWorkerResize())
+                        ? parallel_op->num_active_workers()
+                        : op->num_producers();
+  double capacity = static_cast<double>(producers) * op->ConnectorQueueCapacity();
+  return capacity > 0 ? std::min(1.0, op->ConnectorSize() / capacity) : 0.0;
+}
+}  // namespace
+
+AutoTune::AutoTune(ExecutionTree *tree) : num_samples_(0), tree_(tree), output_op_(nullptr) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  sampling_interval_ = cfg->monitor_sampling_interval();
+  cpu_budget_ = static_cast<int32_t>(cfg->autotune_cpu_budget());
+  if (cpu_budget_ <= 0) {
+    cpu_budget_ = std::max(1, static_cast<int32_t>(std::thread::hardware_concurrency()));
+  }
+}
+
+// Launch more workers than configured in the ops which can change their number of workers
+Status AutoTune::ReserveWorkers() {
+  for (auto &node : *tree_) {
+    auto parallel_op = dynamic_cast<ParallelOp *>(&node);
+    if (parallel_op != nullptr && parallel_op->AllowsWorkerResize()) {
+      RETURN_IF_NOT_OK(parallel_op->ReserveWorkers(std::max(parallel_op->num_workers(), cpu_budget_)));
+    }
+  }
+  return Status::OK();
+}
+
+Status AutoTune::operator()() {
+  // Register this thread with TaskManager to receive proper interrupt signal.
+  TaskManager::FindMe()->Post();
+
+  for (auto &node : *tree_) {
+    // DeviceQueueOp is a special op, it is not inlined but its output queue is invalid.
+    if (node.inlined() || node.Name() == "DeviceQueueOp") {
+      continue;
+    }
+    auto parallel_op = dynamic_cast<ParallelOp *>(&node);
+    if (parallel_op != nullptr && !parallel_op->AllowsWorkerResize()) {
+      parallel_op = nullptr;
+    }
+    ops_.push_back({&node, parallel_op, node.ConnectorQueueCapacity() * kMaxQueueGrowth, false, 0.0, 0.0, 0, 0});
+  }
+  output_op_ = tree_->root().get();
+  while ((output_op_->inlined() || output_op_->Name() == "DeviceQueueOp") && !output_op_->Children().empty()) {
+    output_op_ = output_op_->Children()[0].get();
+  }
+  if (output_op_->inlined()) {
+    return Status::OK();
+  }
+
+  // Keep tuning until the first epoch is out of the tree
+  int64_t last_count = output_op_->ConnectorOutBufferCount();
+  while (!this_thread::is_interrupted() && !(tree_->isFinished()) && output_op_->ConnectorOutEoeCount() == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(sampling_interval_));
+    Sample();
+    if (num_samples_ == kWindowSize) {
+      int64_t count = output_op_->ConnectorOutBufferCount();
+      RETURN_IF_NOT_OK(Tune(count - last_count));
+      last_count = count;
+    }
+  }
+  LogConfig();
+  return Status::OK();
+}
+
+// Sample the connectors of all the ops once
+void AutoTune::Sample() {
+  for (auto &stats : ops_) {
+    stats.in_fill += stats.op->Children().empty() ? 1.0 : QueueFill(stats.op->Children()[0].get());
+    double out_fill = QueueFill(stats.op);
+    stats.out_fill += out_fill;
+    stats.out_empty += (stats.op->ConnectorSize() == 0) ? 1 : 0;
+    stats.out_full += (out_fill >= kFullFill) ? 1 : 0;
+  }
+  num_samples_++;
+}
+
+// Act on the samples of the last window, then start a new one
+Status AutoTune::Tune(int64_t throughput) {
+  bool reverted = false;
+  if (grown_ >= 0) {
+    // Undo the last change of workers if the tree got slower
+    if (throughput < last_throughput_ * kMinSpeedup) {
+      RETURN_IF_NOT_OK(ops_[grown_].parallel_op->SetNumActiveWorkers(grown_from_));
+      if (shrunk_ >= 0) {
+        RETURN_IF_NOT_OK(ops_[shrunk_].parallel_op->SetNumActiveWorkers(shrunk_from_));
+      }
+      ops_[grown_].settled = true;
+      reverted = true;
+      MS_LOG(INFO) << "Autotune: more workers made " << ops_[grown_].op->Name() << " slower, back to " << grown_from_
+                   << " workers.";
+    }
+    grown_ = -1;
+    shrunk_ = -1;
+  }
+  if (!reverted) {
+    last_throughput_ = throughput;
+    int32_t bottleneck = -1;
+    int32_t donor = -1;
+    double max_gap = 0.0;
+    for (int32_t i = 0; i < ops_.size(); i++) {
+      OpStats &stats = ops_[i];
+      double in_fill = stats.in_fill / num_samples_;
+      double out_fill = stats.out_fill / num_samples_;
+      // A connector often empty and often full has a bursty producer, a larger one evens it out
+      int32_t capacity = stats.op->ConnectorQueueCapacity();
+      if (stats.out_empty * 4 >= num_samples_ && stats.out_full * 4 >= num_samples_ &&
+          capacity < stats.max_queue_capacity) {
+        int32_t new_capacity = std::min(capacity * 2, stats.max_queue_capacity);
+        RETURN_IF_NOT_OK(stats.op->SetConnectorQueueCapacity(new_capacity));
+        MS_LOG(INFO) << "Autotune: connector of " << stats.op->Name() << " resized to " << new_capacity << ".";
+      }
+      if (stats.parallel_op == nullptr) {
+        continue;
+      }
+      if (!stats.settled && in_fill >= kBusyFill && out_fill <= kIdleFill && in_fill - out_fill > max_gap) {
+        bottleneck = i;
+        max_gap = in_fill - out_fill;
+      }
+      if (in_fill <= kIdleFill && stats.parallel_op->num_active_workers() > 1) {
+        donor = i;
+      }
+    }
+    if (bottleneck >= 0) {
+      ParallelOp *op = ops_[bottleneck].parallel_op;
+      int32_t current = op->num_active_workers();
+      int32_t used = 0;
+      for (auto &node : *tree_) {
+        used += ActiveWorkers(&node);
+      }
+      int32_t grow = std::min({std::max(1, current / 2), cpu_budget_ - used, op->num_workers() - current});
+      if (grow <= 0 && donor >= 0 && donor != bottleneck && current < op->num_workers()) {
+        // Out of budget, move a worker from an op waiting for its input
+        shrunk_ = donor;
+        shrunk_from_ = ops_[donor].parallel_op->num_active_workers();
+        RETURN_IF_NOT_OK(ops_[donor].parallel_op->SetNumActiveWorkers(shrunk_from_ - 1));
+        grow = 1;
+      }
+      if (grow > 0) {
+        grown_ = bottleneck;
+        grown_from_ = current;
+        RETURN_IF_NOT_OK(op->SetNumActiveWorkers(current + grow));
+        MS_LOG(INFO) << "Autotune: " << op->Name() << " is the bottleneck, " << current + grow << " workers.";
+      }
+    }
+  }
+  for (auto &stats : ops_) {
+    stats.in_fill = 0.0;
+    stats.out_fill = 0.0;
+    stats.out_empty = 0;
+    stats.out_full = 0;
+  }
+  num_samples_ = 0;
+  return Status::OK();
+}
+
+// Log the configuration of the tree as tuned
+void AutoTune::LogConfig() const {
+  std::ostringstream ss;
+  for (auto &stats : ops_) {
+    ss << "\n  " << stats.op->Name() << " (id " << stats.op->id() << "): num_parallel_workers "
+       << ActiveWorkers(stats.op) << ", op_connector_size " << stats.op->ConnectorQueueCapacity();
+  }
+  MS_LOG(INFO) << "Autotune finished, set these values in the pipeline to skip the tuning:" << ss.str();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATASET_ENGINE_PERF_AUTO_TUNE_H_
+#define DATASET_ENGINE_PERF_AUTO_TUNE_H_
+
+#include <memory>
+#include <vector>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class DatasetOp;
+class ExecutionTree;
+class ParallelOp;
+
+// Tunes the number of workers and the connector sizes of a running tree during its first epoch.
+// The ops whose input connector is mostly full while their output connector is mostly empty are the bottleneck of
+// the tree. They get more workers, within the cpu budget of the config and if need be taken from the ops starved of
+// input, as long as the throughput of the tree does not drop. Connectors which alternate between empty and full
+// are made larger. The final configuration is logged, so it can be set explicitly in the next runs.
+class AutoTune {
+ public:
+  // AutoTune object constructor
+  // @param tree - The tree to tune
+  explicit AutoTune(ExecutionTree *tree);
+
+  ~AutoTune() = default;
+
+  // Launch more workers than configured in the ops which can change their number of workers while running, so the
+  // tuning can give them work later. Called when the tree is prepared, before the connectors are created.
+  // @return Status - The error code return
+  Status ReserveWorkers();
+
+  // Functor for the tuning main loop.
+  // This function will be the entry point of mindspore::Dataset::Task
+  Status operator()();
+
+ private:
+  // The numbers gathered for an op over a window of samples
+  struct OpStats {
+    DatasetOp *op;
+    ParallelOp *parallel_op;  // nullptr if the op cannot change its number of workers
+    int32_t max_queue_capacity;
+    bool settled;  // The last change of its workers made the tree slower, it is left alone from then on
+    double in_fill;
+    double out_fill;
+    int32_t out_empty;
+    int32_t out_full;
+  };
+
+  // Sample the connectors of all the ops once
+  void Sample();
+
+  // Act on the samples of the last window, then start a new one
+  // @param throughput - The number of buffers sent by the tree in the window
+  // @return Status - The error code return
+  Status Tune(int64_t throughput);
+
+  // Log the configuration of the tree as tuned
+  void LogConfig() const;
+
+  int32_t cpu_budget_;
+  int64_t sampling_interval_;
+  int32_t num_samples_;
+  ExecutionTree *tree_;
+  DatasetOp *output_op_;  // The op whose output is the output of the tree
+  std::vector<OpStats> ops_;
+
+  // The last change of workers, to undo it if the throughput of the next window drops
+  int32_t grown_ = -1;
+  int32_t shrunk_ = -1;
+  int32_t grown_from_ = 0;
+  int32_t shrunk_from_ = 0;
+  int64_t last_throughput_ = 0;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_PERF_AUTO_TUNE_H_
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/memory_pool_usage.h"
+#include <fstream>
+#include <memory>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/size_class_pool.h"
+
+using json = nlohmann::json;
+namespace mindspore {
+namespace dataset {
+// Sample action
+Status MemoryPoolUsage::Sample() {
+  auto pool = std::dynamic_pointer_cast<SizeClassPool>(GlobalContext::Instance()->mem_pool());
+  if (pool == nullptr) {
+    // The tensors do not come from a pool with counters
+    return Status::OK();
+  }
+  SizeClassPool::Stats stats = pool->GetStats();
+  hits_.push_back(stats.hits);
+  misses_.push_back(stats.misses);
+  cached_bytes_.push_back(stats.cached_bytes);
+  return Status::OK();
+}
+
+// Save profiling data to file
+Status MemoryPoolUsage::SaveToFile() {
+  std::ofstream os(file_path_, std::ios::trunc);
+  json output;
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  output["sampling_interval"] = cfg->monitor_sampling_interval();
+  output["hits"] = hits_;
+  output["misses"] = misses_;
+  output["cached_bytes"] = cached_bytes_;
+  os << output;
+  return Status::OK();
+}
+
+Status MemoryPoolUsage::Init(const std::string &dir_path, const std::string &device_id) {
+  file_path_ = (Path(dir_path) / Path("memory_pool_profiling_" + device_id + ".json")).toString();
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
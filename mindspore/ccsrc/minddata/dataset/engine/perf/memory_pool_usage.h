@@ -0,0 +1,54 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_MEMORY_POOL_USAGE_H
+#define DATASET_MEMORY_POOL_USAGE_H
+
+#include <string>
+#include <vector>
+#include "minddata/dataset/engine/perf/profiling.h"
+
+namespace mindspore {
+namespace dataset {
+// Memory pool usage sampling samples the counters of the pool of the tensors (see SizeClassPool):
+// how many requests were served from its caches, how many went to the system, and how much memory the
+// pool holds. The counters are cumulative since the start of the process.
+// It support JSON serialization for external usage.
+class MemoryPoolUsage : public Sampling {
+ public:
+  MemoryPoolUsage() = default;
+
+  ~MemoryPoolUsage() override = default;
+
+  // Driver function for memory pool sampling.
+  Status Sample() override;
+
+  std::string Name() const override { return kMemoryPoolSamplingName; }
+
+  // Save sampling data to file
+  // @return Status - The error code return
+  Status SaveToFile() override;
+
+  Status Init(const std::string &dir_path, const std::string &device_id) override;
+
+ private:
+  std::vector<uint64_t> hits_;
+  std::vector<uint64_t> misses_;
+  std::vector<uint64_t> cached_bytes_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_MEMORY_POOL_USAGE_H
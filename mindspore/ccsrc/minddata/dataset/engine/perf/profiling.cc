@@ -24,6 +24,7 @@
 #include "minddata/dataset/engine/perf/connector_size.h"
 #include "minddata/dataset/engine/perf/connector_throughput.h"
 #include "minddata/dataset/engine/perf/dataset_iterator_tracing.h"
+#include "minddata/dataset/engine/perf/memory_pool_usage.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -77,6 +78,9 @@ Status ProfilingManager::Initialize() {
 
   std::shared_ptr<Sampling> connector_thr_sampling = std::make_shared<ConnectorThroughput>(tree_);
   RETURN_IF_NOT_OK(RegisterSamplingNode(connector_thr_sampling));
+
+  std::shared_ptr<Sampling> memory_pool_sampling = std::make_shared<MemoryPoolUsage>();
+  RETURN_IF_NOT_OK(RegisterSamplingNode(memory_pool_sampling));
   return Status::OK();
 }
 
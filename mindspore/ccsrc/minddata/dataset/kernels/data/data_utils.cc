@@ -652,5 +652,39 @@ Status ConcatenateHelper(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
 
   return Status::OK();
 }
+
+Status StackTensors(const std::vector<std::shared_ptr<Tensor>> &input, std::shared_ptr<Tensor> *output) {
+  CHECK_FAIL_RETURN_UNEXPECTED(!input.empty() && input[0] != nullptr, "No tensor to stack");
+  const TensorShape &shape = input[0]->shape();
+  const DataType &type = input[0]->type();
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric() && shape.known(), "Only numeric tensors of known shape can be stacked");
+  std::shared_ptr<Tensor> out;
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, TensorImpl::kFlexible,
+                                        shape.PrependDim(static_cast<dsize_t>(input.size())), type));
+  for (size_t i = 0; i < input.size(); i++) {
+    CHECK_FAIL_RETURN_UNEXPECTED(input[i] != nullptr && input[i]->shape() == shape && input[i]->type() == type,
+                                 "Tensors to stack have different shapes or types");
+    RETURN_IF_NOT_OK(out->InsertTensor({static_cast<dsize_t>(i)}, input[i]));
+  }
+  *output = std::move(out);
+  return Status::OK();
+}
+
+Status UnstackTensor(const std::shared_ptr<Tensor> &input, std::vector<std::shared_ptr<Tensor>> *output) {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  RETURN_UNEXPECTED_IF_NULL(output);
+  CHECK_FAIL_RETURN_UNEXPECTED(input->type().IsNumeric() && input->Rank() > 0,
+                               "Only numeric tensors of rank 1 or more can be unstacked");
+  output->clear();
+  for (dsize_t i = 0; i < input->shape()[0]; i++) {
+    uchar *start = nullptr;
+    TensorShape remaining({-1});
+    RETURN_IF_NOT_OK(input->StartAddrOfIndex({i}, &start, &remaining));
+    std::shared_ptr<Tensor> out;
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, TensorImpl::kFlexible, remaining, input->type(), start));
+    output->push_back(std::move(out));
+  }
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
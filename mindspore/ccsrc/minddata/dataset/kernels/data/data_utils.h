@@ -157,6 +157,19 @@ Status Concatenate(const TensorRow &input, TensorRow *output, int8_t axis, std::
 Status ConcatenateHelper(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int8_t axis,
                          std::shared_ptr<Tensor> append);
 
+// Stacks numeric tensors of the same shape and type into one tensor with a new first dimension.
+//          Example: 3 tensors of shape <H,W,C> give a tensor of shape <3,H,W,C>
+// @param input: the tensors to stack, at least one
+// @param output: Tensor. The stacked tensor
+// @return Status ok/error
+Status StackTensors(const std::vector<std::shared_ptr<Tensor>> &input, std::shared_ptr<Tensor> *output);
+
+// Splits a numeric tensor along its first dimension, the reverse of StackTensors.
+// @param input: Tensor of rank 1 or more
+// @param output: the tensors, one per index of the first dimension
+// @return Status ok/error
+Status UnstackTensor(const std::shared_ptr<Tensor> &input, std::vector<std::shared_ptr<Tensor>> *output);
+
 }  // namespace dataset
 }  // namespace mindspore
 
@@ -35,6 +35,11 @@ class FillOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  bool SupportsBatch() const override { return true; }
+
+  // The fill does not depend on the shape, so the stacked rows are filled in one call.
+  Status ComputeBatch(const TensorRow &input, TensorRow *output) override { return TensorOp::Compute(input, output); }
+
   std::string Name() const override { return kFillOp; }
 
  private:
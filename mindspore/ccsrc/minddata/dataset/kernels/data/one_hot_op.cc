@@ -27,6 +27,19 @@ Status OneHotOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   return s;
 }
 
+Status OneHotOp::ComputeBatch(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  CHECK_FAIL_RETURN_UNEXPECTED(input.size() == 1, "OneHotOp expects one column");
+  const TensorShape &shape = input[0]->shape();
+  // The per row output is squeezed, which only keeps the <N,num_classes> layout when both are more than 1
+  if (shape.Rank() == 0 || shape[0] < 2 || num_classes_ < 2 || shape.NumOfElements() != shape[0]) {
+    return TensorOp::ComputeBatch(input, output);
+  }
+  RETURN_IF_NOT_OK(input[0]->Reshape(TensorShape({shape[0]})));
+  output->resize(1);
+  return OneHotEncoding(input[0], &(*output)[0], num_classes_);
+}
+
 Status OneHotOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
   outputs.clear();
@@ -37,6 +37,11 @@ class OneHotOp : public TensorOp {
 
   Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
 
+  bool SupportsBatch() const override { return true; }
+
+  // Rows holding a single label are encoded together as one 1D tensor of labels.
+  Status ComputeBatch(const TensorRow &input, TensorRow *output) override;
+
   std::string Name() const override { return kOneHotOp; }
 
  private:
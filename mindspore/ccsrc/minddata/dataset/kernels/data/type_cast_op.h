@@ -39,6 +39,11 @@ class TypeCastOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  bool SupportsBatch() const override { return true; }
+
+  // The cast is elementwise, so the stacked rows are cast in one call.
+  Status ComputeBatch(const TensorRow &input, TensorRow *output) override { return TensorOp::Compute(input, output); }
+
   void Print(std::ostream &out) const override { out << "TypeCastOp"; }
   Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
 
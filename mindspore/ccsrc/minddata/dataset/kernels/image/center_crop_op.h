@@ -43,6 +43,8 @@ class CenterCropOp : public TensorOp {
   std::string Name() const override { return kCenterCropOp; }
 
  private:
+  friend class FusedCropFlipOp;
+
   int32_t crop_het_;
   int32_t crop_wid_;
 };
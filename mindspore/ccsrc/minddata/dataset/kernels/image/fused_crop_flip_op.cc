@@ -0,0 +1,154 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_crop_flip_op.h"
+
+#include <utility>
+
+#include "minddata/dataset/core/cv_tensor.h"
+#include "minddata/dataset/kernels/image/center_crop_op.h"
+#include "minddata/dataset/kernels/image/random_crop_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/random_vertical_flip_op.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Copy the window <x,y,w,h> of the input, mirrored as requested, in one pass
+Status CropAndFlip(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int32_t x, int32_t y,
+                   int32_t w, int32_t h, bool flip_h, bool flip_v) {
+  if (x == 0 && y == 0 && w == input->shape()[1] && h == input->shape()[0] && !flip_h && !flip_v) {
+    *output = input;
+    return Status::OK();
+  }
+  std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
+  if (!input_cv->mat().data) {
+    RETURN_STATUS_UNEXPECTED("Could not convert to CV Tensor");
+  }
+  try {
+    TensorShape shape{h, w};
+    if (input_cv->Rank() == 3) shape = shape.AppendDim(input_cv->shape()[2]);
+    std::shared_ptr<CVTensor> output_cv = std::make_shared<CVTensor>(shape, input_cv->type());
+    RETURN_UNEXPECTED_IF_NULL(output_cv);
+    cv::Mat roi = input_cv->mat()(cv::Rect(x, y, w, h));
+    if (flip_h || flip_v) {
+      // flip code of OpenCV: 1 around the vertical axis, 0 around the horizontal axis, -1 around both
+      cv::flip(roi, output_cv->mat(), (flip_h && flip_v) ? -1 : (flip_h ? 1 : 0));
+    } else {
+      roi.copyTo(output_cv->mat());
+    }
+    *output = std::static_pointer_cast<Tensor>(output_cv);
+    return Status::OK();
+  } catch (const cv::Exception &e) {
+    RETURN_STATUS_UNEXPECTED("Unexpected error in FusedCropFlipOp.");
+  }
+}
+}  // namespace
+
+FusedCropFlipOp::FusedCropFlipOp(std::vector<std::shared_ptr<TensorOp>> ops) : ops_(std::move(ops)) {}
+
+bool FusedCropFlipOp::IsFusible(const TensorOp &op) {
+  std::string name = op.Name();
+  if (name == kRandomCropOp) {
+    auto &crop = static_cast<const RandomCropOp &>(op);
+    return crop.pad_top_ == 0 && crop.pad_bottom_ == 0 && crop.pad_left_ == 0 && crop.pad_right_ == 0 &&
+           !crop.pad_if_needed_;
+  }
+  return name == kCenterCropOp || name == kRandomHorizontalFlipOp || name == kRandomVerticalFlipOp;
+}
+
+void FusedCropFlipOp::Print(std::ostream &out) const {
+  out << "FusedCropFlipOp:";
+  for (auto &op : ops_) {
+    out << " " << op->Name();
+  }
+}
+
+Status FusedCropFlipOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  dsize_t rank = input->shape().Rank();
+  if (rank != 2 && rank != 3) {
+    RETURN_STATUS_UNEXPECTED("Rank received::" + std::to_string(rank) + " Expected: 2 or 3");
+  }
+  // Window of the input covered by the output so far, and whether it is mirrored
+  int32_t x = 0;
+  int32_t y = 0;
+  auto w = static_cast<int32_t>(input->shape()[1]);
+  auto h = static_cast<int32_t>(input->shape()[0]);
+  bool flip_h = false;
+  bool flip_v = false;
+  size_t i = 0;
+  for (; i < ops_.size(); i++) {
+    std::string name = ops_[i]->Name();
+    if (name == kRandomHorizontalFlipOp) {
+      auto op = static_cast<RandomHorizontalFlipOp *>(ops_[i].get());
+      flip_h = (flip_h != op->distribution_(op->rnd_));
+      continue;
+    }
+    if (name == kRandomVerticalFlipOp) {
+      auto op = static_cast<RandomVerticalFlipOp *>(ops_[i].get());
+      flip_v = (flip_v != op->distribution_(op->rnd_));
+      continue;
+    }
+    int32_t crop_x = 0;
+    int32_t crop_y = 0;
+    int32_t crop_w = 0;
+    int32_t crop_h = 0;
+    if (name == kCenterCropOp) {
+      auto op = static_cast<CenterCropOp *>(ops_[i].get());
+      crop_w = op->crop_wid_;
+      crop_h = op->crop_het_;
+      // A crop larger than the image pads it. It is left to the op itself, like any error.
+      if (crop_w <= 0 || crop_h <= 0 || crop_w > w || crop_h > h) break;
+      crop_x = (w - crop_w) / 2;
+      crop_y = (h - crop_h) / 2;
+    } else {
+      auto op = static_cast<RandomCropOp *>(ops_[i].get());
+      crop_w = op->crop_width_;
+      crop_h = op->crop_height_;
+      if (crop_w <= 0 || crop_h <= 0 || crop_w > w || crop_h > h) break;
+      // RandomCropOp draws no position when the crop covers the whole image
+      if (crop_w != w || crop_h != h) {
+        op->GenRandomXY(&crop_x, &crop_y, w, h);
+      }
+    }
+    // Map the window, given in the coordinates of the mirrored image, back to the input
+    x += flip_h ? (w - crop_x - crop_w) : crop_x;
+    y += flip_v ? (h - crop_y - crop_h) : crop_y;
+    w = crop_w;
+    h = crop_h;
+  }
+  std::shared_ptr<Tensor> image;
+  RETURN_IF_NOT_OK(CropAndFlip(input, &image, x, y, w, h, flip_h, flip_v));
+  // The rest of the chain, from an op which could not be composed, runs op by op
+  for (; i < ops_.size(); i++) {
+    std::shared_ptr<Tensor> next;
+    RETURN_IF_NOT_OK(ops_[i]->Compute(image, &next));
+    image = std::move(next);
+  }
+  *output = std::move(image);
+  return Status::OK();
+}
+
+Status FusedCropFlipOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  for (auto &op : ops_) {
+    std::vector<TensorShape> shapes = outputs;
+    RETURN_IF_NOT_OK(op->OutputShape(shapes, outputs));
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_IMAGE_FUSED_CROP_FLIP_OP_H_
+#define DATASET_KERNELS_IMAGE_FUSED_CROP_FLIP_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Fused form of a chain of CenterCrop, RandomCrop, RandomHorizontalFlip and RandomVerticalFlip, created by
+/// the TensorOpFusionPass. The crop windows and flips chosen by the ops are composed first, then the output is
+/// produced by a single copy of the final window of the input. Each op still makes its own random choices, in the same
+/// order as when the ops run one after another, so the output is the same.
+class FusedCropFlipOp : public TensorOp {
+ public:
+  /// \brief Constructor
+  /// \param ops The ops of the chain, in order. Every op must be accepted by IsFusible.
+  explicit FusedCropFlipOp(std::vector<std::shared_ptr<TensorOp>> ops);
+
+  ~FusedCropFlipOp() override = default;
+
+  /// \brief Whether the op can be part of a fused chain. A crop which pads the image cannot.
+  static bool IsFusible(const TensorOp &op);
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  std::string Name() const override { return kFusedCropFlipOp; }
+
+ private:
+  std::vector<std::shared_ptr<TensorOp>> ops_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_KERNELS_IMAGE_FUSED_CROP_FLIP_OP_H_
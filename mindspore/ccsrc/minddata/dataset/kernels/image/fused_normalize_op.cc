@@ -0,0 +1,149 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_normalize_op.h"
+
+#include <utility>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr dsize_t kNumChannels = 3;
+
+// One pass over an <H,W,3> image: the affine transform of every channel, written either interleaved or planar
+template <typename T>
+void NormalizePixels(const T *src, float *dst, dsize_t num_pixels, const float *scale, const float *shift,
+                     bool hwc_to_chw) {
+  if (hwc_to_chw) {
+    float *planes[kNumChannels] = {dst, dst + num_pixels, dst + 2 * num_pixels};
+    for (dsize_t i = 0; i < num_pixels; i++, src += kNumChannels) {
+      for (dsize_t c = 0; c < kNumChannels; c++) {
+        planes[c][i] = static_cast<float>(src[c]) * scale[c] + shift[c];
+      }
+    }
+  } else {
+    for (dsize_t i = 0; i < num_pixels; i++, src += kNumChannels, dst += kNumChannels) {
+      for (dsize_t c = 0; c < kNumChannels; c++) {
+        dst[c] = static_cast<float>(src[c]) * scale[c] + shift[c];
+      }
+    }
+  }
+}
+}  // namespace
+
+FusedNormalizeOp::FusedNormalizeOp(std::shared_ptr<DecodeOp> decode, std::shared_ptr<ResizeOp> resize,
+                                   const RescaleOp *rescale, const NormalizeOp &normalize, bool hwc_to_chw)
+    : decode_(std::move(decode)), resize_(std::move(resize)), hwc_to_chw_(hwc_to_chw) {
+  float rescale_ratio = (rescale == nullptr) ? 1.0f : rescale->rescale_;
+  float shift_ratio = (rescale == nullptr) ? 0.0f : rescale->shift_;
+  for (dsize_t c = 0; c < kNumChannels; c++) {
+    float mean_c = normalize.mean_->mat().at<float>(c);
+    float std_c = normalize.std_->mat().at<float>(c);
+    // ((x * rescale + shift) - mean) / std
+    scale_.push_back(rescale_ratio / std_c);
+    shift_.push_back((shift_ratio - mean_c) / std_c);
+  }
+}
+
+void FusedNormalizeOp::Print(std::ostream &out) const {
+  out << "FusedNormalizeOp: decode: " << (decode_ != nullptr) << ", resize: " << (resize_ != nullptr)
+      << ", scale: " << scale_[0] << ", " << scale_[1] << ", " << scale_[2] << ", shift: " << shift_[0] << ", "
+      << shift_[1] << ", " << shift_[2] << ", hwc_to_chw: " << hwc_to_chw_;
+}
+
+Status FusedNormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  std::shared_ptr<Tensor> image = input;
+  if (decode_ != nullptr) {
+    RETURN_IF_NOT_OK(decode_->Compute(input, &image));
+  }
+  if (resize_ != nullptr) {
+    std::shared_ptr<Tensor> resized;
+    RETURN_IF_NOT_OK(resize_->Compute(image, &resized));
+    image = std::move(resized);
+  }
+  const TensorShape &shape = image->shape();
+  if (shape.Rank() != 3 || shape[2] != kNumChannels) {
+    RETURN_STATUS_UNEXPECTED("FusedNormalizeOp expects an image of shape <H,W,3>, got " + shape.ToString());
+  }
+  TensorShape out_shape = hwc_to_chw_ ? TensorShape({kNumChannels, shape[0], shape[1]}) : shape;
+  std::shared_ptr<Tensor> out;
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, TensorImpl::kFlexible, out_shape, DataType(DataType::DE_FLOAT32)));
+  float *dst = &(*out->begin<float>());
+  const unsigned char *src = image->GetBuffer();
+  dsize_t num_pixels = shape[0] * shape[1];
+  switch (image->type().value()) {
+    case DataType::DE_UINT8:
+      NormalizePixels(reinterpret_cast<const uint8_t *>(src), dst, num_pixels, scale_.data(), shift_.data(),
+                      hwc_to_chw_);
+      break;
+    case DataType::DE_INT8:
+      NormalizePixels(reinterpret_cast<const int8_t *>(src), dst, num_pixels, scale_.data(), shift_.data(),
+                      hwc_to_chw_);
+      break;
+    case DataType::DE_UINT16:
+      NormalizePixels(reinterpret_cast<const uint16_t *>(src), dst, num_pixels, scale_.data(), shift_.data(),
+                      hwc_to_chw_);
+      break;
+    case DataType::DE_INT16:
+      NormalizePixels(reinterpret_cast<const int16_t *>(src), dst, num_pixels, scale_.data(), shift_.data(),
+                      hwc_to_chw_);
+      break;
+    case DataType::DE_INT32:
+      NormalizePixels(reinterpret_cast<const int32_t *>(src), dst, num_pixels, scale_.data(), shift_.data(),
+                      hwc_to_chw_);
+      break;
+    case DataType::DE_FLOAT32:
+      NormalizePixels(reinterpret_cast<const float *>(src), dst, num_pixels, scale_.data(), shift_.data(),
+                      hwc_to_chw_);
+      break;
+    case DataType::DE_FLOAT64:
+      NormalizePixels(reinterpret_cast<const double *>(src), dst, num_pixels, scale_.data(), shift_.data(),
+                      hwc_to_chw_);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("FusedNormalizeOp does not support images of type " + image->type().ToString());
+  }
+  *output = std::move(out);
+  return Status::OK();
+}
+
+Status FusedNormalizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  std::vector<TensorShape> shapes = inputs;
+  if (decode_ != nullptr) {
+    RETURN_IF_NOT_OK(decode_->OutputShape(shapes, outputs));
+    shapes = outputs;
+  }
+  if (resize_ != nullptr) {
+    RETURN_IF_NOT_OK(resize_->OutputShape(shapes, outputs));
+    shapes = outputs;
+  }
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(shapes, outputs));
+  outputs.clear();
+  TensorShape in = shapes[0];
+  if (in.Rank() == 3) outputs.emplace_back(hwc_to_chw_ ? TensorShape{in[2], in[0], in[1]} : in);
+  if (!outputs.empty()) return Status::OK();
+  return Status(StatusCode::kUnexpectedError, "Input has a wrong shape");
+}
+
+Status FusedNormalizeOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = DataType(DataType::DE_FLOAT32);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
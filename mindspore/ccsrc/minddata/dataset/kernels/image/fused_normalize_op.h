@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
+#define DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Fused form of [Decode] [Resize] [Rescale] Normalize [HwcToChw], created by the TensorOpFusionPass.
+/// Decode and Resize still produce their uint8 image, but Rescale, Normalize and HwcToChw are done in a single pass
+/// over it which writes the float output directly in its final layout, instead of one float image per op.
+class FusedNormalizeOp : public TensorOp {
+ public:
+  /// \brief Constructor
+  /// \param decode The DecodeOp to run first, or nullptr
+  /// \param resize The ResizeOp to run after decoding, or nullptr
+  /// \param rescale The RescaleOp preceding the normalization, or nullptr
+  /// \param normalize The NormalizeOp
+  /// \param hwc_to_chw Whether the output is permuted to <C,H,W>
+  FusedNormalizeOp(std::shared_ptr<DecodeOp> decode, std::shared_ptr<ResizeOp> resize, const RescaleOp *rescale,
+                   const NormalizeOp &normalize, bool hwc_to_chw);
+
+  ~FusedNormalizeOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kFusedNormalizeOp; }
+
+ private:
+  std::shared_ptr<DecodeOp> decode_;
+  std::shared_ptr<ResizeOp> resize_;
+  // Rescale and Normalize folded into one affine transform per channel: out = in * scale_[c] + shift_[c]
+  std::vector<float> scale_;
+  std::vector<float> shift_;
+  bool hwc_to_chw_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
@@ -46,6 +46,19 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
   return Normalize(input, output, mean_, std_);
 }
 
+Status NormalizeOp::ComputeBatch(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  CHECK_FAIL_RETURN_UNEXPECTED(input.size() == 1, "NormalizeOp expects one column");
+  TensorShape shape = input[0]->shape();
+  if (shape.Rank() != 4 || shape[3] != 3) {
+    return TensorOp::ComputeBatch(input, output);
+  }
+  RETURN_IF_NOT_OK(input[0]->Reshape(TensorShape({shape[0] * shape[1], shape[2], shape[3]})));
+  output->resize(1);
+  RETURN_IF_NOT_OK(Normalize(input[0], &(*output)[0], mean_, std_));
+  return (*output)[0]->Reshape(shape);
+}
+
 void NormalizeOp::Print(std::ostream &out) const {
   out << "NormalizeOp, mean: " << mean_->mat().at<float>(0) << ", " << mean_->mat().at<float>(1) << ", "
       << mean_->mat().at<float>(2) << "std: " << std_->mat().at<float>(0) << ", " << std_->mat().at<float>(1) << ", "
@@ -36,9 +36,16 @@ class NormalizeOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  bool SupportsBatch() const override { return true; }
+
+  // Stacked <N,H,W,3> images are normalized as a single <N*H,W,3> image.
+  Status ComputeBatch(const TensorRow &input, TensorRow *output) override;
+
   std::string Name() const override { return kNormalizeOp; }
 
  private:
+  friend class FusedNormalizeOp;
+
   std::shared_ptr<CVTensor> mean_;
   std::shared_ptr<CVTensor> std_;
 };
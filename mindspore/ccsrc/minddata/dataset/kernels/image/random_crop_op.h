@@ -84,6 +84,8 @@ class RandomCropOp : public TensorOp {
   int32_t crop_width_ = 0;
 
  private:
+  friend class FusedCropFlipOp;
+
   int32_t pad_top_ = 0;
   int32_t pad_bottom_ = 0;
   int32_t pad_left_ = 0;
@@ -51,6 +51,8 @@ class RandomHorizontalFlipOp : public TensorOp {
   std::string Name() const override { return kRandomHorizontalFlipOp; }
 
  private:
+  friend class FusedCropFlipOp;
+
   std::mt19937 rnd_;
   std::bernoulli_distribution distribution_;
 };
@@ -45,6 +45,8 @@ class RandomVerticalFlipOp : public TensorOp {
   std::string Name() const override { return kRandomVerticalFlipOp; }
 
  private:
+  friend class FusedCropFlipOp;
+
   std::mt19937 rnd_;
   std::bernoulli_distribution distribution_;
 };
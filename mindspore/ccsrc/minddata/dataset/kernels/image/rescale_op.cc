@@ -24,6 +24,19 @@ Status RescaleOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<
   IO_CHECK(input, output);
   return Rescale(input, output, rescale_, shift_);
 }
+Status RescaleOp::ComputeBatch(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  CHECK_FAIL_RETURN_UNEXPECTED(input.size() == 1, "RescaleOp expects one column");
+  TensorShape shape = input[0]->shape();
+  if (shape.Rank() == 0 || shape[0] == 0) {
+    return TensorOp::ComputeBatch(input, output);
+  }
+  RETURN_IF_NOT_OK(input[0]->Reshape(TensorShape({shape[0], shape.NumOfElements() / shape[0]})));
+  output->resize(1);
+  RETURN_IF_NOT_OK(Rescale(input[0], &(*output)[0], rescale_, shift_));
+  return (*output)[0]->Reshape(shape);
+}
+
 Status RescaleOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
   outputs[0] = DataType(DataType::DE_FLOAT32);
@@ -39,9 +39,16 @@ class RescaleOp : public TensorOp {
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
   Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
 
+  bool SupportsBatch() const override { return true; }
+
+  // The transform is the same for every element, so the stacked rows are rescaled as a single 2D image.
+  Status ComputeBatch(const TensorRow &input, TensorRow *output) override;
+
   std::string Name() const override { return kRescaleOp; }
 
  private:
+  friend class FusedNormalizeOp;
+
   float rescale_;
   float shift_;
 };
@@ -18,6 +18,7 @@
 #include <memory>
 #include <mutex>
 #include <vector>
+#include "minddata/dataset/kernels/data/data_utils.h"
 
 namespace mindspore {
 namespace dataset {
@@ -48,6 +49,41 @@ Status TensorOp::Compute(const TensorRow &input, TensorRow *output) {
                 "Is this TensorOp oneToOne? If no, please implement this Compute() in the derived class.");
 }
 
+// Name: ComputeBatch()
+// Description: This ComputeBatch() unstacks the rows, calls Compute() on each of them and stacks the results.
+//              The derived class may override this function to work on the stacked tensors directly.
+Status TensorOp::ComputeBatch(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  std::vector<TensorRow> rows;
+  for (const auto &column : input) {
+    std::vector<std::shared_ptr<Tensor>> tensors;
+    RETURN_IF_NOT_OK(UnstackTensor(column, &tensors));
+    if (rows.empty()) {
+      rows.resize(tensors.size());
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(tensors.size() == rows.size(), "Stacked columns have different numbers of rows");
+    for (size_t r = 0; r < tensors.size(); r++) {
+      rows[r].push_back(std::move(tensors[r]));
+    }
+  }
+  std::vector<TensorRow> results(rows.size());
+  for (size_t r = 0; r < rows.size(); r++) {
+    RETURN_IF_NOT_OK(Compute(rows[r], &results[r]));
+  }
+  output->clear();
+  for (size_t c = 0; !results.empty() && c < results[0].size(); c++) {
+    std::vector<std::shared_ptr<Tensor>> tensors;
+    for (auto &result : results) {
+      CHECK_FAIL_RETURN_UNEXPECTED(c < result.size(), "Rows have different numbers of output columns");
+      tensors.push_back(std::move(result[c]));
+    }
+    std::shared_ptr<Tensor> stacked;
+    RETURN_IF_NOT_OK(StackTensors(tensors, &stacked));
+    output->push_back(std::move(stacked));
+  }
+  return Status::OK();
+}
+
 void TensorOp::Print(std::ostream &out) const { out << "TensorOp" << std::endl; }
 
 Status TensorOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
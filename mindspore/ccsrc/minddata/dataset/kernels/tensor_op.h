@@ -91,6 +91,8 @@ constexpr char kBoundingBoxAugmentOp[] = "BoundingBoxAugmentOp";
 constexpr char kDecodeOp[] = "DecodeOp";
 constexpr char kCenterCropOp[] = "CenterCropOp";
 constexpr char kCutOutOp[] = "CutOutOp";
+constexpr char kFusedCropFlipOp[] = "FusedCropFlipOp";
+constexpr char kFusedNormalizeOp[] = "FusedNormalizeOp";
 constexpr char kHwcToChwOp[] = "HwcToChwOp";
 constexpr char kNormalizeOp[] = "NormalizeOp";
 constexpr char kPadOp[] = "PadOp";
@@ -178,6 +180,19 @@ class TensorOp {
   // @return Status
   virtual Status Compute(const TensorRow &input, TensorRow *output);
 
+  // Function to tell if ComputeBatch() does better than one Compute() per row. MapOp only stacks the rows of a
+  // buffer when every TensorOp it runs returns true.
+  // @return true/false
+  virtual bool SupportsBatch() const { return false; }
+
+  // Perform the operation on the rows of a whole buffer at once. Each input column holds the tensors of all the
+  // rows stacked along a new first dimension, and so does each output column.
+  // The default implementation splits the rows and calls Compute() on each of them.
+  // @param input is a vector of stacked Tensors, one per column.
+  // @param output is the address to an empty vector of shared_ptr to Tensor.
+  // @return Status
+  virtual Status ComputeBatch(const TensorRow &input, TensorRow *output);
+
   // Returns true oif the TensorOp takes one input and returns one output.
   // @return true/false
   bool OneToOne() { return NumInput() == 1 && NumOutput() == 1; }
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/double_array_trie.h"
+
+#include <algorithm>
+#include <queue>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int32_t kFree = -1;   // check_ of a slot not taken by any state
+constexpr int32_t kTaken = -2;  // check_ of the root, which has no parent
+
+// The words words[begin, end) share their first depth bytes, and lead to the state.
+struct Range {
+  DoubleArrayTrie::State state;
+  size_t begin;
+  size_t end;
+  size_t depth;
+};
+
+// A child of a state, reached by the byte label, with the words below it.
+struct Child {
+  uint8_t label;
+  size_t begin;
+  size_t end;
+};
+}  // namespace
+
+constexpr DoubleArrayTrie::State DoubleArrayTrie::kRoot;
+constexpr int32_t DoubleArrayTrie::kNoValue;
+
+void DoubleArrayTrie::Build(std::vector<std::pair<std::string_view, int32_t>> words) {
+  // Once sorted, the words below a state are a contiguous range, and a word ending at the state comes first
+  std::sort(words.begin(), words.end(),
+            [](const std::pair<std::string_view, int32_t> &a, const std::pair<std::string_view, int32_t> &b) {
+              return a.first < b.first;
+            });
+  base_.assign(1, 0);
+  check_.assign(1, kTaken);
+  value_.assign(1, kNoValue);
+  size_t first_free = 1;  // No slot before it is free
+  std::queue<Range> ranges;
+  ranges.push({kRoot, 0, words.size(), 0});
+  std::vector<Child> children;
+  // Breadth first, the states near the root end up close to each other at the front of the arrays
+  while (!ranges.empty()) {
+    Range r = ranges.front();
+    ranges.pop();
+    size_t i = r.begin;
+    if (i < r.end && words[i].first.size() == r.depth) {
+      value_[r.state] = words[i].second;
+      i++;
+    }
+    children.clear();
+    for (; i < r.end; i++) {
+      auto label = static_cast<uint8_t>(words[i].first[r.depth]);
+      if (children.empty() || children.back().label != label) {
+        children.push_back({label, i, i + 1});
+      } else {
+        children.back().end = i + 1;
+      }
+    }
+    if (children.empty()) {
+      continue;
+    }
+    // Find the first base which puts every child on a free slot, starting with the first free slot for the first
+    // child. Slots past the end of the arrays are free.
+    size_t base = 0;
+    for (size_t pos = std::max<size_t>(first_free, children[0].label + 1);; pos++) {
+      if (pos < check_.size() && check_[pos] != kFree) {
+        continue;
+      }
+      base = pos - children[0].label - 1;
+      bool fits = std::all_of(children.begin(), children.end(), [this, base](const Child &c) {
+        size_t t = base + c.label + 1;
+        return t >= check_.size() || check_[t] == kFree;
+      });
+      if (fits) {
+        break;
+      }
+    }
+    size_t size = base + children.back().label + 2;
+    if (size > check_.size()) {
+      base_.resize(size, 0);
+      check_.resize(size, kFree);
+      value_.resize(size, kNoValue);
+    }
+    base_[r.state] = static_cast<int32_t>(base);
+    for (const Child &c : children) {
+      auto t = static_cast<State>(base + c.label + 1);
+      check_[t] = r.state;
+      ranges.push({t, c.begin, c.end, r.depth + 1});
+    }
+    while (first_free < check_.size() && check_[first_free] != kFree) {
+      first_free++;
+    }
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
+#define DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+// A byte-wise trie of words, stored in two arrays.
+//
+// The child of the state s by the byte c is the state t = base_[s] + c + 1, which is valid iff check_[t] == s. The
+// root is the state 0. value_[s] holds the value of the word ending at s, or kNoValue if no word ends there. A
+// lookup touches one slot of each array per byte, without hashing or allocating, and the states reached along the
+// way give every word that prefixes the key.
+class DoubleArrayTrie {
+ public:
+  using State = int32_t;
+
+  static constexpr State kRoot = 0;
+  static constexpr int32_t kNoValue = -1;
+
+  DoubleArrayTrie() = default;
+
+  ~DoubleArrayTrie() = default;
+
+  // Builds the trie, replacing its content.
+  // @param std::vector<std::pair<std::string_view, int32_t>> words - the words and their values, unique words
+  void Build(std::vector<std::pair<std::string_view, int32_t>> words);
+
+  // @param std::string_view key - word to look up
+  // @return the value of the word, or kNoValue if it is not in the trie
+  int32_t Find(std::string_view key) const {
+    State s = kRoot;
+    return Walk(key, &s) ? value_[s] : kNoValue;
+  }
+
+  // Follows a byte from a state.
+  // @param uint8_t c - the byte
+  // @param State *s - the state, moved to the child on success
+  // @return true if the child exists
+  bool Next(uint8_t c, State *s) const {
+    size_t t = static_cast<size_t>(base_[*s]) + c + 1;
+    if (t >= check_.size() || check_[t] != *s) {
+      return false;
+    }
+    *s = static_cast<State>(t);
+    return true;
+  }
+
+  // Follows the bytes of a key from a state.
+  // @param std::string_view key - the bytes
+  // @param State *s - the state, moved to the end of the key on success and left unchanged otherwise
+  // @return true if the whole key is in the trie
+  bool Walk(std::string_view key, State *s) const {
+    if (base_.empty()) {
+      return false;
+    }
+    State t = *s;
+    for (char c : key) {
+      if (!Next(static_cast<uint8_t>(c), &t)) {
+        return false;
+      }
+    }
+    *s = t;
+    return true;
+  }
+
+  // @return the value of the word ending at a state, or kNoValue
+  int32_t Value(State s) const { return value_[s]; }
+
+  bool empty() const { return base_.empty(); }
+
+ private:
+  std::vector<int32_t> base_;
+  std::vector<State> check_;
+  std::vector<int32_t> value_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/kernels/ascii_scan.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mindspore {
+namespace dataset {
+namespace {
+inline bool IsNonAscii(char c) { return static_cast<uint8_t>(c) >= 0x80; }
+
+#if defined(__SSE2__)
+constexpr size_t kBlock = 16;
+
+// @return 0xFF in the bytes of v within [lo, hi], 0 in the others
+inline __m128i InRange(__m128i v, uint8_t lo, uint8_t hi) {
+  __m128i ge_lo = _mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(static_cast<char>(lo))), v);
+  __m128i le_hi = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(static_cast<char>(hi))), v);
+  return _mm_and_si128(ge_lo, le_hi);
+}
+
+// @return one bit for each byte of the block which is a space, or punctuation if kPunct, or not ASCII
+template <bool kPunct>
+inline uint32_t BlockMask(const char *block) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+  __m128i m = _mm_or_si128(InRange(v, '\t', '\r'), _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+  if (kPunct) {
+    m = _mm_or_si128(m, _mm_or_si128(InRange(v, '!', '/'), InRange(v, ':', '@')));
+    m = _mm_or_si128(m, _mm_or_si128(InRange(v, '[', '`'), InRange(v, '{', '~')));
+  }
+  // The non ASCII bytes are those with the top bit set, which movemask picks up as they are
+  return static_cast<uint32_t>(_mm_movemask_epi8(m) | _mm_movemask_epi8(v));
+}
+#endif
+
+template <bool kPunct>
+size_t Find(const char *data, size_t size, size_t pos) {
+#if defined(__SSE2__)
+  for (; pos + kBlock <= size; pos += kBlock) {
+    uint32_t mask = BlockMask<kPunct>(data + pos);
+    if (mask != 0) {
+      return pos + __builtin_ctz(mask);
+    }
+  }
+#endif
+  for (; pos < size; pos++) {
+    char c = data[pos];
+    if (IsAsciiSpace(c) || IsNonAscii(c) || (kPunct && IsAsciiPunct(c))) {
+      return pos;
+    }
+  }
+  return size;
+}
+}  // namespace
+
+size_t AsciiPrefixLength(const char *data, size_t size) {
+  size_t pos = 0;
+#if defined(__SSE2__)
+  for (; pos + kBlock <= size; pos += kBlock) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(v));
+    if (mask != 0) {
+      return pos + __builtin_ctz(mask);
+    }
+  }
+#endif
+  while (pos < size && !IsNonAscii(data[pos])) {
+    pos++;
+  }
+  return pos;
+}
+
+size_t FindSpaceOrNonAscii(const char *data, size_t size, size_t pos) { return Find<false>(data, size, pos); }
+
+size_t FindSpacePunctOrNonAscii(const char *data, size_t size, size_t pos) { return Find<true>(data, size, pos); }
+
+size_t DecodeUtf8(const char *data, size_t size, uint32_t *rune) {
+  if (size == 0) {
+    return 0;
+  }
+  auto b = reinterpret_cast<const uint8_t *>(data);
+  if (b[0] < 0x80) {
+    *rune = b[0];
+    return 1;
+  }
+  if (b[0] <= 0xDF && size > 1) {
+    *rune = (static_cast<uint32_t>(b[0] & 0x1F) << 6) | (b[1] & 0x3F);
+    return 2;
+  }
+  if (b[0] <= 0xEF && size > 2) {
+    *rune = (static_cast<uint32_t>(b[0] & 0x0F) << 12) | (static_cast<uint32_t>(b[1] & 0x3F) << 6) | (b[2] & 0x3F);
+    return 3;
+  }
+  if (b[0] <= 0xF7 && size > 3) {
+    *rune = (static_cast<uint32_t>(b[0] & 0x07) << 18) | (static_cast<uint32_t>(b[1] & 0x3F) << 12) |
+            (static_cast<uint32_t>(b[2] & 0x3F) << 6) | (b[3] & 0x3F);
+    return 4;
+  }
+  return 0;
+}
+
+bool IsValidUtf8(const char *data, size_t size) {
+  size_t pos = 0;
+  while (true) {
+    pos += AsciiPrefixLength(data + pos, size - pos);
+    if (pos == size) {
+      return true;
+    }
+    uint32_t rune = 0;
+    size_t len = DecodeUtf8(data + pos, size - pos, &rune);
+    if (len == 0) {
+      return false;
+    }
+    pos += len;
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
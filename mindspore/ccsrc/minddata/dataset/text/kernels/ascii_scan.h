@@ -0,0 +1,60 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_TEXT_KERNELS_ASCII_SCAN_H_
+#define DATASET_TEXT_KERNELS_ASCII_SCAN_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Scans of UTF-8 text for the bytes the tokenizers split at. Most text is mostly ASCII, so the scans look at 16
+// bytes at a time with SSE2 where it is available, and leave the rare non-ASCII characters to the caller.
+namespace mindspore {
+namespace dataset {
+// @return true for \t, \n, \v, \f, \r and space, the ASCII characters with the Unicode White_Space property
+inline bool IsAsciiSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+// @return true for the ASCII punctuation [!-/], [:-@], [[-`] and [{-~]
+inline bool IsAsciiPunct(char c) {
+  return (c >= '!' && c <= '/') || (c >= ':' && c <= '@') || (c >= '[' && c <= '`') || (c >= '{' && c <= '~');
+}
+
+// @param const char *data, size_t size - text
+// @return the number of bytes before the first byte which is not ASCII
+size_t AsciiPrefixLength(const char *data, size_t size);
+
+// @param const char *data, size_t size - text
+// @param size_t pos - where to start
+// @return the position of the first byte from pos which is an ASCII space or not ASCII, or size if there is none
+size_t FindSpaceOrNonAscii(const char *data, size_t size, size_t pos);
+
+// @param const char *data, size_t size - text
+// @param size_t pos - where to start
+// @return the position of the first byte from pos which is an ASCII space or punctuation or not ASCII, or size if
+//     there is none
+size_t FindSpacePunctOrNonAscii(const char *data, size_t size, size_t pos);
+
+// Decodes one character, the same way as cppjieba: the lead byte alone gives the length of the character.
+// @param const char *data, size_t size - text starting with the character
+// @param uint32_t *rune - Returned code point
+// @return the length of the character, or 0 if the text ends before it does or the lead byte is above 0xF7
+size_t DecodeUtf8(const char *data, size_t size, uint32_t *rune);
+
+// @param const char *data, size_t size - text
+// @return true if every character of the text decodes with DecodeUtf8()
+bool IsValidUtf8(const char *data, size_t size);
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_TEXT_KERNELS_ASCII_SCAN_H_
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "minddata/dataset/text/kernels/basic_tokenizer_op.h"
+#include <algorithm>
 #include <memory>
 #include <queue>
 #include <string>
@@ -25,6 +26,8 @@
 #include "unicode/normalizer2.h"
 #include "unicode/utypes.h"
 
+#include "minddata/dataset/text/kernels/ascii_scan.h"
+
 namespace mindspore {
 namespace dataset {
 
@@ -50,6 +53,49 @@ const char BasicTokenizerOp::kCommonPattern[] =
 const char BasicTokenizerOp::kUnusedPattern[] = "\\[CLS\\]|\\[SEP\\]|\\[UNK\\]|\\[PAD\\]|\\[MASK\\]|\\[unused\\d+\\]|";
 const std::unordered_set<std::string> BasicTokenizerOp::kUnusedWords{"[CLS]", "[SEP]", "[UNK]", "[PAD]", "[MASK]"};
 
+namespace {
+// Get the first and last offsets of the unused words in a text, which are not case folded.
+void FindUnusedWords(const std::string_view &text, const std::unordered_set<std::string> &unused_words,
+                     std::queue<std::pair<int, int>> *offsets) {
+  int start = -1;
+  int len = 0;
+  for (int i = 0; i < text.length(); i++) {
+    if (text[i] == '[') {
+      start = i;
+      ++len;
+    } else if (text[i] == ']' && start >= 0) {
+      ++len;
+      std::string word(text.substr(start, len));
+      if (unused_words.find(word) != unused_words.end()) {
+        offsets->push(std::make_pair(start, start + len - 1));
+      }
+      start = -1;
+      len = 0;
+    } else if (start >= 0) {
+      ++len;
+    }
+  }
+}
+
+// @return the length of the token matched by kUnusedPattern at the start of text, or 0 if there is none
+size_t UnusedTokenLength(const std::string_view &text) {
+  for (const char *word : {"[CLS]", "[SEP]", "[UNK]", "[PAD]", "[MASK]"}) {
+    if (text.substr(0, std::char_traits<char>::length(word)) == word) {
+      return std::char_traits<char>::length(word);
+    }
+  }
+  constexpr std::string_view kUnused = "[unused";
+  if (text.substr(0, kUnused.size()) != kUnused) {
+    return 0;
+  }
+  size_t i = kUnused.size();
+  while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+    i++;
+  }
+  return i > kUnused.size() && i < text.size() && text[i] == ']' ? i + 1 : 0;
+}
+}  // namespace
+
 BasicTokenizerOp::BasicTokenizerOp(const bool &lower_case, const bool &keep_whitespace,
                                    const NormalizeForm &normalization_form, const bool &preserve_unused_token,
                                    const bool &with_offsets)
@@ -87,27 +133,10 @@ Status BasicTokenizerOp::CaseFoldWithoutUnusedWords(const std::string_view &text
 
   // 1. get start and end offsets of not case fold strs
   std::queue<std::pair<int, int>> offsets;  // offsets of not used words
-  int start = -1;
-  int len = 0;
-  for (int i = 0; i < text.length(); i++) {
-    if (text[i] == '[') {
-      start = i;
-      ++len;
-    } else if (text[i] == ']' && start >= 0) {
-      ++len;
-      std::string word(text.substr(start, len));
-      if (unused_words.find(word) != unused_words.end()) {
-        offsets.push(std::make_pair(start, start + len - 1));
-      }
-      start = -1;
-      len = 0;
-    } else if (start >= 0) {
-      ++len;
-    }
-  }
+  FindUnusedWords(text, unused_words, &offsets);
 
   // 2. Do not apply case fold on `unused_words`
-  start = 0;
+  int start = 0;
   for (int i = 0; i < text.length();) {
     std::string_view process_text;
     std::string preserve_token;
@@ -140,12 +169,90 @@ Status BasicTokenizerOp::CaseFoldWithoutUnusedWords(const std::shared_ptr<Tensor
   return Status::OK();
 }
 
+Status BasicTokenizerOp::TokenizeAscii(const std::string_view &text, TensorRow *output) const {
+  std::string str(text);
+  if (lower_case_) {
+    std::queue<std::pair<int, int>> offsets;
+    if (preserve_unused_token_) {
+      FindUnusedWords(text, kUnusedWords, &offsets);
+    }
+    for (int i = 0; i < str.size(); i++) {
+      if (!offsets.empty() && i == offsets.front().first) {
+        i = offsets.front().second;
+        offsets.pop();
+      } else if (str[i] >= 'A' && str[i] <= 'Z') {
+        str[i] = static_cast<char>(str[i] - 'A' + 'a');
+      }
+    }
+  }
+  // \p{Cc} and \p{Cf} of ASCII
+  for (char &c : str) {
+    if (static_cast<uint8_t>(c) < 0x20 || c == 0x7F) {
+      c = ' ';
+    }
+  }
+
+  std::vector<std::string> tokens;
+  std::vector<uint32_t> offsets_start;
+  std::vector<uint32_t> offsets_limit;
+  auto add_token = [&](size_t start, size_t end) {
+    tokens.emplace_back(str, start, end - start);
+    offsets_start.push_back(static_cast<uint32_t>(start));
+    offsets_limit.push_back(static_cast<uint32_t>(end));
+  };
+  size_t token_start = 0;
+  for (size_t pos = FindSpacePunctOrNonAscii(str.data(), str.size(), 0); pos < str.size();
+       pos = FindSpacePunctOrNonAscii(str.data(), str.size(), pos)) {
+    size_t delim_len = 1;
+    bool keep_delim = true;
+    if (str[pos] == ' ') {
+      while (pos + delim_len < str.size() && str[pos + delim_len] == ' ') {
+        delim_len++;
+      }
+      keep_delim = keep_whitespace_;
+    } else if (preserve_unused_token_ && str[pos] == '[') {
+      delim_len = std::max<size_t>(UnusedTokenLength(std::string_view(str).substr(pos)), 1);
+    }
+    if (pos > token_start) {
+      add_token(token_start, pos);
+    }
+    if (keep_delim) {
+      add_token(pos, pos + delim_len);
+    }
+    pos += delim_len;
+    token_start = pos;
+  }
+  if (token_start < str.size()) {
+    add_token(token_start, str.size());
+  }
+
+  std::shared_ptr<Tensor> token_tensor, offsets_start_tensor, offsets_limit_tensor;
+  token_tensor = std::make_shared<Tensor>(std::move(tokens), TensorShape({(dsize_t)tokens.size()}));
+  output->push_back(token_tensor);
+  if (with_offsets_) {
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&offsets_start_tensor, TensorImpl::kFlexible,
+                                          TensorShape({(dsize_t)offsets_start.size()}), DataType(DataType::DE_UINT32),
+                                          reinterpret_cast<unsigned char *>(&offsets_start[0])));
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&offsets_limit_tensor, TensorImpl::kFlexible,
+                                          TensorShape({(dsize_t)offsets_limit.size()}), DataType(DataType::DE_UINT32),
+                                          reinterpret_cast<unsigned char *>(&offsets_limit[0])));
+    output->push_back(offsets_start_tensor);
+    output->push_back(offsets_limit_tensor);
+  }
+  return Status::OK();
+}
+
 Status BasicTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
   CHECK_FAIL_RETURN_UNEXPECTED(input.size() == 1, "Input should be one tensor");
   if (input[0]->Rank() != 0 || input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED("The input tensor should be scalar string tensor");
   }
+  std::string_view text;
+  RETURN_IF_NOT_OK(input[0]->GetItemAt(&text, {}));
+  if (AsciiPrefixLength(text.data(), text.size()) == text.size()) {
+    return TokenizeAscii(text, output);
+  }
   std::shared_ptr<Tensor> cur_input;
   std::shared_ptr<Tensor> processed_tensor;
   if (lower_case_) {
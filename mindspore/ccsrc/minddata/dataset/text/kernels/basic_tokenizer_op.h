@@ -54,6 +54,14 @@ class BasicTokenizerOp : public TensorOp {
                                     std::string *outupt);
   Status CaseFoldWithoutUnusedWords(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
 
+  // Does the same as Compute() for ASCII text, in one pass over it without ICU. Case folding of ASCII text is
+  // lowering the case, the normalization and the accent stripping leave it as it is, and the delimiters are single
+  // bytes but for the runs of spaces and the unused tokens.
+  // @param std::string_view text - ASCII text
+  // @param TensorRow *output - Returned tokens, and offsets if with_offsets_
+  // @return Status - The error code return
+  Status TokenizeAscii(const std::string_view &text, TensorRow *output) const;
+
   std::string Name() const override { return kBasicTokenizerOp; }
 
  private:
@@ -20,13 +20,11 @@
 #include <utility>
 #include <vector>
 
-#include "cppjieba/Unicode.hpp"
 #include "unicode/errorcode.h"
 #include "unicode/uchar.h"
 #include "unicode/uscript.h"
 
-using cppjieba::DecodeRunesInString;
-using cppjieba::RuneStrArray;
+#include "minddata/dataset/text/kernels/ascii_scan.h"
 
 namespace mindspore {
 namespace dataset {
@@ -42,38 +40,37 @@ Status WhitespaceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
   std::string_view str;
   RETURN_IF_NOT_OK(input[0]->GetItemAt(&str, {}));
 
-  RuneStrArray runes;
-  if (!DecodeRunesInString(str.data(), str.size(), runes)) {
-    RETURN_STATUS_UNEXPECTED("Decode utf8 string failed.");
-  }
-
   std::shared_ptr<Tensor> token_tensor, offsets_start_tensor, offsets_limit_tensor;
   std::vector<uint32_t> offsets_start, offsets_limit;
   std::vector<std::string> splits;
-  int start = 0;
-  int len = 0;
-  for (size_t i = 0; i < runes.size(); i++) {
-    if (u_isUWhiteSpace(runes[i].rune)) {
-      if (len > 0) {
-        offsets_start.push_back(static_cast<uint32_t>(start));
-        offsets_limit.push_back(static_cast<uint32_t>(start + len));
-        std::string temp(str.substr(start, len));
-        splits.emplace_back(std::move(temp));
-        len = 0;
-      }
-    } else {
+  auto add_split = [&](size_t start, size_t end) {
+    if (end > start) {
+      offsets_start.push_back(static_cast<uint32_t>(start));
+      offsets_limit.push_back(static_cast<uint32_t>(end));
+      splits.emplace_back(str.substr(start, end - start));
+    }
+  };
+  // Jump from one ASCII space or non ASCII character to the next, only the latter need to be decoded
+  size_t start = 0;
+  for (size_t pos = FindSpaceOrNonAscii(str.data(), str.size(), 0); pos < str.size();
+       pos = FindSpaceOrNonAscii(str.data(), str.size(), pos)) {
+    size_t len = 1;
+    bool is_space = true;
+    if (static_cast<uint8_t>(str[pos]) >= 0x80) {
+      uint32_t rune = 0;
+      len = DecodeUtf8(str.data() + pos, str.size() - pos, &rune);
       if (len == 0) {
-        start = runes[i].offset;
+        RETURN_STATUS_UNEXPECTED("Decode utf8 string failed.");
       }
-      len += runes[i].len;
+      is_space = u_isUWhiteSpace(rune);
     }
+    if (is_space) {
+      add_split(start, pos);
+      start = pos + len;
+    }
+    pos += len;
   }
-  if (len > 0) {
-    offsets_start.push_back(static_cast<uint32_t>(start));
-    offsets_limit.push_back(static_cast<uint32_t>(start + len));
-    std::string temp(str.substr(start, len));
-    splits.emplace_back(std::move(temp));
-  }
+  add_split(start, str.size());
   if (splits.empty()) {
     splits.emplace_back("");
     offsets_start.push_back(0);
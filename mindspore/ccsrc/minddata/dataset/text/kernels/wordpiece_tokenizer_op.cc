@@ -18,6 +18,8 @@
 #include <algorithm>
 #include <utility>
 
+#include "minddata/dataset/text/kernels/ascii_scan.h"
+
 namespace mindspore {
 namespace dataset {
 
@@ -35,26 +37,17 @@ WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
       unknown_token_(unknown_token),
       with_offsets_(with_offsets) {}
 
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
+Status WordpieceTokenizerOp::LookupWord(std::string_view input_token, const int start, bool *out_found,
+                                        int *out_end) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "Out of range");
-  *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
-    }
-    if (vocab_->Lookup(word) != Vocab::kNoTokenExists) {
-      *out_found = true;
-      break;
-    }
-  }
+  std::string_view prefix = start > 0 ? std::string_view(suffix_indicator_) : std::string_view();
+  size_t len = 0;
+  *out_found = vocab_->LongestPrefix(prefix, input_token.substr(start), &len) != Vocab::kNoTokenExists;
+  *out_end = start + static_cast<int>(len);
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::FoundNoToken(std::string_view input_token, const uint32_t &basic_start,
                                           std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                           std::vector<uint32_t> *offsets_limit) const {
   out_tokens->clear();
@@ -69,18 +62,20 @@ Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const int &start, const int &end,
+Status WordpieceTokenizerOp::AddSubword(std::string_view input_token, const int &start, const int &end,
                                         std::vector<std::string> *out_tokens) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && end > start && end <= input_token.size(), "Out of range");
-  std::string subword = input_token.substr(start, end - start);
+  std::string subword;
   if (start > 0) {
-    subword = suffix_indicator_ + subword;
+    subword.reserve(suffix_indicator_.size() + end - start);
+    subword = suffix_indicator_;
   }
-  out_tokens->emplace_back(subword);
+  subword.append(input_token.substr(start, end - start));
+  out_tokens->emplace_back(std::move(subword));
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::GetTokens(std::string_view input_token, const uint32_t &basic_start,
                                        std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                        std::vector<uint32_t> *offsets_limit) const {
   if (input_token.size() > max_bytes_per_token_) {
@@ -94,14 +89,13 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
     }
     return Status::OK();
   }
-  RuneStrArray runes;
-  if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
+  if (!IsValidUtf8(input_token.data(), input_token.size())) {
     RETURN_STATUS_UNEXPECTED("Decode utf8 string failed.");
   }
   int end = 0;
   for (int start = 0; start < input_token.size();) {
     bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
+    RETURN_IF_NOT_OK(LookupWord(input_token, start, &found, &end));
     if (found) {
       RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
       offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
@@ -122,15 +116,17 @@ Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
   dsize_t count = 0;
   std::vector<std::string> out_tokens;
   std::vector<uint32_t> offsets_start, offsets_limit;
+  std::vector<std::string> temp_tokens;
   std::shared_ptr<Tensor> token_tensor, offsets_start_tensor, offsets_limit_tensor;
   for (auto iter = input[0]->begin<std::string_view>(); iter != input[0]->end<std::string_view>(); iter++) {
     uint32_t basic_start = 0;
-    std::vector<std::string> temp_tokens;
+    temp_tokens.clear();
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count, 0}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
-    out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
+    RETURN_IF_NOT_OK(GetTokens(*iter, basic_start, &temp_tokens, &offsets_start, &offsets_limit));
+    out_tokens.insert(out_tokens.end(), std::make_move_iterator(temp_tokens.begin()),
+                      std::make_move_iterator(temp_tokens.end()));
     count++;
   }
   if (out_tokens.empty()) {
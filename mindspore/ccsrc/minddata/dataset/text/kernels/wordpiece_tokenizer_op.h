@@ -20,15 +20,11 @@
 #include <string_view>
 #include <vector>
 
-#include "cppjieba/Unicode.hpp"
-
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/text/vocab.h"
 #include "minddata/dataset/util/status.h"
 
-using cppjieba::DecodeRunesInString;
-using cppjieba::RuneStrArray;
 namespace mindspore {
 namespace dataset {
 
@@ -49,13 +45,13 @@ class WordpieceTokenizerOp : public TensorOp {
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
  protected:
-  Status AddSubword(const std::string &input_token, const int &start, const int &end,
+  Status AddSubword(std::string_view input_token, const int &start, const int &end,
                     std::vector<std::string> *out_token) const;
-  Status FoundNoToken(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+  Status FoundNoToken(std::string_view input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
                       std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
-  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start, bool *out_found,
-                    int *out_end) const;
-  Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+  // Finds the longest subword of the vocab starting at start, with the suffix indicator unless start is 0.
+  Status LookupWord(std::string_view input_token, const int start, bool *out_found, int *out_end) const;
+  Status GetTokens(std::string_view input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
                    std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
 
   std::string Name() const override { return kWordpieceTokenizerOp; }
@@ -17,16 +17,49 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "minddata/dataset/text/vocab.h"
 
 namespace mindspore {
 namespace dataset {
-Vocab::Vocab(std::unordered_map<WordType, WordIdType> word2id) { word2id_ = std::move(word2id); }
+Vocab::Vocab(std::unordered_map<WordType, WordIdType> word2id) : trie_ready_(false) { word2id_ = std::move(word2id); }
+
+const DoubleArrayTrie &Vocab::Trie() const {
+  if (!trie_ready_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lck(trie_mux_);
+    if (!trie_ready_.load(std::memory_order_relaxed)) {
+      // The keys of word2id_ do not move, the trie refers to them while it is built
+      std::vector<std::pair<std::string_view, int32_t>> words(word2id_.begin(), word2id_.end());
+      trie_.Build(std::move(words));
+      trie_ready_.store(true, std::memory_order_release);
+    }
+  }
+  return trie_;
+}
+
+WordIdType Vocab::Lookup(std::string_view word) const { return Trie().Find(word); }
 
-WordIdType Vocab::Lookup(const WordType &word) const {
-  auto itr = word2id_.find(word);
-  return itr == word2id_.end() ? kNoTokenExists : itr->second;
+WordIdType Vocab::LongestPrefix(std::string_view prefix, std::string_view text, size_t *len) const {
+  const DoubleArrayTrie &trie = Trie();
+  *len = 0;
+  DoubleArrayTrie::State s = DoubleArrayTrie::kRoot;
+  if (!trie.Walk(prefix, &s)) {
+    return kNoTokenExists;
+  }
+  WordIdType id = kNoTokenExists;
+  for (size_t i = 0; i < text.size(); i++) {
+    if (!trie.Next(static_cast<uint8_t>(text[i]), &s)) {
+      break;
+    }
+    // A word may end here if the next byte is not a continuation byte of a UTF-8 character
+    bool at_boundary = i + 1 == text.size() || (static_cast<uint8_t>(text[i + 1]) & 0xC0) != 0x80;
+    if (at_boundary && trie.Value(s) != DoubleArrayTrie::kNoValue) {
+      id = trie.Value(s);
+      *len = i + 1;
+    }
+  }
+  return id;
 }
 
 Status Vocab::BuildFromPyList(const py::list &words, const py::list &special_tokens, bool prepend_special,
@@ -98,6 +131,7 @@ Status Vocab::BuildFromPyDict(const py::dict &words, std::shared_ptr<Vocab> *voc
 void Vocab::append_word(const std::string &word) {
   if (word2id_.find(word) == word2id_.end()) {
     word2id_[word] = word2id_.size();
+    trie_ready_ = false;
   }
 }
 
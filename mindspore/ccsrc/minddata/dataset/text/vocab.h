@@ -17,11 +17,15 @@
 #ifndef DATASET_TEXT_VOCAB_H_
 #define DATASET_TEXT_VOCAB_H_
 
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
+#include "minddata/dataset/text/double_array_trie.h"
 #include "minddata/dataset/util/status.h"
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
@@ -57,17 +61,24 @@ class Vocab {
   static Status BuildFromFile(const std::string &path, const std::string &delimiter, int32_t vocab_size,
                               const py::list &special_tokens, bool prepend_special, std::shared_ptr<Vocab> *vocab);
 
-  // Lookup the id of a word, if word doesn't exist in vocab, return default_id
-  // @param const WordType word - word to look up
-  // @param WordIdType default_id - word id to return to user when its not in the vocab
+  // Lookup the id of a word, if word doesn't exist in vocab, return kNoTokenExists
+  // @param std::string_view word - word to look up
   // @return WordIdType, word_id
-  WordIdType Lookup(const WordType &word) const;
+  WordIdType Lookup(std::string_view word) const;
+
+  // Find the longest word of the vocab which is prefix + a prefix of text, in one pass over text. Only the matches
+  // ending at a UTF-8 character boundary of text count.
+  // @param std::string_view prefix - to be matched in full before text, e.g. the suffix indicator of WordPiece
+  // @param std::string_view text - text to match
+  // @param size_t *len - Returned number of bytes of text in the word, 0 if no word is found
+  // @return WordIdType, id of the word, or kNoTokenExists
+  WordIdType LongestPrefix(std::string_view prefix, std::string_view text, size_t *len) const;
 
   // constructor, shouldn't be called directly, can't be private due to std::make_unique()
   // @param std::unordered_map<WordType, WordIdType> map - sanitized word2id map
   explicit Vocab(std::unordered_map<WordType, WordIdType> map);
 
-  Vocab() = default;
+  Vocab() : trie_ready_(false) {}
 
   // add one word to vocab, increment it's index automatically
   // @param std::string & word - word to be added will skip if word already exists
@@ -79,7 +90,15 @@ class Vocab {
   static const WordIdType kNoTokenExists;
 
  private:
+  // @return the trie of the words, built on first use after the vocab changes
+  const DoubleArrayTrie &Trie() const;
+
   std::unordered_map<WordType, WordIdType> word2id_;
+  // The lookups go to a trie of word2id_. A vocab is filled before it is looked up, so the trie is built once, by
+  // the first lookup, rather than kept up to date by every append_word().
+  mutable DoubleArrayTrie trie_;
+  mutable std::atomic<bool> trie_ready_;
+  mutable std::mutex trie_mux_;
 };
 
 }  // namespace dataset
@@ -173,6 +173,41 @@ class Queue {
     return rc;
   }
 
+  // Change the capacity of the queue while it is in use. The elements in the queue are kept, and producers
+  // waiting for room are woken up if the queue grows.
+  // @param capacity The new capacity. It must not be smaller than the number of elements in the queue.
+  // @return Status
+  Status Resize(int capacity) {
+    std::unique_lock<std::mutex> _lock(mux_);
+    if (capacity <= 0 || capacity < size()) {
+      return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
+                    "Cannot resize queue " + my_name_ + " to " + std::to_string(capacity) + " elements.");
+    }
+    auto sz = static_cast<uint64_t>(capacity);
+    pointer arr = alloc_.allocate(sz);
+    for (uint64_t i = 0; i < sz; i++) {
+      std::allocator_traits<Allocator<T>>::construct(alloc_, &(arr[i]));
+    }
+    uint64_t n = 0;
+    for (uint64_t i = head_; i < tail_; i++) {
+      arr[n++] = std::move(arr_[i % sz_]);
+    }
+    if (std::is_destructible<T>::value) {
+      for (uint64_t i = 0; i < sz_; i++) {
+        arr_[i].~T();
+      }
+    }
+    if (arr_) {
+      alloc_.deallocate(arr_);
+    }
+    arr_ = arr;
+    sz_ = sz;
+    head_ = 0;
+    tail_ = n;
+    full_cv_.NotifyAll();
+    return Status::OK();
+  }
+
   void ResetQue() noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // If there are elements in the queue, invoke its destructor one by one.
@@ -0,0 +1,296 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/size_class_pool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include "./securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Every block starts with a header holding its size class. 16 bytes keep the alignment given by malloc.
+constexpr size_t kHeaderSize = 16;
+constexpr uint32_t kUnpooledClass = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t kMinClassLog = 6;  // The smallest class has 64 bytes
+constexpr uint32_t kClassesPerLog = 4;
+constexpr size_t kCentralBatch = 8;  // Blocks a thread takes from the central cache at a time
+
+std::atomic<uint64_t> next_pool_id(0);
+
+// Set once the caches of the thread are destroyed, the thread then goes to the central cache directly.
+thread_local bool thread_caches_destroyed = false;
+
+inline void *BlockToUser(void *block) { return static_cast<char *>(block) + kHeaderSize; }
+
+inline void *UserToBlock(void *p) { return static_cast<char *>(p) - kHeaderSize; }
+
+inline uint32_t *BlockClass(void *block) { return static_cast<uint32_t *>(block); }
+
+uint32_t NumClasses() { return SizeClassPool::SizeToClass(SizeClassPool::kMaxPooledSize) + 1; }
+}  // namespace
+
+constexpr size_t SizeClassPool::kMaxPooledSize;
+
+struct SizeClassPool::CentralCache {
+  explicit CentralCache(size_t max_bytes) : max_bytes(max_bytes), bytes(0), lists(NumClasses()), hits(0), misses(0) {}
+
+  ~CentralCache() { Trim(); }
+
+  // Takes the blocks of a thread, and frees those that do not fit in the limit.
+  void Put(uint32_t size_class, std::vector<void *> *blocks) {
+    size_t block_size = ClassToSize(size_class);
+    std::lock_guard<std::mutex> lck(mux);
+    for (void *block : *blocks) {
+      if (bytes + block_size <= max_bytes) {
+        lists[size_class].push_back(block);
+        bytes += block_size;
+      } else {
+        free(block);
+      }
+    }
+    blocks->clear();
+  }
+
+  void Trim() {
+    std::lock_guard<std::mutex> lck(mux);
+    for (auto &list : lists) {
+      for (void *block : list) {
+        free(block);
+      }
+      list.clear();
+      list.shrink_to_fit();
+    }
+    bytes = 0;
+  }
+
+  std::mutex mux;
+  size_t max_bytes;
+  size_t bytes;
+  std::vector<std::vector<void *>> lists;
+  std::atomic<uint64_t> hits;
+  std::atomic<uint64_t> misses;
+};
+
+struct SizeClassPool::ThreadCache {
+  ThreadCache(uint64_t pool_id, const std::shared_ptr<CentralCache> &central)
+      : pool_id(pool_id), central(central), bytes(0), lists(NumClasses()) {}
+
+  ~ThreadCache() { Flush(); }
+
+  // Hands every block to the central cache, or frees them if the pool is gone.
+  void Flush() {
+    auto c = central.lock();
+    for (uint32_t i = 0; i < lists.size(); i++) {
+      if (c != nullptr) {
+        c->Put(i, &lists[i]);
+      } else {
+        for (void *block : lists[i]) {
+          free(block);
+        }
+        lists[i].clear();
+      }
+    }
+    bytes = 0;
+  }
+
+  uint64_t pool_id;
+  std::weak_ptr<CentralCache> central;
+  size_t bytes;
+  std::vector<std::vector<void *>> lists;
+};
+
+SizeClassPool::SizeClassPool(size_t max_thread_cache_bytes, size_t max_central_cache_bytes)
+    : pool_id_(next_pool_id++),
+      max_thread_cache_bytes_(max_thread_cache_bytes),
+      central_(std::make_shared<CentralCache>(max_central_cache_bytes)) {}
+
+// The blocks cached by other threads are freed when those threads exit.
+SizeClassPool::~SizeClassPool() { central_.reset(); }
+
+uint32_t SizeClassPool::SizeToClass(size_t n) {
+  if (n <= (1u << kMinClassLog)) {
+    return 0;
+  }
+  // n is in (2^k, 2^(k+1)], which is split in kClassesPerLog classes
+  uint32_t k = 63 - __builtin_clzll(static_cast<uint64_t>(n - 1));
+  size_t base = static_cast<size_t>(1) << k;
+  size_t step = base / kClassesPerLog;
+  auto idx = static_cast<uint32_t>((n - base + step - 1) / step);
+  return (k - kMinClassLog) * kClassesPerLog + idx;
+}
+
+size_t SizeClassPool::ClassToSize(uint32_t size_class) {
+  if (size_class == 0) {
+    return static_cast<size_t>(1) << kMinClassLog;
+  }
+  uint32_t k = kMinClassLog + (size_class - 1) / kClassesPerLog;
+  uint32_t idx = (size_class - 1) % kClassesPerLog + 1;
+  size_t base = static_cast<size_t>(1) << k;
+  return base + idx * (base / kClassesPerLog);
+}
+
+SizeClassPool::ThreadCache *SizeClassPool::GetThreadCache() {
+  struct ThreadCaches {
+    ~ThreadCaches() { thread_caches_destroyed = true; }
+    std::vector<std::unique_ptr<ThreadCache>> caches;
+  };
+  if (thread_caches_destroyed) {
+    return nullptr;
+  }
+  thread_local ThreadCaches thread_caches;
+  auto &caches = thread_caches.caches;
+  for (auto &cache : caches) {
+    if (cache->pool_id == pool_id_) {
+      return cache.get();
+    }
+  }
+  // First use of this pool by the thread. Drop the caches of pools that no longer exist while here.
+  caches.erase(std::remove_if(caches.begin(), caches.end(),
+                              [](const std::unique_ptr<ThreadCache> &cache) { return cache->central.expired(); }),
+               caches.end());
+  caches.push_back(std::make_unique<ThreadCache>(pool_id_, central_));
+  return caches.back().get();
+}
+
+Status SizeClassPool::AllocateFromCentral(uint32_t size_class, void **block) {
+  ThreadCache *tc = GetThreadCache();
+  {
+    std::lock_guard<std::mutex> lck(central_->mux);
+    auto &list = central_->lists[size_class];
+    if (!list.empty()) {
+      *block = list.back();
+      list.pop_back();
+      central_->bytes -= ClassToSize(size_class);
+      // Take a few more while holding the lock, the thread likely asks for this size again
+      size_t n = tc != nullptr ? std::min(list.size(), kCentralBatch - 1) : 0;
+      for (size_t i = 0; i < n; i++) {
+        tc->lists[size_class].push_back(list.back());
+        list.pop_back();
+      }
+      central_->bytes -= n * ClassToSize(size_class);
+      if (tc != nullptr) {
+        tc->bytes += n * ClassToSize(size_class);
+      }
+      central_->hits++;
+      return Status::OK();
+    }
+  }
+  central_->misses++;
+  size_t sz = ClassToSize(size_class) + kHeaderSize;
+  Status rc = DeMalloc(sz, block, false);
+  if (rc.IsOutofMemory()) {
+    // The system may be short because of what the caches hold
+    Trim();
+    rc = DeMalloc(sz, block, false);
+  }
+  return rc;
+}
+
+Status SizeClassPool::Allocate(size_t n, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  void *block = nullptr;
+  if (n > kMaxPooledSize) {
+    central_->misses++;
+    RETURN_IF_NOT_OK(DeMalloc(n + kHeaderSize, &block, false));
+    *BlockClass(block) = kUnpooledClass;
+    *p = BlockToUser(block);
+    return Status::OK();
+  }
+  uint32_t size_class = SizeToClass(n);
+  ThreadCache *tc = GetThreadCache();
+  if (tc != nullptr && !tc->lists[size_class].empty()) {
+    block = tc->lists[size_class].back();
+    tc->lists[size_class].pop_back();
+    tc->bytes -= ClassToSize(size_class);
+    central_->hits++;
+  } else {
+    RETURN_IF_NOT_OK(AllocateFromCentral(size_class, &block));
+  }
+  *BlockClass(block) = size_class;
+  *p = BlockToUser(block);
+  return Status::OK();
+}
+
+Status SizeClassPool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  if (*p != nullptr) {
+    uint32_t size_class = *BlockClass(UserToBlock(*p));
+    // Nothing to do if the block is large enough already
+    if (size_class != kUnpooledClass && new_sz <= ClassToSize(size_class)) {
+      return Status::OK();
+    }
+    if (new_sz <= old_sz) {
+      return Status::OK();
+    }
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  if (*p != nullptr) {
+    errno_t err = memcpy_s(q, new_sz, *p, old_sz);
+    if (err) {
+      Deallocate(q);
+      RETURN_STATUS_UNEXPECTED(std::to_string(err));
+    }
+    Deallocate(*p);
+  }
+  *p = q;
+  return Status::OK();
+}
+
+void SizeClassPool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  void *block = UserToBlock(p);
+  uint32_t size_class = *BlockClass(block);
+  if (size_class == kUnpooledClass) {
+    free(block);
+    return;
+  }
+  std::vector<void *> one_block;
+  ThreadCache *tc = GetThreadCache();
+  try {
+    if (tc == nullptr) {
+      one_block.push_back(block);
+      central_->Put(size_class, &one_block);
+      return;
+    }
+    tc->lists[size_class].push_back(block);
+  } catch (const std::bad_alloc &e) {
+    free(block);
+    return;
+  }
+  tc->bytes += ClassToSize(size_class);
+  if (tc->bytes > max_thread_cache_bytes_) {
+    tc->Flush();
+  }
+}
+
+uint64_t SizeClassPool::get_max_size() const { return std::numeric_limits<uint64_t>::max(); }
+
+SizeClassPool::Stats SizeClassPool::GetStats() const {
+  Stats stats{};
+  stats.hits = central_->hits;
+  stats.misses = central_->misses;
+  std::lock_guard<std::mutex> lck(central_->mux);
+  stats.cached_bytes = central_->bytes;
+  return stats;
+}
+
+void SizeClassPool::Trim() { central_->Trim(); }
+}  // namespace dataset
+}  // namespace mindspore
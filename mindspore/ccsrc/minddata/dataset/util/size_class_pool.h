@@ -0,0 +1,104 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_SIZE_CLASS_POOL_H_
+#define DATASET_UTIL_SIZE_CLASS_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "minddata/dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+// A memory pool which keeps freed blocks for reuse instead of returning them to the system.
+// Requests are rounded up to a size class, four classes for each power of two so that at most a
+// quarter of a block is wasted. A freed block goes to a cache of the thread that frees it and the next
+// request of the same class on that thread takes it back without any lock. When a thread cache grows
+// past its limit it is handed to a central cache shared by all threads, which in turn gives the memory
+// back to the system past its own limit. Requests larger than kMaxPooledSize are not pooled.
+//
+// The pool suits the tensors of the pipeline: every row of every worker allocates buffers of about
+// the same sizes, and the same worker frees them once the row is consumed.
+class SizeClassPool : public MemoryPool {
+ public:
+  // Counters of the pool, for the profiler.
+  struct Stats {
+    uint64_t hits;          // requests served from a cache
+    uint64_t misses;        // requests which went to the system
+    uint64_t cached_bytes;  // bytes held by the central cache
+  };
+
+  static constexpr size_t kMaxPooledSize = 64 * 1024 * 1024;
+
+  // Constructor
+  // @param max_thread_cache_bytes - bytes a thread may keep before handing its blocks to the central cache
+  // @param max_central_cache_bytes - bytes the central cache keeps, the rest is freed
+  explicit SizeClassPool(size_t max_thread_cache_bytes = 32 * 1024 * 1024,
+                         size_t max_central_cache_bytes = 512 * 1024 * 1024);
+
+  SizeClassPool(const SizeClassPool &) = delete;
+
+  SizeClassPool &operator=(const SizeClassPool &) = delete;
+
+  ~SizeClassPool() override;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override;
+
+  int PercentFree() const override { return 100; }
+
+  // Getter method
+  // @return the counters of the pool
+  Stats GetStats() const;
+
+  // Frees the blocks held by the central cache.
+  void Trim();
+
+  // Rounds a request up to its size class.
+  // @param n - the size of the request
+  // @return the index of the size class
+  static uint32_t SizeToClass(size_t n);
+
+  // @param size_class - the index of a size class
+  // @return the size of the blocks of the class
+  static size_t ClassToSize(uint32_t size_class);
+
+ private:
+  struct CentralCache;
+  struct ThreadCache;
+
+  // The cache of the calling thread for this pool, created on first use
+  ThreadCache *GetThreadCache();
+
+  // Gets a block of a size class from the central cache, or from the system.
+  Status AllocateFromCentral(uint32_t size_class, void **block);
+
+  uint64_t pool_id_;  // Tells the pools apart in the thread caches
+  size_t max_thread_cache_bytes_;
+  std::shared_ptr<CentralCache> central_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_UTIL_SIZE_CLASS_POOL_H_
@@ -74,6 +74,7 @@ void BindShardWriter(py::module *m) {
     .def("open_for_append", &ShardWriter::OpenForAppend)
     .def("set_header_size", &ShardWriter::SetHeaderSize)
     .def("set_page_size", &ShardWriter::SetPageSize)
+    .def("set_columnar_blob", &ShardWriter::SetColumnarBlob)
     .def("set_shard_header", &ShardWriter::SetShardHeader)
     .def("write_raw_data", (MSRStatus(ShardWriter::*)(std::map<uint64_t, std::vector<py::handle>> &,
                                                       vector<vector<uint8_t>> &, bool, bool)) &
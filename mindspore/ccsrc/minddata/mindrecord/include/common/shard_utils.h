@@ -66,7 +66,10 @@ const int kUnsignedInt4 = 4;
 enum LabelCategory { kSchemaLabel, kStatisticsLabel, kIndexLabel };
 
 const char kVersion[] = "3.0";
-const std::vector<std::string> kSupportedVersion = {"2.0", kVersion};
+const char kColumnarBlobVersion[] = "3.1";  // version of the files whose blob pages are stored column by column
+const std::vector<std::string> kSupportedVersion = {"2.0", kVersion, kColumnarBlobVersion};
+
+const char kBlobLayoutColumn[] = "column";
 
 enum ShardType {
   kNLP = 0,
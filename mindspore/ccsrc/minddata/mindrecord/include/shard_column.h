@@ -94,6 +94,14 @@ class ShardColumn {
                                                            uint64_t *column_data_type_size,
                                                            std::vector<int64_t> *column_shape);
 
+  /// \brief convert big-endian bytes to unsigned int
+  /// \param bytes_array bytes array
+  /// \param pos shift address in bytes array
+  /// \param i_type integer type
+  /// \return unsigned int
+  static uint64_t BytesBigToUInt64(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
+                                   const IntegerType &i_type);
+
   /// \brief get column value from json
   MSRStatus GetColumnFromJson(const std::string &column_name, const json &columns_json,
                               std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *n_bytes);
@@ -122,14 +130,6 @@ class ShardColumn {
   static MSRStatus UncompressInt(const uint64_t &column_id, std::unique_ptr<unsigned char[]> *const data_ptr,
                                  const std::vector<uint8_t> &columns_blob, uint64_t *num_bytes, uint64_t shift_idx);
 
-  /// \brief convert big-endian bytes to unsigned int
-  /// \param bytes_array bytes array
-  /// \param pos shift address in bytes array
-  /// \param i_type integer type
-  /// \return unsigned int
-  static uint64_t BytesBigToUInt64(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
-                                   const IntegerType &i_type);
-
   /// \brief convert unsigned int to big-endian bytes
   /// \param value integer value
   /// \param i_type integer type
@@ -118,6 +118,11 @@ class ShardHeader {
 
   void SetPageSize(const uint64_t &page_size) { page_size_ = page_size; }
 
+  /// \brief whether each blob column is stored contiguously in a blob page, instead of blob by blob
+  bool GetColumnarBlob() const { return columnar_blob_; }
+
+  void SetColumnarBlob(bool columnar_blob) { columnar_blob_ = columnar_blob; }
+
   std::vector<std::string> SerializeHeader();
 
   MSRStatus PagesToFile(const std::string dump_file_name);
@@ -173,6 +178,7 @@ class ShardHeader {
   uint32_t shard_count_;
   uint64_t header_size_;
   uint64_t page_size_;
+  bool columnar_blob_;
 
   std::shared_ptr<Index> index_;
   std::vector<std::string> shard_addresses_;
@@ -40,6 +40,11 @@ class ShardIndexGenerator {
 
   static std::pair<MSRStatus, std::string> GenerateFieldName(const std::pair<uint64_t, std::string> &field);
 
+  /// \brief names of the index fields which locate the blob columns of a row in a columnar blob page
+  /// \param[in] num_blob_column number of blob columns
+  /// \return start and end offset of every blob column but the first, which PAGE_OFFSET_BLOB(_END) locate
+  static std::vector<std::string> GenerateBlobOffsetFields(uint64_t num_blob_column);
+
   ~ShardIndexGenerator() {}
 
   /// \brief fetch value in json by field name
@@ -68,7 +73,8 @@ class ShardIndexGenerator {
 
   std::pair<MSRStatus, std::vector<json>> GetSchemaDetails(const std::vector<uint64_t> &schema_lens, std::fstream &in);
 
-  static std::pair<MSRStatus, std::string> GenerateRawSQL(const std::vector<std::pair<uint64_t, std::string>> &fields);
+  static std::pair<MSRStatus, std::string> GenerateRawSQL(const std::vector<std::pair<uint64_t, std::string>> &fields,
+                                                         const std::vector<std::string> &blob_offset_fields);
 
   std::pair<MSRStatus, sqlite3 *> CheckDatabase(const std::string &shard_address);
 
@@ -100,6 +106,13 @@ class ShardIndexGenerator {
                             const std::shared_ptr<Page> cur_blob_page, uint64_t &cur_blob_page_offset,
                             std::fstream &in);
 
+  /// \brief start and end offset of every blob column of every row in a columnar blob page
+  std::pair<MSRStatus, std::vector<std::vector<uint64_t>>> GetColumnarBlobOffsets(const std::shared_ptr<Page> &page,
+                                                                                  std::fstream &in);
+
+  void AddColumnarBlobPageInfo(std::vector<std::tuple<std::string, std::string, std::string>> &row_data,
+                               const std::shared_ptr<Page> cur_blob_page, const std::vector<uint64_t> &blob_offsets);
+
   void AddIndexFieldByRawData(const std::vector<json> &schema_detail,
                               std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
 
@@ -114,6 +127,8 @@ class ShardIndexGenerator {
   std::atomic_int task_;
   std::atomic_bool write_success_;
   std::vector<std::pair<uint64_t, std::string>> fields_;
+  uint64_t num_blob_column_;
+  std::vector<std::string> blob_offset_fields_;  // empty unless the blob pages are columnar
 };
 }  // namespace mindrecord
 }  // namespace mindspore
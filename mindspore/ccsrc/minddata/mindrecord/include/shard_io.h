@@ -0,0 +1,120 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDRECORD_INCLUDE_SHARD_IO_H_
+#define MINDRECORD_INCLUDE_SHARD_IO_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+const int kDefaultIOQueueDepth = 8;     // outstanding requests of the pread and io_uring modes
+const uint64_t kIOChunkSize = 1 << 20;  // 1MB, reads larger than this are split into parallel requests
+
+const char kIOModeStream[] = "stream";     // seekg + read on a std::fstream per reader thread
+const char kIOModePread[] = "pread";       // pread on one descriptor per shard, large reads split in chunks
+const char kIOModeMmap[] = "mmap";         // shard files mapped in memory, rows are sliced out of the mapping
+const char kIOModeIoUring[] = "io_uring";  // chunks submitted together to an io_uring per reader thread
+
+enum class ShardIOMode { kStream = 0, kPread, kMmap, kIoUring };
+
+/// \brief bytes and time spent in the reads of one backend
+struct ShardIOStats {
+  uint64_t bytes_read = 0;
+  uint64_t num_requests = 0;
+  uint64_t read_time_us = 0;  // sum of the time of every request
+  uint64_t wall_time_us = 0;  // from the start of the first request to the end of the last one
+  // pages handed out of a mapping by Slice, they are read when the rows are copied out of them, so they are kept
+  // out of the bytes read and of the time of the requests
+  uint64_t bytes_sliced = 0;
+  uint64_t num_slices = 0;
+
+  /// \brief MB read per second, over the wall time so that requests in flight together are not counted twice
+  double Throughput() const;
+
+  /// \brief average time of a request in us
+  double Latency() const;
+};
+
+/// \brief the way a ShardReader reads pages and rows out of the shard files
+class ShardIO {
+ public:
+  /// \brief create the backend of a mode, falls back to a supported one when the platform lacks the mode
+  /// \param[in] mode name of the mode, one of kIOModeStream, kIOModePread, kIOModeMmap or kIOModeIoUring
+  /// \param[in] queue_depth maximum number of requests in flight for the pread and io_uring modes
+  static std::unique_ptr<ShardIO> Create(const std::string &mode, int queue_depth = kDefaultIOQueueDepth);
+
+  /// \brief parse the name of a mode
+  static std::pair<MSRStatus, ShardIOMode> GetMode(const std::string &mode);
+
+  virtual ~ShardIO() = default;
+
+  /// \brief open the shard files
+  /// \param[in] file_paths shard files, indexed by shard id
+  /// \param[in] n_reader number of threads which call Read, each passes its own reader_id in [0, n_reader)
+  /// \return MSRStatus the status of MSRStatus
+  virtual MSRStatus Open(const std::vector<std::string> &file_paths, int n_reader) = 0;
+
+  /// \brief close the shard files, slices handed out before are invalid afterwards
+  virtual void Close() = 0;
+
+  /// \brief copy length bytes at offset of a shard file into buf
+  /// \return MSRStatus the status of MSRStatus
+  virtual MSRStatus Read(int shard_id, uint64_t offset, uint64_t length, uint8_t *buf, int reader_id) = 0;
+
+  /// \brief address of length bytes at offset of a shard file, without copying them
+  /// \return nullptr if the backend can only copy, see Read
+  virtual const uint8_t *Slice(int shard_id, uint64_t offset, uint64_t length) { return nullptr; }
+
+  ShardIOMode GetMode() const { return mode_; }
+
+  std::string GetModeName() const;
+
+  ShardIOStats GetStats() const;
+
+ protected:
+  explicit ShardIO(ShardIOMode mode) : mode_(mode) {}
+
+  /// \brief current time in us, on the clock of the stats
+  static uint64_t Now();
+
+  /// \brief count a request which ran from start_us to now into the stats
+  void Record(uint64_t bytes, uint64_t start_us);
+
+  /// \brief count a slice handed out without reading it into the stats
+  void RecordSlice(uint64_t bytes);
+
+  ShardIOMode mode_;
+
+ private:
+  std::atomic<uint64_t> bytes_read_{0};
+  std::atomic<uint64_t> num_requests_{0};
+  std::atomic<uint64_t> read_time_us_{0};
+  std::atomic<uint64_t> first_start_us_{UINT64_MAX};
+  std::atomic<uint64_t> last_end_us_{0};
+  std::atomic<uint64_t> bytes_sliced_{0};
+  std::atomic<uint64_t> num_slices_{0};
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDRECORD_INCLUDE_SHARD_IO_H_
@@ -48,6 +48,7 @@
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_io.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
@@ -95,6 +96,16 @@ class ShardReader {
                    const std::vector<std::string> &selected_columns = {},
                    const std::vector<std::shared_ptr<ShardOperator>> &operators = {});
 
+  /// \brief choose how the shard files are read, call before Open
+  /// \param[in] io_mode one of kIOModeStream (default), kIOModePread, kIOModeMmap or kIOModeIoUring
+  /// \param[in] queue_depth maximum number of reads in flight for the pread and io_uring modes
+  /// \return null
+  void SetIOMode(const std::string &io_mode, int queue_depth = kDefaultIOQueueDepth);
+
+  /// \brief get the bytes read and the time spent reading the shard files so far
+  /// \return the stats of the io backend
+  ShardIOStats GetIOStats() const;
+
   /// \brief close reader
   /// \return null
   void Close();
@@ -219,6 +230,11 @@ class ShardReader {
   /// \brief sqlite call back function
   static int SelectCallback(void *p_data, int num_fields, char **p_fields, char **p_col_names);
 
+  /// \brief read the blob of a row, the blob columns which are not selected are left empty in a columnar blob page
+  /// \param[in] blob_address start and end of the blob in its page, or of every blob column in a columnar page
+  std::pair<MSRStatus, std::vector<uint8_t>> ReadRowBlob(int shard_id, uint64_t page_id,
+                                                         const std::vector<uint64_t> &blob_address, int reader_id);
+
  private:
   /// \brief wrap up labels to json format
   MSRStatus ConvertLabelToJson(const std::vector<std::vector<std::string>> &labels, std::shared_ptr<std::fstream> fs,
@@ -297,7 +313,25 @@ class ShardReader {
   std::pair<MSRStatus, std::vector<json>> GetLabelsFromBinaryFile(
     int shard_id, const std::vector<std::string> &columns, const std::vector<std::vector<std::string>> &label_offsets);
 
-  MSRStatus ReadBlob(const int &shard_id, const uint64_t &page_offset, const int &page_length, const int &buf_id);
+  MSRStatus ReadBlob(const int &shard_id, const uint64_t &page_offset, const int &page_length, const int &buf_id,
+                     const int &consumer_id, const std::vector<std::vector<uint64_t>> &blob_addresses);
+
+  /// \brief blob address of a row from its index fields, see ReadRowBlob
+  /// \param[in] offset_id position of PAGE_OFFSET_BLOB in the fields
+  /// \param[in] column_offset_id position of the offsets of the other blob columns of a columnar blob page
+  std::vector<uint64_t> GetBlobAddress(const std::vector<std::string> &fields, int offset_id, int column_offset_id);
+
+  /// \brief index fields locating the blob columns of a columnar blob page, to append to a select
+  std::string GetBlobOffsetSQL();
+
+  /// \brief size of the blob of a row once the blob columns which are selected are read
+  uint64_t GetRowBlobSize(const std::vector<uint64_t> &blob_address);
+
+  /// \brief copy the blob of a row out of its page, see ReadRowBlob
+  std::vector<uint8_t> CopyRowBlob(const uint8_t *page, const std::vector<uint64_t> &blob_address);
+
+  /// \brief mark the blob columns among the selected columns
+  void SelectBlobColumns();
 
   /// \brief get classes in one shard
   void GetClassesInShard(sqlite3 *db, int shard_id, const std::string sql, std::set<std::string> &categories);
@@ -318,14 +352,16 @@ class ShardReader {
   std::shared_ptr<ShardHeader> shard_header_;  // shard header
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
 
-  std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
-  std::vector<string> file_paths_;                                               // file paths
-  std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
-  std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<sqlite3 *> database_paths_;  // sqlite handle list
+  std::vector<string> file_paths_;         // file paths
+  std::string io_mode_;                    // how the shard files are read
+  int io_queue_depth_;                     // reads in flight of the io backend
+  std::unique_ptr<ShardIO> shard_io_;      // io backend reading the shard files
 
  private:
   int n_consumer_;                                         // number of workers (threads)
   std::vector<std::string> selected_columns_;              // columns which will be read
+  std::vector<bool> blob_column_selected_;                 // blob columns which will be read, by blob column id
   std::map<string, uint64_t> column_schema_id_;            // column-schema map
   std::vector<std::shared_ptr<ShardOperator>> operators_;  // data operators, including shuffle, sample and category
   ShardTask tasks_;                                        // shard task
@@ -357,7 +393,8 @@ class ShardReader {
   // raw data page
   std::vector<std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>> delivery_block_;
   std::unordered_set<int> delivery_block_set_;  // set of delivered pages
-  std::vector<std::vector<uint8_t>> buf_;       // page buffer
+  std::vector<std::vector<uint8_t>> buf_;       // page buffer, not used when the io backend slices pages
+  std::vector<const uint8_t *> blob_pages_;     // page of every buffer, in buf_ or in the io backend
   // Block reader mode end
 };
 }  // namespace mindrecord
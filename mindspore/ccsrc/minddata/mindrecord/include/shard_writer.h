@@ -77,6 +77,12 @@ class ShardWriter {
   /// \return MSRStatus the status of MSRStatus
   MSRStatus SetPageSize(const uint64_t &page_size);
 
+  /// \brief Store each blob column contiguously in a blob page, so that readers of some blob columns only read them
+  /// \param[in] columnar_blob true for the columnar layout, ignored when there are less than two blob columns
+  ///        WARNING, only called before SetShardHeader
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus SetColumnarBlob(bool columnar_blob);
+
   /// \brief Set shard header
   /// \param[in] header_data the info of header
   ///        WARNING, only called when file is empty
@@ -177,6 +183,11 @@ class ShardWriter {
   MSRStatus FlushBlobChunk(const std::shared_ptr<std::fstream> &out, const std::vector<std::vector<uint8_t>> &blob_data,
                            const std::pair<int, int> &blob_row);
 
+  /// \brief write blob chunk to disk column by column, each blob column of the rows one after the other
+  MSRStatus FlushColumnarBlobChunk(const std::shared_ptr<std::fstream> &out,
+                                   const std::vector<std::vector<uint8_t>> &blob_data,
+                                   const std::pair<int, int> &blob_row);
+
   /// \brief write raw chunk to disk
   MSRStatus FlushRawChunk(const std::shared_ptr<std::fstream> &out,
                           const std::vector<std::pair<int, int>> &rows_in_group, const int &chunk_id,
@@ -237,6 +248,7 @@ class ShardWriter {
   uint64_t page_size_;     // page size
   uint32_t row_count_;     // count of rows
   uint32_t schema_count_;  // count of schemas
+  bool columnar_blob_;     // blob pages are stored column by column
 
   std::vector<uint64_t> raw_data_size_;   // Raw data size
   std::vector<uint64_t> blob_data_size_;  // Blob data size
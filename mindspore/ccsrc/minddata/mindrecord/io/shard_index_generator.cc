@@ -16,6 +16,7 @@
 #include <thread>
 
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_column.h"
 #include "common/utils.h"
 
 using mindspore::LogStream;
@@ -32,6 +33,7 @@ ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool appe
       page_size_(0),
       header_size_(0),
       schema_count_(0),
+      num_blob_column_(0),
       task_(0),
       write_success_(true) {}
 
@@ -180,6 +182,15 @@ std::pair<MSRStatus, std::string> ShardIndexGenerator::GenerateFieldName(
   return {SUCCESS, field_name + "_" + std::to_string(field.first)};
 }
 
+std::vector<std::string> ShardIndexGenerator::GenerateBlobOffsetFields(uint64_t num_blob_column) {
+  std::vector<std::string> fields;
+  for (uint64_t i = 1; i < num_blob_column; ++i) {
+    fields.emplace_back("PAGE_OFFSET_BLOB_" + std::to_string(i));
+    fields.emplace_back("PAGE_OFFSET_BLOB_END_" + std::to_string(i));
+  }
+  return fields;
+}
+
 std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CheckDatabase(const std::string &shard_address) {
   sqlite3 *db = nullptr;
   std::ifstream fin(common::SafeCStr(shard_address));
@@ -240,6 +251,9 @@ std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CreateDatabase(int shard_no
     ", PAGE_OFFSET_RAW      INT  NOT NULL, PAGE_OFFSET_RAW_END  INT  NOT NULL"
     ", ROW_GROUP_ID         INT  NOT NULL, PAGE_ID_BLOB         INT  NOT NULL"
     ", PAGE_OFFSET_BLOB     INT  NOT NULL, PAGE_OFFSET_BLOB_END INT  NOT NULL";
+  for (const auto &field : blob_offset_fields_) {
+    sql += ", " + field + " INT  NOT NULL";
+  }
 
   int field_no = 0;
   for (const auto &field : fields_) {
@@ -291,10 +305,13 @@ std::pair<MSRStatus, std::vector<json>> ShardIndexGenerator::GetSchemaDetails(co
 }
 
 std::pair<MSRStatus, std::string> ShardIndexGenerator::GenerateRawSQL(
-  const std::vector<std::pair<uint64_t, std::string>> &fields) {
+  const std::vector<std::pair<uint64_t, std::string>> &fields, const std::vector<std::string> &blob_offset_fields) {
   std::string sql =
     "INSERT INTO INDEXES (ROW_ID,ROW_GROUP_ID,PAGE_ID_RAW,PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END,"
     "PAGE_ID_BLOB,PAGE_OFFSET_BLOB,PAGE_OFFSET_BLOB_END";
+  for (const auto &field : blob_offset_fields) {
+    sql += "," + field;
+  }
 
   int field_no = 0;
   for (const auto &field : fields) {
@@ -307,6 +324,9 @@ std::pair<MSRStatus, std::string> ShardIndexGenerator::GenerateRawSQL(
   sql +=
     ") VALUES( :ROW_ID,:ROW_GROUP_ID,:PAGE_ID_RAW,:PAGE_OFFSET_RAW,:PAGE_OFFSET_RAW_END,:PAGE_ID_BLOB,"
     ":PAGE_OFFSET_BLOB,:PAGE_OFFSET_BLOB_END";
+  for (const auto &field : blob_offset_fields) {
+    sql += ",:" + field;
+  }
   field_no = 0;
   for (const auto &field : fields) {
     auto ret = GenerateFieldName(field);
@@ -398,6 +418,50 @@ MSRStatus ShardIndexGenerator::AddBlobPageInfo(std::vector<std::tuple<std::strin
   return SUCCESS;
 }
 
+std::pair<MSRStatus, std::vector<std::vector<uint64_t>>> ShardIndexGenerator::GetColumnarBlobOffsets(
+  const std::shared_ptr<Page> &page, std::fstream &in) {
+  // every blob column holds the size (8 bytes, big-endian) and the data of the column of each row in turn
+  std::vector<std::vector<uint64_t>> blob_offsets(page->GetEndRowID() - page->GetStartRowID(),
+                                                  std::vector<uint64_t>(num_blob_column_ * 2, 0));
+  uint64_t page_offset = 0;
+  std::vector<uint8_t> column_size(kInt64Len);
+  for (uint64_t i = 0; i < num_blob_column_; ++i) {
+    for (auto &row : blob_offsets) {
+      auto &io_seekg = in.seekg(page_size_ * page->GetPageID() + header_size_ + page_offset, std::ios::beg);
+      if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+        MS_LOG(ERROR) << "File seekg failed";
+        in.close();
+        return {FAILED, {}};
+      }
+      auto &io_read = in.read(reinterpret_cast<char *>(&column_size[0]), kInt64Len);
+      if (!io_read.good() || io_read.fail() || io_read.bad()) {
+        MS_LOG(ERROR) << "File read failed";
+        in.close();
+        return {FAILED, {}};
+      }
+      row[i * 2] = page_offset;
+      page_offset += kInt64Len + ShardColumn::BytesBigToUInt64(column_size, 0, kInt64Type);
+      row[i * 2 + 1] = page_offset;
+    }
+  }
+  if (page_offset != page->GetPageSize()) {
+    MS_LOG(ERROR) << "Blob columns of page " << page->GetPageID() << " do not match its size.";
+    return {FAILED, {}};
+  }
+  return {SUCCESS, std::move(blob_offsets)};
+}
+
+void ShardIndexGenerator::AddColumnarBlobPageInfo(
+  std::vector<std::tuple<std::string, std::string, std::string>> &row_data, const std::shared_ptr<Page> cur_blob_page,
+  const std::vector<uint64_t> &blob_offsets) {
+  row_data.emplace_back(":PAGE_ID_BLOB", "INTEGER", std::to_string(cur_blob_page->GetPageID()));
+  row_data.emplace_back(":PAGE_OFFSET_BLOB", "INTEGER", std::to_string(blob_offsets[0]));
+  row_data.emplace_back(":PAGE_OFFSET_BLOB_END", "INTEGER", std::to_string(blob_offsets[1]));
+  for (uint64_t i = 0; i < blob_offset_fields_.size(); ++i) {
+    row_data.emplace_back(":" + blob_offset_fields_[i], "INTEGER", std::to_string(blob_offsets[i + 2]));
+  }
+}
+
 void ShardIndexGenerator::AddIndexFieldByRawData(
   const std::vector<json> &schema_detail, std::vector<std::tuple<std::string, std::string, std::string>> &row_data) {
   auto result = GenerateIndexFields(schema_detail);
@@ -429,6 +493,14 @@ ROW_DATA ShardIndexGenerator::GenerateRowData(int shard_no, const std::map<int,
     // offset in current raw data page
     auto cur_raw_page_offset = static_cast<uint64_t>(blob_ids.second);
     uint64_t cur_blob_page_offset = 0;
+    std::vector<std::vector<uint64_t>> columnar_blob_offsets;
+    if (shard_header_.GetColumnarBlob()) {
+      auto ret = GetColumnarBlobOffsets(cur_blob_page, in);
+      if (ret.first != SUCCESS) {
+        return {FAILED, {}};
+      }
+      columnar_blob_offsets = std::move(ret.second);
+    }
     for (unsigned int i = cur_blob_page->GetStartRowID(); i < cur_blob_page->GetEndRowID(); ++i) {
       std::vector<std::tuple<std::string, std::string, std::string>> row_data;
       row_data.emplace_back(":ROW_ID", "INTEGER", std::to_string(i));
@@ -472,7 +544,9 @@ ROW_DATA ShardIndexGenerator::GenerateRowData(int shard_no, const std::map<int,
       }
 
       // start blob page info
-      if (AddBlobPageInfo(row_data, cur_blob_page, cur_blob_page_offset, in) != SUCCESS) {
+      if (shard_header_.GetColumnarBlob()) {
+        AddColumnarBlobPageInfo(row_data, cur_blob_page, columnar_blob_offsets[i - cur_blob_page->GetStartRowID()]);
+      } else if (AddBlobPageInfo(row_data, cur_blob_page, cur_blob_page_offset, in) != SUCCESS) {
         return {FAILED, {}};
       }
 
@@ -532,7 +606,7 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
   }
   (void)sqlite3_exec(db.second, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
   for (int raw_page_id : raw_page_ids) {
-    auto sql = GenerateRawSQL(fields_);
+    auto sql = GenerateRawSQL(fields_, blob_offset_fields_);
     if (sql.first != SUCCESS) {
       MS_LOG(ERROR) << "Generate raw SQL failed";
       return FAILED;
@@ -565,6 +639,11 @@ MSRStatus ShardIndexGenerator::WriteToDatabase() {
   page_size_ = shard_header_.GetPageSize();
   header_size_ = shard_header_.GetHeaderSize();
   schema_count_ = shard_header_.GetSchemaCount();
+  num_blob_column_ = schema_count_ > 0 ? shard_header_.GetSchemas()[0]->GetBlobFields().size() : 0;
+  blob_offset_fields_.clear();
+  if (shard_header_.GetColumnarBlob()) {
+    blob_offset_fields_ = GenerateBlobOffsetFields(num_blob_column_);
+  }
   if (shard_header_.GetShardCount() > kMaxShardCount) {
     MS_LOG(ERROR) << "num shards: " << shard_header_.GetShardCount() << " exceeds max count:" << kMaxSchemaCount;
     return FAILED;
@@ -0,0 +1,586 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_io.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef ENABLE_IO_URING
+#include <dlfcn.h>
+#include <liburing.h>
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include "common/utils.h"
+#include "utils/log_adapter.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+using mindspore::MsLogLevel::WARNING;
+
+namespace mindspore {
+namespace mindrecord {
+double ShardIOStats::Throughput() const {
+  if (wall_time_us == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(bytes_read) / (1 << 20) / (static_cast<double>(wall_time_us) / 1000000);
+}
+
+double ShardIOStats::Latency() const {
+  return num_requests == 0 ? 0.0 : static_cast<double>(read_time_us) / num_requests;
+}
+
+uint64_t ShardIO::Now() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+void ShardIO::Record(uint64_t bytes, uint64_t start_us) {
+  auto end_us = Now();
+  bytes_read_ += bytes;
+  num_requests_++;
+  read_time_us_ += end_us - start_us;
+  auto first = first_start_us_.load();
+  while (start_us < first && !first_start_us_.compare_exchange_weak(first, start_us)) {
+  }
+  auto last = last_end_us_.load();
+  while (end_us > last && !last_end_us_.compare_exchange_weak(last, end_us)) {
+  }
+}
+
+void ShardIO::RecordSlice(uint64_t bytes) {
+  bytes_sliced_ += bytes;
+  num_slices_++;
+}
+
+ShardIOStats ShardIO::GetStats() const {
+  ShardIOStats stats;
+  stats.bytes_read = bytes_read_;
+  stats.num_requests = num_requests_;
+  stats.read_time_us = read_time_us_;
+  auto first = first_start_us_.load();
+  auto last = last_end_us_.load();
+  stats.wall_time_us = last > first ? last - first : 0;
+  stats.bytes_sliced = bytes_sliced_;
+  stats.num_slices = num_slices_;
+  return stats;
+}
+
+std::pair<MSRStatus, ShardIOMode> ShardIO::GetMode(const std::string &mode) {
+  if (mode == kIOModeStream) {
+    return {SUCCESS, ShardIOMode::kStream};
+  } else if (mode == kIOModePread) {
+    return {SUCCESS, ShardIOMode::kPread};
+  } else if (mode == kIOModeMmap) {
+    return {SUCCESS, ShardIOMode::kMmap};
+  } else if (mode == kIOModeIoUring) {
+    return {SUCCESS, ShardIOMode::kIoUring};
+  }
+  return {FAILED, ShardIOMode::kStream};
+}
+
+std::string ShardIO::GetModeName() const {
+  switch (mode_) {
+    case ShardIOMode::kPread:
+      return kIOModePread;
+    case ShardIOMode::kMmap:
+      return kIOModeMmap;
+    case ShardIOMode::kIoUring:
+      return kIOModeIoUring;
+    default:
+      return kIOModeStream;
+  }
+}
+
+// seekg + read on a std::fstream per reader thread and shard
+class ShardIOStream : public ShardIO {
+ public:
+  ShardIOStream() : ShardIO(ShardIOMode::kStream) {}
+  ~ShardIOStream() override { Close(); }
+
+  MSRStatus Open(const std::vector<std::string> &file_paths, int n_reader) override {
+    file_streams_ = std::vector<std::vector<std::shared_ptr<std::fstream>>>(n_reader);
+    for (const auto &file : file_paths) {
+      for (int j = 0; j < n_reader; ++j) {
+        std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
+        fs->open(common::SafeCStr(file), std::ios::in | std::ios::binary);
+        if (!fs->good()) {
+          MS_LOG(ERROR) << "File could not opened";
+          return FAILED;
+        }
+        file_streams_[j].push_back(fs);
+      }
+    }
+    return SUCCESS;
+  }
+
+  void Close() override {
+    for (auto &streams : file_streams_) {
+      for (auto &fs : streams) {
+        fs->close();
+      }
+    }
+    file_streams_.clear();
+  }
+
+  MSRStatus Read(int shard_id, uint64_t offset, uint64_t length, uint8_t *buf, int reader_id) override {
+    auto start = Now();
+    auto &fs = file_streams_[reader_id][shard_id];
+    auto &io_seekg = fs->seekg(offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      MS_LOG(ERROR) << "File seekg failed";
+      fs->close();
+      return FAILED;
+    }
+    auto &io_read = fs->read(reinterpret_cast<char *>(buf), length);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      MS_LOG(ERROR) << "File read failed";
+      fs->close();
+      return FAILED;
+    }
+    Record(length, start);
+    return SUCCESS;
+  }
+
+ private:
+  std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_;  // [reader_id][shard_id]
+};
+
+#if !defined(_WIN32) && !defined(_WIN64)
+// pread all of length bytes, a read may return less than asked
+static bool PreadFull(int fd, uint8_t *buf, uint64_t length, uint64_t offset) {
+  while (length > 0) {
+    auto n = pread(fd, buf, length, static_cast<off_t>(offset));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    buf += n;
+    offset += n;
+    length -= n;
+  }
+  return true;
+}
+
+// pread on one descriptor per shard, shared by all the readers since pread does not move a file position.
+// Reads above kIOChunkSize are split into chunks which a pool of queue_depth - 1 threads reads together
+// with the calling thread.
+class ShardIOPread : public ShardIO {
+ public:
+  explicit ShardIOPread(int queue_depth, ShardIOMode mode = ShardIOMode::kPread)
+      : ShardIO(mode), queue_depth_(std::max(queue_depth, 1)) {}
+  ~ShardIOPread() override { Close(); }
+
+  MSRStatus Open(const std::vector<std::string> &file_paths, int n_reader) override {
+    for (const auto &file : file_paths) {
+      int fd = open(common::SafeCStr(file), O_RDONLY);
+      if (fd < 0) {
+        MS_LOG(ERROR) << "File could not opened, errno " << errno;
+        return FAILED;
+      }
+      fds_.push_back(fd);
+    }
+    if (mode_ == ShardIOMode::kPread) {
+      stop_ = false;
+      for (int i = 1; i < queue_depth_; ++i) {
+        pool_.emplace_back(&ShardIOPread::ChunkWorker, this);
+      }
+    }
+    return SUCCESS;
+  }
+
+  void Close() override {
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &t : pool_) {
+      t.join();
+    }
+    pool_.clear();
+    for (auto fd : fds_) {
+      (void)close(fd);
+    }
+    fds_.clear();
+  }
+
+  MSRStatus Read(int shard_id, uint64_t offset, uint64_t length, uint8_t *buf, int reader_id) override {
+    auto start = Now();
+    int fd = fds_[shard_id];
+    if (length <= kIOChunkSize || pool_.empty()) {
+      if (!PreadFull(fd, buf, length, offset)) {
+        MS_LOG(ERROR) << "File read failed, errno " << errno;
+        return FAILED;
+      }
+      Record(length, start);
+      return SUCCESS;
+    }
+
+    // the first chunk is read here while the pool reads the others
+    ChunkGroup group;
+    uint64_t num_chunks = (length + kIOChunkSize - 1) / kIOChunkSize;
+    group.pending = static_cast<int>(num_chunks - 1);
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      for (uint64_t i = 1; i < num_chunks; ++i) {
+        uint64_t chunk_offset = i * kIOChunkSize;
+        chunks_.push_back({fd, buf + chunk_offset, std::min(kIOChunkSize, length - chunk_offset),
+                           offset + chunk_offset, &group});
+      }
+    }
+    cv_.notify_all();
+    bool ok = PreadFull(fd, buf, kIOChunkSize, offset);
+    {
+      std::unique_lock<std::mutex> lck(group.mtx);
+      group.cv.wait(lck, [&group] { return group.pending == 0; });
+      ok = ok && !group.failed;
+    }
+    if (!ok) {
+      MS_LOG(ERROR) << "File read failed, errno " << errno;
+      return FAILED;
+    }
+    Record(length, start);
+    return SUCCESS;
+  }
+
+ protected:
+  int queue_depth_;
+  std::vector<int> fds_;  // [shard_id]
+
+ private:
+  struct ChunkGroup {
+    std::mutex mtx;
+    std::condition_variable cv;
+    int pending = 0;
+    bool failed = false;
+  };
+
+  struct Chunk {
+    int fd;
+    uint8_t *buf;
+    uint64_t length;
+    uint64_t offset;
+    ChunkGroup *group;
+  };
+
+  void ChunkWorker() {
+    for (;;) {
+      Chunk chunk;
+      {
+        std::unique_lock<std::mutex> lck(mtx_);
+        cv_.wait(lck, [this] { return stop_ || !chunks_.empty(); });
+        if (chunks_.empty()) {
+          return;
+        }
+        chunk = chunks_.front();
+        chunks_.pop_front();
+      }
+      bool ok = PreadFull(chunk.fd, chunk.buf, chunk.length, chunk.offset);
+      {
+        std::unique_lock<std::mutex> lck(chunk.group->mtx);
+        chunk.group->failed = chunk.group->failed || !ok;
+        if (--chunk.group->pending == 0) {
+          chunk.group->cv.notify_all();
+        }
+      }
+    }
+  }
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool stop_ = true;
+  std::deque<Chunk> chunks_;
+  std::vector<std::thread> pool_;
+};
+
+// The shard files are mapped read only; Slice hands out rows and pages without copying them and the page
+// cache is the buffer.
+class ShardIOMmap : public ShardIO {
+ public:
+  ShardIOMmap() : ShardIO(ShardIOMode::kMmap) {}
+  ~ShardIOMmap() override { Close(); }
+
+  MSRStatus Open(const std::vector<std::string> &file_paths, int n_reader) override {
+    for (const auto &file : file_paths) {
+      int fd = open(common::SafeCStr(file), O_RDONLY);
+      if (fd < 0) {
+        MS_LOG(ERROR) << "File could not opened, errno " << errno;
+        return FAILED;
+      }
+      struct stat file_stat;
+      if (fstat(fd, &file_stat) != 0) {
+        MS_LOG(ERROR) << "File stat failed, errno " << errno;
+        (void)close(fd);
+        return FAILED;
+      }
+      auto size = static_cast<uint64_t>(file_stat.st_size);
+      void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      // the mapping keeps the file open
+      (void)close(fd);
+      if (addr == MAP_FAILED) {
+        MS_LOG(ERROR) << "File mmap failed, errno " << errno;
+        return FAILED;
+      }
+      mappings_.emplace_back(static_cast<uint8_t *>(addr), size);
+    }
+    return SUCCESS;
+  }
+
+  void Close() override {
+    for (auto &mapping : mappings_) {
+      (void)munmap(mapping.first, mapping.second);
+    }
+    mappings_.clear();
+  }
+
+  MSRStatus Read(int shard_id, uint64_t offset, uint64_t length, uint8_t *buf, int reader_id) override {
+    auto start = Now();
+    auto src = Address(shard_id, offset, length);
+    if (src == nullptr) {
+      return FAILED;
+    }
+    std::copy(src, src + length, buf);
+    Record(length, start);
+    return SUCCESS;
+  }
+
+  const uint8_t *Slice(int shard_id, uint64_t offset, uint64_t length) override {
+    auto src = Address(shard_id, offset, length);
+    if (src == nullptr) {
+      return nullptr;
+    }
+    if (length > kIOChunkSize) {
+      // a whole page: start reading it ahead of the rows which will be copied out of it
+      auto page_mask = static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) - 1;
+      (void)madvise(const_cast<uint8_t *>(src) - (offset & page_mask), length + (offset & page_mask), MADV_WILLNEED);
+    }
+    RecordSlice(length);
+    return src;
+  }
+
+ private:
+  const uint8_t *Address(int shard_id, uint64_t offset, uint64_t length) const {
+    auto &mapping = mappings_[shard_id];
+    if (offset + length > mapping.second) {
+      MS_LOG(ERROR) << "Read beyond the end of shard " << shard_id << ", offset " << offset << ", length " << length;
+      return nullptr;
+    }
+    return mapping.first + offset;
+  }
+
+  std::vector<std::pair<uint8_t *, uint64_t>> mappings_;  // [shard_id] address and size
+};
+#endif
+
+#ifdef ENABLE_IO_URING
+// liburing is opened the first time an io_uring reader is made, so that the package does not depend on it and falls
+// back to pread where it is missing. Only its exported functions are called through here, the inline helpers of
+// liburing.h are compiled in. The layouts of liburing.h are those of its major version 2.
+struct LibUring {
+  int (*queue_init)(unsigned entries, struct io_uring *ring, unsigned flags);
+  void (*queue_exit)(struct io_uring *ring);
+  int (*submit)(struct io_uring *ring);
+  struct io_uring_sqe *(*get_sqe)(struct io_uring *ring);
+  int (*wait_cqes)(struct io_uring *ring, struct io_uring_cqe **cqe_ptr, unsigned wait_nr,
+                   struct __kernel_timespec *ts, sigset_t *sigmask);
+};
+
+static const LibUring *LoadLibUring() {
+  static const LibUring *lib = []() -> const LibUring * {
+    void *handle = dlopen("liburing.so.2", RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+      MS_LOG(WARNING) << "Cannot open liburing.so.2: " << dlerror();
+      return nullptr;
+    }
+    static LibUring funcs;
+    funcs.queue_init = reinterpret_cast<decltype(funcs.queue_init)>(dlsym(handle, "io_uring_queue_init"));
+    funcs.queue_exit = reinterpret_cast<decltype(funcs.queue_exit)>(dlsym(handle, "io_uring_queue_exit"));
+    funcs.submit = reinterpret_cast<decltype(funcs.submit)>(dlsym(handle, "io_uring_submit"));
+    funcs.get_sqe = reinterpret_cast<decltype(funcs.get_sqe)>(dlsym(handle, "io_uring_get_sqe"));
+    funcs.wait_cqes = reinterpret_cast<decltype(funcs.wait_cqes)>(dlsym(handle, "io_uring_wait_cqes"));
+    if (funcs.queue_init == nullptr || funcs.queue_exit == nullptr || funcs.submit == nullptr ||
+        funcs.get_sqe == nullptr || funcs.wait_cqes == nullptr) {
+      MS_LOG(WARNING) << "liburing.so.2 misses some io_uring functions.";
+      (void)dlclose(handle);
+      return nullptr;
+    }
+    return &funcs;
+  }();
+  return lib;
+}
+
+// The chunks of a read are submitted together to a ring of the reader thread, up to queue_depth at a time.
+class ShardIOUring : public ShardIOPread {
+ public:
+  explicit ShardIOUring(int queue_depth) : ShardIOPread(queue_depth, ShardIOMode::kIoUring) {}
+  ~ShardIOUring() override { Close(); }
+
+  MSRStatus Open(const std::vector<std::string> &file_paths, int n_reader) override {
+    if (ShardIOPread::Open(file_paths, n_reader) != SUCCESS) {
+      return FAILED;
+    }
+    lib_ = LoadLibUring();
+    if (lib_ == nullptr) {
+      MS_LOG(WARNING) << "io_uring is not available, use pread instead.";
+      mode_ = ShardIOMode::kPread;
+      return SUCCESS;
+    }
+    rings_ = std::vector<struct io_uring>(n_reader);
+    for (int i = 0; i < n_reader; ++i) {
+      auto ret = lib_->queue_init(queue_depth_, &rings_[i], 0);
+      if (ret < 0) {
+        // e.g. a kernel older than 5.1, the descriptors are still good for pread
+        MS_LOG(WARNING) << "io_uring is not available, errno " << -ret << ", use pread instead.";
+        mode_ = ShardIOMode::kPread;
+        rings_.resize(i);
+        CloseRings();
+        break;
+      }
+    }
+    return SUCCESS;
+  }
+
+  void Close() override {
+    CloseRings();
+    ShardIOPread::Close();
+  }
+
+  MSRStatus Read(int shard_id, uint64_t offset, uint64_t length, uint8_t *buf, int reader_id) override {
+    if (rings_.empty()) {
+      return ShardIOPread::Read(shard_id, offset, length, buf, reader_id);
+    }
+    auto start = Now();
+    auto ring = &rings_[reader_id];
+    int fd = fds_[shard_id];
+    uint64_t submitted = 0;  // bytes queued so far
+    uint64_t done = 0;       // bytes read so far
+    int in_flight = 0;
+    while (done < length) {
+      while (submitted < length && in_flight < queue_depth_) {
+        struct io_uring_sqe *sqe = lib_->get_sqe(ring);
+        if (sqe == nullptr) {
+          break;
+        }
+        auto chunk = static_cast<unsigned>(std::min(kIOChunkSize, length - submitted));
+        io_uring_prep_read(sqe, fd, buf + submitted, chunk, offset + submitted);
+        io_uring_sqe_set_data(sqe, reinterpret_cast<void *>(submitted));
+        submitted += chunk;
+        in_flight++;
+      }
+      if (lib_->submit(ring) < 0) {
+        MS_LOG(ERROR) << "io_uring submit failed";
+        return FAILED;
+      }
+      struct io_uring_cqe *cqe = nullptr;
+      if (lib_->wait_cqes(ring, &cqe, 1, nullptr, nullptr) < 0) {
+        MS_LOG(ERROR) << "io_uring wait failed";
+        return FAILED;
+      }
+      auto chunk_offset = reinterpret_cast<uint64_t>(io_uring_cqe_get_data(cqe));
+      auto res = cqe->res;
+      io_uring_cqe_seen(ring, cqe);
+      in_flight--;
+      if (res <= 0) {
+        MS_LOG(ERROR) << "File read failed, errno " << -res;
+        DrainRing(ring, in_flight);
+        return FAILED;
+      }
+      auto chunk = std::min(kIOChunkSize, length - chunk_offset);
+      if (static_cast<uint64_t>(res) < chunk &&
+          !PreadFull(fd, buf + chunk_offset + res, chunk - res, offset + chunk_offset + res)) {
+        // a short read is finished synchronously
+        MS_LOG(ERROR) << "File read failed, errno " << errno;
+        DrainRing(ring, in_flight);
+        return FAILED;
+      }
+      done += chunk;
+    }
+    Record(length, start);
+    return SUCCESS;
+  }
+
+ private:
+  // wait for the requests still in flight, their buffer is about to be released
+  void DrainRing(struct io_uring *ring, int in_flight) {
+    for (; in_flight > 0; --in_flight) {
+      struct io_uring_cqe *cqe = nullptr;
+      if (lib_->wait_cqes(ring, &cqe, 1, nullptr, nullptr) < 0) {
+        return;
+      }
+      io_uring_cqe_seen(ring, cqe);
+    }
+  }
+
+  void CloseRings() {
+    for (auto &ring : rings_) {
+      lib_->queue_exit(&ring);
+    }
+    rings_.clear();
+  }
+
+  const LibUring *lib_ = nullptr;
+  std::vector<struct io_uring> rings_;  // [reader_id]
+};
+#endif
+
+std::unique_ptr<ShardIO> ShardIO::Create(const std::string &mode, int queue_depth) {
+  auto ret = GetMode(mode);
+  if (ret.first != SUCCESS) {
+    MS_LOG(ERROR) << "Invalid io mode " << mode << ", use " << kIOModeStream << " instead.";
+    return std::make_unique<ShardIOStream>();
+  }
+#if !defined(_WIN32) && !defined(_WIN64)
+  switch (ret.second) {
+    case ShardIOMode::kPread:
+      return std::make_unique<ShardIOPread>(queue_depth);
+    case ShardIOMode::kMmap:
+      return std::make_unique<ShardIOMmap>();
+    case ShardIOMode::kIoUring:
+#ifdef ENABLE_IO_URING
+      return std::make_unique<ShardIOUring>(queue_depth);
+#else
+      MS_LOG(WARNING) << "Built without liburing, use " << kIOModePread << " instead of " << mode << ".";
+      return std::make_unique<ShardIOPread>(queue_depth);
+#endif
+    default:
+      return std::make_unique<ShardIOStream>();
+  }
+#else
+  if (ret.second != ShardIOMode::kStream) {
+    MS_LOG(WARNING) << "Io mode " << mode << " is not supported on Windows, use " << kIOModeStream << " instead.";
+  }
+  return std::make_unique<ShardIOStream>();
+#endif
+}
+}  // namespace mindrecord
+}  // namespace mindspore
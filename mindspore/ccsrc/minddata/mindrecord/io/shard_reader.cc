@@ -47,6 +47,8 @@ ShardReader::ShardReader() {
   num_blocks_ = 0;
   block_reader_ = false;
   num_padded_ = 0;
+  io_mode_ = kIOModeStream;
+  io_queue_depth_ = kDefaultIOQueueDepth;
 }
 
 std::pair<MSRStatus, std::vector<std::string>> ShardReader::GetMeta(const std::string &file_path, json &meta_data) {
@@ -171,54 +173,41 @@ MSRStatus ShardReader::CheckColumnList(const std::vector<std::string> &selected_
   return SUCCESS;
 }
 
-MSRStatus ShardReader::Open() {
-  file_streams_.clear();
+MSRStatus ShardReader::Open() { return Open(1); }
 
-  for (const auto &file : file_paths_) {
-    std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
-    fs->open(common::SafeCStr(file), std::ios::in | std::ios::binary);
-    if (!fs->good()) {
-      MS_LOG(ERROR) << "File could not opened";
-      return FAILED;
-    }
-    MS_LOG(INFO) << "Open shard file successfully.";
-    file_streams_.push_back(fs);
+MSRStatus ShardReader::Open(int n_consumer) {
+  if (shard_io_ != nullptr) {
+    shard_io_->Close();
+  }
+  shard_io_ = ShardIO::Create(io_mode_, io_queue_depth_);
+  if (shard_io_->Open(file_paths_, n_consumer) != SUCCESS) {
+    return FAILED;
   }
+  MS_LOG(INFO) << "Open shard file successfully, io mode is " << shard_io_->GetModeName() << ".";
 
   return SUCCESS;
 }
 
-MSRStatus ShardReader::Open(int n_consumer) {
-  file_streams_random_ =
-    std::vector<std::vector<std::shared_ptr<std::fstream>>>(n_consumer, std::vector<std::shared_ptr<std::fstream>>());
-  for (const auto &file : file_paths_) {
-    for (int j = 0; j < n_consumer; ++j) {
-      std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
-      fs->open(common::SafeCStr(file), std::ios::in | std::ios::binary);
-      if (!fs->good()) {
-        MS_LOG(ERROR) << "File could not opened";
-        return FAILED;
-      }
-      file_streams_random_[j].push_back(fs);
-    }
-    MS_LOG(INFO) << "Open shard file successfully.";
-  }
-
-  return SUCCESS;
+void ShardReader::SetIOMode(const std::string &io_mode, int queue_depth) {
+  io_mode_ = io_mode;
+  io_queue_depth_ = queue_depth;
 }
 
+ShardIOStats ShardReader::GetIOStats() const { return shard_io_ == nullptr ? ShardIOStats() : shard_io_->GetStats(); }
+
 void ShardReader::FileStreamsOperator() {
-  for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; --i) {
-    if (file_streams_[i] != nullptr) {
-      file_streams_[i]->close();
+  if (shard_io_ != nullptr) {
+    auto stats = shard_io_->GetStats();
+    if (stats.num_requests > 0) {
+      MS_LOG(INFO) << "Shard files read in " << shard_io_->GetModeName() << " mode: " << stats.bytes_read
+                   << " bytes in " << stats.num_requests << " requests, " << stats.Throughput() << " MB/s, "
+                   << stats.Latency() << " us per request.";
     }
-  }
-  for (int i = static_cast<int>(file_streams_random_.size()) - 1; i >= 0; --i) {
-    for (int j = static_cast<int>(file_streams_random_[i].size()) - 1; j >= 0; --j) {
-      if (file_streams_random_[i][j] != nullptr) {
-        file_streams_random_[i][j]->close();
-      }
+    if (stats.num_slices > 0) {
+      MS_LOG(INFO) << "Shard files sliced in " << shard_io_->GetModeName() << " mode: " << stats.bytes_sliced
+                   << " bytes in " << stats.num_slices << " pages.";
     }
+    shard_io_->Close();
   }
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
@@ -280,12 +269,17 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
                                           std::vector<std::vector<std::vector<uint64_t>>> &offsets, int shard_id,
                                           const std::vector<std::string> &columns,
                                           std::vector<std::vector<json>> &column_values) {
+  // the offsets of the other blob columns of a columnar blob page close the fields
+  int column_offset_id = 0;
+  if (shard_header_->GetColumnarBlob() && !labels.empty()) {
+    column_offset_id = labels[0].size() - (blob_column_selected_.size() - 1) * 2;
+  }
   for (int i = 0; i < static_cast<int>(labels.size()); ++i) {
     uint64_t group_id = std::stoull(labels[i][0]);
-    uint64_t offset_start = std::stoull(labels[i][1]) + kInt64Len;
-    uint64_t offset_end = std::stoull(labels[i][2]);
-    offsets[shard_id].emplace_back(
-      std::vector<uint64_t>{static_cast<uint64_t>(shard_id), group_id, offset_start, offset_end});
+    std::vector<uint64_t> offset{static_cast<uint64_t>(shard_id), group_id};
+    auto blob_address = GetBlobAddress(labels[i], 1, column_offset_id);
+    offset.insert(offset.end(), blob_address.begin(), blob_address.end());
+    offsets[shard_id].emplace_back(std::move(offset));
     if (!all_in_index_) {
       int raw_page_id = std::stoi(labels[i][3]);
       uint64_t label_start = std::stoull(labels[i][4]) + kInt64Len;
@@ -435,6 +429,7 @@ ROW_GROUPS ShardReader::ReadAllRowGroup(std::vector<std::string> &columns) {
   } else {  // fetch raw data from Raw page while some field is not index.
     fields += ", PAGE_ID_RAW, PAGE_OFFSET_RAW, PAGE_OFFSET_RAW_END ";
   }
+  fields += GetBlobOffsetSQL();
 
   std::string sql = "SELECT " + fields + " FROM INDEXES ORDER BY ROW_ID ;";
 
@@ -509,8 +504,8 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
                                                                const std::pair<std::string, std::string> &criteria) {
   auto db = database_paths_[shard_id];
 
-  std::string sql =
-    "SELECT PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END FROM INDEXES WHERE PAGE_ID_BLOB = " + std::to_string(page_id);
+  std::string sql = "SELECT PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END" + GetBlobOffsetSQL() +
+                    " FROM INDEXES WHERE PAGE_ID_BLOB = " + std::to_string(page_id);
 
   // whether use index search
   if (!criteria.first.empty()) {
@@ -539,16 +534,107 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
     MS_LOG(DEBUG) << "Get " << static_cast<int>(image_offsets.size()) << "records from index.";
   }
   std::vector<std::vector<uint64_t>> res;
-  for (int i = static_cast<int>(image_offsets.size()) - 1; i >= 0; i--) res.emplace_back(std::vector<uint64_t>{0, 0});
-  for (int i = 0; i < static_cast<int>(image_offsets.size()); i++) {
-    const auto &image_offset = image_offsets[i];
-    res[i][0] = std::stoull(image_offset[0]) + kInt64Len;
-    res[i][1] = std::stoull(image_offset[1]);
+  for (const auto &image_offset : image_offsets) {
+    res.emplace_back(GetBlobAddress(image_offset, 0, 2));
   }
   sqlite3_free(errmsg);
   return res;
 }
 
+std::vector<uint64_t> ShardReader::GetBlobAddress(const std::vector<std::string> &fields, int offset_id,
+                                                  int column_offset_id) {
+  if (!shard_header_->GetColumnarBlob()) {
+    // skip the size of the blob
+    return {std::stoull(fields[offset_id]) + kInt64Len, std::stoull(fields[offset_id + 1])};
+  }
+  std::vector<uint64_t> blob_address{std::stoull(fields[offset_id]), std::stoull(fields[offset_id + 1])};
+  for (size_t i = column_offset_id; i < fields.size(); ++i) {
+    blob_address.push_back(std::stoull(fields[i]));
+  }
+  return blob_address;
+}
+
+std::string ShardReader::GetBlobOffsetSQL() {
+  std::string sql;
+  if (shard_header_->GetColumnarBlob()) {
+    for (const auto &field : ShardIndexGenerator::GenerateBlobOffsetFields(blob_column_selected_.size())) {
+      sql += ", " + field;
+    }
+  }
+  return sql;
+}
+
+void ShardReader::SelectBlobColumns() {
+  auto blob_fields = GetBlobFields().second;
+  blob_column_selected_ = std::vector<bool>(blob_fields.size(), true);
+  if (selected_columns_.empty()) {
+    return;
+  }
+  for (size_t i = 0; i < blob_fields.size(); ++i) {
+    blob_column_selected_[i] =
+      std::find(selected_columns_.begin(), selected_columns_.end(), blob_fields[i]) != selected_columns_.end();
+  }
+  if (shard_header_->GetColumnarBlob()) {
+    MS_LOG(INFO) << "Read " << std::count(blob_column_selected_.begin(), blob_column_selected_.end(), true) << " of "
+                 << blob_fields.size() << " blob columns.";
+  }
+}
+
+uint64_t ShardReader::GetRowBlobSize(const std::vector<uint64_t> &blob_address) {
+  if (!shard_header_->GetColumnarBlob()) {
+    return blob_address[1] - blob_address[0];
+  }
+  // a blob column which is not read is left with its size, of 0
+  uint64_t blob_size = 0;
+  for (size_t i = 0; i < blob_column_selected_.size(); ++i) {
+    blob_size += blob_column_selected_[i] ? blob_address[i * 2 + 1] - blob_address[i * 2] : kInt64Len;
+  }
+  return blob_size;
+}
+
+std::pair<MSRStatus, std::vector<uint8_t>> ShardReader::ReadRowBlob(int shard_id, uint64_t page_id,
+                                                                    const std::vector<uint64_t> &blob_address,
+                                                                    int reader_id) {
+  std::vector<uint8_t> blob(GetRowBlobSize(blob_address), 0);
+  uint64_t page_offset = header_size_ + page_size_ * page_id;
+  if (!shard_header_->GetColumnarBlob()) {
+    if (shard_io_->Read(shard_id, page_offset + blob_address[0], blob.size(), blob.data(), reader_id) != SUCCESS) {
+      return {FAILED, {}};
+    }
+    return {SUCCESS, std::move(blob)};
+  }
+  uint64_t blob_offset = 0;
+  for (size_t i = 0; i < blob_column_selected_.size(); ++i) {
+    if (!blob_column_selected_[i]) {
+      blob_offset += kInt64Len;
+      continue;
+    }
+    uint64_t column_size = blob_address[i * 2 + 1] - blob_address[i * 2];
+    if (shard_io_->Read(shard_id, page_offset + blob_address[i * 2], column_size, &blob[blob_offset], reader_id) !=
+        SUCCESS) {
+      return {FAILED, {}};
+    }
+    blob_offset += column_size;
+  }
+  return {SUCCESS, std::move(blob)};
+}
+
+std::vector<uint8_t> ShardReader::CopyRowBlob(const uint8_t *page, const std::vector<uint64_t> &blob_address) {
+  if (!shard_header_->GetColumnarBlob()) {
+    return std::vector<uint8_t>(page + blob_address[0], page + blob_address[1]);
+  }
+  std::vector<uint8_t> blob(GetRowBlobSize(blob_address), 0);
+  auto blob_iter = blob.begin();
+  for (size_t i = 0; i < blob_column_selected_.size(); ++i) {
+    if (blob_column_selected_[i]) {
+      blob_iter = std::copy(page + blob_address[i * 2], page + blob_address[i * 2 + 1], blob_iter);
+    } else {
+      blob_iter += kInt64Len;
+    }
+  }
+  return blob;
+}
+
 std::pair<ShardType, std::vector<std::string>> ShardReader::GetBlobFields() {
   std::vector<std::string> blob_fields;
   for (auto &p : GetShardHeader()->GetSchemas()) {
@@ -882,6 +968,7 @@ MSRStatus ShardReader::Open(const std::vector<std::string> &file_paths, bool loa
     MS_LOG(ERROR) << "Illegal column list";
     return ILLEGAL_COLUMN_LIST;
   }
+  SelectBlobColumns();
 
   // Initialize argument
   shard_count_ = static_cast<int>(file_paths_.size());
@@ -892,12 +979,16 @@ MSRStatus ShardReader::Open(const std::vector<std::string> &file_paths, bool loa
 
   if (block_reader) {
     block_reader_ = true;
-    if (Open() == FAILED) {
+    if (Open(n_consumer) == FAILED) {
       return FAILED;
     }
     delivery_block_ = std::vector<std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>>(
       kNumPageInBuffer, std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>{});
-    buf_ = std::vector<std::vector<uint8_t>>(kNumPageInBuffer, std::vector<uint8_t>(page_size_));
+    blob_pages_ = std::vector<const uint8_t *>(kNumPageInBuffer, nullptr);
+    // pages are sliced out of the mapped files instead of being copied
+    if (shard_io_->GetMode() != ShardIOMode::kMmap) {
+      buf_ = std::vector<std::vector<uint8_t>>(kNumPageInBuffer, std::vector<uint8_t>(page_size_));
+    }
   } else {
     block_reader_ = false;
     if (Open(n_consumer) == FAILED) {
@@ -936,6 +1027,7 @@ MSRStatus ShardReader::OpenPy(const std::vector<std::string> &file_paths, bool l
 
   // Initialize columns which will be read
   selected_columns_ = selected_columns;
+  SelectBlobColumns();
   operators_ = operators;
 
   return SUCCESS;
@@ -1058,7 +1150,7 @@ MSRStatus ShardReader::CreateTasksByRow(const std::vector<std::tuple<int, int, i
     for (int shard_id = 0; shard_id < shard_count_; shard_id++) {
       for (uint32_t i = 0; i < offsets[shard_id].size(); i += 1) {
         tasks_.InsertTask(TaskType::kCommonTask, offsets[shard_id][i][0], offsets[shard_id][i][1],
-                          std::vector<uint64_t>{offsets[shard_id][i][2], offsets[shard_id][i][3]},
+                          std::vector<uint64_t>(offsets[shard_id][i].begin() + 2, offsets[shard_id][i].end()),
                           local_columns[shard_id][i]);
       }
     }
@@ -1143,29 +1235,15 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
   const std::shared_ptr<Page> &page = ret.second;
 
   // Pack image list
-  std::vector<uint8_t> images(addr[1] - addr[0]);
-  auto file_offset = header_size_ + page_size_ * (page->GetPageID()) + addr[0];
-
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
-  }
-
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), addr[1] - addr[0]);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
+  auto images = ReadRowBlob(shard_id, page->GetPageID(), addr, consumer_id);
+  if (images.first != SUCCESS) {
     return std::make_pair(FAILED,
                           std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
   }
 
   // Deliver batch data to output map
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
-  batch.emplace_back(std::move(images), std::move(std::get<3>(task)));
+  batch.emplace_back(std::move(images.second), std::move(std::get<3>(task)));
 
   return std::make_pair(SUCCESS, std::make_pair(TaskType::kCommonTask, std::move(batch)));
 }
@@ -1208,19 +1286,28 @@ MSRStatus ShardReader::ConsumerByRow(int consumer_id) {
 }
 
 MSRStatus ShardReader::ReadBlob(const int &shard_id, const uint64_t &page_offset, const int &page_length,
-                                const int &buf_id) {
-  auto &io_seekg = file_streams_[shard_id]->seekg(page_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_[shard_id]->close();
-    return FAILED;
-  }
-
-  auto &io_read = file_streams_[shard_id]->read(reinterpret_cast<char *>(&buf_[buf_id][0]), page_length);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_[shard_id]->close();
-    return FAILED;
+                                const int &buf_id, const int &consumer_id,
+                                const std::vector<std::vector<uint64_t>> &blob_addresses) {
+  if (buf_.empty()) {
+    blob_pages_[buf_id] = shard_io_->Slice(shard_id, page_offset, page_length);
+    return blob_pages_[buf_id] == nullptr ? FAILED : SUCCESS;
+  }
+  blob_pages_[buf_id] = buf_[buf_id].data();
+  if (!shard_header_->GetColumnarBlob()) {
+    return shard_io_->Read(shard_id, page_offset, page_length, buf_[buf_id].data(), consumer_id);
+  }
+  if (blob_addresses.empty()) {
+    return SUCCESS;
+  }
+  // each blob column is contiguous in a columnar page, only the selected ones are read
+  for (size_t i = 0; i < blob_column_selected_.size(); ++i) {
+    if (!blob_column_selected_[i]) continue;
+    uint64_t column_start = blob_addresses.front()[i * 2];
+    uint64_t column_end = blob_addresses.back()[i * 2 + 1];
+    if (shard_io_->Read(shard_id, page_offset + column_start, column_end - column_start,
+                        buf_[buf_id].data() + column_start, consumer_id) != SUCCESS) {
+      return FAILED;
+    }
   }
   return SUCCESS;
 }
@@ -1282,7 +1369,7 @@ MSRStatus ShardReader::ConsumerByBlock(int consumer_id) {
       std::make_shared<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>(offset_and_labels);
 
     // Read blob
-    if (ReadBlob(shard_id, page_offset, page_length, buf_id) != SUCCESS) {
+    if (ReadBlob(shard_id, page_offset, page_length, buf_id, consumer_id, offset_and_labels.first) != SUCCESS) {
       return FAILED;
     }
 
@@ -1296,12 +1383,10 @@ MSRStatus ShardReader::ConsumerByBlock(int consumer_id) {
 
 std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardReader::GetRowFromBuffer(int buf_id,
                                                                                                    int rowId) {
-  auto &blob_page = buf_[buf_id];
+  auto blob_page = blob_pages_[buf_id];
   auto &offsets = (*delivery_block_[buf_id]).first;
   auto &labels = (*delivery_block_[buf_id]).second;
-  auto &addr_start = offsets[rowId][0];
-  auto &addr_end = offsets[rowId][1];
-  std::vector<uint8_t> images(blob_page.begin() + addr_start, blob_page.begin() + addr_end);
+  auto images = CopyRowBlob(blob_page, offsets[rowId]);
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
   batch.emplace_back(std::move(images), std::move(labels[rowId]));
   return std::make_shared<std::vector<std::tuple<std::vector<uint8_t>, json>>>(std::move(batch));
@@ -32,7 +32,8 @@ ShardWriter::ShardWriter()
       header_size_(kDefaultHeaderSize),
       page_size_(kDefaultPageSize),
       row_count_(0),
-      schema_count_(1) {}
+      schema_count_(1),
+      columnar_blob_(false) {}
 
 ShardWriter::~ShardWriter() {
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; i--) {
@@ -201,6 +202,7 @@ MSRStatus ShardWriter::OpenForAppend(const std::string &path) {
   if (ret == FAILED) {
     return FAILED;
   }
+  columnar_blob_ = shard_header_->GetColumnarBlob();
   ret = Open(real_addresses, true);
   if (ret == FAILED) {
     MS_LOG(ERROR) << "Open file failed";
@@ -273,6 +275,11 @@ MSRStatus ShardWriter::SetShardHeader(std::shared_ptr<ShardHeader> header_data)
   shard_header_->SetHeaderSize(header_size_);
   shard_header_->SetPageSize(page_size_);
   shard_column_ = std::make_shared<ShardColumn>(shard_header_);
+  if (columnar_blob_ && shard_column_->GetNumBlobColumn() < 2) {
+    MS_LOG(INFO) << "Less than two blob columns, blob pages are stored row by row.";
+    columnar_blob_ = false;
+  }
+  shard_header_->SetColumnarBlob(columnar_blob_);
   return SUCCESS;
 }
 
@@ -305,6 +312,15 @@ MSRStatus ShardWriter::SetPageSize(const uint64_t &page_size) {
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::SetColumnarBlob(bool columnar_blob) {
+  if (shard_header_ != nullptr) {
+    MS_LOG(ERROR) << "Blob layout should be set before the shard header.";
+    return FAILED;
+  }
+  columnar_blob_ = columnar_blob;
+  return SUCCESS;
+}
+
 void ShardWriter::DeleteErrorData(std::map<uint64_t, std::vector<json>> &raw_data,
                                   std::vector<std::vector<uint8_t>> &blob_data) {
   // get wrong data location
@@ -833,7 +849,8 @@ MSRStatus ShardWriter::CutRowGroup(int start_row, int end_row, const std::vector
                                    std::vector<std::pair<int, int>> &rows_in_group,
                                    const std::shared_ptr<Page> &last_raw_page,
                                    const std::shared_ptr<Page> &last_blob_page) {
-  auto n_byte_blob = last_blob_page ? last_blob_page->GetPageSize() : 0;
+  // a columnar blob page cannot take more rows once written, so the rows start a new one
+  auto n_byte_blob = last_blob_page && !columnar_blob_ ? last_blob_page->GetPageSize() : 0;
 
   auto last_raw_page_size = last_raw_page ? last_raw_page->GetPageSize() : 0;
   auto last_raw_offset = last_raw_page ? last_raw_page->GetLastRowGroupID().second : 0;
@@ -910,7 +927,11 @@ MSRStatus ShardWriter::NewBlobPage(const int &shard_id, const std::vector<std::v
       return FAILED;
     }
 
-    (void)FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row);
+    auto flush = columnar_blob_ ? FlushColumnarBlobChunk(file_streams_[shard_id], blob_data, blob_row)
+                                : FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row);
+    if (flush != SUCCESS) {
+      return FAILED;
+    }
     // Create new page info for header
     auto page_size =
       std::accumulate(blob_data_size_.begin() + blob_row.first, blob_data_size_.begin() + blob_row.second, 0);
@@ -1083,6 +1104,42 @@ MSRStatus ShardWriter::FlushBlobChunk(const std::shared_ptr<std::fstream> &out,
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::FlushColumnarBlobChunk(const std::shared_ptr<std::fstream> &out,
+                                              const std::vector<std::vector<uint8_t>> &blob_data,
+                                              const std::pair<int, int> &blob_row) {
+  if (blob_row.first > blob_row.second) {
+    return FAILED;
+  }
+  if (blob_row.second > static_cast<int>(blob_data.size()) || blob_row.first < 0) {
+    return FAILED;
+  }
+  // a blob of several columns is the size (8 bytes, big-endian) and the data of every column in turn
+  std::vector<uint64_t> column_start(blob_row.second - blob_row.first, 0);
+  for (uint64_t i = 0; i < shard_column_->GetNumBlobColumn(); ++i) {
+    for (int j = blob_row.first; j < blob_row.second; ++j) {
+      const auto &blob = blob_data[j];
+      auto &start = column_start[j - blob_row.first];
+      if (start + kInt64Len > blob.size()) {
+        MS_LOG(ERROR) << "Blob of row " << j << " has less columns than the schema.";
+        return FAILED;
+      }
+      uint64_t column_len = kInt64Len + ShardColumn::BytesBigToUInt64(blob, start, kInt64Type);
+      if (start + column_len > blob.size()) {
+        MS_LOG(ERROR) << "Blob column " << i << " of row " << j << " is truncated.";
+        return FAILED;
+      }
+      auto &io_handle = out->write(reinterpret_cast<const char *>(&blob[start]), column_len);
+      if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
+        MS_LOG(ERROR) << "File write failed";
+        out->close();
+        return FAILED;
+      }
+      start += column_len;
+    }
+  }
+  return SUCCESS;
+}
+
 MSRStatus ShardWriter::FlushRawChunk(const std::shared_ptr<std::fstream> &out,
                                      const std::vector<std::pair<int, int>> &rows_in_group, const int &chunk_id,
                                      const std::vector<std::vector<uint8_t>> &bin_raw_data) {
@@ -1224,8 +1281,10 @@ MSRStatus ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &b
 
 MSRStatus ShardWriter::SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data) {
   blob_data_size_ = std::vector<uint64_t>(row_count_);
+  // a row blob page prefixes every blob with its size, a columnar one keeps the sizes of the blob columns only
+  uint64_t size_len = columnar_blob_ ? 0 : kInt64Len;
   (void)std::transform(blob_data.begin(), blob_data.end(), blob_data_size_.begin(),
-                       [](const std::vector<uint8_t> &row) { return kInt64Len + row.size(); });
+                       [size_len](const std::vector<uint8_t> &row) { return size_len + row.size(); });
   if (*std::max_element(blob_data_size_.begin(), blob_data_size_.end()) > page_size_) {
     MS_LOG(ERROR) << "Page size is too small to save a row!";
     return FAILED;
@@ -33,7 +33,9 @@ using mindspore::MsLogLevel::ERROR;
 namespace mindspore {
 namespace mindrecord {
 std::atomic<bool> thread_status(false);
-ShardHeader::ShardHeader() : shard_count_(0), header_size_(0), page_size_(0) { index_ = std::make_shared<Index>(); }
+ShardHeader::ShardHeader() : shard_count_(0), header_size_(0), page_size_(0), columnar_blob_(false) {
+  index_ = std::make_shared<Index>();
+}
 
 MSRStatus ShardHeader::InitializeHeader(const std::vector<json> &headers, bool load_dataset) {
   shard_count_ = headers.size();
@@ -54,6 +56,7 @@ MSRStatus ShardHeader::InitializeHeader(const std::vector<json> &headers, bool l
       ParseShardAddress(header["shard_addresses"]);
       header_size_ = header["header_size"].get<uint64_t>();
       page_size_ = header["page_size"].get<uint64_t>();
+      columnar_blob_ = header.find("blob_layout") != header.end() && header["blob_layout"] == kBlobLayoutColumn;
     }
     ParsePage(header["page"], shard_index, load_dataset);
     shard_index++;
@@ -330,8 +333,11 @@ std::vector<std::string> ShardHeader::SerializeHeader() {
   }
   if (shard_count_ <= kMaxShardCount) {
     for (int shardId = 0; shardId < shard_count_; shardId++) {
-      string s;
-      s += "{\"header_size\":" + std::to_string(header_size_) + ",";
+      string s = "{";
+      if (columnar_blob_) {
+        s += "\"blob_layout\":\"" + std::string(kBlobLayoutColumn) + "\",";
+      }
+      s += "\"header_size\":" + std::to_string(header_size_) + ",";
       s += "\"index_fields\":" + index + ",";
       s += "\"page\":" + pages[shardId] + ",";
       s += "\"page_size\":" + std::to_string(page_size_) + ",";
@@ -339,7 +345,7 @@ std::vector<std::string> ShardHeader::SerializeHeader() {
       s += "\"shard_addresses\":" + address + ",";
       s += "\"shard_id\":" + std::to_string(shardId) + ",";
       s += "\"statistics\":" + stats + ",";
-      s += "\"version\":\"" + std::string(kVersion) + "\"";
+      s += "\"version\":\"" + std::string(columnar_blob_ ? kColumnarBlobVersion : kVersion) + "\"";
       s += "}";
       header.emplace_back(s);
     }
@@ -23,6 +23,9 @@
 #include <unordered_map>
 #include <cstdlib>
 #include <algorithm>
+#include <chrono>
+#include <thread>
+#include <utility>
 
 #include "ir/param_value.h"
 #include "pipeline/jit/pass.h"
@@ -41,6 +44,10 @@
 #include "pipeline/pynative/pynative_execute.h"
 #include "frontend/optimizer/py_pass_manager.h"
 
+#ifdef ENABLE_CPUQUE
+#include "runtime/device/cpu/cpu_buffer_mgr.h"
+#endif
+
 #if (ENABLE_GE || ENABLE_D)
 #include "pipeline/jit/pipeline_ge.h"
 #include "transform/graph_ir/convert.h"
@@ -796,6 +803,11 @@ bool InitExecDatasetVm(const std::string &queue_name, int64_t size, int64_t batc
                        const std::vector<TypePtr> &types, const std::vector<std::vector<int64_t>> &shapes,
                        const std::vector<int64_t> &input_indexes, bool need_run) {
   MS_LOG(INFO) << "Start InitDataSet Entry";
+  if (MsContext::GetInstance()->device_target() == kCPUDevice) {
+    // The dataset cpu sink opens its channel by itself and GetNextFromCpuQueue pops from it directly
+    MS_LOG(DEBUG) << "InitDataSetVm End, no init graph for the cpu queue.";
+    return true;
+  }
   std::vector<int> int_input_indexes;
   (void)std::transform(input_indexes.begin(), input_indexes.end(), std::back_inserter(int_input_indexes),
                        [](int64_t item) { return static_cast<int>(item); });
@@ -856,6 +868,87 @@ bool InitExecDatasetVm(const std::string &queue_name, int64_t size, int64_t batc
   return true;
 }
 
+#ifdef ENABLE_CPUQUE
+namespace {
+// Tensor data on a buffer of the dataset cpu sink. The buffer is shared, not copied, and lives as long as the tensor.
+class CpuQueueTensorData : public tensor::TensorData {
+ public:
+  CpuQueueTensorData(device::DataItemCpu &&item, ssize_t itemsize) : item_(std::move(item)), itemsize_(itemsize) {}
+  ~CpuQueueTensorData() = default;
+
+  ssize_t size() const override { return nbytes() / itemsize_; }
+  ssize_t itemsize() const override { return itemsize_; }
+  ssize_t nbytes() const override { return static_cast<ssize_t>(item_.data_len_); }
+  ssize_t ndim() const override { return static_cast<ssize_t>(item_.shape_.size()); }
+  void *data() override { return item_.data_ptr_; }
+
+  bool equals(const tensor::TensorData &other) const override {
+    auto ptr = dynamic_cast<const CpuQueueTensorData *>(&other);
+    return ptr != nullptr && ptr->item_.data_ptr_ == item_.data_ptr_ && ptr->item_.data_len_ == item_.data_len_;
+  }
+
+  std::string ToString(const TypeId type, const std::vector<int> &shape) const override {
+    // printing is rare, so a copy is made to reuse the formatting of the regular tensor data
+    Tensor copy(type, shape, item_.data_ptr_, item_.data_len_);
+    return copy.data().ToString(type, shape);
+  }
+
+ private:
+  device::DataItemCpu item_;
+  ssize_t itemsize_;
+};
+}  // namespace
+
+py::tuple GetNextFromCpuQueue(const std::string &queue_name, const std::vector<TypePtr> &types) {
+  const unsigned int kWaitTimeInMs = 5000;
+  const int kMaxRepeat = 10;
+  std::vector<device::DataItemCpu> items;
+  device::CpuQueueStatus ret;
+  {
+    // the dataset may run python operations while we wait
+    py::gil_scoped_release release;
+    int repeat = 0;
+    while (true) {
+      ret = device::CpuBufferMgr::GetInstance().Pop(queue_name, &items, kWaitTimeInMs);
+      if (ret == device::CPU_QUEUE_NOT_EXIST) {
+        // the channel is opened when the device queue op starts running
+        std::this_thread::sleep_for(std::chrono::milliseconds(kWaitTimeInMs));
+      } else if (ret != device::CPU_QUEUE_TIMEOUT) {
+        break;
+      }
+      if (++repeat >= kMaxRepeat) {
+        break;
+      }
+      MS_LOG(INFO) << "Waiting for data...(" << repeat << " / " << kMaxRepeat << ")";
+    }
+  }
+  if (ret == device::CPU_QUEUE_CLOSED) {
+    MS_LOG(EXCEPTION) << "Cpu queue " << queue_name << " has been closed, no more data.";
+  } else if (ret != device::CPU_QUEUE_SUCCESS) {
+    MS_LOG(EXCEPTION) << "Get data from cpu queue " << queue_name << " timeout, errcode " << ret;
+  }
+  if (items.size() != types.size()) {
+    MS_LOG(EXCEPTION) << "Cpu queue " << queue_name << " gives " << items.size() << " columns, expect "
+                      << types.size();
+  }
+
+  py::tuple tensors(items.size());
+  for (size_t i = 0; i < items.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(types[i]);
+    TypeId type_id = types[i]->type_id();
+    auto itemsize = static_cast<ssize_t>(GetTypeByte(TypeIdToType(type_id)));
+    if (itemsize == 0 || items[i].data_len_ % itemsize != 0) {
+      MS_LOG(EXCEPTION) << "Column " << i << " of " << items[i].data_len_ << " bytes does not match type "
+                        << types[i]->ToString();
+    }
+    auto shape = items[i].shape_;
+    auto data = std::make_shared<CpuQueueTensorData>(std::move(items[i]), itemsize);
+    tensors[i] = std::make_shared<Tensor>(type_id, shape, data);
+  }
+  return tensors;
+}
+#endif
+
 void ResetOpId() { mindspore::id_generator::reset_id(); }
 
 void InitHccl() {
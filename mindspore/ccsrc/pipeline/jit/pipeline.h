@@ -140,6 +140,11 @@ bool InitExecDatasetVm(const std::string &queue_name, int64_t size, int64_t batc
                        const std::vector<TypePtr> &types, const std::vector<std::vector<int64_t>> &shapes,
                        const std::vector<int64_t> &input_indexes, bool need_run);
 
+#ifdef ENABLE_CPUQUE
+// Pop the next batch sent by the dataset cpu sink, the returned tensors share the buffers of the dataset
+py::tuple GetNextFromCpuQueue(const std::string &queue_name, const std::vector<TypePtr> &types);
+#endif
+
 void ProcessVmArgInner(const py::tuple &args, const ResourcePtr &res, VectorRef *const arg_list);
 
 }  // namespace pipeline
@@ -14,9 +14,27 @@
  * limitations under the License.
  */
 #include "runtime/device/convert_tensor_utils.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 namespace mindspore {
 namespace device {
+namespace {
+constexpr uint32_t kBFloat16Shift = 16;
+constexpr uint32_t kBFloat16NaN = 0x7fc0;
+
+uint16_t ToBFloat16(float value) {
+  if (std::isnan(value)) {
+    return kBFloat16NaN;
+  }
+  uint32_t bits = 0;
+  (void)memcpy(&bits, &value, sizeof(bits));
+  bits += 0x7fff + ((bits >> kBFloat16Shift) & 1);
+  return static_cast<uint16_t>(bits >> kBFloat16Shift);
+}
+}  // namespace
+
 void HalfToFloat(void *dst, const void *src, size_t elem_num) {
   auto half_data = static_cast<const Eigen::half *>(src);
   auto float_data = static_cast<float *>(dst);
@@ -49,5 +67,21 @@ void FloatToDouble(void *dst, const void *src, size_t elem_num) {
     double_data[i] = static_cast<double>(float_data[i]);
   }
 }
+
+void FloatToBFloat16(void *dst, const void *src, size_t elem_num) {
+  auto float_data = static_cast<const float *>(src);
+  auto bfloat16_data = static_cast<uint16_t *>(dst);
+  for (size_t i = 0; i < elem_num; ++i) {
+    bfloat16_data[i] = ToBFloat16(float_data[i]);
+  }
+}
+
+void HalfToBFloat16(void *dst, const void *src, size_t elem_num) {
+  auto half_data = static_cast<const Eigen::half *>(src);
+  auto bfloat16_data = static_cast<uint16_t *>(dst);
+  for (size_t i = 0; i < elem_num; ++i) {
+    bfloat16_data[i] = ToBFloat16(Eigen::half_impl::half_to_float(half_data[i]));
+  }
+}
 }  // namespace device
 }  // namespace mindspore
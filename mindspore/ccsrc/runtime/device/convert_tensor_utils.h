@@ -27,6 +27,9 @@ void HalfToFloat(void *dst, const void *src, size_t elem_num);
 void FloatToHalf(void *dst, const void *src, size_t elem_num);
 void DoubleToFloat(void *dst, const void *src, size_t elem_num);
 void FloatToDouble(void *dst, const void *src, size_t elem_num);
+// bfloat16 is the upper half of a float32, the conversions to it round to nearest even
+void FloatToBFloat16(void *dst, const void *src, size_t elem_num);
+void HalfToBFloat16(void *dst, const void *src, size_t elem_num);
 }  // namespace device
 }  // namespace mindspore
 
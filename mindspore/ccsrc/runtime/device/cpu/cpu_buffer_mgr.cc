@@ -0,0 +1,125 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/device/cpu/cpu_buffer_mgr.h"
+#include <chrono>
+#include <utility>
+
+namespace mindspore {
+namespace device {
+CpuQueueStatus CpuQueue::Push(std::vector<DataItemCpu> &&data, unsigned int timeout_in_ms) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!not_full_cond_.wait_for(lock, std::chrono::milliseconds(timeout_in_ms),
+                               [this] { return closed_ || queue_.size() < capacity_; })) {
+    return CPU_QUEUE_TIMEOUT;
+  }
+  if (closed_) {
+    return CPU_QUEUE_CLOSED;
+  }
+  queue_.emplace_back(std::move(data));
+  not_empty_cond_.notify_one();
+  return CPU_QUEUE_SUCCESS;
+}
+
+CpuQueueStatus CpuQueue::Pop(std::vector<DataItemCpu> *data, unsigned int timeout_in_ms) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!not_empty_cond_.wait_for(lock, std::chrono::milliseconds(timeout_in_ms),
+                                [this] { return closed_ || !queue_.empty(); })) {
+    return CPU_QUEUE_TIMEOUT;
+  }
+  if (queue_.empty()) {
+    return CPU_QUEUE_CLOSED;
+  }
+  *data = std::move(queue_.front());
+  queue_.pop_front();
+  not_full_cond_.notify_one();
+  return CPU_QUEUE_SUCCESS;
+}
+
+void CpuQueue::Close() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  closed_ = true;
+  not_full_cond_.notify_all();
+  not_empty_cond_.notify_all();
+}
+
+size_t CpuQueue::Size() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return queue_.size();
+}
+
+CpuBufferMgr &CpuBufferMgr::GetInstance() noexcept {
+  static CpuBufferMgr instance;
+  return instance;
+}
+
+CpuQueueStatus CpuBufferMgr::Open(const std::string &channel_name, size_t capacity) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  // A channel left over from a finished run is replaced, so its queued batches are dropped
+  name_queue_map_[channel_name] = std::make_shared<CpuQueue>(capacity == 0 ? kDefaultCapacity : capacity);
+  return CPU_QUEUE_SUCCESS;
+}
+
+std::shared_ptr<CpuQueue> CpuBufferMgr::GetQueue(const std::string &channel_name) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto iter = name_queue_map_.find(channel_name);
+  if (iter == name_queue_map_.end()) {
+    return nullptr;
+  }
+  return iter->second;
+}
+
+CpuQueueStatus CpuBufferMgr::Push(const std::string &channel_name, std::vector<DataItemCpu> &&data,
+                                  unsigned int timeout_in_ms) {
+  auto queue = GetQueue(channel_name);
+  if (queue == nullptr) {
+    return CPU_QUEUE_NOT_EXIST;
+  }
+  return queue->Push(std::move(data), timeout_in_ms);
+}
+
+CpuQueueStatus CpuBufferMgr::Pop(const std::string &channel_name, std::vector<DataItemCpu> *data,
+                                 unsigned int timeout_in_ms) {
+  auto queue = GetQueue(channel_name);
+  if (queue == nullptr) {
+    return CPU_QUEUE_NOT_EXIST;
+  }
+  return queue->Pop(data, timeout_in_ms);
+}
+
+void CpuBufferMgr::Close(const std::string &channel_name) {
+  auto queue = GetQueue(channel_name);
+  if (queue != nullptr) {
+    queue->Close();
+  }
+}
+
+bool CpuBufferMgr::IsOpen(const std::string &channel_name) { return GetQueue(channel_name) != nullptr; }
+
+size_t CpuBufferMgr::Size(const std::string &channel_name) {
+  auto queue = GetQueue(channel_name);
+  return queue == nullptr ? 0 : queue->Size();
+}
+
+void CpuBufferMgr::Destroy() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (auto &item : name_queue_map_) {
+    item.second->Close();
+  }
+  name_queue_map_.clear();
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_BUFFER_MGR_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_BUFFER_MGR_H_
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define EXPORT __attribute__((visibility("default")))
+
+namespace mindspore {
+namespace device {
+enum CpuQueueStatus : int { CPU_QUEUE_SUCCESS = 0, CPU_QUEUE_NOT_EXIST, CPU_QUEUE_TIMEOUT, CPU_QUEUE_CLOSED };
+
+// One column of a batch. The data is not copied: holder_ keeps the buffer of the producer alive until the
+// consumer drops the item.
+struct DataItemCpu {
+  void *data_ptr_;
+  size_t data_len_;
+  std::vector<int> shape_;
+  std::shared_ptr<void> holder_;
+};
+
+// A bounded queue of batches between one producer and one consumer. Once closed, Push fails and Pop drains
+// what is left before failing.
+class CpuQueue {
+ public:
+  explicit CpuQueue(size_t capacity) : capacity_(capacity), closed_(false) {}
+  ~CpuQueue() = default;
+
+  CpuQueueStatus Push(std::vector<DataItemCpu> &&data, unsigned int timeout_in_ms);
+  CpuQueueStatus Pop(std::vector<DataItemCpu> *data, unsigned int timeout_in_ms);
+  void Close();
+  size_t Size();
+  size_t capacity() const { return capacity_; }
+
+ private:
+  size_t capacity_;
+  bool closed_;
+  std::mutex mutex_;
+  std::condition_variable not_full_cond_;
+  std::condition_variable not_empty_cond_;
+  std::deque<std::vector<DataItemCpu>> queue_;
+
+  CpuQueue(const CpuQueue &) = delete;
+  CpuQueue &operator=(const CpuQueue &) = delete;
+};
+
+// Named queues which hand batches of the dataset CPU sink to the CPU session without copying them.
+// The dataset side opens a channel and pushes, the training side pops by the same channel name.
+class CpuBufferMgr {
+ public:
+  // Two batches in flight: one being consumed by the session while the next one is filled.
+  static constexpr size_t kDefaultCapacity = 2;
+
+  EXPORT static CpuBufferMgr &GetInstance() noexcept;
+
+  // call for Push thread, replaces the channel of the same name left from an earlier run
+  EXPORT CpuQueueStatus Open(const std::string &channel_name, size_t capacity = kDefaultCapacity);
+
+  EXPORT CpuQueueStatus Push(const std::string &channel_name, std::vector<DataItemCpu> &&data,
+                             unsigned int timeout_in_ms);
+  EXPORT CpuQueueStatus Pop(const std::string &channel_name, std::vector<DataItemCpu> *data,
+                            unsigned int timeout_in_ms);
+
+  // No more batches will be pushed; the consumer still gets the queued ones
+  EXPORT void Close(const std::string &channel_name);
+
+  EXPORT bool IsOpen(const std::string &channel_name);
+
+  EXPORT size_t Size(const std::string &channel_name);
+
+  // Close all channels and drop the queued batches
+  EXPORT void Destroy();
+
+ private:
+  CpuBufferMgr() = default;
+  ~CpuBufferMgr() = default;
+
+  std::shared_ptr<CpuQueue> GetQueue(const std::string &channel_name);
+
+  std::mutex mutex_;
+  std::map<std::string, std::shared_ptr<CpuQueue>> name_queue_map_;
+
+  CpuBufferMgr(const CpuBufferMgr &) = delete;
+  CpuBufferMgr &operator=(const CpuBufferMgr &) = delete;
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_BUFFER_MGR_H_
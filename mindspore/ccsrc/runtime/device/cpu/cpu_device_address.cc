@@ -40,6 +40,8 @@ bool CPUDeviceAddress::SyncDeviceToHost(const std::vector<int> & /*shape*/, size
     }
   } else if (type == kNumberTypeFloat16) {
     FloatToHalf(host_ptr, ptr_, size / 2);
+  } else if (type == kNumberTypeFloat32 && type_id_ == kNumberTypeFloat16) {
+    HalfToFloat(host_ptr, ptr_, size / sizeof(float));
   } else if (type == kNumberTypeFloat64) {
     FloatToDouble(host_ptr, ptr_, size / sizeof(double));
   } else {
@@ -52,8 +54,16 @@ bool CPUDeviceAddress::SyncDeviceToHost(const std::vector<int> & /*shape*/, size
 
 bool CPUDeviceAddress::SyncHostToDevice(const std::vector<int> & /*shape*/, size_t size, TypeId type,
                                         const void *host_ptr) const {
-  if (type == kNumberTypeFloat16) {
+  if (type == type_id_) {
+    auto ret_code = memcpy_s(ptr_, size_, host_ptr, size);
+    if (ret_code != EOK) {
+      MS_LOG(ERROR) << "Failed to copy tensor!";
+      return false;
+    }
+  } else if (type == kNumberTypeFloat16) {
     HalfToFloat(ptr_, host_ptr, size / 2);
+  } else if (type == kNumberTypeFloat32 && type_id_ == kNumberTypeFloat16) {
+    FloatToHalf(ptr_, host_ptr, size / sizeof(float));
   } else if (type == kNumberTypeFloat64) {
     DoubleToFloat(ptr_, host_ptr, size / sizeof(double));
   }
@@ -24,6 +24,7 @@
 #include <set>
 #include "backend/kernel_compiler/kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
+#include "runtime/device/kernel_info.h"
 #include "utils/context/ms_context.h"
 #include "utils/config_manager.h"
 #include "utils/profile.h"
@@ -51,6 +52,30 @@ TypeId GetCPUSupportOutputTypeId(const TypeId type_id) {
   }
   return support_type_id;
 }
+
+size_t GetTypeSize(TypeId type_id) {
+  size_t type_size = GetTypeByte(TypeIdToType(type_id));
+  return type_size == 0 ? sizeof(float) : type_size;
+}
+
+// the dtype kernel selection gave a graph input, an input no kernel has claimed stays float32
+TypeId GetInputDeviceDataType(const AnfNodePtr &node) {
+  auto kernel_info = dynamic_cast<device::KernelInfo *>(node->kernel_info());
+  if (kernel_info == nullptr || kernel_info->select_kernel_build_info() == nullptr) {
+    return kNumberTypeFloat32;
+  }
+  auto type_id = AnfAlgo::GetOutputDeviceDataType(node, 0);
+  return type_id == kTypeUnknown ? kNumberTypeFloat32 : type_id;
+}
+
+// float32 and int32 host data has always been used in place, half precision data is used in place when the kernels
+// taking it run in half precision
+bool CanUseHostData(TypeId host_type, TypeId device_type) {
+  if (host_type == device_type) {
+    return true;
+  }
+  return device_type != kNumberTypeFloat16 && (host_type == kNumberTypeFloat32 || host_type == kNumberTypeInt32);
+}
 }  // namespace
 
 void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
@@ -63,7 +88,6 @@ void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
 
 void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
-  size_t type_size = sizeof(float);
   for (auto &item_node : kernel_graph->graph_value_nodes()) {
     MS_EXCEPTION_IF_NULL(item_node);
     if (item_node->isa<ValueNode>()) {
@@ -76,11 +100,13 @@ void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph
       }
       auto tensor = node_value->cast<TensorPtr>();
       MS_EXCEPTION_IF_NULL(tensor);
+      TypeId device_type = GetInputDeviceDataType(value_node);
       std::vector<int> data_shape = tensor->shape();
-      size_t tensor_size = std::accumulate(data_shape.begin(), data_shape.end(), type_size, std::multiplies<size_t>());
-      DeviceAddressPtr address = CreateDeviceAddress(nullptr, tensor_size, kOpFormat_DEFAULT, kNumberTypeFloat32);
+      size_t tensor_size =
+        std::accumulate(data_shape.begin(), data_shape.end(), GetTypeSize(device_type), std::multiplies<size_t>());
+      DeviceAddressPtr address = CreateDeviceAddress(nullptr, tensor_size, kOpFormat_DEFAULT, device_type);
       MS_EXCEPTION_IF_NULL(address);
-      if (tensor->data_type() == kNumberTypeFloat32 || tensor->data_type() == kNumberTypeInt32) {
+      if (CanUseHostData(tensor->data_type(), device_type)) {
         address->ptr_ = tensor->data_c();
       } else {
         address->ptr_ = resource_manager_.MemMalloc(tensor_size);
@@ -97,13 +123,13 @@ void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph
 
 void CPUKernelRuntime::AssignInputNodeAddress(const session::KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
-  size_t type_size = sizeof(float);
   for (auto &item : kernel_graph->inputs()) {
     MS_EXCEPTION_IF_NULL(item);
     if (item->isa<Parameter>()) {
       auto output_num = AnfAlgo::GetOutputTensorNum(item);
       for (size_t index = 0; index < output_num; index++) {
         TypeId output_type_id = AnfAlgo::GetOutputDeviceDataType(item, index);
+        size_t type_size = GetTypeSize(output_type_id);
         std::vector<size_t> fmt_shape = AnfAlgo::GetOutputDeviceShape(item, index);
         size_t tensor_size =
           fmt_shape.empty() ? type_size
@@ -158,7 +184,9 @@ tensor::TensorPtr CPUKernelRuntime::CreatTensorForOutput(const CNodePtr &node, s
   std::vector<int> temp_shape;
   (void)temp_shape.insert(temp_shape.end(), shape.begin(), shape.end());
   TypeId type_id = AnfAlgo::GetOutputInferDataType(node, index);
-  type_id = GetCPUSupportOutputTypeId(type_id);
+  if (type_id != kNumberTypeFloat16 || address->type_id() != kNumberTypeFloat16) {
+    type_id = GetCPUSupportOutputTypeId(type_id);
+  }
   tensor::TensorPtr tensor = std::make_shared<tensor::Tensor>(type_id, temp_shape);
   MS_EXCEPTION_IF_NULL(tensor);
   if (bound_addresses->find(address) != bound_addresses->end()) {
@@ -227,9 +255,9 @@ void CPUKernelRuntime::BindInputOutput(const session::KernelGraph *kernel_graph,
         (void)tensor->data_sync();
       }
       std::vector<int> data_shape = tensor->shape();
-      size_t tensor_size =
-        std::accumulate(data_shape.begin(), data_shape.end(), sizeof(float), std::multiplies<size_t>());
-      if (tensor->data_type() == kNumberTypeFloat32 || tensor->data_type() == kNumberTypeInt32) {
+      size_t tensor_size = std::accumulate(data_shape.begin(), data_shape.end(), GetTypeSize(address->type_id()),
+                                           std::multiplies<size_t>());
+      if (CanUseHostData(tensor->data_type(), address->type_id())) {
         address->ptr_ = tensor->data_c();
       } else {
         address->ptr_ = resource_manager_.MemMalloc(tensor_size);
@@ -260,7 +288,10 @@ void CPUKernelRuntime::AddRuntimeAddress(DeviceAddress *address, std::vector<ker
   kernel::AddressPtr input = std::make_shared<kernel::Address>();
   MS_EXCEPTION_IF_NULL(input);
   if (address->ptr_ == nullptr) {
-    address->ptr_ = resource_manager_.MemMalloc(address->size_);
+    std::lock_guard<std::mutex> lock(malloc_mutex_);
+    if (address->ptr_ == nullptr) {
+      address->ptr_ = resource_manager_.MemMalloc(address->size_);
+    }
   }
   MS_EXCEPTION_IF_NULL(address->ptr_);
   input->addr = address->ptr_;
@@ -276,46 +307,57 @@ void CPUKernelRuntime::DecreaseSummaryRefCount(const session::NamedSummaryOutput
   resource_manager_.DecreaseSummaryRefCount(summary_outputs);
 }
 
+bool CPUKernelRuntime::LaunchKernel(const CNodePtr &kernel) {
+  MS_EXCEPTION_IF_NULL(kernel);
+#ifdef ENABLE_PROFILE
+  double start_time = GetTime();
+#endif
+  std::vector<kernel::AddressPtr> kernel_inputs;
+  std::vector<kernel::AddressPtr> kernel_workspaces;
+  std::vector<kernel::AddressPtr> kernel_outputs;
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+  for (size_t i = 0; i < input_num; ++i) {
+    auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &kernel_inputs);
+  }
+  size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+  for (size_t i = 0; i < output_num; ++i) {
+    auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &kernel_outputs);
+  }
+  auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+  MS_EXCEPTION_IF_NULL(kernel_mod);
+  for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+    auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &kernel_workspaces);
+  }
+  auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+  resource_manager_.DecreaseAddressRefCount(kernel);
+#ifdef ENABLE_PROFILE
+  double cost_time = GetTime() - start_time;
+  MS_LOG(INFO) << "cpu kernel: " << kernel->fullname_with_scope() << "  costs " << cost_time * 1e6 << " us";
+#endif
+  return ret;
+}
+
 bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   resource_manager_.IncreaseAddressRefCount(kernel_graph);
 
   auto kernels = kernel_graph->execution_order();
+  // the dynamic malloc fallback frees addresses by ref count, which is only safe in execution order
+  if (scheduler_.enable_parallel() && !resource_manager_.dynamic_malloc()) {
+    scheduler_.Run(kernel_graph, kernels, resource_manager_.GetMemReuseDependency(kernel_graph),
+                   [this](const CNodePtr &kernel) { return LaunchKernel(kernel); });
+    return true;
+  }
   for (const auto &kernel : kernels) {
-#ifdef ENABLE_PROFILE
-    double start_time = GetTime();
-#endif
-    std::vector<kernel::AddressPtr> kernel_inputs;
-    std::vector<kernel::AddressPtr> kernel_workspaces;
-    std::vector<kernel::AddressPtr> kernel_outputs;
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_inputs);
-    }
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_outputs);
-    }
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_workspaces);
-    }
-    auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
-    resource_manager_.DecreaseAddressRefCount(kernel);
-    if (!ret) {
+    if (!LaunchKernel(kernel)) {
       MS_LOG(EXCEPTION) << "Launch kernel failed.";
     }
-#ifdef ENABLE_PROFILE
-    double cost_time = GetTime() - start_time;
-    MS_LOG(INFO) << "cpu kernel: " << kernel->fullname_with_scope() << "  costs " << cost_time * 1e6 << " us";
-#endif
   }
   return true;
 }
@@ -21,10 +21,12 @@
 #include <string>
 #include <unordered_map>
 #include <set>
+#include <mutex>
 #include "runtime/device/kernel_runtime.h"
 #include "backend/session/kernel_graph.h"
 #include "backend/session/session_basic.h"
 #include "runtime/device/cpu/cpu_resource_manager.h"
+#include "runtime/device/cpu/cpu_kernel_scheduler.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "utils/any.h"
 namespace mindspore {
@@ -61,7 +63,10 @@ class CPUKernelRuntime : public KernelRuntime {
   void AssignInputNodeAddress(const session::KernelGraph *kernel_graph);
   void AssignKernelOutputAddress(const session::KernelGraph *kernel_graph);
   void AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list);
+  bool LaunchKernel(const CNodePtr &kernel);
   CPUResourceManager resource_manager_;
+  CPUKernelScheduler scheduler_;
+  std::mutex malloc_mutex_;
 };
 }  // namespace cpu
 }  // namespace device
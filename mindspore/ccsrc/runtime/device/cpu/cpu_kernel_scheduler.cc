@@ -0,0 +1,273 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "runtime/device/cpu/cpu_kernel_scheduler.h"
+#include <algorithm>
+#include <set>
+#include <string>
+#include "backend/session/anf_runtime_algorithm.h"
+#include "common/utils.h"
+#include "ir/primitive_py.h"
+#include "ir/signature.h"
+#include "utils/convert_utils_base.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr auto kLaunchThreadNumEnv = "MS_CPU_LAUNCH_THREAD_NUM";
+constexpr auto kLaunchDeterministicEnv = "MS_CPU_LAUNCH_DETERMINISTIC";
+
+size_t GetLaunchThreadNum() {
+  auto thread_num_str = common::GetEnv(kLaunchThreadNumEnv);
+  if (thread_num_str.empty()) {
+    return 1;
+  }
+  int thread_num = 1;
+  try {
+    thread_num = std::stoi(thread_num_str);
+  } catch (const std::exception &) {
+    MS_LOG(WARNING) << "Invalid " << kLaunchThreadNumEnv << ": " << thread_num_str << ", launch kernels serially.";
+    return 1;
+  }
+  if (thread_num <= 0) {
+    thread_num = SizeToInt(std::thread::hardware_concurrency());
+  }
+  return thread_num > 1 ? IntToSize(thread_num) : 1;
+}
+
+// kernels whose signature marks a parameter input as written update that parameter in place
+bool WritesParameterInput(const CNodePtr &kernel) {
+  auto prim = dyn_cast<PrimitivePy>(AnfAlgo::GetCNodePrimitive(kernel));
+  if (prim == nullptr) {
+    return false;
+  }
+  const auto &signatures = prim->signatures();
+  size_t input_num = std::min(signatures.size(), AnfAlgo::GetInputTensorNum(kernel));
+  for (size_t i = 0; i < input_num; ++i) {
+    if (signatures[i].rw != SignatureEnumRW::kRWWrite) {
+      continue;
+    }
+    auto input = AnfAlgo::VisitKernelWithReturnType(AnfAlgo::GetInputNode(kernel, i), 0).first;
+    MS_EXCEPTION_IF_NULL(input);
+    if (input->isa<Parameter>()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// kernels that talk to other processes or update parameters in place keep their order against all other kernels
+bool IsSerialKernel(const CNodePtr &kernel) {
+  if (AnfAlgo::IsCommunicationOp(kernel)) {
+    return true;
+  }
+  // the parameter server ops exchange parameters with the servers
+  auto kernel_name = AnfAlgo::GetCNodeName(kernel);
+  if (kernel_name == kPushOpName || kernel_name == kPullOpName || kernel_name == kEmbeddingLookupProxyOpName) {
+    return true;
+  }
+  return WritesParameterInput(kernel);
+}
+
+void CollectPrevKernels(const CNodePtr &node, const std::unordered_map<const AnfNode *, size_t> &kernel_index,
+                        std::set<const AnfNode *> *visited, std::set<size_t> *prev_kernels) {
+  MS_EXCEPTION_IF_NULL(node);
+  for (size_t i = 1; i < node->inputs().size(); ++i) {
+    auto input = node->input(i);
+    MS_EXCEPTION_IF_NULL(input);
+    if (!input->isa<CNode>() || !visited->insert(input.get()).second) {
+      continue;
+    }
+    auto iter = kernel_index.find(input.get());
+    if (iter != kernel_index.end()) {
+      (void)prev_kernels->insert(iter->second);
+      continue;
+    }
+    // walk through the virtual nodes such as TupleGetItem, MakeTuple and Depend
+    CollectPrevKernels(input->cast<CNodePtr>(), kernel_index, visited, prev_kernels);
+  }
+}
+}  // namespace
+
+CPUKernelScheduler::CPUKernelScheduler() {
+  thread_num_ = GetLaunchThreadNum();
+  deterministic_ = common::GetEnv(kLaunchDeterministicEnv) == "1";
+  if (!enable_parallel()) {
+    return;
+  }
+  MS_LOG(INFO) << "Launch cpu kernels with " << thread_num_ << " threads";
+  // the calling thread launches kernels too
+  for (size_t i = 1; i < thread_num_; ++i) {
+    workers_.emplace_back(&CPUKernelScheduler::WorkerLoop, this);
+  }
+}
+
+CPUKernelScheduler::~CPUKernelScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+const KernelLaunchGraph &CPUKernelScheduler::GetLaunchGraph(
+  const session::KernelGraph *graph, const std::vector<CNodePtr> &kernels,
+  const std::vector<MemReuseDependency> &mem_reuse_dependency) {
+  auto &launch_graph = launch_graphs_[graph];
+  if (launch_graph.kernels == kernels) {
+    return launch_graph;
+  }
+  size_t kernel_num = kernels.size();
+  std::unordered_map<const AnfNode *, size_t> kernel_index;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    kernel_index[kernels[i].get()] = i;
+  }
+
+  std::vector<std::set<size_t>> prev_kernels(kernel_num);
+  size_t last_serial = kernel_num;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    std::set<const AnfNode *> visited;
+    CollectPrevKernels(kernels[i], kernel_index, &visited, &prev_kernels[i]);
+    if (IsSerialKernel(kernels[i])) {
+      size_t begin = last_serial == kernel_num ? 0 : last_serial;
+      for (size_t j = begin; j < i; ++j) {
+        (void)prev_kernels[i].insert(j);
+      }
+      last_serial = i;
+    } else if (last_serial != kernel_num) {
+      (void)prev_kernels[i].insert(last_serial);
+    }
+  }
+  for (const auto &dependency : mem_reuse_dependency) {
+    auto prev_iter = kernel_index.find(dependency.first);
+    auto next_iter = kernel_index.find(dependency.second);
+    if (prev_iter == kernel_index.end() || next_iter == kernel_index.end()) {
+      MS_LOG(EXCEPTION) << "The memory plan does not match the execution order of graph " << graph->graph_id();
+    }
+    (void)prev_kernels[next_iter->second].insert(prev_iter->second);
+  }
+
+  launch_graph.kernels = kernels;
+  launch_graph.successors.assign(kernel_num, {});
+  launch_graph.dependency_num.assign(kernel_num, 0);
+  for (size_t i = 0; i < kernel_num; ++i) {
+    for (auto prev : prev_kernels[i]) {
+      // only edges pointing forward in execution order are kept, so the launch graph can never deadlock
+      if (prev >= i) {
+        MS_LOG(WARNING) << "Ignore backward dependency from " << kernels[prev]->fullname_with_scope() << " to "
+                        << kernels[i]->fullname_with_scope();
+        continue;
+      }
+      launch_graph.successors[prev].push_back(i);
+      launch_graph.dependency_num[i]++;
+    }
+  }
+  return launch_graph;
+}
+
+void CPUKernelScheduler::LaunchReadyKernel(size_t kernel_index) {
+  MS_EXCEPTION_IF_NULL(running_graph_);
+  MS_EXCEPTION_IF_NULL(launch_func_);
+  // after a failure the remaining kernels are only drained, so that Run can return
+  if (!failed_) {
+    try {
+      if (!(*launch_func_)(running_graph_->kernels[kernel_index])) {
+        MS_LOG(EXCEPTION) << "Launch kernel failed: " << running_graph_->kernels[kernel_index]->fullname_with_scope();
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (error_ == nullptr) {
+        error_ = std::current_exception();
+      }
+      failed_ = true;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto next : running_graph_->successors[kernel_index]) {
+      if (--pending_dependency_[next] == 0) {
+        ready_kernels_.push_back(next);
+      }
+    }
+    finished_num_++;
+  }
+  cond_.notify_all();
+}
+
+void CPUKernelScheduler::WorkerLoop() {
+  while (true) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return stop_ || !ready_kernels_.empty(); });
+    if (stop_) {
+      return;
+    }
+    size_t kernel_index = ready_kernels_.front();
+    ready_kernels_.pop_front();
+    lock.unlock();
+    LaunchReadyKernel(kernel_index);
+  }
+}
+
+void CPUKernelScheduler::Run(const session::KernelGraph *graph, const std::vector<CNodePtr> &kernels,
+                             const std::vector<MemReuseDependency> &mem_reuse_dependency,
+                             const KernelLaunchFunc &launch_func) {
+  MS_EXCEPTION_IF_NULL(graph);
+  const auto &launch_graph = GetLaunchGraph(graph, kernels, mem_reuse_dependency);
+  size_t kernel_num = launch_graph.kernels.size();
+  std::unique_lock<std::mutex> lock(mutex_);
+  running_graph_ = &launch_graph;
+  launch_func_ = &launch_func;
+  pending_dependency_ = launch_graph.dependency_num;
+  finished_num_ = 0;
+  error_ = nullptr;
+  failed_ = false;
+  ready_kernels_.clear();
+  for (size_t i = 0; i < kernel_num; ++i) {
+    if (pending_dependency_[i] == 0) {
+      ready_kernels_.push_back(i);
+    }
+  }
+  cond_.notify_all();
+
+  while (finished_num_ < kernel_num) {
+    if (ready_kernels_.empty()) {
+      cond_.wait(lock);
+      continue;
+    }
+    size_t kernel_index = ready_kernels_.front();
+    ready_kernels_.pop_front();
+    lock.unlock();
+    LaunchReadyKernel(kernel_index);
+    lock.lock();
+  }
+  running_graph_ = nullptr;
+  launch_func_ = nullptr;
+  if (error_ != nullptr) {
+    auto error = error_;
+    error_ = nullptr;
+    lock.unlock();
+    std::rethrow_exception(error);
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
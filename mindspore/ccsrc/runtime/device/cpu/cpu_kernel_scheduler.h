@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_CPU_KERNEL_SCHEDULER_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_CPU_KERNEL_SCHEDULER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "backend/session/kernel_graph.h"
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The dependency graph of the kernels in one execution order.
+struct KernelLaunchGraph {
+  std::vector<CNodePtr> kernels;
+  std::vector<std::vector<size_t>> successors;
+  std::vector<size_t> dependency_num;
+};
+
+using KernelLaunchFunc = std::function<bool(const CNodePtr &)>;
+
+// Dispatches ready kernels of a graph to a persistent worker pool, so independent branches run at the same time.
+// Set MS_CPU_LAUNCH_THREAD_NUM to the number of launching threads, and MS_CPU_LAUNCH_DETERMINISTIC=1 to launch
+// the kernels one by one in execution order for debugging.
+class CPUKernelScheduler {
+ public:
+  CPUKernelScheduler();
+  ~CPUKernelScheduler();
+
+  bool enable_parallel() const { return thread_num_ > 1 && !deterministic_; }
+  void Run(const session::KernelGraph *graph, const std::vector<CNodePtr> &kernels,
+           const std::vector<MemReuseDependency> &mem_reuse_dependency, const KernelLaunchFunc &launch_func);
+
+ private:
+  const KernelLaunchGraph &GetLaunchGraph(const session::KernelGraph *graph, const std::vector<CNodePtr> &kernels,
+                                          const std::vector<MemReuseDependency> &mem_reuse_dependency);
+  void WorkerLoop();
+  void LaunchReadyKernel(size_t kernel_index);
+
+  size_t thread_num_{1};
+  bool deterministic_{false};
+  std::vector<std::thread> workers_;
+  std::unordered_map<const session::KernelGraph *, KernelLaunchGraph> launch_graphs_;
+
+  // state of the graph being run, guarded by mutex_
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<size_t> ready_kernels_;
+  std::vector<size_t> pending_dependency_;
+  const KernelLaunchGraph *running_graph_{nullptr};
+  const KernelLaunchFunc *launch_func_{nullptr};
+  size_t finished_num_{0};
+  std::exception_ptr error_{nullptr};
+  std::atomic<bool> failed_{false};
+  bool stop_{false};
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_CPU_KERNEL_SCHEDULER_H_
@@ -38,6 +38,10 @@ class CPUResourceManager {
   void MemFree(void *ptr);
   void IncreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
+  bool dynamic_malloc() const { return dynamic_malloc_; }
+  const std::vector<MemReuseDependency> &GetMemReuseDependency(const session::KernelGraph *graph) const {
+    return mem_plan_.GetMemReuseDependency(graph);
+  }
 
  private:
   void MemFree();
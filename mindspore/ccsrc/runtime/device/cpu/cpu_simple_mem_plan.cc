@@ -14,16 +14,96 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include <algorithm>
+#include <limits>
 #include "backend/session/anf_runtime_algorithm.h"
+#include "frontend/operator/ops.h"
+#include "utils/context/ms_context.h"
+#include "utils/graph_utils.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-void CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+namespace {
+constexpr size_t kMemAlignSize = 64;
+constexpr size_t kSummaryGetItem = 2;
+
+size_t AlignMemSize(size_t size) { return (size + kMemAlignSize - 1) / kMemAlignSize * kMemAlignSize; }
+
+bool IsLifeOverlap(const MemBlockLife &a, const MemBlockLife &b) {
+  return a.first_use <= b.last_use && b.first_use <= a.last_use;
+}
+
+void UpdateMemBlockLife(DeviceAddress *address, size_t pos, std::unordered_map<DeviceAddress *, size_t> *block_index,
+                        std::vector<MemBlockLife> *blocks) {
+  MS_EXCEPTION_IF_NULL(address);
+  if (address->ptr_ != nullptr) {
+    return;
+  }
+  auto iter = block_index->find(address);
+  if (iter != block_index->end()) {
+    auto &block = (*blocks)[iter->second];
+    block.last_use = pos;
+    if (block.users.back() != pos) {
+      block.users.push_back(pos);
+    }
+    return;
+  }
+  MemBlockLife block;
+  block.address = address;
+  block.size = address->size_;
+  block.first_use = pos;
+  block.last_use = pos;
+  block.users.push_back(pos);
+  (*block_index)[address] = blocks->size();
+  blocks->push_back(block);
+}
+}  // namespace
+
+std::set<DeviceAddress *> CPUSimpleMemPlan::GetPinnedAddresses(const session::KernelGraph *graph) const {
   MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 0;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  std::vector<session::KernelWithIndex> pinned_items;
+  // graph outputs are read by the session after the whole graph has run
+  for (const auto &output : graph->outputs()) {
+    for (const auto &node : AnfAlgo::GetAllOutput(output, {prim::kPrimTupleGetItem})) {
+      pinned_items.emplace_back(AnfAlgo::VisitKernelWithReturnType(node, 0, true));
+    }
+  }
+  // summary inputs are read by the summary callback after the whole graph has run
+  if (graph->summary_node_exist()) {
+    for (const auto &node : TopoSort(graph->get_return())) {
+      if (IsPrimitiveCNode(node, prim::kPrimScalarSummary) || IsPrimitiveCNode(node, prim::kPrimTensorSummary) ||
+          IsPrimitiveCNode(node, prim::kPrimImageSummary) || IsPrimitiveCNode(node, prim::kPrimHistogramSummary)) {
+        auto cnode = node->cast<CNodePtr>();
+        MS_EXCEPTION_IF_NULL(cnode);
+        if (cnode->inputs().size() <= kSummaryGetItem) {
+          continue;
+        }
+        pinned_items.emplace_back(AnfAlgo::VisitKernelWithReturnType(cnode->input(kSummaryGetItem), 0, true));
+      }
+    }
+  }
+
+  std::set<DeviceAddress *> pinned_addresses;
+  for (const auto &item : pinned_items) {
+    if (item.first == nullptr || !item.first->isa<CNode>() || !AnfAlgo::IsRealKernel(item.first)) {
+      continue;
+    }
+    if (!AnfAlgo::OutputAddrExist(item.first, item.second)) {
+      continue;
+    }
+    (void)pinned_addresses.insert(AnfAlgo::GetMutableOutputAddr(item.first, item.second, true).get());
+  }
+  return pinned_addresses;
+}
+
+void CPUSimpleMemPlan::CollectMemBlocks(const session::KernelGraph *graph, const std::vector<CNodePtr> &kernels,
+                                        std::vector<MemBlockLife> *blocks) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(blocks);
+  std::unordered_map<DeviceAddress *, size_t> block_index;
+  for (size_t pos = 0; pos < kernels.size(); ++pos) {
+    const auto &kernel = kernels[pos];
     MS_EXCEPTION_IF_NULL(kernel);
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
@@ -32,33 +112,150 @@ void CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
       if (kernel_with_index.first->isa<Parameter>()) {
         continue;
       }
-      auto address = AnfAlgo::GetOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
+      UpdateMemBlockLife(address.get(), pos, &block_index, blocks);
     }
 
     size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
     for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
+      UpdateMemBlockLife(address.get(), pos, &block_index, blocks);
     }
 
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
     MS_EXCEPTION_IF_NULL(kernel_mod);
     for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
       auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
+      UpdateMemBlockLife(address, pos, &block_index, blocks);
+    }
+  }
+
+  auto pinned_addresses = GetPinnedAddresses(graph);
+  for (auto &block : *blocks) {
+    if (pinned_addresses.find(block.address) != pinned_addresses.end()) {
+      block.last_use = kernels.size();
+    }
+  }
+}
+
+size_t CPUSimpleMemPlan::AssignOffsetSequential(std::vector<MemBlockLife> *blocks) const {
+  MS_EXCEPTION_IF_NULL(blocks);
+  size_t total_mem_size = 0;
+  for (auto &block : *blocks) {
+    block.offset = total_mem_size;
+    total_mem_size += block.size;
+  }
+  return total_mem_size;
+}
+
+size_t CPUSimpleMemPlan::AssignOffsetBestFit(std::vector<MemBlockLife> *blocks) const {
+  MS_EXCEPTION_IF_NULL(blocks);
+  // place the largest blocks first, each into the smallest gap left by the placed blocks it is alive with
+  std::vector<size_t> order(blocks->size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [blocks](size_t a, size_t b) { return (*blocks)[a].size > (*blocks)[b].size; });
+
+  size_t total_mem_size = 0;
+  std::vector<const MemBlockLife *> placed;
+  for (auto index : order) {
+    auto &block = (*blocks)[index];
+    size_t block_size = AlignMemSize(block.size);
+    std::vector<const MemBlockLife *> alive;
+    for (auto other : placed) {
+      if (IsLifeOverlap(block, *other)) {
+        alive.push_back(other);
+      }
+    }
+    std::sort(alive.begin(), alive.end(),
+              [](const MemBlockLife *a, const MemBlockLife *b) { return a->offset < b->offset; });
+
+    size_t best_offset = std::numeric_limits<size_t>::max();
+    size_t best_gap = std::numeric_limits<size_t>::max();
+    size_t gap_start = 0;
+    for (auto other : alive) {
+      if (other->offset >= gap_start) {
+        size_t gap = other->offset - gap_start;
+        if (gap >= block_size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = gap_start;
+        }
       }
+      gap_start = std::max(gap_start, other->offset + AlignMemSize(other->size));
+    }
+    if (best_offset == std::numeric_limits<size_t>::max()) {
+      best_offset = gap_start;
     }
+    block.offset = best_offset;
+    total_mem_size = std::max(total_mem_size, best_offset + block_size);
+    placed.push_back(&block);
+  }
+  return total_mem_size;
+}
+
+void CPUSimpleMemPlan::GenMemReuseDependency(const session::KernelGraph *graph, const std::vector<CNodePtr> &kernels,
+                                             std::vector<MemBlockLife> *blocks) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(blocks);
+  auto &dependency = graph_mem_reuse_dependency_[graph];
+  dependency.clear();
+  std::sort(blocks->begin(), blocks->end(),
+            [](const MemBlockLife &a, const MemBlockLife &b) { return a.offset < b.offset; });
+  std::set<std::pair<size_t, size_t>> dependency_pos;
+  for (size_t i = 0; i < blocks->size(); ++i) {
+    const auto &block = (*blocks)[i];
+    size_t block_end = block.offset + AlignMemSize(block.size);
+    for (size_t j = i + 1; j < blocks->size() && (*blocks)[j].offset < block_end; ++j) {
+      const auto &other = (*blocks)[j];
+      if (other.size == 0 || block.size == 0) {
+        continue;
+      }
+      // every user of the earlier address must be done before the later address is first written
+      const auto &prev = block.last_use < other.first_use ? block : other;
+      const auto &next = block.last_use < other.first_use ? other : block;
+      for (auto user : prev.users) {
+        (void)dependency_pos.emplace(user, next.first_use);
+      }
+    }
+  }
+  for (const auto &pos : dependency_pos) {
+    dependency.emplace_back(kernels[pos.first].get(), kernels[pos.second].get());
+  }
+}
+
+void CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  // plan against the order the runtime really launches in, optimizer kernels are moved to the end
+  auto kernels = graph->execution_order();
+  AnfAlgo::ReorderExecList(NOT_NULL(&kernels));
+  std::vector<MemBlockLife> blocks;
+  CollectMemBlocks(graph, kernels, &blocks);
+
+  size_t naive_mem_size = 0;
+  for (const auto &block : blocks) {
+    naive_mem_size += block.size;
+  }
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  bool enable_mem_reuse = context_ptr->enable_mem_reuse();
+  size_t total_mem_size = enable_mem_reuse ? AssignOffsetBestFit(&blocks) : AssignOffsetSequential(&blocks);
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " cpu mem plan: naive size " << naive_mem_size << ", planned size "
+               << total_mem_size << ", address num " << blocks.size();
+
+  auto &mem_offset = graph_mem_offset_[graph];
+  mem_offset.clear();
+  for (const auto &block : blocks) {
+    mem_offset.emplace_back(block.address, block.offset);
   }
   graph_mem_size_[graph] = total_mem_size;
+  graph_naive_mem_size_[graph] = naive_mem_size;
+  if (enable_mem_reuse) {
+    GenMemReuseDependency(graph, kernels, &blocks);
+  } else {
+    graph_mem_reuse_dependency_[graph].clear();
+  }
 }
 
 size_t CPUSimpleMemPlan::GetGraphMemSize(const session::KernelGraph *graph) const {
@@ -69,47 +266,36 @@ size_t CPUSimpleMemPlan::GetGraphMemSize(const session::KernelGraph *graph) cons
   return 0;
 }
 
+size_t CPUSimpleMemPlan::GetGraphNaiveMemSize(const session::KernelGraph *graph) const {
+  auto iter = graph_naive_mem_size_.find(graph);
+  if (iter != graph_naive_mem_size_.end()) {
+    return iter->second;
+  }
+  return 0;
+}
+
+const std::vector<MemReuseDependency> &CPUSimpleMemPlan::GetMemReuseDependency(
+  const session::KernelGraph *graph) const {
+  static const std::vector<MemReuseDependency> empty_dependency;
+  auto iter = graph_mem_reuse_dependency_.find(graph);
+  if (iter != graph_mem_reuse_dependency_.end()) {
+    return iter->second;
+  }
+  return empty_dependency;
+}
+
 void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(base_ptr);
-  uint8_t *mem_ptr = base_ptr;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
-    MS_EXCEPTION_IF_NULL(kernel);
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto kernel_with_index = AnfAlgo::GetPrevNodeOutput(kernel, i);
-      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
-      if (kernel_with_index.first->isa<Parameter>()) {
-        continue;
-      }
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
-    }
-
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
-    }
-
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+  auto iter = graph_mem_offset_.find(graph);
+  if (iter == graph_mem_offset_.end()) {
+    MS_LOG(EXCEPTION) << "Graph " << graph->graph_id() << " has not been planned before mem assign";
+  }
+  for (const auto &item : iter->second) {
+    auto address = item.first;
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->ptr_ == nullptr) {
+      address->ptr_ = base_ptr + item.second;
     }
   }
 }
@@ -17,13 +17,29 @@
 #define MINDSPORE_CCSRC_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 
 #include <vector>
+#include <set>
 #include <unordered_map>
+#include <utility>
 #include "backend/session/kernel_graph.h"
 #include "runtime/device/device_address.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+// The live range of one address in the graph arena, measured in positions of the execution order.
+struct MemBlockLife {
+  DeviceAddress *address{nullptr};
+  size_t size{0};
+  size_t first_use{0};
+  size_t last_use{0};
+  size_t offset{0};
+  // positions of the kernels that write or read the address
+  std::vector<size_t> users;
+};
+
+// The first kernel must finish before the second one is launched, as their addresses share arena memory.
+using MemReuseDependency = std::pair<const AnfNode *, const AnfNode *>;
+
 class CPUSimpleMemPlan {
  public:
   CPUSimpleMemPlan() = default;
@@ -32,9 +48,23 @@ class CPUSimpleMemPlan {
   void MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
   size_t GetGraphMemSize(const session::KernelGraph *graph) const;
+  // the arena size the graph would need if no address were shared
+  size_t GetGraphNaiveMemSize(const session::KernelGraph *graph) const;
+  const std::vector<MemReuseDependency> &GetMemReuseDependency(const session::KernelGraph *graph) const;
 
  private:
+  void CollectMemBlocks(const session::KernelGraph *graph, const std::vector<CNodePtr> &kernels,
+                        std::vector<MemBlockLife> *blocks) const;
+  void GenMemReuseDependency(const session::KernelGraph *graph, const std::vector<CNodePtr> &kernels,
+                             std::vector<MemBlockLife> *blocks);
+  std::set<DeviceAddress *> GetPinnedAddresses(const session::KernelGraph *graph) const;
+  size_t AssignOffsetSequential(std::vector<MemBlockLife> *blocks) const;
+  size_t AssignOffsetBestFit(std::vector<MemBlockLife> *blocks) const;
+
   std::unordered_map<const session::KernelGraph *, size_t> graph_mem_size_;
+  std::unordered_map<const session::KernelGraph *, size_t> graph_naive_mem_size_;
+  std::unordered_map<const session::KernelGraph *, std::vector<std::pair<DeviceAddress *, size_t>>> graph_mem_offset_;
+  std::unordered_map<const session::KernelGraph *, std::vector<MemReuseDependency>> graph_mem_reuse_dependency_;
 };
 }  // namespace cpu
 }  // namespace device
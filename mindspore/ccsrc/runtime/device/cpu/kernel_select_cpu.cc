@@ -19,8 +19,11 @@
 #include <string>
 #include <memory>
 #include <algorithm>
+#include <unordered_map>
 
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "frontend/operator/ops.h"
+#include "utils/convert_utils_base.h"
 
 namespace mindspore {
 namespace device {
@@ -38,12 +41,15 @@ bool IsInputNotCNode(const CNodePtr &kernel_node, size_t input_index) {
 }
 
 void UpdatePrevNotCNodeFormatDtype(const KernelAttr &kernel_attr, const std::vector<size_t> &input_not_cnode_indexes,
-                                   const CNodePtr kernel_node) {
+                                   const CNodePtr kernel_node, InputDeviceTypes *input_device_types) {
   for (auto &input_index : input_not_cnode_indexes) {
     auto input_node = AnfAlgo::VisitKernel(kernel_node->input(input_index + 1), 0).first;
     MS_EXCEPTION_IF_NULL(input_node);
     std::vector<TypeId> output_types;
     output_types.emplace_back(kernel_attr.GetInputAttr(input_index).first);
+    if (input_device_types != nullptr) {
+      (*input_device_types)[input_node] = output_types[0];
+    }
     auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
     MS_EXCEPTION_IF_NULL(builder);
     builder->SetOutputsFormat({kOpFormat_DEFAULT});
@@ -52,14 +58,24 @@ void UpdatePrevNotCNodeFormatDtype(const KernelAttr &kernel_attr, const std::vec
   }
 }
 
-void GetInputFormatsAndDtypes(const CNodePtr &kernel_node, std::vector<std::string> *input_formats,
-                              std::vector<TypeId> *input_types, std::vector<size_t> *input_no_cnode_indexes) {
+void GetInputFormatsAndDtypes(const CNodePtr &kernel_node, const InputDeviceTypes *input_device_types,
+                              std::vector<std::string> *input_formats, std::vector<TypeId> *input_types,
+                              std::vector<size_t> *input_no_cnode_indexes, std::vector<size_t> *input_pinned_indexes) {
   size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
   for (size_t input_index = 0; input_index < input_num; ++input_index) {
     TypeId dtype = kTypeUnknown;
     if (IsInputNotCNode(kernel_node, input_index)) {
       input_no_cnode_indexes->emplace_back(input_index);
       dtype = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, input_index);
+      // a kernel selected before has fixed the device dtype of the input already
+      if (input_device_types != nullptr) {
+        auto input_node = AnfAlgo::VisitKernel(kernel_node->input(input_index + 1), 0).first;
+        auto iter = input_device_types->find(input_node);
+        if (iter != input_device_types->end()) {
+          input_pinned_indexes->emplace_back(input_index);
+          dtype = iter->second;
+        }
+      }
     } else {
       dtype = AnfAlgo::GetPrevNodeOutputDeviceDataType(kernel_node, input_index);
     }
@@ -78,9 +94,69 @@ void GetOutputFormatsAndDtypes(const CNodePtr &kernel_node, const KernelAttr &ke
   }
 }
 
+bool IsFloatType(TypeId type_id) {
+  return type_id == kNumberTypeFloat16 || type_id == kNumberTypeFloat32 || type_id == kNumberTypeFloat64;
+}
+
+bool HasFloat16Output(const KernelAttr &kernel_attr) {
+  for (size_t i = 0; i < kernel_attr.GetOutputSize(); ++i) {
+    if (kernel_attr.GetOutputAttr(i).first == kNumberTypeFloat16) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// the cpu backend has no cast kernel, so a half precision output is only selected when every user of it takes half
+// precision too, either as a graph output or as a kernel with a half precision registration that can pass it on
+bool CanConsumeFloat16(const AnfNodePtr &node, std::unordered_map<AnfNodePtr, bool> *memo) {
+  MS_EXCEPTION_IF_NULL(node);
+  MS_EXCEPTION_IF_NULL(memo);
+  auto iter = memo->find(node);
+  if (iter != memo->end()) {
+    return iter->second;
+  }
+  auto func_graph = node->func_graph();
+  auto manager = func_graph == nullptr ? nullptr : func_graph->manager();
+  if (manager == nullptr) {
+    return false;
+  }
+  auto users = manager->node_users().find(node);
+  if (users == manager->node_users().end()) {
+    return false;
+  }
+  bool result = true;
+  for (const auto &user : users->second) {
+    auto user_node = user.first;
+    if (IsPrimitiveCNode(user_node, prim::kPrimReturn) || IsPrimitiveCNode(user_node, prim::kPrimMakeTuple) ||
+        IsPrimitiveCNode(user_node, prim::kPrimDepend)) {
+      continue;
+    }
+    if (!user_node->isa<CNode>() || !AnfAlgo::IsRealKernel(user_node)) {
+      result = false;
+      break;
+    }
+    auto kernel_attrs =
+      kernel::CPUKernelFactory::GetInstance().GetSupportedKernelAttrList(AnfAlgo::GetCNodeName(user_node));
+    size_t input_index = IntToSize(user.second - 1);
+    auto takes_float16 = [input_index](const KernelAttr &attr) {
+      size_t index = attr.GetAllSame() ? 0 : input_index;
+      return index < attr.GetInputSize() && attr.GetInputAttr(index).first == kNumberTypeFloat16;
+    };
+    bool has_float16_attr = std::any_of(kernel_attrs.begin(), kernel_attrs.end(), takes_float16);
+    if (!has_float16_attr || !CanConsumeFloat16(user_node, memo)) {
+      result = false;
+      break;
+    }
+  }
+  (*memo)[node] = result;
+  return result;
+}
+
 bool IsInputFormatDtypeMatched(const KernelAttr &kernel_attr, const std::vector<std::string> &input_formats,
                                const std::vector<TypeId> &input_types,
-                               const std::vector<size_t> &input_not_cnode_indexes) {
+                               const std::vector<size_t> &input_not_cnode_indexes,
+                               const std::vector<size_t> &input_pinned_indexes, bool relaxed) {
   if (kernel_attr.GetInputSize() != input_types.size()) {
     MS_LOG(DEBUG) << "required input num:" << kernel_attr.GetInputSize() << ", actual input num:" << input_types.size();
     return false;
@@ -89,11 +165,17 @@ bool IsInputFormatDtypeMatched(const KernelAttr &kernel_attr, const std::vector<
   for (size_t i = 0; i < input_num; ++i) {
     bool is_not_cnode_idx = std::any_of(input_not_cnode_indexes.begin(), input_not_cnode_indexes.end(),
                                         [i](size_t index) { return index == i; });
+    bool is_pinned_idx = std::any_of(input_pinned_indexes.begin(), input_pinned_indexes.end(),
+                                     [i](size_t index) { return index == i; });
     bool have_cnode_input = (input_types.size() != input_not_cnode_indexes.size());
-    if (have_cnode_input && is_not_cnode_idx) {
+    if (have_cnode_input && is_not_cnode_idx && !is_pinned_idx) {
       continue;
     }
-    if (kernel_attr.GetInputAttr(i).first != input_types[i]) {
+    // graph inputs of any float type are converted to the dtype of the kernel when they are bound, unless another
+    // kernel reads them in the dtype they have on the device already
+    bool convertible = relaxed && is_not_cnode_idx && !is_pinned_idx && IsFloatType(input_types[i]) &&
+                       IsFloatType(kernel_attr.GetInputAttr(i).first);
+    if (kernel_attr.GetInputAttr(i).first != input_types[i] && !convertible) {
       MS_LOG(DEBUG) << "required dtype:" << kernel_attr.GetInputAttr(i).first
                     << ", actual input dtype:" << input_types[i];
       return false;
@@ -121,39 +203,76 @@ void ExpandKernelAttr(const CNodePtr &kernel_node, KernelAttr *kernel_attr) {
     kernel_attr->AddOutputAttr(output_dtype);
   }
 }
+
+// exact dtypes are tried first, then float graph inputs may be converted to the dtype of a registration
+bool SelectKernelAttr(const CNodePtr &kernel_node, const std::vector<std::string> &input_formats,
+                      const std::vector<TypeId> &input_types, const std::vector<size_t> &input_not_cnode_indexes,
+                      const std::vector<size_t> &input_pinned_indexes, KernelAttr *selected) {
+  MS_EXCEPTION_IF_NULL(selected);
+  auto kernel_attrs =
+    kernel::CPUKernelFactory::GetInstance().GetSupportedKernelAttrList(AnfAlgo::GetCNodeName(kernel_node));
+  std::unordered_map<AnfNodePtr, bool> float16_memo;
+  for (bool relaxed : {false, true}) {
+    for (size_t index = 0; index < kernel_attrs.size(); ++index) {
+      auto kernel_attr = kernel_attrs[index];
+      if (kernel_attr.GetAllSame()) {
+        ExpandKernelAttr(kernel_node, &kernel_attr);
+      }
+      if (!IsInputFormatDtypeMatched(kernel_attr, input_formats, input_types, input_not_cnode_indexes,
+                                     input_pinned_indexes, relaxed)) {
+        continue;
+      }
+      size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
+      if (kernel_attr.GetOutputSize() != output_num) {
+        MS_LOG(DEBUG) << "Output num is not equal!";
+        continue;
+      }
+      if (HasFloat16Output(kernel_attr) && !CanConsumeFloat16(kernel_node, &float16_memo)) {
+        MS_LOG(DEBUG) << "Users of the node can not take float16, index: " << index;
+        continue;
+      }
+      MS_LOG(INFO) << "Input format and dtype is matched, index: " << index;
+      *selected = kernel_attr;
+      return true;
+    }
+  }
+  return false;
+}
 }  // namespace
 
-void SetKernelInfo(const CNodePtr &kernel_node) {
+void SetKernelInfo(const CNodePtr &kernel_node, InputDeviceTypes *input_device_types) {
   std::vector<std::string> input_formats;
   std::vector<TypeId> input_types;
   std::vector<size_t> input_not_cnode_indexes;
+  std::vector<size_t> input_pinned_indexes;
   std::vector<std::string> output_formats;
   std::vector<TypeId> output_types;
 
   MS_LOG(INFO) << "SetKernelInfo, CNode Name: " << AnfAlgo::GetCNodeName(kernel_node);
-  GetInputFormatsAndDtypes(kernel_node, &input_formats, &input_types, &input_not_cnode_indexes);
+  GetInputFormatsAndDtypes(kernel_node, input_device_types, &input_formats, &input_types, &input_not_cnode_indexes,
+                           &input_pinned_indexes);
 
-  auto kernel_attrs =
-    kernel::CPUKernelFactory::GetInstance().GetSupportedKernelAttrList(AnfAlgo::GetCNodeName(kernel_node));
-
-  for (size_t index = 0; index < kernel_attrs.size(); ++index) {
-    auto kernel_attr = kernel_attrs[index];
-    if (kernel_attr.GetAllSame()) {
-      ExpandKernelAttr(kernel_node, &kernel_attr);
+  KernelAttr kernel_attr;
+  if (SelectKernelAttr(kernel_node, input_formats, input_types, input_not_cnode_indexes, input_pinned_indexes,
+                       &kernel_attr)) {
+    GetOutputFormatsAndDtypes(kernel_node, kernel_attr, &output_formats, &output_types);
+    UpdatePrevNotCNodeFormatDtype(kernel_attr, input_not_cnode_indexes, kernel_node, input_device_types);
+    for (auto &input_index : input_not_cnode_indexes) {
+      input_types[input_index] = kernel_attr.GetInputAttr(input_index).first;
     }
-    if (IsInputFormatDtypeMatched(kernel_attr, input_formats, input_types, input_not_cnode_indexes)) {
-      size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
-      if (kernel_attr.GetOutputSize() != output_num) {
-        MS_LOG(DEBUG) << "Output num is not equal!";
-        continue;
-      }
-      MS_LOG(INFO) << "Input format and dtype is matched, index: " << index;
-      GetOutputFormatsAndDtypes(kernel_node, kernel_attr, &output_formats, &output_types);
-      UpdatePrevNotCNodeFormatDtype(kernel_attr, input_not_cnode_indexes, kernel_node);
-      for (auto &input_index : input_not_cnode_indexes) {
-        input_types[input_index] = kernel_attr.GetInputAttr(input_index).first;
-      }
-      break;
+  } else if (!input_pinned_indexes.empty()) {
+    // there is no cast kernel to hand a graph input to this kernel in another dtype than the one it is bound with
+    std::vector<std::string> unpinned_formats;
+    std::vector<TypeId> unpinned_types;
+    std::vector<size_t> unpinned_not_cnode_indexes;
+    std::vector<size_t> no_pinned_indexes;
+    GetInputFormatsAndDtypes(kernel_node, nullptr, &unpinned_formats, &unpinned_types, &unpinned_not_cnode_indexes,
+                             &no_pinned_indexes);
+    if (SelectKernelAttr(kernel_node, unpinned_formats, unpinned_types, unpinned_not_cnode_indexes, no_pinned_indexes,
+                         &kernel_attr)) {
+      MS_LOG(EXCEPTION) << "The graph inputs of " << kernel_node->DebugString()
+                        << " are read by other kernels in a dtype " << AnfAlgo::GetCNodeName(kernel_node)
+                        << " does not support, and the cpu backend can not cast them";
     }
   }
 
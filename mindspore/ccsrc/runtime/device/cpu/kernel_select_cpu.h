@@ -19,6 +19,7 @@
 
 #include <utility>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ir/anf.h"
@@ -28,7 +29,10 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
-void SetKernelInfo(const CNodePtr &apply_kernel_ptr);
+// Device dtypes given to the parameters and value nodes of a graph by the kernels selected so far. Such an input has
+// one device address, so every kernel reading it must take the same dtype.
+using InputDeviceTypes = std::unordered_map<AnfNodePtr, TypeId>;
+void SetKernelInfo(const CNodePtr &apply_kernel_ptr, InputDeviceTypes *input_device_types = nullptr);
 
 class KernelAttr {
  public:
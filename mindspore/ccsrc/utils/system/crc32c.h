@@ -39,7 +39,7 @@ class Crc32c {
   Crc32c() = default;
   ~Crc32c() = default;
 
-  // Calculate the crc32c value, use the 8 table method
+  // Calculate the crc32c value, with the crc32c instructions of the cpu if it has them, else the 8 table method
   static uint32 MakeCrc32c(uint32 init_crc, const char *data, size_t size);
 
   // retrun the crc32c value(need mask)
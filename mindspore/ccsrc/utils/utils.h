@@ -177,6 +177,7 @@ constexpr auto kPushOpName = "Push";
 constexpr auto kPullOpName = "Pull";
 constexpr auto kEmbeddingLookupOpName = "EmbeddingLookup";
 constexpr auto kEmbeddingLookupProxyOpName = "EmbeddingLookupProxy";
+constexpr auto kCPUFusedElemwiseOpName = "CPUFusedElemwise";
 
 // attr key name
 constexpr auto kAttrInputNames = "input_names";
@@ -240,6 +241,10 @@ constexpr auto kAttrReduceScatterFlag = "reduce_scatter_flag";
 constexpr auto kAttrOffset = "offset";
 constexpr auto kAttrPsKey = "ps_key";
 constexpr auto kAttrOptimizerType = "optim_type";
+constexpr auto kAttrFusedOps = "fused_ops";
+constexpr auto kAttrFusedOperands = "fused_operands";
+constexpr auto kAttrFusedOperandNums = "fused_operand_nums";
+constexpr auto kAttrInputDimOffsets = "input_dim_offsets";
 
 // attr value
 constexpr auto kValueTargetSwitch = "target_switch";
@@ -20,7 +20,9 @@ import numpy
 import mindspore._c_dataengine as cde
 
 __all__ = ['set_seed', 'get_seed', 'set_prefetch_size', 'get_prefetch_size', 'set_num_parallel_workers',
-           'get_num_parallel_workers', 'set_monitor_sampling_interval', 'get_monitor_sampling_interval', 'load']
+           'get_num_parallel_workers', 'set_monitor_sampling_interval', 'get_monitor_sampling_interval',
+           'set_enable_autotune', 'get_enable_autotune', 'set_autotune_cpu_budget', 'get_autotune_cpu_budget',
+           'set_mindrecord_io_mode', 'get_mindrecord_io_mode', 'load']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
@@ -157,6 +159,105 @@ def get_monitor_sampling_interval():
     return _config.get_monitor_sampling_interval()
 
 
+def set_enable_autotune(enable):
+    """
+    Set whether the pipeline tunes itself during the first epoch.
+
+    When enabled, the pipeline watches the queues between its operations during the first epoch, gives more workers
+    to the slowest operation and larger queues to the operations with a bursty output, then logs the configuration
+    it found so it can be set explicitly in later runs. The number of samples and their order are not changed.
+
+    Args:
+        enable (bool): whether to tune the pipeline.
+
+    Raises:
+        TypeError: If enable is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_enable_autotune(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("Enable given is not a boolean.")
+    _config.set_enable_autotune(enable)
+
+
+def get_enable_autotune():
+    """
+    Get whether the pipeline tunes itself during the first epoch.
+
+    Returns:
+        Bool, whether the pipeline is tuned.
+    """
+    return _config.get_enable_autotune()
+
+
+def set_autotune_cpu_budget(cpu_budget):
+    """
+    Set the number of worker threads the tuning may spread among the operations of a pipeline.
+
+    Args:
+        cpu_budget (int): number of worker threads, 0 for the number of cores of the machine.
+
+    Raises:
+        ValueError: If cpu_budget is invalid (< 0 or > MAX_INT_32).
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_autotune_cpu_budget(16)
+    """
+    if cpu_budget < 0 or cpu_budget > INT32_MAX:
+        raise ValueError("Cpu budget given is not within the required range.")
+    _config.set_autotune_cpu_budget(cpu_budget)
+
+
+def get_autotune_cpu_budget():
+    """
+    Get the number of worker threads the tuning may spread among the operations of a pipeline.
+
+    Returns:
+        Int, number of worker threads, 0 for the number of cores of the machine.
+    """
+    return _config.get_autotune_cpu_budget()
+
+
+MINDRECORD_IO_MODES = ("stream", "pread", "mmap", "io_uring")
+
+
+def set_mindrecord_io_mode(io_mode):
+    """
+    Set how MindDataset reads its MindRecord files.
+
+    "stream" reads through one file stream per worker. "pread" reads with positional reads shared by the workers and
+    splits large pages into requests issued in parallel. "mmap" maps the files in memory and reads the pages out of
+    the mapping without copying them. "io_uring" submits the requests of a page together, it falls back to "pread"
+    where io_uring is not available.
+
+    Args:
+        io_mode (str): one of "stream", "pread", "mmap" or "io_uring".
+
+    Raises:
+        ValueError: If io_mode is not one of the modes above.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_mindrecord_io_mode("mmap")
+    """
+    if io_mode not in MINDRECORD_IO_MODES:
+        raise ValueError("IO mode given is not one of {}.".format(MINDRECORD_IO_MODES))
+    _config.set_mindrecord_io_mode(io_mode)
+
+
+def get_mindrecord_io_mode():
+    """
+    Get how MindDataset reads its MindRecord files.
+
+    Returns:
+        Str, the io mode, "stream" by default.
+    """
+    return _config.get_mindrecord_io_mode()
+
+
 def __str__():
     """
     String representation of the configurations.
@@ -189,7 +290,10 @@ def load(file):
         >>> #     "workerConnectorSize": 16,
         >>> #     "opConnectorSize": 16,
         >>> #     "seed": 5489,
-        >>> #     "monitorSamplingInterval": 30
+        >>> #     "monitorSamplingInterval": 30,
+        >>> #     "enableAutotune": false,
+        >>> #     "autotuneCpuBudget": 0,
+        >>> #     "mindrecordIOMode": "stream"
         >>> # }
     """
     _config.load(file)
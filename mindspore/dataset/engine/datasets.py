@@ -25,6 +25,7 @@ import os
 import uuid
 import multiprocessing
 import queue
+import tempfile
 from enum import Enum
 from importlib import import_module
 import threading
@@ -309,7 +310,7 @@ class Dataset:
         return SyncWaitDataset(self, condition_name, num_batch, callback)
 
     @check_shuffle
-    def shuffle(self, buffer_size):
+    def shuffle(self, buffer_size, memory_limit=None, spill_dir=None):
         """
         Randomly shuffles the rows of this dataset using the following algorithm:
 
@@ -326,6 +327,11 @@ class Dataset:
             buffer_size (int): The size of the buffer (must be larger than 1) for
                 shuffling. Setting buffer_size equal to the number of rows in the entire
                 dataset will result in a global shuffle.
+            memory_limit (int, optional): Megabytes of memory for the rows in the shuffle
+                buffer (default=None, no limit). With a limit the rows are kept serialized,
+                and the ones that do not fit are written to spill_dir.
+            spill_dir (str, optional): Directory for the rows beyond memory_limit
+                (default=None, the system temporary directory).
 
         Returns:
             ShuffleDataset, dataset shuffled.
@@ -341,8 +347,11 @@ class Dataset:
             >>>
             >>> # creates a shuffled dataset using a shuffle buffer of size 4
             >>> data = data.shuffle(4)
+            >>>
+            >>> # shuffles the whole dataset in at most 512MB of memory, spilling the rest to disk
+            >>> data = data.shuffle(data.get_dataset_size(), memory_limit=512, spill_dir="/tmp/shuffle")
         """
-        return ShuffleDataset(self, buffer_size)
+        return ShuffleDataset(self, buffer_size, memory_limit, spill_dir)
 
     def flat_map(self, func):
         """
@@ -1781,14 +1790,20 @@ class ShuffleDataset(DatasetOp):
     Args:
         input_dataset (Dataset): Input Dataset to be shuffled.
         buffer_size (int): The size of the buffer.
+        memory_limit (int, optional): Megabytes of memory for the rows in the buffer (default=None, no limit).
+        spill_dir (str, optional): Directory for the rows beyond memory_limit (default=None).
 
     Raises:
         RuntimeError: If exist sync operators before shuffle.
     """
 
-    def __init__(self, input_dataset, buffer_size):
+    def __init__(self, input_dataset, buffer_size, memory_limit=None, spill_dir=None):
         super().__init__()
         self.buffer_size = buffer_size
+        self.memory_limit = memory_limit
+        self.spill_dir = spill_dir
+        if memory_limit is not None and spill_dir is None:
+            self.spill_dir = tempfile.gettempdir()
         self.children.append(input_dataset)
         self.reshuffle_each_epoch = None
         input_dataset.parent.append(self)
@@ -1801,6 +1816,8 @@ class ShuffleDataset(DatasetOp):
         args["buffer_size"] = self.buffer_size
         if self.reshuffle_each_epoch is not None:
             args["reshuffle_each_epoch"] = self.reshuffle_each_epoch
+        args["memory_limit"] = self.memory_limit
+        args["spill_dir"] = self.spill_dir
 
         return args
 
@@ -3276,6 +3293,8 @@ class TFRecordDataset(SourceDataset):
         shard_equal_rows (bool): Get equal rows for all shards(default=False). If shard_equal_rows is false, number
             of rows of each shard may be not equal.
         cache (DatasetCache, optional): Tensor cache to use. (default=None which means no cache is used)
+        check_crc (bool, optional): Check the crc of every record read, a corrupted record raises an error
+            (default=False, only the first record of each file is checked).
     Examples:
         >>> import mindspore.dataset as ds
         >>> import mindspore.common.dtype as mstype
@@ -3293,7 +3312,8 @@ class TFRecordDataset(SourceDataset):
 
     @check_tfrecorddataset
     def __init__(self, dataset_files, schema=None, columns_list=None, num_samples=None, num_parallel_workers=None,
-                 shuffle=Shuffle.GLOBAL, num_shards=None, shard_id=None, shard_equal_rows=False, cache=None):
+                 shuffle=Shuffle.GLOBAL, num_shards=None, shard_id=None, shard_equal_rows=False, cache=None,
+                 check_crc=False):
         super().__init__(num_parallel_workers)
         self.dataset_files = self._find_files(dataset_files)
         self.dataset_files.sort()
@@ -3330,6 +3350,7 @@ class TFRecordDataset(SourceDataset):
         self.sampler = _select_sampler(self.num_samples, sampler, sampler_shuffle, num_shards, shard_id,
                                        non_mappable=True)
         self.shard_equal_rows = shard_equal_rows
+        self.check_crc = check_crc
 
     def get_args(self):
         args = super().get_args()
@@ -3352,6 +3373,7 @@ class TFRecordDataset(SourceDataset):
         args["num_shards"] = self.num_shards
         args["shard_id"] = self.shard_id
         args["shard_equal_rows"] = self.shard_equal_rows
+        args["check_crc"] = self.check_crc
         args["cache"] = self.cache.cache_client if self.cache is not None else None
         args["sampler"] = self.sampler
         return args
@@ -23,7 +23,7 @@ from mindspore._c_dataengine import Tensor
 from .validators import check_gnn_graphdata, check_gnn_get_all_nodes, check_gnn_get_all_edges, \
     check_gnn_get_nodes_from_edges, check_gnn_get_all_neighbors, check_gnn_get_sampled_neighbors, \
     check_gnn_get_neg_sampled_neighbors, check_gnn_get_node_feature, check_gnn_get_edge_feature, \
-    check_gnn_random_walk
+    check_gnn_random_walk, check_gnn_save_snapshot
 
 
 class GraphData:
@@ -31,7 +31,9 @@ class GraphData:
     Reads the graph dataset used for GNN training from the shared file and database.
 
     Args:
-        dataset_file (str): One of file names in dataset.
+        dataset_file (str): One of file names in dataset, or a snapshot file written by `save_snapshot`.
+            A snapshot is mapped into memory instead of being loaded, and the processes of a host which
+            use the same snapshot share one copy of it.
         num_parallel_workers (int, optional): Number of workers to process the Dataset in parallel
             (default=None).
     """
@@ -287,3 +289,22 @@ class GraphData:
         """
         return self._graph.random_walk(target_nodes, meta_path, step_home_param, step_away_param,
                                        default_node).as_array()
+
+    @check_gnn_save_snapshot
+    def save_snapshot(self, snapshot_file):
+        """
+        Write the graph into a snapshot file, which can be given as `dataset_file` to load the graph faster.
+
+        Args:
+            snapshot_file (str): Path of the snapshot file, overwritten if it exists.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> data_graph = ds.GraphData('dataset_file', 2)
+            >>> data_graph.save_snapshot('graph.snapshot')
+            >>> snapshot_graph = ds.GraphData('graph.snapshot')
+
+        Raises:
+            TypeError: If `snapshot_file` is not string.
+        """
+        self._graph.save_snapshot(snapshot_file)
@@ -369,6 +369,9 @@ class RandomSampler(BuiltinSampler):
     Args:
         replacement (bool, optional): If True, put the sample ID back for the next draw (default=False).
         num_samples (int, optional): Number of elements to sample (default=None, all elements).
+        block_size (int, optional): Shuffle blocks of this many consecutive elements instead of
+            single elements (default=1). The elements of a block keep their order, so follow the
+            dataset with shuffle() to mix them. Requires replacement to be False.
 
     Examples:
         >>> import mindspore.dataset as ds
@@ -378,13 +381,18 @@ class RandomSampler(BuiltinSampler):
         >>> # creates a RandomSampler
         >>> sampler = ds.RandomSampler()
         >>> data = ds.ImageFolderDatasetV2(dataset_dir, num_parallel_workers=8, sampler=sampler)
+        >>>
+        >>> # reads blocks of 64 images in random order and mixes them in a shuffle buffer
+        >>> sampler = ds.RandomSampler(block_size=64)
+        >>> data = ds.ImageFolderDatasetV2(dataset_dir, num_parallel_workers=8, sampler=sampler).shuffle(1024)
 
     Raises:
         ValueError: If replacement is not boolean.
         ValueError: If num_samples is not positive.
+        ValueError: If block_size is not positive, or larger than 1 with replacement.
      """
 
-    def __init__(self, replacement=False, num_samples=None):
+    def __init__(self, replacement=False, num_samples=None, block_size=1):
         if not isinstance(replacement, bool):
             raise ValueError("replacement should be a boolean value, but got replacement={}".format(replacement))
 
@@ -393,19 +401,31 @@ class RandomSampler(BuiltinSampler):
                 raise ValueError("num_samples should be a positive integer "
                                  "value, but got num_samples={}".format(num_samples))
 
+        if not isinstance(block_size, int) or block_size <= 0:
+            raise ValueError("block_size should be a positive integer "
+                             "value, but got block_size={}".format(block_size))
+
+        if replacement and block_size != 1:
+            raise ValueError("block_size should be 1 when replacement is True, "
+                             "but got block_size={}".format(block_size))
+
         self.deterministic = False
         self.replacement = replacement
+        self.block_size = block_size
         self.reshuffle_each_epoch = True
         super().__init__(num_samples)
 
     def create(self):
         num_samples = self.num_samples if self.num_samples is not None else 0
-        c_sampler = cde.RandomSampler(num_samples, self.replacement, self.reshuffle_each_epoch)
+        c_sampler = cde.RandomSampler(num_samples, self.replacement, self.reshuffle_each_epoch, self.block_size)
         c_child_sampler = self.create_child()
         c_sampler.add_child(c_child_sampler)
         return c_sampler
 
     def create_for_minddataset(self):
+        if self.block_size != 1:
+            raise ValueError("block_size is not supported by MindDataset, "
+                             "but got block_size={}".format(self.block_size))
         num_samples = self.num_samples if self.num_samples is not None else 0
         c_sampler = cde.MindrecordRandomSampler(num_samples, self.replacement, self.reshuffle_each_epoch)
         c_child_sampler = self.create_child_for_minddataset()
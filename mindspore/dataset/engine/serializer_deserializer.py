@@ -340,7 +340,7 @@ def create_node(node):
                                  node.get('columns_order'), node.get('num_parallel_workers'))
 
     elif dataset_op == 'ShuffleDataset':
-        pyobj = de.Dataset().shuffle(node.get('buffer_size'))
+        pyobj = de.Dataset().shuffle(node.get('buffer_size'), node.get('memory_limit'), node.get('spill_dir'))
 
     elif dataset_op == 'BatchDataset':
         pyobj = de.Dataset().batch(node['batch_size'], node.get('drop_remainder'))
@@ -392,7 +392,8 @@ def construct_sampler(in_sampler):
         elif sampler_name == 'PKSampler':
             sampler = sampler_class(in_sampler['num_val'], in_sampler.get('num_class'), in_sampler('shuffle'))
         elif sampler_name == 'RandomSampler':
-            sampler = sampler_class(in_sampler.get('replacement'), in_sampler.get('num_samples'))
+            sampler = sampler_class(in_sampler.get('replacement'), in_sampler.get('num_samples'),
+                                    in_sampler.get('block_size', 1))
         elif sampler_name == 'SequentialSampler':
             sampler = sampler_class()
         elif sampler_name == 'SubsetRandomSampler':
@@ -117,7 +117,7 @@ def check_tfrecorddataset(method):
 
         nreq_param_int = ['num_samples', 'num_parallel_workers', 'num_shards', 'shard_id']
         nreq_param_list = ['columns_list']
-        nreq_param_bool = ['shard_equal_rows']
+        nreq_param_bool = ['shard_equal_rows', 'check_crc']
 
         dataset_files = param_dict.get('dataset_files')
         if not isinstance(dataset_files, (str, list)):
@@ -511,12 +511,19 @@ def check_shuffle(method):
 
     @wraps(method)
     def new_method(self, *args, **kwargs):
-        [buffer_size], _ = parse_user_args(method, *args, **kwargs)
+        [buffer_size, memory_limit, spill_dir], _ = parse_user_args(method, *args, **kwargs)
 
         type_check(buffer_size, (int,), "buffer_size")
 
         check_value(buffer_size, [2, INT32_MAX], "buffer_size")
 
+        if memory_limit is not None:
+            type_check(memory_limit, (int,), "memory_limit")
+            check_value(memory_limit, [1, INT32_MAX], "memory_limit")
+
+        if spill_dir is not None:
+            type_check(spill_dir, (str,), "spill_dir")
+
         return method(self, *args, **kwargs)
 
     return new_method
@@ -961,6 +968,19 @@ def check_gnn_random_walk(method):
     return new_method
 
 
+def check_gnn_save_snapshot(method):
+    """A wrapper that wraps a parameter checker to the GNN `save_snapshot` function."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        [snapshot_file], _ = parse_user_args(method, *args, **kwargs)
+        type_check(snapshot_file, (str,), "snapshot_file")
+
+        return method(self, *args, **kwargs)
+
+    return new_method
+
+
 def check_aligned_list(param, param_name, member_type):
     """Check whether the structure of each member of the list is the same."""
 
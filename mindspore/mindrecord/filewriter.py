@@ -273,6 +273,24 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_columnar_blob(self, enable):
+        """
+        Store each blob field of a page contiguously instead of interleaving the blob fields row by row, \
+        so that a reader which loads only some of the blob fields reads only their bytes. \
+        It takes effect when the schema has at least two blob fields, and must be called before writing.
+
+        Args:
+           enable (bool): Whether to use the columnar blob layout. The files written with it \
+               cannot be read by older versions of MindSpore.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMSetHeaderError: If data has been written already.
+        """
+        return self._writer.set_columnar_blob(enable)
+
     def commit(self):
         """
         Flush data to disk and generate the correspond db files.
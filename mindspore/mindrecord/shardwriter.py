@@ -112,6 +112,25 @@ class ShardWriter:
             raise MRMInvalidPageSizeError
         return ret
 
+    def set_columnar_blob(self, enable):
+        """
+        Store the blob columns of a page one after another instead of row by row.
+
+        Args:
+           enable (bool): Whether to use the columnar layout, must be set before the header.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMSetHeaderError: If the header has been set already.
+        """
+        ret = self._writer.set_columnar_blob(enable)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to set columnar blob.")
+            raise MRMSetHeaderError
+        return ret
+
     def set_shard_header(self, shard_header):
         """
         Set header which contains schema and index before write raw data.
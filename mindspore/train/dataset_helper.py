@@ -67,7 +67,7 @@ class DatasetHelper:
                     else:
                         iterclass = _DatasetIterMS
                 elif context.get_context("device_target") == "CPU":
-                    raise RuntimeError("Currently dataset sink mode is not supported when the device target is CPU.")
+                    iterclass = _DatasetIterCPU
         else:
             iterclass = _DatasetIterFeed
         self.iter = iterclass(dataset)
@@ -162,6 +162,23 @@ class _DatasetIterMS(_DatasetIter):
         self.op = GetNextSingleOp(self.dataset_types, self.dataset_shapes, queue_name)
 
 
+class _DatasetIterCPU(_DatasetIter):
+    """Iter for context (device_target=CPU), batches are shared with the dataset instead of copied"""
+    def __init__(self, dataset):
+        # only exported by builds with the cpu backend
+        from mindspore._c_expression import get_next_from_cpu_queue
+        super(_DatasetIterCPU, self).__init__(dataset)
+        self.loop_count = dataset.get_dataset_size()
+        self.loop_size = 1
+        queue_name = dataset.__ME_INITED__
+        dataset_types = self.dataset_types
+
+        def op():
+            return get_next_from_cpu_queue(queue_name, dataset_types)
+
+        self.op = op
+
+
 class _DatasetIterPSLite(_DatasetIter):
     """Iter for context (device_target=GPU) on MS_PSERVER or MS_SCHED"""
     def __init__(self, dataset):
@@ -497,7 +497,6 @@ class Model:
         When setting pynative mode, the training process will be performed with dataset not sink.
 
         Note:
-            CPU is not supported when dataset_sink_mode is true.
             If dataset_sink_mode is True, epoch of training should be equal to the count of repeat
             operation in dataset processing. Otherwise, errors could occur since the amount of data
             is not the amount training requires.
@@ -617,7 +616,6 @@ class Model:
         Configure to pynative mode, the evaluation will be performed with dataset non-sink mode.
 
         Note:
-            CPU is not supported when dataset_sink_mode is true.
             If dataset_sink_mode is True, data will be sent to device. If device is Ascend, features
             of data will be transferred one by one. The limitation of data transmission per time is 256M.
 
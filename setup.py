@@ -103,6 +103,7 @@ package_data = {
         'lib/*.so*',
         'lib/*.a',
         '.commit_id',
+        'cache_server',
     ]
 }
 
@@ -124,7 +125,10 @@ def update_permissions(path):
                      stat.S_IEXEC | stat.S_IRGRP | stat.S_IXGRP)
         for filename in filenames:
             file_fullpath = os.path.join(dirpath, filename)
-            os.chmod(file_fullpath, stat.S_IREAD)
+            if filename == 'cache_server':
+                os.chmod(file_fullpath, stat.S_IREAD | stat.S_IEXEC)
+            else:
+                os.chmod(file_fullpath, stat.S_IREAD)
 
 
 class EggInfo(egg_info):
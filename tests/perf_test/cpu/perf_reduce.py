@@ -0,0 +1,75 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""compare the strided CPU ReduceSum with a reduction that transposes the reduced axes to the end first"""
+import time
+import numpy as np
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+SHAPE = (32, 128, 512)
+AXES = [(2,), (1,), (0, 2)]
+LOOPS = 20
+
+
+class ReduceSum(nn.Cell):
+    def __init__(self, axis):
+        super(ReduceSum, self).__init__()
+        self.reduce_sum = P.ReduceSum(keep_dims=False)
+        self.axis = axis
+
+    def construct(self, x):
+        return self.reduce_sum(x, self.axis)
+
+
+def transpose_reduce(x, axis):
+    kept = [i for i in range(x.ndim) if i not in axis]
+    moved = np.ascontiguousarray(np.transpose(x, kept + list(axis)))
+    return moved.reshape([x.shape[i] for i in kept] + [-1]).sum(axis=-1)
+
+
+def use_transpose(x, axis):
+    start = time.time()
+    for _ in range(LOOPS):
+        output = transpose_reduce(x, axis)
+    end = time.time()
+    print("Reduce sum over axes {} by transpose - cost time: {}ms".format(axis, (end - start) * 1000 / LOOPS))
+    return output
+
+
+def use_strided(x, axis):
+    net = ReduceSum(axis)
+    input_x = Tensor(x)
+    # the first run compiles the graph
+    output = net(input_x)
+    start = time.time()
+    for _ in range(LOOPS):
+        output = net(input_x)
+    end = time.time()
+    print("Reduce sum over axes {} by the CPU kernel - cost time: {}ms".format(axis, (end - start) * 1000 / LOOPS))
+    return output.asnumpy()
+
+
+if __name__ == '__main__':
+    np.random.seed(1)
+    data = np.random.randn(*SHAPE).astype(np.float32)
+    for reduce_axis in AXES:
+        expect = use_transpose(data, reduce_axis)
+        result = use_strided(data, reduce_axis)
+        assert np.allclose(result, expect, rtol=1e-3, atol=1e-3)
@@ -21,6 +21,7 @@ import mindspore.nn as nn
 from mindspore import Tensor
 from mindspore.common.initializer import initializer
 from mindspore.common.parameter import Parameter
+from mindspore.ops import operations as P
 from mindspore.ops.operations import _grad_ops as G
 
 context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
@@ -51,3 +52,44 @@ def test_relu_grad():
     error = np.ones(shape=[3, 3]) * 1.0e-6
     diff = output.asnumpy() - expect
     assert np.all(diff < error)
+
+
+class NetReluGradBlocked(nn.Cell):
+    """dy and x come from mkl-dnn kernels and may stay blocked, dx is a graph output in the default layout"""
+    def __init__(self, channel):
+        super(NetReluGradBlocked, self).__init__()
+        self.conv = P.Conv2D(out_channel=channel, kernel_size=3)
+        self.relu = P.ReLU()
+        self.relu_grad = G.ReluGrad()
+
+    def construct(self, x, w, y, v):
+        return self.relu_grad(self.relu(self.conv(y, v)), self.relu(self.conv(x, w)))
+
+
+class NetReluGradInputs(nn.Cell):
+    """the inputs of NetReluGradBlocked, returned so that they keep the default layout"""
+    def __init__(self, channel):
+        super(NetReluGradInputs, self).__init__()
+        self.conv = P.Conv2D(out_channel=channel, kernel_size=3)
+        self.relu = P.ReLU()
+
+    def construct(self, x, w, y, v):
+        return self.relu(self.conv(y, v)), self.relu(self.conv(x, w))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_relu_grad_blocked_input():
+    # 20 channels are padded to 32 in the blocked layout, so dy takes more bytes than dx
+    channel = 20
+    np.random.seed(1)
+    x = Tensor(np.random.randn(2, 3, 8, 8).astype(np.float32))
+    w = Tensor(np.random.randn(channel, 3, 3, 3).astype(np.float32))
+    y = Tensor(np.random.randn(2, 3, 8, 8).astype(np.float32))
+    v = Tensor(np.random.randn(channel, 3, 3, 3).astype(np.float32))
+    output = NetReluGradBlocked(channel)(x, w, y, v)
+    dy, src = NetReluGradInputs(channel)(x, w, y, v)
+    expect = dy.asnumpy() * (src.asnumpy() > 0)
+    assert output.asnumpy().shape == (2, channel, 6, 6)
+    assert np.allclose(output.asnumpy(), expect, rtol=1.0e-4, atol=1.0e-4)
@@ -0,0 +1,82 @@
+#!/bin/bash
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+# Run one scheduler, the parameter servers and the workers of a full parameter server job on this host.
+# Usage: bash shell_run_test.sh DEVICE_TARGET WORKER_NUM SERVER_NUM SCHED_PORT STALENESS [TEST_SCRIPT]
+script_self=$(readlink -f "$0")
+execute_path=$(pwd)
+self_path=$(dirname "${script_self}")
+export MS_COMM_TYPE=zmq
+export MS_SCHED_HOST=127.0.0.1
+DEVICE_TARGET=$1
+export MS_WORKER_NUM=$2
+export MS_SERVER_NUM=$3
+export MS_SCHED_PORT=$4
+export MS_PS_STALENESS=$5
+TEST_SCRIPT=${6:-test_full_ps_lenet.py}
+
+export MS_ROLE=MS_SCHED
+rm -rf ${execute_path}/sched/
+mkdir ${execute_path}/sched/
+cd ${execute_path}/sched/ || exit
+python ${self_path}/${TEST_SCRIPT} --device_target=$DEVICE_TARGET > sched.log 2>&1 &
+sched_pid=`echo $!`
+
+export MS_ROLE=MS_PSERVER
+server_pids=()
+for((i=0; i<$MS_SERVER_NUM; i++)); do
+    rm -rf ${execute_path}/server_$i/
+    mkdir ${execute_path}/server_$i/
+    cd ${execute_path}/server_$i/ || exit
+    python ${self_path}/${TEST_SCRIPT} --device_target=$DEVICE_TARGET > server_$i.log 2>&1 &
+    server_pids[${i}]=`echo $!`
+done
+
+export MS_ROLE=MS_WORKER
+process_pid=()
+for((i=0; i<$MS_WORKER_NUM; i++)); do
+    rm -rf ${execute_path}/worker_$i/
+    mkdir ${execute_path}/worker_$i/
+    cd ${execute_path}/worker_$i/ || exit
+    python ${self_path}/${TEST_SCRIPT} --device_target=$DEVICE_TARGET > worker_$i.log 2>&1 &
+    process_pid[${i}]=`echo $!`
+done
+
+for((i=0; i<${MS_WORKER_NUM}; i++)); do
+    wait ${process_pid[i]}
+    status=`echo $?`
+    if [ "${status}" != "0" ]; then
+        echo "[ERROR] ${TEST_SCRIPT} failed. Failed to wait worker_{$i}, status: ${status}"
+        exit 1
+    fi
+done
+
+for((i=0; i<${MS_SERVER_NUM}; i++)); do
+    wait ${server_pids[i]}
+    status=`echo $?`
+    if [ "${status}" != "0" ]; then
+        echo "[ERROR] ${TEST_SCRIPT} failed. Failed to wait server_{$i}, status: ${status}"
+        exit 1
+    fi
+done
+
+wait ${sched_pid}
+status=`echo $?`
+if [ "${status}" != "0" ]; then
+    echo "[ERROR] ${TEST_SCRIPT} failed. Failed to wait scheduler, status: ${status}"
+    exit 1
+fi
+
+exit 0
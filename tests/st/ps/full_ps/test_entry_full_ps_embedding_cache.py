@@ -0,0 +1,28 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import os
+
+import pytest
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_full_ps_embedding_cache():
+    # two servers split the table, a cached row serves the lookups of one more version of the table
+    self_path = os.path.split(os.path.realpath(__file__))[0]
+    return_code = os.system(f"MS_PS_EMBEDDING_CACHE_SIZE=64 MS_PS_EMBEDDING_CACHE_STALENESS=1 "
+                            f"bash {self_path}/shell_run_test.sh CPU 1 2 8082 0 test_full_ps_embedding_cache.py")
+    assert return_code == 0
@@ -0,0 +1,28 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import os
+
+import pytest
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("staleness", [0, 2])
+def test_full_ps_lenet(staleness):
+    # 0 runs the synchronous updates, 2 lets every push be applied on its own and the pulls read the snapshots
+    self_path = os.path.split(os.path.realpath(__file__))[0]
+    return_code = os.system(f"bash {self_path}/shell_run_test.sh CPU 2 1 8081 {staleness}")
+    assert return_code == 0
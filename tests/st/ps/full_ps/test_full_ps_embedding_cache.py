@@ -0,0 +1,63 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import argparse
+import os
+
+import numpy as np
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Parameter, Tensor
+from mindspore.common.initializer import initializer
+from mindspore.ops import operations as P
+
+parser = argparse.ArgumentParser(description="test_full_ps_embedding_cache")
+parser.add_argument("--device_target", type=str, default="CPU")
+args, _ = parser.parse_known_args()
+context.set_context(mode=context.GRAPH_MODE, device_target=args.device_target)
+
+VOCAB_SIZE = 20
+EMBEDDING_SIZE = 8
+# the servers init every row of the table to 0.01
+INIT_VALUE = 0.01
+
+
+class EmbeddingSum(nn.Cell):
+    def __init__(self):
+        super(EmbeddingSum, self).__init__()
+        # only the tables whose name has embedding_table are looked up on the servers
+        self.embedding_table = Parameter(initializer("normal", [VOCAB_SIZE, EMBEDDING_SIZE]), name="embedding_table")
+        self.lookup = P.EmbeddingLookup().add_prim_attr("primitive_target", "CPU")
+        self.reduce_sum = P.ReduceSum()
+
+    def construct(self, ids):
+        return self.reduce_sum(self.lookup(self.embedding_table, ids, 0))
+
+
+if __name__ == "__main__":
+    network = EmbeddingSum()
+    network.set_param_ps()
+    net_opt = nn.PSFTRL(network.trainable_params(), learning_rate=0.1)
+    train_network = nn.TrainOneStepCell(network, net_opt)
+    # with two servers the first owns rows 0 to 9 and the second rows 10 to 19, the repeated id is asked for once
+    ids = Tensor(np.array([[0, 7, 12, 19, 7]]).astype(np.int32))
+    losses = [train_network(ids).asnumpy() for _ in range(3)]
+    if os.getenv("MS_ROLE") == "MS_WORKER":
+        # every row comes back from the server that owns it
+        assert np.allclose(losses[0], ids.asnumpy().size * EMBEDDING_SIZE * INIT_VALUE)
+        # one push later the rows are still served by the cache, although the servers updated them
+        assert np.allclose(losses[1], losses[0])
+        # two pushes later they are stale and fetched again
+        assert not np.allclose(losses[2], losses[0])
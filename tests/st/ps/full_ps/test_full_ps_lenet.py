@@ -0,0 +1,94 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import argparse
+import os
+
+import numpy as np
+
+import mindspore.context as context
+import mindspore.dataset as ds
+import mindspore.nn as nn
+from mindspore.common.initializer import TruncatedNormal
+from mindspore.nn.metrics import Accuracy
+from mindspore.train import Model
+from mindspore.train.callback import Callback
+
+parser = argparse.ArgumentParser(description="test_full_ps_lenet")
+parser.add_argument("--device_target", type=str, default="CPU")
+args, _ = parser.parse_known_args()
+context.set_context(mode=context.GRAPH_MODE, device_target=args.device_target)
+
+
+def conv(in_channels, out_channels, kernel_size):
+    return nn.Conv2d(in_channels, out_channels, kernel_size=kernel_size, weight_init=TruncatedNormal(0.02),
+                     pad_mode="valid")
+
+
+def fc_with_initialize(input_channels, out_channels):
+    return nn.Dense(input_channels, out_channels, TruncatedNormal(0.02), TruncatedNormal(0.02))
+
+
+class LeNet5(nn.Cell):
+    def __init__(self, num_class=10):
+        super(LeNet5, self).__init__()
+        self.conv1 = conv(1, 6, 5)
+        self.conv2 = conv(6, 16, 5)
+        self.fc1 = fc_with_initialize(16 * 5 * 5, 120)
+        self.fc2 = fc_with_initialize(120, 84)
+        self.fc3 = fc_with_initialize(84, num_class)
+        self.relu = nn.ReLU()
+        self.max_pool2d = nn.MaxPool2d(kernel_size=2, stride=2)
+        self.flatten = nn.Flatten()
+
+    def construct(self, x):
+        x = self.max_pool2d(self.relu(self.conv1(x)))
+        x = self.max_pool2d(self.relu(self.conv2(x)))
+        x = self.flatten(x)
+        x = self.relu(self.fc1(x))
+        x = self.relu(self.fc2(x))
+        return self.fc3(x)
+
+
+class LossGet(Callback):
+    def __init__(self):
+        super(LossGet, self).__init__()
+        self.losses = []
+
+    def step_end(self, run_context):
+        loss = run_context.original_args().net_outputs
+        self.losses.append(loss.asnumpy())
+
+
+def create_dataset(batch_size=32, batch_num=50):
+    # one fixed batch repeated, so that the loss has to go down even when the pulled weights are stale
+    np.random.seed(1)
+    data = np.random.randn(batch_size, 1, 32, 32).astype(np.float32)
+    label = np.random.randint(0, 10, [batch_size]).astype(np.int32)
+    dataset = ds.NumpySlicesDataset((np.tile(data, (batch_num, 1, 1, 1)), np.tile(label, batch_num)),
+                                    column_names=["image", "label"], shuffle=False)
+    return dataset.batch(batch_size, drop_remainder=True)
+
+
+if __name__ == "__main__":
+    network = LeNet5(10)
+    network.set_param_ps()
+    net_loss = nn.SoftmaxCrossEntropyWithLogits(is_grad=False, sparse=True, reduction="mean")
+    net_opt = nn.Momentum(network.trainable_params(), 0.01, 0.9)
+    model = Model(network, net_loss, net_opt, metrics={"Accuracy": Accuracy()})
+    loss_get = LossGet()
+    model.train(1, create_dataset(), callbacks=[loss_get], dataset_sink_mode=False)
+    if os.getenv("MS_ROLE") == "MS_WORKER":
+        assert len(loss_get.losses) == 50
+        assert np.mean(loss_get.losses[-5:]) < np.mean(loss_get.losses[:5])
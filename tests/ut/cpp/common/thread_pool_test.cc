@@ -0,0 +1,58 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "common/common_test.h"
+#include "common/thread_pool.h"
+
+namespace mindspore {
+namespace common {
+class ThreadPoolTest : public UT::Common {
+ public:
+  ThreadPoolTest() = default;
+};
+
+TEST_F(ThreadPoolTest, parallel_for_cover_all) {
+  std::vector<int> data(100003, 0);
+  ThreadPool::GetInstance().ParallelFor(data.size(), 16, [&data](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      data[i] += 1;
+    }
+  });
+  for (size_t i = 0; i < data.size(); ++i) {
+    EXPECT_EQ(data[i], 1);
+  }
+}
+
+TEST_F(ThreadPoolTest, nested_run) {
+  std::atomic<size_t> count{0};
+  auto &pool = ThreadPool::GetInstance();
+  pool.Run(8, [&pool, &count](size_t) { pool.Run(8, [&count](size_t) { count++; }); });
+  EXPECT_EQ(count, 64);
+}
+
+TEST_F(ThreadPoolTest, rethrow_task_error) {
+  auto task = [](size_t task_id) {
+    if (task_id == 3) {
+      throw std::runtime_error("task failed");
+    }
+  };
+  EXPECT_THROW(ThreadPool::GetInstance().Run(10, task), std::runtime_error);
+}
+}  // namespace common
+}  // namespace mindspore
@@ -21,6 +21,7 @@
 #include "common/utils.h"
 #include "gtest/gtest.h"
 #include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/kernels/tensor_op.h"
 #include "utils/log_adapter.h"
 #include "securec.h"
 #include "minddata/dataset/util/status.h"
@@ -370,3 +371,120 @@ TEST_F(MindDataTestBatchOp, TestSimpleBatchPadding) {
     EXPECT_TRUE(rc.IsOk());
   }
 }
+
+namespace {
+// Adds one to each value, into a new tensor the map can place in the batch
+class PlusOneOp : public TensorOp {
+ public:
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, input->shape(), input->type()));
+    auto out = (*output)->begin<int64_t>();
+    for (auto itr = input->begin<int64_t>(); itr != input->end<int64_t>(); itr++, out++) {
+      *out = *itr + 1;
+    }
+    return Status::OK();
+  }
+
+  std::string Name() const override { return "PlusOneOp"; }
+};
+
+// Repeats each value, so the output is twice as long as OutputShape() tells
+class RepeatValuesOp : public TensorOp {
+ public:
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    std::vector<int64_t> values;
+    for (auto itr = input->begin<int64_t>(); itr != input->end<int64_t>(); itr++) {
+      values.push_back(*itr);
+      values.push_back(*itr);
+    }
+    return Tensor::CreateTensor(output, values);
+  }
+
+  std::string Name() const override { return "RepeatValuesOp"; }
+};
+
+// Runs TFReader -> Repeat(2) -> Map(op) -> Batch and gives back the batches of col_sint64, and in num_placed the
+// number of them the map wrote its rows into
+std::vector<std::shared_ptr<Tensor>> MapBatch(std::shared_ptr<TensorOp> op, bool perf_mode, int32_t batch_size,
+                                              bool drop, const std::string &schema_file,
+                                              int64_t *num_placed = nullptr) {
+  std::shared_ptr<MapOp> map_op;
+  Status rc = MapOp::Builder()
+                .SetInColNames({"col_sint64"})
+                .SetTensorFuncs({std::move(op)})
+                .SetNumWorkers(4)
+                .SetPerformanceMode(perf_mode)
+                .Build(&map_op);
+  EXPECT_TRUE(rc.IsOk());
+  auto tree = Build({TFReader(schema_file, 3), Repeat(2), map_op, Batch(batch_size, drop)});
+  std::vector<std::shared_ptr<Tensor>> batches;
+  rc = tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+  if (rc.IsError()) {
+    return batches;
+  }
+  de::DatasetIterator di(tree);
+  TensorMap tensor_map;
+  rc = di.GetNextAsMap(&tensor_map);
+  EXPECT_TRUE(rc.IsOk());
+  while (rc.IsOk() && !tensor_map.empty()) {
+    batches.push_back(tensor_map["col_sint64"]);
+    rc = di.GetNextAsMap(&tensor_map);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  if (num_placed != nullptr) {
+    *num_placed = map_op->batch_slots() == nullptr ? 0 : map_op->batch_slots()->num_taken();
+  }
+  return batches;
+}
+}  // namespace
+
+TEST_F(MindDataTestBatchOp, TestMapBatchInPlace) {
+  std::string schema_file = datasets_root_path_ + "/testBatchDataset/test.data";
+  // 24 rows in batches of 5, the last 4 dropped
+  int64_t num_placed = 0;
+  auto placed = MapBatch(std::make_shared<PlusOneOp>(), true, 5, true, schema_file, &num_placed);
+  auto copied = MapBatch(std::make_shared<PlusOneOp>(), false, 5, true, schema_file);
+  ASSERT_EQ(placed.size(), 4);
+  ASSERT_EQ(copied.size(), placed.size());
+  // every batch is the tensor the map wrote its rows into, not a copy of them
+  EXPECT_EQ(num_placed, 4);
+  for (size_t i = 0; i < placed.size(); i++) {
+    EXPECT_EQ(placed[i]->shape(), TensorShape({5, 1}));
+    EXPECT_TRUE(*placed[i] == *copied[i]);
+  }
+  int64_t payload[] = {-9223372036854775807, 2, 3, 4, 5};
+  std::shared_ptr<Tensor> t;
+  Status rc = Tensor::CreateTensor(&t, TensorImpl::kFlexible, TensorShape({5, 1}), DataType(DataType::DE_INT64),
+                                   reinterpret_cast<unsigned char *>(payload));
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(*t == *placed[0]);
+
+  // Keeping the remainder gives a short last batch, which is copied
+  placed = MapBatch(std::make_shared<PlusOneOp>(), true, 5, false, schema_file, &num_placed);
+  copied = MapBatch(std::make_shared<PlusOneOp>(), false, 5, false, schema_file);
+  ASSERT_EQ(placed.size(), 5);
+  ASSERT_EQ(copied.size(), placed.size());
+  EXPECT_EQ(num_placed, 4);
+  EXPECT_EQ(placed.back()->shape(), TensorShape({4, 1}));
+  for (size_t i = 0; i < placed.size(); i++) {
+    EXPECT_TRUE(*placed[i] == *copied[i]);
+  }
+}
+
+TEST_F(MindDataTestBatchOp, TestMapBatchInPlaceFallback) {
+  std::string schema_file = datasets_root_path_ + "/testBatchDataset/test.data";
+  // The rows do not have the shape OutputShape() tells, so the batches are assembled by copying
+  int64_t num_placed = -1;
+  auto placed = MapBatch(std::make_shared<RepeatValuesOp>(), true, 5, true, schema_file, &num_placed);
+  auto copied = MapBatch(std::make_shared<RepeatValuesOp>(), false, 5, true, schema_file);
+  ASSERT_EQ(placed.size(), 4);
+  ASSERT_EQ(copied.size(), placed.size());
+  EXPECT_EQ(num_placed, 0);
+  for (size_t i = 0; i < placed.size(); i++) {
+    EXPECT_EQ(placed[i]->shape(), TensorShape({5, 2}));
+    EXPECT_TRUE(*placed[i] == *copied[i]);
+  }
+}
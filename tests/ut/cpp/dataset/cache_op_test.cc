@@ -13,9 +13,16 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <limits>
 #include <string>
+#include <vector>
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/cache/cache_client.h"
+#include "minddata/dataset/engine/cache/cache_ipc.h"
+#include "minddata/dataset/engine/cache/cache_request.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/cache_op.h"
 #include "minddata/dataset/engine/datasetops/cache_lookup_op.h"
@@ -177,6 +184,151 @@ TEST_F(MindDataTestCacheOp, TestConcurrencyRequest) {
   EXPECT_TRUE(rc.IsOk());
 }
 
+TEST_F(MindDataTestCacheOp, TestSharedMemoryRing) {
+  SharedMemoryRing ring;
+  ASSERT_TRUE(ring.Create(1024).IsOk());
+  int64_t offset = -1;
+  ASSERT_TRUE(ring.Allocate(400, &offset).IsOk());
+  EXPECT_EQ(offset, 0);
+  ASSERT_TRUE(ring.Allocate(400, &offset).IsOk());
+  EXPECT_EQ(offset, 400);
+  // Only 224 bytes left at the end of the ring and none at the start.
+  EXPECT_TRUE(ring.Allocate(400, &offset).IsNoSpace());
+  ring.FreeOldest();
+  // An allocation is never split, it wraps around to the start.
+  ASSERT_TRUE(ring.Allocate(400, &offset).IsOk());
+  EXPECT_EQ(offset, 0);
+  EXPECT_TRUE(ring.Allocate(1, &offset).IsNoSpace());
+  ring.FreeOldest();
+  ASSERT_TRUE(ring.Allocate(100, &offset).IsOk());
+  EXPECT_EQ(offset, 400);
+  ring.FreeOldest();
+  ring.FreeOldest();
+  EXPECT_TRUE(ring.empty());
+  ASSERT_TRUE(ring.Allocate(1024, &offset).IsOk());
+  EXPECT_EQ(offset, 0);
+}
+
+namespace {
+// Lay out a row the way CacheIpcClient::SendRow does, a header with one int64 column followed by its data.
+std::vector<uint8_t> MakeIpcRow(int64_t data_sz, int64_t pad) {
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<int64_t> dims{4};
+  auto meta = CreateTensorMetaMsg(fbb, fbb.CreateVector(dims), TensorType_DE_INT64);
+  std::vector<flatbuffers::Offset<TensorMetaMsg>> column{meta};
+  std::vector<int64_t> sizes{data_sz};
+  auto column_off = fbb.CreateVector(column);
+  auto data_sz_off = fbb.CreateVector(sizes);
+  TensorRowHeaderMsgBuilder row_builder(fbb);
+  row_builder.add_column(column_off);
+  row_builder.add_data_sz(data_sz_off);
+  row_builder.add_row_id(0);
+  row_builder.add_size_of_this(-1);
+  fbb.Finish(row_builder.Finish());
+  GetMutableTensorRowHeaderMsg(fbb.GetBufferPointer())->mutate_size_of_this(fbb.GetSize());
+  std::vector<uint8_t> row(fbb.GetBufferPointer(), fbb.GetBufferPointer() + fbb.GetSize());
+  row.resize(row.size() + pad, 0);
+  return row;
+}
+}  // namespace
+
+TEST_F(MindDataTestCacheOp, TestIpcRowHeaderChecks) {
+  std::vector<uint8_t> header;
+  std::vector<const void *> buffers;
+  // A well formed row
+  std::vector<uint8_t> row = MakeIpcRow(32, 32);
+  ASSERT_TRUE(ParseIpcRow(row.data(), row.size(), &header, &buffers).IsOk());
+  ASSERT_EQ(buffers.size(), 2);
+  EXPECT_EQ(buffers[0], header.data());
+  EXPECT_EQ(buffers[1], row.data() + row.size() - 32);
+  // The server must not trust the header a client wrote in the shared memory.
+  std::vector<uint8_t> garbage(64, 0xff);
+  EXPECT_FALSE(ParseIpcRow(garbage.data(), garbage.size(), &header, &buffers).IsOk());
+  row = MakeIpcRow(-8, 32);
+  EXPECT_FALSE(ParseIpcRow(row.data(), row.size(), &header, &buffers).IsOk());
+  row = MakeIpcRow(33, 32);
+  EXPECT_FALSE(ParseIpcRow(row.data(), row.size(), &header, &buffers).IsOk());
+  row = MakeIpcRow(std::numeric_limits<int64_t>::max(), 32);
+  EXPECT_FALSE(ParseIpcRow(row.data(), row.size(), &header, &buffers).IsOk());
+  // A header that claims to be larger than the payload
+  row = MakeIpcRow(0, 0);
+  GetMutableTensorRowHeaderMsg(row.data())->mutate_size_of_this(row.size() + 1);
+  EXPECT_FALSE(ParseIpcRow(row.data(), row.size(), &header, &buffers).IsOk());
+  // A header cut short
+  row = MakeIpcRow(0, 0);
+  EXPECT_FALSE(ParseIpcRow(row.data(), row.size() / 2, &header, &buffers).IsOk());
+}
+
+// The server maps the shared memory of a client with the size the client sent, which must not exceed the segment.
+TEST_F(MindDataTestCacheOp, TestSharedMemoryAttachSize) {
+  SharedMemory mem;
+  ASSERT_TRUE(mem.Create(4096).IsOk());
+  for (int64_t sz : {static_cast<int64_t>(1) << 20, static_cast<int64_t>(4097), static_cast<int64_t>(0),
+                     static_cast<int64_t>(-1)}) {
+    SharedMemory peer;
+    EXPECT_FALSE(peer.Attach(dup(mem.fd()), sz).IsOk());
+    EXPECT_EQ(peer.GetPointer(), nullptr);
+  }
+  SharedMemory peer;
+  ASSERT_TRUE(peer.Attach(dup(mem.fd()), 4096).IsOk());
+  peer.GetPointer()[4095] = 1;
+  EXPECT_EQ(mem.GetPointer()[4095], 1);
+}
+
+// One process caches rows into the cache server of another through the unix socket and the shared memory rings.
+TEST_F(MindDataTestCacheOp, TestCacheServerTwoProcesses) {
+  std::string socket_path = "/tmp/ms_cache_ut_" + std::to_string(getpid()) + ".sock";
+  ASSERT_TRUE(CacheServer::GetInstance().Listen(socket_path).IsOk());
+  ASSERT_EQ(setenv(kCacheServerSocketEnv, socket_path.c_str(), 1), 0);
+  std::shared_ptr<Tensor> t = std::make_shared<Tensor>(TensorShape({64, 1024}), DataType(DataType::DE_INT32));
+  for (auto i = 0; i < 64; ++i) {
+    for (auto j = 0; j < 1024; ++j) {
+      t->SetItemAt<int32_t>({i, j}, i * 1024 + j);
+    }
+  }
+  const int64_t num_rows = 200;
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // The child is the training job which fills the cache. Row ids are given by the client, so there is no cookie.
+    CacheClient child_client(3, 0, true);
+    Status rc = child_client.CreateCache(1, false);
+    for (auto i = 0; i < num_rows && (rc.IsOk() || rc.get_code() == StatusCode::kDuplicateKey); ++i) {
+      TensorRow row;
+      row.setId(i);
+      row.push_back(t);
+      rc = child_client.WriteRow(row);
+    }
+    _exit(rc.IsOk() ? 0 : 1);
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(WEXITSTATUS(status), 0);
+
+  // The parent is another job sharing the same cache.
+  CacheClient myClient(3, 0, true);
+  ASSERT_EQ(unsetenv(kCacheServerSocketEnv), 0);
+  Status rc = myClient.CreateCache(1, false);
+  EXPECT_EQ(rc.get_code(), StatusCode::kDuplicateKey);
+  CacheClient::ServiceStat stat{};
+  ASSERT_TRUE(myClient.GetStat(&stat).IsOk());
+  EXPECT_EQ(stat.num_mem_cached, num_rows);
+  std::vector<row_id_type> row_ids;
+  for (auto i = 0; i < num_rows; ++i) {
+    row_ids.push_back(i);
+  }
+  TensorTable tbl;
+  ASSERT_TRUE(myClient.GetRows(row_ids, &tbl).IsOk());
+  ASSERT_EQ(tbl.size(), num_rows);
+  for (const auto &row : tbl) {
+    ASSERT_EQ(row.size(), 1);
+    bool cmp = (*t == *row.front());
+    EXPECT_TRUE(cmp);
+  }
+  EXPECT_TRUE(myClient.DestroyCache().IsOk());
+}
+
 // Simple test with a repeated cache op over random data producer
 //
 //     RepeatOp
@@ -122,6 +122,27 @@ TEST_F(MindDataTestConnector, Test2) {
   ASSERT_TRUE(rc.IsOk());
 }
 
+// Test3: the producers stop pushing to the last queue from a given element on, and the queues grow in between.
+// The elements are still popped in the order they were handed out to the producers.
+TEST_F(MindDataTestConnector, Test3) {
+  MS_LOG(INFO) << "MindDataTestConnector Test3.";
+  Connector<uint32_t> conn(3, 1, 1);
+  for (uint32_t i = 0; i < 3; i++) {
+    ASSERT_TRUE(conn.Push(i, i).IsOk());
+  }
+  conn.ScheduleActiveProducers(3, 2);
+  ASSERT_TRUE(conn.SetQueueCapacity(2).IsOk());
+  ASSERT_EQ(conn.capacity(), 6);
+  ASSERT_TRUE(conn.Push(0, 3).IsOk());
+  ASSERT_TRUE(conn.Push(1, 4).IsOk());
+  uint32_t v;
+  for (uint32_t i = 0; i < 5; i++) {
+    ASSERT_TRUE(conn.Pop(0, &v).IsOk());
+    ASSERT_EQ(v, i);
+  }
+  ASSERT_EQ(conn.size(), 0);
+}
+
 
 
 // Implementation of MindDataTestConnector class and the helper functions.
@@ -0,0 +1,137 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_CPUQUE
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/core/client.h"
+#include "minddata/dataset/engine/datasetops/device_queue_op.h"
+#include "runtime/device/cpu/cpu_buffer_mgr.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::device::CpuBufferMgr;
+using mindspore::device::CpuQueueStatus;
+using mindspore::device::DataItemCpu;
+
+class MindDataTestDeviceQueueOp : public UT::DatasetOpTesting {
+ protected:
+  // TFReaderOp -> DeviceQueueOp(CPU), 12 rows of 8 numeric columns
+  std::shared_ptr<ExecutionTree> BuildCpuSinkTree(const std::string &channel_name) {
+    auto my_tree = std::make_shared<ExecutionTree>();
+    std::shared_ptr<TFReaderOp> my_tfreader_op;
+    TFReaderOp::Builder builder;
+    builder.SetDatasetFilesList({datasets_root_path_ + "/testTFTestAllTypes/test.data"})
+      .SetRowsPerBuffer(4)
+      .SetWorkerConnectorSize(16)
+      .SetNumWorkers(1);
+    std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+    schema->LoadSchemaFile(datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json", {});
+    builder.SetDataSchema(std::move(schema));
+    EXPECT_TRUE(builder.Build(&my_tfreader_op).IsOk());
+
+    std::shared_ptr<DeviceQueueOp> my_device_queue_op;
+    DeviceQueueOp::Builder builder_device_queue(16);
+    builder_device_queue.SetChannelName(channel_name).SetDeviceType("CPU");
+    EXPECT_TRUE(builder_device_queue.Build(&my_device_queue_op).IsOk());
+
+    EXPECT_TRUE(my_tree->AssociateNode(my_tfreader_op).IsOk());
+    EXPECT_TRUE(my_tree->AssociateNode(my_device_queue_op).IsOk());
+    EXPECT_TRUE(my_device_queue_op->AddChild(my_tfreader_op).IsOk());
+    EXPECT_TRUE(my_tree->AssignRoot(my_device_queue_op).IsOk());
+    EXPECT_TRUE(my_tree->Prepare().IsOk());
+    return my_tree;
+  }
+
+  const unsigned int kWaitTimeInMs = 10000;
+};
+
+TEST_F(MindDataTestDeviceQueueOp, TestCpuSinkSharesBuffers) {
+  MS_LOG(INFO) << "Doing MindDataTestDeviceQueueOp-TestCpuSinkSharesBuffers.";
+  const std::string channel_name = "test_cpu_sink_shares_buffers";
+  auto my_tree = BuildCpuSinkTree(channel_name);
+  ASSERT_TRUE(my_tree->Launch().IsOk());
+
+  int row_count = 0;
+  while (true) {
+    std::vector<DataItemCpu> items;
+    CpuQueueStatus ret = CpuBufferMgr::GetInstance().Pop(channel_name, &items, kWaitTimeInMs);
+    if (ret == CpuQueueStatus::CPU_QUEUE_CLOSED) {
+      break;
+    }
+    ASSERT_EQ(ret, CpuQueueStatus::CPU_QUEUE_SUCCESS);
+    ASSERT_EQ(items.size(), 8);
+    for (const auto &item : items) {
+      // the item points into the dataset tensor it keeps alive, no copy is made
+      auto tensor = std::static_pointer_cast<Tensor>(item.holder_);
+      ASSERT_NE(tensor, nullptr);
+      EXPECT_EQ(item.data_ptr_, tensor->GetBuffer());
+      EXPECT_EQ(item.data_len_, tensor->SizeInBytes());
+    }
+    // col_3d
+    EXPECT_EQ(items[6].shape_, std::vector<int>({2, 2, 2}));
+    EXPECT_EQ(items[6].data_len_, 8 * sizeof(int64_t));
+    row_count++;
+  }
+  ASSERT_EQ(row_count, 12);
+}
+
+TEST_F(MindDataTestDeviceQueueOp, TestCpuSinkIsBounded) {
+  MS_LOG(INFO) << "Doing MindDataTestDeviceQueueOp-TestCpuSinkIsBounded.";
+  const std::string channel_name = "test_cpu_sink_is_bounded";
+  auto my_tree = BuildCpuSinkTree(channel_name);
+  ASSERT_TRUE(my_tree->Launch().IsOk());
+
+  // Nobody pops, so the sink stops once the queue is full
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  EXPECT_EQ(CpuBufferMgr::GetInstance().Size(channel_name), CpuBufferMgr::kDefaultCapacity);
+
+  int row_count = 0;
+  std::vector<DataItemCpu> items;
+  while (CpuBufferMgr::GetInstance().Pop(channel_name, &items, kWaitTimeInMs) == CpuQueueStatus::CPU_QUEUE_SUCCESS) {
+    EXPECT_LE(CpuBufferMgr::GetInstance().Size(channel_name), CpuBufferMgr::kDefaultCapacity);
+    row_count++;
+  }
+  ASSERT_EQ(row_count, 12);
+}
+
+TEST_F(MindDataTestDeviceQueueOp, TestCpuQueueClose) {
+  MS_LOG(INFO) << "Doing MindDataTestDeviceQueueOp-TestCpuQueueClose.";
+  const std::string channel_name = "test_cpu_queue_close";
+  std::vector<DataItemCpu> items;
+  EXPECT_EQ(CpuBufferMgr::GetInstance().Pop("test_cpu_queue_not_exist", &items, 0),
+            CpuQueueStatus::CPU_QUEUE_NOT_EXIST);
+
+  ASSERT_EQ(CpuBufferMgr::GetInstance().Open(channel_name, 1), CpuQueueStatus::CPU_QUEUE_SUCCESS);
+  auto data = std::make_shared<std::vector<float>>(4, 1.0);
+  DataItemCpu item{data->data(), data->size() * sizeof(float), {4}, data};
+  EXPECT_EQ(CpuBufferMgr::GetInstance().Push(channel_name, {item}, 0), CpuQueueStatus::CPU_QUEUE_SUCCESS);
+  EXPECT_EQ(CpuBufferMgr::GetInstance().Push(channel_name, {item}, 10), CpuQueueStatus::CPU_QUEUE_TIMEOUT);
+  CpuBufferMgr::GetInstance().Close(channel_name);
+  EXPECT_EQ(CpuBufferMgr::GetInstance().Push(channel_name, {item}, 0), CpuQueueStatus::CPU_QUEUE_CLOSED);
+
+  // queued batches are still handed out after close
+  EXPECT_EQ(CpuBufferMgr::GetInstance().Pop(channel_name, &items, 0), CpuQueueStatus::CPU_QUEUE_SUCCESS);
+  ASSERT_EQ(items.size(), 1);
+  EXPECT_EQ(items[0].data_ptr_, data->data());
+  EXPECT_EQ(CpuBufferMgr::GetInstance().Pop(channel_name, &items, 0), CpuQueueStatus::CPU_QUEUE_CLOSED);
+}
+#endif
@@ -20,6 +20,8 @@
 
 #include "common/common.h"
 #include "gtest/gtest.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/engine/gnn/node.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
@@ -60,6 +62,65 @@ TEST_F(MindDataTestGNNGraph, TestGraphLoader) {
   EXPECT_EQ(n_type_map[1].size(), 10);
 }
 
+TEST_F(MindDataTestGNNGraph, TestCsrGraph) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  GraphLoader gl(path, 4);
+  EXPECT_TRUE(gl.InitAndLoad().IsOk());
+  CsrGraph csr;
+  DefaultNodeFeatureMap default_node_feature_map;
+  DefaultEdgeFeatureMap default_edge_feature_map;
+  EXPECT_TRUE(gl.GetCsrGraph(&csr, &default_node_feature_map, &default_edge_feature_map).IsOk());
+  EXPECT_EQ(csr.NumNodes(), 20);
+  EXPECT_EQ(csr.NumEdges(), 40);
+  CsrGraph::Index begin = 0, end = 0;
+  EXPECT_TRUE(csr.GetNodeRange(1, &begin, &end).IsOk());
+  EXPECT_EQ(end - begin, 10);
+  EXPECT_TRUE(csr.GetNodeRange(2, &begin, &end).IsOk());
+  EXPECT_EQ(end - begin, 10);
+  EXPECT_FALSE(csr.GetNodeRange(3, &begin, &end).IsOk());
+
+  // The neighbors must be the same as those of the linked nodes
+  GraphLoader gl_ref(path, 4);
+  EXPECT_TRUE(gl_ref.InitAndLoad().IsOk());
+  NodeIdMap n_id_map;
+  EdgeIdMap e_id_map;
+  NodeTypeMap n_type_map;
+  EdgeTypeMap e_type_map;
+  NodeFeatureMap n_feature_map;
+  EdgeFeatureMap e_feature_map;
+  EXPECT_TRUE(gl_ref
+                .GetNodesAndEdges(&n_id_map, &e_id_map, &n_type_map, &e_type_map, &n_feature_map, &e_feature_map,
+                                  &default_node_feature_map, &default_edge_feature_map)
+                .IsOk());
+  for (const auto &p : n_id_map) {
+    CsrGraph::Index node = 0;
+    EXPECT_TRUE(csr.FindNode(p.first, &node).IsOk());
+    EXPECT_EQ(csr.NodeId(node), p.first);
+    for (NodeType type : {1, 2}) {
+      std::vector<NodeIdType> expected;
+      EXPECT_TRUE(p.second->GetAllNeighbors(type, &expected, true).IsOk());
+      std::sort(expected.begin(), expected.end());
+      const CsrGraph::Index *nbr_begin = nullptr, *nbr_end = nullptr;
+      csr.GetNeighbors(node, type, &nbr_begin, &nbr_end);
+      std::vector<NodeIdType> actual;
+      for (auto itr = nbr_begin; itr != nbr_end; ++itr) {
+        actual.push_back(csr.NodeId(*itr));
+      }
+      std::sort(actual.begin(), actual.end());
+      EXPECT_EQ(actual, expected);
+    }
+  }
+  for (const auto &p : e_id_map) {
+    CsrGraph::Index edge = 0;
+    EXPECT_TRUE(csr.FindEdge(p.first, &edge).IsOk());
+    std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>> nodes;
+    EXPECT_TRUE(p.second->GetNode(&nodes).IsOk());
+    EXPECT_EQ(csr.NodeId(csr.EdgeSrc(edge)), nodes.first->id());
+    EXPECT_EQ(csr.NodeId(csr.EdgeDst(edge)), nodes.second->id());
+  }
+  EXPECT_FALSE(csr.FindNode(-1, &begin).IsOk());
+}
+
 TEST_F(MindDataTestGNNGraph, TestGetAllNeighbors) {
   std::string path = "data/mindrecord/testGraphData/testdata";
   Graph graph(path, 1);
@@ -286,3 +347,41 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+TEST_F(MindDataTestGNNGraph, TestParallelSamplingIsDeterministic) {
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(5);
+  std::string path = "data/mindrecord/testGraphData/sns";
+  Graph serial_graph(path, 1);
+  Graph parallel_graph(path, 4);
+  EXPECT_TRUE(serial_graph.Init().IsOk());
+  EXPECT_TRUE(parallel_graph.Init().IsOk());
+
+  MetaInfo meta_info;
+  EXPECT_TRUE(serial_graph.GetMetaInfo(&meta_info).IsOk());
+  std::shared_ptr<Tensor> nodes;
+  EXPECT_TRUE(serial_graph.GetAllNodes(meta_info.node_type[0], &nodes).IsOk());
+  // Enough nodes for several chunks
+  std::vector<NodeIdType> node_list;
+  for (int i = 0; i < 8; i++) {
+    for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+      node_list.push_back(*itr);
+    }
+  }
+
+  std::shared_ptr<Tensor> serial_out, parallel_out;
+  EXPECT_TRUE(serial_graph.GetSampledNeighbors(node_list, {3, 2}, {1, 1}, &serial_out).IsOk());
+  EXPECT_TRUE(parallel_graph.GetSampledNeighbors(node_list, {3, 2}, {1, 1}, &parallel_out).IsOk());
+  EXPECT_EQ(serial_out->ToString(), parallel_out->ToString());
+
+  EXPECT_TRUE(serial_graph.GetNegSampledNeighbors(node_list, 5, 1, &serial_out).IsOk());
+  EXPECT_TRUE(parallel_graph.GetNegSampledNeighbors(node_list, 5, 1, &parallel_out).IsOk());
+  EXPECT_EQ(serial_out->ToString(), parallel_out->ToString());
+
+  std::vector<NodeType> meta_path(10, 1);
+  EXPECT_TRUE(serial_graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &serial_out).IsOk());
+  EXPECT_TRUE(parallel_graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &parallel_out).IsOk());
+  EXPECT_EQ(serial_out->shape().ToString(), "<264,11>");
+  EXPECT_EQ(serial_out->ToString(), parallel_out->ToString());
+  GlobalContext::config_manager()->set_seed(original_seed);
+}
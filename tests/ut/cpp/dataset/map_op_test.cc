@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -20,9 +21,13 @@
 
 #include "common/common.h"
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
 #include "minddata/dataset/kernels/image/resize_op.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "utils/log_adapter.h"
@@ -741,3 +746,115 @@ TEST_F(MindDataTestMapOp, ImageFolder_Decode_Repeat_Resize_NoInputColumns) {
 }
 
 
+
+// TestBatchCompute scenario:
+//    TFReaderOp reads buffers of 2 rows whose "image" column is a uint8 tensor of the same shape on every row.
+//    A map of TypeCast and Rescale goes through TensorOp::ComputeBatch on the stacked rows, while the same map
+//    with a NoOp in the middle falls back to one Compute() per row.
+//    Verify that both give the same rows.
+TEST_F(MindDataTestMapOp, TestBatchCompute) {
+  MS_LOG(INFO) << "Doing TestBatchCompute.";
+  auto run = [this](bool batch, std::vector<std::vector<float>> *rows) {
+    std::vector<std::shared_ptr<TensorOp>> func_list;
+    func_list.push_back(std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT32)));
+    if (!batch) {
+      func_list.push_back(std::make_shared<mindspore::dataset::test::NoOp>());
+    }
+    func_list.push_back(std::make_shared<RescaleOp>(1.0 / 255, 0.0));
+    std::shared_ptr<MapOp> map_op;
+    MapOp::Builder builder;
+    builder.SetInColNames({"image"}).SetTensorFuncs(std::move(func_list)).SetNumWorkers(2);
+    Status rc = builder.Build(&map_op);
+    EXPECT_TRUE(rc.IsOk());
+
+    my_tree_ = Build({this->CreateTFReaderOp(), map_op});
+    rc = my_tree_->Prepare();
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_tree_->Launch();
+    EXPECT_TRUE(rc.IsOk());
+
+    DatasetIterator di(my_tree_);
+    TensorMap tensor_map;
+    rc = di.GetNextAsMap(&tensor_map);
+    EXPECT_TRUE(rc.IsOk());
+    while (tensor_map.size() != 0) {
+      std::shared_ptr<Tensor> image = tensor_map["image"];
+      EXPECT_TRUE(image->shape() == TensorShape({3, 4, 2}));
+      EXPECT_TRUE(image->type() == DataType::DE_FLOAT32);
+      std::vector<float> row;
+      for (auto itr = image->begin<float>(); itr != image->end<float>(); itr++) {
+        row.push_back(*itr);
+      }
+      rows->push_back(std::move(row));
+      rc = di.GetNextAsMap(&tensor_map);
+      EXPECT_TRUE(rc.IsOk());
+    }
+  };
+
+  std::vector<std::vector<float>> batch_rows, row_rows;
+  run(true, &batch_rows);
+  run(false, &row_rows);
+  EXPECT_EQ(batch_rows.size(), 10);
+  std::sort(batch_rows.begin(), batch_rows.end());
+  std::sort(row_rows.begin(), row_rows.end());
+  EXPECT_EQ(batch_rows, row_rows);
+}
+
+// TestAutoTuneResize scenario:
+//    ImageFolderOp -> MapOp(decode, performance mode) -> RepeatOp, read once without and once with autotune.
+//    While the tuned tree runs, the test also changes the active workers of the map and grows its output queues
+//    every few rows, on top of the changes of the tuner. The rows must come out the same and in the same order.
+TEST_F(MindDataTestMapOp, TestAutoTuneResize) {
+  MS_LOG(INFO) << "Doing TestAutoTuneResize.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  auto cfg = GlobalContext::config_manager();
+  bool original_autotune = cfg->enable_autotune();
+  uint32_t original_budget = cfg->autotune_cpu_budget();
+
+  auto run = [&folder_path](bool force_resize, std::vector<int32_t> *labels, std::string *images) {
+    std::shared_ptr<RepeatOp> repeat_op;
+    ASSERT_TRUE(RepeatOp::Builder(2).Build(&repeat_op).IsOk());
+    std::vector<std::shared_ptr<TensorOp>> func_list{std::make_shared<DecodeOp>()};
+    std::shared_ptr<MapOp> map_op;
+    MapOp::Builder builder;
+    builder.SetInColNames({"image"}).SetTensorFuncs(func_list).SetNumWorkers(2).SetOpConnectorSize(2);
+    ASSERT_TRUE(builder.Build(&map_op).IsOk());
+    auto tree = Build({ImageFolder(2, 2, 2, folder_path, false), map_op, repeat_op});
+    ASSERT_TRUE(tree->Prepare().IsOk());
+    ASSERT_TRUE(tree->Launch().IsOk());
+
+    DatasetIterator di(tree);
+    TensorMap tensor_map;
+    ASSERT_TRUE(di.GetNextAsMap(&tensor_map).IsOk());
+    int32_t row = 0;
+    while (!tensor_map.empty()) {
+      int32_t label = 0;
+      ASSERT_TRUE(tensor_map["label"]->GetItemAt<int32_t>(&label, {}).IsOk());
+      labels->push_back(label);
+      images->append(reinterpret_cast<const char *>(tensor_map["image"]->GetBuffer()), tensor_map["image"]->Size());
+      if (force_resize && ++row % 5 == 0) {
+        ASSERT_TRUE(map_op->SetNumActiveWorkers(1 + (row / 5) % map_op->num_workers()).IsOk());
+        ASSERT_TRUE(map_op->SetConnectorQueueCapacity(map_op->ConnectorQueueCapacity() + 1).IsOk());
+      }
+      ASSERT_TRUE(di.GetNextAsMap(&tensor_map).IsOk());
+    }
+  };
+
+  std::vector<int32_t> expect_labels;
+  std::string expect_images;
+  cfg->set_enable_autotune(false);
+  run(false, &expect_labels, &expect_images);
+  EXPECT_EQ(expect_labels.size(), 88);
+
+  std::vector<int32_t> labels;
+  std::string images;
+  cfg->set_enable_autotune(true);
+  cfg->set_autotune_cpu_budget(4);
+  run(true, &labels, &images);
+  cfg->set_enable_autotune(original_autotune);
+  cfg->set_autotune_cpu_budget(original_budget);
+
+  EXPECT_EQ(labels, expect_labels);
+  EXPECT_EQ(images.size(), expect_images.size());
+  EXPECT_TRUE(images == expect_images);
+}
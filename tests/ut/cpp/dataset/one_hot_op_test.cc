@@ -51,3 +51,42 @@ TEST_F(MindDataTestOneHotOp, TestOp) {
   ASSERT_TRUE(*output == *expected);
   MS_LOG(INFO) << "MindDataTestOneHotOp end.";
 }
+
+TEST_F(MindDataTestOneHotOp, TestComputeBatch) {
+  MS_LOG(INFO) << "Doing MindDataTestOneHotOp-TestComputeBatch.";
+  std::unique_ptr<OneHotOp> op(new OneHotOp(5));
+  uint64_t out[15] = {1, 0, 0, 0, 0,
+                      0, 1, 0, 0, 0,
+                      0, 0, 1, 0, 0};
+  std::shared_ptr<Tensor> expected = std::make_shared<Tensor>(TensorShape{3, 5}, DataType(DataType::DE_UINT64),
+                                                              reinterpret_cast <unsigned char *>(out));
+
+  // Three rows with one label each, encoded together
+  uint64_t labels[3] = {0, 1, 2};
+  TensorRow input, output;
+  input.push_back(std::make_shared<Tensor>(TensorShape({3, 1}), DataType(DataType::DE_UINT64),
+                                           reinterpret_cast <unsigned char *>(labels)));
+  Status s = op->ComputeBatch(input, &output);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(output.size(), 1);
+  ASSERT_TRUE(output[0]->shape() == expected->shape());
+  ASSERT_TRUE(*output[0] == *expected);
+
+  // Two rows with two labels each, encoded one row at a time
+  uint64_t labels2[4] = {0, 1, 2, 0};
+  input.clear();
+  input.push_back(std::make_shared<Tensor>(TensorShape({2, 2}), DataType(DataType::DE_UINT64),
+                                           reinterpret_cast <unsigned char *>(labels2)));
+  s = op->ComputeBatch(input, &output);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(output.size(), 1);
+  ASSERT_TRUE(output[0]->shape() == TensorShape({2, 2, 5}));
+  uint64_t out2[20] = {1, 0, 0, 0, 0,
+                       0, 1, 0, 0, 0,
+                       0, 0, 1, 0, 0,
+                       1, 0, 0, 0, 0};
+  expected = std::make_shared<Tensor>(TensorShape{2, 2, 5}, DataType(DataType::DE_UINT64),
+                                      reinterpret_cast <unsigned char *>(out2));
+  ASSERT_TRUE(*output[0] == *expected);
+  MS_LOG(INFO) << "MindDataTestOneHotOp-TestComputeBatch end.";
+}
@@ -169,6 +169,31 @@ TEST_F(MindDataTestQueue, Test6) {
   MS_LOG(INFO) << "Popped value " << *pepped_value << " from queue index " << chosen_queue_index;
   ASSERT_EQ(*pepped_value, 99);
 }
+
+TEST_F(MindDataTestQueue, Test7) {
+  // Resize a queue holding elements which wrap around the end of its array
+  Queue<int> que(3);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(que.Add(i).IsOk());
+  }
+  int v;
+  ASSERT_TRUE(que.PopFront(&v).IsOk());
+  ASSERT_TRUE(que.PopFront(&v).IsOk());
+  ASSERT_TRUE(que.Add(3).IsOk());
+  ASSERT_TRUE(que.Add(4).IsOk());
+  // The queue cannot shrink below its number of elements
+  ASSERT_TRUE(que.Resize(2).IsError());
+  ASSERT_TRUE(que.Resize(5).IsOk());
+  ASSERT_EQ(que.capacity(), 5);
+  ASSERT_EQ(que.size(), 3);
+  ASSERT_TRUE(que.Add(5).IsOk());
+  ASSERT_TRUE(que.Add(6).IsOk());
+  for (int i = 2; i <= 6; i++) {
+    ASSERT_TRUE(que.PopFront(&v).IsOk());
+    ASSERT_EQ(v, i);
+  }
+  ASSERT_TRUE(que.empty());
+}
 using namespace std::chrono;
 template <typename QueueType, typename PayloadType>
 void Perf(int n, int p, std::string name) {
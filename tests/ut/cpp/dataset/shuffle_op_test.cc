@@ -18,7 +18,10 @@
 #include "common/utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/dataset/engine/datasetops/source/random_data_op.h"
+#include "minddata/dataset/engine/data_schema.h"
 #include <memory>
+#include <string>
 #include <vector>
 #include <iostream>
 
@@ -333,3 +336,226 @@ TEST_F(MindDataTestShuffleOp, TestRepeatShuffle) {
   }
   ASSERT_EQ(row_count, 20);
 }
+
+// Runs shuffle over TFReader on testDataset1 and returns the rows in the order they come out.
+static std::vector<TensorRow> ShuffleTestDataset1(const std::string &dataset_path, int32_t memory_limit) {
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<TFReaderOp> my_tfreader_op;
+  Status rc = TFReaderOp::Builder()
+      .SetDatasetFilesList({dataset_path})
+      .SetRowsPerBuffer(3)
+      .SetWorkerConnectorSize(16)
+      .SetNumWorkers(1)
+      .Build(&my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<ShuffleOp> my_shuffle_op;
+  rc = ShuffleOp::Builder()
+      .SetShuffleSize(4)
+      .SetShuffleSeed(100)
+      .SetRowsPerBuffer(3)
+      .SetMemoryLimit(memory_limit)
+      .Build(&my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_shuffle_op->AddChild(my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  std::vector<TensorRow> rows;
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+  while (!tensor_list.empty()) {
+    rows.push_back(tensor_list);
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  return rows;
+}
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - A shuffle with a memory limit keeps its rows serialized in an arena, the rows it returns and their
+//   order must be the same as without a limit for the same seed.
+//
+// Tree: shuffle over TFReader
+//
+//    ShuffleOp
+//       |
+//    TFReaderOp
+//
+TEST_F(MindDataTestShuffleOp, TestShuffleMemoryLimit) {
+  MS_LOG(INFO) << "UT test TestShuffleMemoryLimit.";
+  std::string dataset_path = datasets_root_path_ + "/testDataset1/testDataset1.data";
+  std::vector<TensorRow> expected = ShuffleTestDataset1(dataset_path, 0);
+  std::vector<TensorRow> actual = ShuffleTestDataset1(dataset_path, 1);
+  ASSERT_EQ(expected.size(), 10);
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ(actual[i].size(), expected[i].size());
+    for (size_t j = 0; j < expected[i].size(); j++) {
+      EXPECT_TRUE(*actual[i][j] == *expected[i][j]);
+    }
+  }
+}
+
+// Replaces the label with a string tensor made from it, so that the rows also hold a string column.
+class LabelToStringOp : public TensorOp {
+ public:
+  LabelToStringOp() = default;
+
+  ~LabelToStringOp() override = default;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    uint32_t label = 0;
+    RETURN_IF_NOT_OK(input->GetItemAt(&label, {}));
+    std::vector<std::string> strings{"label", std::to_string(label), ""};
+    return Tensor::CreateTensor(output, strings, TensorShape({3}));
+  }
+
+  void Print(std::ostream &out) const override { out << "LabelToStringOp"; }
+
+  std::string Name() const override { return "LabelToStringOp"; }
+};
+
+// Runs RandomDataOp with a fixed seed and a map turning the labels into strings, through a shuffle spilling to /tmp
+// if shuffle is set, repeated twice, and returns the rows in the order they come out.
+static std::vector<TensorRow> SpillTestRows(bool shuffle) {
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(42);
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+  TensorShape image_shape({512, 1024});
+  Status rc =
+    schema->AddColumn(ColDescriptor("image", DataType(DataType::DE_UINT8), TensorImpl::kFlexible, 2, &image_shape));
+  EXPECT_TRUE(rc.IsOk());
+  TensorShape label_shape({});
+  rc = schema->AddColumn(ColDescriptor("label", DataType(DataType::DE_UINT32), TensorImpl::kFlexible, 0, &label_shape));
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<RandomDataOp> my_random_data_op;
+  rc = RandomDataOp::Builder()
+      .SetRowsPerBuffer(2)
+      .SetNumWorkers(1)
+      .SetDataSchema(std::move(schema))
+      .SetTotalRows(10)
+      .Build(&my_random_data_op);
+  EXPECT_TRUE(rc.IsOk());
+  GlobalContext::config_manager()->set_seed(original_seed);
+  rc = my_tree->AssociateNode(my_random_data_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<MapOp> my_map_op;
+  std::vector<std::shared_ptr<TensorOp>> my_func_list{std::make_shared<LabelToStringOp>()};
+  rc = MapOp::Builder()
+      .SetInColNames({"label"})
+      .SetTensorFuncs(std::move(my_func_list))
+      .SetNumWorkers(1)
+      .Build(&my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_map_op->AddChild(my_random_data_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<DatasetOp> repeat_child = my_map_op;
+  if (shuffle) {
+    std::shared_ptr<ShuffleOp> my_shuffle_op;
+    rc = ShuffleOp::Builder()
+        .SetShuffleSize(10)
+        .SetRowsPerBuffer(2)
+        .SetMemoryLimit(1)
+        .SetSpillDir("/tmp")
+        .Build(&my_shuffle_op);
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_tree->AssociateNode(my_shuffle_op);
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_shuffle_op->AddChild(my_map_op);
+    EXPECT_TRUE(rc.IsOk());
+    repeat_child = my_shuffle_op;
+  }
+  std::shared_ptr<RepeatOp> my_repeat_op;
+  rc = RepeatOp::Builder(2).Build(&my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_repeat_op->AddChild(repeat_child);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  std::vector<TensorRow> rows;
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+  while (!tensor_list.empty()) {
+    rows.push_back(tensor_list);
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  return rows;
+}
+
+// Test info:
+// - RandomDataOp makes 10 rows of 512KB images, and a map turns their labels into string tensors.
+// - The shuffle buffer holds every row but only has 1MB of memory, so most rows are spilled to disk.
+// - Repeated twice, the spilled rows of the first epoch are dropped before the second one.
+// - Every row of an epoch comes back exactly once through the spill file, with its data intact.
+//
+// Tree: repeat over shuffle over map over RandomData
+//
+//    RepeatOp
+//       |
+//    ShuffleOp
+//       |
+//     MapOp
+//       |
+//    RandomDataOp
+//
+TEST_F(MindDataTestShuffleOp, TestShuffleSpill) {
+  MS_LOG(INFO) << "UT test TestShuffleSpill.";
+  std::vector<TensorRow> expected = SpillTestRows(false);
+  std::vector<TensorRow> actual = SpillTestRows(true);
+  ASSERT_EQ(expected.size(), 20);
+  ASSERT_EQ(actual.size(), expected.size());
+  const size_t rows_per_epoch = 10;
+  for (size_t i = 0; i < actual.size(); i++) {
+    ASSERT_EQ(actual[i].size(), 2);
+    EXPECT_TRUE(actual[i][0]->shape() == TensorShape({512, 1024}));
+    EXPECT_TRUE(actual[i][0]->type() == DataType::DE_UINT8);
+    EXPECT_TRUE(actual[i][1]->shape() == TensorShape({3}));
+    EXPECT_TRUE(actual[i][1]->type() == DataType::DE_STRING);
+    EXPECT_EQ(actual[i][1]->SizeInBytes(), expected[i][1]->SizeInBytes());
+    std::string_view text;
+    ASSERT_TRUE(actual[i][1]->GetItemAt(&text, {0}).IsOk());
+    EXPECT_EQ(text, "label");
+    ASSERT_TRUE(actual[i][1]->GetItemAt(&text, {2}).IsOk());
+    EXPECT_TRUE(text.empty());
+  }
+  // The shuffle only reorders the rows of each epoch, match every input row with a distinct output row
+  for (size_t epoch = 0; epoch < expected.size() / rows_per_epoch; epoch++) {
+    std::vector<bool> matched(rows_per_epoch, false);
+    for (size_t i = epoch * rows_per_epoch; i < (epoch + 1) * rows_per_epoch; i++) {
+      bool found = false;
+      for (size_t j = 0; j < rows_per_epoch && !found; j++) {
+        const TensorRow &row = actual[epoch * rows_per_epoch + j];
+        if (!matched[j] && *row[0] == *expected[i][0] && *row[1] == *expected[i][1]) {
+          matched[j] = true;
+          found = true;
+        }
+      }
+      EXPECT_TRUE(found) << "row " << i << " did not come back from the shuffle";
+    }
+  }
+}
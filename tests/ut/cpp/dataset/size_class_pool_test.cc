@@ -0,0 +1,112 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+#include "minddata/dataset/util/size_class_pool.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestSizeClassPool : public UT::Common {
+ public:
+  MindDataTestSizeClassPool() {}
+};
+
+TEST_F(MindDataTestSizeClassPool, TestSizeClasses) {
+  // Every request fits its class, and a class wastes at most a quarter of the request
+  for (size_t n = 1; n <= SizeClassPool::kMaxPooledSize; n = n * 5 / 4 + 1) {
+    size_t sz = SizeClassPool::ClassToSize(SizeClassPool::SizeToClass(n));
+    ASSERT_GE(sz, n);
+    if (n > 64) {
+      ASSERT_LT(sz, n + n / 4 + 1);
+    }
+  }
+  for (uint32_t c = 1; c <= SizeClassPool::SizeToClass(SizeClassPool::kMaxPooledSize); c++) {
+    ASSERT_EQ(SizeClassPool::SizeToClass(SizeClassPool::ClassToSize(c)), c);
+    ASSERT_EQ(SizeClassPool::SizeToClass(SizeClassPool::ClassToSize(c - 1) + 1), c);
+  }
+}
+
+TEST_F(MindDataTestSizeClassPool, TestReuse) {
+  SizeClassPool pool;
+  void *p = nullptr;
+  ASSERT_TRUE(pool.Allocate(1000, &p).IsOk());
+  memset(p, 1, 1000);
+  pool.Deallocate(p);
+  void *q = nullptr;
+  // Same class, same thread: the freed block comes back
+  ASSERT_TRUE(pool.Allocate(1010, &q).IsOk());
+  EXPECT_EQ(p, q);
+  SizeClassPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 1);
+
+  // Growing within the class keeps the block, growing past it moves the data
+  memset(q, 7, 1010);
+  ASSERT_TRUE(pool.Reallocate(&q, 1010, 1024).IsOk());
+  EXPECT_EQ(p, q);
+  ASSERT_TRUE(pool.Reallocate(&q, 1024, 100000).IsOk());
+  EXPECT_EQ(static_cast<unsigned char *>(q)[1009], 7);
+  pool.Deallocate(q);
+
+  // Larger requests are not pooled
+  ASSERT_TRUE(pool.Allocate(SizeClassPool::kMaxPooledSize + 1, &p).IsOk());
+  pool.Deallocate(p);
+}
+
+TEST_F(MindDataTestSizeClassPool, TestThreads) {
+  // A small thread cache so that blocks keep moving through the central cache
+  SizeClassPool pool(1024 * 1024, 8 * 1024 * 1024);
+  auto worker = [&pool](int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<size_t> dist(1, 256 * 1024);
+    std::vector<std::pair<unsigned char *, size_t>> live;
+    for (int i = 0; i < 20000; i++) {
+      if (live.size() < 64 && (live.empty() || gen() % 2 == 0)) {
+        size_t n = dist(gen);
+        void *p = nullptr;
+        ASSERT_TRUE(pool.Allocate(n, &p).IsOk());
+        memset(p, seed, n);
+        live.emplace_back(static_cast<unsigned char *>(p), n);
+      } else {
+        size_t k = gen() % live.size();
+        ASSERT_EQ(live[k].first[0], static_cast<unsigned char>(seed));
+        ASSERT_EQ(live[k].first[live[k].second - 1], static_cast<unsigned char>(seed));
+        pool.Deallocate(live[k].first);
+        live[k] = live.back();
+        live.pop_back();
+      }
+    }
+    for (auto &b : live) {
+      pool.Deallocate(b.first);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back(worker, i + 1);
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  SizeClassPool::Stats stats = pool.GetStats();
+  MS_LOG(INFO) << "hits " << stats.hits << " misses " << stats.misses << " cached " << stats.cached_bytes;
+  EXPECT_GT(stats.hits, stats.misses);
+  EXPECT_LE(stats.cached_bytes, 8 * 1024 * 1024);
+}
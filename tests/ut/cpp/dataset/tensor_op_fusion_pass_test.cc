@@ -15,12 +15,23 @@
  */
 
 #include <memory>
+#include <random>
 #include <string>
+#include <vector>
 #include "minddata/dataset/core/client.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/center_crop_op.h"
+#include "minddata/dataset/kernels/image/fused_crop_flip_op.h"
+#include "minddata/dataset/kernels/image/fused_normalize_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/random_crop_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/random_vertical_flip_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+#include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 
@@ -33,6 +44,43 @@ class MindDataTestTensorOpFusionPass : public UT::DatasetOpTesting {
  public:
   MindDataTestTensorOpFusionPass() = default;
   void SetUp() override { GlobalInit(); }
+
+  // Run the fusion pass on a MapOp with the given tensor ops and return the names of the resulting ops
+  std::vector<std::string> Fuse(std::vector<std::shared_ptr<TensorOp>> func_list) {
+    std::shared_ptr<MapOp> map_op;
+    MapOp::Builder builder;
+    builder.SetInColNames({}).SetOutColNames({}).SetTensorFuncs(std::move(func_list)).SetNumWorkers(4);
+    EXPECT_TRUE(builder.Build(&map_op).IsOk());
+    bool modified = false;
+    EXPECT_TRUE(TensorOpFusionPass().RunOnNode(map_op, &modified).IsOk());
+    std::vector<std::string> names;
+    for (auto &op : map_op->TFuncs()) {
+      names.push_back(op->Name());
+    }
+    return names;
+  }
+
+  // A random uint8 image of shape <h,w,3>
+  std::shared_ptr<Tensor> RandomImage(dsize_t h, dsize_t w) {
+    std::shared_ptr<Tensor> image;
+    EXPECT_TRUE(
+      Tensor::CreateTensor(&image, TensorImpl::kFlexible, TensorShape({h, w, 3}), DataType(DataType::DE_UINT8)).IsOk());
+    std::mt19937 gen(h * w);
+    for (auto it = image->begin<uint8_t>(); it != image->end<uint8_t>(); ++it) {
+      *it = static_cast<uint8_t>(gen() % 256);
+    }
+    return image;
+  }
+
+  // Run the ops one after another
+  std::shared_ptr<Tensor> RunOps(const std::vector<std::shared_ptr<TensorOp>> &ops, std::shared_ptr<Tensor> input) {
+    for (auto &op : ops) {
+      std::shared_ptr<Tensor> output;
+      EXPECT_TRUE(op->Compute(input, &output).IsOk());
+      input = output;
+    }
+    return input;
+  }
 };
 
 TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResize_fusion_disabled) {
@@ -102,4 +150,70 @@ TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResize_fusion_enabled) {
   auto func_it = tfuncs.begin();
   EXPECT_EQ((*func_it)->Name(), kRandomCropDecodeResizeOp);
   EXPECT_EQ(++func_it, tfuncs.end());
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, Normalize_fusion) {
+  MS_LOG(INFO) << "Doing Normalize_fusion";
+  auto names = Fuse({std::make_shared<DecodeOp>(), std::make_shared<ResizeOp>(32, 32),
+                     std::make_shared<NormalizeOp>(121.0, 115.0, 100.0, 70.0, 68.0, 71.0),
+                     std::make_shared<HwcToChwOp>(), std::make_shared<RandomHorizontalFlipOp>()});
+  EXPECT_EQ(names, std::vector<std::string>({kFusedNormalizeOp, kRandomHorizontalFlipOp}));
+
+  names =
+    Fuse({std::make_shared<RescaleOp>(1.0 / 255, 0.0), std::make_shared<NormalizeOp>(0.5, 0.5, 0.5, 0.2, 0.2, 0.2)});
+  EXPECT_EQ(names, std::vector<std::string>({kFusedNormalizeOp}));
+
+  // A lone NormalizeOp is left alone
+  names = Fuse({std::make_shared<NormalizeOp>(0.5, 0.5, 0.5, 0.2, 0.2, 0.2), std::make_shared<ResizeOp>(32, 32)});
+  EXPECT_EQ(names, std::vector<std::string>({kNormalizeOp, kResizeOp}));
+
+  // The fused op gives the same output as the ops it replaces
+  std::vector<std::shared_ptr<TensorOp>> ops = {std::make_shared<RescaleOp>(1.0 / 255, 0.1),
+                                                std::make_shared<NormalizeOp>(0.4, 0.5, 0.6, 0.2, 0.3, 0.25),
+                                                std::make_shared<HwcToChwOp>()};
+  auto fused = std::make_shared<FusedNormalizeOp>(nullptr, nullptr, static_cast<RescaleOp *>(ops[0].get()),
+                                                  *static_cast<NormalizeOp *>(ops[1].get()), true);
+  auto image = RandomImage(17, 23);
+  std::shared_ptr<Tensor> expected = RunOps(ops, image);
+  std::shared_ptr<Tensor> output;
+  ASSERT_TRUE(fused->Compute(image, &output).IsOk());
+  ASSERT_EQ(output->shape(), expected->shape());
+  ASSERT_EQ(output->type(), expected->type());
+  for (auto it = output->begin<float>(), jt = expected->begin<float>(); it != output->end<float>(); ++it, ++jt) {
+    EXPECT_NEAR(*it, *jt, 1e-4);
+  }
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, CropFlip_fusion) {
+  MS_LOG(INFO) << "Doing CropFlip_fusion";
+  auto names = Fuse({std::make_shared<DecodeOp>(), std::make_shared<CenterCropOp>(64),
+                     std::make_shared<RandomHorizontalFlipOp>(), std::make_shared<RandomCropOp>(32, 32),
+                     std::make_shared<RandomVerticalFlipOp>(), std::make_shared<RescaleOp>(1.0 / 255, 0.0),
+                     std::make_shared<NormalizeOp>(0.5, 0.5, 0.5, 0.2, 0.2, 0.2)});
+  EXPECT_EQ(names, std::vector<std::string>({kDecodeOp, kFusedCropFlipOp, kFusedNormalizeOp}));
+
+  // A crop which pads the image prevents the fusion
+  names = Fuse({std::make_shared<RandomHorizontalFlipOp>(), std::make_shared<RandomCropOp>(32, 32, 4, 4, 4, 4)});
+  EXPECT_EQ(names, std::vector<std::string>({kRandomHorizontalFlipOp, kRandomCropOp}));
+
+  // With the same seed, the fused chain makes the same random choices as the ops run one after another. The last
+  // center crop is larger than its input and pads it, which the fused op leaves to the CenterCropOp itself.
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(7);
+  auto make_ops = []() -> std::vector<std::shared_ptr<TensorOp>> {
+    return {std::make_shared<RandomVerticalFlipOp>(),   std::make_shared<RandomCropOp>(40, 30),
+            std::make_shared<RandomHorizontalFlipOp>(), std::make_shared<CenterCropOp>(21, 17),
+            std::make_shared<RandomHorizontalFlipOp>(), std::make_shared<RandomCropOp>(15, 16),
+            std::make_shared<CenterCropOp>(20, 20)};
+  };
+  std::vector<std::shared_ptr<TensorOp>> ops = make_ops();
+  auto fused = std::make_shared<FusedCropFlipOp>(make_ops());
+  GlobalContext::config_manager()->set_seed(original_seed);
+  for (int i = 0; i < 20; i++) {
+    auto image = RandomImage(48 + i, 36 + i);
+    std::shared_ptr<Tensor> expected = RunOps(ops, image);
+    std::shared_ptr<Tensor> output;
+    ASSERT_TRUE(fused->Compute(image, &output).IsOk());
+    EXPECT_TRUE(*output == *expected);
+  }
+}
@@ -446,3 +446,49 @@ TEST_F(MindDataTestTensorDE, TensorEmptyInvalidate) {
   ASSERT_TRUE(t->HasData());
 }
 
+TEST_F(MindDataTestTensorDE, TensorRowView) {
+  std::vector<uint32_t> values = {1, 2, 3, 4, 5, 6};
+  std::shared_ptr<Tensor> t;
+  Tensor::CreateTensor(&t, values, TensorShape({3, 2}));
+  std::shared_ptr<Tensor> view;
+  ASSERT_TRUE(Tensor::CreateRowView(&view, t, 1).IsOk());
+  ASSERT_EQ(view->shape(), TensorShape({2}));
+  ASSERT_EQ(view->GetBuffer(), t->GetBuffer() + 2 * sizeof(uint32_t));
+  uint32_t o;
+  view->GetItemAt<uint32_t>(&o, {1});
+  ASSERT_EQ(o, 4);
+  // The view keeps the memory of the row alive
+  const unsigned char *row = view->GetBuffer();
+  t.reset();
+  ASSERT_EQ(view->GetBuffer(), row);
+  view->GetItemAt<uint32_t>(&o, {0});
+  ASSERT_EQ(o, 3);
+  ASSERT_FALSE(Tensor::CreateRowView(&t, view, 2).IsOk());
+}
+
+TEST_F(MindDataTestTensorDE, TensorPlacement) {
+  std::shared_ptr<Tensor> batch;
+  Tensor::CreateTensor(&batch, TensorImpl::kFlexible, TensorShape({4, 2, 3}), DataType(DataType::DE_FLOAT32));
+  std::shared_ptr<Tensor> placed, other;
+  {
+    Tensor::Placement placement(batch, 2);
+    // A buffer of another size does not take the row
+    Tensor::CreateTensor(&other, TensorImpl::kCv, TensorShape({2, 2}), DataType(DataType::DE_FLOAT32));
+    ASSERT_FALSE(placement.taken());
+    Tensor::CreateTensor(&placed, TensorImpl::kCv, TensorShape({2, 3}), DataType(DataType::DE_FLOAT32));
+    ASSERT_TRUE(placement.taken());
+    ASSERT_EQ(placed->GetBuffer(), placement.data());
+    // The row is lent once
+    Tensor::CreateTensor(&other, TensorImpl::kCv, TensorShape({3, 2}), DataType(DataType::DE_FLOAT32));
+    ASSERT_NE(other->GetBuffer(), placement.data());
+  }
+  ASSERT_EQ(placed->GetBuffer(), batch->GetBuffer() + 2 * 6 * sizeof(float));
+  placed->SetItemAt<float>({1, 2}, 1.5);
+  float o;
+  batch->GetItemAt<float>(&o, {2, 1, 2});
+  ASSERT_EQ(o, 1.5);
+  // The placement has ended, so the next buffer of the size is allocated as usual
+  Tensor::CreateTensor(&other, TensorImpl::kCv, TensorShape({2, 3}), DataType(DataType::DE_FLOAT32));
+  ASSERT_TRUE(other->GetBuffer() < batch->GetBuffer() ||
+              other->GetBuffer() >= batch->GetBuffer() + batch->SizeInBytes());
+}
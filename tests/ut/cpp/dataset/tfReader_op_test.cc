@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -731,3 +733,51 @@ TEST_F(MindDataTestTFReaderOp, TestTFReaderInvalidFiles) {
   rc = builder.Build(&my_tfreader_op);
   ASSERT_TRUE(!rc.IsOk());
 }
+
+TEST_F(MindDataTestTFReaderOp, TestTFReaderCheckCrc) {
+  std::string schema_file = datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json";
+  std::string valid_file = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+  std::string corrupted_file = "./tf_reader_check_crc.data";
+
+  // flip a byte in the data of the first record, the crc of its length is still valid
+  {
+    std::ifstream in(valid_file, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ASSERT_GT(content.size(), 64);
+    content[sizeof(int64_t) + sizeof(int32_t) + 8] ^= 0x01;
+    std::ofstream out(corrupted_file, std::ios::binary);
+    out.write(content.data(), content.size());
+  }
+
+  for (const auto &file : {valid_file, corrupted_file}) {
+    auto my_tree = std::make_shared<ExecutionTree>();
+    std::shared_ptr<TFReaderOp> my_tfreader_op;
+    TFReaderOp::Builder builder;
+    builder.SetDatasetFilesList({file}).SetRowsPerBuffer(16).SetNumWorkers(1).SetCheckCrc(true);
+    std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+    schema->LoadSchemaFile(schema_file, {});
+    builder.SetDataSchema(std::move(schema));
+    ASSERT_TRUE(builder.Build(&my_tfreader_op).IsOk());
+    ASSERT_TRUE(my_tree->AssociateNode(my_tfreader_op).IsOk());
+    ASSERT_TRUE(my_tree->AssignRoot(my_tfreader_op).IsOk());
+    ASSERT_TRUE(my_tree->Prepare().IsOk());
+    ASSERT_TRUE(my_tree->Launch().IsOk());
+
+    DatasetIterator di(my_tree);
+    TensorRow tensor_list;
+    Status rc = di.FetchNextTensorRow(&tensor_list);
+    int row_count = 0;
+    while (rc.IsOk() && !tensor_list.empty()) {
+      row_count++;
+      rc = di.FetchNextTensorRow(&tensor_list);
+    }
+
+    if (file == valid_file) {
+      ASSERT_TRUE(rc.IsOk());
+      ASSERT_EQ(row_count, 12);
+    } else {
+      ASSERT_FALSE(rc.IsOk());
+    }
+  }
+  (void)remove(corrupted_file.c_str());
+}
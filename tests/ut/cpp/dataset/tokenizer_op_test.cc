@@ -26,6 +26,8 @@
 #include "minddata/dataset/text/kernels/unicode_char_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_script_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/whitespace_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
+#include "minddata/dataset/text/vocab.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
@@ -356,4 +358,64 @@ TEST_F(MindDataTestTokenizerOp, TestBasicTokenizer) {
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestTokenizerOp, TestBasicTokenizerAscii) {
+  MS_LOG(INFO) << "Doing TestBasicTokenizerAscii.";
+  // ASCII text takes a path of its own, which has to split the same as the regex for any other text
+  std::string text = "[CLS] Hello,World!  [unused12] [unused] [MASK]x\tA.B";
+  for (bool lower_case : {false, true}) {
+    for (bool keep_whitespace : {false, true}) {
+      for (bool preserve_unused_token : {false, true}) {
+        BasicTokenizerOp op(lower_case, keep_whitespace, NormalizeForm::kNone, preserve_unused_token, true);
+        TensorRow ascii_output, output;
+        Status s = op.Compute(TensorRow(0, {std::make_shared<Tensor>(text)}), &ascii_output);
+        EXPECT_TRUE(s.IsOk());
+        s = op.Compute(TensorRow(0, {std::make_shared<Tensor>(text + " 中")}), &output);
+        EXPECT_TRUE(s.IsOk());
+        ASSERT_EQ(ascii_output[0]->Size() + 1, output[0]->Size() - (keep_whitespace ? 1 : 0));
+        for (dsize_t i = 0; i < ascii_output[0]->Size(); i++) {
+          std::string_view token;
+          EXPECT_TRUE(ascii_output[0]->GetItemAt(&token, {i}).IsOk());
+          CheckEqual(output[0], {i}, std::string(token));
+          uint32_t ascii_offset = 0, offset = 0;
+          EXPECT_TRUE(ascii_output[1]->GetItemAt(&ascii_offset, {i}).IsOk());
+          EXPECT_TRUE(output[1]->GetItemAt(&offset, {i}).IsOk());
+          EXPECT_EQ(ascii_offset, offset);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizer) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizer.";
+  std::unordered_map<WordType, WordIdType> words{{"u", 0},   {"un", 1}, {"##aff", 2}, {"##able", 3},
+                                                 {"[UNK]", 4}, {"床", 5}, {"##前", 6}};
+  auto vocab = std::make_shared<Vocab>(words);
+  EXPECT_EQ(vocab->Lookup("##aff"), 2);
+  EXPECT_EQ(vocab->Lookup("##af"), Vocab::kNoTokenExists);
+  size_t len = 0;
+  EXPECT_EQ(vocab->LongestPrefix("", "unaffable", &len), 1);
+  EXPECT_EQ(len, 2);
+  EXPECT_EQ(vocab->LongestPrefix("##", "affable", &len), 2);
+  EXPECT_EQ(len, 3);
+  EXPECT_EQ(vocab->LongestPrefix("##", "un", &len), Vocab::kNoTokenExists);
+  EXPECT_EQ(len, 0);
+
+  WordpieceTokenizerOp op(vocab);
+  std::vector<std::string> tokens{"unaffable", "床前", "unable", "ux"};
+  std::shared_ptr<Tensor> input = std::make_shared<Tensor>(tokens, TensorShape({4}));
+  TensorRow output;
+  Status s = op.Compute(TensorRow(0, {input}), &output);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(output[0]->Size(), 8);
+  CheckEqual(output[0], {0}, "un");
+  CheckEqual(output[0], {1}, "##aff");
+  CheckEqual(output[0], {2}, "##able");
+  CheckEqual(output[0], {3}, "床");
+  CheckEqual(output[0], {4}, "##前");
+  CheckEqual(output[0], {5}, "un");
+  CheckEqual(output[0], {6}, "##able");
+  CheckEqual(output[0], {7}, "[UNK]");
+}
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "ir/primitive_py.h"
+#include "pipeline/jit/parse/python_adapter.h"
+#include "backend/session/kernel_graph.h"
+#include "runtime/device/cpu/cpu_kernel_scheduler.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class CPUKernelSchedulerTest : public UT::Common {
+ public:
+  CPUKernelSchedulerTest() = default;
+  void SetUp() override { (void)setenv("MS_CPU_LAUNCH_THREAD_NUM", "3", 1); }
+  void TearDown() override { (void)unsetenv("MS_CPU_LAUNCH_THREAD_NUM"); }
+};
+
+// A SparseApplyAdam updating var in place sits between two kernels reading var, with no data edge between any of
+// them. The update must start after the first read ends, and the second read after the update ends.
+TEST_F(CPUKernelSchedulerTest, InPlaceWriterKeepsOrder) {
+  auto graph = std::make_shared<session::KernelGraph>();
+  auto var = graph->add_parameter();
+  auto x = graph->add_parameter();
+  py::object adam_obj = parse::python_adapter::GetPyFn("mindspore.ops.operations", "SparseApplyAdam")();
+  auto adam = py::cast<PrimitivePyPtr>(adam_obj);
+  ASSERT_TRUE(adam != nullptr);
+  auto reader = graph->NewCNode({NewValueNode(prim::kPrimTensorAdd), x, var});
+  auto writer = graph->NewCNode({NewValueNode(adam), var, x});
+  auto reader_after = graph->NewCNode({NewValueNode(prim::kPrimTensorAdd), x, var});
+  std::vector<CNodePtr> kernels{reader, writer, reader_after};
+
+  CPUKernelScheduler scheduler;
+  ASSERT_TRUE(scheduler.enable_parallel());
+  std::atomic<bool> reader_done{false};
+  std::atomic<bool> writer_done{false};
+  std::atomic<bool> in_order{true};
+  KernelLaunchFunc launch = [&](const CNodePtr &kernel) {
+    if (kernel == reader) {
+      // long enough for an unfenced writer to start meanwhile
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      reader_done = true;
+    } else if (kernel == writer) {
+      in_order = in_order && reader_done;
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      writer_done = true;
+    } else {
+      in_order = in_order && writer_done;
+    }
+    return true;
+  };
+  scheduler.Run(graph.get(), kernels, {}, launch);
+  EXPECT_TRUE(in_order);
+  EXPECT_TRUE(writer_done);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
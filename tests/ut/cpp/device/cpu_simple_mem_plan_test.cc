@@ -0,0 +1,92 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class CPUSimpleMemPlanTest : public UT::Common {
+ public:
+  CPUSimpleMemPlanTest() = default;
+
+  static MemBlockLife Block(size_t size, size_t first_use, size_t last_use) {
+    MemBlockLife block;
+    block.size = size;
+    block.first_use = first_use;
+    block.last_use = last_use;
+    return block;
+  }
+
+  // the planner keeps every block on a 64 bytes boundary
+  static size_t End(const MemBlockLife &block) { return block.offset + (block.size + 63) / 64 * 64; }
+};
+
+// Blocks alive at the same position of the execution order must not share a byte of the arena
+TEST_F(CPUSimpleMemPlanTest, OverlappingLivesNeverShare) {
+  std::vector<MemBlockLife> blocks;
+  for (size_t i = 0; i < 40; ++i) {
+    size_t first_use = (i * 7) % 23;
+    blocks.push_back(Block(((i * 131) % 17 + 1) * 100, first_use, first_use + (i * 5) % 9));
+  }
+  CPUSimpleMemPlan plan;
+  size_t total = plan.AssignOffsetBestFit(&blocks);
+
+  size_t naive = 0;
+  for (const auto &block : blocks) {
+    naive += (block.size + 63) / 64 * 64;
+    EXPECT_LE(End(block), total);
+  }
+  EXPECT_LE(total, naive);
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    for (size_t j = i + 1; j < blocks.size(); ++j) {
+      const auto &a = blocks[i];
+      const auto &b = blocks[j];
+      bool alive_together = a.first_use <= b.last_use && b.first_use <= a.last_use;
+      if (alive_together) {
+        EXPECT_TRUE(End(a) <= b.offset || End(b) <= a.offset) << "blocks " << i << " and " << j << " overlap";
+      }
+    }
+  }
+}
+
+// Blocks whose lives do not meet reuse the same memory
+TEST_F(CPUSimpleMemPlanTest, DisjointLivesReuseMemory) {
+  // a chain of kernels, each output read by the next kernel only
+  std::vector<MemBlockLife> chain{Block(1024, 0, 1), Block(1024, 1, 2), Block(1024, 2, 3), Block(1024, 3, 4)};
+  CPUSimpleMemPlan plan;
+  EXPECT_EQ(plan.AssignOffsetBestFit(&chain), 2048);
+  EXPECT_EQ(chain[0].offset, chain[2].offset);
+  EXPECT_EQ(chain[1].offset, chain[3].offset);
+  EXPECT_NE(chain[0].offset, chain[1].offset);
+
+  // a small block dead before a large one is born fits in the memory of the large one
+  std::vector<MemBlockLife> blocks{Block(4096, 5, 8), Block(512, 0, 2), Block(1000, 3, 4)};
+  EXPECT_EQ(plan.AssignOffsetBestFit(&blocks), 4096);
+
+  // without reuse every block has its own memory
+  std::vector<MemBlockLife> sequential{Block(1024, 0, 1), Block(1024, 2, 3)};
+  EXPECT_EQ(plan.AssignOffsetSequential(&sequential), 2048);
+  EXPECT_NE(sequential[0].offset, sequential[1].offset);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
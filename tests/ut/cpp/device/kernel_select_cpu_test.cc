@@ -0,0 +1,109 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "ir/manager.h"
+#include "backend/session/kernel_graph.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "runtime/device/cpu/kernel_select_cpu.h"
+
+namespace mindspore {
+namespace kernel {
+class DtypeTestCPUKernel : public CPUKernel {
+ public:
+  DtypeTestCPUKernel() = default;
+  ~DtypeTestCPUKernel() override = default;
+  void InitKernel(const CNodePtr &kernel_node) override {}
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override {
+    return true;
+  }
+};
+
+MS_REG_CPU_KERNEL(Float16OnlyTest, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+                  DtypeTestCPUKernel);
+MS_REG_CPU_KERNEL(Float32OnlyTest, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  DtypeTestCPUKernel);
+MS_REG_CPU_KERNEL(AnyFloatTest, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  DtypeTestCPUKernel);
+MS_REG_CPU_KERNEL(AnyFloatTest, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+                  DtypeTestCPUKernel);
+}  // namespace kernel
+
+namespace device {
+namespace cpu {
+using AnfAlgo = session::AnfRuntimeAlgorithm;
+
+class KernelSelectCPUTest : public UT::Common {
+ public:
+  KernelSelectCPUTest() = default;
+
+  // One float32 parameter read by the two kernels, whose outputs are the outputs of the graph.
+  std::vector<CNodePtr> BuildSharedInputGraph(const std::string &first, const std::string &second) {
+    graph_ = std::make_shared<session::KernelGraph>();
+    std::vector<int> shp{2, 3};
+    auto abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+    x_ = graph_->NewParameter();
+    x_->set_abstract(abstract);
+    std::vector<CNodePtr> kernels;
+    for (const auto &name : {first, second}) {
+      auto kernel = graph_->NewCNode({NewValueNode(std::make_shared<Primitive>(name)), x_});
+      kernel->set_abstract(abstract);
+      kernels.push_back(kernel);
+    }
+    graph_->set_output(graph_->NewCNode({NewValueNode(prim::kPrimMakeTuple), kernels[0], kernels[1]}));
+    manager_ = Manage(graph_);
+    return kernels;
+  }
+
+  std::shared_ptr<session::KernelGraph> graph_;
+  FuncGraphManagerPtr manager_;
+  ParameterPtr x_;
+};
+
+// The float16 kernel binds x as float16, so the other kernel has to read it as float16 as well.
+TEST_F(KernelSelectCPUTest, SharedInputKeepsOneDtype) {
+  auto kernels = BuildSharedInputGraph("Float16OnlyTest", "AnyFloatTest");
+  InputDeviceTypes input_device_types;
+  for (const auto &kernel : kernels) {
+    SetKernelInfo(kernel, &input_device_types);
+  }
+  EXPECT_EQ(AnfAlgo::GetOutputDeviceDataType(x_, 0), kNumberTypeFloat16);
+  for (const auto &kernel : kernels) {
+    EXPECT_EQ(AnfAlgo::GetInputDeviceDataType(kernel, 0), kNumberTypeFloat16);
+    EXPECT_EQ(AnfAlgo::GetOutputDeviceDataType(kernel, 0), kNumberTypeFloat16);
+  }
+}
+
+// Without a cast kernel, a float16 kernel and a float32 kernel can not share a graph input. The selection has to
+// fail instead of letting one of them read the memory of the other dtype.
+TEST_F(KernelSelectCPUTest, SharedInputDtypeConflict) {
+  for (bool float16_first : {true, false}) {
+    auto kernels = float16_first ? BuildSharedInputGraph("Float16OnlyTest", "Float32OnlyTest")
+                                 : BuildSharedInputGraph("Float32OnlyTest", "Float16OnlyTest");
+    InputDeviceTypes input_device_types;
+    SetKernelInfo(kernels[0], &input_device_types);
+    EXPECT_ANY_THROW(SetKernelInfo(kernels[1], &input_device_types));
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
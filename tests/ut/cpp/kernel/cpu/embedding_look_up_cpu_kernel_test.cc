@@ -0,0 +1,136 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "ir/tensor.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class EmbeddingLookUpCpuKernelTest : public UT::Common {
+ public:
+  EmbeddingLookUpCpuKernelTest() : embedding_look_up_(std::make_shared<EmbeddingLookUpCPUKernel>()) {}
+
+  void SetUp() override {
+    input_.clear();
+    output_.clear();
+    inputs_.clear();
+    workspace_.clear();
+    outputs_.clear();
+  }
+
+  AddressPtr CreateKernelAddress(void *addr) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    return kernel_addr;
+  }
+
+  // a [vocab_size, row_size] table whose elements tell their row and column
+  void CreateTable(size_t vocab_size, size_t row_size) {
+    for (size_t i = 0; i < vocab_size; ++i) {
+      for (size_t j = 0; j < row_size; ++j) {
+        input_.push_back(i * 1000 + j);
+      }
+    }
+    embedding_look_up_->input_shape_ = {1, 1, vocab_size, row_size};
+    embedding_look_up_->input_lens_ = vocab_size * row_size;
+    embedding_look_up_->axis_ = 2;
+  }
+
+  void Run(std::vector<int> &indices, size_t row_size) {
+    embedding_look_up_->indices_lens_ = indices.size();
+    output_.assign(indices.size() * row_size, -1);
+    inputs_.push_back(CreateKernelAddress(input_.data()));
+    inputs_.push_back(CreateKernelAddress(indices.data()));
+    outputs_.push_back(CreateKernelAddress(output_.data()));
+    embedding_look_up_->Launch(inputs_, workspace_, outputs_);
+  }
+
+  void CheckOutput(const std::vector<int> &indices, size_t vocab_size, size_t row_size, int offset) {
+    for (size_t i = 0; i < indices.size(); ++i) {
+      int row = indices[i] - offset;
+      for (size_t j = 0; j < row_size; ++j) {
+        float expect = row >= 0 && row < SizeToInt(vocab_size) ? row * 1000 + j : 0;
+        EXPECT_EQ(output_[i * row_size + j], expect);
+      }
+    }
+  }
+
+  std::vector<float> input_;
+  std::vector<float> output_;
+  std::vector<AddressPtr> inputs_;
+  std::vector<AddressPtr> workspace_;
+  std::vector<AddressPtr> outputs_;
+  std::shared_ptr<EmbeddingLookUpCPUKernel> embedding_look_up_;
+};
+
+TEST_F(EmbeddingLookUpCpuKernelTest, look_up_small_batch) {
+  CreateTable(10, 3);
+  std::vector<int> indices{0, 9, 3, 3, -1, 10, 7, 0};
+  Run(indices, 3);
+  CheckOutput(indices, 10, 3, 0);
+}
+
+TEST_F(EmbeddingLookUpCpuKernelTest, look_up_small_batch_with_offset) {
+  CreateTable(10, 3);
+  embedding_look_up_->offset_ = 5;
+  std::vector<int> indices{5, 14, 4, 15, 9, 9};
+  Run(indices, 3);
+  CheckOutput(indices, 10, 3, 5);
+}
+
+TEST_F(EmbeddingLookUpCpuKernelTest, look_up_big_batch_with_repeated_ids) {
+  CreateTable(3000, 20);
+  embedding_look_up_->offset_ = 100;
+  std::vector<int> indices;
+  for (size_t i = 0; i < 20000; ++i) {
+    // ids repeat, go out of the table on both sides and come in no particular order
+    indices.push_back((i * 7919) % 3300);
+  }
+  Run(indices, 20);
+  CheckOutput(indices, 3000, 20, 100);
+
+  output_.assign(indices.size() * 20, -1);
+  embedding_look_up_->GatherRowsByRow(input_.data(), indices.data(), output_.data());
+  CheckOutput(indices, 3000, 20, 100);
+}
+
+TEST_F(EmbeddingLookUpCpuKernelTest, look_up_float16_table) {
+  CreateTable(10, 3);
+  std::vector<float16> table(input_.begin(), input_.end());
+  std::vector<float16> output(24, float16(-1.0f));
+  std::vector<int> indices{0, 9, 3, 3, -1, 10, 7, 0};
+  embedding_look_up_->dtype_ = kNumberTypeFloat16;
+  embedding_look_up_->indices_lens_ = indices.size();
+  inputs_.push_back(CreateKernelAddress(table.data()));
+  inputs_.push_back(CreateKernelAddress(indices.data()));
+  outputs_.push_back(CreateKernelAddress(output.data()));
+  embedding_look_up_->Launch(inputs_, workspace_, outputs_);
+  // the rows are copied bit for bit
+  for (size_t i = 0; i < indices.size(); ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      float expect = indices[i] >= 0 && indices[i] < 10 ? static_cast<float>(table[indices[i] * 3 + j]) : 0;
+      EXPECT_EQ(static_cast<float>(output[i * 3 + j]), expect);
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,189 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/tensor.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/fused_elemwise_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class FusedElemwiseCpuKernelTest : public UT::Common {
+ public:
+  FusedElemwiseCpuKernelTest() {}
+
+  AddressPtr CreateKernelAddress(void *addr, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  std::vector<float> CreateInput(size_t size, size_t seed) {
+    std::vector<float> input(size);
+    for (size_t i = 0; i < size; ++i) {
+      input[i] = static_cast<float>(((i + seed) * 7919) % 23) / 8 - 1.0f;
+    }
+    return input;
+  }
+
+  std::vector<float> RunKernel(const std::vector<std::vector<float>> &inputs,
+                               const std::vector<std::vector<size_t>> &input_shapes,
+                               const std::vector<size_t> &output_shape, const std::vector<int> &dim_offsets,
+                               const std::vector<std::string> &ops, const std::vector<int> &operands,
+                               const std::vector<int> &operand_nums) {
+    FusedElemwiseCPUKernel kernel;
+    kernel.input_num_ = inputs.size();
+    kernel.InitProgram(ops, operands, operand_nums);
+    kernel.output_shape_ = output_shape;
+    kernel.InitStrides(input_shapes, dim_offsets);
+    std::vector<float> output(kernel.output_size_, -100);
+    std::vector<AddressPtr> input_addrs;
+    for (const auto &input : inputs) {
+      input_addrs.push_back(CreateKernelAddress(const_cast<float *>(input.data()), input.size() * sizeof(float)));
+    }
+    std::vector<AddressPtr> outputs{CreateKernelAddress(output.data(), output.size() * sizeof(float))};
+    kernel.Launch(input_addrs, {}, outputs);
+    return output;
+  }
+};
+
+// relu(x * w + b) with b broadcast on the last dim, the body of a dense layer
+TEST_F(FusedElemwiseCpuKernelTest, mul_add_relu_with_broadcast) {
+  size_t rows = 37;
+  size_t cols = 2100;
+  auto x = CreateInput(rows * cols, 0);
+  auto w = CreateInput(rows * cols, 5);
+  auto b = CreateInput(cols, 11);
+  auto output = RunKernel({x, w, b}, {{rows, cols}, {rows, cols}, {cols}}, {rows, cols}, {0, 0, 1},
+                          {"Mul", "TensorAdd", "ReLU"}, {0, 1, 3, 2, 4}, {2, 2, 1});
+  ASSERT_EQ(output.size(), rows * cols);
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      float expect = std::max(x[i * cols + j] * w[i * cols + j] + b[j], 0.0f);
+      EXPECT_FLOAT_EQ(output[i * cols + j], expect);
+    }
+  }
+}
+
+// BiasAdd on NCHW broadcasts the bias along H and W, which makes it a scalar inside every tile
+TEST_F(FusedElemwiseCpuKernelTest, bias_add_relu_grad_nchw) {
+  std::vector<size_t> shape{2, 3, 5, 7};
+  size_t size = 2 * 3 * 5 * 7;
+  auto x = CreateInput(size, 0);
+  auto bias = CreateInput(3, 3);
+  auto dy = CreateInput(size, 7);
+  auto output = RunKernel({x, bias, dy}, {shape, {3}, shape}, shape, {0, 1, 0}, {"BiasAdd", "ReluGrad"},
+                          {0, 1, 2, 3}, {2, 2});
+  ASSERT_EQ(output.size(), size);
+  for (size_t i = 0; i < size; ++i) {
+    float y = x[i] + bias[(i / 35) % 3];
+    EXPECT_FLOAT_EQ(output[i], y > 0 ? dy[i] : 0);
+  }
+}
+
+TEST_F(FusedElemwiseCpuKernelTest, unary_chain_and_addn) {
+  size_t size = 3001;
+  auto a = CreateInput(size, 0);
+  auto b = CreateInput(size, 1);
+  auto c = CreateInput(size, 2);
+  // max(d, s) - min(d, s) with d = sqrt(exp(-(a + b + c)^2)) / s and s a scalar input
+  std::vector<float> s{0.25f};
+  std::vector<std::string> ops{"AddN", "Square", "Neg", "Exp", "Sqrt", "RealDiv", "Maximum", "Minimum", "Sub"};
+  std::vector<int> operands{0, 1, 2, 4, 5, 6, 7, 8, 3, 9, 3, 9, 3, 10, 11};
+  std::vector<int> operand_nums{3, 1, 1, 1, 1, 2, 2, 2, 2};
+  auto output = RunKernel({a, b, c, s}, {{size}, {size}, {size}, {1}}, {size}, {}, ops, operands, operand_nums);
+  ASSERT_EQ(output.size(), size);
+  for (size_t i = 0; i < size; ++i) {
+    float sum = a[i] + b[i] + c[i];
+    float div = std::sqrt(std::exp(-(sum * sum))) / 0.25f;
+    float expect = std::max(div, 0.25f) - std::min(div, 0.25f);
+    EXPECT_NEAR(output[i], expect, std::fabs(expect) * 1e-5 + 1e-6);
+  }
+}
+
+TEST_F(FusedElemwiseCpuKernelTest, scalar_only_instructions) {
+  // x + (s * s), the product of the broadcast scalars is worked out once and broadcast again
+  auto x = CreateInput(60, 0);
+  std::vector<float> s{3.0f};
+  auto output = RunKernel({x, s}, {{4, 15}, {1, 1}}, {4, 15}, {}, {"Mul", "TensorAdd"}, {1, 1, 0, 2}, {2, 2});
+  for (size_t i = 0; i < x.size(); ++i) {
+    EXPECT_FLOAT_EQ(output[i], x[i] + 9.0f);
+  }
+  auto scalar_output = RunKernel({s}, {{1, 1}}, {4, 15}, {}, {"Square"}, {0}, {1});
+  for (auto value : scalar_output) {
+    EXPECT_FLOAT_EQ(value, 9.0f);
+  }
+}
+
+// a dim of size 0 leaves nothing to compute, wherever it sits
+TEST_F(FusedElemwiseCpuKernelTest, empty_output) {
+  for (const auto &shape : std::vector<std::vector<size_t>>{{4, 0}, {0, 15}, {3, 0, 5}}) {
+    FusedElemwiseCPUKernel kernel;
+    kernel.input_num_ = 2;
+    kernel.InitProgram({"Mul", "ReLU"}, {0, 1, 2}, {2, 1});
+    kernel.output_shape_ = shape;
+    kernel.InitStrides({shape, {1}}, {});
+    EXPECT_EQ(kernel.output_size_, 0);
+    std::vector<float> x;
+    std::vector<float> s{2.0f};
+    std::vector<float> output;
+    std::vector<AddressPtr> inputs{CreateKernelAddress(x.data(), 0), CreateKernelAddress(s.data(), sizeof(float))};
+    std::vector<AddressPtr> outputs{CreateKernelAddress(output.data(), 0)};
+    EXPECT_TRUE(kernel.Launch(inputs, {}, outputs));
+  }
+}
+
+// float16 tensors are computed in float32 and rounded once at the output
+TEST_F(FusedElemwiseCpuKernelTest, mul_add_relu_float16) {
+  size_t rows = 3;
+  size_t cols = 1500;
+  auto x = CreateInput(rows * cols, 0);
+  auto w = CreateInput(rows * cols, 5);
+  auto b = CreateInput(cols, 11);
+  std::vector<float16> x_half(x.begin(), x.end());
+  std::vector<float16> w_half(w.begin(), w.end());
+  std::vector<float16> b_half(b.begin(), b.end());
+  std::vector<float16> output(rows * cols, float16(-100.0f));
+  FusedElemwiseCPUKernel kernel;
+  kernel.input_num_ = 3;
+  kernel.dtype_ = kNumberTypeFloat16;
+  kernel.InitProgram({"Mul", "TensorAdd", "ReLU"}, {0, 1, 3, 2, 4}, {2, 2, 1});
+  kernel.output_shape_ = {rows, cols};
+  kernel.InitStrides({{rows, cols}, {rows, cols}, {cols}}, {0, 0, 1});
+  std::vector<AddressPtr> inputs{CreateKernelAddress(x_half.data(), x_half.size() * sizeof(float16)),
+                                 CreateKernelAddress(w_half.data(), w_half.size() * sizeof(float16)),
+                                 CreateKernelAddress(b_half.data(), b_half.size() * sizeof(float16))};
+  std::vector<AddressPtr> outputs{CreateKernelAddress(output.data(), output.size() * sizeof(float16))};
+  kernel.Launch(inputs, {}, outputs);
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      float expect = std::max(static_cast<float>(x_half[i * cols + j]) * static_cast<float>(w_half[i * cols + j]) +
+                                static_cast<float>(b_half[j]),
+                              0.0f);
+      EXPECT_EQ(static_cast<float>(output[i * cols + j]), static_cast<float>(float16(expect)));
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
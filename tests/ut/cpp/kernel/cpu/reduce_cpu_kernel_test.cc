@@ -0,0 +1,186 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/tensor.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/reduce_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr size_t kMax = 0;
+constexpr size_t kMean = 1;
+constexpr size_t kSum = 2;
+constexpr size_t kMin = 3;
+constexpr size_t kProd = 4;
+}  // namespace
+
+class ReduceCpuKernelTest : public UT::Common {
+ public:
+  ReduceCpuKernelTest() {}
+
+  AddressPtr CreateKernelAddress(void *addr, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  std::vector<float> CreateInput(size_t size) {
+    std::vector<float> input(size);
+    for (size_t i = 0; i < size; ++i) {
+      input[i] = static_cast<float>((i * 7919) % 23) / 16 + 0.5f;
+    }
+    return input;
+  }
+
+  // the reduction the kernel used to do: move the reduce axes innermost with a full copy, then reduce rows
+  std::vector<float> TransposeReduce(const std::vector<float> &input, const std::vector<size_t> &shape,
+                                     const std::vector<size_t> &axis, size_t reduce_type) {
+    std::vector<size_t> perm;
+    for (size_t i = 0; i < shape.size(); ++i) {
+      if (std::find(axis.begin(), axis.end(), i) == axis.end()) {
+        perm.push_back(i);
+      }
+    }
+    size_t stride = 1;
+    for (auto i : axis) {
+      perm.push_back(i);
+      stride *= shape[i];
+    }
+    std::vector<float> transposed(input.size());
+    std::vector<size_t> index(shape.size(), 0);
+    for (size_t pos = 0; pos < input.size(); ++pos) {
+      size_t offset = 0;
+      for (auto i : perm) {
+        offset = offset * shape[i] + index[i];
+      }
+      transposed[offset] = input[pos];
+      for (size_t i = shape.size(); i > 0 && ++index[i - 1] == shape[i - 1]; --i) {
+        index[i - 1] = 0;
+      }
+    }
+    std::vector<float> output(input.size() / stride);
+    for (size_t i = 0; i < output.size(); ++i) {
+      float value = reduce_type == kProd ? 1 : 0;
+      if (reduce_type == kMax || reduce_type == kMin) {
+        value = transposed[i * stride];
+      }
+      for (size_t k = 0; k < stride; ++k) {
+        float x = transposed[i * stride + k];
+        if (reduce_type == kMax) {
+          value = std::max(value, x);
+        } else if (reduce_type == kMin) {
+          value = std::min(value, x);
+        } else if (reduce_type == kProd) {
+          value *= x;
+        } else {
+          value += x;
+        }
+      }
+      output[i] = reduce_type == kMean ? value / stride : value;
+    }
+    return output;
+  }
+
+  template <typename T>
+  std::vector<T> RunKernel(const std::vector<T> &input, const std::vector<size_t> &shape,
+                           const std::vector<size_t> &axis, size_t reduce_type) {
+    ReduceCPUKernel reduce;
+    reduce.reduce_type_ = reduce_type;
+    reduce.dtype_ = sizeof(T) == sizeof(float) ? kNumberTypeFloat32 : kNumberTypeFloat16;
+    reduce.shape_ = shape;
+    reduce.axis_ = axis;
+    reduce.InitReducePlan();
+    std::vector<T> output(reduce.left_dims_);
+    std::vector<AddressPtr> inputs{CreateKernelAddress(const_cast<T *>(input.data()), input.size() * sizeof(T))};
+    std::vector<AddressPtr> outputs{CreateKernelAddress(output.data(), output.size() * sizeof(T))};
+    reduce.Launch(inputs, {}, outputs);
+    return output;
+  }
+
+  void CheckReduce(const std::vector<size_t> &shape, const std::vector<size_t> &axis, bool check_prod = true) {
+    size_t size = 1;
+    for (auto dim : shape) {
+      size *= dim;
+    }
+    auto input = CreateInput(size);
+    for (auto reduce_type : {kMax, kMean, kSum, kMin, kProd}) {
+      if (reduce_type == kProd && !check_prod) {
+        continue;
+      }
+      auto expect = TransposeReduce(input, shape, axis, reduce_type);
+      auto output = RunKernel(input, shape, axis, reduce_type);
+      ASSERT_EQ(output.size(), expect.size());
+      for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_NEAR(output[i], expect[i], std::fabs(expect[i]) * 1e-3 + 1e-5);
+      }
+    }
+  }
+};
+
+TEST_F(ReduceCpuKernelTest, reduce_inner_axis) {
+  CheckReduce({4, 37}, {1});
+  CheckReduce({3, 5, 67}, {1, 2});
+  CheckReduce({1000}, {0}, false);
+}
+
+TEST_F(ReduceCpuKernelTest, reduce_outer_axis) {
+  CheckReduce({37, 4}, {0});
+  CheckReduce({5, 9, 130}, {0});
+  CheckReduce({2, 9, 1, 33}, {1});
+}
+
+TEST_F(ReduceCpuKernelTest, reduce_interleaved_axis) {
+  CheckReduce({2, 3, 4, 5, 6}, {0, 2, 4});
+  CheckReduce({3, 4, 5, 6}, {1, 3});
+  CheckReduce({3, 1, 4, 1}, {1, 3});
+}
+
+TEST_F(ReduceCpuKernelTest, reduce_big_input_in_parallel) {
+  // the products of so many elements overflow
+  CheckReduce({4, 70000}, {1}, false);
+  CheckReduce({70000, 4}, {0}, false);
+  CheckReduce({300, 2, 300}, {0, 2}, false);
+}
+
+TEST_F(ReduceCpuKernelTest, reduce_fp16) {
+  std::vector<size_t> shape{6, 40, 3};
+  std::vector<size_t> axis{1};
+  auto input = CreateInput(6 * 40 * 3);
+  std::vector<float16> input_fp16(input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    input_fp16[i] = float16(input[i]);
+    input[i] = static_cast<float>(input_fp16[i]);
+  }
+  for (auto reduce_type : {kMax, kMean, kSum, kMin}) {
+    auto expect = TransposeReduce(input, shape, axis, reduce_type);
+    auto output = RunKernel(input_fp16, shape, axis, reduce_type);
+    ASSERT_EQ(output.size(), expect.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+      EXPECT_NEAR(static_cast<float>(output[i]), expect[i], std::fabs(expect[i]) * 1e-3);
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -219,5 +219,78 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Finish();
 }
+
+TEST_F(TestShardReader, TestShardReaderIOMode) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with every io mode");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name"};
+
+  std::vector<std::vector<uint8_t>> expected;
+  for (const auto &io_mode : {kIOModeStream, kIOModePread, kIOModeMmap, kIOModeIoUring}) {
+    ShardReader dataset;
+    dataset.SetIOMode(io_mode, 2);
+    ASSERT_EQ(dataset.Open({file_name}, true, 4, column_list), SUCCESS);
+    dataset.Launch();
+
+    std::vector<std::vector<uint8_t>> images;
+    while (true) {
+      auto x = dataset.GetNext();
+      if (x.empty()) break;
+      for (auto &j : x) {
+        images.push_back(std::get<0>(j));
+      }
+    }
+    dataset.Finish();
+    if (expected.empty()) {
+      expected = images;
+    }
+    EXPECT_EQ(images, expected);
+
+    auto stats = dataset.GetIOStats();
+    EXPECT_GT(stats.bytes_read, 0);
+    EXPECT_EQ(stats.num_requests, images.size());
+    dataset.Close();
+  }
+}
+
+TEST_F(TestShardReader, TestShardReaderBlockIOMode) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with block way and every io mode");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"label"};
+  const bool kBlockReader = true;
+
+  size_t expected = 0;
+  for (const auto &io_mode : {kIOModeStream, kIOModePread, kIOModeMmap, kIOModeIoUring}) {
+    ShardReader dataset;
+    dataset.SetIOMode(io_mode);
+    ASSERT_EQ(dataset.Open({file_name}, true, 4, column_list, {}, kBlockReader), SUCCESS);
+    dataset.Launch();
+
+    size_t row_count = 0;
+    while (true) {
+      auto x = dataset.GetBlockNext();
+      if (x.empty()) break;
+      for (auto &j : x) {
+        EXPECT_FALSE(std::get<0>(j).empty());
+        row_count++;
+      }
+    }
+    dataset.Finish();
+    if (expected == 0) {
+      expected = row_count;
+    }
+    EXPECT_EQ(row_count, expected);
+    auto stats = dataset.GetIOStats();
+    if (std::string(io_mode) == kIOModeMmap) {
+      // the pages are only mapped, nothing is read until the rows are copied out of them
+      EXPECT_EQ(stats.bytes_read, 0);
+      EXPECT_GT(stats.bytes_sliced, 0);
+    } else {
+      EXPECT_GT(stats.bytes_read, 0);
+      EXPECT_EQ(stats.num_slices, 0);
+    }
+    dataset.Close();
+  }
+}
 }  // namespace mindrecord
 }  // namespace mindspore
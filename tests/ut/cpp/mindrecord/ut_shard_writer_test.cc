@@ -24,6 +24,7 @@
 #include "common/utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_column.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_writer.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
@@ -1136,5 +1137,82 @@ TEST_F(TestShardWriter, TestOpenForAppend) {
   }
 }
 
+TEST_F(TestShardWriter, TestShardColumnarBlob) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test columnar blob layout"));
+
+  mindrecord::ShardHeader header_data;
+  json schema_json = R"({"label": {"type": "int32"}, "image": {"type": "bytes"}, "mask": {"type": "bytes"}})"_json;
+  std::shared_ptr<mindrecord::Schema> schema = mindrecord::Schema::Build("columnar", schema_json);
+  ASSERT_TRUE(schema != nullptr);
+  int schema_id = header_data.AddSchema(schema);
+  ASSERT_EQ(schema_id, 0);
+  auto blob_fields = schema->GetBlobFields();
+  ASSERT_EQ(blob_fields.size(), 2);
+
+  // each blob is [8 bytes big-endian length][data] per blob field, in the order of the blob fields
+  const int kRows = 100;
+  std::vector<json> labels;
+  std::vector<std::vector<uint8_t>> bin_data;
+  for (int i = 0; i < kRows; i++) {
+    labels.emplace_back(json{{"label", i}});
+    std::vector<uint8_t> blob;
+    for (size_t c = 0; c < blob_fields.size(); c++) {
+      uint64_t size = (i * 37 + c * 101) % 900 + 1;
+      for (int k = 7; k >= 0; k--) {
+        blob.emplace_back(static_cast<uint8_t>((size >> (k * 8)) & 0xff));
+      }
+      blob.insert(blob.end(), size, static_cast<uint8_t>(i + c));
+    }
+    bin_data.emplace_back(blob);
+  }
+  std::map<std::uint64_t, std::vector<json>> rawdatas;
+  rawdatas.insert(pair<uint64_t, vector<json>>(schema_id, labels));
+
+  std::string filename = "./columnar.shard01";
+  mindrecord::ShardWriter fw_init;
+  ASSERT_TRUE(fw_init.Open({filename}) == SUCCESS);
+  fw_init.SetPageSize(1 << 15);
+  ASSERT_TRUE(fw_init.SetColumnarBlob(true) == SUCCESS);
+  ASSERT_TRUE(fw_init.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)) == SUCCESS);
+  ASSERT_TRUE(fw_init.SetColumnarBlob(false) == FAILED);
+  ASSERT_TRUE(fw_init.WriteRawData(rawdatas, bin_data) == SUCCESS);
+  ASSERT_TRUE(fw_init.Commit() == SUCCESS);
+
+  mindrecord::ShardIndexGenerator sg{filename};
+  sg.Build();
+  ASSERT_TRUE(sg.WriteToDatabase() == SUCCESS);
+
+  // only the mask is loaded, the image comes back empty
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open({filename}, true, 4, {"label", "mask"}), SUCCESS);
+  ASSERT_TRUE(dataset.GetShardHeader()->GetColumnarBlob());
+  auto column = dataset.GetShardColumn();
+  dataset.Launch();
+
+  int count = 0;
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    for (auto &j : x) {
+      int label = std::get<1>(j)["label"];
+      const unsigned char *data = nullptr;
+      std::unique_ptr<unsigned char[]> data_ptr;
+      uint64_t n_bytes = 0;
+      ASSERT_EQ(column->GetColumnFromBlob("mask", std::get<0>(j), &data, &data_ptr, &n_bytes), SUCCESS);
+      if (data == nullptr) data = data_ptr.get();
+      ASSERT_EQ(n_bytes, (label * 37 + 101) % 900 + 1);
+      ASSERT_EQ(data[0], static_cast<uint8_t>(label + 1));
+      ASSERT_EQ(data[n_bytes - 1], static_cast<uint8_t>(label + 1));
+      ASSERT_EQ(column->GetColumnFromBlob("image", std::get<0>(j), &data, &data_ptr, &n_bytes), SUCCESS);
+      ASSERT_EQ(n_bytes, 0);
+      count++;
+    }
+  }
+  ASSERT_EQ(count, kRows);
+  dataset.Finish();
+  remove(common::SafeCStr(filename));
+  remove(common::SafeCStr(filename + ".db"));
+}
+
 }  // namespace mindrecord
 }  // namespace mindspore
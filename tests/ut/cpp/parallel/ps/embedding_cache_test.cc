@@ -0,0 +1,74 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/ps/embedding_cache.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+class TestEmbeddingCache : public UT::Common {
+ public:
+  TestEmbeddingCache() {}
+};
+
+TEST_F(TestEmbeddingCache, evict_least_recently_used) {
+  EmbeddingCache<float> cache(2, 0);
+  std::vector<float> row0{1, 2, 3};
+  std::vector<float> row1{4, 5, 6};
+  std::vector<float> row2{7, 8, 9};
+  cache.Insert(0, 10, row0.data(), 3);
+  cache.Insert(0, 11, row1.data(), 3);
+  std::vector<float> out(3, 0);
+  // reading row 10 makes row 11 the least recently used one
+  ASSERT_TRUE(cache.Lookup(0, 10, out.data(), 3));
+  EXPECT_EQ(out, row0);
+  cache.Insert(0, 12, row2.data(), 3);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_FALSE(cache.Lookup(0, 11, out.data(), 3));
+  ASSERT_TRUE(cache.Lookup(0, 12, out.data(), 3));
+  EXPECT_EQ(out, row2);
+  // the same id of another table is another row
+  EXPECT_FALSE(cache.Lookup(1, 12, out.data(), 3));
+  EXPECT_EQ(cache.hit_count(), 2);
+  EXPECT_EQ(cache.miss_count(), 2);
+}
+
+TEST_F(TestEmbeddingCache, drop_rows_older_than_staleness) {
+  EmbeddingCache<float> cache(8, 1);
+  std::vector<float> row{1, 2};
+  std::vector<float> out(2, 0);
+  cache.Insert(0, 5, row.data(), 2);
+  cache.Insert(1, 5, row.data(), 2);
+  cache.Update(0);
+  EXPECT_TRUE(cache.Lookup(0, 5, out.data(), 2));
+  cache.Update(0);
+  EXPECT_FALSE(cache.Lookup(0, 5, out.data(), 2));
+  EXPECT_EQ(cache.size(), 1);
+  // the pushes of table 0 do not age the rows of table 1
+  EXPECT_TRUE(cache.Lookup(1, 5, out.data(), 2));
+}
+
+TEST_F(TestEmbeddingCache, disabled_without_capacity) {
+  EmbeddingCache<float> cache(0, 0);
+  std::vector<float> row{1};
+  cache.Insert(0, 1, row.data(), 1);
+  EXPECT_FALSE(cache.Lookup(0, 1, row.data(), 1));
+  EXPECT_EQ(cache.size(), 0);
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/backend_common_test.h"
+#include "ir/anf.h"
+#include "common/py_func_graph_fetcher.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/optimizer/common/optimizer.h"
+#include "backend/optimizer/common/pass_manager.h"
+#include "backend/optimizer/cpu/cpu_elemwise_fusion.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestCPUElemwiseFusion : public BackendCommon {
+ public:
+  TestCPUElemwiseFusion() : get_py_fun_("gtest_input.pre_activate.cpu_elemwise_fusion_test", true) {}
+  ~TestCPUElemwiseFusion() override = default;
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestCPUElemwiseFusion, test_fuse_addn_with_make_tuple) {
+  FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_cpu_elemwise_fusion_addn", "before");
+  ASSERT_TRUE(g != nullptr);
+  std::vector<int> shp{2, 32, 4, 4};
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+  AbstractBasePtrList args_spec_list{x_abstract, x_abstract, x_abstract};
+  auto kernel_graph = GetKernelGraph(g, args_spec_list);
+  ASSERT_TRUE(kernel_graph != nullptr);
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::CPUElemwiseFusion>());
+  optimizer->AddPassManager(pm);
+  optimizer->Optimize(kernel_graph);
+
+  // the kernel graph returns make_tuple(output)
+  auto output = kernel_graph->output();
+  ASSERT_TRUE(IsPrimitiveCNode(output, prim::kPrimMakeTuple));
+  auto fused = output->cast<CNodePtr>()->input(1);
+  ASSERT_EQ(AnfAlgo::GetCNodeName(fused), kCPUFusedElemwiseOpName);
+  auto ops = AnfAlgo::GetNodeAttr<std::vector<std::string>>(fused, kAttrFusedOps);
+  auto operand_nums = AnfAlgo::GetNodeAttr<std::vector<int>>(fused, kAttrFusedOperandNums);
+  ASSERT_EQ(ops.size(), 3);
+  EXPECT_EQ(ops.back(), "AddN");
+  EXPECT_EQ(operand_nums.back(), 3);
+  // x, y and z, the MakeTuple is gone
+  auto fused_cnode = fused->cast<CNodePtr>();
+  ASSERT_EQ(fused_cnode->inputs().size(), 4);
+  for (size_t i = 1; i < fused_cnode->inputs().size(); ++i) {
+    EXPECT_TRUE(fused_cnode->input(i)->isa<Parameter>());
+  }
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 # ==============================================================================
+import os
 import random
 import pytest
 import numpy as np
@@ -237,6 +238,30 @@ def test_graphdata_getedgefeature():
     assert features[1].shape == (40,)
 
 
+def test_graphdata_snapshot():
+    """
+    Test save and load graph snapshot
+    """
+    logger.info('test graph snapshot.\n')
+    snapshot_file = "./graphdata_test.snapshot"
+    g = ds.GraphData(DATASET_FILE, 2)
+    g.save_snapshot(snapshot_file)
+    try:
+        s = ds.GraphData(snapshot_file)
+        assert s.graph_info() == g.graph_info()
+        nodes = g.get_all_nodes(1)
+        assert np.array_equal(s.get_all_nodes(1), nodes)
+        assert np.array_equal(s.get_all_neighbors(nodes, 2), g.get_all_neighbors(nodes, 2))
+        for expected, actual in zip(g.get_node_feature(nodes, [1, 2, 3]), s.get_node_feature(nodes, [1, 2, 3])):
+            assert np.array_equal(expected, actual)
+        edges = g.get_all_edges(0)
+        assert np.array_equal(s.get_nodes_from_edges(edges), g.get_nodes_from_edges(edges))
+        for expected, actual in zip(g.get_edge_feature(edges, [1, 2]), s.get_edge_feature(edges, [1, 2])):
+            assert np.array_equal(expected, actual)
+    finally:
+        os.remove(snapshot_file)
+
+
 if __name__ == '__main__':
     test_graphdata_getfullneighbor()
     test_graphdata_getnodefeature_input_check()
@@ -247,3 +272,4 @@ if __name__ == '__main__':
     test_graphdata_randomwalkdefault()
     test_graphdata_randomwalk()
     test_graphdata_getedgefeature()
+    test_graphdata_snapshot()
@@ -90,6 +90,20 @@ def test_random_sampler_multi_iter(print_res=False):
     test_config(replacement=True, num_samples=5, num_repeats=5, validate=[0, 1, 2, 3, 4, 5])
 
 
+def test_random_sampler_block():
+    sampler = ds.RandomSampler(block_size=4).create()
+    sampler.set_num_rows(10)
+    sampler.set_num_samples(10)
+    sampler.initialize()
+    indices = list(sampler.get_indices())
+
+    # every id once, and the ids of a block stay together and in order
+    assert sorted(indices) == list(range(10))
+    for i, idx in enumerate(indices):
+        if idx % 4 != 0:
+            assert indices[i - 1] == idx - 1
+
+
 def test_sampler_py_api():
     sampler = ds.SequentialSampler().create()
     sampler.set_num_rows(128)
@@ -239,6 +253,7 @@ if __name__ == '__main__':
     test_sequential_sampler(True)
     test_random_sampler(True)
     test_random_sampler_multi_iter(True)
+    test_random_sampler_block()
     test_sampler_py_api()
     test_python_sampler()
     test_subset_sampler()
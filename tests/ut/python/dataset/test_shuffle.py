@@ -139,6 +139,53 @@ def test_shuffle_06():
         np.testing.assert_equal(item1, item2)
 
 
+def test_shuffle_memory_limit():
+    """
+    Test shuffle: with a memory limit, same rows in the same order as without one
+    """
+    logger.info("test_shuffle_memory_limit")
+    # define parameters
+    buffer_size = 5
+    seed = 1
+
+    # apply dataset operations
+    ds.config.set_seed(seed)
+    data1 = ds.TFRecordDataset(DATA_DIR, shuffle=False)
+    data1 = data1.shuffle(buffer_size=buffer_size)
+
+    ds.config.set_seed(seed)
+    data2 = ds.TFRecordDataset(DATA_DIR, shuffle=False)
+    data2 = data2.shuffle(buffer_size=buffer_size, memory_limit=1)
+
+    num_rows = 0
+    for item1, item2 in zip(data1.create_dict_iterator(), data2.create_dict_iterator()):
+        np.testing.assert_equal(item1, item2)
+        num_rows += 1
+    assert num_rows == 12
+
+    # string tensors are stored with their offsets, and must come back with all their strings
+    def gen():
+        for i in range(12):
+            yield (np.array(["row", str(i) * i, ""]), np.array([i], dtype=np.int32))
+
+    ds.config.set_seed(seed)
+    data1 = ds.GeneratorDataset(gen, column_names=["text", "label"], shuffle=False)
+    data1 = data1.shuffle(buffer_size=buffer_size)
+
+    ds.config.set_seed(seed)
+    data2 = ds.GeneratorDataset(gen, column_names=["text", "label"], shuffle=False)
+    data2 = data2.shuffle(buffer_size=buffer_size, memory_limit=1)
+
+    num_rows = 0
+    for item1, item2 in zip(data1.create_dict_iterator(), data2.create_dict_iterator()):
+        np.testing.assert_array_equal(item1["text"], item2["text"])
+        np.testing.assert_array_equal(item1["label"], item2["label"])
+        i = item2["label"][0]
+        np.testing.assert_array_equal(item2["text"], np.array(["row", str(i) * i, ""]).astype("S"))
+        num_rows += 1
+    assert num_rows == 12
+
+
 def test_shuffle_exception_01():
     """
     Test shuffle exception: buffer_size<0
@@ -254,6 +301,7 @@ if __name__ == '__main__':
     test_shuffle_04()
     test_shuffle_05()
     test_shuffle_06()
+    test_shuffle_memory_limit()
     test_shuffle_exception_01()
     test_shuffle_exception_02()
     test_shuffle_exception_03()
@@ -15,6 +15,8 @@
 """
 Test TFRecordDataset Ops
 """
+import os
+
 import numpy as np
 import pytest
 
@@ -294,6 +296,32 @@ def test_tfrecord_invalid_files():
     assert nonexistent_file in str(info.value)
 
 
+def test_tfrecord_check_crc():
+    logger.info("test_tfrecord_check_crc")
+    corrupted_file = "./test_tfrecord_check_crc.data"
+    with open(FILES[0], "rb") as f:
+        content = bytearray(f.read())
+    # flip a byte in the data of the first record, after its 8 byte length and the 4 byte crc of the length
+    content[8 + 4 + 8] ^= 0x01
+    with open(corrupted_file, "wb") as f:
+        f.write(content)
+
+    try:
+        data = ds.TFRecordDataset(FILES, SCHEMA_FILE, shuffle=False, check_crc=True)
+        assert sum(1 for _ in data.create_dict_iterator()) == 12
+
+        data = ds.TFRecordDataset([corrupted_file], SCHEMA_FILE, shuffle=False, check_crc=True)
+        with pytest.raises(RuntimeError) as info:
+            for _ in data.create_dict_iterator():
+                pass
+        assert "crc check failed" in str(info.value)
+
+        with pytest.raises(TypeError):
+            ds.TFRecordDataset(FILES, SCHEMA_FILE, check_crc=1)
+    finally:
+        os.remove(corrupted_file)
+
+
 if __name__ == '__main__':
     test_tfrecord_shape()
     test_tfrecord_read_all_dataset()
@@ -312,3 +340,4 @@ if __name__ == '__main__':
     test_tfrecord_no_schema_columns_list()
     test_tfrecord_schema_columns_list()
     test_tfrecord_invalid_files()
+    test_tfrecord_check_crc()